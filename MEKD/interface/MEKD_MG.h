@@ -3,11 +3,18 @@
 
 #include <string>
 #include <vector>
+#include <map>
 
 #include <sstream>
 #include <complex>
 
 #include "../src/MadGraphSrc/read_slha.h"
+#include "../src/MadGraphSrc/Parameters_MEKD.h"
+
+extern "C"
+{
+#include "../src/Extra_code/MEKD_CalcHEP_PDF.h"
+}
 
 using namespace std;
 
@@ -38,6 +45,7 @@ public:
 	double ContributionCoeff_c;	//3
 // 	double GG;	// Assign QCD coupling, force g3 running if needed
 	double Sqrt_s;	//Max energy, collision energy
+	int Helicity_warm_up_events;	// Events each ME sums over all helicities before it only uses the non-vanishing ones. Zero or negative: always all helicities (default). Applied on (re)loading
 	
 	/// State mixing
 	complex<double> *Mixing_Coefficients_Spin0, *Mixing_Coefficients_Spin1, *Mixing_Coefficients_Spin2;
@@ -60,6 +68,7 @@ public:
 	vector<string> Test_Models;	// same names as for the Test_Model
 	string Parameter_file;	// Location where a parameter card is stored
 	string PDF_file;	// PDF/PDT table file
+	string Helicity_file;	// Non-vanishing helicities are read from it on (re)loading, so that the warm-up is skipped, and written by Save_Helicities()
 	
 	/// Calculation results
 	double Mass_4l;	//is filled after running RUN_XXXX(...). Invariant mass of the final-state system
@@ -68,13 +77,14 @@ public:
 	vector<double> Signal_MEs;	//is filled if Test_Models are set after running RUN_XXXX(...)
 	double KD;	//is not filled with RUN_MEKD_MG( string )
 	
-	/// Parameter container. For experts only
+	/// Parameter container. For experts only. Read from Parameter_file and copied into the flat parameter set by Reload_Parameters()
 	SLHAReader_MEKD Set_Of_Model_Parameters;
 	
 	/// Functions
 	void Set_Default_MEKD_MG_Parameters();
 	
 	int Reload_Parameters();	// reloads parameter set and updates PDF file reader
+	int Save_Helicities();	// saves the non-vanishing helicities of the warmed-up MEs to Helicity_file
 	int Run_MEKD_MG();	// main routine to evaluate matrix elements; updates "Calculation results"
 	int Run_MEKD_MG(string Input_Model);	// Calculates a ME ONLY for a chosen model; ignores automatic background calculation. Updates Signal_ME
 	
@@ -89,11 +99,40 @@ private:
 	unsigned int counter;
 	
 	double *buffer, buffer_p[4], buffer_Custom, ml1, ml2, ml3, ml4, PDFx1, PDFx2, LmbdGG_calculated;
+	
+	/// PDF tables of this instance and their values at ( PDFx1, Mass_4l ) and ( PDFx2, Mass_4l ), pdfreader_flavours each
+	pdfreaderTables PDF_tables;
+	double PDF_values[2*pdfreader_flavours];
 	double *pl1_internal, *pl2_internal, *pl3_internal, *pl4_internal, *pA1_internal;
 	
 	complex<double> *buffer_complex, *Mixing_Coefficients_Spin0_internal, *Mixing_Coefficients_Spin1_internal, *Mixing_Coefficients_Spin2_internal;
 	
-	string *Test_Model_buffer;
+	/// Final state, initial state and resonance decay mode resolved from the strings, so that MEs are chosen without string comparisons
+	enum Final_state_id { FS_unknown, FS_4e, FS_4eA, FS_4mu, FS_4muA, FS_2e2mu, FS_2e2muA, FS_2mu, FS_2muA };
+	enum Initial_state_id { IS_NO, IS_gg, IS_qq };
+	enum Resonance_decay_mode_id { RDM_ZZ, RDM_2l };
+	
+	Final_state_id Final_state_internal;
+	Resonance_decay_mode_id Resonance_decay_mode_internal;
+	
+	typedef int (MEKD_MG::*Configurator_ptr)(Initial_state_id initial_state);
+	struct Resolved_Model
+	{
+		const char *Name;
+		Configurator_ptr Configurator;	// NULL for unknown models
+		Initial_state_id Initial_state;
+		Resonance_decay_mode_id Decay_mode;
+	};
+	
+	vector<Resolved_Model> Resolved_Test_Models;
+	vector<string> Resolved_Test_Models_Names;	// Test_Models from which Resolved_Test_Models were made
+	map<string, Resolved_Model> Resolved_Models_Cache;
+	
+	map<string, vector<int> > Good_Helicities;	// non-vanishing helicities by ME class name
+	
+	/// Flat parameter sets handed to the MEs by pointer, so that no SLHA maps are touched per event
+	Parameters_MEKD Model_Parameters;	// filled from Set_Of_Model_Parameters on (re)loading; configurators overwrite entries directly
+	Parameters_MEKD Model_Parameters_qqbar;	// Model_Parameters with the masses and couplings of the current quark flavour
 	
 	// Parameters
 	double v_expectation;	// Vacuum expectation value
@@ -114,52 +153,65 @@ private:
 		params_rhob21, params_rhob22, params_rhob23, params_rhob24;
 	
 	
-	string buffer_string;
-	
 	vector<double> id_set;
 	vector<double*> p_set;
 	
 	/// Internal functions ///
 	int Load_Parameters();
 	
+	/// Helicity filtering of the MEs
+	int Load_Helicities();
+	void Exchange_All_Helicities(bool Save);
+	template<class Generic_MEKD_MG_ME>
+	void Exchange_Helicities(Generic_MEKD_MG_ME &Generic_ME, bool Save);
+	
 	int Arrange_Internal_pls();
 	
+	/// Model and final-state resolution. Done once per model name, not per event
+	int Resolve_Model(string Input_Model, Resolved_Model &Model);
+	const Resolved_Model& Resolve_Model_Cached(const string &Input_Model);
+	int Resolve_Test_Models();
+	int Resolve_Final_state();
+	
+	/// Runs the resolved models on the current event
+	int Run_MEKD_MG_Models(const Resolved_Model *Models, unsigned int N_models, bool Compute_background, bool Fill_Signal_MEs, bool Compute_KD);
+	
 	/// Sets up particular choices. Tier 3
-	int Run_MEKD_MG_ME_Configurator_BKG_ZZ(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Custom();
-	int Run_MEKD_MG_ME_Configurator_CPPProcess(string initial_state);	// RAW MG5_aMC ME
-	int Run_MEKD_MG_ME_Configurator_Spin0(string initial_state);	// A general mixed spin-0 state
-	int Run_MEKD_MG_ME_Configurator_Spin1(string initial_state);	// A general mixed spin-1 state
-	int Run_MEKD_MG_ME_Configurator_Spin2(string initial_state);	// A general mixed spin-2 state
-	int Run_MEKD_MG_ME_Configurator_Spin0Pm(string initial_state);	// SM Higgs
-	int Run_MEKD_MG_ME_Configurator_Spin0M(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin0Ph(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin1P(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin1M(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin2Pm(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin2Ph(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin2Mh(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin2Pb(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin2Ph2(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin2Ph3(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin2Ph6(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin2Ph7(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin2Mh9(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin2Mh10(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin0Pm_Spin0M(string initial_state);	// A mixed state of two contributions
-	int Run_MEKD_MG_ME_Configurator_Spin0Pm_Spin0Ph(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Spin0M_Spin0Ph(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Z4l_BKG(string initial_state);
-	int Run_MEKD_MG_ME_Configurator_Z4l_SIG(string initial_state);
+	int Run_MEKD_MG_ME_Configurator_BKG_ZZ(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Custom(Initial_state_id);	// Sets its own initial states; the argument only fits Configurator_ptr
+	int Run_MEKD_MG_ME_Configurator_CPPProcess(Initial_state_id initial_state);	// RAW MG5_aMC ME
+	int Run_MEKD_MG_ME_Configurator_Spin0(Initial_state_id initial_state);	// A general mixed spin-0 state
+	int Run_MEKD_MG_ME_Configurator_Spin1(Initial_state_id initial_state);	// A general mixed spin-1 state
+	int Run_MEKD_MG_ME_Configurator_Spin2(Initial_state_id initial_state);	// A general mixed spin-2 state
+	int Run_MEKD_MG_ME_Configurator_Spin0Pm(Initial_state_id initial_state);	// SM Higgs
+	int Run_MEKD_MG_ME_Configurator_Spin0M(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin0Ph(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin1P(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin1M(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin2Pm(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin2Ph(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin2Mh(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin2Pb(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin2Ph2(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin2Ph3(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin2Ph6(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin2Ph7(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin2Mh9(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin2Mh10(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin0Pm_Spin0M(Initial_state_id initial_state);	// A mixed state of two contributions
+	int Run_MEKD_MG_ME_Configurator_Spin0Pm_Spin0Ph(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Spin0M_Spin0Ph(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Z4l_BKG(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Configurator_Z4l_SIG(Initial_state_id initial_state);
 	
 	/// Dispatches MEs that have correct parameters. Tier 2
-	int Run_MEKD_MG_ME_Dispatcher_CPPProcess(string initial_state);	// RAW MG5_aMC ME
-	int Run_MEKD_MG_ME_Dispatcher_BKG_ZZ(string initial_state);
-	int Run_MEKD_MG_ME_Dispatcher_Z4l_BKG(string initial_state);
-	int Run_MEKD_MG_ME_Dispatcher_Z4l_SIG(string initial_state);
-	int Run_MEKD_MG_ME_Dispatcher_SIG_Spin0(string initial_state);
-	int Run_MEKD_MG_ME_Dispatcher_SIG_Spin1(string initial_state);
-	int Run_MEKD_MG_ME_Dispatcher_SIG_Spin2(string initial_state);
+	int Run_MEKD_MG_ME_Dispatcher_CPPProcess(Initial_state_id initial_state);	// RAW MG5_aMC ME
+	int Run_MEKD_MG_ME_Dispatcher_BKG_ZZ(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Dispatcher_Z4l_BKG(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Dispatcher_Z4l_SIG(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Dispatcher_SIG_Spin0(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Dispatcher_SIG_Spin1(Initial_state_id initial_state);
+	int Run_MEKD_MG_ME_Dispatcher_SIG_Spin2(Initial_state_id initial_state);
 	
 	/// Evaluators. Blind-calculation functions. Handles MEs from Dispatchers. Tier 1
 	template<class Generic_MEKD_MG_ME>
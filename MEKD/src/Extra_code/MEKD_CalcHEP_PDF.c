@@ -9,9 +9,13 @@
 
 
 
+/// Binary copies of the tables start with it
+#define pdfreader_binary_tag "MEKD-PDT-binary\n"
+
+
+
 /// Part of pdfreader
-pdtStr pdtSg, pdtSd, pdtSu, pdtSs, pdtSc,
-	pdtSad, pdtSau, pdtSas, pdtSac;
+static pdfreaderTables pdfreader_shared;
 
 
 
@@ -36,22 +40,53 @@ int ConvertID_2_CalcID(int pNum) // To translate KF code (PYTHIA) into a number
 }
 
 
-double pdfreader(long pNum, double x, double q)
+double pdfreader_tables(pdfreaderTables *tables, long pNum, double x, double q)
 {
-	if( pNum==1 ) return interFunc( x, q, &pdtSd );
-	if( pNum==2 ) return interFunc( x, q, &pdtSu );
-	if( pNum==3 ) return interFunc( x, q, &pdtSs );
-	if( pNum==4 ) return interFunc( x, q, &pdtSc );
-	if( pNum==-1 ) return interFunc( x, q, &pdtSad );
-	if( pNum==-2 ) return interFunc( x, q, &pdtSau );
-	if( pNum==-3 ) return interFunc( x, q, &pdtSas );
-	if( pNum==-4 ) return interFunc( x, q, &pdtSac );
-	if( pNum==21 ) return interFunc( x, q, &pdtSg );
+	if( pNum==1 ) return interFunc( x, q, &tables->d );
+	if( pNum==2 ) return interFunc( x, q, &tables->u );
+	if( pNum==3 ) return interFunc( x, q, &tables->s );
+	if( pNum==4 ) return interFunc( x, q, &tables->c );
+	if( pNum==-1 ) return interFunc( x, q, &tables->ad );
+	if( pNum==-2 ) return interFunc( x, q, &tables->au );
+	if( pNum==-3 ) return interFunc( x, q, &tables->as );
+	if( pNum==-4 ) return interFunc( x, q, &tables->ac );
+	if( pNum==21 ) return interFunc( x, q, &tables->g );
 	
 	return 0;
 }
 
 
+/// Same order as in the output of pdfreader_all(...)
+static void pdfreader_list(pdfreaderTables *tables, pdtStr **list)
+{
+	list[0] = &tables->ac;
+	list[1] = &tables->as;
+	list[2] = &tables->au;
+	list[3] = &tables->ad;
+	list[4] = &tables->g;
+	list[5] = &tables->d;
+	list[6] = &tables->u;
+	list[7] = &tables->s;
+	list[8] = &tables->c;
+}
+
+
+void pdfreader_all(pdfreaderTables *tables, int n, const double *x, const double *q, double *f)
+{
+	pdtStr *list[pdfreader_flavours];
+	int i;
+	
+	pdfreader_list( tables, list );
+	for( i=0; i<n; i++ ) interFuncs( x[i], q[i], pdfreader_flavours, list, f+pdfreader_flavours*i );
+}
+
+
+double pdfreader(long pNum, double x, double q)
+{
+	return pdfreader_tables( &pdfreader_shared, pNum, x, q );
+}
+
+
 // double pdfreader(long pNum, double x, double q)
 // {
 // 	if( pNum==1 ) return 0;
@@ -68,42 +103,77 @@ double pdfreader(long pNum, double x, double q)
 // }
 
 
+int Load_pdfreader_tables(pdfreaderTables *tables, char *file)
+{
+	pdtStr *list[pdfreader_flavours];
+	char tag[sizeof(pdfreader_binary_tag)-1];
+	int i, err=0;
+	FILE *f=fopen( file, "rb" );
+	
+	if( !f ) return -1;
+	pdfreader_list( tables, list );
+	
+	/// Binary copy
+	if( fread( tag, 1, sizeof(tag), f )==sizeof(tag) && memcmp( tag, pdfreader_binary_tag, sizeof(tag) )==0 )
+	{
+		for( i=0; i<pdfreader_flavours; i++ )
+		{
+			if( (err=readPdtData( f, list[i] ))!=0 ) break;
+		}
+		if( err!=0 ) { while( i-- ) freePdtData( list[i] ); }
+		fclose( f );
+		return err;
+	}
+	fclose( f );
+	
+	/// PDT text file. Flavours are looked up by their CalcHEP numbers
+	for( i=0; i<pdfreader_flavours; i++ )
+	{
+		if( (err=getPdtData( file, ConvertID_2_CalcID( i==4 ? 21 : i-4 ), list[i] ))!=0 ) break;
+	}
+	if( err!=0 ) { while( i-- ) freePdtData( list[i] ); }
+	return err;
+}
+
+
+int Save_pdfreader_tables(pdfreaderTables *tables, char *file)
+{
+	pdtStr *list[pdfreader_flavours];
+	int i, err=0;
+	FILE *f=fopen( file, "wb" );
+	
+	if( !f ) return -1;
+	pdfreader_list( tables, list );
+	
+	if( fwrite( pdfreader_binary_tag, 1, sizeof(pdfreader_binary_tag)-1, f )!=sizeof(pdfreader_binary_tag)-1 ) err=-1;
+	for( i=0; i<pdfreader_flavours && err==0; i++ ) err=writePdtData( f, list[i] );
+	if( fclose( f )!=0 ) err=-1;
+	
+	return err;
+}
+
+
+void Unload_pdfreader_tables(pdfreaderTables *tables)
+{
+	pdtStr *list[pdfreader_flavours];
+	int i;
+	
+	pdfreader_list( tables, list );
+	for( i=0; i<pdfreader_flavours; i++ ) freePdtData( list[i] );
+}
+
+
 void Load_pdfreader(char* file)
 {
-	int err;
+	int err=Load_pdfreader_tables( &pdfreader_shared, file );
 	
-	err=getPdtData( file, ConvertID_2_CalcID(21), &pdtSg);
-	if( err!=0 ) { printf( "Setting-up pdfreader has failed! Error number: %d. Exiting.\n", err ); exit(1); }
-	err=getPdtData( file, ConvertID_2_CalcID(1), &pdtSd );
-	if( err!=0 ) { printf( "Setting-up pdfreader has failed! Error number: %d. Exiting.\n", err ); exit(1); }
-	err=getPdtData( file, ConvertID_2_CalcID(2), &pdtSu );
-	if( err!=0 ) { printf( "Setting-up pdfreader has failed! Error number: %d. Exiting.\n", err ); exit(1); }
-	err=getPdtData( file, ConvertID_2_CalcID(3), &pdtSs );
-	if( err!=0 ) { printf( "Setting-up pdfreader has failed! Error number: %d. Exiting.\n", err ); exit(1); }
-	err=getPdtData( file, ConvertID_2_CalcID(4), &pdtSc );
-	if( err!=0 ) { printf( "Setting-up pdfreader has failed! Error number: %d. Exiting.\n", err ); exit(1); }
-	err=getPdtData( file, ConvertID_2_CalcID(-1), &pdtSad);
-	if( err!=0 ) { printf( "Setting-up pdfreader has failed! Error number: %d. Exiting.\n", err ); exit(1); }
-	err=getPdtData( file, ConvertID_2_CalcID(-2), &pdtSau);
-	if( err!=0 ) { printf( "Setting-up pdfreader has failed! Error number: %d. Exiting.\n", err ); exit(1); }
-	err=getPdtData( file, ConvertID_2_CalcID(-3), &pdtSas);
-	if( err!=0 ) { printf( "Setting-up pdfreader has failed! Error number: %d. Exiting.\n", err ); exit(1); }
-	err=getPdtData( file, ConvertID_2_CalcID(-4), &pdtSac);
 	if( err!=0 ) { printf( "Setting-up pdfreader has failed! Error number: %d. Exiting.\n", err ); exit(1); }
 }
 
 
 void Unload_pdfreader()
 {
-	freePdtData( &pdtSg );
-	freePdtData( &pdtSd );
-	freePdtData( &pdtSu );
-	freePdtData( &pdtSs );
-	freePdtData( &pdtSc );
-	freePdtData( &pdtSad);
-	freePdtData( &pdtSau);
-	freePdtData( &pdtSas);
-	freePdtData( &pdtSac);
+	Unload_pdfreader_tables( &pdfreader_shared );
 }
 
 
@@ -1,10 +1,33 @@
 #ifndef MEKD_CalcHEP_PDF_h
 #define MEKD_CalcHEP_PDF_h
 
+#include "../PDFTables/pdt.h"
+
 
 /// To translate KF code (PYTHIA) into a number defined in CalCHEP
 int ConvertID_2_CalcID(int pNum);
 
+/// Flavours returned by pdfreader_all(...): anti-charm to charm, with the gluon in place of 0
+#define pdfreader_flavours 9
+
+/// PDF tables of one reader, so that every user keeps its own
+typedef struct pdfreaderTables
+{
+	pdtStr g, d, u, s, c, ad, au, as, ac;
+} pdfreaderTables;
+
+double pdfreader_tables(pdfreaderTables *tables, long pNum, double x, double q);
+
+/// Fills f[pdfreader_flavours*i+4+pNum] for quarks and f[pdfreader_flavours*i+4] for gluons at ( x[i], q[i] ), i<n.
+/// The bins and the x- and q-dependent factors are found once per point for all flavours
+void pdfreader_all(pdfreaderTables *tables, int n, const double *x, const double *q, double *f);
+
+/// Reads a PDT file, or its binary copy written by Save_pdfreader_tables(...) for a faster start-up. 0 on success
+int Load_pdfreader_tables(pdfreaderTables *tables, char *file);
+int Save_pdfreader_tables(pdfreaderTables *tables, char *file);
+void Unload_pdfreader_tables(pdfreaderTables *tables);
+
+/// The same with one set of tables for the whole program
 double pdfreader(long pNum, double x, double q);
 
 void Load_pdfreader(char *file);
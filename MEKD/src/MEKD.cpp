@@ -353,7 +353,7 @@ int MEKD::computeKD( string processA, string processB,
 	
 	/// Looking for the precalculated MEs
 	if( ME_ZZ == 0 ) { cerr << "ERROR! The requested process has not been precalculated.\n" ; return ERR_PROCESS; }
-	else if( m_processA=="ZZ" )			me2processA = ME_ZZ;
+	else if( m_processA=="qqZZ" )		me2processA = ME_ZZ;
 	else if( m_processA=="ggSpin0Pm" )	me2processA = ME_Spin0PSMH;
 	else if( m_processA=="ggSpin0M" )	me2processA = ME_Spin0M;
 	else if( m_processA=="ggSpin0Ph" )	me2processA = ME_Spin0Ph;
@@ -366,7 +366,7 @@ int MEKD::computeKD( string processA, string processB,
 	
 	/// Looking for the precalculated MEs
 	if( ME_ZZ == 0 ) { cerr << "ERROR! The requested process has not been precalculated.\n" ; return ERR_PROCESS; }
-	else if( m_processB=="ZZ" )			me2processB = ME_ZZ;
+	else if( m_processB=="qqZZ" )		me2processB = ME_ZZ;
 	else if( m_processB=="ggSpin0Pm" )	me2processB = ME_Spin0PSMH;
 	else if( m_processB=="ggSpin0M" )	me2processB = ME_Spin0M;
 	else if( m_processB=="ggSpin0Ph" )	me2processB = ME_Spin0Ph;
@@ -567,7 +567,7 @@ int MEKD::computeMEs( vector<double*> input_Ps, vector<int> input_IDs )
 		MEKD_MG_Calc.Test_Models.push_back( "ggSpin2Pm" );
 		MEKD_MG_Calc.Test_Models.push_back( "qqSpin2Pm" );
 	}
-	else if( MEKD_MG_Calc.Test_Models.size()!=4 ) return ERR_PROCESS;
+	else if( MEKD_MG_Calc.Test_Models.size()!=8 ) return ERR_PROCESS;
 	
 	/// Set input-particle kinematics
 	MEKD_MG_Calc.p1 = input_Ps[0];
@@ -3,7 +3,7 @@
 
 /// C++ libraries
 #include <iostream>
-// #include <fstream>
+#include <fstream>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -35,7 +35,6 @@
 extern "C"
 {
 #include "Extra_code/MEKD_CalcHEP_PDF.h"
-#include "PDFTables/pdt.h"
 }
 
 #include "Extra_code/MEKD_CalcHEP_Extra_functions.h"
@@ -48,10 +47,6 @@ extern "C"
 using namespace std;
 
 
-/// Part of pdfreader
-extern "C" pdtStr pdtSg, pdtSd, pdtSu, pdtSs, pdtSc,
-	pdtSad, pdtSau, pdtSas, pdtSac;
-
 // #define PDTFILE "PDFTables/cteq6l.pdt" // CalCHEP reads a table for CTEQ6L. You can change PDF set as you want.
 
 
@@ -440,7 +435,7 @@ MEKD_MG::~MEKD_MG()
 	delete Mixing_Coefficients_Spin2;
 	delete Mixing_Coefficients_Spin2_internal;
 	
-	if( Parameters_Are_Loaded ) Unload_pdfreader();
+	if( Parameters_Are_Loaded ) Unload_pdfreader_tables( &PDF_tables );
 	
 	p_set.clear();
 	id_set.clear();
@@ -451,6 +446,7 @@ MEKD_MG::~MEKD_MG()
 int MEKD_MG::Load_Parameters()
 {
 	Set_Of_Model_Parameters.read_slha_file( Parameter_file );
+	Model_Parameters.setIndependentParameters( Set_Of_Model_Parameters );
 	
 	/// Initializing parameters
 	// ZZ
@@ -685,7 +681,8 @@ int MEKD_MG::Load_Parameters()
 	hZZ_coupling = 2.0*params_m_Z*params_m_Z/v_expectation;
 	
 	
-	Load_pdfreader( const_cast<char*>(PDF_file.c_str()) );
+	Load_Helicities();
+	if( (error_value=Load_pdfreader_tables( &PDF_tables, const_cast<char*>(PDF_file.c_str()) )) != 0 ) { cerr << "Setting-up pdfreader has failed! Error number: " << error_value << ". Exiting.\n"; exit(1); }
 	
 	Parameters_Are_Loaded = true;
 	return 0;
@@ -698,6 +695,7 @@ int MEKD_MG::Reload_Parameters()
 	if( !Parameters_Are_Loaded ) return 1;
 	
 	Set_Of_Model_Parameters.read_slha_file( static_cast<string>(Parameter_file) );
+	Model_Parameters.setIndependentParameters( Set_Of_Model_Parameters );
 	
 	params_m_d = Set_Of_Model_Parameters.get_block_entry( "mass", 1, 0 ).real();
 	params_m_u = Set_Of_Model_Parameters.get_block_entry( "mass", 2, 0 ).real();
@@ -764,14 +762,207 @@ int MEKD_MG::Reload_Parameters()
 	hZZ_coupling = 2.0*params_m_Z*params_m_Z/v_expectation;
 	
 	
-	Unload_pdfreader();
-	Load_pdfreader( const_cast<char*>(PDF_file.c_str()) );
+	Load_Helicities();
+	Unload_pdfreader_tables( &PDF_tables );
+	if( (error_value=Load_pdfreader_tables( &PDF_tables, const_cast<char*>(PDF_file.c_str()) )) != 0 ) { cerr << "Setting-up pdfreader has failed! Error number: " << error_value << ". Exiting.\n"; exit(1); }
+	
+	return 0;
+}
+
+
+
+/// Reads the non-vanishing helicities saved in Helicity_file, if any, and hands them or the warm-up to the MEs
+int MEKD_MG::Load_Helicities()
+{
+	Good_Helicities.clear();
+	
+	if( Helicity_file!="" )
+	{
+		ifstream helicity_input( Helicity_file.c_str() );
+		string ME_name;
+		unsigned int N_helicities;
+		
+		if( !helicity_input.good() && Warning_Mode ) cout << "Warning. Helicity file " << Helicity_file << " could not be read. Warming up the MEs instead.\n";
+		
+		while( helicity_input >> ME_name >> N_helicities )
+		{
+			vector<int> &helicities=Good_Helicities[ME_name];
+			helicities.resize( N_helicities );
+			for( unsigned int count=0; count < N_helicities; count++ ) helicity_input >> helicities[count];
+		}
+	}
 	
+	Exchange_All_Helicities( false );
 	return 0;
 }
 
 
 
+int MEKD_MG::Save_Helicities()
+{
+	if( Helicity_file=="" || !Parameters_Are_Loaded ) return 1;
+	
+	Exchange_All_Helicities( true );
+	
+	ofstream helicity_output( Helicity_file.c_str() );
+	if( !helicity_output.good() ) { if( Warning_Mode ) cout << "Warning. Cannot write helicity file " << Helicity_file << endl; return 1; }
+	
+	for( map<string, vector<int> >::const_iterator it=Good_Helicities.begin(); it!=Good_Helicities.end(); it++ )
+	{
+		helicity_output << it->first << " " << it->second.size();
+		for( unsigned int count=0; count < it->second.size(); count++ ) helicity_output << " " << it->second[count];
+		helicity_output << endl;
+	}
+	
+	return 0;
+}
+
+
+
+template<class Generic_MEKD_MG_ME>
+void MEKD_MG::Exchange_Helicities(Generic_MEKD_MG_ME &Generic_ME, bool Save)
+{
+	if( Save )
+	{
+		vector<int> helicities;
+		if( Generic_ME.getGoodHelicities( helicities ) ) Good_Helicities[Generic_ME.className()] = helicities;
+		return;
+	}
+	
+	map<string, vector<int> >::const_iterator it=Good_Helicities.find( Generic_ME.className() );
+	if( it!=Good_Helicities.end() ) Generic_ME.setGoodHelicities( it->second );
+	else Generic_ME.setHelicityWarmUp( Helicity_warm_up_events > 0 ? Helicity_warm_up_events : -1 );
+}
+
+
+
+/// Save: collects the helicities of the warmed-up MEs. Otherwise: hands the loaded helicities or the warm-up to the MEs
+void MEKD_MG::Exchange_All_Helicities(bool Save)
+{
+	Exchange_Helicities( ME_qq_Z4l_SIG_DownType_OF, Save );
+	Exchange_Helicities( ME_qq_Z4l_SIG_DownType_SF, Save );
+	Exchange_Helicities( ME_qq_Z4l_SIG_UpType_OF, Save );
+	Exchange_Helicities( ME_qq_Z4l_SIG_UpType_SF, Save );
+	Exchange_Helicities( ME_qq_Z4l_SIG_DownType_OFpA, Save );
+	Exchange_Helicities( ME_qq_Z4l_SIG_DownType_SFpA, Save );
+	Exchange_Helicities( ME_qq_Z4l_SIG_UpType_OFpA, Save );
+	Exchange_Helicities( ME_qq_Z4l_SIG_UpType_SFpA, Save );
+	Exchange_Helicities( ME_qq_Z4l_BKG_DownType_OF, Save );
+	Exchange_Helicities( ME_qq_Z4l_BKG_DownType_SF, Save );
+	Exchange_Helicities( ME_qq_Z4l_BKG_UpType_OF, Save );
+	Exchange_Helicities( ME_qq_Z4l_BKG_UpType_SF, Save );
+	Exchange_Helicities( ME_qq_Z4l_BKG_DownType_OFpA, Save );
+	Exchange_Helicities( ME_qq_Z4l_BKG_DownType_SFpA, Save );
+	Exchange_Helicities( ME_qq_Z4l_BKG_UpType_OFpA, Save );
+	Exchange_Helicities( ME_qq_Z4l_BKG_UpType_SFpA, Save );
+	Exchange_Helicities( ME_qq_ZZ_DownType_OF, Save );
+	Exchange_Helicities( ME_qq_ZZ_DownType_SF, Save );
+	Exchange_Helicities( ME_qq_ZZ_UpType_OF, Save );
+	Exchange_Helicities( ME_qq_ZZ_UpType_SF, Save );
+	Exchange_Helicities( ME_qq_ZZ_DownType_OFpA, Save );
+	Exchange_Helicities( ME_qq_ZZ_DownType_SFpA, Save );
+	Exchange_Helicities( ME_qq_ZZ_UpType_OFpA, Save );
+	Exchange_Helicities( ME_qq_ZZ_UpType_SFpA, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin0_OF, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin0_SF, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin0_OFpA, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin0_SFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_DownType_OF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_DownType_SF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_UpType_OF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_UpType_SF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_DownType_OFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_DownType_SFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_UpType_OFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_UpType_SFpA, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin2_OF, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin2_SF, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin2_OFpA, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin2_SFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_DownType_OF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_DownType_SF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_UpType_OF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_UpType_SF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_DownType_OFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_DownType_SFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_UpType_OFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_UpType_SFpA, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin0_2f_OF, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin0_2f_SF, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin0_2f_OFpA, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin0_2f_SFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_2f_DownType_OF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_2f_DownType_SF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_2f_UpType_OF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_2f_UpType_SF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_2f_DownType_OFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_2f_DownType_SFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_2f_UpType_OFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_2f_UpType_SFpA, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin2_2f_OF, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin2_2f_SF, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin2_2f_OFpA, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin2_2f_SFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_2f_DownType_OF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_2f_DownType_SF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_2f_UpType_OF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_2f_UpType_SF, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_2f_DownType_OFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_2f_DownType_SFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_2f_UpType_OFpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_2f_UpType_SFpA, Save );
+	Exchange_Helicities( ME_DY_2l, Save );
+	Exchange_Helicities( ME_DY_2lpA, Save );
+	Exchange_Helicities( ME_Signal_Spin0_2l, Save );
+	Exchange_Helicities( ME_Signal_Spin0_OF, Save );
+	Exchange_Helicities( ME_Signal_Spin0_SF, Save );
+	Exchange_Helicities( ME_Signal_Spin0_2f_OF, Save );
+	Exchange_Helicities( ME_Signal_Spin0_2f_SF, Save );
+	Exchange_Helicities( ME_Signal_Spin0_2lpA, Save );
+	Exchange_Helicities( ME_Signal_Spin0_OFpA, Save );
+	Exchange_Helicities( ME_Signal_Spin0_SFpA, Save );
+	Exchange_Helicities( ME_Signal_Spin0_2f_OFpA, Save );
+	Exchange_Helicities( ME_Signal_Spin0_2f_SFpA, Save );
+	Exchange_Helicities( ME_Signal_Spin1_2l, Save );
+	Exchange_Helicities( ME_Signal_Spin1_OF, Save );
+	Exchange_Helicities( ME_Signal_Spin1_SF, Save );
+	Exchange_Helicities( ME_Signal_Spin1_2f_OF, Save );
+	Exchange_Helicities( ME_Signal_Spin1_2f_SF, Save );
+	Exchange_Helicities( ME_Signal_Spin1_2lpA, Save );
+	Exchange_Helicities( ME_Signal_Spin1_OFpA, Save );
+	Exchange_Helicities( ME_Signal_Spin1_SFpA, Save );
+	Exchange_Helicities( ME_Signal_Spin1_2f_OFpA, Save );
+	Exchange_Helicities( ME_Signal_Spin1_2f_SFpA, Save );
+	Exchange_Helicities( ME_Signal_Spin2_2l, Save );
+	Exchange_Helicities( ME_Signal_Spin2_OF, Save );
+	Exchange_Helicities( ME_Signal_Spin2_SF, Save );
+	Exchange_Helicities( ME_Signal_Spin2_2f_OF, Save );
+	Exchange_Helicities( ME_Signal_Spin2_2f_SF, Save );
+	Exchange_Helicities( ME_Signal_Spin2_2lpA, Save );
+	Exchange_Helicities( ME_Signal_Spin2_OFpA, Save );
+	Exchange_Helicities( ME_Signal_Spin2_SFpA, Save );
+	Exchange_Helicities( ME_Signal_Spin2_2f_OFpA, Save );
+	Exchange_Helicities( ME_Signal_Spin2_2f_SFpA, Save );
+	Exchange_Helicities( ME_qq_DY_DownType_2l, Save );
+	Exchange_Helicities( ME_qq_DY_UpType_2l, Save );
+	Exchange_Helicities( ME_qq_DY_DownType_2lpA, Save );
+	Exchange_Helicities( ME_qq_DY_UpType_2lpA, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin0_2l, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin0_2lpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_DownType_2l, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_UpType_2l, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_DownType_2lpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin1_UpType_2lpA, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin2_2l, Save );
+	Exchange_Helicities( ME_Signal_gg_Spin2_2lpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_DownType_2l, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_UpType_2l, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_DownType_2lpA, Save );
+	Exchange_Helicities( ME_Signal_qq_Spin2_UpType_2lpA, Save );
+}
+
+
+
 void MEKD_MG::Set_Default_MEKD_MG_Parameters()
 {
 	Boost_To_CM = true;	// for a boosted data
@@ -794,6 +985,7 @@ void MEKD_MG::Set_Default_MEKD_MG_Parameters()
 	ContributionCoeff_c = 0;	//3
 // 	GG=0;	// Assign QCD coupling, force g3 running if needed
 	Sqrt_s = 8000;	//Max energy, collision energy
+	Helicity_warm_up_events = -1;	// no helicity filtering
 	
 	Mixing_Coefficients_Spin0[0] = complex<double>(1/sqrt(4), 0);
 	Mixing_Coefficients_Spin0[1] = complex<double>(1/sqrt(4), 0);
@@ -814,6 +1006,7 @@ void MEKD_MG::Set_Default_MEKD_MG_Parameters()
 	Proton_mass = 0.93827205;	// Always used if needed
 	
 	Final_state = "2e2m";	// Final state, for the moment: 4e, 4mu, 2e2mu
+	Final_state_internal = FS_2e2mu;
 	Resonance_decay_mode = "ZZ";	// default: ZZ. Alternatives: 2l, 2l_s
 	Test_Model = "ggSpin0Pm";	// Models: ZZ, DY, Custom, ggSpin0Pm, ggSpin0M, ggSpin0Ph, qqSpin1P, qqSpin1M, ggSpin2Pm, ggSpin2Ph, ggSpin2Mh, ggSpin2Pb, qqSpin2Pm, qqSpin2Ph, qqSpin2Mh, qqSpin2Pb, Spin0Pm, Spin0M, Spin0Ph, Spin1P, Spin1M, Spin2Pm, Spin2Ph, Spin2Mh, Spin2Pb
 	
@@ -828,11 +1021,26 @@ void MEKD_MG::Set_Default_MEKD_MG_Parameters()
 	Parameter_file = "../src/Cards/param_card.dat";	// Location where a parameter card is stored
 	PDF_file = "../src/PDFTables/cteq6l.pdt";	// PDF/PDT table file
 #endif
+	Helicity_file = "";	// no saved helicities
 }
 
 
 
 int MEKD_MG::Run_MEKD_MG()
+{
+	/// '!' in Test_Model runs the signal only. Model names are resolved again only if Test_Models changed.
+	if( Test_Models.size() > 0 && Test_Model[0]!='!' )
+	{
+		if( Test_Models!=Resolved_Test_Models_Names ) Resolve_Test_Models();
+		return Run_MEKD_MG_Models( &(Resolved_Test_Models[0]), Resolved_Test_Models.size(), Test_Models[0][0]!='!', true, true );
+	}
+	
+	return Run_MEKD_MG_Models( &Resolve_Model_Cached( Test_Model ), 1, ( Test_Models.size()>0 ? Test_Models[0][0]!='!' : Test_Model[0]!='!' ), false, Test_Model[0]!='!' );
+}
+
+
+
+int MEKD_MG::Run_MEKD_MG_Models(const Resolved_Model *Models, unsigned int N_models, bool Compute_background, bool Fill_Signal_MEs, bool Compute_KD)
 {
 	if( !Parameters_Are_Loaded ) Load_Parameters();
 	if( Arrange_Internal_pls() == 1 ) { cerr << "Particle id error. Exiting.\n"; exit(1); }
@@ -846,21 +1054,21 @@ int MEKD_MG::Run_MEKD_MG()
 	
 	if( Overwrite_e_and_mu_masses )
 	{
-		Set_Of_Model_Parameters.set_block_entry( "mass", 11, Electron_mass );
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, Muon_mass );
+		Model_Parameters.Me = Electron_mass;
+		Model_Parameters.MM = Muon_mass;
 		params_m_e = Electron_mass;
 		params_m_mu = Muon_mass;
 	}
 	
-	if( Final_state == "4e" || Final_state == "4eA" )
-		{ ml1=Set_Of_Model_Parameters.get_block_entry( "mass", 11, Electron_mass ).real(); ml2=ml1; ml3=ml1; ml4=ml1; }
-	if( Final_state == "4m" || Final_state == "4mu" || Final_state == "4mA" || Final_state == "4muA" )
-		{ ml1=Set_Of_Model_Parameters.get_block_entry( "mass", 13, Muon_mass ).real(); ml2=ml1; ml3=ml1; ml4=ml1; }
-	if( Final_state == "2e2m" || Final_state == "2e2mu" || Final_state == "2e2mA" || Final_state == "2e2muA" )
-		{ ml1=Set_Of_Model_Parameters.get_block_entry( "mass", 11, Electron_mass ).real(); ml2=ml1; ml3=Set_Of_Model_Parameters.get_block_entry( "mass", 13, Muon_mass ).real(); ml4=ml3; }
+	if( Final_state_internal==FS_4e || Final_state_internal==FS_4eA )
+		{ ml1=Model_Parameters.Me; ml2=ml1; ml3=ml1; ml4=ml1; }
+	if( Final_state_internal==FS_4mu || Final_state_internal==FS_4muA )
+		{ ml1=Model_Parameters.MM; ml2=ml1; ml3=ml1; ml4=ml1; }
+	if( Final_state_internal==FS_2e2mu || Final_state_internal==FS_2e2muA )
+		{ ml1=Model_Parameters.Me; ml2=ml1; ml3=Model_Parameters.MM; ml4=ml3; }
 		
-	if( Final_state == "2m" || Final_state == "2mu" || Final_state == "2mA" || Final_state == "2muA" )
-		{ ml1=Set_Of_Model_Parameters.get_block_entry( "mass", 13, Muon_mass ).real(); ml2=ml1; ml3=0; ml4=0; }
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA )
+		{ ml1=Model_Parameters.MM; ml2=ml1; ml3=0; ml4=0; }
 	
 	
 	/// No boosting setup for initial partons
@@ -882,7 +1090,7 @@ int MEKD_MG::Run_MEKD_MG()
 		if( pA1_internal == NULL ) p_set[6][i] = 0;
 		else
 		{
-			if( Final_state == "2mA" || Final_state == "2muA" )
+			if( Final_state_internal==FS_2muA )
 			{
 				p_set[4][i] = pA1_internal[i];
 				p_set[6][i] = 0;
@@ -950,6 +1158,14 @@ int MEKD_MG::Run_MEKD_MG()
 		- (p_set[2][3]+p_set[3][3]+p_set[4][3]+p_set[5][3]+p_set[6][3])*(p_set[2][3]+p_set[3][3]+p_set[4][3]+p_set[5][3]+p_set[6][3]) );
 	
 	
+	/// PDFs of all flavours at both x values, shared by all models of the event
+	if( Use_PDF_w_pT0 )
+	{
+		double PDF_x[2] = { PDFx1, PDFx2 }, PDF_q[2] = { Mass_4l, Mass_4l };
+		pdfreader_all( &PDF_tables, 2, PDF_x, PDF_q, PDF_values );
+	}
+	
+	
 	/// Pick quark flavors to use if PDFs are not set. Normalizing coefficients here.
 	if( !Use_PDF_w_pT0 )
 	{
@@ -980,286 +1196,221 @@ int MEKD_MG::Run_MEKD_MG()
 	
 	
 	/// Background is interesting in any case, except for the Signal Runs or '!' is indicated in the first model to save CPU
-	if( Test_Model[0]!='!' && Test_Models.size() == 0 ) { Run_MEKD_MG_ME_Configurator_BKG_ZZ( "qq" ); Background_ME=Signal_ME; }
-	else if( Test_Models.size() > 0 )
+	if( Compute_background ) { Run_MEKD_MG_ME_Configurator_BKG_ZZ( IS_qq ); Background_ME=Signal_ME; }
+	
+	
+	/// Signal ME(s) from the resolved models
+	if( Fill_Signal_MEs ) Signal_MEs.clear();
+	
+	for( counter=0; counter<N_models; counter++ )
 	{
-		if( Test_Models[0][0]!='!' ) { Run_MEKD_MG_ME_Configurator_BKG_ZZ( "qq" ); Background_ME=Signal_ME; }
+		if( Models[counter].Configurator!=NULL )
+		{
+			Resonance_decay_mode_internal = Models[counter].Decay_mode;
+			(this->*(Models[counter].Configurator))( Models[counter].Initial_state );
+		}
+		
+		if( Debug_Mode ) cout << "Evaluated model: " << Models[counter].Name << "; calculated ME: " << Signal_ME << endl;
+		
+		if( Fill_Signal_MEs ) Signal_MEs.push_back( Signal_ME );
 	}
 	
 	
-	/// Signal ME(s) is(are) chosen here
-	if( Test_Models.size() > 0 && Test_Model[0]!='!' )
+	if( Debug_Mode )
 	{
-		Signal_MEs.clear();
-		Test_Model_buffer = &(Test_Models[0]);	// Should be NULL or undefined before this point; works as counter=0
+		printf( "Status after ME calculations are over:\n" );
+		printf( "Energy of Parton 1: %.10E\nEnergy of Parton 2: %.10E\n", p_set[0][0], p_set[1][0] );
+		printf( "Final-state four-momenta exiting ME(s) (E px py px):\n" );
+		printf( "%.10E %.10E %.10E %.10E\n", p_set[2][0], p_set[2][1], p_set[2][2], p_set[2][3] );
+		printf( "%.10E %.10E %.10E %.10E\n", p_set[3][0], p_set[3][1], p_set[3][2], p_set[3][3] );
+		printf( "%.10E %.10E %.10E %.10E\n", p_set[4][0], p_set[4][1], p_set[4][2], p_set[4][3] );
+		printf( "%.10E %.10E %.10E %.10E\n", p_set[5][0], p_set[5][1], p_set[5][2], p_set[5][3] );
+		printf( "%.10E %.10E %.10E %.10E\n", p_set[6][0], p_set[6][1], p_set[6][2], p_set[6][3] );
+		printf( "Sum px=%.10E\n", (p_set[2][1]+p_set[3][1]+p_set[4][1]+p_set[5][1]+p_set[6][1]) );
+		printf( "Sum py=%.10E\n", (p_set[2][2]+p_set[3][2]+p_set[4][2]+p_set[5][2]+p_set[6][2]) );
+		printf( "Sum pz=%.10E\n", (p_set[2][3]+p_set[3][3]+p_set[4][3]+p_set[5][3]+p_set[6][3]) );
+		printf( "Sum E=%.10E\n", (p_set[2][0]+p_set[3][0]+p_set[4][0]+p_set[5][0]+p_set[6][0]) );
 	}
-	else
-		Test_Model_buffer = &Test_Model;	// Should be NULL or undefined before this point
 	
-	counter = 1;
-	while( Test_Model_buffer!=NULL )
-	{
+	
+	if( Compute_KD ) KD = log( Signal_ME/Background_ME );
+	
+	return 0;
+}
+
+
+
+int MEKD_MG::Run_MEKD_MG(string Input_Model)
+{
+	return Run_MEKD_MG_Models( &Resolve_Model_Cached( Input_Model ), 1, ( Test_Models.size()>0 && Test_Models[0][0]!='!' ), false, false );
+}
+
+
+
+/// Looks up a model name in the table below. A leading '!' is ignored. Unknown names get no configurator.
+int MEKD_MG::Resolve_Model(string Input_Model, Resolved_Model &Model)
+{
+	struct Model_Entry { const char *Name; Configurator_ptr Configurator; Initial_state_id Initial_state; Resonance_decay_mode_id Decay_mode; };
+	static const Model_Entry Models[] = {
 		// Is it a parameter card defined?
-		if( (*Test_Model_buffer)=="Custom" || (*Test_Model_buffer)=="!Custom" )
-			Run_MEKD_MG_ME_Configurator_Custom();
-		
+		{ "Custom", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Custom, IS_NO, RDM_ZZ },
 		
 		// Is it a "background"?
-		else if( (*Test_Model_buffer)=="qqZZ" || (*Test_Model_buffer)=="!qqZZ" )
-			Run_MEKD_MG_ME_Configurator_BKG_ZZ( "qq" );
-		else if( (*Test_Model_buffer)==  "ZZ" || (*Test_Model_buffer)==  "!ZZ" )
-			Run_MEKD_MG_ME_Configurator_BKG_ZZ( "qq" );
-			
-		else if( (*Test_Model_buffer)=="qqDY" || (*Test_Model_buffer)=="!qqDY" )
-			Run_MEKD_MG_ME_Configurator_BKG_ZZ( "qq" );
-		else if( (*Test_Model_buffer)==  "DY" || (*Test_Model_buffer)==  "!DY" )
-			Run_MEKD_MG_ME_Configurator_BKG_ZZ( "NO" );
-		
+		{ "qqZZ", &MEKD_MG::Run_MEKD_MG_ME_Configurator_BKG_ZZ, IS_qq, RDM_ZZ },
+		{ "ZZ", &MEKD_MG::Run_MEKD_MG_ME_Configurator_BKG_ZZ, IS_qq, RDM_ZZ },
+		{ "qqDY", &MEKD_MG::Run_MEKD_MG_ME_Configurator_BKG_ZZ, IS_qq, RDM_ZZ },
+		{ "DY", &MEKD_MG::Run_MEKD_MG_ME_Configurator_BKG_ZZ, IS_NO, RDM_ZZ },
 		
 		// Is it a Z boson resonance?
-		else if( (*Test_Model_buffer)=="qqZ4l_Background" || (*Test_Model_buffer)=="!qqZ4l_Background" )
-			Run_MEKD_MG_ME_Configurator_Z4l_BKG( "qq" );
-		else if( (*Test_Model_buffer)=="qqZ4l_Signal" || (*Test_Model_buffer)=="!qqZ4l_Signal" )
-			Run_MEKD_MG_ME_Configurator_Z4l_SIG( "qq" );
-		
+		{ "qqZ4l_Background", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Z4l_BKG, IS_qq, RDM_ZZ },
+		{ "qqZ4l_Signal", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Z4l_SIG, IS_qq, RDM_ZZ },
 		
 		/// Resonance to ZZ decay modes (with exceptions for 2l, 2l+A states). Final states: 4 leptons (+photon) also 2 muons (+photon)
-		Resonance_decay_mode = "ZZ";
-		
 		// Is it a spin-0 resonance?
-		if(      (*Test_Model_buffer)=="ggSpin0Pm" || (*Test_Model_buffer)=="!ggSpin0Pm" )	// SM Higgs
-			Run_MEKD_MG_ME_Configurator_Spin0Pm( "gg" );
-		else if( (*Test_Model_buffer)==  "Spin0Pm" || (*Test_Model_buffer)==  "!Spin0Pm" )
-			Run_MEKD_MG_ME_Configurator_Spin0Pm( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin0M" || (*Test_Model_buffer)=="!ggSpin0M" )
-			Run_MEKD_MG_ME_Configurator_Spin0M( "gg" );
-		else if( (*Test_Model_buffer)==  "Spin0M" || (*Test_Model_buffer)==  "!Spin0M" )
-			Run_MEKD_MG_ME_Configurator_Spin0M( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin0Ph" || (*Test_Model_buffer)=="!ggSpin0Ph" )
-			Run_MEKD_MG_ME_Configurator_Spin0Ph( "gg" );
-		else if( (*Test_Model_buffer)==  "Spin0Ph" || (*Test_Model_buffer)==  "!Spin0Ph" )
-			Run_MEKD_MG_ME_Configurator_Spin0Ph( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin0" || (*Test_Model_buffer)=="!ggSpin0" )
-			Run_MEKD_MG_ME_Configurator_Spin0( "gg" );
-		else if( (*Test_Model_buffer)==  "Spin0" || (*Test_Model_buffer)==  "!Spin0" )
-			Run_MEKD_MG_ME_Configurator_Spin0( "NO" );
-		
+		{ "ggSpin0Pm", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Pm, IS_gg, RDM_ZZ },	// SM Higgs
+		{ "Spin0Pm", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Pm, IS_NO, RDM_ZZ },
+		{ "ggSpin0M", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0M, IS_gg, RDM_ZZ },
+		{ "Spin0M", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0M, IS_NO, RDM_ZZ },
+		{ "ggSpin0Ph", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Ph, IS_gg, RDM_ZZ },
+		{ "Spin0Ph", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Ph, IS_NO, RDM_ZZ },
+		{ "ggSpin0", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0, IS_gg, RDM_ZZ },
+		{ "Spin0", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0, IS_NO, RDM_ZZ },
 		
 		// Is it a spin-1 resonance?
-		else if( (*Test_Model_buffer)=="qqSpin1M" || (*Test_Model_buffer)=="!qqSpin1M" )
-			Run_MEKD_MG_ME_Configurator_Spin1M( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin1M" || (*Test_Model_buffer)==  "!Spin1M" )
-			Run_MEKD_MG_ME_Configurator_Spin1M( "NO" );
-		
-		else if( (*Test_Model_buffer)=="qqSpin1P" || (*Test_Model_buffer)=="!qqSpin1P" )
-			Run_MEKD_MG_ME_Configurator_Spin1P( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin1P" || (*Test_Model_buffer)==  "!Spin1P" )
-			Run_MEKD_MG_ME_Configurator_Spin1P( "NO" );
-		
-		else if( (*Test_Model_buffer)=="qqSpin1" || (*Test_Model_buffer)=="!qqSpin1" )
-			Run_MEKD_MG_ME_Configurator_Spin1( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin1" || (*Test_Model_buffer)==  "!Spin1" )
-			Run_MEKD_MG_ME_Configurator_Spin1( "NO" );
-		
+		{ "qqSpin1M", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1M, IS_qq, RDM_ZZ },
+		{ "Spin1M", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1M, IS_NO, RDM_ZZ },
+		{ "qqSpin1P", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1P, IS_qq, RDM_ZZ },
+		{ "Spin1P", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1P, IS_NO, RDM_ZZ },
+		{ "qqSpin1", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1, IS_qq, RDM_ZZ },
+		{ "Spin1", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1, IS_NO, RDM_ZZ },
 		
 		// Is it a spin-2 resonance?
-		else if( (*Test_Model_buffer)=="ggSpin2Pm" || (*Test_Model_buffer)=="!ggSpin2Pm" )
-			Run_MEKD_MG_ME_Configurator_Spin2Pm( "gg" );
-		else if( (*Test_Model_buffer)=="qqSpin2Pm" || (*Test_Model_buffer)=="!qqSpin2Pm" )
-			Run_MEKD_MG_ME_Configurator_Spin2Pm( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin2Pm" || (*Test_Model_buffer)==  "!Spin2Pm" )
-			Run_MEKD_MG_ME_Configurator_Spin2Pm( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin2Ph" || (*Test_Model_buffer)=="!ggSpin2Ph" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph( "gg" );
-		else if( (*Test_Model_buffer)=="qqSpin2Ph" || (*Test_Model_buffer)=="!qqSpin2Ph" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin2Ph" || (*Test_Model_buffer)==  "!Spin2Ph" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin2Mh" || (*Test_Model_buffer)=="!ggSpin2Mh" )
-			Run_MEKD_MG_ME_Configurator_Spin2Mh( "gg" );
-		else if( (*Test_Model_buffer)=="qqSpin2Mh" || (*Test_Model_buffer)=="!qqSpin2Mh" )
-			Run_MEKD_MG_ME_Configurator_Spin2Mh( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin2Mh" || (*Test_Model_buffer)==  "!Spin2Mh" )
-			Run_MEKD_MG_ME_Configurator_Spin2Mh( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin2Pb" || (*Test_Model_buffer)=="!ggSpin2Pb" )
-			Run_MEKD_MG_ME_Configurator_Spin2Pb( "gg" );
-		else if( (*Test_Model_buffer)=="qqSpin2Pb" || (*Test_Model_buffer)=="!qqSpin2Pb" )
-			Run_MEKD_MG_ME_Configurator_Spin2Pb( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin2Pb" || (*Test_Model_buffer)==  "!Spin2Pb" )
-			Run_MEKD_MG_ME_Configurator_Spin2Pb( "NO" );
-		
-		
-		else if( (*Test_Model_buffer)=="ggSpin2Ph2" || (*Test_Model_buffer)=="!ggSpin2Ph2" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph2( "gg" );
-		else if( (*Test_Model_buffer)=="qqSpin2Ph2" || (*Test_Model_buffer)=="!qqSpin2Ph2" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph2( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin2Ph2" || (*Test_Model_buffer)==  "!Spin2Ph2" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph2( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin2Ph3" || (*Test_Model_buffer)=="!ggSpin2Ph3" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph3( "gg" );
-		else if( (*Test_Model_buffer)=="qqSpin2Ph3" || (*Test_Model_buffer)=="!qqSpin2Ph3" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph3( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin2Ph3" || (*Test_Model_buffer)==  "!Spin2Ph3" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph3( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin2Ph6" || (*Test_Model_buffer)=="!ggSpin2Ph6" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph6( "gg" );
-		else if( (*Test_Model_buffer)=="qqSpin2Ph6" || (*Test_Model_buffer)=="!qqSpin2Ph6" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph6( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin2Ph6" || (*Test_Model_buffer)==  "!Spin2Ph6" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph6( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin2Ph7" || (*Test_Model_buffer)=="!ggSpin2Ph7" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph7( "gg" );
-		else if( (*Test_Model_buffer)=="qqSpin2Ph7" || (*Test_Model_buffer)=="!qqSpin2Ph7" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph7( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin2Ph7" || (*Test_Model_buffer)==  "!Spin2Ph7" )
-			Run_MEKD_MG_ME_Configurator_Spin2Ph7( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin2Mh9" || (*Test_Model_buffer)=="!ggSpin2Mh9" )
-			Run_MEKD_MG_ME_Configurator_Spin2Mh9( "gg" );
-		else if( (*Test_Model_buffer)=="qqSpin2Mh9" || (*Test_Model_buffer)=="!qqSpin2Mh9" )
-			Run_MEKD_MG_ME_Configurator_Spin2Mh9( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin2Mh9" || (*Test_Model_buffer)==  "!Spin2Mh9" )
-			Run_MEKD_MG_ME_Configurator_Spin2Mh9( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin2Mh10" || (*Test_Model_buffer)=="!ggSpin2Mh10" )
-			Run_MEKD_MG_ME_Configurator_Spin2Mh10( "gg" );
-		else if( (*Test_Model_buffer)=="qqSpin2Mh10" || (*Test_Model_buffer)=="!qqSpin2Mh10" )
-			Run_MEKD_MG_ME_Configurator_Spin2Mh10( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin2Mh10" || (*Test_Model_buffer)==  "!Spin2Mh10" )
-			Run_MEKD_MG_ME_Configurator_Spin2Mh10( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin2" || (*Test_Model_buffer)=="!ggSpin2" )
-			Run_MEKD_MG_ME_Configurator_Spin2( "gg" );
-		else if( (*Test_Model_buffer)=="qqSpin2" || (*Test_Model_buffer)=="!qqSpin2" )
-			Run_MEKD_MG_ME_Configurator_Spin2( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin2" || (*Test_Model_buffer)==  "!Spin2" )
-			Run_MEKD_MG_ME_Configurator_Spin2( "NO" );
-		
-		
+		{ "ggSpin2Pm", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm, IS_gg, RDM_ZZ },
+		{ "qqSpin2Pm", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm, IS_qq, RDM_ZZ },
+		{ "Spin2Pm", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm, IS_NO, RDM_ZZ },
+		{ "ggSpin2Ph", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph, IS_gg, RDM_ZZ },
+		{ "qqSpin2Ph", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph, IS_qq, RDM_ZZ },
+		{ "Spin2Ph", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph, IS_NO, RDM_ZZ },
+		{ "ggSpin2Mh", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh, IS_gg, RDM_ZZ },
+		{ "qqSpin2Mh", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh, IS_qq, RDM_ZZ },
+		{ "Spin2Mh", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh, IS_NO, RDM_ZZ },
+		{ "ggSpin2Pb", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pb, IS_gg, RDM_ZZ },
+		{ "qqSpin2Pb", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pb, IS_qq, RDM_ZZ },
+		{ "Spin2Pb", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pb, IS_NO, RDM_ZZ },
+		{ "ggSpin2Ph2", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph2, IS_gg, RDM_ZZ },
+		{ "qqSpin2Ph2", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph2, IS_qq, RDM_ZZ },
+		{ "Spin2Ph2", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph2, IS_NO, RDM_ZZ },
+		{ "ggSpin2Ph3", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph3, IS_gg, RDM_ZZ },
+		{ "qqSpin2Ph3", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph3, IS_qq, RDM_ZZ },
+		{ "Spin2Ph3", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph3, IS_NO, RDM_ZZ },
+		{ "ggSpin2Ph6", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph6, IS_gg, RDM_ZZ },
+		{ "qqSpin2Ph6", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph6, IS_qq, RDM_ZZ },
+		{ "Spin2Ph6", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph6, IS_NO, RDM_ZZ },
+		{ "ggSpin2Ph7", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph7, IS_gg, RDM_ZZ },
+		{ "qqSpin2Ph7", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph7, IS_qq, RDM_ZZ },
+		{ "Spin2Ph7", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph7, IS_NO, RDM_ZZ },
+		{ "ggSpin2Mh9", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh9, IS_gg, RDM_ZZ },
+		{ "qqSpin2Mh9", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh9, IS_qq, RDM_ZZ },
+		{ "Spin2Mh9", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh9, IS_NO, RDM_ZZ },
+		{ "ggSpin2Mh10", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh10, IS_gg, RDM_ZZ },
+		{ "qqSpin2Mh10", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh10, IS_qq, RDM_ZZ },
+		{ "Spin2Mh10", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh10, IS_NO, RDM_ZZ },
+		{ "ggSpin2", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2, IS_gg, RDM_ZZ },
+		{ "qqSpin2", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2, IS_qq, RDM_ZZ },
+		{ "Spin2", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2, IS_NO, RDM_ZZ },
 		
 		/// Resonance to 2l decay modes. Final states: 4 leptons (+photon)
-		Resonance_decay_mode = "2l";
-		
 		// Is it a spin-0 resonance?
-		if(      (*Test_Model_buffer)=="ggSpin0Pm_2f" || (*Test_Model_buffer)=="!ggSpin0Pm_2f" )	// SM Higgs
-			Run_MEKD_MG_ME_Configurator_Spin0Pm( "gg" );
-		else if( (*Test_Model_buffer)==  "Spin0Pm_2f" || (*Test_Model_buffer)==  "!Spin0Pm_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin0Pm( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin0M_2f" || (*Test_Model_buffer)=="!ggSpin0M_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin0M( "gg" );
-		else if( (*Test_Model_buffer)==  "Spin0M_2f" || (*Test_Model_buffer)==  "!Spin0M_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin0M( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin0_2f" || (*Test_Model_buffer)=="!ggSpin0_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin0( "gg" );
-		else if( (*Test_Model_buffer)==  "Spin0_2f" || (*Test_Model_buffer)==  "!Spin0_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin0( "NO" );
-		
+		{ "ggSpin0Pm_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Pm, IS_gg, RDM_2l },	// SM Higgs
+		{ "Spin0Pm_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Pm, IS_NO, RDM_2l },
+		{ "ggSpin0M_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0M, IS_gg, RDM_2l },
+		{ "Spin0M_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0M, IS_NO, RDM_2l },
+		{ "ggSpin0_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0, IS_gg, RDM_2l },
+		{ "Spin0_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0, IS_NO, RDM_2l },
 		
 		// Is it a spin-1 resonance?
-		else if( (*Test_Model_buffer)=="qqSpin1M_2f" || (*Test_Model_buffer)=="!qqSpin1M_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin1M( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin1M" || (*Test_Model_buffer)==  "!Spin1M_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin1M( "NO" );
-		
-		else if( (*Test_Model_buffer)=="qqSpin1P_2f" || (*Test_Model_buffer)=="!qqSpin1P_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin1P( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin1P_2f" || (*Test_Model_buffer)==  "!Spin1P_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin1P( "NO" );
-		
-		else if( (*Test_Model_buffer)=="qqSpin1_2f" || (*Test_Model_buffer)=="!qqSpin1_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin1( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin1_2f" || (*Test_Model_buffer)==  "!Spin1_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin1( "NO" );
-		
+		{ "qqSpin1M_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1M, IS_qq, RDM_2l },
+		{ "Spin1M_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1M, IS_NO, RDM_2l },
+		{ "qqSpin1P_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1P, IS_qq, RDM_2l },
+		{ "Spin1P_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1P, IS_NO, RDM_2l },
+		{ "qqSpin1_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1, IS_qq, RDM_2l },
+		{ "Spin1_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1, IS_NO, RDM_2l },
 		
 		// Is it a spin-2 resonance?
-		else if( (*Test_Model_buffer)=="ggSpin2Pm_2f" || (*Test_Model_buffer)=="!ggSpin2Pm_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin2Pm( "gg" );
-		else if( (*Test_Model_buffer)=="qqSpin2Pm_2f" || (*Test_Model_buffer)=="!qqSpin2Pm_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin2Pm( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin2Pm_2f" || (*Test_Model_buffer)==  "!Spin2Pm_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin2Pm( "NO" );
-		
-		else if( (*Test_Model_buffer)=="ggSpin2_2f" || (*Test_Model_buffer)=="!ggSpin2_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin2Pm( "gg" );
-		else if( (*Test_Model_buffer)=="qqSpin2_2f" || (*Test_Model_buffer)=="!qqSpin2_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin2Pm( "qq" );
-		else if( (*Test_Model_buffer)==  "Spin2_2f" || (*Test_Model_buffer)==  "!Spin2_2f" )
-			Run_MEKD_MG_ME_Configurator_Spin2Pm( "NO" );
-		
+		{ "ggSpin2Pm_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm, IS_gg, RDM_2l },
+		{ "qqSpin2Pm_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm, IS_qq, RDM_2l },
+		{ "Spin2Pm_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm, IS_NO, RDM_2l },
+		{ "ggSpin2_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm, IS_gg, RDM_2l },
+		{ "qqSpin2_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm, IS_qq, RDM_2l },
+		{ "Spin2_2f", &MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm, IS_NO, RDM_2l },
 		
 		// Is it a RAW MG5_aMC ME?
-		if(      (*Test_Model_buffer)=="ggCPPProcess" || (*Test_Model_buffer)=="!ggCPPProcess" )	// ME_RAW
-			Run_MEKD_MG_ME_Configurator_CPPProcess( "gg" );
-		else if( (*Test_Model_buffer)=="qqCPPProcess" || (*Test_Model_buffer)=="!qqCPPProcess" )
-			Run_MEKD_MG_ME_Configurator_CPPProcess( "qq" );
-		else if( (*Test_Model_buffer)==  "CPPProcess" || (*Test_Model_buffer)==  "!CPPProcess" )
-			Run_MEKD_MG_ME_Configurator_CPPProcess( "NO" );
-		
-		
-		if( Debug_Mode ) cout << "Evaluated model: " << (*Test_Model_buffer) << "; calculated ME: " << Signal_ME << endl;
-		
-		if( Test_Models.size() > 0 && Test_Model[0]!='!' )
-		{
-			Signal_MEs.push_back( Signal_ME );
-			
-			if( counter < Test_Models.size() )
-				Test_Model_buffer = &(Test_Models[counter]);
-			else
-				Test_Model_buffer = NULL;
-		}
-		else
-			Test_Model_buffer = NULL;
-		
-		counter++;
-	}
+		{ "ggCPPProcess", &MEKD_MG::Run_MEKD_MG_ME_Configurator_CPPProcess, IS_gg, RDM_2l },	// ME_RAW
+		{ "qqCPPProcess", &MEKD_MG::Run_MEKD_MG_ME_Configurator_CPPProcess, IS_qq, RDM_2l },
+		{ "CPPProcess", &MEKD_MG::Run_MEKD_MG_ME_Configurator_CPPProcess, IS_NO, RDM_2l }
+	};
 	
+	if( Input_Model.size()>0 && Input_Model[0]=='!' ) Input_Model.erase( 0, 1 );
 	
-	if( Debug_Mode )
+	Model.Name = "unknown";
+	Model.Configurator = NULL;
+	Model.Initial_state = IS_NO;
+	Model.Decay_mode = RDM_ZZ;
+	
+	for( unsigned int i=0; i<sizeof(Models)/sizeof(Models[0]); i++ )
 	{
-		printf( "Status after ME calculations are over:\n" );
-		printf( "Energy of Parton 1: %.10E\nEnergy of Parton 2: %.10E\n", p_set[0][0], p_set[1][0] );
-		printf( "Final-state four-momenta exiting ME(s) (E px py px):\n" );
-		printf( "%.10E %.10E %.10E %.10E\n", p_set[2][0], p_set[2][1], p_set[2][2], p_set[2][3] );
-		printf( "%.10E %.10E %.10E %.10E\n", p_set[3][0], p_set[3][1], p_set[3][2], p_set[3][3] );
-		printf( "%.10E %.10E %.10E %.10E\n", p_set[4][0], p_set[4][1], p_set[4][2], p_set[4][3] );
-		printf( "%.10E %.10E %.10E %.10E\n", p_set[5][0], p_set[5][1], p_set[5][2], p_set[5][3] );
-		printf( "%.10E %.10E %.10E %.10E\n", p_set[6][0], p_set[6][1], p_set[6][2], p_set[6][3] );
-		printf( "Sum px=%.10E\n", (p_set[2][1]+p_set[3][1]+p_set[4][1]+p_set[5][1]+p_set[6][1]) );
-		printf( "Sum py=%.10E\n", (p_set[2][2]+p_set[3][2]+p_set[4][2]+p_set[5][2]+p_set[6][2]) );
-		printf( "Sum pz=%.10E\n", (p_set[2][3]+p_set[3][3]+p_set[4][3]+p_set[5][3]+p_set[6][3]) );
-		printf( "Sum E=%.10E\n", (p_set[2][0]+p_set[3][0]+p_set[4][0]+p_set[5][0]+p_set[6][0]) );
+		if( Input_Model!=Models[i].Name ) continue;
+		
+		Model.Name = Models[i].Name;
+		Model.Configurator = Models[i].Configurator;
+		Model.Initial_state = Models[i].Initial_state;
+		Model.Decay_mode = Models[i].Decay_mode;
+		return 0;
 	}
 	
+	if( Warning_Mode ) cout << "Warning. Unknown model " << Input_Model << ". Its ME is not evaluated.\n";
+	return 1;
+}
+
+
+
+const MEKD_MG::Resolved_Model& MEKD_MG::Resolve_Model_Cached(const string &Input_Model)
+{
+	map<string, Resolved_Model>::iterator found = Resolved_Models_Cache.find( Input_Model );
+	if( found!=Resolved_Models_Cache.end() ) return found->second;
 	
-	if( Test_Model[0]!='!' ) KD = log( Signal_ME/Background_ME );
+	Resolve_Model( Input_Model, Resolved_Models_Cache[Input_Model] );
+	return Resolved_Models_Cache[Input_Model];
+}
+
+
+
+/// Resolves Test_Models into Resolved_Test_Models. Called only if Test_Models changed since the last call.
+int MEKD_MG::Resolve_Test_Models()
+{
+	Resolved_Test_Models.resize( Test_Models.size() );
+	for( counter=0; counter<Test_Models.size(); counter++ ) Resolved_Test_Models[counter] = Resolve_Model_Cached( Test_Models[counter] );
+	Resolved_Test_Models_Names = Test_Models;
 	
 	return 0;
 }
 
 
 
-int MEKD_MG::Run_MEKD_MG(string Input_Model)
+/// Final_state is only resolved from the string if the particle ids are not set
+int MEKD_MG::Resolve_Final_state()
 {
-	buffer_string = Test_Model;
-	Test_Model = "!";
-	Test_Model += Input_Model;
-	
-	error_value = Run_MEKD_MG();
+	if( Final_state=="4e" ) Final_state_internal = FS_4e;
+	else if( Final_state=="4eA" ) Final_state_internal = FS_4eA;
+	else if( Final_state=="4m" || Final_state=="4mu" ) Final_state_internal = FS_4mu;
+	else if( Final_state=="4mA" || Final_state=="4muA" ) Final_state_internal = FS_4muA;
+	else if( Final_state=="2e2m" || Final_state=="2e2mu" ) Final_state_internal = FS_2e2mu;
+	else if( Final_state=="2e2mA" || Final_state=="2e2muA" ) Final_state_internal = FS_2e2muA;
+	else if( Final_state=="2m" || Final_state=="2mu" ) Final_state_internal = FS_2mu;
+	else if( Final_state=="2mA" || Final_state=="2muA" ) Final_state_internal = FS_2muA;
+	else { Final_state_internal = FS_unknown; return 1; }
 	
-	Test_Model = buffer_string;
-	return error_value;
+	return 0;
 }
 
 
@@ -1277,7 +1428,7 @@ int MEKD_MG::Run_MEKD_MG(string Input_Model)
 
 
 /// ZZ and DY processes
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_BKG_ZZ(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_BKG_ZZ(Initial_state_id initial_state)
 {
 	return Run_MEKD_MG_ME_Dispatcher_BKG_ZZ( initial_state );
 }
@@ -1285,32 +1436,32 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_BKG_ZZ(string initial_state)
 
 
 /// Z4l Background processes (t channel)
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Z4l_BKG(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Z4l_BKG(Initial_state_id initial_state)
 {
-	if( Use_mZ4l_eq_m4l ) Set_Of_Model_Parameters.set_block_entry( "mass", 23, Mass_4l );
+	if( Use_mZ4l_eq_m4l ) Model_Parameters.MZ = Mass_4l;
 	return Run_MEKD_MG_ME_Dispatcher_Z4l_BKG( initial_state );
 }
 
 
 
 /// Z4l Signal processes (s channel)
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Z4l_SIG(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Z4l_SIG(Initial_state_id initial_state)
 {
-	if( Use_mZ4l_eq_m4l ) Set_Of_Model_Parameters.set_block_entry( "mass", 23, Mass_4l );
+	if( Use_mZ4l_eq_m4l ) Model_Parameters.MZ = Mass_4l;
 	return Run_MEKD_MG_ME_Dispatcher_Z4l_SIG( initial_state );
 }
 
 
 
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Custom()
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Custom(Initial_state_id)
 {
-	if( (error_value=Run_MEKD_MG_ME_Dispatcher_SIG_Spin0( "gg" ))!=0 ) return error_value;
+	if( (error_value=Run_MEKD_MG_ME_Dispatcher_SIG_Spin0( IS_gg ))!=0 ) return error_value;
 	buffer_Custom = Signal_ME;
-	if( (error_value=Run_MEKD_MG_ME_Dispatcher_SIG_Spin1( "qq" ))!=0 ) return error_value;
+	if( (error_value=Run_MEKD_MG_ME_Dispatcher_SIG_Spin1( IS_qq ))!=0 ) return error_value;
 	buffer_Custom += Signal_ME;
-	if( (error_value=Run_MEKD_MG_ME_Dispatcher_SIG_Spin2( "gg" ))!=0 ) return error_value;
+	if( (error_value=Run_MEKD_MG_ME_Dispatcher_SIG_Spin2( IS_gg ))!=0 ) return error_value;
 	buffer_Custom += Signal_ME;
-	if( (error_value=Run_MEKD_MG_ME_Dispatcher_SIG_Spin2( "qq" ))!=0 ) return error_value;
+	if( (error_value=Run_MEKD_MG_ME_Dispatcher_SIG_Spin2( IS_qq ))!=0 ) return error_value;
 	Signal_ME += buffer_Custom;
 	
 	return 0;
@@ -1318,7 +1469,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Custom()
 
 
 
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_CPPProcess(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_CPPProcess(Initial_state_id initial_state)
 {
 	return Run_MEKD_MG_ME_Dispatcher_CPPProcess( initial_state );
 }
@@ -1332,7 +1483,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_CPPProcess(string initial_state)
 
 
 /// A SM Higgs
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Pm(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Pm(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
 	Mixing_Coefficients_Spin0_internal[0] = complex<double>(1, 0);	// fits 2l case
@@ -1340,7 +1491,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Pm(string initial_state)
 	Mixing_Coefficients_Spin0_internal[2] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin0_internal[3] = complex<double>(0, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin0_internal[0] = complex<double>(1, 0);
 		Mixing_Coefficients_Spin0_internal[1] = complex<double>(0, 0);
@@ -1352,7 +1503,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Pm(string initial_state)
 
 
 /// A pseudoscalar
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0M(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0M(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
 	Mixing_Coefficients_Spin0_internal[0] = complex<double>(0, 0);
@@ -1360,7 +1511,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0M(string initial_state)
 	Mixing_Coefficients_Spin0_internal[2] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin0_internal[3] = complex<double>(1, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin0_internal[0] = complex<double>(0, 0);
 		Mixing_Coefficients_Spin0_internal[1] = complex<double>(1, 0);
@@ -1372,7 +1523,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0M(string initial_state)
 
 
 /// A scalar with higher-order couplings
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Ph(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Ph(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
 	Mixing_Coefficients_Spin0_internal[0] = complex<double>(0, 0);
@@ -1380,7 +1531,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Ph(string initial_state)
 	Mixing_Coefficients_Spin0_internal[2] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin0_internal[3] = complex<double>(0, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin0_internal[0] = complex<double>(0, 0);
 		Mixing_Coefficients_Spin0_internal[1] = complex<double>(0, 0);
@@ -1398,7 +1549,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0Ph(string initial_state)
 
 
 /// A vector default configuration
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1M(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1M(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
 	Mixing_Coefficients_Spin1_internal[0] = complex<double>(1, 0);	// Production, same for 2l
@@ -1408,7 +1559,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1M(string initial_state)
 	Mixing_Coefficients_Spin1_internal[4] = complex<double>(1, 0);	// Decay
 	Mixing_Coefficients_Spin1_internal[5] = complex<double>(0, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin1_internal[6] = complex<double>(0, 0);
 		Mixing_Coefficients_Spin1_internal[7] = complex<double>(0, 0);
@@ -1420,7 +1571,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1M(string initial_state)
 
 
 /// A vector default configuration
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1P(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1P(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
 	Mixing_Coefficients_Spin1_internal[0] = complex<double>(0, 0);	// Production
@@ -1430,7 +1581,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1P(string initial_state)
 	Mixing_Coefficients_Spin1_internal[4] = complex<double>(0, 0);	// Decay
 	Mixing_Coefficients_Spin1_internal[5] = complex<double>(1, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin1_internal[6] = complex<double>(0, 0);
 		Mixing_Coefficients_Spin1_internal[7] = complex<double>(0, 0);
@@ -1448,10 +1599,10 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1P(string initial_state)
 
 
 /// A minimal-coupling KK graviton
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
-	if( initial_state=="gg" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);	// Production
+	if( initial_state==IS_gg ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);	// Production
 	Mixing_Coefficients_Spin2_internal[1] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[2] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[3] = complex<double>(0, 0);
@@ -1472,7 +1623,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm(string initial_state)
 	Mixing_Coefficients_Spin2_internal[18] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[19] = complex<double>(0, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin2_internal[10] = complex<double>(1, 0);
 		Mixing_Coefficients_Spin2_internal[11] = complex<double>(0, 0);
@@ -1480,8 +1631,8 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm(string initial_state)
 		Mixing_Coefficients_Spin2_internal[13] = complex<double>(0, 0);
 	}
 	
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
 	
 	return Run_MEKD_MG_ME_Configurator_Spin2( initial_state );
 }
@@ -1489,13 +1640,13 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pm(string initial_state)
 
 
 ///
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
 	Mixing_Coefficients_Spin2_internal[0] = complex<double>(0, 0);	// Production
 	Mixing_Coefficients_Spin2_internal[1] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[2] = complex<double>(0, 0);
-	if( initial_state=="gg" ) Mixing_Coefficients_Spin2_internal[3] = complex<double>(1, 0);
+	if( initial_state==IS_gg ) Mixing_Coefficients_Spin2_internal[3] = complex<double>(1, 0);
 	Mixing_Coefficients_Spin2_internal[4] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[5] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[6] = complex<double>(0, 0);
@@ -1513,7 +1664,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph(string initial_state)
 	Mixing_Coefficients_Spin2_internal[18] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[19] = complex<double>(0, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin2_internal[10] = complex<double>(0, 0);
 		Mixing_Coefficients_Spin2_internal[11] = complex<double>(0, 0);
@@ -1521,9 +1672,9 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph(string initial_state)
 		Mixing_Coefficients_Spin2_internal[13] = complex<double>(0, 0);
 	}
 	
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[3] = complex<double>(0, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[3] = complex<double>(0, 0);
 	
 	return Run_MEKD_MG_ME_Configurator_Spin2( initial_state );
 }
@@ -1531,7 +1682,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph(string initial_state)
 
 
 ///
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
 	Mixing_Coefficients_Spin2_internal[0] = complex<double>(0, 0);	// Production
@@ -1541,7 +1692,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh(string initial_state)
 	Mixing_Coefficients_Spin2_internal[4] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[5] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[6] = complex<double>(0, 0);
-	if( initial_state=="gg" ) Mixing_Coefficients_Spin2_internal[7] = complex<double>(1, 0);
+	if( initial_state==IS_gg ) Mixing_Coefficients_Spin2_internal[7] = complex<double>(1, 0);
 	Mixing_Coefficients_Spin2_internal[8] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[9] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[10] = complex<double>(0, 0);	// Decay
@@ -1555,7 +1706,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh(string initial_state)
 	Mixing_Coefficients_Spin2_internal[18] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[19] = complex<double>(0, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin2_internal[10] = complex<double>(0, 0);
 		Mixing_Coefficients_Spin2_internal[11] = complex<double>(0, 0);
@@ -1563,9 +1714,9 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh(string initial_state)
 		Mixing_Coefficients_Spin2_internal[13] = complex<double>(0, 0);
 	}
 	
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[7] = complex<double>(0, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[7] = complex<double>(0, 0);
 	
 	return Run_MEKD_MG_ME_Configurator_Spin2( initial_state );
 }
@@ -1573,10 +1724,10 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh(string initial_state)
 
 
 ///
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pb(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pb(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
-	if( initial_state=="gg" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);	// Production
+	if( initial_state==IS_gg ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);	// Production
 	Mixing_Coefficients_Spin2_internal[1] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[2] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[3] = complex<double>(0, 0);
@@ -1597,7 +1748,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pb(string initial_state)
 	Mixing_Coefficients_Spin2_internal[18] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[19] = complex<double>(0, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin2_internal[10] = complex<double>(0, 0);
 		Mixing_Coefficients_Spin2_internal[11] = complex<double>(0, 0);
@@ -1605,8 +1756,8 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pb(string initial_state)
 		Mixing_Coefficients_Spin2_internal[13] = complex<double>(0, 0);
 	}
 	
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
 	
 	return Run_MEKD_MG_ME_Configurator_Spin2( initial_state );
 }
@@ -1614,11 +1765,11 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Pb(string initial_state)
 
 
 ///
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph2(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph2(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
 	Mixing_Coefficients_Spin2_internal[0] = complex<double>(0, 0);	// Production
-	if( initial_state=="gg" ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
+	if( initial_state==IS_gg ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
 	Mixing_Coefficients_Spin2_internal[2] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[3] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[4] = complex<double>(0, 0);
@@ -1638,7 +1789,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph2(string initial_state)
 	Mixing_Coefficients_Spin2_internal[18] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[19] = complex<double>(0, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin2_internal[10] = complex<double>(0, 0);
 		Mixing_Coefficients_Spin2_internal[11] = complex<double>(0, 0);
@@ -1646,8 +1797,8 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph2(string initial_state)
 		Mixing_Coefficients_Spin2_internal[13] = complex<double>(0, 0);
 	}
 	
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
 	
 	return Run_MEKD_MG_ME_Configurator_Spin2( initial_state );
 }
@@ -1655,12 +1806,12 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph2(string initial_state)
 
 
 ///
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph3(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph3(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
 	Mixing_Coefficients_Spin2_internal[0] = complex<double>(0, 0);	// Production
 	Mixing_Coefficients_Spin2_internal[1] = complex<double>(0, 0);
-	if( initial_state=="gg" ) Mixing_Coefficients_Spin2_internal[2] = complex<double>(1, 0);
+	if( initial_state==IS_gg ) Mixing_Coefficients_Spin2_internal[2] = complex<double>(1, 0);
 	Mixing_Coefficients_Spin2_internal[3] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[4] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[5] = complex<double>(0, 0);
@@ -1679,7 +1830,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph3(string initial_state)
 	Mixing_Coefficients_Spin2_internal[18] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[19] = complex<double>(0, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin2_internal[10] = complex<double>(0, 0);
 		Mixing_Coefficients_Spin2_internal[11] = complex<double>(0, 0);
@@ -1687,9 +1838,9 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph3(string initial_state)
 		Mixing_Coefficients_Spin2_internal[13] = complex<double>(0, 0);
 	}
 	
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[2] = complex<double>(0, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[2] = complex<double>(0, 0);
 	
 	return Run_MEKD_MG_ME_Configurator_Spin2( initial_state );
 }
@@ -1697,10 +1848,10 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph3(string initial_state)
 
 
 ///
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph6(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph6(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
-	if( initial_state=="gg" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);	// Production
+	if( initial_state==IS_gg ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);	// Production
 	Mixing_Coefficients_Spin2_internal[1] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[2] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[3] = complex<double>(0, 0);
@@ -1721,7 +1872,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph6(string initial_state)
 	Mixing_Coefficients_Spin2_internal[18] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[19] = complex<double>(0, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin2_internal[10] = complex<double>(0, 0);
 		Mixing_Coefficients_Spin2_internal[11] = complex<double>(0, 0);
@@ -1729,8 +1880,8 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph6(string initial_state)
 		Mixing_Coefficients_Spin2_internal[13] = complex<double>(0, 0);
 	}
 	
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
 	
 	return Run_MEKD_MG_ME_Configurator_Spin2( initial_state );
 }
@@ -1738,10 +1889,10 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph6(string initial_state)
 
 
 ///
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph7(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph7(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
-	if( initial_state=="gg" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);	// Production
+	if( initial_state==IS_gg ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);	// Production
 	Mixing_Coefficients_Spin2_internal[1] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[2] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[3] = complex<double>(0, 0);
@@ -1762,7 +1913,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph7(string initial_state)
 	Mixing_Coefficients_Spin2_internal[18] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[19] = complex<double>(0, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin2_internal[10] = complex<double>(0, 0);
 		Mixing_Coefficients_Spin2_internal[11] = complex<double>(0, 0);
@@ -1770,8 +1921,8 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph7(string initial_state)
 		Mixing_Coefficients_Spin2_internal[13] = complex<double>(0, 0);
 	}
 	
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
 	
 	return Run_MEKD_MG_ME_Configurator_Spin2( initial_state );
 }
@@ -1779,7 +1930,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Ph7(string initial_state)
 
 
 ///
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh9(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh9(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
 	Mixing_Coefficients_Spin2_internal[0] = complex<double>(0, 0);	// Production
@@ -1789,7 +1940,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh9(string initial_state)
 	Mixing_Coefficients_Spin2_internal[4] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[5] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[6] = complex<double>(0, 0);
-	if( initial_state=="gg" ) Mixing_Coefficients_Spin2_internal[7] = complex<double>(1, 0);
+	if( initial_state==IS_gg ) Mixing_Coefficients_Spin2_internal[7] = complex<double>(1, 0);
 	Mixing_Coefficients_Spin2_internal[8] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[9] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[10] = complex<double>(0, 0);	// Decay
@@ -1803,7 +1954,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh9(string initial_state)
 	Mixing_Coefficients_Spin2_internal[18] = complex<double>(1, 0);
 	Mixing_Coefficients_Spin2_internal[19] = complex<double>(0, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin2_internal[10] = complex<double>(0, 0);
 		Mixing_Coefficients_Spin2_internal[11] = complex<double>(0, 0);
@@ -1811,9 +1962,9 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh9(string initial_state)
 		Mixing_Coefficients_Spin2_internal[13] = complex<double>(0, 0);
 	}
 	
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[7] = complex<double>(0, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[7] = complex<double>(0, 0);
 	
 	return Run_MEKD_MG_ME_Configurator_Spin2( initial_state );
 }
@@ -1821,7 +1972,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh9(string initial_state)
 
 
 ///
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh10(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh10(Initial_state_id initial_state)
 {
 	Predefined_Model = true;
 	Mixing_Coefficients_Spin2_internal[0] = complex<double>(0, 0);	// Production
@@ -1831,7 +1982,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh10(string initial_state)
 	Mixing_Coefficients_Spin2_internal[4] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[5] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[6] = complex<double>(0, 0);
-	if( initial_state=="gg" ) Mixing_Coefficients_Spin2_internal[7] = complex<double>(1, 0);
+	if( initial_state==IS_gg ) Mixing_Coefficients_Spin2_internal[7] = complex<double>(1, 0);
 	Mixing_Coefficients_Spin2_internal[8] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[9] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[10] = complex<double>(0, 0);	// Decay
@@ -1845,7 +1996,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh10(string initial_state)
 	Mixing_Coefficients_Spin2_internal[18] = complex<double>(0, 0);
 	Mixing_Coefficients_Spin2_internal[19] = complex<double>(1, 0);
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" || Resonance_decay_mode=="2l" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA || Resonance_decay_mode_internal==RDM_2l )
 	{
 		Mixing_Coefficients_Spin2_internal[10] = complex<double>(0, 0);
 		Mixing_Coefficients_Spin2_internal[11] = complex<double>(0, 0);
@@ -1853,9 +2004,9 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh10(string initial_state)
 		Mixing_Coefficients_Spin2_internal[13] = complex<double>(0, 0);
 	}
 	
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
-	if( initial_state=="qq" ) Mixing_Coefficients_Spin2_internal[7] = complex<double>(0, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[0] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[1] = complex<double>(1, 0);
+	if( initial_state==IS_qq ) Mixing_Coefficients_Spin2_internal[7] = complex<double>(0, 0);
 	
 	return Run_MEKD_MG_ME_Configurator_Spin2( initial_state );
 }
@@ -1863,7 +2014,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2Mh10(string initial_state)
 
 
 /// A generic spin-0 resonance handler
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0(Initial_state_id initial_state)
 {
 	if( Predefined_Model )
 	{
@@ -1874,28 +2025,28 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0(string initial_state)
 	
 	if( Use_mh_eq_m4l )
 	{	
-		Set_Of_Model_Parameters.set_block_entry( "mass", 9000006, Mass_4l );
+		Model_Parameters.MH = Mass_4l;
 		
 		if( Use_Higgs_width )
 		{
-			if( Vary_resonance_width ) Set_Of_Model_Parameters.set_block_entry( "decay", 9000006, static_cast<double>( MEKD_CalcHEP_Extra::Higgs_width(Mass_4l) ) );
-			else Set_Of_Model_Parameters.set_block_entry( "decay", 9000006, Higgs_width );
+			if( Vary_resonance_width ) Model_Parameters.WH = static_cast<double>( MEKD_CalcHEP_Extra::Higgs_width(Mass_4l) );
+			else Model_Parameters.WH = Higgs_width;
 		}
-		else Set_Of_Model_Parameters.set_block_entry( "decay", 9000006, 1 );
+		else Model_Parameters.WH = 1;
 		
 		
 		LmbdGG_calculated = LmbdGG(Mass_4l);
 	}
 	else
 	{
-		Set_Of_Model_Parameters.set_block_entry( "mass", 9000006, Higgs_mass );
+		Model_Parameters.MH = Higgs_mass;
 		
 		if( Use_Higgs_width )
 		{
-			if( Vary_resonance_width ) Set_Of_Model_Parameters.set_block_entry( "decay", 9000006, static_cast<double>( MEKD_CalcHEP_Extra::Higgs_width(Mass_4l) ) );
-			else Set_Of_Model_Parameters.set_block_entry( "decay", 9000006, Higgs_width );
+			if( Vary_resonance_width ) Model_Parameters.WH = static_cast<double>( MEKD_CalcHEP_Extra::Higgs_width(Mass_4l) );
+			else Model_Parameters.WH = Higgs_width;
 		}
-		else Set_Of_Model_Parameters.set_block_entry( "decay", 9000006, 1 );
+		else Model_Parameters.WH = 1;
 		
 		
 		LmbdGG_calculated = LmbdGG(Higgs_mass);
@@ -1906,42 +2057,42 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0(string initial_state)
 		//gg
 		if( Fix_Spin0_Production )
 		{
-			Set_Of_Model_Parameters.set_block_entry( "heff", 1, complex<double>(0, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "heff", 2, complex<double>(4*LmbdGG_calculated, 0) );	// Spin0Pm
-			Set_Of_Model_Parameters.set_block_entry( "heff", 3, complex<double>(0, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "heff", 4, complex<double>(0, 0) );	// Spin0M
+			Model_Parameters.g1g = complex<double>(0, 0);
+			Model_Parameters.g2g = complex<double>(4*LmbdGG_calculated, 0);	// Spin0Pm
+			Model_Parameters.g3g = complex<double>(0, 0);
+			Model_Parameters.g4g = complex<double>(0, 0);	// Spin0M
 		}
 		else
 		{
-			Set_Of_Model_Parameters.set_block_entry( "heff", 1, complex<double>(0, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "heff", 2, (buffer_complex[0]+buffer_complex[1]+buffer_complex[2])*complex<double>(4*LmbdGG_calculated, 0) );	// Spin0P
-			Set_Of_Model_Parameters.set_block_entry( "heff", 3, complex<double>(0, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "heff", 4, buffer_complex[3]*complex<double>(4*LmbdGG_calculated, 0) );	// Spin0M
+			Model_Parameters.g1g = complex<double>(0, 0);
+			Model_Parameters.g2g = (buffer_complex[0]+buffer_complex[1]+buffer_complex[2])*complex<double>(4*LmbdGG_calculated, 0);	// Spin0P
+			Model_Parameters.g3g = complex<double>(0, 0);
+			Model_Parameters.g4g = buffer_complex[3]*complex<double>(4*LmbdGG_calculated, 0);	// Spin0M
 		}
 		
 		// Decay to ZZ
 		if( Use_mh_eq_m4l )
 		{
-			Set_Of_Model_Parameters.set_block_entry( "heff", 5, buffer_complex[0]*complex<double>(hZZ_coupling, 0) );	// Spin0Pm
-			Set_Of_Model_Parameters.set_block_entry( "heff", 6, buffer_complex[1]*complex<double>(hZZ_coupling/params_m_Z/params_m_Z, 0) );	// Spin0Ph
-			Set_Of_Model_Parameters.set_block_entry( "heff", 7, buffer_complex[2]*complex<double>(hZZ_coupling/params_m_Z/params_m_Z/Mass_4l/Mass_4l, 0) );	// Spin0Ph+
-			Set_Of_Model_Parameters.set_block_entry( "heff", 8, buffer_complex[3]*complex<double>(hZZ_coupling/params_m_Z/params_m_Z, 0) );	// Spin0M
+			Model_Parameters.g1z = buffer_complex[0]*complex<double>(hZZ_coupling, 0);	// Spin0Pm
+			Model_Parameters.g2z = buffer_complex[1]*complex<double>(hZZ_coupling/params_m_Z/params_m_Z, 0);	// Spin0Ph
+			Model_Parameters.g3z = buffer_complex[2]*complex<double>(hZZ_coupling/params_m_Z/params_m_Z/Mass_4l/Mass_4l, 0);	// Spin0Ph+
+			Model_Parameters.g4z = buffer_complex[3]*complex<double>(hZZ_coupling/params_m_Z/params_m_Z, 0);	// Spin0M
 		}
 		else
 		{
-			Set_Of_Model_Parameters.set_block_entry( "heff", 5, buffer_complex[0]*complex<double>(hZZ_coupling, 0) );	// Spin0Pm
-			Set_Of_Model_Parameters.set_block_entry( "heff", 6, buffer_complex[1]*complex<double>(hZZ_coupling/params_m_Z/params_m_Z, 0) );	// Spin0Ph
-			Set_Of_Model_Parameters.set_block_entry( "heff", 7, buffer_complex[2]*complex<double>(hZZ_coupling/params_m_Z/params_m_Z/Higgs_mass/Higgs_mass, 0) );	// Spin0Ph+
-			Set_Of_Model_Parameters.set_block_entry( "heff", 8, buffer_complex[3]*complex<double>(hZZ_coupling/params_m_Z/params_m_Z, 0) );	// Spin0M
+			Model_Parameters.g1z = buffer_complex[0]*complex<double>(hZZ_coupling, 0);	// Spin0Pm
+			Model_Parameters.g2z = buffer_complex[1]*complex<double>(hZZ_coupling/params_m_Z/params_m_Z, 0);	// Spin0Ph
+			Model_Parameters.g3z = buffer_complex[2]*complex<double>(hZZ_coupling/params_m_Z/params_m_Z/Higgs_mass/Higgs_mass, 0);	// Spin0Ph+
+			Model_Parameters.g4z = buffer_complex[3]*complex<double>(hZZ_coupling/params_m_Z/params_m_Z, 0);	// Spin0M
 		}
 		
 		// Decay to 2l (or 2mu in 2f)
-		Set_Of_Model_Parameters.set_block_entry( "heff", 19, buffer_complex[0]*complex<double>(4.291210e-04, 0) );
-		Set_Of_Model_Parameters.set_block_entry( "heff", 20, buffer_complex[1]*complex<double>(4.291210e-04, 0) );
+		Model_Parameters.rhomu01 = buffer_complex[0]*complex<double>(4.291210e-04, 0);
+		Model_Parameters.rhomu02 = buffer_complex[1]*complex<double>(4.291210e-04, 0);
 		
 		// Decay to 2e (2f)
-		Set_Of_Model_Parameters.set_block_entry( "heff", 21, buffer_complex[0]*complex<double>(4.291210e-04, 0) );	// for Hee should be 2.075371e-06
-		Set_Of_Model_Parameters.set_block_entry( "heff", 22, buffer_complex[1]*complex<double>(4.291210e-04, 0) );
+		Model_Parameters.rhoe01 = buffer_complex[0]*complex<double>(4.291210e-04, 0);	// for Hee should be 2.075371e-06
+		Model_Parameters.rhoe02 = buffer_complex[1]*complex<double>(4.291210e-04, 0);
 	}
 	
 	//qq
@@ -1964,7 +2115,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin0(string initial_state)
 
 
 /// A generic spin-1 resonance handler
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1(Initial_state_id initial_state)
 {
 	if( Predefined_Model )
 	{
@@ -1975,28 +2126,28 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1(string initial_state)
 	
 	if( Use_mh_eq_m4l )
 	{
-		Set_Of_Model_Parameters.set_block_entry( "mass", 300, Mass_4l );
+		Model_Parameters.MZp = Mass_4l;
 		
 		if( Use_Higgs_width )
 		{
-			if( Vary_resonance_width ) Set_Of_Model_Parameters.set_block_entry( "decay", 300, static_cast<double>( MEKD_CalcHEP_Extra::Higgs_width(Mass_4l) ) );
-			else Set_Of_Model_Parameters.set_block_entry( "decay", 300, Higgs_width );
+			if( Vary_resonance_width ) Model_Parameters.WZp = static_cast<double>( MEKD_CalcHEP_Extra::Higgs_width(Mass_4l) );
+			else Model_Parameters.WZp = Higgs_width;
 		}
-		else Set_Of_Model_Parameters.set_block_entry( "decay", 300, 1 );
+		else Model_Parameters.WZp = 1;
 		
 		
 		LmbdGG_calculated = LmbdGG(Mass_4l);
 	}
 	else
 	{
-		Set_Of_Model_Parameters.set_block_entry( "mass", 300, Higgs_mass );
+		Model_Parameters.MZp = Higgs_mass;
 		
 		if( Use_Higgs_width )
 		{
-			if( Vary_resonance_width ) Set_Of_Model_Parameters.set_block_entry( "decay", 300, static_cast<double>( MEKD_CalcHEP_Extra::Higgs_width(Mass_4l) ) );
-			else Set_Of_Model_Parameters.set_block_entry( "decay", 300, Higgs_width );
+			if( Vary_resonance_width ) Model_Parameters.WZp = static_cast<double>( MEKD_CalcHEP_Extra::Higgs_width(Mass_4l) );
+			else Model_Parameters.WZp = Higgs_width;
 		}
-		else Set_Of_Model_Parameters.set_block_entry( "decay", 300, 1 );
+		else Model_Parameters.WZp = 1;
 		
 		
 		LmbdGG_calculated = LmbdGG(Higgs_mass);
@@ -2053,20 +2204,20 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1(string initial_state)
 		}
 		
 		// Decay to ZZ
-		Set_Of_Model_Parameters.set_block_entry( "vec", 1, buffer_complex[4]*complex<double>(hZZ_coupling/2/params_m_Z, 0) );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 2, buffer_complex[5]*complex<double>(hZZ_coupling/4/params_m_Z, 0) );
+		Model_Parameters.b1z = buffer_complex[4]*complex<double>(hZZ_coupling/2/params_m_Z, 0);
+		Model_Parameters.b2z = buffer_complex[5]*complex<double>(hZZ_coupling/4/params_m_Z, 0);
 		
 		// Decay to 2l (or 2mu in 2f)
-		Set_Of_Model_Parameters.set_block_entry( "vec", 23, buffer_complex[4]*complex<double>(4.291210e-04, 0) );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 24, buffer_complex[5]*complex<double>(4.291210e-04, 0) );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 25, buffer_complex[6]*complex<double>(4.291210e-04, 0) );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 26, buffer_complex[7]*complex<double>(4.291210e-04, 0) );
+		Model_Parameters.rhomu11 = buffer_complex[4]*complex<double>(4.291210e-04, 0);
+		Model_Parameters.rhomu12 = buffer_complex[5]*complex<double>(4.291210e-04, 0);
+		Model_Parameters.rhomu13 = buffer_complex[6]*complex<double>(4.291210e-04, 0);
+		Model_Parameters.rhomu14 = buffer_complex[7]*complex<double>(4.291210e-04, 0);
 		
 		// Decay to 2e (2f)
-		Set_Of_Model_Parameters.set_block_entry( "vec", 27, buffer_complex[4]*complex<double>(4.291210e-04, 0) );	// for Hee should be 2.075371e-06
-		Set_Of_Model_Parameters.set_block_entry( "vec", 28, buffer_complex[5]*complex<double>(4.291210e-04, 0) );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 29, buffer_complex[6]*complex<double>(4.291210e-04, 0) );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 30, buffer_complex[7]*complex<double>(4.291210e-04, 0) );
+		Model_Parameters.rhoe11 = buffer_complex[4]*complex<double>(4.291210e-04, 0);	// for Hee should be 2.075371e-06
+		Model_Parameters.rhoe12 = buffer_complex[5]*complex<double>(4.291210e-04, 0);
+		Model_Parameters.rhoe13 = buffer_complex[6]*complex<double>(4.291210e-04, 0);
+		Model_Parameters.rhoe14 = buffer_complex[7]*complex<double>(4.291210e-04, 0);
 	}
 	
 	buffer_complex = NULL;
@@ -2077,7 +2228,7 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin1(string initial_state)
 
 
 /// A generic spin-2 resonance handler
-int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2(Initial_state_id initial_state)
 {
 	if( Predefined_Model )
 	{
@@ -2088,28 +2239,28 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2(string initial_state)
 	
 	if( Use_mh_eq_m4l )
 	{
-		Set_Of_Model_Parameters.set_block_entry( "mass", 9000007, Mass_4l );
+		Model_Parameters.MXG = Mass_4l;
 		
 		if( Use_Higgs_width )
 		{
-			if( Vary_resonance_width ) Set_Of_Model_Parameters.set_block_entry( "decay", 9000007, static_cast<double>( MEKD_CalcHEP_Extra::Higgs_width(Mass_4l) ) );
-			else Set_Of_Model_Parameters.set_block_entry( "decay", 9000007, Higgs_width );
+			if( Vary_resonance_width ) Model_Parameters.WXG = static_cast<double>( MEKD_CalcHEP_Extra::Higgs_width(Mass_4l) );
+			else Model_Parameters.WXG = Higgs_width;
 		}
-		else Set_Of_Model_Parameters.set_block_entry( "decay", 9000007, 1 );
+		else Model_Parameters.WXG = 1;
 		
 		
 		LmbdGG_calculated = LmbdGG(Mass_4l);
 	}
 	else
 	{
-		Set_Of_Model_Parameters.set_block_entry( "mass", 9000007, Higgs_mass );
+		Model_Parameters.MXG = Higgs_mass;
 		
 		if( Use_Higgs_width )
 		{
-			if( Vary_resonance_width ) Set_Of_Model_Parameters.set_block_entry( "decay", 9000007, static_cast<double>( MEKD_CalcHEP_Extra::Higgs_width(Mass_4l) ) );
-			else Set_Of_Model_Parameters.set_block_entry( "decay", 9000007, Higgs_width );
+			if( Vary_resonance_width ) Model_Parameters.WXG = static_cast<double>( MEKD_CalcHEP_Extra::Higgs_width(Mass_4l) );
+			else Model_Parameters.WXG = Higgs_width;
 		}
-		else Set_Of_Model_Parameters.set_block_entry( "decay", 9000007, 1 );
+		else Model_Parameters.WXG = 1;
 		
 		
 		LmbdGG_calculated = LmbdGG(Higgs_mass);
@@ -2121,29 +2272,29 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2(string initial_state)
 		//gg
 		if( Use_mh_eq_m4l )
 		{
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 1, buffer_complex[0]*complex<double>(8.0*LmbdGG_calculated, 0) );	// 8 flavors
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 2, buffer_complex[1]*complex<double>(8.0*LmbdGG_calculated/Mass_4l/Mass_4l, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 3, buffer_complex[2]*complex<double>(8.0*LmbdGG_calculated/Mass_4l/Mass_4l, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 4, buffer_complex[3]*complex<double>(8.0*LmbdGG_calculated/Mass_4l/Mass_4l, 0) );	// old dummy scale factor a_s(100 GeV)^2/2Pi/m4l
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 5, buffer_complex[4]*complex<double>(8.0*LmbdGG_calculated*Mass_4l*Mass_4l, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 6, buffer_complex[5]*complex<double>(8.0*LmbdGG_calculated/Mass_4l/Mass_4l, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 7, buffer_complex[6]*complex<double>(8.0*LmbdGG_calculated, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 8, buffer_complex[7]*complex<double>(8.0*LmbdGG_calculated/Mass_4l/Mass_4l, 0) );	// old dummy scale factor a_s(100 GeV)^2/2Pi/m4l
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 9, buffer_complex[8]*complex<double>(8.0*LmbdGG_calculated, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity",10, buffer_complex[9]*complex<double>(8.0*LmbdGG_calculated/Mass_4l/Mass_4l, 0) );
+			Model_Parameters.k1g = buffer_complex[0]*complex<double>(8.0*LmbdGG_calculated, 0);	// 8 flavors
+			Model_Parameters.k2g = buffer_complex[1]*complex<double>(8.0*LmbdGG_calculated/Mass_4l/Mass_4l, 0);
+			Model_Parameters.k3g = buffer_complex[2]*complex<double>(8.0*LmbdGG_calculated/Mass_4l/Mass_4l, 0);
+			Model_Parameters.k4g = buffer_complex[3]*complex<double>(8.0*LmbdGG_calculated/Mass_4l/Mass_4l, 0);	// old dummy scale factor a_s(100 GeV)^2/2Pi/m4l
+			Model_Parameters.k5g = buffer_complex[4]*complex<double>(8.0*LmbdGG_calculated*Mass_4l*Mass_4l, 0);
+			Model_Parameters.k6g = buffer_complex[5]*complex<double>(8.0*LmbdGG_calculated/Mass_4l/Mass_4l, 0);
+			Model_Parameters.k7g = buffer_complex[6]*complex<double>(8.0*LmbdGG_calculated, 0);
+			Model_Parameters.k8g = buffer_complex[7]*complex<double>(8.0*LmbdGG_calculated/Mass_4l/Mass_4l, 0);	// old dummy scale factor a_s(100 GeV)^2/2Pi/m4l
+			Model_Parameters.k9g = buffer_complex[8]*complex<double>(8.0*LmbdGG_calculated, 0);
+			Model_Parameters.k10g = buffer_complex[9]*complex<double>(8.0*LmbdGG_calculated/Mass_4l/Mass_4l, 0);
 		}
 		else
 		{
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 1, buffer_complex[0]*complex<double>(8.0*LmbdGG_calculated, 0) );	// 8 flavors
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 2, buffer_complex[1]*complex<double>(8.0*LmbdGG_calculated/Higgs_mass/Higgs_mass, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 3, buffer_complex[2]*complex<double>(8.0*LmbdGG_calculated/Higgs_mass/Higgs_mass, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 4, buffer_complex[3]*complex<double>(8.0*LmbdGG_calculated/Higgs_mass/Higgs_mass, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 5, buffer_complex[4]*complex<double>(8.0*LmbdGG_calculated*Higgs_mass*Higgs_mass, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 6, buffer_complex[5]*complex<double>(8.0*LmbdGG_calculated/Higgs_mass/Higgs_mass, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 7, buffer_complex[6]*complex<double>(8.0*LmbdGG_calculated, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 8, buffer_complex[7]*complex<double>(8.0*LmbdGG_calculated/Higgs_mass/Higgs_mass, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 9, buffer_complex[8]*complex<double>(8.0*LmbdGG_calculated, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity",10, buffer_complex[9]*complex<double>(8.0*LmbdGG_calculated/Higgs_mass/Higgs_mass, 0) );
+			Model_Parameters.k1g = buffer_complex[0]*complex<double>(8.0*LmbdGG_calculated, 0);	// 8 flavors
+			Model_Parameters.k2g = buffer_complex[1]*complex<double>(8.0*LmbdGG_calculated/Higgs_mass/Higgs_mass, 0);
+			Model_Parameters.k3g = buffer_complex[2]*complex<double>(8.0*LmbdGG_calculated/Higgs_mass/Higgs_mass, 0);
+			Model_Parameters.k4g = buffer_complex[3]*complex<double>(8.0*LmbdGG_calculated/Higgs_mass/Higgs_mass, 0);
+			Model_Parameters.k5g = buffer_complex[4]*complex<double>(8.0*LmbdGG_calculated*Higgs_mass*Higgs_mass, 0);
+			Model_Parameters.k6g = buffer_complex[5]*complex<double>(8.0*LmbdGG_calculated/Higgs_mass/Higgs_mass, 0);
+			Model_Parameters.k7g = buffer_complex[6]*complex<double>(8.0*LmbdGG_calculated, 0);
+			Model_Parameters.k8g = buffer_complex[7]*complex<double>(8.0*LmbdGG_calculated/Higgs_mass/Higgs_mass, 0);
+			Model_Parameters.k9g = buffer_complex[8]*complex<double>(8.0*LmbdGG_calculated, 0);
+			Model_Parameters.k10g = buffer_complex[9]*complex<double>(8.0*LmbdGG_calculated/Higgs_mass/Higgs_mass, 0);
 			
 		}
 			
@@ -2172,43 +2323,43 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2(string initial_state)
 		// Decay to ZZ
 		if( Use_mh_eq_m4l )
 		{
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 11, buffer_complex[10]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/sqrt(2), 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 12, buffer_complex[11]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/Mass_4l/Mass_4l, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 13, buffer_complex[12]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/params_m_Z, 0) );	// or /mZ^4?
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 14, buffer_complex[13]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/params_m_Z, 0) );	// or /mZ^4?
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 15, buffer_complex[14]*complex<double>(hZZ_coupling/2/sqrt(2), 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 16, buffer_complex[15]*complex<double>(hZZ_coupling/2/params_m_Z/Mass_4l, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 17, buffer_complex[16]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 18, buffer_complex[17]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/params_m_Z, 0) );	// or /mZ^4?
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 19, buffer_complex[18]*complex<double>(hZZ_coupling/2/params_m_Z/Mass_4l, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 20, buffer_complex[19]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/Mass_4l/Mass_4l, 0) );
+			Model_Parameters.k1z = buffer_complex[10]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/sqrt(2), 0);
+			Model_Parameters.k2z = buffer_complex[11]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/Mass_4l/Mass_4l, 0);
+			Model_Parameters.k3z = buffer_complex[12]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/params_m_Z, 0);	// or /mZ^4?
+			Model_Parameters.k4z = buffer_complex[13]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/params_m_Z, 0);	// or /mZ^4?
+			Model_Parameters.k5z = buffer_complex[14]*complex<double>(hZZ_coupling/2/sqrt(2), 0);
+			Model_Parameters.k6z = buffer_complex[15]*complex<double>(hZZ_coupling/2/params_m_Z/Mass_4l, 0);
+			Model_Parameters.k7z = buffer_complex[16]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z, 0);
+			Model_Parameters.k8z = buffer_complex[17]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/params_m_Z, 0);	// or /mZ^4?
+			Model_Parameters.k9z = buffer_complex[18]*complex<double>(hZZ_coupling/2/params_m_Z/Mass_4l, 0);
+			Model_Parameters.k10z = buffer_complex[19]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/Mass_4l/Mass_4l, 0);
 			
 		}
 		else
 		{
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 11, buffer_complex[10]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/sqrt(2), 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 12, buffer_complex[11]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/Higgs_mass/Higgs_mass, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 13, buffer_complex[12]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/params_m_Z, 0) );	// or /mZ^4?
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 14, buffer_complex[13]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/params_m_Z, 0) );	// or /mZ^4?
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 15, buffer_complex[14]*complex<double>(hZZ_coupling/2/sqrt(2), 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 16, buffer_complex[15]*complex<double>(hZZ_coupling/2/params_m_Z/Higgs_mass, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 17, buffer_complex[16]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 18, buffer_complex[17]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/params_m_Z, 0) );	// or /mZ^4?
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 19, buffer_complex[18]*complex<double>(hZZ_coupling/2/params_m_Z/Higgs_mass, 0) );
-			Set_Of_Model_Parameters.set_block_entry( "gravity", 20, buffer_complex[19]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/Higgs_mass/Higgs_mass, 0) );
+			Model_Parameters.k1z = buffer_complex[10]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/sqrt(2), 0);
+			Model_Parameters.k2z = buffer_complex[11]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/Higgs_mass/Higgs_mass, 0);
+			Model_Parameters.k3z = buffer_complex[12]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/params_m_Z, 0);	// or /mZ^4?
+			Model_Parameters.k4z = buffer_complex[13]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/params_m_Z, 0);	// or /mZ^4?
+			Model_Parameters.k5z = buffer_complex[14]*complex<double>(hZZ_coupling/2/sqrt(2), 0);
+			Model_Parameters.k6z = buffer_complex[15]*complex<double>(hZZ_coupling/2/params_m_Z/Higgs_mass, 0);
+			Model_Parameters.k7z = buffer_complex[16]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z, 0);
+			Model_Parameters.k8z = buffer_complex[17]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/params_m_Z, 0);	// or /mZ^4?
+			Model_Parameters.k9z = buffer_complex[18]*complex<double>(hZZ_coupling/2/params_m_Z/Higgs_mass, 0);
+			Model_Parameters.k10z = buffer_complex[19]*complex<double>(hZZ_coupling/2/params_m_Z/params_m_Z/Higgs_mass/Higgs_mass, 0);
 		}
 		
 		// Decay to 2l (or 2mu in 2f)
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 41, buffer_complex[10]*complex<double>(4.291210e-04, 0) );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 42, buffer_complex[11]*complex<double>(4.291210e-04, 0) );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 43, buffer_complex[12]*complex<double>(4.291210e-04, 0) );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 44, buffer_complex[13]*complex<double>(4.291210e-04, 0) );
+		Model_Parameters.rhomu21 = buffer_complex[10]*complex<double>(4.291210e-04, 0);
+		Model_Parameters.rhomu22 = buffer_complex[11]*complex<double>(4.291210e-04, 0);
+		Model_Parameters.rhomu23 = buffer_complex[12]*complex<double>(4.291210e-04, 0);
+		Model_Parameters.rhomu24 = buffer_complex[13]*complex<double>(4.291210e-04, 0);
 		
 		// Decay to 2e (2f)
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 45, buffer_complex[10]*complex<double>(4.291210e-04, 0) );	// for Hee should be 2.075371e-06
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 46, buffer_complex[11]*complex<double>(4.291210e-04, 0) );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 47, buffer_complex[12]*complex<double>(4.291210e-04, 0) );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 48, buffer_complex[13]*complex<double>(4.291210e-04, 0) );
+		Model_Parameters.rhoe21 = buffer_complex[10]*complex<double>(4.291210e-04, 0);	// for Hee should be 2.075371e-06
+		Model_Parameters.rhoe22 = buffer_complex[11]*complex<double>(4.291210e-04, 0);
+		Model_Parameters.rhoe23 = buffer_complex[12]*complex<double>(4.291210e-04, 0);
+		Model_Parameters.rhoe24 = buffer_complex[13]*complex<double>(4.291210e-04, 0);
 	}
 	
 	buffer_complex = NULL;
@@ -2219,181 +2370,181 @@ int MEKD_MG::Run_MEKD_MG_ME_Configurator_Spin2(string initial_state)
 
 
 /// ME_RAW (RAW MG5_aMC ME) dispatcher
-int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_CPPProcess(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_CPPProcess(Initial_state_id initial_state)
 {
-// 	if( Resonance_decay_mode=="ZZ" )
+// 	if( Resonance_decay_mode_internal==RDM_ZZ )
 // 	{
-// 		if( Final_state=="4e" || Final_state=="4eA" )
+// 		if( Final_state_internal==FS_4e || Final_state_internal==FS_4eA )
 // 		{
 // // 			/// Common mass for the same-flavor leptons
-// // 			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_e );
+// // 			Model_Parameters.MM = params_m_e;
 // 			
-// 			if( initial_state=="NO" && Final_state=="4e" )
+// 			if( initial_state==IS_NO && Final_state_internal==FS_4e )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_RAW );
 // 			
-// 			if( initial_state=="NO" && Final_state=="4eA" )
+// 			if( initial_state==IS_NO && Final_state_internal==FS_4eA )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_RAW );
 // 			
-// 			if( initial_state=="gg" && Final_state=="4e" )
+// 			if( initial_state==IS_gg && Final_state_internal==FS_4e )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_RAW );
 // 			
-// 			if( initial_state=="gg" && Final_state=="4eA" )
+// 			if( initial_state==IS_gg && Final_state_internal==FS_4eA )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_RAW );
 // 			
-// 			if( initial_state=="qq" && Final_state=="4e" )
+// 			if( initial_state==IS_qq && Final_state_internal==FS_4e )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_RAW, ME_RAW );
 // 			
-// 			if( initial_state=="qq" && Final_state=="4eA" )
+// 			if( initial_state==IS_qq && Final_state_internal==FS_4eA )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_RAW, ME_RAW );
 // 		}
 // 		
-// 		if( Final_state=="2e2m" || Final_state=="2e2mu" || Final_state=="2e2mA" || Final_state=="2e2muA" )
+// 		if( Final_state_internal==FS_2e2mu || Final_state_internal==FS_2e2muA )
 // 		{
 // // 			/// Common mass for the opposite-flavor leptons
-// // 			Set_Of_Model_Parameters.set_block_entry( "mass", 11, params_m_e );
-// // 			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+// // 			Model_Parameters.Me = params_m_e;
+// // 			Model_Parameters.MM = params_m_mu;
 // 			
-// 			if( initial_state=="NO" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 			if( initial_state==IS_NO && (Final_state_internal==FS_2e2mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_RAW );
 // 			
-// 			if( initial_state=="NO" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 			if( initial_state==IS_NO && (Final_state_internal==FS_2e2muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_RAW );
 // 			
-// 			if( initial_state=="gg" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_2e2mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_RAW );
 // 			
-// 			if( initial_state=="gg" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_2e2muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_RAW );
 // 			
-// 			if( initial_state=="qq" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_2e2mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_RAW, ME_RAW );
 // 			
-// 			if( initial_state=="qq" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_2e2muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_RAW, ME_RAW );
 // 		}
 // 		
-// 		if( Final_state=="4m" || Final_state=="4mu" || Final_state=="4mA" || Final_state=="4muA" )
+// 		if( Final_state_internal==FS_4mu || Final_state_internal==FS_4muA )
 // 		{
 // // 			/// Common mass for the same-flavor leptons
-// // 			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+// // 			Model_Parameters.MM = params_m_mu;
 // 			
-// 			if( initial_state=="NO" && (Final_state=="4m" || Final_state=="4mu") )
+// 			if( initial_state==IS_NO && (Final_state_internal==FS_4mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_RAW );
 // 			
-// 			if( initial_state=="NO" && (Final_state=="4mA" || Final_state=="4muA") )
+// 			if( initial_state==IS_NO && (Final_state_internal==FS_4muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_RAW );
 // 			
-// 			if( initial_state=="gg" && (Final_state=="4m" || Final_state=="4mu") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_4mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_RAW );
 // 			
-// 			if( initial_state=="gg" && (Final_state=="4mA" || Final_state=="4muA") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_4muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_RAW );
 // 			
-// 			if( initial_state=="qq" && (Final_state=="4m" || Final_state=="4mu") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_4mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_RAW, ME_RAW );
 // 			
-// 			if( initial_state=="qq" && (Final_state=="4mA" || Final_state=="4muA") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_4muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_RAW, ME_RAW );
 // 		}
 // 	}
 // 	
-// 	if( Resonance_decay_mode=="2l" )
+// 	if( Resonance_decay_mode_internal==RDM_2l )
 // 	{
-// 		if( Final_state=="4e" || Final_state=="4eA" )
+// 		if( Final_state_internal==FS_4e || Final_state_internal==FS_4eA )
 // 		{
 // // 			/// Common mass for the same-flavor leptons
-// // 			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_e );
+// // 			Model_Parameters.MM = params_m_e;
 // 			
-// 			if( initial_state=="NO" && Final_state=="4e" )
+// 			if( initial_state==IS_NO && Final_state_internal==FS_4e )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_RAW );
 // 			
-// 			if( initial_state=="NO" && Final_state=="4eA" )
+// 			if( initial_state==IS_NO && Final_state_internal==FS_4eA )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_RAW );
 // 			
-// 			if( initial_state=="gg" && Final_state=="4e" )
+// 			if( initial_state==IS_gg && Final_state_internal==FS_4e )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_RAW );
 // 			
-// 			if( initial_state=="gg" && Final_state=="4eA" )
+// 			if( initial_state==IS_gg && Final_state_internal==FS_4eA )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_RAW );
 // 			
-// 			if( initial_state=="qq" && Final_state=="4e" )
+// 			if( initial_state==IS_qq && Final_state_internal==FS_4e )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_RAW, ME_RAW );
 // 			
-// 			if( initial_state=="qq" && Final_state=="4eA" )
+// 			if( initial_state==IS_qq && Final_state_internal==FS_4eA )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_RAW, ME_RAW );
 // 		}
 // 		
-// 		if( Final_state=="2e2m" || Final_state=="2e2mu" || Final_state=="2e2mA" || Final_state=="2e2muA" )
+// 		if( Final_state_internal==FS_2e2mu || Final_state_internal==FS_2e2muA )
 // 		{
 // // 			/// Common mass for the opposite-flavor leptons
-// // 			Set_Of_Model_Parameters.set_block_entry( "mass", 11, params_m_e );
-// // 			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+// // 			Model_Parameters.Me = params_m_e;
+// // 			Model_Parameters.MM = params_m_mu;
 // 			
-// 			if( initial_state=="NO" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 			if( initial_state==IS_NO && (Final_state_internal==FS_2e2mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_RAW );
 // 			
-// 			if( initial_state=="NO" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 			if( initial_state==IS_NO && (Final_state_internal==FS_2e2muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_RAW );
 // 			
-// 			if( initial_state=="gg" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_2e2mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_RAW );
 // 			
-// 			if( initial_state=="gg" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_2e2muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_RAW );
 // 			
-// 			if( initial_state=="qq" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_2e2mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_RAW, ME_RAW );
 // 			
-// 			if( initial_state=="qq" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_2e2muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_RAW, ME_RAW );
 // 		}
 // 		
-// 		if( Final_state=="4m" || Final_state=="4mu" || Final_state=="4mA" || Final_state=="4muA" )
+// 		if( Final_state_internal==FS_4mu || Final_state_internal==FS_4muA )
 // 		{
 // // 			/// Common mass for the same-flavor leptons
-// // 			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+// // 			Model_Parameters.MM = params_m_mu;
 // 			
-// 			if( initial_state=="NO" && (Final_state=="4m" || Final_state=="4mu") )
+// 			if( initial_state==IS_NO && (Final_state_internal==FS_4mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_RAW );
 // 			
-// 			if( initial_state=="NO" && (Final_state=="4mA" || Final_state=="4muA") )
+// 			if( initial_state==IS_NO && (Final_state_internal==FS_4muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_RAW );
 // 			
-// 			if( initial_state=="gg" && (Final_state=="4m" || Final_state=="4mu") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_4mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_RAW );
 // 			
-// 			if( initial_state=="gg" && (Final_state=="4mA" || Final_state=="4muA") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_4muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_RAW );
 // 			
-// 			if( initial_state=="qq" && (Final_state=="4m" || Final_state=="4mu") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_4mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_RAW, ME_RAW );
 // 			
-// 			if( initial_state=="qq" && (Final_state=="4mA" || Final_state=="4muA") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_4muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_RAW, ME_RAW );
 // 		}
 // 	}
 // 	
-// 	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" )
+// 	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA )
 // 	{
 // // 		/// Mass for the muons
-// // 		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+// // 		Model_Parameters.MM = params_m_mu;
 // 		
-// 		if( initial_state=="NO" && (Final_state=="2m" || Final_state=="2mu") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_RAW );
 // 		
-// 		if( initial_state=="NO" && (Final_state=="2mA" || Final_state=="2muA") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_RAW );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2m" || Final_state=="2mu") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_RAW );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2mA" || Final_state=="2muA") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_RAW );
 // 		
-// 		if( initial_state=="qq" && (Final_state=="2m" || Final_state=="2mu") )
+// 		if( initial_state==IS_qq && (Final_state_internal==FS_2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_RAW, ME_RAW );
 // 		
-// 		if( initial_state=="qq" && (Final_state=="2mA" || Final_state=="2muA") )
+// 		if( initial_state==IS_qq && (Final_state_internal==FS_2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_RAW, ME_RAW );
 // 	}
 	
@@ -2403,113 +2554,113 @@ int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_CPPProcess(string initial_state)
 
 
 /// ZZ and DY ME dispatcher
-int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_BKG_ZZ(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_BKG_ZZ(Initial_state_id initial_state)
 {
-	if( initial_state=="NO" && !(Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA") )
+	if( initial_state==IS_NO && !(Final_state_internal==FS_2mu || Final_state_internal==FS_2muA) )
 	{
 		cerr << "ZZ gg initial state is not supported.\n";
 		return 1;
 	}
-	if( initial_state=="gg" )
+	if( initial_state==IS_gg )
 	{
 		cerr << "ZZ productionless state is not supported.\n";
 		return 1;
 	}
 	
-	if( Final_state=="4e" || Final_state=="4eA" )
+	if( Final_state_internal==FS_4e || Final_state_internal==FS_4eA )
 	{
 		/// Common mass for the same-flavor leptons
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_e );
+		Model_Parameters.MM = params_m_e;
 		
-// 		if( initial_state=="NO" && Final_state=="4e" )
+// 		if( initial_state==IS_NO && Final_state_internal==FS_4e )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_ZZ_SF );
 // 		
-// 		if( initial_state=="NO" && Final_state=="4eA" )
+// 		if( initial_state==IS_NO && Final_state_internal==FS_4eA )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_ZZ_SFpA );
 // 		
-// 		if( initial_state=="gg" && Final_state=="4e" )
+// 		if( initial_state==IS_gg && Final_state_internal==FS_4e )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_gg_ZZ_SF );
 // 		
-// 		if( initial_state=="gg" && Final_state=="4eA" )
+// 		if( initial_state==IS_gg && Final_state_internal==FS_4eA )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_gg_ZZ_SFpA );
 		
-		if( initial_state=="qq" && Final_state=="4e" )
+		if( initial_state==IS_qq && Final_state_internal==FS_4e )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_qq_ZZ_DownType_SF, ME_qq_ZZ_UpType_SF );
 		
-		if( initial_state=="qq" && Final_state=="4eA" )
+		if( initial_state==IS_qq && Final_state_internal==FS_4eA )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_qq_ZZ_DownType_SFpA, ME_qq_ZZ_UpType_SFpA );
 	}
 	
-	if( Final_state=="2e2m" || Final_state=="2e2mu" || Final_state=="2e2mA" || Final_state=="2e2muA" )
+	if( Final_state_internal==FS_2e2mu || Final_state_internal==FS_2e2muA )
 	{
 		/// Common mass for the opposite-flavor leptons
-		Set_Of_Model_Parameters.set_block_entry( "mass", 11, params_m_e );
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+		Model_Parameters.Me = params_m_e;
+		Model_Parameters.MM = params_m_mu;
 		
-// 		if( initial_state=="NO" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_2e2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_ZZ_OF );
 // 		
-// 		if( initial_state=="NO" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_2e2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_ZZ_OFpA );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2e2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_gg_ZZ_OF );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2e2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_gg_ZZ_OFpA );
 		
-		if( initial_state=="qq" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_2e2mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_qq_ZZ_DownType_OF, ME_qq_ZZ_UpType_OF );
 		
-		if( initial_state=="qq" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_2e2muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_qq_ZZ_DownType_OFpA, ME_qq_ZZ_UpType_OFpA );
 	}
 	
-	if( Final_state=="4m" || Final_state=="4mu" || Final_state=="4mA" || Final_state=="4muA" )
+	if( Final_state_internal==FS_4mu || Final_state_internal==FS_4muA )
 	{
 		/// Common mass for the same-flavor leptons
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+		Model_Parameters.MM = params_m_mu;
 		
-// 		if( initial_state=="NO" && (Final_state=="4m" || Final_state=="4mu") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_4mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_ZZ_SF );
 // 		
-// 		if( initial_state=="NO" && (Final_state=="4mA" || Final_state=="4muA") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_4muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_ZZ_SFpA );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="4m" || Final_state=="4mu") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_4mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_gg_ZZ_SF );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="4mA" || Final_state=="4muA") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_4muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_gg_ZZ_SFpA );
 		
-		if( initial_state=="qq" && (Final_state=="4m" || Final_state=="4mu") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_4mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_qq_ZZ_DownType_SF, ME_qq_ZZ_UpType_SF );
 		
-		if( initial_state=="qq" && (Final_state=="4mA" || Final_state=="4muA") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_4muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_qq_ZZ_DownType_SFpA, ME_qq_ZZ_UpType_SFpA );
 	}
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA )
 	{
 		/// Mass for the muons
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+		Model_Parameters.MM = params_m_mu;
 		
-		if( initial_state=="NO" && (Final_state=="2m" || Final_state=="2mu") )
+		if( initial_state==IS_NO && (Final_state_internal==FS_2mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_DY_2l );
 		
-		if( initial_state=="NO" && (Final_state=="2mA" || Final_state=="2muA") )
+		if( initial_state==IS_NO && (Final_state_internal==FS_2muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_DY_2lpA );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2m" || Final_state=="2mu") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_gg_DY_2l );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2mA" || Final_state=="2muA") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_gg_DY_2lpA );
 		
-		if( initial_state=="qq" && (Final_state=="2m" || Final_state=="2mu") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_2mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_qq_DY_DownType_2l, ME_qq_DY_UpType_2l );
 		
-		if( initial_state=="qq" && (Final_state=="2mA" || Final_state=="2muA") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_2muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_qq_DY_DownType_2lpA, ME_qq_DY_UpType_2lpA );
 	}
 	
@@ -2519,118 +2670,118 @@ int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_BKG_ZZ(string initial_state)
 
 
 /// Z4l Background ME dispatcher
-int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_Z4l_BKG(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_Z4l_BKG(Initial_state_id initial_state)
 {
-	if( initial_state=="NO" )
+	if( initial_state==IS_NO )
 	{
 		cerr << "Z -> 4l gg initial state is not supported.\n";
 		return 1;
 	}
-	if( initial_state=="gg" )
+	if( initial_state==IS_gg )
 	{
 		cerr << "Z -> 4l productionless state is not supported.\n";
 		return 1;
 	}
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA )
 	{
 		cerr << "Z -> 4l to 2 lepton is pointless. Run Drell-Yan (DY) instead (ZZ-based).\n";
 		return 1;
 	}
 	
-	if( Final_state=="4e" || Final_state=="4eA" )
+	if( Final_state_internal==FS_4e || Final_state_internal==FS_4eA )
 	{
 		/// Common mass for the same-flavor leptons
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_e );
+		Model_Parameters.MM = params_m_e;
 		
-// 		if( initial_state=="NO" && Final_state=="4e" )
+// 		if( initial_state==IS_NO && Final_state_internal==FS_4e )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Z4l_BKG_SF );
 // 		
-// 		if( initial_state=="NO" && Final_state=="4eA" )
+// 		if( initial_state==IS_NO && Final_state_internal==FS_4eA )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Z4l_BKG_SFpA );
 // 		
-// 		if( initial_state=="gg" && Final_state=="4e" )
+// 		if( initial_state==IS_gg && Final_state_internal==FS_4e )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_gg_Z4l_BKG_SF );
 // 		
-// 		if( initial_state=="gg" && Final_state=="4eA" )
+// 		if( initial_state==IS_gg && Final_state_internal==FS_4eA )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_gg_Z4l_BKG_SFpA );
 		
-		if( initial_state=="qq" && Final_state=="4e" )
+		if( initial_state==IS_qq && Final_state_internal==FS_4e )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_qq_Z4l_BKG_DownType_SF, ME_qq_Z4l_BKG_UpType_SF );
 		
-		if( initial_state=="qq" && Final_state=="4eA" )
+		if( initial_state==IS_qq && Final_state_internal==FS_4eA )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_qq_Z4l_BKG_DownType_SFpA, ME_qq_Z4l_BKG_UpType_SFpA );
 	}
 	
-	if( Final_state=="2e2m" || Final_state=="2e2mu" || Final_state=="2e2mA" || Final_state=="2e2muA" )
+	if( Final_state_internal==FS_2e2mu || Final_state_internal==FS_2e2muA )
 	{
 		/// Common mass for the opposite-flavor leptons
-		Set_Of_Model_Parameters.set_block_entry( "mass", 11, params_m_e );
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+		Model_Parameters.Me = params_m_e;
+		Model_Parameters.MM = params_m_mu;
 		
-// 		if( initial_state=="NO" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_2e2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Z4l_BKG_OF );
 // 		
-// 		if( initial_state=="NO" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_2e2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Z4l_BKG_OFpA );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2e2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_gg_Z4l_BKG_OF );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2e2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_gg_Z4l_BKG_OFpA );
 		
-		if( initial_state=="qq" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_2e2mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_qq_Z4l_BKG_DownType_OF, ME_qq_Z4l_BKG_UpType_OF );
 		
-		if( initial_state=="qq" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_2e2muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_qq_Z4l_BKG_DownType_OFpA, ME_qq_Z4l_BKG_UpType_OFpA );
 	}
 	
-	if( Final_state=="4m" || Final_state=="4mu" || Final_state=="4mA" || Final_state=="4muA" )
+	if( Final_state_internal==FS_4mu || Final_state_internal==FS_4muA )
 	{
 		/// Common mass for the same-flavor leptons
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+		Model_Parameters.MM = params_m_mu;
 		
-// 		if( initial_state=="NO" && (Final_state=="4m" || Final_state=="4mu") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_4mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Z4l_BKG_SF );
 // 		
-// 		if( initial_state=="NO" && (Final_state=="4mA" || Final_state=="4muA") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_4muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Z4l_BKG_SFpA );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="4m" || Final_state=="4mu") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_4mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_gg_Z4l_BKG_SF );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="4mA" || Final_state=="4muA") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_4muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_gg_Z4l_BKG_SFpA );
 		
-		if( initial_state=="qq" && (Final_state=="4m" || Final_state=="4mu") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_4mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_qq_Z4l_BKG_DownType_SF, ME_qq_Z4l_BKG_UpType_SF );
 		
-		if( initial_state=="qq" && (Final_state=="4mA" || Final_state=="4muA") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_4muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_qq_Z4l_BKG_DownType_SFpA, ME_qq_Z4l_BKG_UpType_SFpA );
 	}
 	
-// 	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" )
+// 	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA )
 // 	{
 // 		/// Mass for the muons
-// 		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+// 		Model_Parameters.MM = params_m_mu;
 // 		
-// 		if( initial_state=="NO" && (Final_state=="2m" || Final_state=="2mu") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Z4l_BKG_2l );
 // 		
-// 		if( initial_state=="NO" && (Final_state=="2mA" || Final_state=="2muA") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Z4l_BKG_2lpA );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2m" || Final_state=="2mu") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_gg_Z4l_BKG__2l );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2mA" || Final_state=="2muA") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_gg_Z4l_BKG__2lpA );
 // 		
-// 		if( initial_state=="qq" && (Final_state=="2m" || Final_state=="2mu") )
+// 		if( initial_state==IS_qq && (Final_state_internal==FS_2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_qq_Z4l_BKG_DownType_2l, ME_qq_Z4l_BKG_UpType_2l );
 // 		
-// 		if( initial_state=="qq" && (Final_state=="2mA" || Final_state=="2muA") )
+// 		if( initial_state==IS_qq && (Final_state_internal==FS_2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_qq_Z4l_BKG_DownType_2lpA, ME_qq_Z4l_BKG_UpType_2lpA );
 // 	}
 	
@@ -2640,118 +2791,118 @@ int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_Z4l_BKG(string initial_state)
 
 
 /// Z4l Signal ME dispatcher
-int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_Z4l_SIG(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_Z4l_SIG(Initial_state_id initial_state)
 {
-	if( initial_state=="NO" )
+	if( initial_state==IS_NO )
 	{
 		cerr << "Z -> 4l gg initial state is not supported.\n";
 		return 1;
 	}
-	if( initial_state=="gg" )
+	if( initial_state==IS_gg )
 	{
 		cerr << "Z -> 4l productionless state is not supported.\n";
 		return 1;
 	}
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA )
 	{
 		cerr << "Z -> 4l to 2 lepton is pointless. Run Drell-Yan (DY) instead (ZZ-based).\n";
 		return 1;
 	}
 	
-	if( Final_state=="4e" || Final_state=="4eA" )
+	if( Final_state_internal==FS_4e || Final_state_internal==FS_4eA )
 	{
 		/// Common mass for the same-flavor leptons
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_e );
+		Model_Parameters.MM = params_m_e;
 		
-// 		if( initial_state=="NO" && Final_state=="4e" )
+// 		if( initial_state==IS_NO && Final_state_internal==FS_4e )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Z4l_SIG_SF );
 // 		
-// 		if( initial_state=="NO" && Final_state=="4eA" )
+// 		if( initial_state==IS_NO && Final_state_internal==FS_4eA )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Z4l_SIG_SFpA );
 // 		
-// 		if( initial_state=="gg" && Final_state=="4e" )
+// 		if( initial_state==IS_gg && Final_state_internal==FS_4e )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_gg_Z4l_SIG_SF );
 // 		
-// 		if( initial_state=="gg" && Final_state=="4eA" )
+// 		if( initial_state==IS_gg && Final_state_internal==FS_4eA )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_gg_Z4l_SIG_SFpA );
 		
-		if( initial_state=="qq" && Final_state=="4e" )
+		if( initial_state==IS_qq && Final_state_internal==FS_4e )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_qq_Z4l_SIG_DownType_SF, ME_qq_Z4l_SIG_UpType_SF );
 		
-		if( initial_state=="qq" && Final_state=="4eA" )
+		if( initial_state==IS_qq && Final_state_internal==FS_4eA )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_qq_Z4l_SIG_DownType_SFpA, ME_qq_Z4l_SIG_UpType_SFpA );
 	}
 	
-	if( Final_state=="2e2m" || Final_state=="2e2mu" || Final_state=="2e2mA" || Final_state=="2e2muA" )
+	if( Final_state_internal==FS_2e2mu || Final_state_internal==FS_2e2muA )
 	{
 		/// Common mass for the opposite-flavor leptons
-		Set_Of_Model_Parameters.set_block_entry( "mass", 11, params_m_e );
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+		Model_Parameters.Me = params_m_e;
+		Model_Parameters.MM = params_m_mu;
 		
-// 		if( initial_state=="NO" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_2e2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Z4l_SIG_OF );
 // 		
-// 		if( initial_state=="NO" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_2e2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Z4l_SIG_OFpA );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2e2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_gg_Z4l_SIG_OF );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2e2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_gg_Z4l_SIG_OFpA );
 		
-		if( initial_state=="qq" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_2e2mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_qq_Z4l_SIG_DownType_OF, ME_qq_Z4l_SIG_UpType_OF );
 		
-		if( initial_state=="qq" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_2e2muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_qq_Z4l_SIG_DownType_OFpA, ME_qq_Z4l_SIG_UpType_OFpA );
 	}
 	
-	if( Final_state=="4m" || Final_state=="4mu" || Final_state=="4mA" || Final_state=="4muA" )
+	if( Final_state_internal==FS_4mu || Final_state_internal==FS_4muA )
 	{
 		/// Common mass for the same-flavor leptons
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+		Model_Parameters.MM = params_m_mu;
 		
-// 		if( initial_state=="NO" && (Final_state=="4m" || Final_state=="4mu") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_4mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Z4l_SIG_SF );
 // 		
-// 		if( initial_state=="NO" && (Final_state=="4mA" || Final_state=="4muA") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_4muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Z4l_SIG_SFpA );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="4m" || Final_state=="4mu") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_4mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_gg_Z4l_SIG_SF );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="4mA" || Final_state=="4muA") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_4muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_gg_Z4l_SIG_SFpA );
 		
-		if( initial_state=="qq" && (Final_state=="4m" || Final_state=="4mu") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_4mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_qq_Z4l_SIG_DownType_SF, ME_qq_Z4l_SIG_UpType_SF );
 		
-		if( initial_state=="qq" && (Final_state=="4mA" || Final_state=="4muA") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_4muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_qq_Z4l_SIG_DownType_SFpA, ME_qq_Z4l_SIG_UpType_SFpA );
 	}
 	
-// 	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" )
+// 	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA )
 // 	{
 // 		/// Mass for the muons
-// 		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+// 		Model_Parameters.MM = params_m_mu;
 // 		
-// 		if( initial_state=="NO" && (Final_state=="2m" || Final_state=="2mu") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Z4l_SIG_2l );
 // 		
-// 		if( initial_state=="NO" && (Final_state=="2mA" || Final_state=="2muA") )
+// 		if( initial_state==IS_NO && (Final_state_internal==FS_2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Z4l_SIG_2lpA );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2m" || Final_state=="2mu") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_gg_Z4l_SIG__2l );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2mA" || Final_state=="2muA") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_gg_Z4l_SIG__2lpA );
 // 		
-// 		if( initial_state=="qq" && (Final_state=="2m" || Final_state=="2mu") )
+// 		if( initial_state==IS_qq && (Final_state_internal==FS_2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_qq_Z4l_SIG_DownType_2l, ME_qq_Z4l_SIG_UpType_2l );
 // 		
-// 		if( initial_state=="qq" && (Final_state=="2mA" || Final_state=="2muA") )
+// 		if( initial_state==IS_qq && (Final_state_internal==FS_2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_qq_Z4l_SIG_DownType_2lpA, ME_qq_Z4l_SIG_UpType_2lpA );
 // 	}
 	
@@ -2761,187 +2912,187 @@ int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_Z4l_SIG(string initial_state)
 
 
 /// Spin-0 ME dispatcher
-int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_SIG_Spin0(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_SIG_Spin0(Initial_state_id initial_state)
 {
-	if( initial_state=="qq" )
+	if( initial_state==IS_qq )
 	{
 		cerr << "Spin-0 qqbar initial state is redundant, thus not provided.\n";
 		return 1;
 	}
 	
-	if( Resonance_decay_mode=="ZZ" )
+	if( Resonance_decay_mode_internal==RDM_ZZ )
 	{
-		if( Final_state=="4e" || Final_state=="4eA" )
+		if( Final_state_internal==FS_4e || Final_state_internal==FS_4eA )
 		{
 			/// Common mass for the same-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_e );
+			Model_Parameters.MM = params_m_e;
 			
-			if( initial_state=="NO" && Final_state=="4e" )
+			if( initial_state==IS_NO && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin0_SF );
 			
-			if( initial_state=="NO" && Final_state=="4eA" )
+			if( initial_state==IS_NO && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin0_SFpA );
 			
-			if( initial_state=="gg" && Final_state=="4e" )
+			if( initial_state==IS_gg && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin0_SF );
 			
-			if( initial_state=="gg" && Final_state=="4eA" )
+			if( initial_state==IS_gg && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin0_SFpA );
 			
-// 			if( initial_state=="qq" && Final_state=="4e" )
+// 			if( initial_state==IS_qq && Final_state_internal==FS_4e )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin0_DownType_SF, ME_Signal_qq_Spin0_UpType_SF );
 // 			
-// 			if( initial_state=="qq" && Final_state=="4eA" )
+// 			if( initial_state==IS_qq && Final_state_internal==FS_4eA )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin0_DownType_SFpA, ME_Signal_qq_Spin0_UpType_SFpA );
 		}
 		
-		if( Final_state=="2e2m" || Final_state=="2e2mu" || Final_state=="2e2mA" || Final_state=="2e2muA" )
+		if( Final_state_internal==FS_2e2mu || Final_state_internal==FS_2e2muA )
 		{
 			/// Common mass for the opposite-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 11, params_m_e );
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+			Model_Parameters.Me = params_m_e;
+			Model_Parameters.MM = params_m_mu;
 			
-			if( initial_state=="NO" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin0_OF );
 			
-			if( initial_state=="NO" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin0_OFpA );
 			
-			if( initial_state=="gg" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin0_OF );
 			
-			if( initial_state=="gg" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin0_OFpA );
 			
-// 			if( initial_state=="qq" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_2e2mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin0_DownType_OF, ME_Signal_qq_Spin0_UpType_OF );
 // 			
-// 			if( initial_state=="qq" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_2e2muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin0_DownType_OFpA, ME_Signal_qq_Spin0_UpType_OFpA );
 		}
 		
-		if( Final_state=="4m" || Final_state=="4mu" || Final_state=="4mA" || Final_state=="4muA" )
+		if( Final_state_internal==FS_4mu || Final_state_internal==FS_4muA )
 		{
 			/// Common mass for the same-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+			Model_Parameters.MM = params_m_mu;
 			
-			if( initial_state=="NO" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin0_SF );
 			
-			if( initial_state=="NO" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin0_SFpA );
 			
-			if( initial_state=="gg" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin0_SF );
 			
-			if( initial_state=="gg" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin0_SFpA );
 			
-// 			if( initial_state=="qq" && (Final_state=="4m" || Final_state=="4mu") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_4mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin0_DownType_SF, ME_Signal_qq_Spin0_UpType_SF );
 // 			
-// 			if( initial_state=="qq" && (Final_state=="4mA" || Final_state=="4muA") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_4muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin0_DownType_SFpA, ME_Signal_qq_Spin0_UpType_SFpA );
 		}
 	}
 	
-	if( Resonance_decay_mode=="2l" )
+	if( Resonance_decay_mode_internal==RDM_2l )
 	{
-		if( Final_state=="4e" || Final_state=="4eA" )
+		if( Final_state_internal==FS_4e || Final_state_internal==FS_4eA )
 		{
 			/// Common mass for the same-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_e );
+			Model_Parameters.MM = params_m_e;
 			
-			if( initial_state=="NO" && Final_state=="4e" )
+			if( initial_state==IS_NO && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin0_2f_SF );
 			
-			if( initial_state=="NO" && Final_state=="4eA" )
+			if( initial_state==IS_NO && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin0_2f_SFpA );
 			
-			if( initial_state=="gg" && Final_state=="4e" )
+			if( initial_state==IS_gg && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin0_2f_SF );
 			
-			if( initial_state=="gg" && Final_state=="4eA" )
+			if( initial_state==IS_gg && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin0_2f_SFpA );
 			
-// 			if( initial_state=="qq" && Final_state=="4e" )
+// 			if( initial_state==IS_qq && Final_state_internal==FS_4e )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin0_2f_DownType_SF, ME_Signal_qq_Spin0_2f_UpType_SF );
 // 			
-// 			if( initial_state=="qq" && Final_state=="4eA" )
+// 			if( initial_state==IS_qq && Final_state_internal==FS_4eA )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin0_2f_DownType_SFpA, ME_Signal_qq_Spin0_2f_UpType_SFpA );
 		}
 		
-		if( Final_state=="2e2m" || Final_state=="2e2mu" || Final_state=="2e2mA" || Final_state=="2e2muA" )
+		if( Final_state_internal==FS_2e2mu || Final_state_internal==FS_2e2muA )
 		{
 			/// Common mass for the opposite-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 11, params_m_e );
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+			Model_Parameters.Me = params_m_e;
+			Model_Parameters.MM = params_m_mu;
 			
-			if( initial_state=="NO" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin0_2f_OF );
 			
-			if( initial_state=="NO" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin0_2f_OFpA );
 			
-			if( initial_state=="gg" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin0_2f_OF );
 			
-			if( initial_state=="gg" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin0_2f_OFpA );
 			
-// 			if( initial_state=="qq" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_2e2mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin0_2f_DownType_OF, ME_Signal_qq_Spin0_2f_UpType_OF );
 // 			
-// 			if( initial_state=="qq" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_2e2muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin0_2f_DownType_OFpA, ME_Signal_qq_Spin0_2f_UpType_OFpA );
 		}
 		
-		if( Final_state=="4m" || Final_state=="4mu" || Final_state=="4mA" || Final_state=="4muA" )
+		if( Final_state_internal==FS_4mu || Final_state_internal==FS_4muA )
 		{
 			/// Common mass for the same-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+			Model_Parameters.MM = params_m_mu;
 			
-			if( initial_state=="NO" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin0_2f_SF );
 			
-			if( initial_state=="NO" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin0_2f_SFpA );
 			
-			if( initial_state=="gg" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin0_2f_SF );
 			
-			if( initial_state=="gg" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin0_2f_SFpA );
 			
-// 			if( initial_state=="qq" && (Final_state=="4m" || Final_state=="4mu") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_4mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin0_2f_DownType_SF, ME_Signal_qq_Spin0_2f_UpType_SF );
 // 			
-// 			if( initial_state=="qq" && (Final_state=="4mA" || Final_state=="4muA") )
+// 			if( initial_state==IS_qq && (Final_state_internal==FS_4muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin0_2f_DownType_SFpA, ME_Signal_qq_Spin0_2f_UpType_SFpA );
 		}
 	}
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA )
 	{
 		/// Mass for the muons
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+		Model_Parameters.MM = params_m_mu;
 		
-		if( initial_state=="NO" && (Final_state=="2m" || Final_state=="2mu") )
+		if( initial_state==IS_NO && (Final_state_internal==FS_2mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin0_2l );
 		
-		if( initial_state=="NO" && (Final_state=="2mA" || Final_state=="2muA") )
+		if( initial_state==IS_NO && (Final_state_internal==FS_2muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin0_2lpA );
 		
-		if( initial_state=="gg" && (Final_state=="2m" || Final_state=="2mu") )
+		if( initial_state==IS_gg && (Final_state_internal==FS_2mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin0_2l );
 		
-		if( initial_state=="gg" && (Final_state=="2mA" || Final_state=="2muA") )
+		if( initial_state==IS_gg && (Final_state_internal==FS_2muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin0_2lpA );
 		
-// 		if( initial_state=="qq" && (Final_state=="2m" || Final_state=="2mu") )
+// 		if( initial_state==IS_qq && (Final_state_internal==FS_2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin0_DownType_2l, ME_Signal_qq_Spin0_UpType_2l );
 		
-// 		if( initial_state=="qq" && (Final_state=="2mA" || Final_state=="2muA") )
+// 		if( initial_state==IS_qq && (Final_state_internal==FS_2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin0_DownType_2lpA, ME_Signal_qq_Spin0_UpType_2lpA );
 	}
 	
@@ -2951,187 +3102,187 @@ int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_SIG_Spin0(string initial_state)
 
 
 /// Spin-1 ME dispatcher
-int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_SIG_Spin1(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_SIG_Spin1(Initial_state_id initial_state)
 {
-	if( initial_state=="gg" )
+	if( initial_state==IS_gg )
 	{
 		cerr << "Spin-1 gg initial state is not possible, thus not provided.\n";
 		return 1;
 	}
 	
-	if( Resonance_decay_mode=="ZZ" )
+	if( Resonance_decay_mode_internal==RDM_ZZ )
 	{
-		if( Final_state=="4e" || Final_state=="4eA" )
+		if( Final_state_internal==FS_4e || Final_state_internal==FS_4eA )
 		{
 			/// Common mass for the same-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_e );
+			Model_Parameters.MM = params_m_e;
 			
-			if( initial_state=="NO" && Final_state=="4e" )
+			if( initial_state==IS_NO && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin1_SF );
 			
-			if( initial_state=="NO" && Final_state=="4eA" )
+			if( initial_state==IS_NO && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin1_SFpA );
 			
-// 			if( initial_state=="gg" && Final_state=="4e" )
+// 			if( initial_state==IS_gg && Final_state_internal==FS_4e )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin1_SF );
 // 			
-// 			if( initial_state=="gg" && Final_state=="4eA" )
+// 			if( initial_state==IS_gg && Final_state_internal==FS_4eA )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin1_SFpA );
 			
-			if( initial_state=="qq" && Final_state=="4e" )
+			if( initial_state==IS_qq && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin1_DownType_SF, ME_Signal_qq_Spin1_UpType_SF );
 			
-			if( initial_state=="qq" && Final_state=="4eA" )
+			if( initial_state==IS_qq && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin1_DownType_SFpA, ME_Signal_qq_Spin1_UpType_SFpA );
 		}
 		
-		if( Final_state=="2e2m" || Final_state=="2e2mu" || Final_state=="2e2mA" || Final_state=="2e2muA" )
+		if( Final_state_internal==FS_2e2mu || Final_state_internal==FS_2e2muA )
 		{
 			/// Common mass for the opposite-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 11, params_m_e );
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+			Model_Parameters.Me = params_m_e;
+			Model_Parameters.MM = params_m_mu;
 			
-			if( initial_state=="NO" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin1_OF );
 			
-			if( initial_state=="NO" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin1_OFpA );
 			
-//	 		if( initial_state=="gg" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+//	 		if( initial_state==IS_gg && (Final_state_internal==FS_2e2mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin1_OF );
 // 			
-// 			if( initial_state=="gg" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_2e2muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin1_OFpA );
 			
-			if( initial_state=="qq" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin1_DownType_OF, ME_Signal_qq_Spin1_UpType_OF );
 			
-			if( initial_state=="qq" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin1_DownType_OFpA, ME_Signal_qq_Spin1_UpType_OFpA );
 		}
 		
-		if( Final_state=="4m" || Final_state=="4mu" || Final_state=="4mA" || Final_state=="4muA" )
+		if( Final_state_internal==FS_4mu || Final_state_internal==FS_4muA )
 		{
 			/// Common mass for the same-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+			Model_Parameters.MM = params_m_mu;
 			
-			if( initial_state=="NO" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin1_SF );
 			
-			if( initial_state=="NO" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin1_SFpA );
 			
-// 			if( initial_state=="gg" && (Final_state=="4m" || Final_state=="4mu") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_4mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin1_SF );
 // 			
-// 			if( initial_state=="gg" && (Final_state=="4mA" || Final_state=="4muA") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_4muA) )
 //	 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin1_SFpA );
 			
-			if( initial_state=="qq" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin1_DownType_SF, ME_Signal_qq_Spin1_UpType_SF );
 			
-			if( initial_state=="qq" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin1_DownType_SFpA, ME_Signal_qq_Spin1_UpType_SFpA );
 		}
 	}
 	
-	if( Resonance_decay_mode=="2l" )
+	if( Resonance_decay_mode_internal==RDM_2l )
 	{
-		if( Final_state=="4e" || Final_state=="4eA" )
+		if( Final_state_internal==FS_4e || Final_state_internal==FS_4eA )
 		{
 			/// Common mass for the same-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_e );
+			Model_Parameters.MM = params_m_e;
 			
-			if( initial_state=="NO" && Final_state=="4e" )
+			if( initial_state==IS_NO && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin1_2f_SF );
 			
-			if( initial_state=="NO" && Final_state=="4eA" )
+			if( initial_state==IS_NO && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin1_2f_SFpA );
 			
-// 			if( initial_state=="gg" && Final_state=="4e" )
+// 			if( initial_state==IS_gg && Final_state_internal==FS_4e )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin1_2f_SF );
 // 			
-// 			if( initial_state=="gg" && Final_state=="4eA" )
+// 			if( initial_state==IS_gg && Final_state_internal==FS_4eA )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin1_2f_SFpA );
 			
-			if( initial_state=="qq" && Final_state=="4e" )
+			if( initial_state==IS_qq && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin1_2f_DownType_SF, ME_Signal_qq_Spin1_2f_UpType_SF );
 			
-			if( initial_state=="qq" && Final_state=="4eA" )
+			if( initial_state==IS_qq && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin1_2f_DownType_SFpA, ME_Signal_qq_Spin1_2f_UpType_SFpA );
 		}
 		
-		if( Final_state=="2e2m" || Final_state=="2e2mu" || Final_state=="2e2mA" || Final_state=="2e2muA" )
+		if( Final_state_internal==FS_2e2mu || Final_state_internal==FS_2e2muA )
 		{
 			/// Common mass for the opposite-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 11, params_m_e );
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+			Model_Parameters.Me = params_m_e;
+			Model_Parameters.MM = params_m_mu;
 			
-			if( initial_state=="NO" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin1_2f_OF );
 			
-			if( initial_state=="NO" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin1_2f_OFpA );
 			
-//	 		if( initial_state=="gg" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+//	 		if( initial_state==IS_gg && (Final_state_internal==FS_2e2mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin1_2f_OF );
 // 			
-// 			if( initial_state=="gg" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_2e2muA) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin1_2f_OFpA );
 			
-			if( initial_state=="qq" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin1_2f_DownType_OF, ME_Signal_qq_Spin1_2f_UpType_OF );
 			
-			if( initial_state=="qq" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin1_2f_DownType_OFpA, ME_Signal_qq_Spin1_2f_UpType_OFpA );
 		}
 		
-		if( Final_state=="4m" || Final_state=="4mu" || Final_state=="4mA" || Final_state=="4muA" )
+		if( Final_state_internal==FS_4mu || Final_state_internal==FS_4muA )
 		{
 			/// Common mass for the same-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+			Model_Parameters.MM = params_m_mu;
 			
-			if( initial_state=="NO" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin1_2f_SF );
 			
-			if( initial_state=="NO" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin1_2f_SFpA );
 			
-// 			if( initial_state=="gg" && (Final_state=="4m" || Final_state=="4mu") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_4mu) )
 // 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin1_2f_SF );
 // 			
-// 			if( initial_state=="gg" && (Final_state=="4mA" || Final_state=="4muA") )
+// 			if( initial_state==IS_gg && (Final_state_internal==FS_4muA) )
 //	 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin1_2f_SFpA );
 			
-			if( initial_state=="qq" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin1_2f_DownType_SF, ME_Signal_qq_Spin1_2f_UpType_SF );
 			
-			if( initial_state=="qq" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin1_2f_DownType_SFpA, ME_Signal_qq_Spin1_2f_UpType_SFpA );
 		}
 	}
 		
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA )
 	{
 		/// Mass for the muons
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+		Model_Parameters.MM = params_m_mu;
 		
-		if( initial_state=="NO" && (Final_state=="2m" || Final_state=="2mu") )
+		if( initial_state==IS_NO && (Final_state_internal==FS_2mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin1_2l );
 		
-		if( initial_state=="NO" && (Final_state=="2mA" || Final_state=="2muA") )
+		if( initial_state==IS_NO && (Final_state_internal==FS_2muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin1_2lpA );
 		
-// 		if( initial_state=="gg" && (Final_state=="2m" || Final_state=="2mu") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2mu) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin1_2l );
 // 		
-// 		if( initial_state=="gg" && (Final_state=="2mA" || Final_state=="2muA") )
+// 		if( initial_state==IS_gg && (Final_state_internal==FS_2muA) )
 // 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin1_2lpA );
 		
-		if( initial_state=="qq" && (Final_state=="2m" || Final_state=="2mu") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_2mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin1_DownType_2l, ME_Signal_qq_Spin1_UpType_2l );
 		
-		if( initial_state=="qq" && (Final_state=="2mA" || Final_state=="2muA") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_2muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin1_DownType_2lpA, ME_Signal_qq_Spin1_UpType_2lpA );
 	}
 	
@@ -3141,181 +3292,181 @@ int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_SIG_Spin1(string initial_state)
 
 
 /// Spin-2 ME dispatcher
-int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_SIG_Spin2(string initial_state)
+int MEKD_MG::Run_MEKD_MG_ME_Dispatcher_SIG_Spin2(Initial_state_id initial_state)
 {
-	if( Resonance_decay_mode=="ZZ" )
+	if( Resonance_decay_mode_internal==RDM_ZZ )
 	{
-		if( Final_state=="4e" || Final_state=="4eA" )
+		if( Final_state_internal==FS_4e || Final_state_internal==FS_4eA )
 		{
 			/// Common mass for the same-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_e );
+			Model_Parameters.MM = params_m_e;
 			
-			if( initial_state=="NO" && Final_state=="4e" )
+			if( initial_state==IS_NO && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin2_SF );
 			
-			if( initial_state=="NO" && Final_state=="4eA" )
+			if( initial_state==IS_NO && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin2_SFpA );
 			
-			if( initial_state=="gg" && Final_state=="4e" )
+			if( initial_state==IS_gg && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin2_SF );
 			
-			if( initial_state=="gg" && Final_state=="4eA" )
+			if( initial_state==IS_gg && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin2_SFpA );
 			
-			if( initial_state=="qq" && Final_state=="4e" )
+			if( initial_state==IS_qq && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin2_DownType_SF, ME_Signal_qq_Spin2_UpType_SF );
 			
-			if( initial_state=="qq" && Final_state=="4eA" )
+			if( initial_state==IS_qq && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin2_DownType_SFpA, ME_Signal_qq_Spin2_UpType_SFpA );
 		}
 		
-		if( Final_state=="2e2m" || Final_state=="2e2mu" || Final_state=="2e2mA" || Final_state=="2e2muA" )
+		if( Final_state_internal==FS_2e2mu || Final_state_internal==FS_2e2muA )
 		{
 			/// Common mass for the opposite-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 11, params_m_e );
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+			Model_Parameters.Me = params_m_e;
+			Model_Parameters.MM = params_m_mu;
 			
-			if( initial_state=="NO" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin2_OF );
 			
-			if( initial_state=="NO" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin2_OFpA );
 			
-			if( initial_state=="gg" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin2_OF );
 			
-			if( initial_state=="gg" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin2_OFpA );
 			
-			if( initial_state=="qq" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin2_DownType_OF, ME_Signal_qq_Spin2_UpType_OF );
 			
-			if( initial_state=="qq" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin2_DownType_OFpA, ME_Signal_qq_Spin2_UpType_OFpA );
 		}
 		
-		if( Final_state=="4m" || Final_state=="4mu" || Final_state=="4mA" || Final_state=="4muA" )
+		if( Final_state_internal==FS_4mu || Final_state_internal==FS_4muA )
 		{
 			/// Common mass for the same-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+			Model_Parameters.MM = params_m_mu;
 			
-			if( initial_state=="NO" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin2_SF );
 			
-			if( initial_state=="NO" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin2_SFpA );
 			
-			if( initial_state=="gg" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin2_SF );
 			
-			if( initial_state=="gg" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin2_SFpA );
 			
-			if( initial_state=="qq" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin2_DownType_SF, ME_Signal_qq_Spin2_UpType_SF );
 			
-			if( initial_state=="qq" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin2_DownType_SFpA, ME_Signal_qq_Spin2_UpType_SFpA );
 		}
 	}
 	
-	if( Resonance_decay_mode=="2l" )
+	if( Resonance_decay_mode_internal==RDM_2l )
 	{
-		if( Final_state=="4e" || Final_state=="4eA" )
+		if( Final_state_internal==FS_4e || Final_state_internal==FS_4eA )
 		{
 			/// Common mass for the same-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_e );
+			Model_Parameters.MM = params_m_e;
 			
-			if( initial_state=="NO" && Final_state=="4e" )
+			if( initial_state==IS_NO && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin2_2f_SF );
 			
-			if( initial_state=="NO" && Final_state=="4eA" )
+			if( initial_state==IS_NO && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin2_2f_SFpA );
 			
-			if( initial_state=="gg" && Final_state=="4e" )
+			if( initial_state==IS_gg && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin2_2f_SF );
 			
-			if( initial_state=="gg" && Final_state=="4eA" )
+			if( initial_state==IS_gg && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin2_2f_SFpA );
 			
-			if( initial_state=="qq" && Final_state=="4e" )
+			if( initial_state==IS_qq && Final_state_internal==FS_4e )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin2_2f_DownType_SF, ME_Signal_qq_Spin2_2f_UpType_SF );
 			
-			if( initial_state=="qq" && Final_state=="4eA" )
+			if( initial_state==IS_qq && Final_state_internal==FS_4eA )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin2_2f_DownType_SFpA, ME_Signal_qq_Spin2_2f_UpType_SFpA );
 		}
 		
-		if( Final_state=="2e2m" || Final_state=="2e2mu" || Final_state=="2e2mA" || Final_state=="2e2muA" )
+		if( Final_state_internal==FS_2e2mu || Final_state_internal==FS_2e2muA )
 		{
 			/// Common mass for the opposite-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 11, params_m_e );
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+			Model_Parameters.Me = params_m_e;
+			Model_Parameters.MM = params_m_mu;
 			
-			if( initial_state=="NO" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin2_2f_OF );
 			
-			if( initial_state=="NO" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin2_2f_OFpA );
 			
-			if( initial_state=="gg" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin2_2f_OF );
 			
-			if( initial_state=="gg" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin2_2f_OFpA );
 			
-			if( initial_state=="qq" && (Final_state=="2e2m" || Final_state=="2e2mu") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_2e2mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin2_2f_DownType_OF, ME_Signal_qq_Spin2_2f_UpType_OF );
 			
-			if( initial_state=="qq" && (Final_state=="2e2mA" || Final_state=="2e2muA") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_2e2muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin2_2f_DownType_OFpA, ME_Signal_qq_Spin2_2f_UpType_OFpA );
 		}
 		
-		if( Final_state=="4m" || Final_state=="4mu" || Final_state=="4mA" || Final_state=="4muA" )
+		if( Final_state_internal==FS_4mu || Final_state_internal==FS_4muA )
 		{
 			/// Common mass for the same-flavor leptons
-			Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+			Model_Parameters.MM = params_m_mu;
 			
-			if( initial_state=="NO" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin2_2f_SF );
 			
-			if( initial_state=="NO" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_NO && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin2_2f_SFpA );
 			
-			if( initial_state=="gg" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin2_2f_SF );
 			
-			if( initial_state=="gg" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_gg && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin2_2f_SFpA );
 			
-			if( initial_state=="qq" && (Final_state=="4m" || Final_state=="4mu") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_4mu) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin2_2f_DownType_SF, ME_Signal_qq_Spin2_2f_UpType_SF );
 			
-			if( initial_state=="qq" && (Final_state=="4mA" || Final_state=="4muA") )
+			if( initial_state==IS_qq && (Final_state_internal==FS_4muA) )
 				return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin2_2f_DownType_SFpA, ME_Signal_qq_Spin2_2f_UpType_SFpA );
 		}
 	}
 	
-	if( Final_state=="2m" || Final_state=="2mu" || Final_state=="2mA" || Final_state=="2muA" )
+	if( Final_state_internal==FS_2mu || Final_state_internal==FS_2muA )
 	{
 		/// Mass for the muons
-		Set_Of_Model_Parameters.set_block_entry( "mass", 13, params_m_mu );
+		Model_Parameters.MM = params_m_mu;
 		
-		if( initial_state=="NO" && (Final_state=="2m" || Final_state=="2mu") )
+		if( initial_state==IS_NO && (Final_state_internal==FS_2mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( false, ME_Signal_Spin2_2l );
 		
-		if( initial_state=="NO" && (Final_state=="2mA" || Final_state=="2muA") )
+		if( initial_state==IS_NO && (Final_state_internal==FS_2muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_NO( true, ME_Signal_Spin2_2lpA );
 		
-		if( initial_state=="gg" && (Final_state=="2m" || Final_state=="2mu") )
+		if( initial_state==IS_gg && (Final_state_internal==FS_2mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( false, ME_Signal_gg_Spin2_2l );
 		
-		if( initial_state=="gg" && (Final_state=="2mA" || Final_state=="2muA") )
+		if( initial_state==IS_gg && (Final_state_internal==FS_2muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_gg( true, ME_Signal_gg_Spin2_2lpA );
 		
-		if( initial_state=="qq" && (Final_state=="2m" || Final_state=="2mu") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_2mu) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( false, ME_Signal_qq_Spin2_DownType_2l, ME_Signal_qq_Spin2_UpType_2l );
 		
-		if( initial_state=="qq" && (Final_state=="2mA" || Final_state=="2muA") )
+		if( initial_state==IS_qq && (Final_state_internal==FS_2muA) )
 			return Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar( true, ME_Signal_qq_Spin2_DownType_2lpA, ME_Signal_qq_Spin2_UpType_2lpA );
 	}
 	
@@ -3356,7 +3507,9 @@ int MEKD_MG::Run_MEKD_MG_MEs_Evaluator_Initial_State_NO(bool photon, Generic_MEK
 	}
 	
 	
-	Generic_ME.updateProc( Set_Of_Model_Parameters );
+	Model_Parameters.setDerivedParameters();
+	Model_Parameters.setIndependentCouplings();
+	Generic_ME.updateProc( &Model_Parameters );
 	Generic_ME.setMomenta( p_set );
 	Generic_ME.sigmaKin();
 	buffer = const_cast<double*>( Generic_ME.getMatrixElements() );
@@ -3393,12 +3546,14 @@ int MEKD_MG::Run_MEKD_MG_MEs_Evaluator_Initial_State_gg(bool photon, Generic_MEK
 	p_set[0][3] = p_set[0][0];
 	p_set[1][3] = -p_set[1][0];
 	
-	Generic_ME.updateProc( Set_Of_Model_Parameters );
+	Model_Parameters.setDerivedParameters();
+	Model_Parameters.setIndependentCouplings();
+	Generic_ME.updateProc( &Model_Parameters );
 	Generic_ME.setMomenta( p_set );
 	Generic_ME.sigmaKin();
 	buffer = const_cast<double*>( Generic_ME.getMatrixElements() );
 	
-	if( Use_PDF_w_pT0 ) { Signal_ME = pdfreader( 21, PDFx1, Mass_4l )*pdfreader( 21, PDFx2, Mass_4l )*buffer[0]; }
+	if( Use_PDF_w_pT0 ) { Signal_ME = PDF_values[4]*PDF_values[pdfreader_flavours+4]*buffer[0]; }
 	else Signal_ME = buffer[0];
 	
 	return 0;
@@ -3411,34 +3566,39 @@ int MEKD_MG::Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar(bool photon, Generic_
 {
 	Signal_ME = 0;
 	
+	/// Flavour-specific masses and couplings are swapped into a copy, so the model parameters stay untouched
+	Model_Parameters_qqbar = Model_Parameters;
+	Model_Parameters_qqbar.setDerivedParameters();
+	
 	/// Down quark block. Down type (s-like)
 	if( ContributionCoeff_d != 0 )
 	{
-		Set_Of_Model_Parameters.set_block_entry( "mass", 3, params_m_d );
-// 		Set_Of_Model_Parameters.set_block_entry( "heff", 15, params_rhod01 );
-// 		Set_Of_Model_Parameters.set_block_entry( "heff", 16, params_rhod02 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 15, params_rhod11 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 16, params_rhod12 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 17, params_rhod13 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 18, params_rhod14 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 33, params_rhod21 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 34, params_rhod22 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 35, params_rhod23 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 36, params_rhod24 );
+		Model_Parameters_qqbar.MS = params_m_d;
+// 		Model_Parameters_qqbar.rhos01 = params_rhod01;
+// 		Model_Parameters_qqbar.rhos02 = params_rhod02;
+		Model_Parameters_qqbar.rhos11 = params_rhod11;
+		Model_Parameters_qqbar.rhos12 = params_rhod12;
+		Model_Parameters_qqbar.rhos13 = params_rhod13;
+		Model_Parameters_qqbar.rhos14 = params_rhod14;
+		Model_Parameters_qqbar.rhos21 = params_rhod21;
+		Model_Parameters_qqbar.rhos22 = params_rhod22;
+		Model_Parameters_qqbar.rhos23 = params_rhod23;
+		Model_Parameters_qqbar.rhos24 = params_rhod24;
 		p_set[0][3] = sqrt( p_set[0][0]*p_set[0][0] - params_m_d*params_m_d );
 		p_set[1][3] = -sqrt( p_set[1][0]*p_set[1][0] - params_m_d*params_m_d );
 		
 		
-		Generic_ME_s.updateProc( Set_Of_Model_Parameters );
+		Model_Parameters_qqbar.setIndependentCouplings();
+		Generic_ME_s.updateProc( &Model_Parameters_qqbar );
 		Generic_ME_s.setMomenta( p_set );
 		Generic_ME_s.sigmaKin();
 		buffer = const_cast<double*>( Generic_ME_s.getMatrixElements() );
 		
 		if( Use_PDF_w_pT0 )
 		{
-			ContributionCoeff_d = pdfreader( 1, PDFx1, Mass_4l )*pdfreader( -1, PDFx2, Mass_4l );
+			ContributionCoeff_d = PDF_values[4+1]*PDF_values[pdfreader_flavours+4-1];
 			Signal_ME = ContributionCoeff_d*buffer[0];
-			ContributionCoeff_d = pdfreader( -1, PDFx1, Mass_4l )*pdfreader( 1, PDFx2, Mass_4l );
+			ContributionCoeff_d = PDF_values[4-1]*PDF_values[pdfreader_flavours+4+1];
 			Signal_ME += ContributionCoeff_d*buffer[1];
 		}
 		else Signal_ME = ContributionCoeff_d*(buffer[0]+buffer[1]);
@@ -3449,30 +3609,31 @@ int MEKD_MG::Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar(bool photon, Generic_
 	/// Strange quark block. Down type (s-like)
 	if( ContributionCoeff_s != 0 )
 	{
-		Set_Of_Model_Parameters.set_block_entry( "mass", 3, params_m_s );
-// 		Set_Of_Model_Parameters.set_block_entry( "heff", 15, params_rhos01 );
-// 		Set_Of_Model_Parameters.set_block_entry( "heff", 16, params_rhos02 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 15, params_rhos11 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 16, params_rhos12 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 17, params_rhos13 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 18, params_rhos14 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 33, params_rhos21 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 34, params_rhos22 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 35, params_rhos23 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 36, params_rhos24 );
+		Model_Parameters_qqbar.MS = params_m_s;
+// 		Model_Parameters_qqbar.rhos01 = params_rhos01;
+// 		Model_Parameters_qqbar.rhos02 = params_rhos02;
+		Model_Parameters_qqbar.rhos11 = params_rhos11;
+		Model_Parameters_qqbar.rhos12 = params_rhos12;
+		Model_Parameters_qqbar.rhos13 = params_rhos13;
+		Model_Parameters_qqbar.rhos14 = params_rhos14;
+		Model_Parameters_qqbar.rhos21 = params_rhos21;
+		Model_Parameters_qqbar.rhos22 = params_rhos22;
+		Model_Parameters_qqbar.rhos23 = params_rhos23;
+		Model_Parameters_qqbar.rhos24 = params_rhos24;
 		p_set[0][3] = sqrt( p_set[0][0]*p_set[0][0] - params_m_s*params_m_s );
 		p_set[1][3] = -sqrt( p_set[1][0]*p_set[1][0] - params_m_s*params_m_s );
 		
-		Generic_ME_s.updateProc( Set_Of_Model_Parameters );
+		Model_Parameters_qqbar.setIndependentCouplings();
+		Generic_ME_s.updateProc( &Model_Parameters_qqbar );
 		Generic_ME_s.setMomenta( p_set );
 		Generic_ME_s.sigmaKin();
 		buffer = const_cast<double*>( Generic_ME_s.getMatrixElements() );
 		
 		if( Use_PDF_w_pT0 )
 		{
-			ContributionCoeff_s= pdfreader( 3, PDFx1, Mass_4l )*pdfreader( -3, PDFx2, Mass_4l );
+			ContributionCoeff_s= PDF_values[4+3]*PDF_values[pdfreader_flavours+4-3];
 			Signal_ME += ContributionCoeff_s*buffer[0];
-			ContributionCoeff_s = pdfreader( -3, PDFx1, Mass_4l )*pdfreader( 3, PDFx2, Mass_4l );
+			ContributionCoeff_s = PDF_values[4-3]*PDF_values[pdfreader_flavours+4+3];
 			Signal_ME += ContributionCoeff_s*buffer[1];
 		}
 		else Signal_ME += ContributionCoeff_s*(buffer[0]+buffer[1]);
@@ -3483,31 +3644,32 @@ int MEKD_MG::Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar(bool photon, Generic_
 	/// Up quark block. Up type (c-like)
 	if( ContributionCoeff_u != 0 )
 	{
-		Set_Of_Model_Parameters.set_block_entry( "mass", 4, params_m_u );
-// 		Set_Of_Model_Parameters.set_block_entry( "heff", 11, params_rhou01 );
-// 		Set_Of_Model_Parameters.set_block_entry( "heff", 12, params_rhou02 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 7, params_rhou11 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 8, params_rhou12 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 9, params_rhou13 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 10, params_rhou14 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 25, params_rhou21 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 26, params_rhou22 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 27, params_rhou23 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 28, params_rhou24 );
+		Model_Parameters_qqbar.MC = params_m_u;
+// 		Model_Parameters_qqbar.rhoc01 = params_rhou01;
+// 		Model_Parameters_qqbar.rhoc02 = params_rhou02;
+		Model_Parameters_qqbar.rhoc11 = params_rhou11;
+		Model_Parameters_qqbar.rhoc12 = params_rhou12;
+		Model_Parameters_qqbar.rhoc13 = params_rhou13;
+		Model_Parameters_qqbar.rhoc14 = params_rhou14;
+		Model_Parameters_qqbar.rhoc21 = params_rhou21;
+		Model_Parameters_qqbar.rhoc22 = params_rhou22;
+		Model_Parameters_qqbar.rhoc23 = params_rhou23;
+		Model_Parameters_qqbar.rhoc24 = params_rhou24;
 		p_set[0][3] = sqrt( p_set[0][0]*p_set[0][0] - params_m_u*params_m_u );
 		p_set[1][3] = -sqrt( p_set[1][0]*p_set[1][0] - params_m_u*params_m_u );
 		
 		
-		Generic_ME_c.updateProc( Set_Of_Model_Parameters );
+		Model_Parameters_qqbar.setIndependentCouplings();
+		Generic_ME_c.updateProc( &Model_Parameters_qqbar );
 		Generic_ME_c.setMomenta( p_set );
 		Generic_ME_c.sigmaKin();
 		buffer = const_cast<double*>( Generic_ME_c.getMatrixElements() );
 		
 		if( Use_PDF_w_pT0 )
 		{
-			ContributionCoeff_u = pdfreader( 2, PDFx1, Mass_4l )*pdfreader( -2, PDFx2, Mass_4l );
+			ContributionCoeff_u = PDF_values[4+2]*PDF_values[pdfreader_flavours+4-2];
 			Signal_ME += ContributionCoeff_u*buffer[0];
-			ContributionCoeff_u = pdfreader( -2, PDFx1, Mass_4l )*pdfreader( 2, PDFx2, Mass_4l );
+			ContributionCoeff_u = PDF_values[4-2]*PDF_values[pdfreader_flavours+4+2];
 			Signal_ME += ContributionCoeff_u*buffer[1];
 		}
 		else Signal_ME += ContributionCoeff_u*(buffer[0]+buffer[1]);
@@ -3518,37 +3680,38 @@ int MEKD_MG::Run_MEKD_MG_MEs_Evaluator_Initial_State_qqbar(bool photon, Generic_
 	/// Charm quark block. Up type (c-like)
 	if( ContributionCoeff_c != 0 )
 	{
-		Set_Of_Model_Parameters.set_block_entry( "mass", 4, params_m_c );
-// 		Set_Of_Model_Parameters.set_block_entry( "heff", 11, params_rhoc01 );
-// 		Set_Of_Model_Parameters.set_block_entry( "heff", 12, params_rhoc02 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 7, params_rhoc11 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 8, params_rhoc12 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 9, params_rhoc13 );
-		Set_Of_Model_Parameters.set_block_entry( "vec", 10, params_rhoc14 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 25, params_rhoc21 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 26, params_rhoc22 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 27, params_rhoc23 );
-		Set_Of_Model_Parameters.set_block_entry( "gravity", 28, params_rhoc24 );
+		Model_Parameters_qqbar.MC = params_m_c;
+// 		Model_Parameters_qqbar.rhoc01 = params_rhoc01;
+// 		Model_Parameters_qqbar.rhoc02 = params_rhoc02;
+		Model_Parameters_qqbar.rhoc11 = params_rhoc11;
+		Model_Parameters_qqbar.rhoc12 = params_rhoc12;
+		Model_Parameters_qqbar.rhoc13 = params_rhoc13;
+		Model_Parameters_qqbar.rhoc14 = params_rhoc14;
+		Model_Parameters_qqbar.rhoc21 = params_rhoc21;
+		Model_Parameters_qqbar.rhoc22 = params_rhoc22;
+		Model_Parameters_qqbar.rhoc23 = params_rhoc23;
+		Model_Parameters_qqbar.rhoc24 = params_rhoc24;
 		p_set[0][3] = sqrt( p_set[0][0]*p_set[0][0] - params_m_c*params_m_c );
 		p_set[1][3] = -sqrt( p_set[1][0]*p_set[1][0] - params_m_c*params_m_c );
 		
 		
-		Generic_ME_c.updateProc( Set_Of_Model_Parameters );
+		Model_Parameters_qqbar.setIndependentCouplings();
+		Generic_ME_c.updateProc( &Model_Parameters_qqbar );
 		Generic_ME_c.setMomenta( p_set );
 		Generic_ME_c.sigmaKin();
 		buffer = const_cast<double*>( Generic_ME_c.getMatrixElements() );
 		
 		if( Use_PDF_w_pT0 )
 		{
-			ContributionCoeff_c = pdfreader( 4, PDFx1, Mass_4l )*pdfreader( -4, PDFx2, Mass_4l );
+			ContributionCoeff_c = PDF_values[4+4]*PDF_values[pdfreader_flavours+4-4];
 			Signal_ME += ContributionCoeff_c*buffer[0];
-			ContributionCoeff_c = pdfreader( -4, PDFx1, Mass_4l )*pdfreader( 4, PDFx2, Mass_4l );
+			ContributionCoeff_c = PDF_values[4-4]*PDF_values[pdfreader_flavours+4+4];
 			Signal_ME += ContributionCoeff_c*buffer[1];
 		}
 		else Signal_ME += ContributionCoeff_c*(buffer[0]+buffer[1]);
 	}
 	
-	if( Use_mZ4l_eq_m4l ) Set_Of_Model_Parameters.set_block_entry( "mass", 23, params_m_Z );	//return to real mass. Used in Z -> 4l
+	if( Use_mZ4l_eq_m4l ) Model_Parameters.MZ = params_m_Z;	//return to real mass. Used in Z -> 4l
 	
 	return 0;
 }
@@ -3601,6 +3764,7 @@ int MEKD_MG::Arrange_Internal_pls()
 		
 		pA1_internal = NULL;
 		Final_state = "2m";
+		Final_state_internal = FS_2mu;
 		
 		return 0;
 	}
@@ -3620,6 +3784,7 @@ int MEKD_MG::Arrange_Internal_pls()
 		if( id2 == 22 ) pA1_internal = p2;
 		if( id3 == 22 ) pA1_internal = p3;
 		Final_state = "2mA";
+		Final_state_internal = FS_2muA;
 		
 		return 0;
 	}
@@ -3654,6 +3819,7 @@ int MEKD_MG::Arrange_Internal_pls()
 		
 		pA1_internal = NULL;
 		Final_state = "2e2m";
+		Final_state_internal = FS_2e2mu;
 		
 		return 0;
 	}
@@ -3678,6 +3844,7 @@ int MEKD_MG::Arrange_Internal_pls()
 		
 		pA1_internal = NULL;
 		Final_state = "4mu";
+		Final_state_internal = FS_4mu;
 		
 		return 0;
 	}
@@ -3702,6 +3869,7 @@ int MEKD_MG::Arrange_Internal_pls()
 		
 		pA1_internal = NULL;
 		Final_state = "4e";
+		Final_state_internal = FS_4e;
 		
 		return 0;
 	}
@@ -3739,6 +3907,7 @@ int MEKD_MG::Arrange_Internal_pls()
 		if( id4 == 22 ) pA1_internal = p4;
 		if( id5 == 22 ) pA1_internal = p5;
 		Final_state = "2e2mA";
+		Final_state_internal = FS_2e2muA;
 		
 		return 0;
 	}
@@ -3771,6 +3940,7 @@ int MEKD_MG::Arrange_Internal_pls()
 		if( id4 == 22 ) pA1_internal = p4;
 		if( id5 == 22 ) pA1_internal = p5;
 		Final_state = "4muA";
+		Final_state_internal = FS_4muA;
 		
 		return 0;
 	}
@@ -3803,6 +3973,7 @@ int MEKD_MG::Arrange_Internal_pls()
 		if( id4 == 22 ) pA1_internal = p4;
 		if( id5 == 22 ) pA1_internal = p5;
 		Final_state = "4eA";
+		Final_state_internal = FS_4eA;
 		
 		return 0;
 	}
@@ -3814,6 +3985,7 @@ int MEKD_MG::Arrange_Internal_pls()
 		if( Warning_Mode ) cout << "Warning. Particle ids are not set. Assuming a proper input-particle configuration.\n";
 		if( Warning_Mode ) cout << "Proceeding according to a specified final state (" << Final_state  << ").\n";
 		pl1_internal=p1; pl2_internal=p2; pl3_internal=p3; pl4_internal=p4; pA1_internal=p5;
+		if( Resolve_Final_state()!=0 && Warning_Mode ) cout << "Warning. Unknown final state (" << Final_state << ").\n";
 		
 		return 0;
 	}
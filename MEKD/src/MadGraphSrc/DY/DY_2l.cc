@@ -24,7 +24,7 @@ void DY_2l::initProc(string param_card_name)
   SLHAReader_MEKD slha(param_card_name);
   pars->setIndependentParameters(slha);
   pars->setIndependentCouplings();
-	ntry = 0, sum_hel = 0, ngood = 0;	// Moved here by Convert_source 0.2
+	setHelicityWarmUp(-1);	// sum over all helicities unless a warm-up is requested
   // Set external particle masses for this matrix element
   mME.push_back(pars->MZ);
   mME.push_back(pars->MM);
@@ -39,7 +39,6 @@ void DY_2l::updateProc(SLHAReader_MEKD &slha)
 {
 	pars->setIndependentParameters(slha);
 	pars->setIndependentCouplings();
-	ntry = 0, sum_hel = 0, ngood = 0;	// needed when altering couplings
 	
 	// Set external particle masses for this matrix element
 	// Should correspond to initProc
@@ -48,6 +47,60 @@ void DY_2l::updateProc(SLHAReader_MEKD &slha)
 	mME[2]=(pars->MM);
 }
 
+//--------------------------------------------------------------------------
+// Update process with a precomputed set of parameters.
+
+void DY_2l::updateProc(Parameters_MEKD *parameters)
+{
+	pars = parameters;
+	
+	// Set external particle masses for this matrix element
+	// Should correspond to initProc
+	mME[0]=(pars->MZ);
+	mME[1]=(pars->MM);
+	mME[2]=(pars->MM);
+}
+
+//--------------------------------------------------------------------------
+// Helicity filtering: the first n calls of sigmaKin sum over all helicities
+// and record the non-vanishing ones, later calls only use these.
+
+void DY_2l::setHelicityWarmUp(int n) 
+{
+  nwarmup = n; 
+  ntry = 0, sum_hel = 0, ngood = 0; 
+  jhel = 0; 
+  for(int i = 0; i < ncomb; i++ )
+    goodhel[i] = false; 
+}
+
+bool DY_2l::getGoodHelicities(vector<int> & good) const
+{
+  good.clear(); 
+  if (nwarmup < 0 || ntry < nwarmup)
+    return false; 
+  for(int i = 0; i < ncomb; i++ )
+  {
+    if (goodhel[i])
+      good.push_back(i); 
+  }
+  return true; 
+}
+
+void DY_2l::setGoodHelicities(const vector<int> & good) 
+{
+  setHelicityWarmUp(0); 
+  for(unsigned int i = 0; i < good.size(); i++ )
+  {
+    if (good[i] >= 0 && good[i] < ncomb && !goodhel[good[i]])
+    {
+      goodhel[good[i]] = true; 
+      igood[ngood] = good[i]; 
+      ngood++; 
+    }
+  }
+}
+
 //--------------------------------------------------------------------------
 // Evaluate |M|^2, part independent of incoming flavour.
 
@@ -63,11 +116,7 @@ void DY_2l::sigmaKin()
     jamp2[0][i] = 0.;
 
   // Local variables and constants
-  const int ncomb = 12;
-  static bool goodhel[ncomb] = {ncomb * false};
 //	static int ntry = 0, sum_hel = 0, ngood = 0;	// Moved by Convert_source 0.2
-  static int igood[ncomb];
-  static int jhel;
 //	std::complex<double> * * wfs;	// Changed by Convert_source 0.2
   double t[nprocesses];
   // Helicities for the process
@@ -96,7 +145,7 @@ void DY_2l::sigmaKin()
     // Calculate the matrix element for all helicities
     for(int ihel = 0;ihel < ncomb;ihel++ )
     {
-      if (goodhel[ihel] || ntry < 2)
+      if (goodhel[ihel] || nwarmup < 0 || ntry <= nwarmup)
       {
         calculate_wavefunctions(perm, helicities[ihel]);
         t[0] = matrix_z_mummup_no_hzpxg();
@@ -111,8 +160,8 @@ void DY_2l::sigmaKin()
         if (tsum != 0. && !goodhel[ihel])
         {
           goodhel[ihel] = true;
-          ngood++;
-          igood[ngood] = ihel;
+          igood[ngood] = ihel; 
+          ngood++; 
         }
       }
     }
@@ -33,6 +33,13 @@ class DY_2l
 	
 	// Update process.
 	virtual void updateProc(SLHAReader_MEKD &slha);
+	virtual void updateProc(Parameters_MEKD *parameters);
+
+	// Helicity filtering. A negative number of warm-up calls sums over all helicities always
+	void setHelicityWarmUp(int n);
+	bool getGoodHelicities(vector<int> & good) const;	// false until the warm-up is done
+	void setGoodHelicities(const vector<int> & good);	// skips the warm-up
+	string className() const {return "DY_2l";}
 
     // Calculate flavour-independent parts of cross section.
     virtual void sigmaKin();
@@ -70,6 +77,9 @@ class DY_2l
     static const int namplitudes = 1;
     std::complex<double> amp[namplitudes];
 	int ntry, sum_hel, ngood;	// Moved here by Convert_source 0.2 
+	static const int ncomb = 12;
+	bool goodhel[ncomb];	// helicity filtering state, moved here from sigmaKin
+	int igood[ncomb], jhel, nwarmup;
     double matrix_z_mummup_no_hzpxg();
 
     // Store the matrix element value from sigmaKin
@@ -24,7 +24,7 @@ void DY_2lpA::initProc(string param_card_name)
   SLHAReader_MEKD slha(param_card_name);
   pars->setIndependentParameters(slha);
   pars->setIndependentCouplings();
-	ntry = 0, sum_hel = 0, ngood = 0;	// Moved here by Convert_source 0.2
+	setHelicityWarmUp(-1);	// sum over all helicities unless a warm-up is requested
   // Set external particle masses for this matrix element
   mME.push_back(pars->MZ);
   mME.push_back(pars->MM);
@@ -40,7 +40,6 @@ void DY_2lpA::updateProc(SLHAReader_MEKD &slha)
 {
 	pars->setIndependentParameters(slha);
 	pars->setIndependentCouplings();
-	ntry = 0, sum_hel = 0, ngood = 0;	// needed when altering couplings
 	
 	// Set external particle masses for this matrix element
 	// Should correspond to initProc
@@ -50,6 +49,61 @@ void DY_2lpA::updateProc(SLHAReader_MEKD &slha)
 	mME[3]=(pars->ZERO);
 }
 
+//--------------------------------------------------------------------------
+// Update process with a precomputed set of parameters.
+
+void DY_2lpA::updateProc(Parameters_MEKD *parameters)
+{
+	pars = parameters;
+	
+	// Set external particle masses for this matrix element
+	// Should correspond to initProc
+	mME[0]=(pars->MZ);
+	mME[1]=(pars->MM);
+	mME[2]=(pars->MM);
+	mME[3]=(pars->ZERO);
+}
+
+//--------------------------------------------------------------------------
+// Helicity filtering: the first n calls of sigmaKin sum over all helicities
+// and record the non-vanishing ones, later calls only use these.
+
+void DY_2lpA::setHelicityWarmUp(int n) 
+{
+  nwarmup = n; 
+  ntry = 0, sum_hel = 0, ngood = 0; 
+  jhel = 0; 
+  for(int i = 0; i < ncomb; i++ )
+    goodhel[i] = false; 
+}
+
+bool DY_2lpA::getGoodHelicities(vector<int> & good) const
+{
+  good.clear(); 
+  if (nwarmup < 0 || ntry < nwarmup)
+    return false; 
+  for(int i = 0; i < ncomb; i++ )
+  {
+    if (goodhel[i])
+      good.push_back(i); 
+  }
+  return true; 
+}
+
+void DY_2lpA::setGoodHelicities(const vector<int> & good) 
+{
+  setHelicityWarmUp(0); 
+  for(unsigned int i = 0; i < good.size(); i++ )
+  {
+    if (good[i] >= 0 && good[i] < ncomb && !goodhel[good[i]])
+    {
+      goodhel[good[i]] = true; 
+      igood[ngood] = good[i]; 
+      ngood++; 
+    }
+  }
+}
+
 //--------------------------------------------------------------------------
 // Evaluate |M|^2, part independent of incoming flavour.
 
@@ -65,11 +119,7 @@ void DY_2lpA::sigmaKin()
     jamp2[0][i] = 0.;
 
   // Local variables and constants
-  const int ncomb = 24;
-  static bool goodhel[ncomb] = {ncomb * false};
 //	static int ntry = 0, sum_hel = 0, ngood = 0;	// Moved by Convert_source 0.2
-  static int igood[ncomb];
-  static int jhel;
 //	std::complex<double> * * wfs;	// Changed by Convert_source 0.2
   double t[nprocesses];
   // Helicities for the process
@@ -101,7 +151,7 @@ void DY_2lpA::sigmaKin()
     // Calculate the matrix element for all helicities
     for(int ihel = 0;ihel < ncomb;ihel++ )
     {
-      if (goodhel[ihel] || ntry < 2)
+      if (goodhel[ihel] || nwarmup < 0 || ntry <= nwarmup)
       {
         calculate_wavefunctions(perm, helicities[ihel]);
         t[0] = matrix_z_mummupa_no_hzpxg();
@@ -116,8 +166,8 @@ void DY_2lpA::sigmaKin()
         if (tsum != 0. && !goodhel[ihel])
         {
           goodhel[ihel] = true;
-          ngood++;
-          igood[ngood] = ihel;
+          igood[ngood] = ihel; 
+          ngood++; 
         }
       }
     }
@@ -0,0 +1,208 @@
+//==========================================================================
+// Batches of MEKD_HELAMPS_BATCH_SIZE events or helicity configurations for
+// the HelAmps libraries. Real and imaginary parts are stored lane by lane,
+// so that the vertices, instantiated with MEKD_Batch_Complex instead of
+// complex<double>, evaluate all lanes at once on the CPU vector units.
+// Compiled in only if MEKD_HELAMPS_BATCH is defined.
+//==========================================================================
+
+#ifndef HelAmps_Batch_H
+#define HelAmps_Batch_H
+
+#include <cmath>
+#include <complex>
+
+// Lanes per batch, a power of two; by default as many as fit in one register
+#ifndef MEKD_HELAMPS_BATCH_SIZE
+#if defined(__AVX512F__)
+#define MEKD_HELAMPS_BATCH_SIZE 8
+#elif defined(__AVX__)
+#define MEKD_HELAMPS_BATCH_SIZE 4
+#else
+#define MEKD_HELAMPS_BATCH_SIZE 2
+#endif
+#endif
+
+// Lanes of real numbers, with the arithmetic operators of the compiler's
+// vector extensions
+typedef double MEKD_Batch_Vector __attribute__ ((vector_size (8 *
+    MEKD_HELAMPS_BATCH_SIZE)));
+
+inline MEKD_Batch_Vector MEKD_Batch_Broadcast(double x)
+{
+  MEKD_Batch_Vector v = {};
+  return v + x;
+}
+
+
+class MEKD_Batch_Real
+{
+  public:
+    MEKD_Batch_Vector v;
+
+    MEKD_Batch_Real() {}
+    MEKD_Batch_Real(double x) : v(MEKD_Batch_Broadcast(x)) {}
+    MEKD_Batch_Real(const MEKD_Batch_Vector &x) : v(x) {}
+};
+
+
+class MEKD_Batch_Complex
+{
+  public:
+    typedef MEKD_Batch_Real value_type;
+
+    MEKD_Batch_Vector re;
+    MEKD_Batch_Vector im;
+
+    MEKD_Batch_Complex() {}
+    MEKD_Batch_Complex(double x) : re(MEKD_Batch_Broadcast(x)),
+        im(MEKD_Batch_Broadcast(0.)) {}
+    MEKD_Batch_Complex(const std::complex<double> &z) :
+        re(MEKD_Batch_Broadcast(z.real())), im(MEKD_Batch_Broadcast(z.imag())) {}
+    MEKD_Batch_Complex(const MEKD_Batch_Real &x) : re(x.v),
+        im(MEKD_Batch_Broadcast(0.)) {}
+    MEKD_Batch_Complex(const MEKD_Batch_Vector &x, const MEKD_Batch_Vector &y) :
+        re(x), im(y) {}
+
+    MEKD_Batch_Real real() const {return re;}
+    MEKD_Batch_Real imag() const {return im;}
+
+    // Access to a single event or helicity configuration
+    std::complex<double> lane(int i) const {return std::complex<double> (re[i],
+        im[i]);}
+    void set_lane(int i, const std::complex<double> &z) {re[i] = z.real(); im[i]
+        = z.imag();}
+};
+
+
+// Real lanes
+inline MEKD_Batch_Real operator+(const MEKD_Batch_Real &a) {return a;}
+inline MEKD_Batch_Real operator-(const MEKD_Batch_Real &a) {return -a.v;}
+
+#define MEKD_BATCH_REAL_OPERATOR(OP) \
+inline MEKD_Batch_Real operator OP(const MEKD_Batch_Real &a, const \
+    MEKD_Batch_Real &b) {return a.v OP b.v;} \
+inline MEKD_Batch_Real operator OP(const MEKD_Batch_Real &a, double b) {return \
+    a.v OP b;} \
+inline MEKD_Batch_Real operator OP(double a, const MEKD_Batch_Real &b) {return \
+    a OP b.v;}
+
+MEKD_BATCH_REAL_OPERATOR(+)
+MEKD_BATCH_REAL_OPERATOR(-)
+MEKD_BATCH_REAL_OPERATOR(*)
+MEKD_BATCH_REAL_OPERATOR(/)
+
+#undef MEKD_BATCH_REAL_OPERATOR
+
+inline MEKD_Batch_Real pow(const MEKD_Batch_Real &a, int n)
+{
+  MEKD_Batch_Real r(1.);
+  for (int k = 0; k < n; k++ )
+    r = r * a;
+  return r;
+}
+
+
+// Complex lanes
+inline MEKD_Batch_Complex operator+(const MEKD_Batch_Complex &a) {return a;}
+inline MEKD_Batch_Complex operator-(const MEKD_Batch_Complex &a) {return
+    MEKD_Batch_Complex(-a.re, -a.im);}
+
+// Sums and differences, with batches, real lanes, complex<double> or double
+#define MEKD_BATCH_ADDITIVE_OPERATOR(OP) \
+inline MEKD_Batch_Complex operator OP(const MEKD_Batch_Complex &a, const \
+    MEKD_Batch_Complex &b) {return MEKD_Batch_Complex(a.re OP b.re, a.im OP \
+    b.im);} \
+inline MEKD_Batch_Complex operator OP(const MEKD_Batch_Complex &a, const \
+    MEKD_Batch_Real &b) {return MEKD_Batch_Complex(a.re OP b.v, a.im);} \
+inline MEKD_Batch_Complex operator OP(const MEKD_Batch_Real &a, const \
+    MEKD_Batch_Complex &b) {return MEKD_Batch_Complex(a.v OP b.re, OP b.im);} \
+inline MEKD_Batch_Complex operator OP(const MEKD_Batch_Complex &a, const \
+    std::complex<double> &b) {return MEKD_Batch_Complex(a.re OP b.real(), a.im \
+    OP b.imag());} \
+inline MEKD_Batch_Complex operator OP(const std::complex<double> &a, const \
+    MEKD_Batch_Complex &b) {return MEKD_Batch_Complex(a.real() OP b.re, \
+    a.imag() OP b.im);} \
+inline MEKD_Batch_Complex operator OP(const MEKD_Batch_Real &a, const \
+    std::complex<double> &b) {return MEKD_Batch_Complex(a.v OP b.real(), OP \
+    MEKD_Batch_Broadcast(b.imag()));} \
+inline MEKD_Batch_Complex operator OP(const std::complex<double> &a, const \
+    MEKD_Batch_Real &b) {return MEKD_Batch_Complex(a.real() OP b.v, \
+    MEKD_Batch_Broadcast(a.imag()));} \
+inline MEKD_Batch_Complex operator OP(const MEKD_Batch_Complex &a, double b) \
+    {return MEKD_Batch_Complex(a.re OP b, a.im);} \
+inline MEKD_Batch_Complex operator OP(double a, const MEKD_Batch_Complex &b) \
+    {return MEKD_Batch_Complex(a OP b.re, OP b.im);}
+
+MEKD_BATCH_ADDITIVE_OPERATOR(+)
+MEKD_BATCH_ADDITIVE_OPERATOR(-)
+
+#undef MEKD_BATCH_ADDITIVE_OPERATOR
+
+// Products
+inline MEKD_Batch_Complex operator*(const MEKD_Batch_Complex &a, const
+    MEKD_Batch_Complex &b) {return MEKD_Batch_Complex(a.re * b.re - a.im * b.im,
+    a.re * b.im + a.im * b.re);}
+inline MEKD_Batch_Complex operator*(const MEKD_Batch_Complex &a, const
+    MEKD_Batch_Real &b) {return MEKD_Batch_Complex(a.re * b.v, a.im * b.v);}
+inline MEKD_Batch_Complex operator*(const MEKD_Batch_Real &a, const
+    MEKD_Batch_Complex &b) {return b * a;}
+inline MEKD_Batch_Complex operator*(const MEKD_Batch_Complex &a, const
+    std::complex<double> &b) {return MEKD_Batch_Complex(a.re * b.real() - a.im *
+    b.imag(), a.re * b.imag() + a.im * b.real());}
+inline MEKD_Batch_Complex operator*(const std::complex<double> &a, const
+    MEKD_Batch_Complex &b) {return b * a;}
+inline MEKD_Batch_Complex operator*(const MEKD_Batch_Real &a, const
+    std::complex<double> &b) {return MEKD_Batch_Complex(a.v * b.real(), a.v *
+    b.imag());}
+inline MEKD_Batch_Complex operator*(const std::complex<double> &a, const
+    MEKD_Batch_Real &b) {return b * a;}
+inline MEKD_Batch_Complex operator*(const MEKD_Batch_Complex &a, double b)
+    {return MEKD_Batch_Complex(a.re * b, a.im * b);}
+inline MEKD_Batch_Complex operator*(double a, const MEKD_Batch_Complex &b)
+    {return b * a;}
+
+// Quotients
+inline MEKD_Batch_Complex operator/(const MEKD_Batch_Complex &a, const
+    MEKD_Batch_Complex &b)
+{
+  MEKD_Batch_Vector norm = b.re * b.re + b.im * b.im;
+  return MEKD_Batch_Complex((a.re * b.re + a.im * b.im)/norm, (a.im * b.re -
+      a.re * b.im)/norm);
+}
+inline MEKD_Batch_Complex operator/(const MEKD_Batch_Complex &a, const
+    MEKD_Batch_Real &b) {return MEKD_Batch_Complex(a.re/b.v, a.im/b.v);}
+inline MEKD_Batch_Complex operator/(const MEKD_Batch_Real &a, const
+    MEKD_Batch_Complex &b) {return MEKD_Batch_Complex(a) / b;}
+inline MEKD_Batch_Complex operator/(const MEKD_Batch_Complex &a, const
+    std::complex<double> &b) {return a / MEKD_Batch_Complex(b);}
+inline MEKD_Batch_Complex operator/(const std::complex<double> &a, const
+    MEKD_Batch_Complex &b) {return MEKD_Batch_Complex(a) / b;}
+inline MEKD_Batch_Complex operator/(const MEKD_Batch_Real &a, const
+    std::complex<double> &b) {return MEKD_Batch_Complex(a) /
+    MEKD_Batch_Complex(b);}
+inline MEKD_Batch_Complex operator/(const std::complex<double> &a, const
+    MEKD_Batch_Real &b) {return MEKD_Batch_Complex(a) / b;}
+inline MEKD_Batch_Complex operator/(const MEKD_Batch_Complex &a, double b)
+    {return MEKD_Batch_Complex(a.re/b, a.im/b);}
+inline MEKD_Batch_Complex operator/(double a, const MEKD_Batch_Complex &b)
+    {return MEKD_Batch_Complex(a) / b;}
+
+inline MEKD_Batch_Complex pow(const MEKD_Batch_Complex &a, int n)
+{
+  MEKD_Batch_Complex r(1.);
+  for (int k = 0; k < n; k++ )
+    r = r * a;
+  return r;
+}
+
+
+// Fills the wavefunction of one lane from a single-event wavefunction
+inline void MEKD_Batch_Set_Lane(MEKD_Batch_Complex batch[], const
+    std::complex<double> single[], int size, int lane)
+{
+  for (int k = 0; k < size; k++ )
+    batch[k].set_lane(lane, single[k]);
+}
+
+#endif  // HelAmps_Batch_H
@@ -425,14 +425,72 @@ void txxxxx(double p[4], double tmass, int nhel, int nst, complex<double> tc[18]
 	}
 }
 
-void VVS2_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex)
+#ifdef MEKD_HELAMPS_BATCH
+void ixxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fi[6])
 {
+  complex<double> fi_lane[6]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    ixxxxx(p[lane], fmass, nhel[lane], nsf, fi_lane); 
+    MEKD_Batch_Set_Lane(fi, fi_lane, 6, lane); 
+  }
+}
+
+void oxxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fo[6])
+{
+  complex<double> fo_lane[6]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    oxxxxx(p[lane], fmass, nhel[lane], nsf, fo_lane); 
+    MEKD_Batch_Set_Lane(fo, fo_lane, 6, lane); 
+  }
+}
+
+void vxxxxx(double * p[], double vmass, int nhel[], int nsv, MEKD_Batch_Complex
+    vc[6])
+{
+  complex<double> vc_lane[6]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    vxxxxx(p[lane], vmass, nhel[lane], nsv, vc_lane); 
+    MEKD_Batch_Set_Lane(vc, vc_lane, 6, lane); 
+  }
+}
+
+void txxxxx(double * p[], double tmass, int nhel[], int nst, MEKD_Batch_Complex
+    tc[18])
+{
+  complex<double> tc_lane[18]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    txxxxx(p[lane], tmass, nhel[lane], nst, tc_lane); 
+    MEKD_Batch_Set_Lane(tc, tc_lane, 18, lane); 
+  }
+}
+
+void sxxxxx(double * p[], int nss, MEKD_Batch_Complex sc[3])
+{
+  complex<double> sc_lane[3]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    sxxxxx(p[lane], nss, sc_lane); 
+    MEKD_Batch_Set_Lane(sc, sc_lane, 3, lane); 
+  }
+}
+#endif
+
+template<class C>
+void VVS2_0(C V1[], C V2[], C S3[],
+    complex<double> COUP, C & vertex)
+{
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP4; 
-  complex<double> TMP3; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP4; 
+  C TMP3; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -463,15 +521,17 @@ void VVS2_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
 }
 
 
-void FFV7_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV7_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
+  C TMP2; 
+  C TMP1; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -502,14 +562,16 @@ void FFV7_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFV5_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV5_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  complex<double> TMP1; 
-  double P3[4]; 
-  double OM3; 
+  C denom; 
+  C TMP1; 
+  R P3[4]; 
+  R OM3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -530,15 +592,16 @@ void FFV5_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
   V3[5] = denom * - cI * (F2[5] * F1[3] - F2[4] * F1[2] - P3[3] * OM3 * TMP1); 
 }
 
-void FFV5_7_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV5_7_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
+  C denom; 
 //   double P3[4]; 
 //   double OM3; 
   int i; 
-  complex<double> Vtmp[6]; 
+  C Vtmp[6]; 
   FFV5_3(F1, F2, COUP1, M3, W3, V3); 
   FFV7_3(F1, F2, COUP2, M3, W3, Vtmp); 
   i = 2; 
@@ -549,18 +612,20 @@ void FFV5_7_3(complex<double> F1[], complex<double> F2[], complex<double>
   }
 }
 
-void VVS4_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[])
+template<class C>
+void VVS4_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C S3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP11; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  double P3[4]; 
-  complex<double> TMP6; 
-  complex<double> denom; 
-  complex<double> TMP13; 
+  C TMP11; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP7; 
+  R P3[4]; 
+  C TMP6; 
+  C denom; 
+  C TMP13; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -585,13 +650,15 @@ void VVS4_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVS3_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[])
+template<class C>
+void VVS3_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C S3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P3[4]; 
-  complex<double> TMP6; 
-  complex<double> denom; 
+  R P3[4]; 
+  C TMP6; 
+  C denom; 
   S3[0] = +V1[0] + V2[0]; 
   S3[1] = +V1[1] + V2[1]; 
   P3[0] = -S3[0].real(); 
@@ -604,14 +671,15 @@ void VVS3_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
   S3[2] = denom * cI * TMP6; 
 }
 
-void VVS3_4_5_3(complex<double> V1[], complex<double> V2[], complex<double>
+template<class C>
+void VVS3_4_5_3(C V1[], C V2[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, double M3, double W3,
-    complex<double> S3[])
+    C S3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Stmp[3]; 
+  C Stmp[3]; 
 //   double P3[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   VVS3_3(V1, V2, COUP1, M3, W3, S3); 
   VVS4_3(V1, V2, COUP2, M3, W3, Stmp); 
@@ -630,16 +698,18 @@ void VVS3_4_5_3(complex<double> V1[], complex<double> V2[], complex<double>
   }
 }
 
-void VVS1_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[])
+template<class C>
+void VVS1_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C S3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> denom; 
-  complex<double> TMP4; 
-  complex<double> TMP3; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C denom; 
+  C TMP4; 
+  C TMP3; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -678,22 +748,24 @@ void VVS1_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVS5_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[])
+template<class C>
+void VVS5_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C S3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP11; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  double P3[4]; 
-  complex<double> TMP6; 
-  complex<double> denom; 
-  complex<double> TMP9; 
-  complex<double> TMP13; 
-  complex<double> TMP8; 
+  C TMP12; 
+  C TMP11; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP7; 
+  R P3[4]; 
+  C TMP6; 
+  C denom; 
+  C TMP9; 
+  C TMP13; 
+  C TMP8; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -723,13 +795,15 @@ void VVS5_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void FFS2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[])
+template<class C>
+void FFS2_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C S3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  complex<double> TMP0; 
-  double P3[4]; 
+  C denom; 
+  C TMP0; 
+  R P3[4]; 
   S3[0] = +F1[0] + F2[0]; 
   S3[1] = +F1[1] + F2[1]; 
   P3[0] = -S3[0].real(); 
@@ -743,13 +817,15 @@ void FFS2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFS1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[])
+template<class C>
+void FFS1_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C S3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP5; 
-  double P3[4]; 
-  complex<double> denom; 
+  C TMP5; 
+  R P3[4]; 
+  C denom; 
   S3[0] = +F1[0] + F2[0]; 
   S3[1] = +F1[1] + F2[1]; 
   P3[0] = -S3[0].real(); 
@@ -762,14 +838,15 @@ void FFS1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
   S3[2] = denom * cI * TMP5; 
 }
 
-void FFS1_2_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> S3[])
+template<class C>
+void FFS1_2_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C S3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Stmp[3]; 
+  C Stmp[3]; 
 //   double P3[4]; 
   int i; 
-  complex<double> denom; 
+  C denom; 
   FFS1_3(F1, F2, COUP1, M3, W3, S3); 
   FFS2_3(F1, F2, COUP2, M3, W3, Stmp); 
   i = 2; 
@@ -780,16 +857,18 @@ void FFS1_2_3(complex<double> F1[], complex<double> F2[], complex<double>
   }
 }
 
-void VVS4_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVS4_0(C V1[], C V2[], C S3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP11; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  complex<double> TMP6; 
-  complex<double> TMP13; 
+  C TMP11; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP7; 
+  C TMP6; 
+  C TMP13; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -806,21 +885,23 @@ void VVS4_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
 }
 
 
-void VVS5_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVS5_0(C V1[], C V2[], C S3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP11; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  double P3[4]; 
-  complex<double> TMP6; 
-  complex<double> TMP9; 
-  complex<double> TMP13; 
-  complex<double> TMP8; 
+  C TMP12; 
+  C TMP11; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP7; 
+  R P3[4]; 
+  C TMP6; 
+  C TMP9; 
+  C TMP13; 
+  C TMP8; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -846,21 +927,23 @@ void VVS5_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
 }
 
 
-void VVS3_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVS3_0(C V1[], C V2[], C S3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP6; 
+  C TMP6; 
   TMP6 = (V2[2] * V1[2] - V2[3] * V1[3] - V2[4] * V1[4] - V2[5] * V1[5]); 
   vertex = COUP * - cI * TMP6 * S3[2]; 
 }
 
-void VVS3_4_5_0(complex<double> V1[], complex<double> V2[], complex<double>
+template<class C>
+void VVS3_4_5_0(C V1[], C V2[], C
     S3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3,
-    complex<double> & vertex)
+    C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> tmp; 
+  C tmp; 
   VVS3_0(V1, V2, S3, COUP1, vertex); 
   VVS4_0(V1, V2, S3, COUP2, tmp); 
   vertex = vertex + tmp; 
@@ -869,12 +952,14 @@ void VVS3_4_5_0(complex<double> V1[], complex<double> V2[], complex<double>
 }
 
 
-void FFV2_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV2_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -910,14 +995,16 @@ void FFV2_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void VVS3_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVS3_1(C V2[], C S3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> TMP7; 
-  complex<double> denom; 
-  double OM1; 
+  R P1[4]; 
+  C TMP7; 
+  C denom; 
+  R OM1; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -936,14 +1023,15 @@ void VVS3_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
   V1[5] = denom * S3[2] * (-cI * (V2[5]) + cI * (P1[3] * TMP7 * OM1)); 
 }
 
-void VVS3_4_5_1(complex<double> V2[], complex<double> S3[], complex<double>
+template<class C>
+void VVS3_4_5_1(C V2[], C S3[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, double M1, double W1,
-    complex<double> V1[])
+    C V1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
-  complex<double> denom; 
-  complex<double> Vtmp[6]; 
+  C denom; 
+  C Vtmp[6]; 
 //   double OM1; 
   int i; 
   VVS3_1(V2, S3, COUP1, M1, W1, V1); 
@@ -963,15 +1051,17 @@ void VVS3_4_5_1(complex<double> V2[], complex<double> S3[], complex<double>
   }
 }
 
-void VVS4_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVS4_1(C V2[], C S3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  complex<double> denom; 
-  complex<double> TMP13; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP7; 
+  C denom; 
+  C TMP13; 
   P2[0] = V2[0].real(); 
   P2[1] = V2[1].real(); 
   P2[2] = V2[1].imag(); 
@@ -993,13 +1083,15 @@ void VVS4_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
 }
 
 
-void VVS2_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVS2_1(C V2[], C S3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C denom; 
   P2[0] = V2[0].real(); 
   P2[1] = V2[1].real(); 
   P2[2] = V2[1].imag(); 
@@ -1027,12 +1119,14 @@ void VVS2_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
 }
 
 
-void FFV2_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV2_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -1068,40 +1162,44 @@ void FFV2_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV5_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV5_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP14; 
+  C TMP14; 
   TMP14 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
       F1[3] * (F2[4] * (V3[3] - cI * (V3[4])) + F2[5] * (V3[2] - V3[5])));
   vertex = COUP * - cI * TMP14; 
 }
 
-void FFV5_7_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex)
+template<class C>
+void FFV5_7_0(C F1[], C F2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> tmp; 
+  C tmp; 
   FFV5_0(F1, F2, V3, COUP1, vertex); 
   FFV7_0(F1, F2, V3, COUP2, tmp); 
   vertex = vertex + tmp; 
 }
 
 
-void VVS5_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVS5_1(C V2[], C S3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  double P3[4]; 
-  complex<double> denom; 
-  complex<double> TMP9; 
-  complex<double> TMP13; 
+  C TMP12; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP7; 
+  R P3[4]; 
+  C denom; 
+  C TMP9; 
+  C TMP13; 
   P2[0] = V2[0].real(); 
   P2[1] = V2[1].real(); 
   P2[2] = V2[1].imag(); 
@@ -1134,12 +1232,13 @@ void VVS5_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
 }
 
 
-void FFV7_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV7_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP15; 
-  complex<double> TMP14; 
+  C TMP15; 
+  C TMP14; 
   TMP15 = (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI * (V3[4]))) +
       F1[5] * (F2[2] * (+cI * (V3[4]) - V3[3]) + F2[3] * (V3[2] + V3[5])));
   TMP14 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
@@ -1148,14 +1247,16 @@ void FFV7_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void FFV2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV2_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P3[4]; 
-  complex<double> TMP16; 
-  double OM3; 
+  C denom; 
+  R P3[4]; 
+  C TMP16; 
+  R OM3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -1182,19 +1283,21 @@ void FFV2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void VVV2_0(complex<double> V1[], complex<double> V2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVV2_0(C V1[], C V2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  complex<double> TMP6; 
-  complex<double> TMP5; 
-  complex<double> TMP4; 
-  complex<double> TMP9; 
-  complex<double> TMP3; 
-  complex<double> TMP8; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP7; 
+  C TMP6; 
+  C TMP5; 
+  C TMP4; 
+  C TMP9; 
+  C TMP3; 
+  C TMP8; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -1214,14 +1317,16 @@ void VVV2_0(complex<double> V1[], complex<double> V2[], complex<double> V3[],
       TMP8 * TMP9)));
 }
 
-void FFV3_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV3_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  complex<double> TMP10; 
-  double P3[4]; 
-  double OM3; 
+  C denom; 
+  C TMP10; 
+  R P3[4]; 
+  R OM3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -1249,18 +1354,20 @@ void FFV3_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFV1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV1_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP0; 
-  double P2[4]; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP0; 
+  R P2[4]; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -1293,17 +1400,18 @@ void FFV1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
       (P1[3]) + cI * (P2[3])));
 }
 
-void FFV1_2_3_4_3(complex<double> F1[], complex<double> F2[], complex<double>
+template<class C>
+void FFV1_2_3_4_3(C F1[], C F2[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4,
-    double M3, double W3, complex<double> V3[])
+    double M3, double W3, C V3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
 //   double P2[4]; 
 //   double P3[4]; 
 //   double OM3; 
-  complex<double> denom; 
-  complex<double> Vtmp[6]; 
+  C denom; 
+  C Vtmp[6]; 
   int i; 
   FFV1_3(F1, F2, COUP1, M3, W3, V3); 
   FFV2_3(F1, F2, COUP2, M3, W3, Vtmp); 
@@ -1329,14 +1437,16 @@ void FFV1_2_3_4_3(complex<double> F1[], complex<double> F2[], complex<double>
   }
 }
 
-void VVV1_0(complex<double> V1[], complex<double> V2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVV1_0(C V1[], C V2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP11; 
-  double P1[4]; 
-  double P2[4]; 
+  C TMP12; 
+  C TMP11; 
+  R P1[4]; 
+  R P2[4]; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -1366,30 +1476,33 @@ void VVV1_0(complex<double> V1[], complex<double> V2[], complex<double> V3[],
   vertex = COUP * (-cI * (TMP11) + cI * (TMP12)); 
 }
 
-void VVV1_2_0(complex<double> V1[], complex<double> V2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex)
+template<class C>
+void VVV1_2_0(C V1[], C V2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
 //   double P2[4]; 
-  complex<double> tmp; 
+  C tmp; 
   VVV1_0(V1, V2, V3, COUP1, vertex); 
   VVV2_0(V1, V2, V3, COUP2, tmp); 
   vertex = vertex + tmp; 
 }
 
-void FFV4_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV4_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP15; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP2; 
-  double P2[4]; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
+  C TMP15; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP2; 
+  R P2[4]; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -1423,19 +1536,21 @@ void FFV4_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void VVV2_1(complex<double> V2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVV2_1(C V2[], C V3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  complex<double> TMP5; 
-  double OM1; 
-  complex<double> TMP3; 
-  complex<double> TMP8; 
+  C denom; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP7; 
+  C TMP5; 
+  R OM1; 
+  C TMP3; 
+  C TMP8; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -1471,15 +1586,17 @@ void VVV2_1(complex<double> V2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void VVV1_1(complex<double> V2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVV1_1(C V2[], C V3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> denom; 
-  complex<double> TMP14; 
-  double OM1; 
+  R P1[4]; 
+  R P2[4]; 
+  C denom; 
+  C TMP14; 
+  R OM1; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -1522,14 +1639,15 @@ void VVV1_1(complex<double> V2[], complex<double> V3[], complex<double> COUP,
       OM1 * TMP14)));
 }
 
-void VVV1_2_1(complex<double> V2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> V1[])
+template<class C>
+void VVV1_2_1(C V2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C V1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
 //   double P2[4]; 
-  complex<double> denom; 
-  complex<double> Vtmp[6]; 
+  C denom; 
+  C Vtmp[6]; 
 //   double OM1; 
   int i; 
   VVV1_1(V2, V3, COUP1, M1, W1, V1); 
@@ -1542,23 +1660,25 @@ void VVV1_2_1(complex<double> V2[], complex<double> V3[], complex<double>
   }
 }
 
-void VVT12_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT12_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  complex<double> TMP7; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP26; 
-  complex<double> TMP4; 
-  complex<double> TMP9; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP23; 
+  C TMP7; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
+  C TMP26; 
+  C TMP4; 
+  C TMP9; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -1793,19 +1913,21 @@ void VVT12_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVT9_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT9_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  double P3[4]; 
-  complex<double> TMP26; 
-  complex<double> TMP28; 
-  complex<double> TMP27; 
-  complex<double> TMP24; 
-  complex<double> TMP25; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP23; 
+  R P3[4]; 
+  C TMP26; 
+  C TMP28; 
+  C TMP27; 
+  C TMP24; 
+  C TMP25; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -1845,24 +1967,26 @@ void VVT9_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void VVT12_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT12_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> TMP22; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  complex<double> TMP36; 
-  complex<double> TMP21; 
-  complex<double> TMP4; 
-  complex<double> TMP28; 
-  complex<double> TMP27; 
-  complex<double> TMP24; 
-  complex<double> TMP25; 
-  complex<double> TMP9; 
-  complex<double> TMP35; 
+  R P1[4]; 
+  C TMP22; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP7; 
+  C TMP36; 
+  C TMP21; 
+  C TMP4; 
+  C TMP28; 
+  C TMP27; 
+  C TMP24; 
+  C TMP25; 
+  C TMP9; 
+  C TMP35; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -1921,19 +2045,21 @@ void VVT12_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void VVT3_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT3_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP56; 
-  double P3[4]; 
-  complex<double> TMP55; 
-  complex<double> denom; 
-  double OM3; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP56; 
+  R P3[4]; 
+  C TMP55; 
+  C denom; 
+  R OM3; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -2208,21 +2334,23 @@ void VVT3_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVT5_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT5_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP34; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP2; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> TMP33; 
-  complex<double> TMP26; 
-  complex<double> denom; 
+  C TMP34; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP2; 
+  R P2[4]; 
+  C TMP23; 
+  R P3[4]; 
+  R OM3; 
+  C TMP33; 
+  C TMP26; 
+  C denom; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -2539,12 +2667,13 @@ void VVT5_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVT11_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT11_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP36; 
-  complex<double> TMP35; 
+  C TMP36; 
+  C TMP35; 
   TMP36 = (V1[2] * - 1. * (V2[3] * T3[3] + V2[4] * T3[4] + V2[5] * T3[5] -
       V2[2] * T3[2]) + (V1[3] * (V2[3] * T3[7] + V2[4] * T3[8] + V2[5] * T3[9]
       - V2[2] * T3[6]) + (V1[4] * (V2[3] * T3[11] + V2[4] * T3[12] + V2[5] *
@@ -2559,19 +2688,21 @@ void VVT11_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void FFT4_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void FFT4_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP19; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
+  C TMP19; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -2662,15 +2793,17 @@ void FFT4_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void VVT7_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT7_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> TMP22; 
-  double P2[4]; 
-  complex<double> TMP21; 
-  complex<double> TMP4; 
+  R P1[4]; 
+  C TMP22; 
+  R P2[4]; 
+  C TMP21; 
+  C TMP4; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -2694,16 +2827,18 @@ void VVT7_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void VVT2_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT2_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> TMP22; 
-  double P2[4]; 
-  complex<double> TMP30; 
-  complex<double> TMP21; 
-  complex<double> TMP29; 
+  R P1[4]; 
+  C TMP22; 
+  R P2[4]; 
+  C TMP30; 
+  C TMP21; 
+  C TMP29; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -2745,20 +2880,22 @@ void VVT2_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void FFT3_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void FFT3_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP39; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP40; 
-  complex<double> denom; 
-  complex<double> TMP11; 
-  double OM3; 
+  C TMP2; 
+  C TMP39; 
+  C TMP1; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP40; 
+  C denom; 
+  C TMP11; 
+  R OM3; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -2972,27 +3109,29 @@ void FFT3_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void VVT10_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT10_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP1; 
-  complex<double> TMP10; 
-  double P3[4]; 
-  complex<double> TMP47; 
-  complex<double> TMP9; 
-  complex<double> TMP2; 
-  double P2[4]; 
-  double OM3; 
-  complex<double> TMP49; 
-  double P1[4]; 
-  complex<double> TMP23; 
-  complex<double> TMP7; 
-  complex<double> denom; 
-  complex<double> TMP48; 
-  complex<double> TMP50; 
-  complex<double> TMP26; 
-  complex<double> TMP4; 
+  C TMP1; 
+  C TMP10; 
+  R P3[4]; 
+  C TMP47; 
+  C TMP9; 
+  C TMP2; 
+  R P2[4]; 
+  R OM3; 
+  C TMP49; 
+  R P1[4]; 
+  C TMP23; 
+  C TMP7; 
+  C denom; 
+  C TMP48; 
+  C TMP50; 
+  C TMP26; 
+  C TMP4; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -3647,25 +3786,27 @@ void VVT10_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVT13_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT13_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP22; 
-  complex<double> TMP36; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  double P3[4]; 
-  complex<double> TMP21; 
-  complex<double> TMP26; 
-  complex<double> TMP28; 
-  complex<double> TMP27; 
-  complex<double> TMP24; 
-  complex<double> TMP25; 
-  complex<double> TMP35; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP22; 
+  C TMP36; 
+  R P2[4]; 
+  C TMP23; 
+  R P3[4]; 
+  C TMP21; 
+  C TMP26; 
+  C TMP28; 
+  C TMP27; 
+  C TMP24; 
+  C TMP25; 
+  C TMP35; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -3728,21 +3869,23 @@ void VVT13_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void VVT9_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT9_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  complex<double> TMP7; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP26; 
-  complex<double> TMP9; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP23; 
+  C TMP7; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
+  C TMP26; 
+  C TMP9; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -3883,21 +4026,23 @@ void VVT9_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVT4_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT4_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  complex<double> TMP31; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP26; 
-  complex<double> TMP32; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP23; 
+  C TMP31; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
+  C TMP26; 
+  C TMP32; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -4214,19 +4359,21 @@ void VVT4_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void FFT1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void FFT1_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP0; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
+  C TMP0; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -4316,17 +4463,18 @@ void FFT1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
       0.333333333 * cI * (TMP10)));
 }
 
-void FFT1_2_3_4_3(complex<double> F1[], complex<double> F2[], complex<double>
+template<class C>
+void FFT1_2_3_4_3(C F1[], C F2[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4,
-    double M3, double W3, complex<double> T3[])
+    double M3, double W3, C T3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Ttmp[18]; 
+  C Ttmp[18]; 
 //   double P1[4]; 
 //   double P2[4]; 
 //   double P3[4]; 
 //   double OM3; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   FFT1_3(F1, F2, COUP1, M3, W3, T3); 
   FFT2_3(F1, F2, COUP2, M3, W3, Ttmp); 
@@ -4352,16 +4500,18 @@ void FFT1_2_3_4_3(complex<double> F1[], complex<double> F2[], complex<double>
   }
 }
 
-void VVT11_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT11_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP23; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP26; 
-  complex<double> TMP4; 
+  C TMP23; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
+  C TMP26; 
+  C TMP4; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -4443,23 +4593,25 @@ void VVT11_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVT13_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT13_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  complex<double> TMP7; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP26; 
-  complex<double> TMP4; 
-  complex<double> TMP9; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP23; 
+  C TMP7; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
+  C TMP26; 
+  C TMP4; 
+  C TMP9; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -4602,17 +4754,19 @@ void VVT13_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVT3_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT3_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP54; 
-  complex<double> TMP53; 
-  complex<double> TMP52; 
-  complex<double> TMP51; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP54; 
+  C TMP53; 
+  C TMP52; 
+  C TMP51; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -4761,19 +4915,21 @@ void VVT3_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void VVT7_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT7_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> denom; 
-  double OM3; 
-  complex<double> TMP4; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  R P3[4]; 
+  C denom; 
+  R OM3; 
+  C TMP4; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -4864,29 +5020,31 @@ void VVT7_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVT10_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT10_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP1; 
-  complex<double> TMP10; 
-  double P3[4]; 
-  complex<double> TMP21; 
-  complex<double> TMP43; 
-  complex<double> TMP9; 
-  complex<double> TMP2; 
-  double P2[4]; 
-  complex<double> TMP46; 
-  complex<double> TMP45; 
-  complex<double> TMP42; 
-  double P1[4]; 
-  complex<double> TMP23; 
-  complex<double> TMP7; 
-  complex<double> TMP41; 
-  complex<double> TMP22; 
-  complex<double> TMP44; 
-  complex<double> TMP26; 
-  complex<double> TMP4; 
+  C TMP1; 
+  C TMP10; 
+  R P3[4]; 
+  C TMP21; 
+  C TMP43; 
+  C TMP9; 
+  C TMP2; 
+  R P2[4]; 
+  C TMP46; 
+  C TMP45; 
+  C TMP42; 
+  R P1[4]; 
+  C TMP23; 
+  C TMP7; 
+  C TMP41; 
+  C TMP22; 
+  C TMP44; 
+  C TMP26; 
+  C TMP4; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -4956,15 +5114,16 @@ void VVT10_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
       cI * (TMP2 * TMP4)))));
 }
 
-void VVT10_11_12_13_2_3_6_7_8_9_0(complex<double> V1[], complex<double> V2[],
-    complex<double> T3[], complex<double> COUP1, complex<double> COUP2,
+template<class C>
+void VVT10_11_12_13_2_3_6_7_8_9_0(C V1[], C V2[],
+    C T3[], complex<double> COUP1, complex<double> COUP2,
     complex<double> COUP3, complex<double> COUP4, complex<double> COUP5,
     complex<double> COUP6, complex<double> COUP7, complex<double> COUP8,
-    complex<double> COUP9, complex<double> COUP10, complex<double> & vertex)
+    complex<double> COUP9, complex<double> COUP10, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P3[4]; 
-  complex<double> tmp; 
+  C tmp; 
 //   double P2[4]; 
 //   double P1[4]; 
   VVT10_0(V1, V2, T3, COUP1, vertex); 
@@ -4988,21 +5147,23 @@ void VVT10_11_12_13_2_3_6_7_8_9_0(complex<double> V1[], complex<double> V2[],
   vertex = vertex + tmp; 
 }
 
-void VVT8_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT8_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  double P3[4]; 
-  complex<double> denom; 
-  double OM3; 
-  complex<double> TMP4; 
-  complex<double> TMP9; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP7; 
+  R P3[4]; 
+  C denom; 
+  R OM3; 
+  C TMP4; 
+  C TMP9; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -5159,18 +5320,20 @@ void VVT8_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVT8_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT8_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> TMP22; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  complex<double> TMP21; 
-  complex<double> TMP4; 
-  complex<double> TMP9; 
+  R P1[4]; 
+  C TMP22; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP7; 
+  C TMP21; 
+  C TMP4; 
+  C TMP9; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -5198,20 +5361,22 @@ void VVT8_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void VVT1_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT1_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP30; 
-  complex<double> denom; 
-  double OM3; 
-  complex<double> TMP29; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP30; 
+  C denom; 
+  R OM3; 
+  C TMP29; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -5366,19 +5531,20 @@ void VVT1_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
       (TMP30)))));
 }
 
-void VVT1_10_11_12_13_3_5_7_8_9_3(complex<double> V1[], complex<double> V2[],
+template<class C>
+void VVT1_10_11_12_13_3_5_7_8_9_3(C V1[], C V2[],
     complex<double> COUP1, complex<double> COUP2, complex<double> COUP3,
     complex<double> COUP4, complex<double> COUP5, complex<double> COUP6,
     complex<double> COUP7, complex<double> COUP8, complex<double> COUP9,
-    complex<double> COUP10, double M3, double W3, complex<double> T3[])
+    complex<double> COUP10, double M3, double W3, C T3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P3[4]; 
 //   double P2[4]; 
 //   double OM3; 
 //   double P1[4]; 
-  complex<double> Ttmp[18]; 
-  complex<double> denom; 
+  C Ttmp[18]; 
+  C denom; 
   int i; 
   VVT1_3(V1, V2, COUP1, M3, W3, T3); 
   VVT10_3(V1, V2, COUP2, M3, W3, Ttmp); 
@@ -5447,25 +5613,27 @@ void VVT1_10_11_12_13_3_5_7_8_9_3(complex<double> V1[], complex<double> V2[],
 }
 
 
-void VVT13_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT13_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP22; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  double P3[4]; 
-  complex<double> TMP21; 
-  complex<double> denom; 
-  double OM1; 
-  complex<double> TMP28; 
-  complex<double> TMP27; 
-  complex<double> TMP65; 
-  complex<double> TMP68; 
-  complex<double> TMP69; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP22; 
+  R P2[4]; 
+  C TMP23; 
+  R P3[4]; 
+  C TMP21; 
+  C denom; 
+  R OM1; 
+  C TMP28; 
+  C TMP27; 
+  C TMP65; 
+  C TMP68; 
+  C TMP69; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -5558,23 +5726,25 @@ void VVT13_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT6_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT6_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP59; 
-  complex<double> TMP61; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP57; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  double P3[4]; 
-  complex<double> TMP66; 
-  complex<double> denom; 
-  complex<double> TMP67; 
-  double OM1; 
-  complex<double> TMP63; 
+  C TMP59; 
+  C TMP61; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP57; 
+  R P2[4]; 
+  C TMP23; 
+  R P3[4]; 
+  C TMP66; 
+  C denom; 
+  C TMP67; 
+  R OM1; 
+  C TMP63; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -5892,23 +6062,25 @@ void VVT6_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT12_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT12_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> TMP22; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  complex<double> TMP21; 
-  complex<double> denom; 
-  double OM1; 
-  complex<double> TMP28; 
-  complex<double> TMP27; 
-  complex<double> TMP65; 
-  complex<double> TMP68; 
-  complex<double> TMP69; 
+  R P1[4]; 
+  C TMP22; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP7; 
+  C TMP21; 
+  C denom; 
+  R OM1; 
+  C TMP28; 
+  C TMP27; 
+  C TMP65; 
+  C TMP68; 
+  C TMP69; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -5996,15 +6168,17 @@ void VVT12_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT11_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT11_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
-  double OM1; 
-  complex<double> TMP68; 
-  complex<double> TMP69; 
+  R P1[4]; 
+  C denom; 
+  R OM1; 
+  C TMP68; 
+  C TMP69; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -6040,19 +6214,21 @@ void VVT11_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
       (V2[5] * T3[17])))));
 }
 
-void VVT3_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT3_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP71; 
-  complex<double> denom; 
-  complex<double> TMP70; 
-  complex<double> TMP73; 
-  complex<double> TMP72; 
-  double OM1; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP71; 
+  C denom; 
+  C TMP70; 
+  C TMP73; 
+  C TMP72; 
+  R OM1; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -6310,27 +6486,29 @@ void VVT3_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT10_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT10_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP1; 
-  complex<double> TMP10; 
-  double P3[4]; 
-  complex<double> TMP21; 
-  complex<double> TMP2; 
-  double P2[4]; 
-  complex<double> TMP46; 
-  complex<double> TMP45; 
-  complex<double> TMP42; 
-  double P1[4]; 
-  complex<double> TMP23; 
-  complex<double> TMP7; 
-  complex<double> denom; 
-  complex<double> TMP41; 
-  complex<double> TMP22; 
-  double OM1; 
-  complex<double> TMP74; 
+  C TMP1; 
+  C TMP10; 
+  R P3[4]; 
+  C TMP21; 
+  C TMP2; 
+  R P2[4]; 
+  C TMP46; 
+  C TMP45; 
+  C TMP42; 
+  R P1[4]; 
+  C TMP23; 
+  C TMP7; 
+  C denom; 
+  C TMP41; 
+  C TMP22; 
+  R OM1; 
+  C TMP74; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -6436,18 +6614,19 @@ void VVT10_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
       TMP41)) + 2. * (V2[5] * (+cI * (TMP2 * TMP41 + TMP1 * TMP42))))));
 }
 
-void VVT10_11_12_13_2_3_6_7_8_9_1(complex<double> V2[], complex<double> T3[],
+template<class C>
+void VVT10_11_12_13_2_3_6_7_8_9_1(C V2[], C T3[],
     complex<double> COUP1, complex<double> COUP2, complex<double> COUP3,
     complex<double> COUP4, complex<double> COUP5, complex<double> COUP6,
     complex<double> COUP7, complex<double> COUP8, complex<double> COUP9,
-    complex<double> COUP10, double M1, double W1, complex<double> V1[])
+    complex<double> COUP10, double M1, double W1, C V1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P3[4]; 
-  complex<double> Vtmp[6]; 
+  C Vtmp[6]; 
 //   double P2[4]; 
 //   double P1[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
 //   double OM1; 
   VVT10_1(V2, T3, COUP1, M1, W1, V1); 
@@ -6517,21 +6696,23 @@ void VVT10_11_12_13_2_3_6_7_8_9_1(complex<double> V2[], complex<double> T3[],
 }
 
 
-void VVT9_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT9_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP1; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  double P3[4]; 
-  complex<double> TMP21; 
-  complex<double> denom; 
-  complex<double> TMP28; 
-  complex<double> TMP27; 
-  complex<double> TMP65; 
-  double OM1; 
+  C TMP1; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP23; 
+  R P3[4]; 
+  C TMP21; 
+  C denom; 
+  C TMP28; 
+  C TMP27; 
+  C TMP65; 
+  R OM1; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -6592,15 +6773,17 @@ void VVT9_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT2_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT2_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> TMP22; 
-  double P2[4]; 
-  complex<double> TMP21; 
-  complex<double> denom; 
+  R P1[4]; 
+  C TMP22; 
+  R P2[4]; 
+  C TMP21; 
+  C denom; 
   P2[0] = V2[0].real(); 
   P2[1] = V2[1].real(); 
   P2[2] = V2[1].imag(); 
@@ -6646,17 +6829,19 @@ void VVT2_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT7_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT7_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> TMP22; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  complex<double> TMP21; 
-  complex<double> denom; 
-  double OM1; 
+  R P1[4]; 
+  C TMP22; 
+  R P2[4]; 
+  C TMP7; 
+  C TMP21; 
+  C denom; 
+  R OM1; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -6694,20 +6879,22 @@ void VVT7_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void FFT2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void FFT2_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP37; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP20; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP1; 
-  complex<double> TMP38; 
+  C TMP2; 
+  C TMP37; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP20; 
+  R OM3; 
+  C denom; 
+  C TMP1; 
+  C TMP38; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -6920,23 +7107,25 @@ void FFT2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void VVT6_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT6_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP59; 
-  complex<double> TMP58; 
-  double P1[4]; 
-  complex<double> TMP57; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  double P3[4]; 
-  complex<double> TMP63; 
-  complex<double> TMP60; 
-  complex<double> TMP26; 
-  complex<double> TMP61; 
-  complex<double> TMP64; 
-  complex<double> TMP62; 
+  C TMP59; 
+  C TMP58; 
+  R P1[4]; 
+  C TMP57; 
+  R P2[4]; 
+  C TMP23; 
+  R P3[4]; 
+  C TMP63; 
+  C TMP60; 
+  C TMP26; 
+  C TMP61; 
+  C TMP64; 
+  C TMP62; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -7220,17 +7409,19 @@ void VVT6_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void VVT8_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT8_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> TMP22; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  complex<double> TMP21; 
-  complex<double> denom; 
+  R P1[4]; 
+  C TMP22; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP7; 
+  C TMP21; 
+  C denom; 
   P2[0] = V2[0].real(); 
   P2[1] = V2[1].real(); 
   P2[2] = V2[1].imag(); 
@@ -7265,6 +7456,91 @@ void VVT8_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
       (+cI * (TMP21 + TMP22)));
 }
 
+// Explicit instantiations of the vertices for single events and, if
+// MEKD_HELAMPS_BATCH is defined, for batches of events or helicities
+#define HELAMPS_HEF_MEKD_VERTICES(C) \
+template void VVS2_0(C V1[], C V2[], C S3[], complex<double> COUP, C & vertex); \
+template void FFV7_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV5_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV5_7_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, double M3, double W3, C V3[]); \
+template void VVS4_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C S3[]); \
+template void VVS3_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C S3[]); \
+template void VVS3_4_5_3(C V1[], C V2[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, double M3, double W3, C S3[]); \
+template void VVS1_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C S3[]); \
+template void VVS5_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C S3[]); \
+template void FFS2_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C S3[]); \
+template void FFS1_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C S3[]); \
+template void FFS1_2_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, double M3, double W3, C S3[]); \
+template void VVS4_0(C V1[], C V2[], C S3[], complex<double> COUP, C & vertex); \
+template void VVS5_0(C V1[], C V2[], C S3[], complex<double> COUP, C & vertex); \
+template void VVS3_0(C V1[], C V2[], C S3[], complex<double> COUP, C & vertex); \
+template void VVS3_4_5_0(C V1[], C V2[], C S3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, C & vertex); \
+template void FFV2_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void VVS3_1(C V2[], C S3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVS3_4_5_1(C V2[], C S3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, double M1, double W1, C V1[]); \
+template void VVS4_1(C V2[], C S3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVS2_1(C V2[], C S3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void FFV2_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV5_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV5_7_0(C F1[], C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, C & vertex); \
+template void VVS5_1(C V2[], C S3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void FFV7_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV2_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void VVV2_0(C V1[], C V2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV3_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV1_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV1_2_3_4_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, double M3, double W3, C V3[]); \
+template void VVV1_0(C V1[], C V2[], C V3[], complex<double> COUP, C & vertex); \
+template void VVV1_2_0(C V1[], C V2[], C V3[], complex<double> COUP1, complex<double> COUP2, C & vertex); \
+template void FFV4_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void VVV2_1(C V2[], C V3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVV1_1(C V2[], C V3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVV1_2_1(C V2[], C V3[], complex<double> COUP1, complex<double> COUP2, double M1, double W1, C V1[]); \
+template void VVT12_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT9_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT12_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT3_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT5_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT11_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void FFT4_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT7_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT2_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void FFT3_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT10_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT13_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT9_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT4_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void FFT1_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void FFT1_2_3_4_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, double M3, double W3, C T3[]); \
+template void VVT11_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT13_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT3_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT7_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT10_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT10_11_12_13_2_3_6_7_8_9_0(C V1[], C V2[], C T3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, complex<double> COUP5, complex<double> COUP6, complex<double> COUP7, complex<double> COUP8, complex<double> COUP9, complex<double> COUP10, C & vertex); \
+template void VVT8_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT8_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT1_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT1_10_11_12_13_3_5_7_8_9_3(C V1[], C V2[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, complex<double> COUP5, complex<double> COUP6, complex<double> COUP7, complex<double> COUP8, complex<double> COUP9, complex<double> COUP10, double M3, double W3, C T3[]); \
+template void VVT13_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVT6_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVT12_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVT11_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVT3_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVT10_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVT10_11_12_13_2_3_6_7_8_9_1(C V2[], C T3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, complex<double> COUP5, complex<double> COUP6, complex<double> COUP7, complex<double> COUP8, complex<double> COUP9, complex<double> COUP10, double M1, double W1, C V1[]); \
+template void VVT9_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVT2_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVT7_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void FFT2_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT6_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT8_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]);
+
+HELAMPS_HEF_MEKD_VERTICES(complex<double>)
+#ifdef MEKD_HELAMPS_BATCH
+HELAMPS_HEF_MEKD_VERTICES(MEKD_Batch_Complex)
+#endif
+#undef HELAMPS_HEF_MEKD_VERTICES
 
 }  // end namespace $(namespace)s_HEF_MEK
 
@@ -11,6 +11,10 @@
 #include <cmath> 
 #include <complex> 
 
+#ifdef MEKD_HELAMPS_BATCH
+#include "HelAmps_Batch.h"
+#endif
+
 using namespace std; 
 
 namespace MG5_HEF_MEKD
@@ -31,239 +35,332 @@ void sxxxxx(double p[4], int nss, std::complex<double> sc[3]);
 void ixxxxx(double p[4], double fmass, int nhel, int nsf, std::complex<double>
     fi[6]);
 
-void VVS2_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex);
+#ifdef MEKD_HELAMPS_BATCH
+// External wavefunctions for a batch, with one momentum and helicity per lane
+void ixxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fi[6]);
 
-void FFV7_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
+void oxxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fo[6]);
 
-void FFV5_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
-void FFV5_7_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[]);
+void vxxxxx(double * p[], double vmass, int nhel[], int nsv, MEKD_Batch_Complex
+    vc[6]);
 
-void VVS4_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[]);
+void txxxxx(double * p[], double tmass, int nhel[], int nst, MEKD_Batch_Complex
+    tc[18]);
 
-void VVS3_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[]);
-void VVS3_4_5_3(complex<double> V1[], complex<double> V2[], complex<double>
+void sxxxxx(double * p[], int nss, MEKD_Batch_Complex sc[3]);
+#endif
+
+template<class C>
+void VVS2_0(C V1[], C V2[], C S3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void FFV7_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
+
+template<class C>
+void FFV5_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
+template<class C>
+void FFV5_7_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[]);
+
+template<class C>
+void VVS4_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C S3[]);
+
+template<class C>
+void VVS3_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C S3[]);
+template<class C>
+void VVS3_4_5_3(C V1[], C V2[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, double M3, double W3,
-    complex<double> S3[]);
-
-void VVS1_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[]);
-
-void VVS5_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[]);
-
-void FFS2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[]);
-
-void FFS1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[]);
-void FFS1_2_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> S3[]);
-
-void VVS4_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void VVS5_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void VVS3_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex);
-void VVS3_4_5_0(complex<double> V1[], complex<double> V2[], complex<double>
+    C S3[]);
+
+template<class C>
+void VVS1_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C S3[]);
+
+template<class C>
+void VVS5_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C S3[]);
+
+template<class C>
+void FFS2_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C S3[]);
+
+template<class C>
+void FFS1_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C S3[]);
+template<class C>
+void FFS1_2_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C S3[]);
+
+template<class C>
+void VVS4_0(C V1[], C V2[], C S3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void VVS5_0(C V1[], C V2[], C S3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void VVS3_0(C V1[], C V2[], C S3[],
+    complex<double> COUP, C & vertex);
+template<class C>
+void VVS3_4_5_0(C V1[], C V2[], C
     S3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3,
-    complex<double> & vertex);
+    C & vertex);
 
-void FFV2_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[]);
+template<class C>
+void FFV2_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[]);
 
-void VVS3_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
-void VVS3_4_5_1(complex<double> V2[], complex<double> S3[], complex<double>
+template<class C>
+void VVS3_1(C V2[], C S3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
+template<class C>
+void VVS3_4_5_1(C V2[], C S3[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, double M1, double W1,
-    complex<double> V1[]);
+    C V1[]);
 
-void VVS4_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
+template<class C>
+void VVS4_1(C V2[], C S3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
 
-void VVS2_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
+template<class C>
+void VVS2_1(C V2[], C S3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
 
-void FFV2_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[]);
+template<class C>
+void FFV2_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[]);
 
-void FFV5_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
-void FFV5_7_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex);
+template<class C>
+void FFV5_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex);
+template<class C>
+void FFV5_7_0(C F1[], C F2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex);
 
-void VVS5_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
+template<class C>
+void VVS5_1(C V2[], C S3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
 
-void FFV7_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
+template<class C>
+void FFV7_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex);
 
-void FFV2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
+template<class C>
+void FFV2_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
 
-void VVV2_0(complex<double> V1[], complex<double> V2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
+template<class C>
+void VVV2_0(C V1[], C V2[], C V3[],
+    complex<double> COUP, C & vertex);
 
-void FFV3_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
+template<class C>
+void FFV3_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
 
-void FFV1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
+template<class C>
+void FFV1_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
 
-void FFV1_2_3_4_3(complex<double> F1[], complex<double> F2[], complex<double>
+template<class C>
+void FFV1_2_3_4_3(C F1[], C F2[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4,
-    double M3, double W3, complex<double> V3[]);
-
-void VVV1_0(complex<double> V1[], complex<double> V2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
-void VVV1_2_0(complex<double> V1[], complex<double> V2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex);
-
-void FFV4_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
-
-void VVV2_1(complex<double> V2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
-
-void VVV1_1(complex<double> V2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
-
-void VVV1_2_1(complex<double> V2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> V1[]);
-
-void VVT12_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
-
-void VVT9_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void VVT12_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void VVT3_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
-
-void VVT5_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
-
-void VVT11_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void FFT4_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
-
-void VVT7_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void VVT2_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void FFT3_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
-
-void VVT10_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
-
-void VVT13_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void VVT9_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
-
-void VVT4_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
-
-void FFT1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
-void FFT1_2_3_4_3(complex<double> F1[], complex<double> F2[], complex<double>
+    double M3, double W3, C V3[]);
+
+template<class C>
+void VVV1_0(C V1[], C V2[], C V3[],
+    complex<double> COUP, C & vertex);
+template<class C>
+void VVV1_2_0(C V1[], C V2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex);
+
+template<class C>
+void FFV4_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
+
+template<class C>
+void VVV2_1(C V2[], C V3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
+
+template<class C>
+void VVV1_1(C V2[], C V3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
+
+template<class C>
+void VVV1_2_1(C V2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C V1[]);
+
+template<class C>
+void VVT12_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
+
+template<class C>
+void VVT9_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void VVT12_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void VVT3_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
+
+template<class C>
+void VVT5_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
+
+template<class C>
+void VVT11_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void FFT4_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
+
+template<class C>
+void VVT7_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void VVT2_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void FFT3_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
+
+template<class C>
+void VVT10_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
+
+template<class C>
+void VVT13_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void VVT9_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
+
+template<class C>
+void VVT4_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
+
+template<class C>
+void FFT1_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
+template<class C>
+void FFT1_2_3_4_3(C F1[], C F2[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4,
-    double M3, double W3, complex<double> T3[]);
+    double M3, double W3, C T3[]);
 
-void VVT11_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
+template<class C>
+void VVT11_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
 
-void VVT13_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
+template<class C>
+void VVT13_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
 
-void VVT3_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex);
+template<class C>
+void VVT3_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex);
 
-void VVT7_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
+template<class C>
+void VVT7_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
 
-void VVT10_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex);
+template<class C>
+void VVT10_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex);
 
-void VVT10_11_12_13_2_3_6_7_8_9_0(complex<double> V1[], complex<double> V2[],
-    complex<double> T3[], complex<double> COUP1, complex<double> COUP2,
+template<class C>
+void VVT10_11_12_13_2_3_6_7_8_9_0(C V1[], C V2[],
+    C T3[], complex<double> COUP1, complex<double> COUP2,
     complex<double> COUP3, complex<double> COUP4, complex<double> COUP5,
     complex<double> COUP6, complex<double> COUP7, complex<double> COUP8,
-    complex<double> COUP9, complex<double> COUP10, complex<double> & vertex);
+    complex<double> COUP9, complex<double> COUP10, C & vertex);
 
-void VVT8_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
+template<class C>
+void VVT8_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
 
-void FFT2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
+template<class C>
+void FFT2_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
 
-void VVT6_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex);
+template<class C>
+void VVT6_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex);
 
-void VVT8_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex);
+template<class C>
+void VVT8_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex);
 
-void VVT1_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[]);
+template<class C>
+void VVT1_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[]);
 
-void VVT1_10_11_12_13_3_5_7_8_9_3(complex<double> V1[], complex<double> V2[],
+template<class C>
+void VVT1_10_11_12_13_3_5_7_8_9_3(C V1[], C V2[],
     complex<double> COUP1, complex<double> COUP2, complex<double> COUP3,
     complex<double> COUP4, complex<double> COUP5, complex<double> COUP6,
     complex<double> COUP7, complex<double> COUP8, complex<double> COUP9,
-    complex<double> COUP10, double M3, double W3, complex<double> T3[]);
+    complex<double> COUP10, double M3, double W3, C T3[]);
 
-void VVT13_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
+template<class C>
+void VVT13_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
 
-void VVT6_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
+template<class C>
+void VVT6_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
 
-void VVT12_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
+template<class C>
+void VVT12_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
 
-void VVT11_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
+template<class C>
+void VVT11_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
 
-void VVT3_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
+template<class C>
+void VVT3_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
 
-void VVT10_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
+template<class C>
+void VVT10_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
 
-void VVT10_11_12_13_2_3_6_7_8_9_1(complex<double> V2[], complex<double> T3[],
+template<class C>
+void VVT10_11_12_13_2_3_6_7_8_9_1(C V2[], C T3[],
     complex<double> COUP1, complex<double> COUP2, complex<double> COUP3,
     complex<double> COUP4, complex<double> COUP5, complex<double> COUP6,
     complex<double> COUP7, complex<double> COUP8, complex<double> COUP9,
-    complex<double> COUP10, double M1, double W1, complex<double> V1[]);
+    complex<double> COUP10, double M1, double W1, C V1[]);
 
-void VVT9_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
+template<class C>
+void VVT9_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
 
-void VVT2_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
+template<class C>
+void VVT2_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
 
-void VVT7_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
+template<class C>
+void VVT7_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
 
-void VVT8_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[]);
+template<class C>
+void VVT8_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[]);
 
 }  // end namespace MG5_HEF_MEKD
 
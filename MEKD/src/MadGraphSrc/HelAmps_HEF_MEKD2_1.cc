@@ -437,12 +437,70 @@ void vxxxxx(double p[4], double vmass, int nhel, int nsv, complex<double> vc[6])
   return; 
 }
 
-void FFV7_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+#ifdef MEKD_HELAMPS_BATCH
+void ixxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fi[6])
 {
+  complex<double> fi_lane[6]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    ixxxxx(p[lane], fmass, nhel[lane], nsf, fi_lane); 
+    MEKD_Batch_Set_Lane(fi, fi_lane, 6, lane); 
+  }
+}
+
+void oxxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fo[6])
+{
+  complex<double> fo_lane[6]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    oxxxxx(p[lane], fmass, nhel[lane], nsf, fo_lane); 
+    MEKD_Batch_Set_Lane(fo, fo_lane, 6, lane); 
+  }
+}
+
+void vxxxxx(double * p[], double vmass, int nhel[], int nsv, MEKD_Batch_Complex
+    vc[6])
+{
+  complex<double> vc_lane[6]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    vxxxxx(p[lane], vmass, nhel[lane], nsv, vc_lane); 
+    MEKD_Batch_Set_Lane(vc, vc_lane, 6, lane); 
+  }
+}
+
+void txxxxx(double * p[], double tmass, int nhel[], int nst, MEKD_Batch_Complex
+    tc[18])
+{
+  complex<double> tc_lane[18]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    txxxxx(p[lane], tmass, nhel[lane], nst, tc_lane); 
+    MEKD_Batch_Set_Lane(tc, tc_lane, 18, lane); 
+  }
+}
+
+void sxxxxx(double * p[], int nss, MEKD_Batch_Complex sc[3])
+{
+  complex<double> sc_lane[3]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    sxxxxx(p[lane], nss, sc_lane); 
+    MEKD_Batch_Set_Lane(sc, sc_lane, 3, lane); 
+  }
+}
+#endif
+
+template<class C>
+void FFV7_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
+{
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -478,12 +536,14 @@ void FFV7_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV2_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV2_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -519,24 +579,26 @@ void FFV2_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void VVT12_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT12_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP11; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP19; 
-  complex<double> TMP31; 
-  complex<double> TMP16; 
-  complex<double> TMP15; 
-  complex<double> TMP32; 
-  complex<double> TMP18; 
-  complex<double> TMP9; 
-  complex<double> TMP13; 
-  complex<double> TMP8; 
+  C TMP12; 
+  C TMP11; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP19; 
+  C TMP31; 
+  C TMP16; 
+  C TMP15; 
+  C TMP32; 
+  C TMP18; 
+  C TMP9; 
+  C TMP13; 
+  C TMP8; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -595,14 +657,16 @@ void VVT12_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void FFV5_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV5_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P3[4]; 
-  complex<double> TMP20; 
-  double OM3; 
+  C denom; 
+  R P3[4]; 
+  C TMP20; 
+  R OM3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -624,15 +688,16 @@ void FFV5_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
   V3[5] = denom * - cI * (F2[5] * F1[3] - F2[4] * F1[2] - P3[3] * OM3 * TMP20); 
 }
 
-void FFV5_7_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV5_7_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
+  C denom; 
 //   double P3[4]; 
 //   double OM3; 
   int i; 
-  complex<double> Vtmp[6]; 
+  C Vtmp[6]; 
   FFV5_3(F1, F2, COUP1, M3, W3, V3); 
   FFV7_3(F1, F2, COUP2, M3, W3, Vtmp); 
   i = 2; 
@@ -643,12 +708,13 @@ void FFV5_7_3(complex<double> F1[], complex<double> F2[], complex<double>
   }
 }
 
-void VVT11_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT11_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP31; 
-  complex<double> TMP32; 
+  C TMP31; 
+  C TMP32; 
   TMP32 = (V1[2] * - 1. * (T3[3] * V2[3] + T3[4] * V2[4] + T3[5] * V2[5] -
       T3[2] * V2[2]) + (V1[3] * (T3[7] * V2[3] + T3[8] * V2[4] + T3[9] * V2[5]
       - T3[6] * V2[2]) + (V1[4] * (T3[11] * V2[3] + T3[12] * V2[4] + T3[13] *
@@ -663,12 +729,14 @@ void VVT11_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void FFV5_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV5_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -693,14 +761,15 @@ void FFV5_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
       (V3[2] - V3[5])))));
 }
 
-void FFV5_7_1(complex<double> F2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV5_7_1(C F2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C F1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFV5_1(F2, V3, COUP1, M1, W1, F1); 
   FFV7_1(F2, V3, COUP2, M1, W1, Ftmp); 
   i = 2; 
@@ -711,15 +780,17 @@ void FFV5_7_1(complex<double> F2[], complex<double> V3[], complex<double>
   }
 }
 
-void VVT7_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT7_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP11; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
+  C TMP12; 
+  C TMP11; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -743,16 +814,18 @@ void VVT7_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void FFT2_0(complex<double> F1[], complex<double> F2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFT2_0(C F1[], C F2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP5; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  complex<double> TMP6; 
-  complex<double> TMP4; 
+  C TMP5; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP7; 
+  C TMP6; 
+  C TMP4; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -835,25 +908,27 @@ void FFT2_0(complex<double> F1[], complex<double> F2[], complex<double> T3[],
 }
 
 
-void VVT13_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT13_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP15; 
-  complex<double> TMP11; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP31; 
-  double P3[4]; 
-  complex<double> TMP16; 
-  complex<double> TMP33; 
-  complex<double> TMP17; 
-  complex<double> TMP14; 
-  complex<double> TMP32; 
-  complex<double> TMP34; 
-  complex<double> TMP19; 
-  complex<double> TMP18; 
+  C TMP15; 
+  C TMP11; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP31; 
+  R P3[4]; 
+  C TMP16; 
+  C TMP33; 
+  C TMP17; 
+  C TMP14; 
+  C TMP32; 
+  C TMP34; 
+  C TMP19; 
+  C TMP18; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -916,18 +991,20 @@ void VVT13_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void VVT8_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT8_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP11; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP9; 
-  complex<double> TMP13; 
-  complex<double> TMP8; 
+  C TMP12; 
+  C TMP11; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP9; 
+  C TMP13; 
+  C TMP8; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -955,17 +1032,19 @@ void VVT8_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void VVT3_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT3_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP39; 
-  complex<double> TMP37; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP40; 
-  complex<double> TMP38; 
+  C TMP39; 
+  C TMP37; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP40; 
+  C TMP38; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -1114,12 +1193,14 @@ void VVT3_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void FFV7_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV7_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -1155,15 +1236,17 @@ void FFV7_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFT5_0(complex<double> F1[], complex<double> F2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFT5_0(C F1[], C F2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP11; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP47; 
+  C TMP11; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP47; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -1187,12 +1270,14 @@ void FFT5_0(complex<double> F1[], complex<double> F2[], complex<double> T3[],
 }
 
 
-void FFV5_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV5_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -1217,13 +1302,14 @@ void FFV5_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
       V3[5]));
 }
 
-void FFV5_7_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV5_7_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
 //   double P2[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   FFV5_2(F1, V3, COUP1, M2, W2, F2); 
   FFV7_2(F1, V3, COUP2, M2, W2, Ftmp); 
@@ -1235,15 +1321,17 @@ void FFV5_7_2(complex<double> F1[], complex<double> V3[], complex<double>
   }
 }
 
-void FFV7_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV7_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P3[4]; 
-  complex<double> TMP20; 
-  complex<double> TMP21; 
-  double OM3; 
+  C denom; 
+  R P3[4]; 
+  C TMP20; 
+  C TMP21; 
+  R OM3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -1274,12 +1362,14 @@ void FFV7_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFV2_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV2_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -1315,16 +1405,18 @@ void FFV2_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFT3_0(complex<double> F1[], complex<double> F2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFT3_0(C F1[], C F2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP0; 
-  double P2[4]; 
-  complex<double> TMP3; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP0; 
+  R P2[4]; 
+  C TMP3; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -1405,29 +1497,31 @@ void FFT3_0(complex<double> F1[], complex<double> F2[], complex<double> T3[],
 }
 
 
-void VVT10_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT10_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP10; 
-  double P3[4]; 
-  complex<double> TMP14; 
-  complex<double> TMP43; 
-  complex<double> TMP9; 
-  complex<double> TMP11; 
-  double P2[4]; 
-  complex<double> TMP46; 
-  complex<double> TMP33; 
-  complex<double> TMP34; 
-  complex<double> TMP42; 
-  complex<double> TMP12; 
-  double P1[4]; 
-  complex<double> TMP45; 
-  complex<double> TMP41; 
-  complex<double> TMP13; 
-  complex<double> TMP44; 
-  complex<double> TMP17; 
-  complex<double> TMP8; 
+  C TMP10; 
+  R P3[4]; 
+  C TMP14; 
+  C TMP43; 
+  C TMP9; 
+  C TMP11; 
+  R P2[4]; 
+  C TMP46; 
+  C TMP33; 
+  C TMP34; 
+  C TMP42; 
+  C TMP12; 
+  R P1[4]; 
+  C TMP45; 
+  C TMP41; 
+  C TMP13; 
+  C TMP44; 
+  C TMP17; 
+  C TMP8; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -1497,15 +1591,16 @@ void VVT10_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
       TMP34)))));
 }
 
-void VVT10_11_12_13_2_3_6_7_8_9_0(complex<double> V1[], complex<double> V2[],
-    complex<double> T3[], complex<double> COUP1, complex<double> COUP2,
+template<class C>
+void VVT10_11_12_13_2_3_6_7_8_9_0(C V1[], C V2[],
+    C T3[], complex<double> COUP1, complex<double> COUP2,
     complex<double> COUP3, complex<double> COUP4, complex<double> COUP5,
     complex<double> COUP6, complex<double> COUP7, complex<double> COUP8,
-    complex<double> COUP9, complex<double> COUP10, complex<double> & vertex)
+    complex<double> COUP9, complex<double> COUP10, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P3[4]; 
-  complex<double> tmp; 
+  C tmp; 
 //   double P2[4]; 
 //   double P1[4]; 
   VVT10_0(V1, V2, T3, COUP1, vertex); 
@@ -1529,19 +1624,21 @@ void VVT10_11_12_13_2_3_6_7_8_9_0(complex<double> V1[], complex<double> V2[],
   vertex = vertex + tmp; 
 }
 
-void VVT9_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT9_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP17; 
-  double P3[4]; 
-  complex<double> TMP16; 
-  complex<double> TMP15; 
-  complex<double> TMP14; 
-  complex<double> TMP19; 
-  complex<double> TMP18; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP17; 
+  R P3[4]; 
+  C TMP16; 
+  C TMP15; 
+  C TMP14; 
+  C TMP19; 
+  C TMP18; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -1581,23 +1678,25 @@ void VVT9_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void VVT6_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT6_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  complex<double> TMP17; 
-  double P3[4]; 
-  complex<double> TMP30; 
-  complex<double> TMP26; 
-  complex<double> TMP14; 
-  complex<double> TMP28; 
-  complex<double> TMP27; 
-  complex<double> TMP29; 
-  complex<double> TMP24; 
-  complex<double> TMP25; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP23; 
+  C TMP17; 
+  R P3[4]; 
+  C TMP30; 
+  C TMP26; 
+  C TMP14; 
+  C TMP28; 
+  C TMP27; 
+  C TMP29; 
+  C TMP24; 
+  C TMP25; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -1881,12 +1980,14 @@ void VVT6_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void FFV2P0_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV2P0_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P3[4]; 
-  complex<double> denom; 
+  R P3[4]; 
+  C denom; 
   V3[0] = +F1[0] + F2[0]; 
   V3[1] = +F1[1] + F2[1]; 
   P3[0] = -V3[0].real(); 
@@ -1906,15 +2007,17 @@ void FFV2P0_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFT1_0(complex<double> F1[], complex<double> F2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFT1_0(C F1[], C F2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP11; 
-  double P1[4]; 
-  complex<double> TMP22; 
-  complex<double> TMP10; 
-  double P2[4]; 
+  C TMP11; 
+  R P1[4]; 
+  C TMP22; 
+  C TMP10; 
+  R P2[4]; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -1937,14 +2040,15 @@ void FFT1_0(complex<double> F1[], complex<double> F2[], complex<double> T3[],
   vertex = COUP * - TMP22 * (+cI * (TMP10 + TMP11)); 
 }
 
-void FFT1_2_3_5_0(complex<double> F1[], complex<double> F2[], complex<double>
+template<class C>
+void FFT1_2_3_5_0(C F1[], C F2[], C
     T3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3,
-    complex<double> COUP4, complex<double> & vertex)
+    complex<double> COUP4, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
 //   double P2[4]; 
-  complex<double> tmp; 
+  C tmp; 
   FFT1_0(F1, F2, T3, COUP1, vertex); 
   FFT2_0(F1, F2, T3, COUP2, tmp); 
   vertex = vertex + tmp; 
@@ -1954,16 +2058,18 @@ void FFT1_2_3_5_0(complex<double> F1[], complex<double> F2[], complex<double>
   vertex = vertex + tmp; 
 }
 
-void VVT2_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVT2_0(C V1[], C V2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP11; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP36; 
-  complex<double> TMP35; 
+  C TMP11; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP36; 
+  C TMP35; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -2005,25 +2111,27 @@ void VVT2_0(complex<double> V1[], complex<double> V2[], complex<double> T3[],
 }
 
 
-void VVT13_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT13_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP38; 
-  complex<double> TMP36; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP32; 
-  complex<double> denom; 
-  complex<double> TMP13; 
-  complex<double> TMP34; 
-  complex<double> TMP29; 
-  double OM1; 
-  complex<double> TMP9; 
-  complex<double> TMP35; 
-  double P1[4]; 
+  C TMP12; 
+  C TMP38; 
+  C TMP36; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP15; 
+  C TMP32; 
+  C denom; 
+  C TMP13; 
+  C TMP34; 
+  C TMP29; 
+  R OM1; 
+  C TMP9; 
+  C TMP35; 
+  R P1[4]; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -2116,16 +2224,18 @@ void VVT13_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void FFT4_0(complex<double> F1[], complex<double> F2[], complex<double> T3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFT4_0(C F1[], C F2[], C T3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP5; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  complex<double> TMP6; 
-  complex<double> TMP4; 
+  C TMP5; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP7; 
+  C TMP6; 
+  C TMP4; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -2210,12 +2320,14 @@ void FFT4_0(complex<double> F1[], complex<double> F2[], complex<double> T3[],
 }
 
 
-void FFV8_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV8_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -2251,13 +2363,15 @@ void FFV8_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFT3_1(complex<double> F2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFT3_1(C F2[], C T3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C denom; 
   P2[0] = F2[0].real(); 
   P2[1] = F2[1].real(); 
   P2[2] = F2[1].imag(); 
@@ -2497,23 +2611,25 @@ void FFT3_1(complex<double> F2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT6_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT6_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP59; 
-  complex<double> TMP61; 
-  double P1[4]; 
-  complex<double> TMP57; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP55; 
-  complex<double> denom; 
-  complex<double> TMP64; 
-  double OM1; 
-  complex<double> TMP9; 
-  complex<double> TMP63; 
-  complex<double> TMP38; 
+  C TMP59; 
+  C TMP61; 
+  R P1[4]; 
+  C TMP57; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP55; 
+  C denom; 
+  C TMP64; 
+  R OM1; 
+  C TMP9; 
+  C TMP63; 
+  C TMP38; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -2831,27 +2947,29 @@ void VVT6_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT10_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT10_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P3[4]; 
-  complex<double> TMP47; 
-  complex<double> TMP9; 
-  complex<double> TMP25; 
-  complex<double> TMP37; 
-  double P2[4]; 
-  complex<double> TMP46; 
-  double OM3; 
-  complex<double> TMP49; 
-  complex<double> TMP12; 
-  double P1[4]; 
-  complex<double> TMP30; 
-  complex<double> TMP16; 
-  complex<double> denom; 
-  complex<double> TMP48; 
-  complex<double> TMP38; 
-  complex<double> TMP26; 
+  R P3[4]; 
+  C TMP47; 
+  C TMP9; 
+  C TMP25; 
+  C TMP37; 
+  R P2[4]; 
+  C TMP46; 
+  R OM3; 
+  C TMP49; 
+  C TMP12; 
+  R P1[4]; 
+  C TMP30; 
+  C TMP16; 
+  C denom; 
+  C TMP48; 
+  C TMP38; 
+  C TMP26; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -3477,19 +3595,20 @@ void VVT10_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
       * (+cI * (TMP46) + 3./1. * cI * (P1[3] * P1[3])))))));
 }
 
-void VVT10_11_12_13_2_3_6_7_8_9_3(complex<double> V1[], complex<double> V2[],
+template<class C>
+void VVT10_11_12_13_2_3_6_7_8_9_3(C V1[], C V2[],
     complex<double> COUP1, complex<double> COUP2, complex<double> COUP3,
     complex<double> COUP4, complex<double> COUP5, complex<double> COUP6,
     complex<double> COUP7, complex<double> COUP8, complex<double> COUP9,
-    complex<double> COUP10, double M3, double W3, complex<double> T3[])
+    complex<double> COUP10, double M3, double W3, C T3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P3[4]; 
 //   double P2[4]; 
 //   double OM3; 
 //   double P1[4]; 
-  complex<double> Ttmp[18]; 
-  complex<double> denom; 
+  C Ttmp[18]; 
+  C denom; 
   int i; 
   VVT10_3(V1, V2, COUP1, M3, W3, T3); 
   VVT11_3(V1, V2, COUP2, M3, W3, Ttmp); 
@@ -3557,12 +3676,14 @@ void VVT10_11_12_13_2_3_6_7_8_9_3(complex<double> V1[], complex<double> V2[],
   }
 }
 
-void FFV6_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV6_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -3598,23 +3719,25 @@ void FFV6_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void VVT12_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT12_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP34; 
-  double P1[4]; 
-  complex<double> TMP36; 
-  double P2[4]; 
-  complex<double> TMP16; 
-  complex<double> TMP15; 
-  complex<double> TMP26; 
-  complex<double> TMP32; 
-  complex<double> denom; 
-  complex<double> TMP13; 
-  complex<double> TMP29; 
-  double OM1; 
-  complex<double> TMP35; 
+  C TMP34; 
+  R P1[4]; 
+  C TMP36; 
+  R P2[4]; 
+  C TMP16; 
+  C TMP15; 
+  C TMP26; 
+  C TMP32; 
+  C denom; 
+  C TMP13; 
+  C TMP29; 
+  R OM1; 
+  C TMP35; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -3702,57 +3825,63 @@ void VVT12_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void FFV5_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV5_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP0; 
+  C TMP0; 
   TMP0 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
       F1[3] * (F2[4] * (V3[3] - cI * (V3[4])) + F2[5] * (V3[2] - V3[5])));
   vertex = COUP * - cI * TMP0; 
 }
 
-void FFV5_7_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex)
+template<class C>
+void FFV5_7_0(C F1[], C F2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> tmp; 
+  C tmp; 
   FFV5_0(F1, F2, V3, COUP1, vertex); 
   FFV7_0(F1, F2, V3, COUP2, tmp); 
   vertex = vertex + tmp; 
 }
-void FFV5_6_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex)
+template<class C>
+void FFV5_6_0(C F1[], C F2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> tmp; 
+  C tmp; 
   FFV5_0(F1, F2, V3, COUP1, vertex); 
   FFV6_0(F1, F2, V3, COUP2, tmp); 
   vertex = vertex + tmp; 
 }
-void FFV5_8_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex)
+template<class C>
+void FFV5_8_0(C F1[], C F2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> tmp; 
+  C tmp; 
   FFV5_0(F1, F2, V3, COUP1, vertex); 
   FFV8_0(F1, F2, V3, COUP2, tmp); 
   vertex = vertex + tmp; 
 }
 
-void VVT7_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT7_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP16; 
-  complex<double> denom; 
-  double OM3; 
-  complex<double> TMP25; 
-  complex<double> TMP9; 
+  C TMP12; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP16; 
+  C denom; 
+  R OM3; 
+  C TMP25; 
+  C TMP9; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -3843,15 +3972,17 @@ void VVT7_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVT11_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT11_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> TMP36; 
-  complex<double> denom; 
-  double OM1; 
-  complex<double> TMP35; 
+  R P1[4]; 
+  C TMP36; 
+  C denom; 
+  R OM1; 
+  C TMP35; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -3888,13 +4019,15 @@ void VVT11_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void FFT2_1(complex<double> F2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFT2_1(C F2[], C T3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C denom; 
   P2[0] = F2[0].real(); 
   P2[1] = F2[1].real(); 
   P2[2] = F2[1].imag(); 
@@ -4134,21 +4267,23 @@ void FFT2_1(complex<double> F2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT8_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT8_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP16; 
-  complex<double> TMP30; 
-  complex<double> denom; 
-  complex<double> TMP26; 
-  complex<double> TMP25; 
-  complex<double> TMP9; 
-  double OM3; 
+  C TMP12; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP16; 
+  C TMP30; 
+  C denom; 
+  C TMP26; 
+  C TMP25; 
+  C TMP9; 
+  R OM3; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -4317,12 +4452,14 @@ void VVT8_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void FFV8_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV8_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -4358,20 +4495,22 @@ void FFV8_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void VVT2_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT2_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP16; 
-  complex<double> TMP66; 
-  complex<double> denom; 
-  double OM3; 
-  complex<double> TMP65; 
-  complex<double> TMP9; 
+  C TMP12; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP16; 
+  C TMP66; 
+  C denom; 
+  R OM3; 
+  C TMP65; 
+  C TMP9; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -4523,21 +4662,23 @@ void VVT2_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVT5_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT5_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP37; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> TMP54; 
-  complex<double> denom; 
-  complex<double> TMP53; 
-  complex<double> TMP9; 
-  complex<double> TMP38; 
+  C TMP12; 
+  C TMP37; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  R OM3; 
+  C TMP54; 
+  C denom; 
+  C TMP53; 
+  C TMP9; 
+  C TMP38; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -4842,15 +4983,17 @@ void VVT5_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void FFT1_2(complex<double> F1[], complex<double> T3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFT1_2(C F1[], C T3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP13; 
+  C denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP15; 
+  C TMP13; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -4887,16 +5030,17 @@ void FFT1_2(complex<double> F1[], complex<double> T3[], complex<double> COUP,
       + (F1[3] * (P2[0] - P2[3]) - F1[5] * M2)));
 }
 
-void FFT1_2_3_5_2(complex<double> F1[], complex<double> T3[], complex<double>
+template<class C>
+void FFT1_2_3_5_2(C F1[], C T3[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4,
-    double M2, double W2, complex<double> F2[])
+    double M2, double W2, C F2[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
+  C denom; 
 //   double P1[4]; 
 //   double P2[4]; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFT1_2(F1, T3, COUP1, M2, W2, F2); 
   FFT2_2(F1, T3, COUP2, M2, W2, Ftmp); 
   i = 2; 
@@ -4920,16 +5064,17 @@ void FFT1_2_3_5_2(complex<double> F1[], complex<double> T3[], complex<double>
     i++; 
   }
 }
-void FFT1_2_4_5_2(complex<double> F1[], complex<double> T3[], complex<double>
+template<class C>
+void FFT1_2_4_5_2(C F1[], C T3[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4,
-    double M2, double W2, complex<double> F2[])
+    double M2, double W2, C F2[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
+  C denom; 
 //   double P1[4]; 
 //   double P2[4]; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFT1_2(F1, T3, COUP1, M2, W2, F2); 
   FFT2_2(F1, T3, COUP2, M2, W2, Ftmp); 
   i = 2; 
@@ -4954,13 +5099,15 @@ void FFT1_2_4_5_2(complex<double> F1[], complex<double> T3[], complex<double>
   }
 }
 
-void FFT4_2(complex<double> F1[], complex<double> T3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFT4_2(C F1[], C T3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C denom; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -5200,20 +5347,22 @@ void FFT4_2(complex<double> F1[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void FFT3_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void FFT3_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP11; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP9; 
-  complex<double> TMP8; 
+  C TMP12; 
+  C TMP11; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
+  C TMP9; 
+  C TMP8; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -5422,19 +5571,21 @@ void FFT3_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFT5_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void FFT5_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP16; 
-  double OM3; 
-  complex<double> TMP14; 
-  complex<double> denom; 
-  complex<double> TMP9; 
+  C TMP12; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP16; 
+  R OM3; 
+  C TMP14; 
+  C denom; 
+  C TMP9; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -5525,19 +5676,21 @@ void FFT5_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void VVT3_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT3_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP71; 
-  complex<double> denom; 
-  complex<double> TMP73; 
-  complex<double> TMP72; 
-  double OM1; 
-  complex<double> TMP74; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP71; 
+  C denom; 
+  C TMP73; 
+  C TMP72; 
+  R OM1; 
+  C TMP74; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -5782,27 +5935,29 @@ void VVT3_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT10_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT10_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP39; 
-  double P3[4]; 
-  complex<double> TMP9; 
-  complex<double> TMP43; 
-  double P2[4]; 
-  complex<double> TMP26; 
-  complex<double> TMP15; 
-  complex<double> TMP12; 
-  double P1[4]; 
-  complex<double> TMP45; 
-  complex<double> TMP16; 
-  complex<double> denom; 
-  complex<double> TMP13; 
-  complex<double> TMP38; 
-  complex<double> TMP44; 
-  complex<double> TMP40; 
-  double OM1; 
+  C TMP39; 
+  R P3[4]; 
+  C TMP9; 
+  C TMP43; 
+  R P2[4]; 
+  C TMP26; 
+  C TMP15; 
+  C TMP12; 
+  R P1[4]; 
+  C TMP45; 
+  C TMP16; 
+  C denom; 
+  C TMP13; 
+  C TMP38; 
+  C TMP44; 
+  C TMP40; 
+  R OM1; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -5908,18 +6063,19 @@ void VVT10_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
       (+cI * (TMP12 * TMP39 + TMP9 * TMP40))))));
 }
 
-void VVT10_11_12_13_2_3_6_7_8_9_1(complex<double> V2[], complex<double> T3[],
+template<class C>
+void VVT10_11_12_13_2_3_6_7_8_9_1(C V2[], C T3[],
     complex<double> COUP1, complex<double> COUP2, complex<double> COUP3,
     complex<double> COUP4, complex<double> COUP5, complex<double> COUP6,
     complex<double> COUP7, complex<double> COUP8, complex<double> COUP9,
-    complex<double> COUP10, double M1, double W1, complex<double> V1[])
+    complex<double> COUP10, double M1, double W1, C V1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P3[4]; 
-  complex<double> Vtmp[6]; 
+  C Vtmp[6]; 
 //   double P2[4]; 
 //   double P1[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
 //   double OM1; 
   VVT10_1(V2, T3, COUP1, M1, W1, V1); 
@@ -5988,13 +6144,15 @@ void VVT10_11_12_13_2_3_6_7_8_9_1(complex<double> V2[], complex<double> T3[],
   }
 }
 
-void FFT2_2(complex<double> F1[], complex<double> T3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFT2_2(C F1[], C T3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C denom; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -6234,23 +6392,25 @@ void FFT2_2(complex<double> F1[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT12_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT12_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP37; 
-  double P1[4]; 
-  double OM3; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP30; 
-  complex<double> TMP16; 
-  complex<double> denom; 
-  complex<double> TMP26; 
-  complex<double> TMP25; 
-  complex<double> TMP9; 
-  complex<double> TMP38; 
+  C TMP12; 
+  C TMP37; 
+  R P1[4]; 
+  R OM3; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP30; 
+  C TMP16; 
+  C denom; 
+  C TMP26; 
+  C TMP25; 
+  C TMP9; 
+  C TMP38; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -6480,13 +6640,14 @@ void VVT12_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
       cI * (TMP30)) + P1[3] * (-cI * (V2[5] * TMP30) + cI * (P2[3] * TMP25)))));
 }
 
-void FFV5_6_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV5_6_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
 //   double P2[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   FFV5_2(F1, V3, COUP1, M2, W2, F2); 
   FFV6_2(F1, V3, COUP2, M2, W2, Ftmp); 
@@ -6497,13 +6658,14 @@ void FFV5_6_2(complex<double> F1[], complex<double> V3[], complex<double>
     i++; 
   }
 }
-void FFV5_8_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV5_8_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
 //   double P2[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   FFV5_2(F1, V3, COUP1, M2, W2, F2); 
   FFV8_2(F1, V3, COUP2, M2, W2, Ftmp); 
@@ -6515,16 +6677,18 @@ void FFV5_8_2(complex<double> F1[], complex<double> V3[], complex<double>
   }
 }
 
-void VVT11_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT11_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP37; 
-  complex<double> TMP38; 
-  double P3[4]; 
-  complex<double> denom; 
-  double OM3; 
-  complex<double> TMP25; 
+  C TMP37; 
+  C TMP38; 
+  R P3[4]; 
+  C denom; 
+  R OM3; 
+  C TMP25; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -6606,20 +6770,22 @@ void VVT11_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVT1_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT1_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP16; 
-  complex<double> TMP66; 
-  complex<double> denom; 
-  double OM3; 
-  complex<double> TMP65; 
-  complex<double> TMP9; 
+  C TMP12; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP16; 
+  C TMP66; 
+  C denom; 
+  R OM3; 
+  C TMP65; 
+  C TMP9; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -6770,19 +6936,20 @@ void VVT1_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
       (TMP66)) + 1./3. * (TMP16 * (-cI * (TMP65) + cI * (TMP66)))));
 }
 
-void VVT1_10_11_12_13_3_5_7_8_9_3(complex<double> V1[], complex<double> V2[],
+template<class C>
+void VVT1_10_11_12_13_3_5_7_8_9_3(C V1[], C V2[],
     complex<double> COUP1, complex<double> COUP2, complex<double> COUP3,
     complex<double> COUP4, complex<double> COUP5, complex<double> COUP6,
     complex<double> COUP7, complex<double> COUP8, complex<double> COUP9,
-    complex<double> COUP10, double M3, double W3, complex<double> T3[])
+    complex<double> COUP10, double M3, double W3, C T3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P3[4]; 
 //   double P2[4]; 
 //   double OM3; 
 //   double P1[4]; 
-  complex<double> Ttmp[18]; 
-  complex<double> denom; 
+  C Ttmp[18]; 
+  C denom; 
   int i; 
   VVT1_3(V1, V2, COUP1, M3, W3, T3); 
   VVT10_3(V1, V2, COUP2, M3, W3, Ttmp); 
@@ -6850,12 +7017,13 @@ void VVT1_10_11_12_13_3_5_7_8_9_3(complex<double> V1[], complex<double> V2[],
   }
 }
 
-void FFV8_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV8_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP1; 
-  complex<double> TMP0; 
+  C TMP1; 
+  C TMP0; 
   TMP1 = (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI * (V3[4]))) +
       F1[5] * (F2[2] * (+cI * (V3[4]) - V3[3]) + F2[3] * (V3[2] + V3[5])));
   TMP0 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
@@ -6864,15 +7032,17 @@ void FFV8_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void VVT2_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT2_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP13; 
+  C denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP15; 
+  C TMP13; 
   P2[0] = V2[0].real(); 
   P2[1] = V2[1].real(); 
   P2[2] = V2[1].imag(); 
@@ -6917,14 +7087,15 @@ void VVT2_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
       V2[2]))));
 }
 
-void FFT1_2_4_5_0(complex<double> F1[], complex<double> F2[], complex<double>
+template<class C>
+void FFT1_2_4_5_0(C F1[], C F2[], C
     T3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3,
-    complex<double> COUP4, complex<double> & vertex)
+    complex<double> COUP4, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
 //   double P2[4]; 
-  complex<double> tmp; 
+  C tmp; 
   FFT1_0(F1, F2, T3, COUP1, vertex); 
   FFT2_0(F1, F2, T3, COUP2, tmp); 
   vertex = vertex + tmp; 
@@ -6934,12 +7105,14 @@ void FFT1_2_4_5_0(complex<double> F1[], complex<double> F2[], complex<double>
   vertex = vertex + tmp; 
 }
 
-void FFV6_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV6_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -6975,15 +7148,17 @@ void FFV6_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFT5_1(complex<double> F2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFT5_1(C F2[], C T3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP13; 
+  C denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP15; 
+  C TMP13; 
   P2[0] = F2[0].real(); 
   P2[1] = F2[1].real(); 
   P2[2] = F2[1].imag(); 
@@ -7021,19 +7196,21 @@ void FFT5_1(complex<double> F2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT3_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT3_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP76; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> denom; 
-  double OM3; 
-  complex<double> TMP75; 
-  complex<double> TMP9; 
+  C TMP12; 
+  C TMP76; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C denom; 
+  R OM3; 
+  C TMP75; 
+  C TMP9; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -7303,11 +7480,12 @@ void VVT3_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void FFV2_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV2_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP50; 
+  C TMP50; 
   TMP50 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
       (F1[3] * (F2[4] * (V3[3] - cI * (V3[4])) + F2[5] * (V3[2] - V3[5])) +
       (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI * (V3[4]))) +
@@ -7315,14 +7493,15 @@ void FFV2_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
   vertex = COUP * - cI * TMP50; 
 }
 
-void FFV5_6_1(complex<double> F2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV5_6_1(C F2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C F1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFV5_1(F2, V3, COUP1, M1, W1, F1); 
   FFV6_1(F2, V3, COUP2, M1, W1, Ftmp); 
   i = 2; 
@@ -7332,14 +7511,15 @@ void FFV5_6_1(complex<double> F2[], complex<double> V3[], complex<double>
     i++; 
   }
 }
-void FFV5_8_1(complex<double> F2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV5_8_1(C F2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C F1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFV5_1(F2, V3, COUP1, M1, W1, F1); 
   FFV8_1(F2, V3, COUP2, M1, W1, Ftmp); 
   i = 2; 
@@ -7351,21 +7531,23 @@ void FFV5_8_1(complex<double> F2[], complex<double> V3[], complex<double>
 }
 
 
-void VVT9_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT9_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP37; 
-  double P1[4]; 
-  double OM3; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP30; 
-  complex<double> denom; 
-  complex<double> TMP26; 
-  complex<double> TMP9; 
-  complex<double> TMP38; 
+  C TMP12; 
+  C TMP37; 
+  R P1[4]; 
+  R OM3; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP30; 
+  C denom; 
+  C TMP26; 
+  C TMP9; 
+  C TMP38; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -7502,19 +7684,21 @@ void VVT9_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void FFT1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void FFT1_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP17; 
-  double P3[4]; 
-  complex<double> TMP16; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP9; 
+  C TMP12; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP17; 
+  R P3[4]; 
+  C TMP16; 
+  R OM3; 
+  C denom; 
+  C TMP9; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -7604,17 +7788,18 @@ void FFT1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
       * cI * (TMP16)));
 }
 
-void FFT1_2_4_5_3(complex<double> F1[], complex<double> F2[], complex<double>
+template<class C>
+void FFT1_2_4_5_3(C F1[], C F2[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4,
-    double M3, double W3, complex<double> T3[])
+    double M3, double W3, C T3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Ttmp[18]; 
+  C Ttmp[18]; 
 //   double P1[4]; 
 //   double P2[4]; 
 //   double P3[4]; 
 //   double OM3; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   FFT1_3(F1, F2, COUP1, M3, W3, T3); 
   FFT2_3(F1, F2, COUP2, M3, W3, Ttmp); 
@@ -7639,17 +7824,18 @@ void FFT1_2_4_5_3(complex<double> F1[], complex<double> F2[], complex<double>
     i++; 
   }
 }
-void FFT1_2_3_5_3(complex<double> F1[], complex<double> F2[], complex<double>
+template<class C>
+void FFT1_2_3_5_3(C F1[], C F2[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4,
-    double M3, double W3, complex<double> T3[])
+    double M3, double W3, C T3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Ttmp[18]; 
+  C Ttmp[18]; 
 //   double P1[4]; 
 //   double P2[4]; 
 //   double P3[4]; 
 //   double OM3; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   FFT1_3(F1, F2, COUP1, M3, W3, T3); 
   FFT2_3(F1, F2, COUP2, M3, W3, Ttmp); 
@@ -7675,13 +7861,15 @@ void FFT1_2_3_5_3(complex<double> F1[], complex<double> F2[], complex<double>
   }
 }
 
-void FFT4_1(complex<double> F2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFT4_1(C F2[], C T3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C denom; 
   P2[0] = F2[0].real(); 
   P2[1] = F2[1].real(); 
   P2[2] = F2[1].imag(); 
@@ -7920,15 +8108,17 @@ void FFT4_1(complex<double> F2[], complex<double> T3[], complex<double> COUP,
       P1[3]))))))))))));
 }
 
-void FFV6_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV6_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP3; 
+  C TMP2; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
+  C TMP3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -7959,23 +8149,25 @@ void FFV6_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void VVT13_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT13_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP37; 
-  double P1[4]; 
-  double OM3; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP30; 
-  complex<double> TMP16; 
-  complex<double> denom; 
-  complex<double> TMP26; 
-  complex<double> TMP25; 
-  complex<double> TMP9; 
-  complex<double> TMP38; 
+  C TMP12; 
+  C TMP37; 
+  R P1[4]; 
+  R OM3; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP30; 
+  C TMP16; 
+  C denom; 
+  C TMP26; 
+  C TMP25; 
+  C TMP9; 
+  C TMP38; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -8101,15 +8293,16 @@ void VVT13_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
       (P3[3] * P3[3] * OM3) + 1./1. * cI) - cI * (P2[3] * V1[5]))));
 }
 
-void FFV5_6_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV5_6_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P3[4]; 
 //   double OM3; 
   int i; 
-  complex<double> denom; 
-  complex<double> Vtmp[6]; 
+  C denom; 
+  C Vtmp[6]; 
   FFV5_3(F1, F2, COUP1, M3, W3, V3); 
   FFV6_3(F1, F2, COUP2, M3, W3, Vtmp); 
   i = 2; 
@@ -8119,15 +8312,16 @@ void FFV5_6_3(complex<double> F1[], complex<double> F2[], complex<double>
     i++; 
   }
 }
-void FFV5_8_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV5_8_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P3[4]; 
 //   double OM3; 
   int i; 
-  complex<double> denom; 
-  complex<double> Vtmp[6]; 
+  C denom; 
+  C Vtmp[6]; 
   FFV5_3(F1, F2, COUP1, M3, W3, V3); 
   FFV8_3(F1, F2, COUP2, M3, W3, Vtmp); 
   i = 2; 
@@ -8138,21 +8332,23 @@ void FFV5_8_3(complex<double> F1[], complex<double> F2[], complex<double>
   }
 }
 
-void VVT4_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT4_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP37; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> denom; 
-  double OM3; 
-  complex<double> TMP52; 
-  complex<double> TMP51; 
-  complex<double> TMP9; 
-  complex<double> TMP38; 
+  C TMP12; 
+  C TMP37; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C denom; 
+  R OM3; 
+  C TMP52; 
+  C TMP51; 
+  C TMP9; 
+  C TMP38; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -8457,15 +8653,17 @@ void VVT4_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void FFV8_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV8_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP3; 
+  C TMP2; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
+  C TMP3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -8496,21 +8694,23 @@ void FFV8_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void VVT9_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT9_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP34; 
-  complex<double> TMP38; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP32; 
-  complex<double> denom; 
-  complex<double> TMP29; 
-  double OM1; 
-  complex<double> TMP9; 
-  double P1[4]; 
+  C TMP34; 
+  C TMP38; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP15; 
+  C TMP32; 
+  C denom; 
+  C TMP29; 
+  R OM1; 
+  C TMP9; 
+  R P1[4]; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -8571,23 +8771,25 @@ void VVT9_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT6_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void VVT6_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP37; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> TMP54; 
-  complex<double> denom; 
-  complex<double> TMP53; 
-  complex<double> TMP52; 
-  complex<double> TMP51; 
-  complex<double> TMP9; 
-  complex<double> TMP38; 
+  C TMP12; 
+  C TMP37; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  R OM3; 
+  C TMP54; 
+  C denom; 
+  C TMP53; 
+  C TMP52; 
+  C TMP51; 
+  C TMP9; 
+  C TMP38; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -9110,15 +9312,17 @@ void VVT6_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void FFT1_1(complex<double> F2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFT1_1(C F2[], C T3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP13; 
+  C denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP15; 
+  C TMP13; 
   P2[0] = F2[0].real(); 
   P2[1] = F2[1].real(); 
   P2[2] = F2[1].imag(); 
@@ -9155,16 +9359,17 @@ void FFT1_1(complex<double> F2[], complex<double> T3[], complex<double> COUP,
       + (F2[3] * (P1[0] + P1[3]) + F2[5] * M1)));
 }
 
-void FFT1_2_3_5_1(complex<double> F2[], complex<double> T3[], complex<double>
+template<class C>
+void FFT1_2_3_5_1(C F2[], C T3[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4,
-    double M1, double W1, complex<double> F1[])
+    double M1, double W1, C F1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
+  C denom; 
 //   double P1[4]; 
 //   double P2[4]; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFT1_1(F2, T3, COUP1, M1, W1, F1); 
   FFT2_1(F2, T3, COUP2, M1, W1, Ftmp); 
   i = 2; 
@@ -9188,16 +9393,17 @@ void FFT1_2_3_5_1(complex<double> F2[], complex<double> T3[], complex<double>
     i++; 
   }
 }
-void FFT1_2_4_5_1(complex<double> F2[], complex<double> T3[], complex<double>
+template<class C>
+void FFT1_2_4_5_1(C F2[], C T3[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4,
-    double M1, double W1, complex<double> F1[])
+    double M1, double W1, C F1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
+  C denom; 
 //   double P1[4]; 
 //   double P2[4]; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFT1_1(F2, T3, COUP1, M1, W1, F1); 
   FFT2_1(F2, T3, COUP2, M1, W1, Ftmp); 
   i = 2; 
@@ -9222,20 +9428,22 @@ void FFT1_2_4_5_1(complex<double> F2[], complex<double> T3[], complex<double>
   }
 }
 
-void FFT4_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void FFT4_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP11; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP9; 
-  complex<double> TMP8; 
+  C TMP12; 
+  C TMP11; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
+  C TMP9; 
+  C TMP8; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -9444,13 +9652,15 @@ void FFT4_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFT3_2(complex<double> F1[], complex<double> T3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFT3_2(C F1[], C T3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C denom; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -9690,12 +9900,13 @@ void FFT3_2(complex<double> F1[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void FFV6_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV6_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP1; 
-  complex<double> TMP0; 
+  C TMP1; 
+  C TMP0; 
   TMP1 = (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI * (V3[4]))) +
       F1[5] * (F2[2] * (+cI * (V3[4]) - V3[3]) + F2[3] * (V3[2] + V3[5])));
   TMP0 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
@@ -9704,15 +9915,17 @@ void FFV6_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void FFT5_2(complex<double> F1[], complex<double> T3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFT5_2(C F1[], C T3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP13; 
+  C denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP15; 
+  C TMP13; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -9750,17 +9963,19 @@ void FFT5_2(complex<double> F1[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void VVT7_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT7_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP26; 
-  double OM1; 
-  complex<double> TMP13; 
+  C denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP15; 
+  C TMP26; 
+  R OM1; 
+  C TMP13; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -9798,20 +10013,22 @@ void VVT7_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void FFT2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> T3[])
+template<class C>
+void FFT2_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C T3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  double P1[4]; 
-  complex<double> TMP22; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
-  complex<double> TMP24; 
-  complex<double> TMP9; 
+  C TMP12; 
+  R P1[4]; 
+  C TMP22; 
+  R P2[4]; 
+  C TMP23; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
+  C TMP24; 
+  C TMP9; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -10015,17 +10232,19 @@ void FFT2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void VVT8_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVT8_1(C V2[], C T3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP16; 
-  complex<double> TMP15; 
-  complex<double> TMP26; 
-  complex<double> TMP13; 
+  C denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP16; 
+  C TMP15; 
+  C TMP26; 
+  C TMP13; 
   P2[0] = V2[0].real(); 
   P2[1] = V2[1].real(); 
   P2[2] = V2[1].imag(); 
@@ -10061,12 +10280,13 @@ void VVT8_1(complex<double> V2[], complex<double> T3[], complex<double> COUP,
 }
 
 
-void FFV7_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV7_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP1; 
-  complex<double> TMP0; 
+  C TMP1; 
+  C TMP0; 
   TMP1 = (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI * (V3[4]))) +
       F1[5] * (F2[2] * (+cI * (V3[4]) - V3[3]) + F2[3] * (V3[2] + V3[5])));
   TMP0 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
@@ -10075,11 +10295,12 @@ void FFV7_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void FFV3_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV3_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP8; 
+  C TMP8; 
   TMP8 = (F1[2] * (F2[4] * - 1. * (V3[2] + V3[5]) - F2[5] * (V3[3] + cI *
       (V3[4]))) + (F1[3] * (F2[4] * (+cI * (V3[4]) - V3[3]) + F2[5] * (V3[5] -
       V3[2])) + (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI *
@@ -10089,19 +10310,21 @@ void FFV3_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void VVV2_0(complex<double> V1[], complex<double> V2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVV2_0(C V1[], C V2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  double P1[4]; 
-  complex<double> TMP0; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  complex<double> TMP6; 
-  complex<double> TMP5; 
-  complex<double> TMP4; 
-  complex<double> TMP3; 
+  C TMP2; 
+  R P1[4]; 
+  C TMP0; 
+  R P2[4]; 
+  C TMP7; 
+  C TMP6; 
+  C TMP5; 
+  C TMP4; 
+  C TMP3; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -10121,14 +10344,16 @@ void VVV2_0(complex<double> V1[], complex<double> V2[], complex<double> V3[],
       TMP6 * TMP7)));
 }
 
-void VVV1_0(complex<double> V1[], complex<double> V2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVV1_0(C V1[], C V2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP9; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP9; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -10158,27 +10383,30 @@ void VVV1_0(complex<double> V1[], complex<double> V2[], complex<double> V3[],
   vertex = COUP * (-cI * (TMP9) + cI * (TMP10)); 
 }
 
-void VVV1_2_0(complex<double> V1[], complex<double> V2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex)
+template<class C>
+void VVV1_2_0(C V1[], C V2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
 //   double P2[4]; 
-  complex<double> tmp; 
+  C tmp; 
   VVV1_0(V1, V2, V3, COUP1, vertex); 
   VVV2_0(V1, V2, V3, COUP2, tmp); 
   vertex = vertex + tmp; 
 }
 
-void FFV4_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV4_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  double P1[4]; 
-  complex<double> TMP0; 
-  double P2[4]; 
-  complex<double> TMP13; 
+  C TMP2; 
+  R P1[4]; 
+  C TMP0; 
+  R P2[4]; 
+  C TMP13; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -10194,15 +10422,17 @@ void FFV4_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void FFV1_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV1_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP1; 
-  double P1[4]; 
-  complex<double> TMP0; 
-  double P2[4]; 
+  C TMP2; 
+  C TMP1; 
+  R P1[4]; 
+  C TMP0; 
+  R P2[4]; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -10217,14 +10447,15 @@ void FFV1_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
   vertex = COUP * TMP1 * (-cI * (TMP0) + cI * (TMP2)); 
 }
 
-void FFV1_2_3_4_0(complex<double> F1[], complex<double> F2[], complex<double>
+template<class C>
+void FFV1_2_3_4_0(C F1[], C F2[], C
     V3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3,
-    complex<double> COUP4, complex<double> & vertex)
+    complex<double> COUP4, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
 //   double P2[4]; 
-  complex<double> tmp; 
+  C tmp; 
   FFV1_0(F1, F2, V3, COUP1, vertex); 
   FFV2_0(F1, F2, V3, COUP2, tmp); 
   vertex = vertex + tmp; 
@@ -10235,12 +10466,14 @@ void FFV1_2_3_4_0(complex<double> F1[], complex<double> F2[], complex<double>
 }
 
 
-void FFV3_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV3_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -10276,15 +10509,17 @@ void FFV3_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV1_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV1_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP11; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> denom; 
-  complex<double> TMP9; 
+  C TMP11; 
+  R P1[4]; 
+  R P2[4]; 
+  C denom; 
+  C TMP9; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -10313,16 +10548,17 @@ void FFV1_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
       (P2[2])) + (F1[3] * (P2[0] - P2[3]) - F1[5] * M2)));
 }
 
-void FFV1_2_3_4_2(complex<double> F1[], complex<double> V3[], complex<double>
+template<class C>
+void FFV1_2_3_4_2(C F1[], C V3[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4,
-    double M2, double W2, complex<double> F2[])
+    double M2, double W2, C F2[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
 //   double P2[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFV1_2(F1, V3, COUP1, M2, W2, F2); 
   FFV2_2(F1, V3, COUP2, M2, W2, Ftmp); 
   i = 2; 
@@ -10348,22 +10584,24 @@ void FFV1_2_3_4_2(complex<double> F1[], complex<double> V3[], complex<double>
 }
 
 
-void VVV2_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void VVV2_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  complex<double> TMP17; 
-  double P3[4]; 
-  complex<double> TMP20; 
-  complex<double> denom; 
-  double OM3; 
-  complex<double> TMP14; 
-  complex<double> TMP19; 
-  complex<double> TMP18; 
+  C TMP12; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  C TMP17; 
+  R P3[4]; 
+  C TMP20; 
+  C denom; 
+  R OM3; 
+  C TMP14; 
+  C TMP19; 
+  C TMP18; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -10404,17 +10642,19 @@ void VVV2_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
       P2[3])) + (+cI * (V1[5] * TMP12 + V2[5] * TMP14))));
 }
 
-void VVV1_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void VVV1_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  double P3[4]; 
-  complex<double> denom; 
-  double OM3; 
-  complex<double> TMP8; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP7; 
+  R P3[4]; 
+  C denom; 
+  R OM3; 
+  C TMP8; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -10470,17 +10710,18 @@ void VVV1_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
       P3[3] * (TMP8 - TMP7))));
 }
 
-void VVV1_2_3(complex<double> V1[], complex<double> V2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[])
+template<class C>
+void VVV1_2_3(C V1[], C V2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
 //   double P2[4]; 
 //   double P3[4]; 
-  complex<double> denom; 
+  C denom; 
 //   double OM3; 
   int i; 
-  complex<double> Vtmp[6]; 
+  C Vtmp[6]; 
   VVV1_3(V1, V2, COUP1, M3, W3, V3); 
   VVV2_3(V1, V2, COUP2, M3, W3, Vtmp); 
   i = 2; 
@@ -10491,15 +10732,17 @@ void VVV1_2_3(complex<double> V1[], complex<double> V2[], complex<double>
   }
 }
 
-void FFV4_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV4_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP11; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> denom; 
-  complex<double> TMP9; 
+  C TMP11; 
+  R P1[4]; 
+  R P2[4]; 
+  C denom; 
+  C TMP9; 
   P2[0] = F2[0].real(); 
   P2[1] = F2[1].real(); 
   P2[2] = F2[1].imag(); 
@@ -10529,15 +10772,17 @@ void FFV4_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV1_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV1_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP11; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> denom; 
-  complex<double> TMP9; 
+  C TMP11; 
+  R P1[4]; 
+  R P2[4]; 
+  C denom; 
+  C TMP9; 
   P2[0] = F2[0].real(); 
   P2[1] = F2[1].real(); 
   P2[2] = F2[1].imag(); 
@@ -10566,16 +10811,17 @@ void FFV1_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
       P1[1]) + (F2[3] * (P1[0] + P1[3]) + F2[5] * M1)));
 }
 
-void FFV1_2_3_4_1(complex<double> F2[], complex<double> V3[], complex<double>
+template<class C>
+void FFV1_2_3_4_1(C F2[], C V3[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4,
-    double M1, double W1, complex<double> F1[])
+    double M1, double W1, C F1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
 //   double P2[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFV1_1(F2, V3, COUP1, M1, W1, F1); 
   FFV2_1(F2, V3, COUP2, M1, W1, Ftmp); 
   i = 2; 
@@ -10601,14 +10847,16 @@ void FFV1_2_3_4_1(complex<double> F2[], complex<double> V3[], complex<double>
 }
 
 
-void FFV3_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV3_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  complex<double> TMP22; 
-  double P3[4]; 
-  double OM3; 
+  C denom; 
+  C TMP22; 
+  R P3[4]; 
+  R OM3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -10636,15 +10884,17 @@ void FFV3_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFV4_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV4_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP11; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> denom; 
-  complex<double> TMP9; 
+  C TMP11; 
+  R P1[4]; 
+  R P2[4]; 
+  C denom; 
+  C TMP9; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -10674,14 +10924,16 @@ void FFV4_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV2_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P3[4]; 
-  complex<double> TMP26; 
-  double OM3; 
+  C denom; 
+  R P3[4]; 
+  C TMP26; 
+  R OM3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -10708,12 +10960,14 @@ void FFV2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFV3_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV3_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -10749,18 +11003,20 @@ void FFV3_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV1_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP23; 
-  complex<double> TMP17; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> TMP18; 
+  C denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP23; 
+  C TMP17; 
+  R P3[4]; 
+  R OM3; 
+  C TMP18; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -10793,17 +11049,18 @@ void FFV1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
       * (P1[3]) + cI * (P2[3])));
 }
 
-void FFV1_2_3_4_3(complex<double> F1[], complex<double> F2[], complex<double>
+template<class C>
+void FFV1_2_3_4_3(C F1[], C F2[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4,
-    double M3, double W3, complex<double> V3[])
+    double M3, double W3, C V3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
+  C denom; 
 //   double P1[4]; 
 //   double P2[4]; 
 //   double P3[4]; 
 //   double OM3; 
-  complex<double> Vtmp[6]; 
+  C Vtmp[6]; 
   int i; 
   FFV1_3(F1, F2, COUP1, M3, W3, V3); 
   FFV2_3(F1, F2, COUP2, M3, W3, Vtmp); 
@@ -10829,19 +11086,21 @@ void FFV1_2_3_4_3(complex<double> F1[], complex<double> F2[], complex<double>
   }
 }
 
-void VVV2_1(complex<double> V2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVV2_1(C V2[], C V3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP11; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP16; 
-  complex<double> TMP15; 
-  complex<double> denom; 
-  double OM1; 
-  complex<double> TMP9; 
+  C TMP12; 
+  C TMP11; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP16; 
+  C TMP15; 
+  C denom; 
+  R OM1; 
+  C TMP9; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -10877,15 +11136,17 @@ void VVV2_1(complex<double> V2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void VVV1_1(complex<double> V2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVV1_1(C V2[], C V3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP6; 
-  complex<double> denom; 
-  double OM1; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP6; 
+  C denom; 
+  R OM1; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -10928,15 +11189,16 @@ void VVV1_1(complex<double> V2[], complex<double> V3[], complex<double> COUP,
       OM1 * TMP6)));
 }
 
-void VVV1_2_1(complex<double> V2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> V1[])
+template<class C>
+void VVV1_2_1(C V2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C V1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
 //   double P2[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
-  complex<double> Vtmp[6]; 
+  C Vtmp[6]; 
 //   double OM1; 
   VVV1_1(V2, V3, COUP1, M1, W1, V1); 
   VVV2_1(V2, V3, COUP2, M1, W1, Vtmp); 
@@ -10948,18 +11210,20 @@ void VVV1_2_1(complex<double> V2[], complex<double> V3[], complex<double>
   }
 }
 
-void FFV4_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV4_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP17; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> TMP24; 
-  complex<double> TMP18; 
+  C denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP17; 
+  R P3[4]; 
+  R OM3; 
+  C TMP24; 
+  C TMP18; 
   P1[0] = F1[0].real(); 
   P1[1] = F1[1].real(); 
   P1[2] = F1[1].imag(); 
@@ -10992,12 +11256,13 @@ void FFV4_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
       * (P1[3]) + cI * (P2[3])));
 }
 
-void VVS3_4_5_0(complex<double> V1[], complex<double> V2[], complex<double>
+template<class C>
+void VVS3_4_5_0(C V1[], C V2[], C
     S3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3,
-    complex<double> & vertex)
+    C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> tmp; 
+  C tmp; 
   VVS3_0(V1, V2, S3, COUP1, vertex); 
   VVS4_0(V1, V2, S3, COUP2, tmp); 
   vertex = vertex + tmp; 
@@ -11005,14 +11270,15 @@ void VVS3_4_5_0(complex<double> V1[], complex<double> V2[], complex<double>
   vertex = vertex + tmp; 
 }
 
-void VVS3_4_5_3(complex<double> V1[], complex<double> V2[], complex<double>
+template<class C>
+void VVS3_4_5_3(C V1[], C V2[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, double M3, double W3,
-    complex<double> S3[])
+    C S3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Stmp[3]; 
+  C Stmp[3]; 
 //   double P3[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   VVS3_3(V1, V2, COUP1, M3, W3, S3); 
   VVS4_3(V1, V2, COUP2, M3, W3, Stmp); 
@@ -11032,16 +11298,18 @@ void VVS3_4_5_3(complex<double> V1[], complex<double> V2[], complex<double>
 }
 
 
-void VVS1_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[])
+template<class C>
+void VVS1_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C S3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  double P3[4]; 
-  complex<double> TMP6; 
-  complex<double> denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP7; 
+  R P3[4]; 
+  C TMP6; 
+  C denom; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -11080,14 +11348,16 @@ void VVS1_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVS2_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVS2_0(C V1[], C V2[], C S3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP7; 
-  complex<double> TMP6; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP7; 
+  C TMP6; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -11118,13 +11388,15 @@ void VVS2_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
 }
 
 
-void VVS2_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVS2_1(C V2[], C S3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C denom; 
   P2[0] = V2[0].real(); 
   P2[1] = V2[1].real(); 
   P2[2] = V2[1].imag(); 
@@ -11152,24 +11424,27 @@ void VVS2_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
 }
 
 
-void VVS3_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVS3_0(C V1[], C V2[], C S3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP8; 
+  C TMP8; 
   TMP8 = (V2[2] * V1[2] - V2[3] * V1[3] - V2[4] * V1[4] - V2[5] * V1[5]); 
   vertex = COUP * - cI * TMP8 * S3[2]; 
 }
 
 
-void VVS3_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVS3_1(C V2[], C S3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
-  double OM1; 
-  complex<double> TMP9; 
+  R P1[4]; 
+  C denom; 
+  R OM1; 
+  C TMP9; 
   OM1 = 0.; 
   if (M1 != 0.)
     OM1 = 1./pow(M1, 2); 
@@ -11189,13 +11464,15 @@ void VVS3_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
 }
 
 
-void VVS3_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[])
+template<class C>
+void VVS3_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C S3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P3[4]; 
-  complex<double> denom; 
-  complex<double> TMP8; 
+  R P3[4]; 
+  C denom; 
+  C TMP8; 
   S3[0] = +V1[0] + V2[0]; 
   S3[1] = +V1[1] + V2[1]; 
   P3[0] = -S3[0].real(); 
@@ -11209,14 +11486,15 @@ void VVS3_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVS3_4_5_1(complex<double> V2[], complex<double> S3[], complex<double>
+template<class C>
+void VVS3_4_5_1(C V2[], C S3[], complex<double>
     COUP1, complex<double> COUP2, complex<double> COUP3, double M1, double W1,
-    complex<double> V1[])
+    C V1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
-  complex<double> denom; 
-  complex<double> Vtmp[6]; 
+  C denom; 
+  C Vtmp[6]; 
 //   double OM1; 
   int i; 
   VVS3_1(V2, S3, COUP1, M1, W1, V1); 
@@ -11237,16 +11515,18 @@ void VVS3_4_5_1(complex<double> V2[], complex<double> S3[], complex<double>
 }
 
 
-void VVS4_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVS4_0(C V1[], C V2[], C S3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP9; 
-  complex<double> TMP13; 
-  complex<double> TMP8; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP15; 
+  C TMP9; 
+  C TMP13; 
+  C TMP8; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -11263,15 +11543,17 @@ void VVS4_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
 }
 
 
-void VVS4_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVS4_1(C V2[], C S3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P1[4]; 
-  double P2[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP9; 
+  C denom; 
+  R P1[4]; 
+  R P2[4]; 
+  C TMP15; 
+  C TMP9; 
   P2[0] = V2[0].real(); 
   P2[1] = V2[1].real(); 
   P2[2] = V2[1].imag(); 
@@ -11293,18 +11575,20 @@ void VVS4_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
 }
 
 
-void VVS4_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[])
+template<class C>
+void VVS4_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C S3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP9; 
-  complex<double> TMP13; 
-  complex<double> TMP8; 
+  C denom; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP15; 
+  C TMP9; 
+  C TMP13; 
+  C TMP8; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -11329,21 +11613,23 @@ void VVS4_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void VVS5_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void VVS5_0(C V1[], C V2[], C S3[],
+    complex<double> COUP, C & vertex)
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP11; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP14; 
-  complex<double> TMP9; 
-  complex<double> TMP13; 
-  complex<double> TMP8; 
+  C TMP12; 
+  C TMP11; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP15; 
+  C TMP14; 
+  C TMP9; 
+  C TMP13; 
+  C TMP8; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -11369,19 +11655,21 @@ void VVS5_0(complex<double> V1[], complex<double> V2[], complex<double> S3[],
 }
 
 
-void VVS5_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> V1[])
+template<class C>
+void VVS5_1(C V2[], C S3[], complex<double> COUP,
+    double M1, double W1, C V1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP11; 
-  double P1[4]; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP14; 
-  complex<double> denom; 
-  complex<double> TMP9; 
+  C TMP12; 
+  C TMP11; 
+  R P1[4]; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP15; 
+  C TMP14; 
+  C denom; 
+  C TMP9; 
   P2[0] = V2[0].real(); 
   P2[1] = V2[1].real(); 
   P2[2] = V2[1].imag(); 
@@ -11414,22 +11702,24 @@ void VVS5_1(complex<double> V2[], complex<double> S3[], complex<double> COUP,
 }
 
 
-void VVS5_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
-    double M3, double W3, complex<double> S3[])
+template<class C>
+void VVS5_3(C V1[], C V2[], complex<double> COUP,
+    double M3, double W3, C S3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP11; 
-  double P1[4]; 
-  complex<double> TMP10; 
-  double P2[4]; 
-  double P3[4]; 
-  complex<double> TMP15; 
-  complex<double> TMP14; 
-  complex<double> denom; 
-  complex<double> TMP9; 
-  complex<double> TMP13; 
-  complex<double> TMP8; 
+  C TMP12; 
+  C TMP11; 
+  R P1[4]; 
+  C TMP10; 
+  R P2[4]; 
+  R P3[4]; 
+  C TMP15; 
+  C TMP14; 
+  C denom; 
+  C TMP9; 
+  C TMP13; 
+  C TMP8; 
   P1[0] = V1[0].real(); 
   P1[1] = V1[1].real(); 
   P1[2] = V1[1].imag(); 
@@ -11459,22 +11749,25 @@ void VVS5_3(complex<double> V1[], complex<double> V2[], complex<double> COUP,
 }
 
 
-void FFS1_0(complex<double> F1[], complex<double> F2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFS1_0(C F1[], C F2[], C S3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP0; 
+  C TMP0; 
   TMP0 = (F2[4] * F1[4] + F2[5] * F1[5] - F2[2] * F1[2] - F2[3] * F1[3]); 
   vertex = COUP * - cI * TMP0 * S3[2]; 
 }
 
 
-void FFS1_1(complex<double> F2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFS1_1(C F2[], C S3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + S3[0]; 
   F1[1] = +F2[1] + S3[1]; 
   P1[0] = -F1[0].real(); 
@@ -11494,12 +11787,14 @@ void FFS1_1(complex<double> F2[], complex<double> S3[], complex<double> COUP,
 }
 
 
-void FFS1_2(complex<double> F1[], complex<double> S3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFS1_2(C F1[], C S3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + S3[0]; 
   F2[1] = +F1[1] + S3[1]; 
   P2[0] = -F2[0].real(); 
@@ -11519,24 +11814,26 @@ void FFS1_2(complex<double> F1[], complex<double> S3[], complex<double> COUP,
 }
 
 
-void FFS1_2_0(complex<double> F1[], complex<double> F2[], complex<double> S3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex)
+template<class C>
+void FFS1_2_0(C F1[], C F2[], C S3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> tmp; 
+  C tmp; 
   FFS1_0(F1, F2, S3, COUP1, vertex); 
   FFS2_0(F1, F2, S3, COUP2, tmp); 
   vertex = vertex + tmp; 
 }
 
-void FFS1_2_1(complex<double> F2[], complex<double> S3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> F1[])
+template<class C>
+void FFS1_2_1(C F2[], C S3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C F1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFS1_1(F2, S3, COUP1, M1, W1, F1); 
   FFS2_1(F2, S3, COUP2, M1, W1, Ftmp); 
   i = 2; 
@@ -11547,13 +11844,14 @@ void FFS1_2_1(complex<double> F2[], complex<double> S3[], complex<double>
   }
 }
 
-void FFS1_2_2(complex<double> F1[], complex<double> S3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[])
+template<class C>
+void FFS1_2_2(C F1[], C S3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
 //   double P2[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   FFS1_2(F1, S3, COUP1, M2, W2, F2); 
   FFS2_2(F1, S3, COUP2, M2, W2, Ftmp); 
@@ -11566,22 +11864,25 @@ void FFS1_2_2(complex<double> F1[], complex<double> S3[], complex<double>
 }
 
 
-void FFS2_0(complex<double> F1[], complex<double> F2[], complex<double> S3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFS2_0(C F1[], C F2[], C S3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP1; 
+  C TMP1; 
   TMP1 = (F2[2] * F1[2] + F2[3] * F1[3] + F2[4] * F1[4] + F2[5] * F1[5]); 
   vertex = COUP * - cI * TMP1 * S3[2]; 
 }
 
 
-void FFS2_1(complex<double> F2[], complex<double> S3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFS2_1(C F2[], C S3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + S3[0]; 
   F1[1] = +F2[1] + S3[1]; 
   P1[0] = -F1[0].real(); 
@@ -11601,12 +11902,14 @@ void FFS2_1(complex<double> F2[], complex<double> S3[], complex<double> COUP,
 }
 
 
-void FFS2_2(complex<double> F1[], complex<double> S3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFS2_2(C F1[], C S3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + S3[0]; 
   F2[1] = +F1[1] + S3[1]; 
   P2[0] = -F2[0].real(); 
@@ -11625,6 +11928,162 @@ void FFS2_2(complex<double> F1[], complex<double> S3[], complex<double> COUP,
       (P2[0] - P2[3]) + F1[5] * M2));
 }
 
+// Explicit instantiations of the vertices for single events and, if
+// MEKD_HELAMPS_BATCH is defined, for batches of events or helicities
+#define HELAMPS_HEF_MEKD2_1_VERTICES(C) \
+template void FFV7_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV2_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void VVT12_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void FFV5_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV5_7_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, double M3, double W3, C V3[]); \
+template void VVT11_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void FFV5_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV5_7_1(C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, double M1, double W1, C F1[]); \
+template void VVT7_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void FFT2_0(C F1[], C F2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT13_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT8_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT3_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void FFV7_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFT5_0(C F1[], C F2[], C T3[], complex<double> COUP, C & vertex); \
+template void FFV5_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV5_7_2(C F1[], C V3[], complex<double> COUP1, complex<double> COUP2, double M2, double W2, C F2[]); \
+template void FFV7_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV2_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFT3_0(C F1[], C F2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT10_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT10_11_12_13_2_3_6_7_8_9_0(C V1[], C V2[], C T3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, complex<double> COUP5, complex<double> COUP6, complex<double> COUP7, complex<double> COUP8, complex<double> COUP9, complex<double> COUP10, C & vertex); \
+template void VVT9_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT6_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void FFV2P0_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFT1_0(C F1[], C F2[], C T3[], complex<double> COUP, C & vertex); \
+template void FFT1_2_3_5_0(C F1[], C F2[], C T3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, C & vertex); \
+template void VVT2_0(C V1[], C V2[], C T3[], complex<double> COUP, C & vertex); \
+template void VVT13_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void FFT4_0(C F1[], C F2[], C T3[], complex<double> COUP, C & vertex); \
+template void FFV8_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFT3_1(C F2[], C T3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void VVT6_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVT10_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT10_11_12_13_2_3_6_7_8_9_3(C V1[], C V2[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, complex<double> COUP5, complex<double> COUP6, complex<double> COUP7, complex<double> COUP8, complex<double> COUP9, complex<double> COUP10, double M3, double W3, C T3[]); \
+template void FFV6_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void VVT12_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void FFV5_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV5_7_0(C F1[], C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, C & vertex); \
+template void FFV5_6_0(C F1[], C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, C & vertex); \
+template void FFV5_8_0(C F1[], C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, C & vertex); \
+template void VVT7_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT11_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void FFT2_1(C F2[], C T3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void VVT8_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void FFV8_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void VVT2_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT5_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void FFT1_2(C F1[], C T3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFT1_2_3_5_2(C F1[], C T3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, double M2, double W2, C F2[]); \
+template void FFT1_2_4_5_2(C F1[], C T3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, double M2, double W2, C F2[]); \
+template void FFT4_2(C F1[], C T3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFT3_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void FFT5_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT3_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVT10_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVT10_11_12_13_2_3_6_7_8_9_1(C V2[], C T3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, complex<double> COUP5, complex<double> COUP6, complex<double> COUP7, complex<double> COUP8, complex<double> COUP9, complex<double> COUP10, double M1, double W1, C V1[]); \
+template void FFT2_2(C F1[], C T3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void VVT12_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void FFV5_6_2(C F1[], C V3[], complex<double> COUP1, complex<double> COUP2, double M2, double W2, C F2[]); \
+template void FFV5_8_2(C F1[], C V3[], complex<double> COUP1, complex<double> COUP2, double M2, double W2, C F2[]); \
+template void VVT11_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT1_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT1_10_11_12_13_3_5_7_8_9_3(C V1[], C V2[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, complex<double> COUP5, complex<double> COUP6, complex<double> COUP7, complex<double> COUP8, complex<double> COUP9, complex<double> COUP10, double M3, double W3, C T3[]); \
+template void FFV8_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void VVT2_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void FFT1_2_4_5_0(C F1[], C F2[], C T3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, C & vertex); \
+template void FFV6_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFT5_1(C F2[], C T3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void VVT3_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void FFV2_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV5_6_1(C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, double M1, double W1, C F1[]); \
+template void FFV5_8_1(C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, double M1, double W1, C F1[]); \
+template void VVT9_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void FFT1_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void FFT1_2_4_5_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, double M3, double W3, C T3[]); \
+template void FFT1_2_3_5_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, double M3, double W3, C T3[]); \
+template void FFT4_1(C F2[], C T3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV6_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void VVT13_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void FFV5_6_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, double M3, double W3, C V3[]); \
+template void FFV5_8_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, double M3, double W3, C V3[]); \
+template void VVT4_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void FFV8_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void VVT9_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVT6_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void FFT1_1(C F2[], C T3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFT1_2_3_5_1(C F2[], C T3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, double M1, double W1, C F1[]); \
+template void FFT1_2_4_5_1(C F2[], C T3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, double M1, double W1, C F1[]); \
+template void FFT4_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void FFT3_2(C F1[], C T3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV6_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFT5_2(C F1[], C T3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void VVT7_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void FFT2_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C T3[]); \
+template void VVT8_1(C V2[], C T3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void FFV7_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV3_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void VVV2_0(C V1[], C V2[], C V3[], complex<double> COUP, C & vertex); \
+template void VVV1_0(C V1[], C V2[], C V3[], complex<double> COUP, C & vertex); \
+template void VVV1_2_0(C V1[], C V2[], C V3[], complex<double> COUP1, complex<double> COUP2, C & vertex); \
+template void FFV4_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV1_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV1_2_3_4_0(C F1[], C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, C & vertex); \
+template void FFV3_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV1_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV1_2_3_4_2(C F1[], C V3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, double M2, double W2, C F2[]); \
+template void VVV2_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void VVV1_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void VVV1_2_3(C V1[], C V2[], complex<double> COUP1, complex<double> COUP2, double M3, double W3, C V3[]); \
+template void FFV4_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV1_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV1_2_3_4_1(C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, double M1, double W1, C F1[]); \
+template void FFV3_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV4_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV2_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV3_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV1_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV1_2_3_4_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, complex<double> COUP4, double M3, double W3, C V3[]); \
+template void VVV2_1(C V2[], C V3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVV1_1(C V2[], C V3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVV1_2_1(C V2[], C V3[], complex<double> COUP1, complex<double> COUP2, double M1, double W1, C V1[]); \
+template void FFV4_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void VVS3_4_5_0(C V1[], C V2[], C S3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, C & vertex); \
+template void VVS3_4_5_3(C V1[], C V2[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, double M3, double W3, C S3[]); \
+template void VVS1_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C S3[]); \
+template void VVS2_0(C V1[], C V2[], C S3[], complex<double> COUP, C & vertex); \
+template void VVS2_1(C V2[], C S3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVS3_0(C V1[], C V2[], C S3[], complex<double> COUP, C & vertex); \
+template void VVS3_1(C V2[], C S3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVS3_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C S3[]); \
+template void VVS3_4_5_1(C V2[], C S3[], complex<double> COUP1, complex<double> COUP2, complex<double> COUP3, double M1, double W1, C V1[]); \
+template void VVS4_0(C V1[], C V2[], C S3[], complex<double> COUP, C & vertex); \
+template void VVS4_1(C V2[], C S3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVS4_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C S3[]); \
+template void VVS5_0(C V1[], C V2[], C S3[], complex<double> COUP, C & vertex); \
+template void VVS5_1(C V2[], C S3[], complex<double> COUP, double M1, double W1, C V1[]); \
+template void VVS5_3(C V1[], C V2[], complex<double> COUP, double M3, double W3, C S3[]); \
+template void FFS1_0(C F1[], C F2[], C S3[], complex<double> COUP, C & vertex); \
+template void FFS1_1(C F2[], C S3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFS1_2(C F1[], C S3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFS1_2_0(C F1[], C F2[], C S3[], complex<double> COUP1, complex<double> COUP2, C & vertex); \
+template void FFS1_2_1(C F2[], C S3[], complex<double> COUP1, complex<double> COUP2, double M1, double W1, C F1[]); \
+template void FFS1_2_2(C F1[], C S3[], complex<double> COUP1, complex<double> COUP2, double M2, double W2, C F2[]); \
+template void FFS2_0(C F1[], C F2[], C S3[], complex<double> COUP, C & vertex); \
+template void FFS2_1(C F2[], C S3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFS2_2(C F1[], C S3[], complex<double> COUP, double M2, double W2, C F2[]);
+
+HELAMPS_HEF_MEKD2_1_VERTICES(complex<double>)
+#ifdef MEKD_HELAMPS_BATCH
+HELAMPS_HEF_MEKD2_1_VERTICES(MEKD_Batch_Complex)
+#endif
+#undef HELAMPS_HEF_MEKD2_1_VERTICES
 
 }  // end namespace $(namespace)s_HEF_MEKD2_1
 
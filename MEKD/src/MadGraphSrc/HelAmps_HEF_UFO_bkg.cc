@@ -258,15 +258,62 @@ void vxxxxx(double p[4], double vmass, int nhel, int nsv, complex<double> vc[6])
   return; 
 }
 
-void FFV43_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+#ifdef MEKD_HELAMPS_BATCH
+void ixxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fi[6])
 {
+  complex<double> fi_lane[6]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    ixxxxx(p[lane], fmass, nhel[lane], nsf, fi_lane); 
+    MEKD_Batch_Set_Lane(fi, fi_lane, 6, lane); 
+  }
+}
+
+void oxxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fo[6])
+{
+  complex<double> fo_lane[6]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    oxxxxx(p[lane], fmass, nhel[lane], nsf, fo_lane); 
+    MEKD_Batch_Set_Lane(fo, fo_lane, 6, lane); 
+  }
+}
+
+void vxxxxx(double * p[], double vmass, int nhel[], int nsv, MEKD_Batch_Complex
+    vc[6])
+{
+  complex<double> vc_lane[6]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    vxxxxx(p[lane], vmass, nhel[lane], nsv, vc_lane); 
+    MEKD_Batch_Set_Lane(vc, vc_lane, 6, lane); 
+  }
+}
+
+void sxxxxx(double * p[], int nss, MEKD_Batch_Complex sc[3])
+{
+  complex<double> sc_lane[3]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    sxxxxx(p[lane], nss, sc_lane); 
+    MEKD_Batch_Set_Lane(sc, sc_lane, 3, lane); 
+  }
+}
+#endif
+
+template<class C>
+void FFV43_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
+{
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  complex<double> TMP11; 
-  complex<double> TMP10; 
-  double P3[4]; 
-  double OM3; 
+  C denom; 
+  C TMP11; 
+  C TMP10; 
+  R P3[4]; 
+  R OM3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -294,12 +341,13 @@ void FFV43_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFV43_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV43_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP13; 
+  C TMP12; 
+  C TMP13; 
   TMP13 = (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI * (V3[4]))) +
       F1[5] * (F2[2] * (+cI * (V3[4]) - V3[3]) + F2[3] * (V3[2] + V3[5])));
   TMP12 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
@@ -308,12 +356,14 @@ void FFV43_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void FFV44_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV44_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -349,12 +399,14 @@ void FFV44_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV42_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV42_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -379,13 +431,14 @@ void FFV42_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
       V3[5]));
 }
 
-void FFV42_43_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV42_43_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
 //   double P2[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   FFV42_2(F1, V3, COUP1, M2, W2, F2); 
   FFV43_2(F1, V3, COUP2, M2, W2, Ftmp); 
@@ -396,13 +449,14 @@ void FFV42_43_2(complex<double> F1[], complex<double> V3[], complex<double>
     i++; 
   }
 }
-void FFV42_44_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV42_44_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
 //   double P2[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   FFV42_2(F1, V3, COUP1, M2, W2, F2); 
   FFV44_2(F1, V3, COUP2, M2, W2, Ftmp); 
@@ -413,13 +467,14 @@ void FFV42_44_2(complex<double> F1[], complex<double> V3[], complex<double>
     i++; 
   }
 }
-void FFV42_45_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV42_45_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
 //   double P2[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   FFV42_2(F1, V3, COUP1, M2, W2, F2); 
   FFV45_2(F1, V3, COUP2, M2, W2, Ftmp); 
@@ -431,12 +486,13 @@ void FFV42_45_2(complex<double> F1[], complex<double> V3[], complex<double>
   }
 }
 
-void FFV44_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV44_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP13; 
+  C TMP12; 
+  C TMP13; 
   TMP13 = (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI * (V3[4]))) +
       F1[5] * (F2[2] * (+cI * (V3[4]) - V3[3]) + F2[3] * (V3[2] + V3[5])));
   TMP12 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
@@ -445,56 +501,62 @@ void FFV44_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void FFV42_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV42_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
+  C TMP12; 
   TMP12 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
       F1[3] * (F2[4] * (V3[3] - cI * (V3[4])) + F2[5] * (V3[2] - V3[5])));
   vertex = COUP * - cI * TMP12; 
 }
 
-void FFV42_45_0(complex<double> F1[], complex<double> F2[], complex<double>
-    V3[], complex<double> COUP1, complex<double> COUP2, complex<double> &
+template<class C>
+void FFV42_45_0(C F1[], C F2[], C
+    V3[], complex<double> COUP1, complex<double> COUP2, C &
     vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> tmp; 
+  C tmp; 
   FFV42_0(F1, F2, V3, COUP1, vertex); 
   FFV45_0(F1, F2, V3, COUP2, tmp); 
   vertex = vertex + tmp; 
 }
-void FFV42_43_0(complex<double> F1[], complex<double> F2[], complex<double>
-    V3[], complex<double> COUP1, complex<double> COUP2, complex<double> &
+template<class C>
+void FFV42_43_0(C F1[], C F2[], C
+    V3[], complex<double> COUP1, complex<double> COUP2, C &
     vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> tmp; 
+  C tmp; 
   FFV42_0(F1, F2, V3, COUP1, vertex); 
   FFV43_0(F1, F2, V3, COUP2, tmp); 
   vertex = vertex + tmp; 
 }
-void FFV42_44_0(complex<double> F1[], complex<double> F2[], complex<double>
-    V3[], complex<double> COUP1, complex<double> COUP2, complex<double> &
+template<class C>
+void FFV42_44_0(C F1[], C F2[], C
+    V3[], complex<double> COUP1, complex<double> COUP2, C &
     vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> tmp; 
+  C tmp; 
   FFV42_0(F1, F2, V3, COUP1, vertex); 
   FFV44_0(F1, F2, V3, COUP2, tmp); 
   vertex = vertex + tmp; 
 }
 
-void FFV45_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV45_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  complex<double> TMP11; 
-  complex<double> TMP10; 
-  double P3[4]; 
-  double OM3; 
+  C denom; 
+  C TMP11; 
+  C TMP10; 
+  R P3[4]; 
+  R OM3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -522,11 +584,12 @@ void FFV45_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFV41_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV41_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP14; 
+  C TMP14; 
   TMP14 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
       (F1[3] * (F2[4] * (V3[3] - cI * (V3[4])) + F2[5] * (V3[2] - V3[5])) +
       (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI * (V3[4]))) +
@@ -535,12 +598,14 @@ void FFV41_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void FFV41_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV41_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -576,12 +641,14 @@ void FFV41_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV43_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV43_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -617,15 +684,17 @@ void FFV43_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV44_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV44_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  complex<double> TMP11; 
-  complex<double> TMP10; 
-  double P3[4]; 
-  double OM3; 
+  C denom; 
+  C TMP11; 
+  C TMP10; 
+  R P3[4]; 
+  R OM3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -653,14 +722,16 @@ void FFV44_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFV42_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV42_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  complex<double> TMP10; 
-  double P3[4]; 
-  double OM3; 
+  C denom; 
+  C TMP10; 
+  R P3[4]; 
+  R OM3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -682,15 +753,16 @@ void FFV42_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
   V3[5] = denom * - cI * (F2[5] * F1[3] - F2[4] * F1[2] - P3[3] * OM3 * TMP10); 
 }
 
-void FFV42_43_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV42_43_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
+  C denom; 
 //   double P3[4];
 //   double OM3;
   int i; 
-  complex<double> Vtmp[6]; 
+  C Vtmp[6]; 
   FFV42_3(F1, F2, COUP1, M3, W3, V3); 
   FFV43_3(F1, F2, COUP2, M3, W3, Vtmp); 
   i = 2; 
@@ -700,15 +772,16 @@ void FFV42_43_3(complex<double> F1[], complex<double> F2[], complex<double>
     i++; 
   }
 }
-void FFV42_44_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV42_44_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
+  C denom; 
 //   double P3[4]; 
 //   double OM3;
   int i; 
-  complex<double> Vtmp[6]; 
+  C Vtmp[6]; 
   FFV42_3(F1, F2, COUP1, M3, W3, V3); 
   FFV44_3(F1, F2, COUP2, M3, W3, Vtmp); 
   i = 2; 
@@ -718,15 +791,16 @@ void FFV42_44_3(complex<double> F1[], complex<double> F2[], complex<double>
     i++; 
   }
 }
-void FFV42_45_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV42_45_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
+  C denom; 
 //   double P3[4]; 
 //   double OM3; 
   int i; 
-  complex<double> Vtmp[6]; 
+  C Vtmp[6]; 
   FFV42_3(F1, F2, COUP1, M3, W3, V3); 
   FFV45_3(F1, F2, COUP2, M3, W3, Vtmp); 
   i = 2; 
@@ -737,12 +811,14 @@ void FFV42_45_3(complex<double> F1[], complex<double> F2[], complex<double>
   }
 }
 
-void FFV44_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV44_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -778,12 +854,13 @@ void FFV44_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV45_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV45_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP12; 
-  complex<double> TMP13; 
+  C TMP12; 
+  C TMP13; 
   TMP13 = (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI * (V3[4]))) +
       F1[5] * (F2[2] * (+cI * (V3[4]) - V3[3]) + F2[3] * (V3[2] + V3[5])));
   TMP12 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
@@ -792,12 +869,14 @@ void FFV45_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void FFV41_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV41_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -833,12 +912,14 @@ void FFV41_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV42_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV42_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -863,14 +944,15 @@ void FFV42_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
       (V3[2] - V3[5])))));
 }
 
-void FFV42_44_1(complex<double> F2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV42_44_1(C F2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C F1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFV42_1(F2, V3, COUP1, M1, W1, F1); 
   FFV44_1(F2, V3, COUP2, M1, W1, Ftmp); 
   i = 2; 
@@ -881,12 +963,14 @@ void FFV42_44_1(complex<double> F2[], complex<double> V3[], complex<double>
   }
 }
 
-void FFV45_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV45_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -922,14 +1006,16 @@ void FFV45_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV41_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV41_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  complex<double> TMP15; 
-  double P3[4]; 
-  double OM3; 
+  C denom; 
+  C TMP15; 
+  R P3[4]; 
+  R OM3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -955,6 +1041,43 @@ void FFV41_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
       * F1[5] - P3[3] * OM3 * TMP15);
 }
 
+// Explicit instantiations of the vertices for single events and, if
+// MEKD_HELAMPS_BATCH is defined, for batches of events or helicities
+#define HELAMPS_HEF_UFO_BKG_VERTICES(C) \
+template void FFV43_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV43_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV44_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV42_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV42_43_2(C F1[], C V3[], complex<double> COUP1, complex<double> COUP2, double M2, double W2, C F2[]); \
+template void FFV42_44_2(C F1[], C V3[], complex<double> COUP1, complex<double> COUP2, double M2, double W2, C F2[]); \
+template void FFV42_45_2(C F1[], C V3[], complex<double> COUP1, complex<double> COUP2, double M2, double W2, C F2[]); \
+template void FFV44_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV42_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV42_45_0(C F1[], C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, C & vertex); \
+template void FFV42_43_0(C F1[], C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, C & vertex); \
+template void FFV42_44_0(C F1[], C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, C & vertex); \
+template void FFV45_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV41_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV41_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV43_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV44_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV42_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV42_43_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, double M3, double W3, C V3[]); \
+template void FFV42_44_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, double M3, double W3, C V3[]); \
+template void FFV42_45_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, double M3, double W3, C V3[]); \
+template void FFV44_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV45_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV41_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV42_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV42_44_1(C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, double M1, double W1, C F1[]); \
+template void FFV45_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV41_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]);
+
+HELAMPS_HEF_UFO_BKG_VERTICES(complex<double>)
+#ifdef MEKD_HELAMPS_BATCH
+HELAMPS_HEF_UFO_BKG_VERTICES(MEKD_Batch_Complex)
+#endif
+#undef HELAMPS_HEF_UFO_BKG_VERTICES
 
 }  // end namespace $(namespace)s_HEF_UF
 
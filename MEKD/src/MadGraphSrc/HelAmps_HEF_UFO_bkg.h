@@ -11,6 +11,10 @@
 #include <cmath> 
 #include <complex> 
 
+#ifdef MEKD_HELAMPS_BATCH
+#include "HelAmps_Batch.h"
+#endif
+
 using namespace std; 
 
 namespace MG5_HEF_UFO_bkg
@@ -28,82 +32,124 @@ void sxxxxx(double p[4], int nss, std::complex<double> sc[3]);
 void vxxxxx(double p[4], double vmass, int nhel, int nsv, std::complex<double>
     v[6]);
 
-void FFV43_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
-
-void FFV43_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void FFV44_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[]);
-
-void FFV42_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[]);
-void FFV42_43_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[]);
-void FFV42_44_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[]);
-void FFV42_45_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[]);
+#ifdef MEKD_HELAMPS_BATCH
+// External wavefunctions for a batch, with one momentum and helicity per lane
+void ixxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fi[6]);
 
-void FFV44_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
+void oxxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fo[6]);
 
-void FFV42_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
-void FFV42_45_0(complex<double> F1[], complex<double> F2[], complex<double>
-    V3[], complex<double> COUP1, complex<double> COUP2, complex<double> &
+void vxxxxx(double * p[], double vmass, int nhel[], int nsv, MEKD_Batch_Complex
+    vc[6]);
+
+void sxxxxx(double * p[], int nss, MEKD_Batch_Complex sc[3]);
+#endif
+
+template<class C>
+void FFV43_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
+
+template<class C>
+void FFV43_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void FFV44_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[]);
+
+template<class C>
+void FFV42_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[]);
+template<class C>
+void FFV42_43_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[]);
+template<class C>
+void FFV42_44_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[]);
+template<class C>
+void FFV42_45_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[]);
+
+template<class C>
+void FFV44_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void FFV42_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex);
+template<class C>
+void FFV42_45_0(C F1[], C F2[], C
+    V3[], complex<double> COUP1, complex<double> COUP2, C &
     vertex);
-void FFV42_43_0(complex<double> F1[], complex<double> F2[], complex<double>
-    V3[], complex<double> COUP1, complex<double> COUP2, complex<double> &
+template<class C>
+void FFV42_43_0(C F1[], C F2[], C
+    V3[], complex<double> COUP1, complex<double> COUP2, C &
     vertex);
-void FFV42_44_0(complex<double> F1[], complex<double> F2[], complex<double>
-    V3[], complex<double> COUP1, complex<double> COUP2, complex<double> &
+template<class C>
+void FFV42_44_0(C F1[], C F2[], C
+    V3[], complex<double> COUP1, complex<double> COUP2, C &
     vertex);
 
-void FFV45_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
-
-void FFV41_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void FFV41_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[]);
-
-void FFV43_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[]);
-
-void FFV44_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
-
-void FFV42_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
-void FFV42_43_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[]);
-void FFV42_44_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[]);
-void FFV42_45_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[]);
-
-void FFV44_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[]);
-
-void FFV45_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void FFV41_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[]);
-
-void FFV42_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[]);
-void FFV42_44_1(complex<double> F2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> F1[]);
-
-void FFV45_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[]);
-
-void FFV41_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
+template<class C>
+void FFV45_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
+
+template<class C>
+void FFV41_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void FFV41_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[]);
+
+template<class C>
+void FFV43_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[]);
+
+template<class C>
+void FFV44_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
+
+template<class C>
+void FFV42_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
+template<class C>
+void FFV42_43_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[]);
+template<class C>
+void FFV42_44_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[]);
+template<class C>
+void FFV42_45_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[]);
+
+template<class C>
+void FFV44_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[]);
+
+template<class C>
+void FFV45_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void FFV41_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[]);
+
+template<class C>
+void FFV42_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[]);
+template<class C>
+void FFV42_44_1(C F2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C F1[]);
+
+template<class C>
+void FFV45_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[]);
+
+template<class C>
+void FFV41_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
 
 }  // end namespace MG5_HEF_UF
 
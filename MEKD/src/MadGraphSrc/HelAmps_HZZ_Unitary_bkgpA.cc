@@ -258,50 +258,101 @@ double Sgn(double a, double b)
   return (b < 0)? - abs(a):abs(a); 
 }
 
-void FFV2_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+#ifdef MEKD_HELAMPS_BATCH
+void ixxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fi[6])
+{
+  complex<double> fi_lane[6]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    ixxxxx(p[lane], fmass, nhel[lane], nsf, fi_lane); 
+    MEKD_Batch_Set_Lane(fi, fi_lane, 6, lane); 
+  }
+}
+
+void oxxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fo[6])
+{
+  complex<double> fo_lane[6]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    oxxxxx(p[lane], fmass, nhel[lane], nsf, fo_lane); 
+    MEKD_Batch_Set_Lane(fo, fo_lane, 6, lane); 
+  }
+}
+
+void vxxxxx(double * p[], double vmass, int nhel[], int nsv, MEKD_Batch_Complex
+    vc[6])
+{
+  complex<double> vc_lane[6]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    vxxxxx(p[lane], vmass, nhel[lane], nsv, vc_lane); 
+    MEKD_Batch_Set_Lane(vc, vc_lane, 6, lane); 
+  }
+}
+
+void sxxxxx(double * p[], int nss, MEKD_Batch_Complex sc[3])
+{
+  complex<double> sc_lane[3]; 
+  for (int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    sxxxxx(p[lane], nss, sc_lane); 
+    MEKD_Batch_Set_Lane(sc, sc_lane, 3, lane); 
+  }
+}
+#endif
+
+template<class C>
+void FFV2_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP0; 
+  C TMP0; 
   TMP0 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
       F1[3] * (F2[4] * (V3[3] - cI * (V3[4])) + F2[5] * (V3[2] - V3[5])));
   vertex = COUP * - cI * TMP0; 
 }
 
-void FFV2_5_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex)
+template<class C>
+void FFV2_5_0(C F1[], C F2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> tmp; 
+  C tmp; 
   FFV2_0(F1, F2, V3, COUP1, vertex); 
   FFV5_0(F1, F2, V3, COUP2, tmp); 
   vertex = vertex + tmp; 
 }
-void FFV2_3_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex)
+template<class C>
+void FFV2_3_0(C F1[], C F2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> tmp; 
+  C tmp; 
   FFV2_0(F1, F2, V3, COUP1, vertex); 
   FFV3_0(F1, F2, V3, COUP2, tmp); 
   vertex = vertex + tmp; 
 }
-void FFV2_4_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex)
+template<class C>
+void FFV2_4_0(C F1[], C F2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex)
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> tmp; 
+  C tmp; 
   FFV2_0(F1, F2, V3, COUP1, vertex); 
   FFV4_0(F1, F2, V3, COUP2, tmp); 
   vertex = vertex + tmp; 
 }
 
-void FFV3_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV3_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -337,15 +388,17 @@ void FFV3_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV5_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV5_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP5; 
-  complex<double> TMP1; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
+  C TMP5; 
+  C TMP1; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -376,12 +429,14 @@ void FFV5_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFV1_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV1_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -417,15 +472,17 @@ void FFV1_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV3_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV3_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP5; 
-  complex<double> TMP1; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
+  C TMP5; 
+  C TMP1; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -456,12 +513,13 @@ void FFV3_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFV3_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV3_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP0; 
+  C TMP2; 
+  C TMP0; 
   TMP0 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
       F1[3] * (F2[4] * (V3[3] - cI * (V3[4])) + F2[5] * (V3[2] - V3[5])));
   TMP2 = (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI * (V3[4]))) +
@@ -470,12 +528,14 @@ void FFV3_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void FFV5_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV5_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -511,11 +571,12 @@ void FFV5_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV1_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV1_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP3; 
+  C TMP3; 
   TMP3 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
       (F1[3] * (F2[4] * (V3[3] - cI * (V3[4])) + F2[5] * (V3[2] - V3[5])) +
       (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI * (V3[4]))) +
@@ -524,12 +585,13 @@ void FFV1_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void FFV4_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV4_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP0; 
+  C TMP2; 
+  C TMP0; 
   TMP0 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
       F1[3] * (F2[4] * (V3[3] - cI * (V3[4])) + F2[5] * (V3[2] - V3[5])));
   TMP2 = (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI * (V3[4]))) +
@@ -538,12 +600,14 @@ void FFV4_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void FFV4_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV4_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -579,12 +643,14 @@ void FFV4_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV2_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV2_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -609,13 +675,14 @@ void FFV2_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
       V3[5]));
 }
 
-void FFV2_5_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV2_5_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
 //   double P2[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   FFV2_2(F1, V3, COUP1, M2, W2, F2); 
   FFV5_2(F1, V3, COUP2, M2, W2, Ftmp); 
@@ -626,13 +693,14 @@ void FFV2_5_2(complex<double> F1[], complex<double> V3[], complex<double>
     i++; 
   }
 }
-void FFV2_3_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV2_3_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
 //   double P2[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   FFV2_2(F1, V3, COUP1, M2, W2, F2); 
   FFV3_2(F1, V3, COUP2, M2, W2, Ftmp); 
@@ -643,13 +711,14 @@ void FFV2_3_2(complex<double> F1[], complex<double> V3[], complex<double>
     i++; 
   }
 }
-void FFV2_4_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV2_4_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
 //   double P2[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
   FFV2_2(F1, V3, COUP1, M2, W2, F2); 
   FFV4_2(F1, V3, COUP2, M2, W2, Ftmp); 
@@ -661,14 +730,16 @@ void FFV2_4_2(complex<double> F1[], complex<double> V3[], complex<double>
   }
 }
 
-void FFV2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV2_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  complex<double> TMP1; 
-  double P3[4]; 
-  double OM3; 
+  C denom; 
+  C TMP1; 
+  R P3[4]; 
+  R OM3; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -689,15 +760,16 @@ void FFV2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
   V3[5] = denom * - cI * (F1[3] * F2[5] - F1[2] * F2[4] - P3[3] * OM3 * TMP1); 
 }
 
-void FFV2_3_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV2_3_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
+  C denom; 
 //   double P3[4]; 
 //   double OM3; 
   int i; 
-  complex<double> Vtmp[6]; 
+  C Vtmp[6]; 
   FFV2_3(F1, F2, COUP1, M3, W3, V3); 
   FFV3_3(F1, F2, COUP2, M3, W3, Vtmp); 
   i = 2; 
@@ -707,15 +779,16 @@ void FFV2_3_3(complex<double> F1[], complex<double> F2[], complex<double>
     i++; 
   }
 }
-void FFV2_4_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV2_4_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
+  C denom; 
 //   double P3[4]; 
 //   double OM3; 
   int i; 
-  complex<double> Vtmp[6]; 
+  C Vtmp[6]; 
   FFV2_3(F1, F2, COUP1, M3, W3, V3); 
   FFV4_3(F1, F2, COUP2, M3, W3, Vtmp); 
   i = 2; 
@@ -725,15 +798,16 @@ void FFV2_4_3(complex<double> F1[], complex<double> F2[], complex<double>
     i++; 
   }
 }
-void FFV2_5_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV2_5_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
+  C denom; 
 //   double P3[4]; 
 //   double OM3; 
   int i; 
-  complex<double> Vtmp[6]; 
+  C Vtmp[6]; 
   FFV2_3(F1, F2, COUP1, M3, W3, V3); 
   FFV5_3(F1, F2, COUP2, M3, W3, Vtmp); 
   i = 2; 
@@ -744,12 +818,14 @@ void FFV2_5_3(complex<double> F1[], complex<double> F2[], complex<double>
   }
 }
 
-void FFV5_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV5_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -785,12 +861,14 @@ void FFV5_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV2_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV2_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -815,14 +893,15 @@ void FFV2_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
       (V3[2] - V3[5])))));
 }
 
-void FFV2_5_1(complex<double> F2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV2_5_1(C F2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C F1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFV2_1(F2, V3, COUP1, M1, W1, F1); 
   FFV5_1(F2, V3, COUP2, M1, W1, Ftmp); 
   i = 2; 
@@ -832,14 +911,15 @@ void FFV2_5_1(complex<double> F2[], complex<double> V3[], complex<double>
     i++; 
   }
 }
-void FFV2_3_1(complex<double> F2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV2_3_1(C F2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C F1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4]; 
-  complex<double> denom; 
+  C denom; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFV2_1(F2, V3, COUP1, M1, W1, F1); 
   FFV3_1(F2, V3, COUP2, M1, W1, Ftmp); 
   i = 2; 
@@ -849,14 +929,15 @@ void FFV2_3_1(complex<double> F2[], complex<double> V3[], complex<double>
     i++; 
   }
 }
-void FFV2_4_1(complex<double> F2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV2_4_1(C F2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C F1[])
 {
 //   complex<double> cI = complex<double> (0., 1.); 
 //   double P1[4];
-  complex<double> denom; 
+  C denom; 
   int i; 
-  complex<double> Ftmp[6]; 
+  C Ftmp[6]; 
   FFV2_1(F2, V3, COUP1, M1, W1, F1); 
   FFV4_1(F2, V3, COUP2, M1, W1, Ftmp); 
   i = 2; 
@@ -867,12 +948,13 @@ void FFV2_4_1(complex<double> F2[], complex<double> V3[], complex<double>
   }
 }
 
-void FFV5_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex)
+template<class C>
+void FFV5_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex)
 {
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP2; 
-  complex<double> TMP0; 
+  C TMP2; 
+  C TMP0; 
   TMP0 = (F1[2] * (F2[4] * (V3[2] + V3[5]) + F2[5] * (V3[3] + cI * (V3[4]))) +
       F1[3] * (F2[4] * (V3[3] - cI * (V3[4])) + F2[5] * (V3[2] - V3[5])));
   TMP2 = (F1[4] * (F2[2] * (V3[2] - V3[5]) - F2[3] * (V3[3] + cI * (V3[4]))) +
@@ -881,14 +963,16 @@ void FFV5_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
 }
 
 
-void FFV1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV1_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> denom; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> TMP4; 
+  C denom; 
+  R P3[4]; 
+  R OM3; 
+  C TMP4; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -915,12 +999,14 @@ void FFV1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
 }
 
 
-void FFV3_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[])
+template<class C>
+void FFV3_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P2[4]; 
-  complex<double> denom; 
+  R P2[4]; 
+  C denom; 
   F2[0] = +F1[0] + V3[0]; 
   F2[1] = +F1[1] + V3[1]; 
   P2[0] = -F2[0].real(); 
@@ -956,12 +1042,14 @@ void FFV3_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV4_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV4_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -997,12 +1085,14 @@ void FFV4_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV1_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[])
+template<class C>
+void FFV1_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  double P1[4]; 
-  complex<double> denom; 
+  R P1[4]; 
+  C denom; 
   F1[0] = +F2[0] + V3[0]; 
   F1[1] = +F2[1] + V3[1]; 
   P1[0] = -F1[0].real(); 
@@ -1038,15 +1128,17 @@ void FFV1_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
 }
 
 
-void FFV4_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[])
+template<class C>
+void FFV4_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[])
 {
+  typedef typename C::value_type R; 
   complex<double> cI = complex<double> (0., 1.); 
-  complex<double> TMP5; 
-  complex<double> TMP1; 
-  double P3[4]; 
-  double OM3; 
-  complex<double> denom; 
+  C TMP5; 
+  C TMP1; 
+  R P3[4]; 
+  R OM3; 
+  C denom; 
   OM3 = 0.; 
   if (M3 != 0.)
     OM3 = 1./pow(M3, 2); 
@@ -1076,6 +1168,47 @@ void FFV4_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
       F2[2] + F1[5] * F2[3]));
 }
 
+// Explicit instantiations of the vertices for single events and, if
+// MEKD_HELAMPS_BATCH is defined, for batches of events or helicities
+#define HELAMPS_HZZ_UNITARY_BKGPA_VERTICES(C) \
+template void FFV2_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV2_5_0(C F1[], C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, C & vertex); \
+template void FFV2_3_0(C F1[], C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, C & vertex); \
+template void FFV2_4_0(C F1[], C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, C & vertex); \
+template void FFV3_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV5_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV1_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV3_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV3_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV5_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV1_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV4_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV4_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV2_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV2_5_2(C F1[], C V3[], complex<double> COUP1, complex<double> COUP2, double M2, double W2, C F2[]); \
+template void FFV2_3_2(C F1[], C V3[], complex<double> COUP1, complex<double> COUP2, double M2, double W2, C F2[]); \
+template void FFV2_4_2(C F1[], C V3[], complex<double> COUP1, complex<double> COUP2, double M2, double W2, C F2[]); \
+template void FFV2_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV2_3_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, double M3, double W3, C V3[]); \
+template void FFV2_4_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, double M3, double W3, C V3[]); \
+template void FFV2_5_3(C F1[], C F2[], complex<double> COUP1, complex<double> COUP2, double M3, double W3, C V3[]); \
+template void FFV5_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV2_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV2_5_1(C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, double M1, double W1, C F1[]); \
+template void FFV2_3_1(C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, double M1, double W1, C F1[]); \
+template void FFV2_4_1(C F2[], C V3[], complex<double> COUP1, complex<double> COUP2, double M1, double W1, C F1[]); \
+template void FFV5_0(C F1[], C F2[], C V3[], complex<double> COUP, C & vertex); \
+template void FFV1_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]); \
+template void FFV3_2(C F1[], C V3[], complex<double> COUP, double M2, double W2, C F2[]); \
+template void FFV4_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV1_1(C F2[], C V3[], complex<double> COUP, double M1, double W1, C F1[]); \
+template void FFV4_3(C F1[], C F2[], complex<double> COUP, double M3, double W3, C V3[]);
+
+HELAMPS_HZZ_UNITARY_BKGPA_VERTICES(complex<double>)
+#ifdef MEKD_HELAMPS_BATCH
+HELAMPS_HZZ_UNITARY_BKGPA_VERTICES(MEKD_Batch_Complex)
+#endif
+#undef HELAMPS_HZZ_UNITARY_BKGPA_VERTICES
 
 }  // end namespace $(namespace)s_HZZ_Unitar
 
@@ -11,6 +11,10 @@
 #include <cmath> 
 #include <complex> 
 
+#ifdef MEKD_HELAMPS_BATCH
+#include "HelAmps_Batch.h"
+#endif
+
 using namespace std; 
 
 namespace MG5_HZZ_Unitary_bkgpA
@@ -28,89 +32,135 @@ void ixxxxx(double p[4], double fmass, int nhel, int nsf, std::complex<double>
 
 double Sgn(double e, double f); 
 
-void FFV2_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
-void FFV2_5_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex);
-void FFV2_3_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex);
-void FFV2_4_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP1, complex<double> COUP2, complex<double> & vertex);
-
-void FFV3_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[]);
-
-void FFV5_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
-
-void FFV1_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[]);
-
-void FFV3_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
-
-void FFV3_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void FFV5_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[]);
-
-void FFV1_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void FFV4_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void FFV4_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[]);
-
-void FFV2_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[]);
-void FFV2_5_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[]);
-void FFV2_3_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[]);
-void FFV2_4_2(complex<double> F1[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M2, double W2, complex<double> F2[]);
-
-void FFV2_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
-void FFV2_3_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[]);
-void FFV2_4_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[]);
-void FFV2_5_3(complex<double> F1[], complex<double> F2[], complex<double>
-    COUP1, complex<double> COUP2, double M3, double W3, complex<double> V3[]);
-
-void FFV5_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[]);
-
-void FFV2_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[]);
-void FFV2_5_1(complex<double> F2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> F1[]);
-void FFV2_3_1(complex<double> F2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> F1[]);
-void FFV2_4_1(complex<double> F2[], complex<double> V3[], complex<double>
-    COUP1, complex<double> COUP2, double M1, double W1, complex<double> F1[]);
-
-void FFV5_0(complex<double> F1[], complex<double> F2[], complex<double> V3[],
-    complex<double> COUP, complex<double> & vertex);
-
-void FFV1_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
-
-void FFV3_2(complex<double> F1[], complex<double> V3[], complex<double> COUP,
-    double M2, double W2, complex<double> F2[]);
-
-void FFV4_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[]);
-
-void FFV1_1(complex<double> F2[], complex<double> V3[], complex<double> COUP,
-    double M1, double W1, complex<double> F1[]);
-
-void FFV4_3(complex<double> F1[], complex<double> F2[], complex<double> COUP,
-    double M3, double W3, complex<double> V3[]);
+#ifdef MEKD_HELAMPS_BATCH
+// External wavefunctions for a batch, with one momentum and helicity per lane
+void ixxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fi[6]);
+
+void oxxxxx(double * p[], double fmass, int nhel[], int nsf, MEKD_Batch_Complex
+    fo[6]);
+
+void vxxxxx(double * p[], double vmass, int nhel[], int nsv, MEKD_Batch_Complex
+    vc[6]);
+
+void sxxxxx(double * p[], int nss, MEKD_Batch_Complex sc[3]);
+#endif
+
+template<class C>
+void FFV2_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex);
+template<class C>
+void FFV2_5_0(C F1[], C F2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex);
+template<class C>
+void FFV2_3_0(C F1[], C F2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex);
+template<class C>
+void FFV2_4_0(C F1[], C F2[], C V3[],
+    complex<double> COUP1, complex<double> COUP2, C & vertex);
+
+template<class C>
+void FFV3_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[]);
+
+template<class C>
+void FFV5_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
+
+template<class C>
+void FFV1_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[]);
+
+template<class C>
+void FFV3_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
+
+template<class C>
+void FFV3_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void FFV5_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[]);
+
+template<class C>
+void FFV1_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void FFV4_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void FFV4_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[]);
+
+template<class C>
+void FFV2_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[]);
+template<class C>
+void FFV2_5_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[]);
+template<class C>
+void FFV2_3_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[]);
+template<class C>
+void FFV2_4_2(C F1[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M2, double W2, C F2[]);
+
+template<class C>
+void FFV2_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
+template<class C>
+void FFV2_3_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[]);
+template<class C>
+void FFV2_4_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[]);
+template<class C>
+void FFV2_5_3(C F1[], C F2[], complex<double>
+    COUP1, complex<double> COUP2, double M3, double W3, C V3[]);
+
+template<class C>
+void FFV5_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[]);
+
+template<class C>
+void FFV2_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[]);
+template<class C>
+void FFV2_5_1(C F2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C F1[]);
+template<class C>
+void FFV2_3_1(C F2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C F1[]);
+template<class C>
+void FFV2_4_1(C F2[], C V3[], complex<double>
+    COUP1, complex<double> COUP2, double M1, double W1, C F1[]);
+
+template<class C>
+void FFV5_0(C F1[], C F2[], C V3[],
+    complex<double> COUP, C & vertex);
+
+template<class C>
+void FFV1_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
+
+template<class C>
+void FFV3_2(C F1[], C V3[], complex<double> COUP,
+    double M2, double W2, C F2[]);
+
+template<class C>
+void FFV4_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[]);
+
+template<class C>
+void FFV1_1(C F2[], C V3[], complex<double> COUP,
+    double M1, double W1, C F1[]);
+
+template<class C>
+void FFV4_3(C F1[], C F2[], complex<double> COUP,
+    double M3, double W3, C V3[]);
 
 }  // end namespace MG5_HZZ_Unitar
 
@@ -163,6 +163,11 @@ void Parameters_MEKD::setIndependentParameters(SLHAReader_MEKD& slha)
   k2g = slha.get_block_entry("gravity", 2, 1.000000e-01); 
   k1g = slha.get_block_entry("gravity", 1, 1.000000e-01);
   cabi = slha.get_block_entry("ckmblock", 1, 2.277360e-01).real();
+  setDerivedParameters(); 
+}
+
+void Parameters_MEKD::setDerivedParameters()
+{
   gw = 1.; 
   g1 = 1.; 
   cos__cabi = cos(cabi); 
@@ -82,6 +82,8 @@ public:
 
     // Set parameters that are unchanged during the run
     void setIndependentParameters(SLHAReader_MEKD& slha); 
+    // Set parameters that follow from the ones above, e.g. after changing masses directly
+    void setDerivedParameters(); 
     // Set couplings that are unchanged during the run
     void setIndependentCouplings(); 
     // Set parameters that are changed event by event
@@ -24,7 +24,7 @@ void Spin0_SF::initProc(string param_card_name)
   SLHAReader_MEKD slha(param_card_name); 
   pars->setIndependentParameters(slha); 
   pars->setIndependentCouplings();
-	ntry = 0, sum_hel = 0, ngood = 0;	// moved here by Ghost remover v. 0.1 
+	setHelicityWarmUp(-1);	// sum over all helicities unless a warm-up is requested
 
 
   // Set external particle masses for this matrix element
@@ -43,7 +43,6 @@ void Spin0_SF::updateProc(SLHAReader_MEKD &slha)
 {
   pars->setIndependentParameters(slha); 
   pars->setIndependentCouplings();
-	ntry = 0, sum_hel = 0, ngood = 0;	// moved here by Ghost remover v. 0.1 
   
   // Set external particle masses for this matrix element
   mME[0]=(pars->MH);
@@ -53,6 +52,61 @@ void Spin0_SF::updateProc(SLHAReader_MEKD &slha)
   mME[4]=(pars->MM);
 }
 
+//--------------------------------------------------------------------------
+// Update process with a precomputed set of parameters.
+
+void Spin0_SF::updateProc(Parameters_MEKD *parameters)
+{
+  pars = parameters;
+  
+  // Set external particle masses for this matrix element
+  mME[0]=(pars->MH);
+  mME[1]=(pars->MM);
+  mME[2]=(pars->MM);
+  mME[3]=(pars->MM);
+  mME[4]=(pars->MM);
+}
+
+//--------------------------------------------------------------------------
+// Helicity filtering: the first n calls of sigmaKin sum over all helicities
+// and record the non-vanishing ones, later calls only use these.
+
+void Spin0_SF::setHelicityWarmUp(int n) 
+{
+  nwarmup = n; 
+  ntry = 0, sum_hel = 0, ngood = 0; 
+  jhel = 0; 
+  for(int i = 0; i < ncomb; i++ )
+    goodhel[i] = false; 
+}
+
+bool Spin0_SF::getGoodHelicities(vector<int> & good) const
+{
+  good.clear(); 
+  if (nwarmup < 0 || ntry < nwarmup)
+    return false; 
+  for(int i = 0; i < ncomb; i++ )
+  {
+    if (goodhel[i])
+      good.push_back(i); 
+  }
+  return true; 
+}
+
+void Spin0_SF::setGoodHelicities(const vector<int> & good) 
+{
+  setHelicityWarmUp(0); 
+  for(unsigned int i = 0; i < good.size(); i++ )
+  {
+    if (good[i] >= 0 && good[i] < ncomb && !goodhel[good[i]])
+    {
+      goodhel[good[i]] = true; 
+      igood[ngood] = good[i]; 
+      ngood++; 
+    }
+  }
+}
+
 //--------------------------------------------------------------------------
 // Evaluate |M|^2, part independent of incoming flavour.
 
@@ -74,11 +128,7 @@ void Spin0_SF::sigmaKin()
     jamp2[0][i] = 0.; 
 
   // Local variables and constants
-  const int ncomb = 16; 
-  static bool goodhel[ncomb] = {ncomb * false}; 
   //static int ntry = 0, sum_hel = 0, ngood = 0;	// picked out by Ghost remover v. 0.1 
-  static int igood[ncomb]; 
-  static int jhel; 
 //  std::complex<double> * * wfs;
   double t[nprocesses]; 
   // Helicities for the process
@@ -109,7 +159,7 @@ void Spin0_SF::sigmaKin()
     // Calculate the matrix element for all helicities
     for(int ihel = 0; ihel < ncomb; ihel++ )
     {
-      if (goodhel[ihel] || ntry < 2)
+      if (goodhel[ihel] || nwarmup < 0 || ntry <= nwarmup)
       {
         calculate_wavefunctions(perm, helicities[ihel]); 
         t[0] = matrix_h_mummupmummup(); 
@@ -124,8 +174,8 @@ void Spin0_SF::sigmaKin()
         if (tsum != 0. && !goodhel[ihel])
         {
           goodhel[ihel] = true; 
-          ngood++; 
           igood[ngood] = ihel; 
+          ngood++; 
         }
       }
     }
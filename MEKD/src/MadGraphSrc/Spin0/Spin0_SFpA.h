@@ -33,6 +33,13 @@ class Spin0_SFpA
 	
 	// Update process.
 	virtual void updateProc(SLHAReader_MEKD &slha);
+	virtual void updateProc(Parameters_MEKD *parameters);
+
+	// Helicity filtering. A negative number of warm-up calls sums over all helicities always
+	void setHelicityWarmUp(int n);
+	bool getGoodHelicities(vector<int> & good) const;	// false until the warm-up is done
+	void setGoodHelicities(const vector<int> & good);	// skips the warm-up
+	string className() const {return "Spin0_SFpA";}
 
     // Calculate flavour-independent parts of cross section.
     virtual void sigmaKin(); 
@@ -70,6 +77,9 @@ class Spin0_SFpA
     static const int namplitudes = 16; 
     std::complex<double> amp[namplitudes];
 	int ntry, sum_hel, ngood;	// moved here by Ghost remover v. 0.1 
+	static const int ncomb = 32;
+	bool goodhel[ncomb];	// helicity filtering state, moved here from sigmaKin
+	int igood[ncomb], jhel, nwarmup;
     double matrix_h_mummupmummupa(); 
 
     // Store the matrix element value from sigmaKin
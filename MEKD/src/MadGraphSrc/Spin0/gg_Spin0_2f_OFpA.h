@@ -34,6 +34,13 @@ class gg_Spin0_2f_OFpA
 	
 	// Update process.
 	virtual void updateProc(SLHAReader_MEKD &slha);
+	virtual void updateProc(Parameters_MEKD *parameters);
+
+	// Helicity filtering. A negative number of warm-up calls sums over all helicities always
+	void setHelicityWarmUp(int n);
+	bool getGoodHelicities(vector<int> & good) const;	// false until the warm-up is done
+	void setGoodHelicities(const vector<int> & good);	// skips the warm-up
+	string className() const {return "gg_Spin0_2f_OFpA";}
 
     // Calculate flavour-independent parts of cross section.
     virtual void sigmaKin();
@@ -71,6 +78,9 @@ class gg_Spin0_2f_OFpA
     static const int namplitudes = 96;
     std::complex<double> amp[namplitudes];
 	int ntry, sum_hel, ngood;	// Moved here by Convert_source 0.2 
+	static const int ncomb = 128;
+	bool goodhel[ncomb];	// helicity filtering state, moved here from sigmaKin
+	int igood[ncomb], jhel, nwarmup;
     double matrix_gg_h_emepmummupa_no_zpxg();
 
     // Store the matrix element value from sigmaKin
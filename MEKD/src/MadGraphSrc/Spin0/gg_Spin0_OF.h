@@ -13,6 +13,9 @@
 
 #include "../Parameters_MEKD.h"
 #include "../read_slha.h"
+#ifdef MEKD_HELAMPS_BATCH
+#include "../HelAmps_Batch.h"
+#endif
 
 using namespace std; 
 
@@ -26,13 +29,28 @@ class gg_Spin0_OF
   public:
 
     // Constructor.
+#ifdef MEKD_HELAMPS_BATCH
+    gg_Spin0_OF() : use_batches(true) {}
+#else
     gg_Spin0_OF() {}
+#endif
 
     // Initialize process.
     virtual void initProc(string param_card_name);
 	
 	// Update process.
 	virtual void updateProc(SLHAReader_MEKD &slha);
+	virtual void updateProc(Parameters_MEKD *parameters);
+
+	// Helicity filtering. A negative number of warm-up calls sums over all helicities always
+	void setHelicityWarmUp(int n);
+	bool getGoodHelicities(vector<int> & good) const;	// false until the warm-up is done
+	void setGoodHelicities(const vector<int> & good);	// skips the warm-up
+	string className() const {return "gg_Spin0_OF";}
+#ifdef MEKD_HELAMPS_BATCH
+	// Helicities are summed MEKD_HELAMPS_BATCH_SIZE at a time unless switched off
+	void setHelicityBatches(bool flag) {use_batches = flag;}
+#endif
 
     // Calculate flavour-independent parts of cross section.
     virtual void sigmaKin(); 
@@ -70,7 +88,19 @@ class gg_Spin0_OF
     static const int namplitudes = 4; 
     std::complex<double> amp[namplitudes];
 	int ntry, sum_hel, ngood;	// moved here by Ghost remover v. 0.1 
+	static const int ncomb = 64;
+	bool goodhel[ncomb];	// helicity filtering state, moved here from sigmaKin
+	int igood[ncomb], jhel, nwarmup;
     double matrix_gg_h_emepmummup_no_zpxg(); 
+#ifdef MEKD_HELAMPS_BATCH
+    // The same for the helicities ihel_first, ihel_first+1,... in the lanes of a batch
+    void calculate_wavefunctions_batch(const int perm[], const int
+        helicities[][nexternal], int ihel_first);
+    MEKD_Batch_Complex w_batch[nwavefuncs][18];
+    MEKD_Batch_Complex amp_batch[namplitudes];
+    void matrix_gg_h_emepmummup_no_zpxg_batch(const bool summed[], double matrix[]);
+    bool use_batches;
+#endif
 
     // Store the matrix element value from sigmaKin
     double matrix_element[nprocesses]; 
@@ -24,7 +24,7 @@ void gg_Spin0_SF::initProc(string param_card_name)
   SLHAReader_MEKD slha(param_card_name); 
   pars->setIndependentParameters(slha); 
   pars->setIndependentCouplings();
-	ntry = 0, sum_hel = 0, ngood = 0;	// moved here by Ghost remover v. 0.1 
+	setHelicityWarmUp(-1);	// sum over all helicities unless a warm-up is requested
   // Set external particle masses for this matrix element
   mME.push_back(pars->ZERO); 
   mME.push_back(pars->ZERO); 
@@ -42,7 +42,6 @@ void gg_Spin0_SF::updateProc(SLHAReader_MEKD &slha)
 {
   pars->setIndependentParameters(slha); 
   pars->setIndependentCouplings();
-	ntry = 0, sum_hel = 0, ngood = 0;	// moved here by Ghost remover v. 0.1 
   
   // Set external particle masses for this matrix element
   mME[0]=(pars->ZERO);
@@ -53,6 +52,62 @@ void gg_Spin0_SF::updateProc(SLHAReader_MEKD &slha)
   mME[5]=(pars->MM);
 }
 
+//--------------------------------------------------------------------------
+// Update process with a precomputed set of parameters.
+
+void gg_Spin0_SF::updateProc(Parameters_MEKD *parameters)
+{
+  pars = parameters;
+  
+  // Set external particle masses for this matrix element
+  mME[0]=(pars->ZERO);
+  mME[1]=(pars->ZERO);
+  mME[2]=(pars->MM);
+  mME[3]=(pars->MM);
+  mME[4]=(pars->MM);
+  mME[5]=(pars->MM);
+}
+
+//--------------------------------------------------------------------------
+// Helicity filtering: the first n calls of sigmaKin sum over all helicities
+// and record the non-vanishing ones, later calls only use these.
+
+void gg_Spin0_SF::setHelicityWarmUp(int n) 
+{
+  nwarmup = n; 
+  ntry = 0, sum_hel = 0, ngood = 0; 
+  jhel = 0; 
+  for(int i = 0; i < ncomb; i++ )
+    goodhel[i] = false; 
+}
+
+bool gg_Spin0_SF::getGoodHelicities(vector<int> & good) const
+{
+  good.clear(); 
+  if (nwarmup < 0 || ntry < nwarmup)
+    return false; 
+  for(int i = 0; i < ncomb; i++ )
+  {
+    if (goodhel[i])
+      good.push_back(i); 
+  }
+  return true; 
+}
+
+void gg_Spin0_SF::setGoodHelicities(const vector<int> & good) 
+{
+  setHelicityWarmUp(0); 
+  for(unsigned int i = 0; i < good.size(); i++ )
+  {
+    if (good[i] >= 0 && good[i] < ncomb && !goodhel[good[i]])
+    {
+      goodhel[good[i]] = true; 
+      igood[ngood] = good[i]; 
+      ngood++; 
+    }
+  }
+}
+
 //--------------------------------------------------------------------------
 // Evaluate |M|^2, part independent of incoming flavour.
 
@@ -67,11 +122,7 @@ void gg_Spin0_SF::sigmaKin()
     jamp2[0][i] = 0.; 
 
   // Local variables and constants
-  const int ncomb = 64; 
-  static bool goodhel[ncomb] = {ncomb * false}; 
   //static int ntry = 0, sum_hel = 0, ngood = 0;	// picked out by Ghost remover v. 0.1 
-  static int igood[ncomb]; 
-  static int jhel; 
 //   std::complex<double> * * wfs; 
   double t[nprocesses]; 
   // Helicities for the process
@@ -115,10 +166,52 @@ void gg_Spin0_SF::sigmaKin()
 
   if (sum_hel == 0 || ntry < 10)
   {
+#ifdef MEKD_HELAMPS_BATCH
+    if (use_batches)
+    {
+      // Calculate the matrix element for MEKD_HELAMPS_BATCH_SIZE helicities at
+      // a time, those not in use are computed but not summed
+      for(int ihel_first = 0; ihel_first < ncomb; ihel_first +=
+          MEKD_HELAMPS_BATCH_SIZE)
+      {
+        bool summed[MEKD_HELAMPS_BATCH_SIZE]; 
+        double t_batch[nprocesses][MEKD_HELAMPS_BATCH_SIZE]; 
+        for(int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+        {
+          int ihel = ihel_first + lane; 
+          summed[lane] = (ihel < ncomb && (goodhel[ihel] || nwarmup < 0 ||
+              ntry <= nwarmup));
+        }
+        calculate_wavefunctions_batch(perm, helicities, ihel_first); 
+        matrix_gg_h_mummupmummup_no_zpxg_batch(summed, t_batch[0]); 
+
+        for(int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+        {
+          if (!summed[lane])
+            continue; 
+          int ihel = ihel_first + lane; 
+          double tsum = 0; 
+          for(int iproc = 0; iproc < nprocesses; iproc++ )
+          {
+            matrix_element[iproc] += t_batch[iproc][lane]; 
+            tsum += t_batch[iproc][lane]; 
+          }
+          // Store which helicities give non-zero result
+          if (tsum != 0. && !goodhel[ihel])
+          {
+            goodhel[ihel] = true; 
+            igood[ngood] = ihel; 
+            ngood++; 
+          }
+        }
+      }
+    }
+    else
+#endif
     // Calculate the matrix element for all helicities
     for(int ihel = 0; ihel < ncomb; ihel++ )
     {
-      if (goodhel[ihel] || ntry < 2)
+      if (goodhel[ihel] || nwarmup < 0 || ntry <= nwarmup)
       {
         calculate_wavefunctions(perm, helicities[ihel]); 
         t[0] = matrix_gg_h_mummupmummup_no_zpxg(); 
@@ -133,8 +226,8 @@ void gg_Spin0_SF::sigmaKin()
         if (tsum != 0. && !goodhel[ihel])
         {
           goodhel[ihel] = true; 
-          ngood++; 
           igood[ngood] = ihel; 
+          ngood++; 
         }
       }
     }
@@ -258,6 +351,102 @@ double gg_Spin0_SF::matrix_gg_h_mummupmummup_no_zpxg()
 
   return matrix; 
 }
+#ifdef MEKD_HELAMPS_BATCH
+//--------------------------------------------------------------------------
+// Batched versions of calculate_wavefunctions and the matrix element. Lanes
+// past the last helicity repeat it.
+
+void gg_Spin0_SF::calculate_wavefunctions_batch(const int perm[], const int
+    helicities[][nexternal], int ihel_first)
+{
+  double * p_lanes[nexternal][MEKD_HELAMPS_BATCH_SIZE]; 
+  int hel_lanes[nexternal][MEKD_HELAMPS_BATCH_SIZE]; 
+  for(int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    int ihel = min(ihel_first + lane, ncomb - 1); 
+    for(int i = 0; i < nexternal; i++ )
+    {
+      p_lanes[i][lane] = p[perm[i]]; 
+      hel_lanes[i][lane] = helicities[ihel][i]; 
+    }
+  }
+
+  // Calculate all wavefunctions
+  vxxxxx(p_lanes[0], mME[0], hel_lanes[0], -1, w_batch[0]); 
+  vxxxxx(p_lanes[1], mME[1], hel_lanes[1], -1, w_batch[1]); 
+  oxxxxx(p_lanes[2], mME[2], hel_lanes[2], +1, w_batch[2]); 
+  ixxxxx(p_lanes[3], mME[3], hel_lanes[3], -1, w_batch[3]); 
+  oxxxxx(p_lanes[4], mME[4], hel_lanes[4], +1, w_batch[4]); 
+  ixxxxx(p_lanes[5], mME[5], hel_lanes[5], -1, w_batch[5]); 
+  VVS3_4_5_3(w_batch[0], w_batch[1], pars->HEF_MEKD_GC_13, pars->HEF_MEKD_GC_15,
+      pars->HEF_MEKD_GC_19, pars->MH, pars->WH, w_batch[6]);
+  FFV5_7_3(w_batch[3], w_batch[2], pars->HEF_MEKD_GC_161, pars->HEF_MEKD_GC_168,
+      pars->MZ, pars->WZ, w_batch[7]);
+  FFV5_7_3(w_batch[5], w_batch[4], pars->HEF_MEKD_GC_161, pars->HEF_MEKD_GC_168,
+      pars->MZ, pars->WZ, w_batch[8]);
+  VVS1_3(w_batch[0], w_batch[1], pars->HEF_MEKD_GC_23, pars->MH, pars->WH,
+      w_batch[9]);
+  FFV5_7_3(w_batch[5], w_batch[2], pars->HEF_MEKD_GC_161, pars->HEF_MEKD_GC_168,
+      pars->MZ, pars->WZ, w_batch[10]);
+  FFV5_7_3(w_batch[3], w_batch[4], pars->HEF_MEKD_GC_161, pars->HEF_MEKD_GC_168,
+      pars->MZ, pars->WZ, w_batch[11]);
+
+  // Calculate all amplitudes
+  // Amplitude(s) for diagram number 0
+  VVS3_4_5_0(w_batch[7], w_batch[8], w_batch[6], pars->HEF_MEKD_GC_14,
+      pars->HEF_MEKD_GC_18, pars->HEF_MEKD_GC_22, amp_batch[0]);
+  VVS2_0(w_batch[7], w_batch[8], w_batch[6], pars->HEF_MEKD_GC_25, amp_batch[1]); 
+  VVS3_4_5_0(w_batch[7], w_batch[8], w_batch[9], pars->HEF_MEKD_GC_14,
+      pars->HEF_MEKD_GC_18, pars->HEF_MEKD_GC_22, amp_batch[2]);
+  VVS2_0(w_batch[7], w_batch[8], w_batch[9], pars->HEF_MEKD_GC_25, amp_batch[3]); 
+  VVS3_4_5_0(w_batch[10], w_batch[11], w_batch[6], pars->HEF_MEKD_GC_14,
+      pars->HEF_MEKD_GC_18, pars->HEF_MEKD_GC_22, amp_batch[4]);
+  VVS2_0(w_batch[10], w_batch[11], w_batch[6], pars->HEF_MEKD_GC_25, amp_batch[5]); 
+  VVS3_4_5_0(w_batch[10], w_batch[11], w_batch[9], pars->HEF_MEKD_GC_14,
+      pars->HEF_MEKD_GC_18, pars->HEF_MEKD_GC_22, amp_batch[6]);
+  VVS2_0(w_batch[10], w_batch[11], w_batch[9], pars->HEF_MEKD_GC_25, amp_batch[7]); 
+}
+
+void gg_Spin0_SF::matrix_gg_h_mummupmummup_no_zpxg_batch(const bool summed[], double
+    matrix[])
+{
+  int i, j; 
+  // Local variables
+  const int ncolor = 1; 
+  std::complex<double> ztemp, jamp_lane[ncolor]; 
+  MEKD_Batch_Complex jamp[ncolor]; 
+  // The color matrix;
+  static const double denom[ncolor] = {1}; 
+  static const double cf[ncolor][ncolor] = {{2}}; 
+
+  // Calculate color flows
+  jamp[0] = +2. * (+amp_batch[0] + amp_batch[1] + amp_batch[2] + amp_batch[3] -
+      amp_batch[4] - amp_batch[5] - amp_batch[6] - amp_batch[7]);
+
+  // Sum and square the color flows lane by lane
+  for(int lane = 0; lane < MEKD_HELAMPS_BATCH_SIZE; lane++ )
+  {
+    for(i = 0; i < ncolor; i++ )
+      jamp_lane[i] = jamp[i].lane(lane); 
+    matrix[lane] = 0; 
+    for(i = 0; i < ncolor; i++ )
+    {
+      ztemp = 0.; 
+      for(j = 0; j < ncolor; j++ )
+        ztemp = ztemp + cf[i][j] * jamp_lane[j]; 
+      matrix[lane] = matrix[lane] + real(ztemp * conj(jamp_lane[i]))/denom[i]; 
+    }
+
+    // Store the leading color flows for choice of color
+    if (summed[lane])
+    {
+      for(i = 0; i < ncolor; i++ )
+        jamp2[0][i] += real(jamp_lane[i] * conj(jamp_lane[i])); 
+    }
+  }
+}
+#endif
+
 
 
 
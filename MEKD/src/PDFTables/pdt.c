@@ -41,11 +41,53 @@ static int  leftX(int dim, double * xa, double x)
 }
 
 
+/* Equal cells over the grid, each one pointing to the last grid point
+   at or below its lower edge. binX then gives the same answer as leftX
+   after a step or two instead of a bisection */
+static void makeBins(int dim, double * xa, pdtBins * b)
+{  int c,k;
+   double step=xa[dim-1]-xa[0];
+
+   b->n=0;
+   b->left=NULL;
+   for(k=1;k<dim;k++) if(xa[k]-xa[k-1]<step) step=xa[k]-xa[k-1];
+   if(!(step>0) || !isfinite(xa[0]) || !isfinite(xa[dim-1])) return;
+
+   b->n=(int)((xa[dim-1]-xa[0])/step)+1;
+   if(b->n>16*dim) b->n=16*dim;
+   b->lo=xa[0];
+   b->scale=b->n/(xa[dim-1]-xa[0]);
+   b->left=(int*)malloc(b->n*sizeof(int));
+
+   for(c=0,k=0;c<b->n;c++)
+   { double edge=b->lo+c/b->scale;
+     while(k<dim-2 && xa[k+1]<=edge) k++;
+     b->left[c]=k;
+   }
+}
+
+
+static int binX(int dim, double * xa, pdtBins * b, double x)
+{  int k;
+   double c;
+
+   if(!b->left) return leftX(dim,xa,x);
+   if(x<xa[0]) return 0;
+   if(x>xa[dim-1]) return dim-3;
+
+   c=(x-b->lo)*b->scale;
+   k= c<b->n ? b->left[(int)c] : dim-2;
+   while(k>0 && xa[k]>x) k--;
+   while(k<dim-2 && xa[k+1]<=x) k++;
+   return k;
+}
+
+
 static double int_cteq4(double x, double q, pdtStr * W)
 { 
-  int px = leftX(W->nx, W->x_grid, x);
+  int px = binX(W->nx, W->x_grid, &W->xBins, x);
   double logQ=log(q);
-  int pq=leftX(W->nq, W->q_grid, logQ);
+  int pq=binX(W->nq, W->q_grid, &W->qBins, logQ);
   double tmp[3];
   int i;
   
@@ -76,21 +118,35 @@ static double qSplineCteq6(double x,double *xa, double *ya)
   return res;
 }
 
-static double int_cteq6(double x, double q, pdtStr * W)
+/* The part of the CTEQ6 interpolation which depends only on x, q and the
+   grids, shared by all partons of one file */
+typedef struct cteq6Point
+{ double x, x3, loglogQ;
+  int px, pq, xExt, qExt;
+} cteq6Point;
+
+static void locateCteq6(double x, double q, pdtStr * W, cteq6Point * P)
+{
+  P->x=x;
+  P->x3=pow(x,0.3);
+  P->loglogQ=log(log(q/W->Q0_cteq));
+  P->pq = binX(W->nq, W->q_grid_aux, &W->qBins, P->loglogQ)-1;
+  P->px = binX(W->nx, W->x_grid_aux, &W->xBins, P->x3)-1;
+  P->qExt=0;
+  P->xExt=0;
+
+  if(P->pq<0)  { P->pq=0; P->qExt=-1;} else if(P->pq > W->nq-4) { P->pq=W->nq-4; P->qExt=1;}
+  if(P->px<=0) { P->px=0; P->xExt=-1;} else if(P->px > W->nx-4) { P->px=W->nx-4; P->xExt=1;}
+}
+
+static double evalCteq6(cteq6Point * P, pdtStr * W)
 {
-  double x3=pow(x,0.3);
-  double loglogQ=log(log(q/W->Q0_cteq));
+  double x=P->x, x3=P->x3, loglogQ=P->loglogQ;
   double * q_grid=W->q_grid_aux;
   double * x_grid=W->x_grid_aux;
-  int pq = leftX(W->nq, q_grid, loglogQ)-1;
-  int px = leftX(W->nx, W->x_grid_aux, x3)-1;
+  int pq=P->pq, px=P->px, qExt=P->qExt, xExt=P->xExt;
   int i;
-  int qExt=0;
-  int xExt=0;
   double tmp[4];
-  
-  if(pq<0)  { pq=0; qExt=-1;} else if(pq > W->nq-4) { pq=W->nq-4; qExt=1;}
-  if(px<=0) { px=0; xExt=-1;} else if(px > W->nx-4) { px=W->nx-4; xExt=1;}
 
        if(xExt==0) for(i=0;i<4;i++) 
             tmp[i]=qSplineCteq6(x3, x_grid+px, W->strfun+W->nx*(pq+i)+px);
@@ -110,6 +166,13 @@ static double int_cteq6(double x, double q, pdtStr * W)
       else return qSplineCteq6(loglogQ,q_grid+pq,tmp);
 }
 
+static double int_cteq6(double x, double q, pdtStr * W)
+{ cteq6Point P;
+
+  locateCteq6(x,q,W,&P);
+  return evalCteq6(&P,W);
+}
+
 /*} MRST2001 INTERPOLATION CODES {*/
 static int locx_(double *xx,int nx,double x)
 {
@@ -222,11 +285,20 @@ static double * jeppe1_(int nx,int my,double*xx,double*yy,double*ff)
 
 }
 
+/* locx_ through the bins of the grid */
+static int locBin_(double *xx,int nx,pdtBins *b,double x)
+{
+   if(!b->left)       return locx_(xx,nx,x);
+   if(x <= xx[0])    return 1;
+   if(x >= xx[nx-1])  return  nx - 1;
+   return binX(nx,xx,b,x)+1;
+}
+
 static double jeppe2_(double x,double y,int nx, int my,
-                   double *xx,double *yy,double *cc)
+                   double *xx,double *yy,double *cc,pdtBins *bx,pdtBins *by)
 {
-    int n = locx_(xx, nx, x);
-    int m = locx_(yy, my, y);
+    int n = locBin_(xx, nx, bx, x);
+    int m = locBin_(yy, my, by, y);
     double t = (x-xx[n-1])/(xx[n]-xx[n-1]);
     double u = (y-yy[m-1])/(yy[m]-yy[m-1]);
     double z=0;
@@ -247,24 +319,48 @@ int i=W->qt0;
 return  jeppe2_(log(x),log(q*q),W->nx, W->nq-i,
                /*  xxl  */  W->x_grid_aux    ,
                /*  qqlb */  W->q_grid_aux+i  ,
-               /*  ccb  */  W->aux        )/x;
+               /*  ccb  */  W->aux        ,
+                            &W->xBins, &W->qBins)/x;
 }
 
 /*} END OF INTEPOLATION CODE */
 
 
-double interFunc(double x, double q, pdtStr * W)
-{ 
+/* counts arguments out of the grids; 0 below the threshold */
+static int inRange(double x, double q, pdtStr * W)
+{
   if(W->q_grid)
   {  if(q<W->q_threshold) return 0; 
      if(q>W->q_max) W->nLargeQ++; else if(q<W->q_min) W->nSmallQ++;  
   }
   if(x<W->x_min)  W->nSmallX++;
+  return 1;
+}
+
+
+double interFunc(double x, double q, pdtStr * W)
+{ 
+  if(!inRange(x,q,W)) return 0;
   
   return (W->interpolation)(x,q,W); 
 }
 
 
+void interFuncs(double x, double q, int n, pdtStr ** W, double * f)
+{ cteq6Point P;
+  int i;
+  int shared= n>0 && W[0]->interpolation==&int_cteq6;
+
+  for(i=1;i<n && shared;i++) shared= W[i]->interpolation==&int_cteq6
+     && W[i]->nx==W[0]->nx && W[i]->nq==W[0]->nq && W[i]->Q0_cteq==W[0]->Q0_cteq;
+
+  if(!shared) { for(i=0;i<n;i++) f[i]=interFunc(x,q,W[i]); return; }
+
+  locateCteq6(x,q,W[0],&P);
+  for(i=0;i<n;i++) f[i]= inRange(x,q,W[i]) ? evalCteq6(&P,W[i]) : 0;
+}
+
+
 double interAlpha(double q, pdtStr * W )
 { 
   double logQ;
@@ -287,6 +383,25 @@ void freePdtData( pdtStr * data)
   if(data->q_grid_aux) {free(data->q_grid_aux);  data->q_grid_aux=NULL; }
   if(data->x_grid_aux) {free(data->x_grid_aux);  data->x_grid_aux=NULL; }
   if(data->aux)        {free(data->aux);         data->aux=NULL;        }
+  if(data->xBins.left) {free(data->xBins.left);  data->xBins.left=NULL; }
+  if(data->qBins.left) {free(data->qBins.left);  data->qBins.left=NULL; }
+}
+
+
+static void makePdtBins(pdtStr * data)
+{
+       if(data->interpolation == &int_cteq4)
+  { makeBins(data->nx, data->x_grid, &data->xBins);
+    makeBins(data->nq, data->q_grid, &data->qBins);
+  }
+  else if(data->interpolation == &int_cteq6)
+  { makeBins(data->nx, data->x_grid_aux, &data->xBins);
+    makeBins(data->nq, data->q_grid_aux, &data->qBins);
+  }
+  else if(data->interpolation == &int_mrst2001)
+  { makeBins(data->nx, data->x_grid_aux, &data->xBins);
+    makeBins(data->nq-data->qt0, data->q_grid_aux+data->qt0, &data->qBins);
+  }
 }
 
 
@@ -310,6 +425,9 @@ int getPdtData(char * file, int n_parton, pdtStr * data )
   data->alpha =NULL;
   data->strfun=NULL;
   data->strfun_aux=NULL;
+  data->q_grid_cteq=NULL;
+  data->xBins.left=NULL;
+  data->qBins.left=NULL;
   data->interpolation=&int_cteq4;
   data->q_threshold=0;
   data->mass=1;
@@ -443,6 +561,7 @@ int getPdtData(char * file, int n_parton, pdtStr * data )
     free(f_aux);
   }
 
+  makePdtBins(data);
   fclose(f); 
   return 0;
   errexit:
@@ -454,6 +573,98 @@ int getPdtData(char * file, int n_parton, pdtStr * data )
 }
 
 
+static int writeItem(FILE * f, double * a, long n)
+{ char present= a!=NULL;
+
+  if(fwrite(&present,1,1,f)!=1) return -1;
+  if(present && fwrite(a,sizeof(double),n,f)!=(size_t)n) return -1;
+  return 0;
+}
+
+
+static int readItem(FILE * f, double ** a, long n)
+{ char present;
+
+  if(fread(&present,1,1,f)!=1) return -1;
+  if(!present) return 0;
+  *a=malloc(n*sizeof(double));
+  if(fread(*a,sizeof(double),n,f)!=(size_t)n) return -1;
+  return 0;
+}
+
+
+/* The structure itself is copied as it is, so the binary copy is only
+   valid for the same build; it starts with sizeof(pdtStr) to check it */
+int writePdtData(FILE * f, pdtStr * data)
+{ int size=sizeof(pdtStr);
+  int kind= data->interpolation==&int_cteq6 ? 6 :
+            data->interpolation==&int_mrst2001 ? 2001 : 4;
+  long nx=data->nx, nq=data->nq;
+
+  if(fwrite(&size,sizeof(int),1,f)!=1) return -1;
+  if(fwrite(&kind,sizeof(int),1,f)!=1) return -1;
+  if(fwrite(data,sizeof(pdtStr),1,f)!=1) return -1;
+
+  if(writeItem(f,data->x_grid,nx))              return -1;
+  if(writeItem(f,data->q_grid,nq))              return -1;
+  if(writeItem(f,data->alpha,nq))               return -1;
+  if(writeItem(f,data->strfun,nx*nq))           return -1;
+  if(writeItem(f,data->x_grid_aux,nx))          return -1;
+  if(writeItem(f,data->q_grid_aux,nq))          return -1;
+  if(writeItem(f,data->aux,16*nx*(nq-data->qt0))) return -1;
+  return 0;
+}
+
+
+int readPdtData(FILE * f, pdtStr * data)
+{ int size,kind;
+  long nx,nq;
+
+  if(fread(&size,sizeof(int),1,f)!=1 || size!=sizeof(pdtStr)) return -1;
+  if(fread(&kind,sizeof(int),1,f)!=1) return -1;
+  if(fread(data,sizeof(pdtStr),1,f)!=1) return -1;
+
+  data->x_grid=NULL;
+  data->q_grid=NULL;
+  data->x_grid_aux=NULL;
+  data->q_grid_aux=NULL;
+  data->aux=NULL;
+  data->alpha =NULL;
+  data->strfun=NULL;
+  data->strfun_aux=NULL;
+  data->q_grid_cteq=NULL;
+  data->xBins.left=NULL;
+  data->qBins.left=NULL;
+       if(kind==6)    data->interpolation=&int_cteq6;
+  else if(kind==2001) data->interpolation=&int_mrst2001;
+  else                data->interpolation=&int_cteq4;
+
+  nx=data->nx;
+  nq=data->nq;
+  if(nx<3 || nq<3 || nx>100000 || nq>100000 || data->qt0<0 || data->qt0>=nq)
+     return -1;
+
+  if(readItem(f,&data->x_grid,nx)
+  || readItem(f,&data->q_grid,nq)
+  || readItem(f,&data->alpha,nq)
+  || readItem(f,&data->strfun,nx*nq)
+  || readItem(f,&data->x_grid_aux,nx)
+  || readItem(f,&data->q_grid_aux,nq)
+  || readItem(f,&data->aux,16*nx*(nq-data->qt0))
+  || !data->strfun)
+  { freePdtData(data);
+    return -1;
+  }
+
+  data->nSmallX=0;
+  data->nSmallQ=0;
+  data->nLargeQ=0;
+  data->nLargeX=0;
+  makePdtBins(data);
+  return 0;
+}
+
+
 void delPdtList(pdtList * list)
 { 
   while(list)
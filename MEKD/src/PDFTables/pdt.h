@@ -19,6 +19,14 @@ typedef struct pdtList
   int  * items;
 } pdtList; 
 
+typedef struct pdtBins
+{ int  n;          /* number of equal cells covering the grid */
+  double lo;       /* first grid point                        */
+  double scale;    /* cells per unit of the grid variable     */
+  int  * left;     /* last grid point at or below each cell,  */
+                   /* the bin search then takes O(1) steps    */
+} pdtBins;
+
 typedef struct pdtStr
 { double mass;       /* mass of composite particle             */
   long beamP;
@@ -53,6 +61,8 @@ typedef struct pdtStr
   
   int    qt0;        /* position of first q point above threshold*/
   int  approx;
+  pdtBins xBins;     /* bins of the X- and Q-grids used by the */
+  pdtBins qBins;     /* interpolation                          */
 } pdtStr;  
 
 
@@ -67,6 +77,12 @@ extern void   delPdtList(pdtList * list);
 extern int    getPdtData(char * file, int n_parton, pdtStr * data );
                      /* read 'file' and  fill items of  'data' */ 
 
+extern int    writePdtData(FILE * f, pdtStr * data);
+extern int    readPdtData(FILE * f, pdtStr * data);
+                     /* binary copy of the items of 'data', so */
+                     /* that tables are not parsed again. 0 is */
+                     /* returned on success                    */
+
 extern void   freePdtData( pdtStr * data);
                     /* free  memory allocated for data items   */
                     /* and assigne NULL to  them.              */
@@ -76,6 +92,10 @@ extern double interFunc(double x, double q, pdtStr * W);
                      /* according to information stored in W.  */
                      /* result should be multiplied by the     */  
                      /* power factors later on                 */
+extern void   interFuncs(double x, double q, int n, pdtStr ** W, double * f);
+                     /* f[i]=interFunc(x,q,W[i]) for n tables  */
+                     /* of one file; x and q dependent parts   */
+                     /* are evaluated once for all of them     */
 extern double interAlpha(double q, pdtStr * W );
                      /* interpolates data for QCD-alpha(Q)     */
                      
@@ -9,12 +9,14 @@
 #define MEKD_TEST_CPP
 
 #include "MEKD_Test.h"
+#include "MEKD_Test_Benchmark.cpp"
 #include "MEKD_Test_Check_Models.cpp"
 #include "MEKD_Test_Consistency.cpp"
 #include "MEKD_Test_Debug_Ghosts.cpp"
 #include "MEKD_Test_Functionality.cpp"
 #include "MEKD_Test_Gen.cpp"
 #include "MEKD_Test_Gen_Interference.cpp"
+#include "MEKD_Test_HelAmps_Batch.cpp"
 
 
 void Initialize_tester();
@@ -131,6 +133,35 @@ int main()
 	else cout << "TEST 2: FAILED\n";
 	
 	
+	if( Show_Description )
+	{
+		cout << "\n ------------------------------------------- \n";
+		cout << " -- Timing ME calculations for the models -- \n";
+		cout << " ------------------------------------------- \n";
+	}
+	
+	error_value = MEKD_Test_Benchmark_Test1();
+	if( error_value == 0 ) cout << "TEST 1: PASSED\n";
+	else cout << "TEST 1: FAILED\n";
+	
+	
+#ifdef MEKD_HELAMPS_BATCH
+	if( Show_Description )
+	{
+		cout << "\n ------------------------------------------------------- \n";
+		cout << " -- Testing batched HelAmps against single evaluations -- \n";
+		cout << " ------------------------------------------------------- \n";
+	}
+	
+	error_value = MEKD_Test_HelAmps_Batch_Test1();
+	if( error_value == 0 ) cout << "TEST 1: PASSED\n";
+	else cout << "TEST 1: FAILED\n";
+	error_value = MEKD_Test_HelAmps_Batch_Test2();
+	if( error_value == 0 ) cout << "TEST 2: PASSED\n";
+	else cout << "TEST 2: FAILED\n";
+#endif
+	
+	
 	return 0;
 }
 
@@ -0,0 +1,93 @@
+#ifndef MEKD_TEST_BENCHMARK_CPP
+#define MEKD_TEST_BENCHMARK_CPP
+
+#include "MEKD_Test.h"
+#include <ctime>
+#include <iomanip>
+
+
+//////////////////////////////
+/// TEST Block "Benchmarks"
+//////////////////////////////
+
+
+
+/// Timing of computeMEs(...) with the eight default models, compared to computing the same models one by one.
+int MEKD_Test_Benchmark_Test1()
+{
+	/// TEST 1
+	if( Show_Description ) cout << "\n -- STARTING TEST 1 -- \n";
+	MEKD test1(8.0, "");
+	
+	
+	const unsigned int benchmark_loops = 1000;
+	
+	double ME_bkg, ME_sig, KD_value, ME_value;
+	clock_t time_start;
+	double time_MEs, time_ME;
+	
+	vector<string> models_to_test;
+	vector<double> MEs_from_computeMEs;
+	
+	
+	/// Same models as the ones filled in by computeMEs(...), ZZ being the first one
+	models_to_test.push_back( "ZZ" );
+	models_to_test.push_back( "ggSpin0Pm" );
+	models_to_test.push_back( "ggSpin0M" );
+	models_to_test.push_back( "ggSpin0Ph" );
+	models_to_test.push_back( "qqSpin1P" );
+	models_to_test.push_back( "qqSpin1M" );
+	models_to_test.push_back( "ggSpin2Pm" );
+	models_to_test.push_back( "qqSpin2Pm" );
+	
+	
+	/// RUNING CALCULATIONS BELOW
+	time_start = clock();
+	for( unsigned int count_loop=0; count_loop<benchmark_loops; count_loop++ )
+	{
+		if( (error_value=test1.computeMEs( Set_Of_Arrays, Set_Of_IDs )) != 0 ) { cout << "ERROR CODE in computeMEs: " << error_value << endl; return 1; }
+	}
+	time_MEs = double( clock()-time_start )/CLOCKS_PER_SEC;
+	
+	MEs_from_computeMEs.push_back( 0 );
+	for( unsigned int count_model=1; count_model<models_to_test.size(); count_model++ )
+	{
+		if( (error_value=test1.computeKD( models_to_test[count_model], "ZZ", KD_value, ME_sig, ME_bkg )) != 0 ) { cout << "ERROR CODE in KD for " << models_to_test[count_model] << ": " << error_value << endl; return 1; }
+		MEs_from_computeMEs[0] = ME_bkg;
+		MEs_from_computeMEs.push_back( ME_sig );
+	}
+	
+	time_start = clock();
+	for( unsigned int count_loop=0; count_loop<benchmark_loops; count_loop++ )
+	{
+		for( unsigned int count_model=0; count_model<models_to_test.size(); count_model++ )
+		{
+			if( (error_value=test1.computeME( models_to_test[count_model], Set_Of_Arrays, Set_Of_IDs, ME_value )) != 0 ) { cout << "ERROR CODE in ME for " << models_to_test[count_model] << ": " << error_value << endl; return 1; }
+		}
+	}
+	time_ME = double( clock()-time_start )/CLOCKS_PER_SEC;
+	
+	
+	if( Show_Basic_Data )
+	{
+		cout << "Timing per event, averaged over " << benchmark_loops << " events\n";
+		cout << setw(30) << left << "computeMEs(...)" << ": " << time_MEs/benchmark_loops*1E6 << " us\n";
+		cout << setw(30) << left << "computeME(...) x8" << ": " << time_ME/benchmark_loops*1E6 << " us\n";
+	}
+	
+	
+	/// The MEs from both approaches have to agree
+	for( unsigned int count_model=0; count_model<models_to_test.size(); count_model++ )
+	{
+		if( (error_value=test1.computeME( models_to_test[count_model], Set_Of_Arrays, Set_Of_IDs, ME_value )) != 0 ) return 1;
+		if( Show_Basic_Data ) cout << setw(30) << left << "Result for " << setw(15) << left << models_to_test[count_model] << ": " << ME_value << " " << MEs_from_computeMEs[count_model] << endl;
+		if( fabs( ME_value-MEs_from_computeMEs[count_model] ) > Precision_of_interest*fabs( ME_value ) ) return 1;
+	}
+	
+	
+	return 0;
+}
+
+
+
+#endif
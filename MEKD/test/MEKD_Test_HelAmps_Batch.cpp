@@ -0,0 +1,291 @@
+#ifndef MEKD_TEST_HELAMPS_BATCH_CPP
+#define MEKD_TEST_HELAMPS_BATCH_CPP
+
+#include "MEKD_Test.h"
+
+#ifdef MEKD_HELAMPS_BATCH
+#include "HelAmps_HEF_MEKD.h"
+#include "HelAmps_HEF_MEKD2_1.h"
+#include "HelAmps_HEF_UFO_bkg.h"
+#include "HelAmps_HZZ_Unitary_bkgpA.h"
+#include "Spin0/gg_Spin0_OF.h"
+#include "Spin0/gg_Spin0_SF.h"
+#include <ctime>
+#include <iomanip>
+
+
+//////////////////////////////
+/// TEST Block "HelAmps batches"
+//////////////////////////////
+
+
+
+/// Only batches and single events are compared, so that any couplings and widths do
+const complex<double> Batch_test_c1( 0.1, 0.3 ), Batch_test_c2( -0.2, 0.05 ), Batch_test_c3( 0.07, -0.4 );
+const double Batch_test_MZ = 91.1876, Batch_test_WZ = 2.4952, Batch_test_MX = 125.6, Batch_test_WX = 0.00415;
+
+
+
+/// Diagrams taken from gg_Spin0_OF, gg_Spin2_OF, qq_DY_DN_2l, qq_ZZ_DN_OF and qq_Z4l_BKG_DN_OFpA. The same code runs
+/// on single events (P = double*, H = int) and on batches (P = double**, H = int*, C = MEKD_Batch_Complex).
+template<class C, class P, class H> void MEKD_Test_HelAmps_Batch_Diagrams(P p[], H hel[], C w[][18], C amp[])
+{
+	const complex<double> c1=Batch_test_c1, c2=Batch_test_c2, c3=Batch_test_c3;
+
+	/// gg -> X -> ZZ -> 2e2mu
+	MG5_HEF_MEKD::vxxxxx( p[0], 0., hel[0], -1, w[0] );
+	MG5_HEF_MEKD::vxxxxx( p[1], 0., hel[1], -1, w[1] );
+	MG5_HEF_MEKD::oxxxxx( p[2], m_e, hel[2], +1, w[2] );
+	MG5_HEF_MEKD::ixxxxx( p[3], m_e, hel[3], -1, w[3] );
+	MG5_HEF_MEKD::oxxxxx( p[4], m_mu, hel[4], +1, w[4] );
+	MG5_HEF_MEKD::ixxxxx( p[5], m_mu, hel[5], -1, w[5] );
+	MG5_HEF_MEKD::VVS3_4_5_3( w[0], w[1], c1, c2, c3, Batch_test_MX, Batch_test_WX, w[6] );
+	MG5_HEF_MEKD::FFV5_7_3( w[3], w[2], c1, c2, Batch_test_MZ, Batch_test_WZ, w[7] );
+	MG5_HEF_MEKD::FFV5_7_3( w[5], w[4], c1, c2, Batch_test_MZ, Batch_test_WZ, w[8] );
+	MG5_HEF_MEKD::VVT8_3( w[0], w[1], c3, Batch_test_MX, Batch_test_WX, w[9] );
+	MG5_HEF_MEKD::VVT1_10_11_12_13_3_5_7_8_9_3( w[0], w[1], c1, c2, c3, c1, c2, c3, c1, c2, c3, c1, Batch_test_MX, Batch_test_WX, w[10] );
+	MG5_HEF_MEKD::VVS3_4_5_0( w[7], w[8], w[6], c3, c2, c1, amp[0] );
+	MG5_HEF_MEKD::VVS2_0( w[7], w[8], w[6], c2, amp[1] );
+	MG5_HEF_MEKD::VVT10_11_12_13_2_3_6_7_8_9_0( w[7], w[8], w[9], c3, c2, c1, c3, c2, c1, c3, c2, c1, c3, amp[2] );
+	MG5_HEF_MEKD::VVT10_11_12_13_2_3_6_7_8_9_0( w[7], w[8], w[10], c3, c2, c1, c3, c2, c1, c3, c2, c1, c3, amp[3] );
+
+	/// qq -> Z/A -> 2e
+	MG5_HEF_MEKD2_1::ixxxxx( p[0], 0., hel[0], +1, w[11] );
+	MG5_HEF_MEKD2_1::oxxxxx( p[1], 0., hel[1], -1, w[12] );
+	MG5_HEF_MEKD2_1::oxxxxx( p[2], m_e, hel[2], +1, w[13] );
+	MG5_HEF_MEKD2_1::ixxxxx( p[3], m_e, hel[3], -1, w[14] );
+	MG5_HEF_MEKD2_1::FFV2P0_3( w[11], w[12], c1, 0., 0., w[15] );
+	MG5_HEF_MEKD2_1::FFV5_6_3( w[11], w[12], c1, c2, Batch_test_MZ, Batch_test_WZ, w[16] );
+	MG5_HEF_MEKD2_1::FFV2_0( w[14], w[13], w[15], c3, amp[4] );
+	MG5_HEF_MEKD2_1::FFV5_7_0( w[14], w[13], w[16], c1, c3, amp[5] );
+
+	/// qq -> ZZ -> 2e2mu
+	MG5_HEF_UFO_bkg::ixxxxx( p[0], 0., hel[0], +1, w[17] );
+	MG5_HEF_UFO_bkg::oxxxxx( p[1], 0., hel[1], -1, w[18] );
+	MG5_HEF_UFO_bkg::oxxxxx( p[2], m_e, hel[2], +1, w[19] );
+	MG5_HEF_UFO_bkg::ixxxxx( p[3], m_e, hel[3], -1, w[20] );
+	MG5_HEF_UFO_bkg::oxxxxx( p[4], m_mu, hel[4], +1, w[21] );
+	MG5_HEF_UFO_bkg::ixxxxx( p[5], m_mu, hel[5], -1, w[22] );
+	MG5_HEF_UFO_bkg::FFV41_3( w[17], w[18], c1, 0., 0., w[23] );
+	MG5_HEF_UFO_bkg::FFV42_44_3( w[20], w[19], c1, c2, Batch_test_MZ, Batch_test_WZ, w[24] );
+	MG5_HEF_UFO_bkg::FFV42_44_1( w[21], w[23], c1, c2, m_mu, 0., w[25] );
+	MG5_HEF_UFO_bkg::FFV42_43_2( w[17], w[24], c1, c3, 0., 0., w[26] );
+	MG5_HEF_UFO_bkg::FFV41_0( w[22], w[25], w[24], c2, amp[6] );
+	MG5_HEF_UFO_bkg::FFV42_43_0( w[26], w[18], w[24], c1, c2, amp[7] );
+
+	/// qq -> Z/A -> 2e2mu + A
+	MG5_HZZ_Unitary_bkgpA::ixxxxx( p[0], 0., hel[0], +1, w[27] );
+	MG5_HZZ_Unitary_bkgpA::oxxxxx( p[1], 0., hel[1], -1, w[28] );
+	MG5_HZZ_Unitary_bkgpA::oxxxxx( p[2], m_e, hel[2], +1, w[29] );
+	MG5_HZZ_Unitary_bkgpA::ixxxxx( p[3], m_e, hel[3], -1, w[30] );
+	MG5_HZZ_Unitary_bkgpA::oxxxxx( p[4], m_mu, hel[4], +1, w[31] );
+	MG5_HZZ_Unitary_bkgpA::ixxxxx( p[5], m_mu, hel[5], -1, w[32] );
+	MG5_HZZ_Unitary_bkgpA::vxxxxx( p[6], 0., hel[6], +1, w[33] );
+	MG5_HZZ_Unitary_bkgpA::FFV1_3( w[27], w[28], c1, 0., 0., w[34] );
+	MG5_HZZ_Unitary_bkgpA::FFV2_4_3( w[30], w[29], c1, c2, Batch_test_MZ, Batch_test_WZ, w[35] );
+	MG5_HZZ_Unitary_bkgpA::FFV1_1( w[31], w[34], c3, m_mu, 0., w[36] );
+	MG5_HZZ_Unitary_bkgpA::FFV2_4_2( w[32], w[35], c1, c2, m_mu, 0., w[37] );
+	MG5_HZZ_Unitary_bkgpA::FFV1_0( w[37], w[36], w[33], c3, amp[8] );
+}
+
+
+
+/// Batches of helicity configurations have to reproduce the single-configuration kernels for the test event.
+/// Both are then timed over all configurations.
+int MEKD_Test_HelAmps_Batch_Test1()
+{
+	/// TEST 1
+	if( Show_Description ) cout << "\n -- STARTING TEST 1 -- \n";
+
+	const unsigned int benchmark_loops = 2000;
+	const int n_external = 7, n_wavefunctions = 38, n_amplitudes = 9;
+	const int n_configurations = 1 << n_external;	// two helicities per particle
+
+	/// Partons along the beam, carrying the energy and longitudinal momentum of the 2e2mu system
+	double E_sum = p1[0]+p2[0]+p3[0]+p4[0], pz_sum = p1[3]+p2[3]+p3[3]+p4[3];
+	double pa[4] = { (E_sum+pz_sum)/2, 0, 0, (E_sum+pz_sum)/2 };
+	double pb[4] = { (E_sum-pz_sum)/2, 0, 0, -(E_sum-pz_sum)/2 };
+	double pA[4] = { 5, 3, 0, 4 };
+	double *p[n_external] = { pa, pb, p1, p2, p3, p4, pA };
+
+	int hel[n_external];
+	complex<double> w[n_wavefunctions][18], amp[n_amplitudes];
+
+	double *p_lanes[n_external][MEKD_HELAMPS_BATCH_SIZE], **p_batch[n_external];
+	int hel_lanes[n_external][MEKD_HELAMPS_BATCH_SIZE], *hel_batch[n_external];
+	MEKD_Batch_Complex w_batch[n_wavefunctions][18], amp_batch[n_amplitudes];
+
+	for( int count_ext=0; count_ext<n_external; count_ext++ )
+	{
+		for( int lane=0; lane<MEKD_HELAMPS_BATCH_SIZE; lane++ ) p_lanes[count_ext][lane] = p[count_ext];
+		p_batch[count_ext] = p_lanes[count_ext];
+		hel_batch[count_ext] = hel_lanes[count_ext];
+	}
+
+
+	/// RUNING CALCULATIONS BELOW
+	double max_amplitude[n_amplitudes], max_difference[n_amplitudes];
+	for( int count_amp=0; count_amp<n_amplitudes; count_amp++ ) max_amplitude[count_amp] = max_difference[count_amp] = 0;
+	for( int first=0; first<n_configurations; first+=MEKD_HELAMPS_BATCH_SIZE )
+	{
+		for( int lane=0; lane<MEKD_HELAMPS_BATCH_SIZE; lane++ )
+		{
+			for( int count_ext=0; count_ext<n_external; count_ext++ )
+				hel_lanes[count_ext][lane] = ( ((first+lane)%n_configurations >> count_ext) & 1 ) ? 1 : -1;
+		}
+		MEKD_Test_HelAmps_Batch_Diagrams( p_batch, hel_batch, w_batch, amp_batch );
+
+		for( int lane=0; lane<MEKD_HELAMPS_BATCH_SIZE; lane++ )
+		{
+			for( int count_ext=0; count_ext<n_external; count_ext++ ) hel[count_ext] = hel_lanes[count_ext][lane];
+			MEKD_Test_HelAmps_Batch_Diagrams( p, hel, w, amp );
+
+			for( int count_amp=0; count_amp<n_amplitudes; count_amp++ )
+			{
+				max_amplitude[count_amp] = max( max_amplitude[count_amp], abs( amp[count_amp] ) );
+				max_difference[count_amp] = max( max_difference[count_amp], abs( amp[count_amp]-amp_batch[count_amp].lane( lane ) ) );
+			}
+		}
+	}
+
+
+	/// Same diagrams over all configurations, first one by one and then in batches
+	clock_t time_start;
+	double time_single, time_batch;
+	complex<double> amp_sum = 0;
+
+	time_start = clock();
+	for( unsigned int count_loop=0; count_loop<benchmark_loops; count_loop++ )
+	{
+		for( int configuration=0; configuration<n_configurations; configuration++ )
+		{
+			for( int count_ext=0; count_ext<n_external; count_ext++ ) hel[count_ext] = ( (configuration >> count_ext) & 1 ) ? 1 : -1;
+			MEKD_Test_HelAmps_Batch_Diagrams( p, hel, w, amp );
+			amp_sum += amp[0];
+		}
+	}
+	time_single = double( clock()-time_start )/CLOCKS_PER_SEC;
+
+	time_start = clock();
+	for( unsigned int count_loop=0; count_loop<benchmark_loops; count_loop++ )
+	{
+		for( int first=0; first<n_configurations; first+=MEKD_HELAMPS_BATCH_SIZE )
+		{
+			for( int lane=0; lane<MEKD_HELAMPS_BATCH_SIZE; lane++ )
+			{
+				for( int count_ext=0; count_ext<n_external; count_ext++ )
+					hel_lanes[count_ext][lane] = ( ((first+lane)%n_configurations >> count_ext) & 1 ) ? 1 : -1;
+			}
+			MEKD_Test_HelAmps_Batch_Diagrams( p_batch, hel_batch, w_batch, amp_batch );
+			amp_sum += amp_batch[0].lane( 0 );
+		}
+	}
+	time_batch = double( clock()-time_start )/CLOCKS_PER_SEC;
+
+
+	if( Show_Basic_Data ) cout << "Lanes per batch: " << MEKD_HELAMPS_BATCH_SIZE << ", helicity configurations: " << n_configurations << endl;
+	for( int count_amp=0; count_amp<n_amplitudes; count_amp++ )
+	{
+		if( Show_Basic_Data ) cout << "Amplitude " << count_amp << ", largest value: " << max_amplitude[count_amp] << ", largest difference to the batches: " << max_difference[count_amp] << endl;
+		if( max_amplitude[count_amp] == 0 || max_difference[count_amp] > Precision_of_interest*max_amplitude[count_amp] ) return 1;
+	}
+	if( Show_Basic_Data )
+	{
+		cout << "Timing per helicity configuration, averaged over " << benchmark_loops << " passes (checksum " << abs( amp_sum ) << ")\n";
+		cout << setw(30) << left << "Single configurations" << ": " << time_single/benchmark_loops/n_configurations*1E6 << " us\n";
+		cout << setw(30) << left << "Batches of configurations" << ": " << time_batch/benchmark_loops/n_configurations*1E6 << " us\n";
+	}
+
+
+	return 0;
+}
+
+
+
+/// Sums the helicities of a process, one by one and in batches, for the event given by momenta and returns both MEs.
+/// Time per event is added to time_single and time_batch.
+template<class ME_class> void MEKD_Test_HelAmps_Batch_Process(ME_class &ME, vector<double*> &momenta, unsigned int loops, double &ME_single, double &ME_batch, double &time_single, double &time_batch)
+{
+	clock_t time_start;
+	ME.setMomenta( momenta );
+	ME.setInitial( 21, 21 );
+
+	ME.setHelicityBatches( false );
+	time_start = clock();
+	for( unsigned int count_loop=0; count_loop<loops; count_loop++ )
+	{
+		ME.sigmaKin();
+		ME_single = ME.sigmaHat();
+	}
+	time_single += double( clock()-time_start )/CLOCKS_PER_SEC/loops;
+
+	ME.setHelicityBatches( true );
+	time_start = clock();
+	for( unsigned int count_loop=0; count_loop<loops; count_loop++ )
+	{
+		ME.sigmaKin();
+		ME_batch = ME.sigmaHat();
+	}
+	time_batch += double( clock()-time_start )/CLOCKS_PER_SEC/loops;
+}
+
+
+
+/// gg_Spin0_OF and gg_Spin0_SF sum their helicities in batches; the MEs of the test event have to agree with the
+/// single-configuration sum, and the timing of both is shown.
+int MEKD_Test_HelAmps_Batch_Test2()
+{
+	/// TEST 2
+	if( Show_Description ) cout << "\n -- STARTING TEST 2 -- \n";
+
+	const unsigned int benchmark_loops = 10000;
+
+	gg_Spin0_OF ME_OF;
+	gg_Spin0_SF ME_SF;
+	ME_OF.initProc( "../src/Cards/param_card.dat" );
+	ME_SF.initProc( "../src/Cards/param_card.dat" );
+
+	/// Gluons along the beam, carrying the energy and longitudinal momentum of the 4l system
+	double E_sum = p1[0]+p2[0]+p3[0]+p4[0], pz_sum = p1[3]+p2[3]+p3[3]+p4[3];
+	double pa[4] = { (E_sum+pz_sum)/2, 0, 0, (E_sum+pz_sum)/2 };
+	double pb[4] = { (E_sum-pz_sum)/2, 0, 0, -(E_sum-pz_sum)/2 };
+	vector<double*> p_4l;
+	p_4l.push_back( pa );
+	p_4l.push_back( pb );
+	p_4l.push_back( p1 );
+	p_4l.push_back( p2 );
+	p_4l.push_back( p3 );
+	p_4l.push_back( p4 );
+
+	double ME_single[2], ME_batch[2], time_single=0, time_batch=0;
+
+
+	/// RUNING CALCULATIONS BELOW
+	MEKD_Test_HelAmps_Batch_Process( ME_OF, p_4l, benchmark_loops, ME_single[0], ME_batch[0], time_single, time_batch );
+	MEKD_Test_HelAmps_Batch_Process( ME_SF, p_4l, benchmark_loops, ME_single[1], ME_batch[1], time_single, time_batch );
+
+
+	if( Show_Basic_Data )
+	{
+		cout << "g g > e- e+ mu- mu+, ME summed over single helicities: " << ME_single[0] << ", in batches of " << MEKD_HELAMPS_BATCH_SIZE << ": " << ME_batch[0] << endl;
+		cout << "g g > mu- mu+ mu- mu+, ME summed over single helicities: " << ME_single[1] << ", in batches of " << MEKD_HELAMPS_BATCH_SIZE << ": " << ME_batch[1] << endl;
+		cout << "Timing per event of both processes, averaged over " << benchmark_loops << " events\n";
+		cout << setw(30) << left << "Single helicities" << ": " << time_single*1E6 << " us\n";
+		cout << setw(30) << left << "Batches of helicities" << ": " << time_batch*1E6 << " us\n";
+	}
+	for( int count_ME=0; count_ME<2; count_ME++ )
+	{
+		if( ME_single[count_ME] == 0 || fabs( ME_batch[count_ME]-ME_single[count_ME] ) > Precision_of_interest*fabs( ME_single[count_ME] ) ) return 1;
+	}
+
+
+	return 0;
+}
+
+
+
+#endif
+
+
+
+#endif
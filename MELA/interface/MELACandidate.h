@@ -4,11 +4,17 @@
 #include "MELAParticle.h"
 #include "MELATopCandidate.h"
 
+class MELAEventArena;
+
 class MELACandidate : public MELAParticle{
 public:
   MELACandidate(int id_, TLorentzVector p4_, bool associatedByHighestPt_=false);
   ~MELACandidate();
   MELACandidate* shallowCopy();
+  // Re-initializes a recycled candidate as if it was newly constructed. The lists of related particles keep their capacity.
+  void reset(int id_, const TLorentzVector& p4_, bool associatedByHighestPt_=false);
+  // If set, the intermediate Vs are taken from the arena and owned by it instead of the candidate
+  void setEventArena(MELAEventArena* arena_){ arena=arena_; }
 
   // Member functions
 
@@ -23,6 +29,7 @@ public:
 
   virtual std::vector<int> getDaughterIds()const;
   std::vector<int> getAssociatedParticleIds()const;
+  virtual size_t getRelationsCapacity()const;
 
   TVar::CandidateDecayMode getDecayMode()const{ return selfDecayMode; }
 
@@ -43,6 +50,7 @@ public:
   void addAssociatedVs();
 
   void sortDaughters();
+  void resortDaughters(); // Re-sorts after the daughter momenta are changed in place, reusing the sorted Vs
   void testPreSelectedDaughters();
   bool testShallowCopy();
 
@@ -54,6 +62,7 @@ public:
 protected:
   bool associatedByHighestPt;
   bool isShallowCopy;
+  MELAEventArena* arena;
 
   TVar::CandidateDecayMode selfDecayMode;
 
@@ -66,6 +75,8 @@ protected:
   std::vector<MELAParticle*> sortedDaughters;
   std::vector<MELAParticle*> sortedVs;
 
+  MELAParticle* createV(int id_, const TLorentzVector& p4_);
+  void deleteOwnedVs();
   void sortDaughtersInitial();
   void sortDaughtersByBestZ1();
   void createSortedVs();
@@ -40,6 +40,8 @@ public:
   virtual TObject* clone(const char* newname) const { return new MELAqqZZPdf_v2(*this, newname); }
   inline virtual ~MELAqqZZPdf_v2(){}
 
+  static Double_t evaluateShape(Double_t m4l, const Double_t a[14]); // Same as evaluate() for parameter values a0-a13, without RooFit
+
 protected:
 
   RooRealProxy m4l;
@@ -115,6 +117,7 @@ public:
   MELADoubleCB(const MELADoubleCB& other, const char* name=0);
   virtual TObject* clone(const char* newname) const { return new MELADoubleCB(*this, newname); }
   inline virtual ~MELADoubleCB(){}
+  static Double_t evaluateShape(Double_t x, Double_t mean, Double_t width, Double_t alpha1, Double_t n1, Double_t alpha2, Double_t n2); // Same as evaluate(), without RooFit
   Int_t getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* rangeName=0) const;
   Double_t analyticalIntegral(Int_t code, const char* rangeName=0) const;
 
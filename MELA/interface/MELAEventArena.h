@@ -0,0 +1,52 @@
+#ifndef MELAEVENTARENA_H
+#define MELAEVENTARENA_H
+
+#include <vector>
+#include "MELAParticle.h"
+#include "MELACandidate.h"
+#include "MELATopCandidate.h"
+
+
+// Event-scoped storage of the MELAParticle, MELACandidate and MELATopCandidate objects of an input event.
+// Objects are never deleted before the arena itself: rewind() only marks all of them as free in O(1),
+// and the next requests re-initialize them in place, keeping the capacity of their lists of related particles.
+// Once the arena has grown to the largest event seen, building an event does not allocate any memory.
+// Pointers handed out become invalid at the next rewind().
+class MELAEventArena{
+public:
+
+  MELAEventArena();
+  virtual ~MELAEventArena();
+
+  MELAParticle* newParticle(int id_, const TLorentzVector& p4_);
+  MELACandidate* newCandidate(int id_, const TLorentzVector& p4_, bool associatedByHighestPt_=false); // Intermediate Vs of the candidate also come from the arena
+  MELATopCandidate* newTopCandidate(int id_, const TLorentzVector& p4_);
+  MELATopCandidate* newTopCandidate(MELAParticle* lightQuark_, MELAParticle* Wferm_, MELAParticle* Wfermbar_);
+
+  void rewind();
+
+  // Counters to check that no allocation happens in the steady state
+  unsigned int getNAllocations()const{ return nAllocations; } // Number of objects created with new
+  size_t getRelationsCapacity()const; // Total capacity of the lists of related particles of all objects
+  unsigned int getNParticlesInUse()const{ return nParticlesInUse; }
+  unsigned int getNCandidatesInUse()const{ return nCandidatesInUse; }
+  unsigned int getNTopCandidatesInUse()const{ return nTopCandidatesInUse; }
+
+protected:
+
+  std::vector<MELAParticle*> particles;
+  std::vector<MELACandidate*> candidates;
+  std::vector<MELATopCandidate*> topCandidates;
+  unsigned int nParticlesInUse;
+  unsigned int nCandidatesInUse;
+  unsigned int nTopCandidatesInUse;
+  unsigned int nAllocations;
+
+private:
+  MELAEventArena(const MELAEventArena&);
+  MELAEventArena& operator=(const MELAEventArena&);
+
+};
+
+
+#endif
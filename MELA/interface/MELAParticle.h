@@ -20,6 +20,8 @@ public:
   MELAParticle(const MELAParticle& particle_);
   MELAParticle& operator=(const MELAParticle& particle_);
   virtual ~MELAParticle(){};
+  // Re-initializes a recycled particle as if it was newly constructed. The mother and daughter lists keep their capacity.
+  void reset(int id_, const TLorentzVector& p4_);
 
   // Data
 
@@ -36,10 +38,12 @@ public:
 
   void addMother(MELAParticle* myParticle);
   void addDaughter(MELAParticle* myParticle);
+  void clearDaughters(){ daughters.clear(); }
 
   int getNMothers() const{ return mothers.size(); };
   int getNDaughters() const{ return daughters.size(); };
   virtual std::vector<int> getDaughterIds()const;
+  virtual size_t getRelationsCapacity()const{ return mothers.capacity()+daughters.capacity(); } // Checks that recycled objects do not reallocate
 
   MELAParticle* getMother(int index) const;
   MELAParticle* getDaughter(int index) const;
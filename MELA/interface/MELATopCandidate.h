@@ -9,6 +9,9 @@ public:
   MELATopCandidate(int id_, TLorentzVector p4_) : MELAParticle(id_, p4_), lightQuark(0), Wferm(0), Wfermbar(0) {}
   MELATopCandidate(MELAParticle* lightQuark_, MELAParticle* Wferm_, MELAParticle* Wfermbar_);
   ~MELATopCandidate(){}
+  // Re-initialize a recycled top candidate in the same way as the constructors
+  void reset(int id_, const TLorentzVector& p4_);
+  void reset(MELAParticle* lightQuark_, MELAParticle* Wferm_, MELAParticle* Wfermbar_);
 
   void setLightQuark(MELAParticle* myParticle);
   void setWFermion(MELAParticle* myParticle);
@@ -23,6 +26,8 @@ protected:
   MELAParticle* Wferm;
   MELAParticle* Wfermbar;
 
+  void setDaughterQuarks();
+
 };
 
 
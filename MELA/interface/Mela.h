@@ -7,6 +7,7 @@ Please see the ../src/Mela.cc file for the instructions.
 #define MELA_Mela_h
 
 #include <vector>
+#include <map>
 #include "TLorentzVector.h"
 #include "TRandom3.h"
 
@@ -17,6 +18,7 @@ class TH1F;
 class TH2F;
 class TH3F;
 class RooRealVar;
+class RooAbsReal;
 class RooAbsPdf;
 class RooArgSet;
 class ScalarPdfFactory_ggH;
@@ -34,11 +36,15 @@ class SuperMELA;
 #include "TensorPdfFactory_HVV.h"
 #include "RooqqZZ_JHU_ZgammaZZ_fast.h"
 
+// Several Mela objects can be used from separate threads of one process, each with its own settings (see MelaContext).
+// Their MCFM and JHUGen computations are serialized by a process-wide lock, however, so threads do not compute MEs concurrently.
 class Mela{
 
 public:
 
   // Mela(){};
+  // Unless the working directory provides the MCFM inputs, the first Mela object of a process switches the working directory of the whole process while MCFM reads them.
+  // It then has to be constructed before other threads that depend on the working directory are started.
   Mela(double LHCsqrts_=13., double mh_=125., TVar::VerbosityLevel verbosity_=TVar::ERROR); // higgs mass for supermela
   ~Mela();
 
@@ -53,6 +59,14 @@ public:
   void setMelaHiggsMassWidth(double myHiggsMass, double myHiggsWidth, int index);
   void setRenFacScaleMode(TVar::EventScaleScheme renormalizationSch, TVar::EventScaleScheme factorizationSch, double ren_sf, double fac_sf);
   void setCandidateDecayMode(TVar::CandidateDecayMode mode);
+  void setCacheAnalyticalIntegrals(bool flag=true); // Keep the ZZINDEPENDENT analytical projections across events (default) instead of rebuilding them per event
+  void setMCFMConfigCaching(bool flag=true); // Reuse the MCFM process configurations resolved for the same process and particle ids (default) in this instance
+  void setCouplingPushTracking(bool flag=true); // Skip the transfer of couplings MCFM or JHUGen already hold (default) in this instance
+  void setPDFCaching(bool flag=true); // Reuse the PDF and alpha_s values computed for the same x1, x2 and scales (default) in this instance
+  void setHJJChannelCaching(bool flag=true); // Recombine the JJQCD channels cached for the same event for other Hgg couplings (default) in this instance
+  void setVHHelicitySumming(bool flag=true); // Sum the VH helicities of each parton pair in one JHUGen call (default) instead of one call per helicity in this instance
+  void setLHAgrid(const char* path, int pdfmember=0); // Loads another NNPDF grid or member for this instance
+  void setAngularIntegration(TVar::AngularIntegrationRule rule, unsigned int nCosThetaStar=6, unsigned int nPhi1=6); // Rule and numbers of nodes for the (cos theta*, Phi1) integration of MCFM ZZINDEPENDENT backgrounds
   void setCurrentCandidateFromIndex(unsigned int icand); // Switches to another candidate
   void setCurrentCandidate(MELACandidate* cand); // Switches to another candidate
   void setInputEvent(
@@ -75,6 +89,7 @@ public:
   void resetWidth(double inwidth, int ipart);
   void resetQuarkMasses();
   void resetMCFM_EWKParameters(double ext_Gf, double ext_aemmz, double ext_mW, double ext_mZ, double ext_xW, int ext_ewscheme=3);
+  void resetCKMElements(double invckm_ud, double invckm_us, double invckm_cd, double invckm_cs, double invckm_ts, double invckm_tb, double invckm_ub=-1, double invckm_cb=-1, double invckm_td=-1); // ub, cb, td<0: Computed from the others
 
 
   MelaIO* getIORecord(); // Full parton-by-parton ME record
@@ -82,6 +97,19 @@ public:
   int getCurrentCandidateIndex();
   int getNCandidates();
   std::vector<MELATopCandidate*>* getTopCandidateCollection();
+  const MELAEventArena* getEventArena(); // Storage of the objects of the input events, with counters of its allocations
+  TUtil::PDFCacheStatistics getPDFCacheStatistics(); // Hits and misses of the PDF and alpha_s caches, counted for this instance
+  void resetPDFCacheStatistics();
+  TUtil::TTHPermutationStatistics getTTHPermutationStatistics(); // Top daughter assignments evaluated in computeProdP_ttH, counted for this instance
+  void resetTTHPermutationStatistics();
+  TUtil::HJJChannelCacheStatistics getHJJChannelCacheStatistics(); // Hits and misses of the JJQCD channel cache, counted for this instance
+  void resetHJJChannelCacheStatistics();
+  void invalidateHJJChannelCache(); // Drops the JJQCD channels cached by this instance for the current event
+  TUtil::MCFMConfigCacheStatistics getMCFMConfigCacheStatistics(); // Hits and misses of the MCFM configuration cache, counted for this instance
+  void resetMCFMConfigCacheStatistics();
+  TUtil::CouplingPushStatistics getCouplingPushStatistics(); // Coupling pushes to MCFM and JHUGen, and how many of them were skipped, counted for this instance
+  void resetCouplingPushStatistics();
+  float getAngularIntegrationError(); // Error estimate of the last MCFM ZZINDEPENDENT computation
 
 
   void getConstant(float& prob); // <ME> constants
@@ -131,6 +159,19 @@ public:
     float& prob,
     bool useConstant=true
     );
+  // Batched computeP over a list of events for the given process and the current self-defined couplings.
+  // The events do not need to be set via setInputEvent, and the current input candidates are left untouched.
+  void computeP_batch(
+    TVar::Process myModel,
+    TVar::MatrixElement myME,
+    TVar::Production myProduction,
+    std::vector<SimpleParticleCollection_t>& daughtersList,
+    std::vector<float>& probList,
+    bool useConstant=true,
+    std::vector<SimpleParticleCollection_t>* associatedList=0,
+    std::vector<SimpleParticleCollection_t>* mothersList=0,
+    bool isGen=false
+    );
 
   void computeD_CP(
     TVar::MatrixElement myME,
@@ -138,6 +179,21 @@ public:
     float& prob
     );
 
+  //****Coupling-basis decomposition of computeP****//
+  // |M|**2 is a quadratic form in the self-defined couplings, so it can be reconstructed for any values of a set of active couplings
+  // from (n+1)**2 evaluations on the same kinematics. The active couplings are passed as pointers to the real parts of selfD* array entries,
+  // e.g. &(mela.selfDHzzcoupl[0][gHIGGS_VV_1][0]). Couplings that are not active keep the values set at the time of the decomposition,
+  // and so do the Higgs mass, width and lepton interference.
+  // With MCFM, all points are computed with the anomalous couplings and lepton interference on, as computeP does whenever a self-defined coupling is nonzero.
+  // The decomposition therefore does not reproduce computeP at the single point where all self-defined couplings are zero.
+  void setCouplingDecompositionBasis(const std::vector<double*>& activeCouplings);
+  void computeCouplingDecomposition(bool useConstant=true); // Computes and caches the interference matrix for the current candidate and process
+  void computeP_fromDecomposition(
+    const std::vector< std::pair<double, double> >& activeCouplingValues, // (Re, Im) in the order of the basis
+    float& prob
+    ); // Recomputes the decomposition if the candidate or process changed
+  void resetCouplingDecomposition();
+
   //****VVH Spin-0****//
   void computeProdDecP(
     double selfDHvvcoupl_input[nSupportedHiggses][SIZE_HVV][2],
@@ -207,6 +263,26 @@ public:
   std::vector<TLorentzVector> calculate4Momentum(double Mx, double M1, double M2, double theta, double theta1, double theta2, double Phi1, double Phi);
 
 
+  // The analytical models and their observables are built on first use, i.e. the first ANALYTICAL computation or the first call to one of these accessors.
+  RooAbsPdf* getAnalyticalPdf(); // Model of the last ANALYTICAL computation, null before the first one
+  ScalarPdfFactory_ggH* getSpinZeroModel();
+  VectorPdfFactory* getSpinOneModel();
+  TensorPdfFactory_HVV* getSpinTwoModel();
+  RooqqZZ_JHU_ZgammaZZ_fast* getqqZZModel();
+  RooRealVar* getMZZObservable();
+  RooRealVar* getZ1MassObservable();
+  RooRealVar* getZ2MassObservable();
+  RooRealVar* getCosThetaStarObservable();
+  RooRealVar* getCosTheta1Observable();
+  RooRealVar* getCosTheta2Observable();
+  RooRealVar* getPhiObservable();
+  RooRealVar* getPhi1Observable();
+  RooRealVar* getYObservable();
+  RooRealVar* getUpFracObservable();
+  // SuperMELA is built on the first computePM4l call or the first call to this accessor.
+  SuperMELA* getSuperMELA();
+
+  // The objects returned by the accessors above. They are null until they are built.
   RooAbsPdf* pdf;
   ScalarPdfFactory_ggH* ggSpin0Model;
   VectorPdfFactory* spin1Model;
@@ -254,6 +330,70 @@ public:
   double selfDGvvcoupl[SIZE_GVV][2];
   // That is a lot of them!
 
+  // Snapshot of all self-defined couplings above, used to keep them across several computations
+  struct SelfDCouplingsRecord{
+    double Hggcoupl[nSupportedHiggses][SIZE_HGG][2];
+    double Hg4g4coupl[nSupportedHiggses][SIZE_HGG][2];
+    double Hqqcoupl[nSupportedHiggses][SIZE_HQQ][2];
+    double Hbbcoupl[nSupportedHiggses][SIZE_HQQ][2];
+    double Httcoupl[nSupportedHiggses][SIZE_HQQ][2];
+    double Hb4b4coupl[nSupportedHiggses][SIZE_HQQ][2];
+    double Ht4t4coupl[nSupportedHiggses][SIZE_HQQ][2];
+    double Hzzcoupl[nSupportedHiggses][SIZE_HVV][2];
+    double Hwwcoupl[nSupportedHiggses][SIZE_HVV][2];
+    double HzzLambda_qsq[nSupportedHiggses][SIZE_HVV_LAMBDAQSQ][SIZE_HVV_CQSQ];
+    double HwwLambda_qsq[nSupportedHiggses][SIZE_HVV_LAMBDAQSQ][SIZE_HVV_CQSQ];
+    int HzzCLambda_qsq[nSupportedHiggses][SIZE_HVV_CQSQ];
+    int HwwCLambda_qsq[nSupportedHiggses][SIZE_HVV_CQSQ];
+    bool differentiate_HWW_HZZ;
+    double Zqqcoupl[SIZE_ZQQ][2];
+    double Zvvcoupl[SIZE_ZVV][2];
+    double Gqqcoupl[SIZE_GQQ][2];
+    double Gggcoupl[SIZE_GGG][2];
+    double Gvvcoupl[SIZE_GVV][2];
+  };
+  void storeSelfDCouplings(SelfDCouplingsRecord& record) const;
+  void restoreSelfDCouplings(const SelfDCouplingsRecord& record);
+  // Snapshot of the Higgs masses, widths and lepton interference, which are reset after each computation like the couplings
+  struct PerComputationSettingsRecord{
+    double mHiggs[nSupportedHiggses];
+    double wHiggs[nSupportedHiggses];
+    TVar::LeptonInterference lepInterf;
+  };
+  void storePerComputationSettings(PerComputationSettingsRecord& record) const;
+  void restorePerComputationSettings(const PerComputationSettingsRecord& record);
+
+  // One entry of a multi-hypothesis computation
+  struct Hypothesis{
+    enum ComputationType{
+      kComputeP,
+      kComputeProdDecP,
+      kComputeProdP,
+      kComputeProdP_VH,
+      kComputeProdP_ttH
+    };
+    TVar::Process process;
+    TVar::MatrixElement matrixElement;
+    TVar::Production production;
+    ComputationType computation;
+    bool useConstant;
+    bool includeHiggsDecay; // Only for kComputeProdP_VH
+    int topProcess; // Only for kComputeProdP_ttH
+    int topDecay; // Only for kComputeProdP_ttH
+    bool hasCouplings; // If false, the self-defined couplings are all reset for this hypothesis
+    SelfDCouplingsRecord couplings;
+
+    Hypothesis(TVar::Process process_, TVar::MatrixElement matrixElement_, TVar::Production production_, ComputationType computation_=kComputeP, bool useConstant_=true);
+    void setCouplings(const Mela& mela); // Records the current self-defined couplings of mela for this hypothesis
+  };
+  // Computes all hypotheses for the current candidate with the same result as calling the corresponding compute functions in sequence,
+  // but with the hypothesis-independent work (pT=0 boosts, alpha_s resets) done once for all of them.
+  // The process set before the call is restored at the end.
+  void computeP_multi(
+    const std::vector<Hypothesis>& hypotheses,
+    std::vector<float>& probList
+    );
+
 protected:
 
   //
@@ -272,6 +412,34 @@ protected:
 
   MELACandidate* melaCand; // Pointer to persistent TEvtProb object
 
+  // Coupling-basis decomposition
+  std::vector<double*> decompositionBasis;
+  std::vector<double> decompositionMatrix_re; // (n+1)x(n+1) Hermitian matrix, index 0 is the contribution of the inactive couplings
+  std::vector<double> decompositionMatrix_im;
+  SelfDCouplingsRecord decompositionCouplings; // Inactive couplings used in the decomposition
+  PerComputationSettingsRecord decompositionSettings; // Higgs mass, width and lepton interference used in the decomposition
+  std::vector<double> decompositionKinematics; // Ids and momenta of the candidate used in the decomposition
+  TVar::Process decompositionModel;
+  TVar::MatrixElement decompositionME;
+  TVar::Production decompositionProduction;
+  bool decompositionUseConstant;
+
+  // Analytical ZZINDEPENDENT projections over (cos theta*, Phi1), built once per pdf.
+  // RooFit recomputes their values whenever the observables or the couplings change.
+  bool cacheAnalyticalIntegrals;
+  std::map<RooAbsPdf*, RooAbsReal*> analyticalIntegrals;
+  void deleteAnalyticalIntegrals();
+
+  // Points and scratch candidate of the MCFM ZZINDEPENDENT integration over (cos theta*, Phi1)
+  MelaAngularIntegrator angularIntegrator;
+  // Grid of the integration over the unknown jet pseudorapidity in single-jet JJVBF probabilities
+  MelaJetEtaIntegrator jetEtaIntegrator;
+
+  // Lazy construction of the analytical models and SuperMELA
+  double initialHiggsMass;
+  void buildAnalyticalModels();
+  void buildSuperMELA();
+
   /***** ME CONSTANT HANDLES *****/
   // Constants that vary with sqrts due to application of PDFs
   //
@@ -307,6 +475,8 @@ protected:
   void reset_SelfDCouplings();
   void reset_PAux(); // SuperProb reset
   void reset_CandRef();
+  bool isSelfDCoupling(const double* coupl) const;
+  void getCandidateKinematics(MELACandidate* cand, std::vector<double>& kinematics) const;
 
   void constructDggr(
     float bkg_VAMCFM_noscale,
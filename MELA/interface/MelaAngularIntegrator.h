@@ -0,0 +1,85 @@
+#ifndef MELAANGULARINTEGRATOR_H
+#define MELAANGULARINTEGRATOR_H
+
+#include <vector>
+#include "TVar.hh"
+#include "MELACandidate.h"
+#include "TLorentzVector.h"
+#include "TLorentzRotation.h"
+
+
+// Integration of the MCFM ZZINDEPENDENT backgrounds over (cos theta*, Phi1) at fixed masses and decay angles.
+// The integrand is symmetric under cos theta* -> -cos theta* and Phi1 -> -Phi1, so only cos theta* in [0, 1] and Phi1 in [0, pi] are sampled,
+// and the result is the average over these ranges.
+// The momenta of all points are built once per event, and one scratch candidate owned by the integrator is updated in place for each point.
+class MelaAngularIntegrator{
+public:
+
+  MelaAngularIntegrator();
+  virtual ~MelaAngularIntegrator();
+
+  // nCosThetaStar and nPhi1 are the numbers of nodes in each variable.
+  // The legacy grid with 6x6 nodes is the default. The Clenshaw-Curtis rule needs odd numbers (>=3) of nodes for its error estimate,
+  // so the numbers are rounded up if needed.
+  void setRule(TVar::AngularIntegrationRule rule_, unsigned int nCosThetaStar, unsigned int nPhi1);
+  TVar::AngularIntegrationRule getRule()const{ return rule; }
+  unsigned int getNCosThetaStar()const{ return hsNodes.size(); }
+  unsigned int getNPhi1()const{ return phi1Nodes.size(); }
+  unsigned int getNPoints()const{ return hsNodes.size()*phi1Nodes.size(); } // Points are ordered with cos theta* as the outer index
+
+  // Builds the daughter momenta of all points for the masses and decay angles of the event, and the ids of the daughters of the Vs of cand
+  void setEvent(double mZZ, double mZ1, double mZ2, double costheta1, double costheta2, double Phi, const MELACandidate* cand);
+  double getCosThetaStar(unsigned int ipoint)const{ return hsNodes.at(ipoint/phi1Nodes.size()); }
+  double getPhi1(unsigned int ipoint)const{ return phi1Nodes.at(ipoint%phi1Nodes.size()); }
+  const SimpleParticleCollection_t& getDaughters(unsigned int ipoint); // Ids and momenta of the daughters at one point
+
+  // Returns the scratch candidate with the momenta of the point. The candidate is only rebuilt if the daughter ids or the decay mode change.
+  // Has to be called under the MelaContext lock since the candidate sorting depends on the global decay mode.
+  MELACandidate* setPoint(unsigned int ipoint);
+
+  // Integral (average) of the values at all points, and an estimate of its absolute error
+  double integrate(const std::vector<float>& values);
+  double getError()const{ return lastError; }
+
+protected:
+
+  TVar::AngularIntegrationRule rule;
+
+  std::vector<double> hsNodes;
+  std::vector<double> phi1Nodes;
+  std::vector<double> hsWeights;
+  std::vector<double> phi1Weights;
+  std::vector<double> hsWeightsCheck; // Rules used only for the error estimates, on every (hs/phi1)CheckStep-th node
+  std::vector<double> phi1WeightsCheck;
+  unsigned int hsCheckStep;
+  unsigned int phi1CheckStep;
+  double lastError;
+
+  // Event
+  std::vector<int> dauIds; // Ids of the daughters passed
+  std::vector<int> dauIndices; // Index of each daughter in (f1, fb1, f2, fb2)
+  std::vector<TLorentzRotation> Z1ToZ; // Per cos theta* node
+  std::vector<TLorentzRotation> Z2ToZ;
+  std::vector<TLorentzVector> pZ1Daughters; // (f1, fb1) per Phi1 node in the Z1 frame
+  std::vector<TLorentzVector> pZ2Daughters; // (f2, fb2) per Phi1 node in the Z2 frame
+  SimpleParticleCollection_t pointDaughters;
+  std::vector<TLorentzVector> pointMomenta;
+
+  // Scratch candidate
+  MELACandidate* cand;
+  std::vector<MELAParticle*> candParticles;
+  std::vector<int> candIds;
+  TVar::CandidateDecayMode candDecayMode;
+  void deleteCandidate();
+
+  void setPointMomenta(unsigned int ipoint);
+  double integrateWith(const std::vector<float>& values, const std::vector<double>& wgts_hs, unsigned int step_hs, const std::vector<double>& wgts_phi1, unsigned int step_phi1)const;
+
+private:
+  MelaAngularIntegrator(const MelaAngularIntegrator&);
+  MelaAngularIntegrator& operator=(const MelaAngularIntegrator&);
+
+};
+
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef MELACONTEXT_H
+#define MELACONTEXT_H
+
+#include <map>
+#include <string>
+#include "TVar.hh"
+
+
+namespace TUtil{
+  struct ContextState;
+}
+
+
+// Per-instance record of the settings that MCFM, JHUGen, TUtil and PDGHelpers otherwise keep in process-global state.
+// Only one context is active at a time: A context is activated by acquiring the process-wide lock through MelaContext::Lock,
+// and re-applies its own settings if another context was active in between.
+// This allows several Mela/TEvtProb instances to be used from separate threads of one process, with their ME computations serialized.
+// Each context also owns the TUtil caches, coupling push records and statistics (TUtil::ContextState), which are switched with it.
+class MelaContext{
+public:
+
+  // Scoped lock of the process-global ME state, activating the context passed (if it is not null)
+  class Lock{
+  public:
+    Lock(MelaContext* context_);
+    ~Lock();
+  protected:
+    MelaContext* previous; // Context requested by the enclosing lock in the same thread, re-activated at the end of a nested lock
+  private:
+    Lock(const Lock&);
+    Lock& operator=(const Lock&);
+  };
+
+  MelaContext(double ebeam_);
+  virtual ~MelaContext();
+
+  // Set-functions record the setting and apply it if the context is active. They should be called under a Lock.
+  void setLeptonMassCorrection(bool flag);
+  void setJetMassCorrection(bool flag);
+  void setLeptonMassScheme(TVar::FermionMassRemoval scheme);
+  void setJetMassScheme(TVar::FermionMassRemoval scheme);
+  void setCandidateDecayMode(TVar::CandidateDecayMode mode);
+  void setMass(double inmass, int ipart);
+  void setDecayWidth(double inwidth, int ipart);
+  void setEwkCouplingParameters(double ext_Gf, double ext_aemmz, double ext_mW, double ext_mZ, double ext_xW, int ext_ewscheme);
+  void setLHAgrid(const char* path, int pdfmember, bool isLoaded=false); // isLoaded=true if the grid is already loaded in the NNPDF driver
+  void setCKMElements(double invckm_ud, double invckm_us, double invckm_cd, double invckm_cs, double invckm_ts, double invckm_tb, double invckm_ub=-1, double invckm_cb=-1, double invckm_td=-1); // <0: Not specified
+
+  bool isActive() const;
+
+protected:
+
+  double ebeam;
+
+  bool forbidMassiveLeptons;
+  bool forbidMassiveJets;
+  TVar::FermionMassRemoval LeptonMassScheme;
+  TVar::FermionMassRemoval JetMassScheme;
+  TVar::CandidateDecayMode HDecayMode;
+
+  std::map<int, double> masses; // Masses set through this context
+  std::map<int, double> widths; // Widths set through this context
+
+  bool hasEwkParameters;
+  double ewk_Gf;
+  double ewk_aemmz;
+  double ewk_mW;
+  double ewk_mZ;
+  double ewk_xW;
+  int ewk_ewscheme;
+
+  std::string pdfPath;
+  int pdfMember;
+
+  bool hasCKMElements;
+  double ckmElements[9]; // ud, us, cd, cs, ts, tb, ub, cb, td
+
+  TUtil::ContextState* state;
+
+  void activate();
+  void applyCKMElements();
+
+private:
+  MelaContext(const MelaContext&);
+  MelaContext& operator=(const MelaContext&);
+
+};
+
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef MELAJETETAINTEGRATOR_H
+#define MELAJETETAINTEGRATOR_H
+
+#include <vector>
+#include "TLorentzVector.h"
+
+
+// Adaptive integration over the pseudorapidity of the unknown jet in single-jet JJVBF probabilities.
+// Starting from an equidistant grid, each interval is bisected until the value at its middle is predicted by a clamped cubic spline
+// through the whole grid within the required precision, in which case the spline value is used there instead of the ME.
+// All arrays are kept between events, so no allocation happens once they have grown to the largest grid needed.
+class MelaJetEtaIntegrator{
+public:
+
+  MelaJetEtaIntegrator(double precision_=0.15);
+  virtual ~MelaJetEtaIntegrator(){}
+
+  // Transverse momentum of the jet, sum of the other momenta and the maximum of (E+|pz|)/2 of the total momentum for an ME to be computed
+  void setJet(const TLorentzVector& pJetRef_, const TLorentzVector& pRecoil_, double threshold_);
+  // Sets the jet momentum for pseudorapidity eta with the pT and phi of pJetRef, and returns false if the total momentum is above threshold
+  bool getJetMomentum(double eta, TLorentzVector& pJet)const;
+
+  // Starts the integration with nGrid equidistant points in [etaMin, etaMax]
+  void initialize(double etaMin, double etaMax, unsigned int nGrid=11);
+  // Returns the next eta for which an ME is needed: First all initial grid points, then the refinements.
+  // The value has to be passed through setValue before the next call. Returns false when the grid is complete.
+  bool nextPoint(double& eta);
+  void setValue(float value);
+
+  // Trapezoidal integral over the grid, normalized to the range of eta where the values are non-zero
+  float integrate()const;
+  unsigned int getNPoints()const{ return etaArray.size(); }
+  unsigned int getNIterations()const{ return nIterations; }
+
+protected:
+
+  double precision;
+
+  TLorentzVector pJetRef;
+  TLorentzVector pRecoil;
+  double threshold;
+
+  std::vector<double> etaArray;
+  std::vector<double> pArray;
+  unsigned int nInitial;
+  unsigned int nextInitial;
+  int iInterval; // Next interval to check
+  int iPending; // Index of the point waiting for its value
+  unsigned int nIterations;
+
+  // Work arrays of the spline
+  std::vector<double> splineM; // Second derivatives at the nodes
+  std::vector<double> splineC;
+  double getSplineMidpoint(int iG);
+
+};
+
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef MELAPCONSTANT_H
 #define MELAPCONSTANT_H
 
+#include <string>
 #include "TUtil.hh"
 #include "TF1.h"
 #include "TSpline.h"
@@ -9,6 +10,8 @@
 class MelaPConstant{
 public:
 
+  // The functions are read from the file on the first call to Eval.
+  // Files ending in .mpc are read in the binary format written by ConvertFile, others as ROOT files.
   MelaPConstant(
     TVar::MatrixElement me_,
     TVar::Production prod_,
@@ -20,6 +23,12 @@ public:
   virtual ~MelaPConstant();
 
   double Eval(MelaIO* RcdME, TVar::VerbosityLevel verbosity)const;
+  double GetVal(double candMass)const; // Value of the functions before any multiplication by couplings or alpha_s
+  bool IsLoaded()const{ return isLoaded; }
+
+  // Writes the splines and low/high functions of all constants in a pAvgSmooth ROOT file into the binary format.
+  // The binary file is memory-mapped when read, so its pages are shared between all handles and processes using it.
+  static bool ConvertFile(const char* rootpath, const char* binpath);
 
 private:
 
@@ -27,11 +36,25 @@ private:
   TVar::Production processProd;
   TVar::Process processProc;
 
-  TF1* fcnLow;
-  TF1* fcnHigh;
-  TSpline3* fcnMid;
-
-  void GetFcnFromFile(const char* path, const char* spname);
+  std::string fcnPath;
+  std::string fcnName;
+  mutable bool isLoaded;
+
+  mutable TF1* fcnLow;
+  mutable TF1* fcnHigh;
+  mutable TSpline3* fcnMid;
+
+  // Spline knots and coefficients (x, y, b, c, d per knot) in the memory-mapped binary file
+  mutable void* mapAddress;
+  mutable size_t mapLength;
+  mutable const double* midKnots;
+  mutable unsigned int nMidKnots;
+
+  void Load()const;
+  void GetFcnFromFile(const char* path, const char* spname)const;
+  void GetFcnFromBinaryFile(const char* path, const char* spname)const;
+  double EvalMid(double candMass)const;
+  bool EvalFcn(double candMass, double& val)const; // Returns false if there is no function for candMass
 
 };
 
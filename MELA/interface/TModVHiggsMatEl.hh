@@ -3,6 +3,7 @@
 
 extern "C" {
   void __modvhiggs_MOD_evalamp_vhiggs(int id[9], double helicity[9], double MomExt[9][4], double* me2);
+  void __modvhiggs_MOD_evalamp_vhiggs_helicitysum(int id[9], double MomExt[9][4], int* nHff, int* idHff, double me2[2][2]);
 }
 
 #endif
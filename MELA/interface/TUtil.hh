@@ -10,6 +10,8 @@
 #include <vector>
 // MelaIO class
 #include "MelaIO.h"
+// Storage of the input objects
+#include "MELAEventArena.h"
 // Couplings classes
 #include "TCouplings.hh"
 // MCFM utilities
@@ -157,10 +159,102 @@ namespace TUtil{
   void SetEwkCouplingParameters(double ext_Gf, double ext_aemmz, double ext_mW, double ext_mZ, double ext_xW, int ext_ewscheme);
   void SetMass(double inmass, int ipart);
   void SetDecayWidth(double inwidth, int ipart);
+  double GetMass(int ipart);
+  double GetDecayWidth(int ipart);
   void SetCKMElements(double* invckm_ud, double* invckm_us, double* invckm_cd, double* invckm_cs, double* invckm_ts, double* invckm_tb, double* invckm_ub=0, double* invckm_cb=0, double* invckm_td=0);
+  void SetDefaultCKMElements();
   double InterpretScaleScheme(const TVar::Production& production, const TVar::MatrixElement& matrixElement, const TVar::EventScaleScheme& scheme, TLorentzVector p[mxpart]);
   void SetAlphaS(double& Q_ren, double& Q_fac, double multiplier_ren, double multiplier_fac, int mynloop, int mynflav, std::string mypartons); // Q_ren/fac -> Q_ren/fac * multiplier_ren/fac
   void GetAlphaS(double* alphas_, double* alphasmz_); // Get last alpha_s value set
+
+  // Small keyed caches of the PDF values in ComputePDF, keyed by (x1, x2, muF), and of alpha_s in SetAlphaS, keyed by muR.
+  // Entries are valid only for the PDF set they were computed with; InvalidatePDFCache has to be called whenever a PDF set or member is loaded.
+  struct PDFCacheStatistics{
+    unsigned long long nPDFHits;
+    unsigned long long nPDFMisses;
+    unsigned long long nAlphaSHits;
+    unsigned long long nAlphaSMisses;
+
+    PDFCacheStatistics() : nPDFHits(0), nPDFMisses(0), nAlphaSHits(0), nAlphaSMisses(0){}
+    double getPDFHitRate() const{ return (nPDFHits+nPDFMisses>0 ? double(nPDFHits)/double(nPDFHits+nPDFMisses) : 0.); }
+    double getAlphaSHitRate() const{ return (nAlphaSHits+nAlphaSMisses>0 ? double(nAlphaSHits)/double(nAlphaSHits+nAlphaSMisses) : 0.); }
+  };
+  void SetPDFCaching(bool flag=true);
+  void InvalidatePDFCache();
+  PDFCacheStatistics GetPDFCacheStatistics();
+  void ResetPDFCacheStatistics();
+
+  // Counts of the top daughter assignments evaluated in TTHiggsMatEl
+  struct TTHPermutationStatistics{
+    unsigned long long nEvents;
+    unsigned long long nAssignmentsEvaluated;
+
+    TTHPermutationStatistics() : nEvents(0), nAssignmentsEvaluated(0){}
+    double getAssignmentsPerEvent() const{ return (nEvents>0 ? double(nAssignmentsEvaluated)/double(nEvents) : 0.); }
+  };
+  TTHPermutationStatistics GetTTHPermutationStatistics();
+  void ResetTTHPermutationStatistics();
+
+  // Per-event cache of the JJQCD channels in HJJMatEl, keyed by the momenta, parton ids and alpha_s.
+  // Each channel is stored in pieces quadratic in the Hgg couplings, so that other Hgg couplings on the same event only recombine them.
+  struct HJJChannelCacheStatistics{
+    unsigned long long nHits; // Channels recombined without calling JHUGen
+    unsigned long long nMisses; // Channels for which at least one piece was computed
+    unsigned long long nAmplitudeEvaluations;
+
+    HJJChannelCacheStatistics() : nHits(0), nMisses(0), nAmplitudeEvaluations(0){}
+    double getHitRate() const{ return (nHits+nMisses>0 ? double(nHits)/double(nHits+nMisses) : 0.); }
+  };
+  void SetHJJChannelCaching(bool flag=true);
+  void InvalidateHJJChannelCache();
+  HJJChannelCacheStatistics GetHJJChannelCacheStatistics();
+  void ResetHJJChannelCacheStatistics();
+
+  // VHiggsMatEl sums the helicities of each parton pair in one call to EvalAmp_VHiggs_HelicitySum, or calls EvalAmp_VHiggs per helicity if switched off.
+  void SetVHHelicitySumming(bool flag=true);
+
+  // Keyed cache of the MCFM configurations resolved by MCFM_chooser and MCFM_SetupParticleCouplings, see MCFM_SetupProcess.
+  // Entries store the zcouple_ couplings, so they are dropped by SetEwkCouplingParameters. Masses and widths are read when an entry is applied.
+  struct MCFMConfigCacheStatistics{
+    unsigned long long nHits; // Configurations applied without running the choosers
+    unsigned long long nMisses;
+
+    MCFMConfigCacheStatistics() : nHits(0), nMisses(0){}
+    double getHitRate() const{ return (nHits+nMisses>0 ? double(nHits)/double(nHits+nMisses) : 0.); }
+  };
+  void SetMCFMConfigCaching(bool flag=true);
+  void InvalidateMCFMConfigCache();
+  MCFMConfigCacheStatistics GetMCFMConfigCacheStatistics();
+  void ResetMCFMConfigCacheStatistics();
+
+  // Record of the couplings last pushed to MCFM (spinzerohiggs_anomcoupl_) and to each coupling block of mod_JHUGenMELA.
+  // SetMCFMSpinZeroCouplings and the SetJHUGen*Couplings wrappers skip the transfer if the target already holds the same values,
+  // and the reset of the MCFM couplings to their defaults is only written if an MCFM ME is computed without another push in between.
+  // InvalidateCouplingPushes has to be called whenever these couplings are written in any other way.
+  struct CouplingPushStatistics{
+    unsigned long long nMCFMPushes; // Calls to SetMCFMSpinZeroCouplings
+    unsigned long long nMCFMWrites; // Writes of spinzerohiggs_anomcoupl_
+    unsigned long long nJHUGenPushes; // Calls to the SetJHUGen*Couplings wrappers
+    unsigned long long nJHUGenWrites; // Calls to the mod_JHUGenMELA setters
+
+    CouplingPushStatistics() : nMCFMPushes(0), nMCFMWrites(0), nJHUGenPushes(0), nJHUGenWrites(0){}
+    unsigned long long getNMCFMSkipped() const{ return (nMCFMPushes>nMCFMWrites ? nMCFMPushes-nMCFMWrites : 0); }
+    unsigned long long getNJHUGenSkipped() const{ return (nJHUGenPushes>nJHUGenWrites ? nJHUGenPushes-nJHUGenWrites : 0); }
+    double getMCFMSkippedFraction() const{ return (nMCFMPushes>0 ? double(getNMCFMSkipped())/double(nMCFMPushes) : 0.); }
+    double getJHUGenSkippedFraction() const{ return (nJHUGenPushes>0 ? double(getNJHUGenSkipped())/double(nJHUGenPushes) : 0.); }
+  };
+  void SetCouplingPushTracking(bool flag=true);
+  void InvalidateCouplingPushes();
+  CouplingPushStatistics GetCouplingPushStatistics();
+  void ResetCouplingPushStatistics();
+
+  // The caches, coupling push records and statistics above belong to the active ContextState.
+  // Each MelaContext owns one and activates it with its settings, so that two Mela objects do not share or invalidate each other's caches.
+  // SetContextState(0) activates the state used outside of any MelaContext.
+  struct ContextState;
+  ContextState* CreateContextState();
+  void DeleteContextState(ContextState* state);
+  void SetContextState(ContextState* state);
  
   // chooser.f split into 3 different functions
   bool MCFM_chooser(
@@ -170,6 +264,14 @@ namespace TUtil{
     );
   bool MCFM_SetupParticleCouplings(
     const TVar::Process& process, const TVar::Production& production,
+    const TVar::VerbosityLevel& verbosity,
+    const TVar::simple_event_record& mela_event,
+    std::vector<int>* partOrder, std::vector<int>* apartOrder
+    );
+  // MCFM_chooser followed by MCFM_SetupParticleCouplings, or the stored result of a previous successful call with the same
+  // (process, production, leptonInterf) and ids of the daughters, intermediate Vs, associated particles and mothers
+  bool MCFM_SetupProcess(
+    const TVar::Process& process, const TVar::Production& production, const TVar::LeptonInterference& leptonInterf,
     const TVar::VerbosityLevel& verbosity,
     const TVar::simple_event_record& mela_event,
     std::vector<int>* partOrder, std::vector<int>* apartOrder
@@ -183,6 +285,7 @@ namespace TUtil{
 
   // Spin-0 couplings
   void SetMCFMSpinZeroCouplings(bool useBSM, SpinZeroCouplings* Hcouplings, bool forceZZ);
+  void WriteMCFMSpinZeroCouplings(bool useBSM, SpinZeroCouplings* Hcouplings, bool forceZZ); // Same without the push record, Hcouplings is not used if useBSM=false
   void SetJHUGenSpinZeroVVCouplings(double Hvvcoupl[SIZE_HVV][2], int Hvvcoupl_cqsq[SIZE_HVV_CQSQ], double HvvLambda_qsq[SIZE_HVV_LAMBDAQSQ][SIZE_HVV_CQSQ], bool useWWcoupl);
   void SetJHUGenSpinZeroGGCouplings(double Hggcoupl[SIZE_HGG][2]);
   void SetJHUGenSpinZeroQQCouplings(double Hqqcoupl[SIZE_HQQ][2]);
@@ -251,6 +354,14 @@ namespace TUtil{
     TVar::VerbosityLevel verbosity=TVar::DEBUG
     );
 
+  // Sharing of hypothesis-independent work between consecutive ME computations on the same input event.
+  // While a shared-event computation is open, the results of GetBoostedParticleVectors are reused for the same candidate and request,
+  // and alpha_s is restored only once at the end instead of after every ME. The MelaContext lock has to be held throughout.
+  void BeginSharedEventComputation();
+  void EndSharedEventComputation();
+  void ResetSharedEventComputation(); // Drops the shared results, called whenever the input candidates change
+  bool IsSharedEventComputation();
+
   // Convert vectors of simple particles to MELAParticles and create a MELACandidate
   // The output lists could be members of TEvtProb directly.
   MELACandidate* ConvertVectorFormat(
@@ -261,7 +372,16 @@ namespace TUtil{
     bool isGen,
     // Outputs
     std::vector<MELAParticle*>* particleList,
-    std::vector<MELACandidate*>* candList
+    std::vector<MELACandidate*>* candList,
+    // Objects are taken from the arena if it is passed, and are owned by it instead of the caller of the lists
+    MELAEventArena* arena=0
+    );
+  // Set the momenta of the daughters of a candidate made by ConvertVectorFormat, passed in the same order as pDaughters was,
+  // and update the candidate and its sorted Vs in place with the same arithmetic as a new conversion
+  void UpdateCandidateDaughterMomenta(
+    MELACandidate* cand,
+    std::vector<MELAParticle*>& daughters,
+    const std::vector<TLorentzVector>& pDaughters
     );
   // Convert the vector of top daughters (as simple particles) to MELAParticles and create a MELATopCandidate
   // The output lists could be members of TEvtProb directly.
@@ -270,7 +390,8 @@ namespace TUtil{
     SimpleParticleCollection_t* TopDaughters,
     // Outputs
     std::vector<MELAParticle*>* particleList,
-    std::vector<MELATopCandidate*>* topCandList
+    std::vector<MELATopCandidate*>* topCandList,
+    MELAEventArena* arena=0
     );
   void PrintCandidateSummary(MELACandidate* cand);
   void PrintCandidateSummary(TVar::simple_event_record* cand);
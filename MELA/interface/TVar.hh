@@ -124,6 +124,11 @@ namespace TVar{
     FixedWidth=2,
     CPS=3
   };
+  enum AngularIntegrationRule{ // Integration over (cos theta*, Phi1) of the MCFM ZZINDEPENDENT backgrounds
+    AngularIntegration_LegacyGrid, // Average over an equidistant grid in cos theta* in [0, 1] and Phi1 in [0, pi]
+    AngularIntegration_ClenshawCurtis, // Clenshaw-Curtis in cos theta*, trapezoidal rule in Phi1
+    nAngularIntegrationRules
+  };
 
   enum Process{
     HSMHiggs, // Call this for any MCFM |H|**2-only ME.
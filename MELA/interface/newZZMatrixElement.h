@@ -22,12 +22,27 @@ public:
   void computeXS(
     float &mevalue
     );
+  void computeXS_Batch(
+    std::vector<SimpleParticleCollection_t>& daughtersList,
+    std::vector<float>& mevalueList,
+    std::vector<SimpleParticleCollection_t>* associatedList=0,
+    std::vector<SimpleParticleCollection_t>* mothersList=0,
+    bool isGen=false
+    );
+  void computeXS_AngularGrid(
+    MelaAngularIntegrator& integrator,
+    std::vector<float>& mevalueList
+    );
   void computeProdXS_VVHVV(
     float& mevalue
     );
   void computeProdXS_JJH(
     float &mevalue
     );
+  void computeProdXS_JJH_JetEtaIntegration(
+    MelaJetEtaIntegrator& integrator,
+    MELAParticle* jet
+    );
   void computeProdXS_JH(
     float &mevalue
     );
@@ -59,6 +74,7 @@ public:
   void set_LHAgrid(const char* path, int pdfmember=0); // Sets variable exclusive to Xcal2
   void set_PrimaryHiggsMass(double mh);
   void set_CandidateDecayMode(TVar::CandidateDecayMode mode); // Sets variables exclusive to Xcal2
+  void set_MCFMForceBSMHiggs(bool flag); // Sets variables exclusive to Xcal2
   void set_CurrentCandidateFromIndex(unsigned int icand); // Sets variables exclusive to Xcal2
   void set_CurrentCandidate(MELACandidate* cand); // Sets variables exclusive to Xcal2
   void set_InputEvent(
@@ -79,6 +95,7 @@ public:
   void reset_Width(double inmass, int ipart);
   void reset_QuarkMasses();
   void reset_MCFM_EWKParameters(double ext_Gf, double ext_aemmz, double ext_mW, double ext_mZ, double ext_xW, int ext_ewscheme=3);
+  void reset_CKMElements(double invckm_ud, double invckm_us, double invckm_cd, double invckm_cs, double invckm_ts, double invckm_tb, double invckm_ub=-1, double invckm_cb=-1, double invckm_td=-1);
   void resetPerEvent(); // Resets variables and owned objects that are per-event
   void reset_InputEvent(); // Resets all candidates in Xcal2, to be called at the end of each event after all computations are done
 
@@ -116,6 +133,11 @@ public:
   MELACandidate* get_CurrentCandidate();
   int get_CurrentCandidateIndex();
   int get_NCandidates();
+  MelaContext* get_Context(); // Record of the global ME settings owned by Xcal2
+  const MELAEventArena* get_EventArena(); // Storage of the input event objects owned by Xcal2
+  double get_mHiggs(int index) const; // Values set by set_mHiggs(_wHiggs), reset after each computation
+  double get_wHiggs(int index) const;
+  TVar::LeptonInterference get_LeptonInterference() const;
   std::vector<MELATopCandidate*>* get_TopCandidateCollection(); // Just so that the user can set MELATopCandidate::passSelection=true or false to omit some tops, in case tere are more than two
 
 protected:
@@ -140,6 +162,7 @@ protected:
   // Having a temporary top candidate list does not make much sense at the moment
   //std::vector<MELATopCandidate*> tmpTopCandList; // Vector of pointers to the owned, temporary MELATopCandidates
   std::vector<MELACandidate*> tmpCandList; // Vector of pointers to the owned, temporary MELACandidates
+  MELAEventArena tmpArena; // Storage of the objects in the temporary lists
 
 };
 #endif
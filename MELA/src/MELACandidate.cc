@@ -1,4 +1,5 @@
 #include "MELACandidate.h"
+#include "MELAEventArena.h"
 #include "TMath.h"
 
 using namespace PDGHelpers;
@@ -7,13 +8,11 @@ MELACandidate::MELACandidate(int id_, TLorentzVector p4_, bool associatedByHighe
 MELAParticle(id_, p4_),
 associatedByHighestPt(associatedByHighestPt_),
 isShallowCopy(false),
+arena(0),
 selfDecayMode(TVar::CandidateDecay_Stable)
 {}
 MELACandidate::~MELACandidate(){
-  if (!isShallowCopy){ // Delete owned objects, or not
-    for (unsigned int i=0; i<sortedVs.size(); i++) delete sortedVs.at(i);
-  }
-  sortedVs.clear();
+  deleteOwnedVs();
 
   sortedDaughters.clear();
   associatedTops.clear(); 
@@ -23,6 +22,30 @@ MELACandidate::~MELACandidate(){
   associatedPhotons.clear();
 }
 
+void MELACandidate::reset(int id_, const TLorentzVector& p4_, bool associatedByHighestPt_){
+  MELAParticle::reset(id_, p4_);
+  deleteOwnedVs();
+  associatedByHighestPt=associatedByHighestPt_;
+  isShallowCopy=false;
+  selfDecayMode=TVar::CandidateDecay_Stable;
+  sortedDaughters.clear();
+  associatedTops.clear();
+  associatedJets.clear();
+  associatedLeptons.clear();
+  associatedNeutrinos.clear();
+  associatedPhotons.clear();
+}
+void MELACandidate::deleteOwnedVs(){
+  if (!isShallowCopy && arena==0){ // Delete owned objects, or not
+    for (unsigned int i=0; i<sortedVs.size(); i++) delete sortedVs.at(i);
+  }
+  sortedVs.clear();
+}
+MELAParticle* MELACandidate::createV(int id_, const TLorentzVector& p4_){
+  if (arena!=0) return arena->newParticle(id_, p4_);
+  else return new MELAParticle(id_, p4_);
+}
+
 MELACandidate* MELACandidate::shallowCopy(){
   MELACandidate* cand = new MELACandidate(id, p4, associatedByHighestPt);
 
@@ -63,6 +86,24 @@ void MELACandidate::sortDaughters(){
   if (debugVars::debugFlag) std::cout << "Starting MELACandidate::createSortedVs" << std::endl;
   createSortedVs();
 }
+void MELACandidate::resortDaughters(){
+  if (isShallowCopy){
+    std::cout << "MELACandidate::resortDaughters: Cannot re-sort a shallow copy, whose sorted Vs are owned by another candidate." << std::endl;
+    return;
+  }
+  sortedDaughters.clear();
+  sortDaughtersInitial();
+  sortDaughtersByBestZ1();
+  createSortedVs();
+}
+
+size_t MELACandidate::getRelationsCapacity()const{
+  return (
+    MELAParticle::getRelationsCapacity()
+    + associatedLeptons.capacity() + associatedNeutrinos.capacity() + associatedPhotons.capacity() + associatedJets.capacity() + associatedTops.capacity()
+    + sortedDaughters.capacity() + sortedVs.capacity()
+    );
+}
 
 std::vector<int> MELACandidate::getDaughterIds()const{
   std::vector<int> result;
@@ -430,15 +471,27 @@ void MELACandidate::createSortedVs(){
     else if (fabs(Vcharge[1]+1.)<0.001) V2id=-24;
   }
 
+  // Update the Vs in place if they exist from a previous sorting
+  if (sortedVs.size()==2){
+    MELAParticle* Vs[2] ={ sortedVs.at(0), sortedVs.at(1) };
+    Vs[0]->id = V1id; Vs[0]->p4.SetXYZT(pZ1.X(), pZ1.Y(), pZ1.Z(), pZ1.T());
+    Vs[1]->id = V2id; Vs[1]->p4.SetXYZT(pZ2.X(), pZ2.Y(), pZ2.Z(), pZ2.T());
+    for (int iv=0; iv<2; iv++) Vs[iv]->clearDaughters();
+    for (int d=0; d<imax; d++){
+      if (sortedDaughters.at(d)!=0) Vs[(d<icutoff ? 0 : 1)]->addDaughter(sortedDaughters.at(d));
+    }
+    return;
+  }
+
   // If the number of Zs is less than 2, should still create empty particles
-  MELAParticle* Z1 = new MELAParticle(V1id, pZ1);
+  MELAParticle* Z1 = createV(V1id, pZ1);
   Z1->addMother(this);
   for (int d=0; d<icutoff; d++){
     if (sortedDaughters.at(d)!=0) Z1->addDaughter(sortedDaughters.at(d));
   }
   addSortedV(Z1);
 
-  MELAParticle* Z2 = new MELAParticle(V2id, pZ2);
+  MELAParticle* Z2 = createV(V2id, pZ2);
   Z2->addMother(this);
   for (int d=icutoff; d<imax; d++){
     if (sortedDaughters.at(d)!=0) Z2->addDaughter(sortedDaughters.at(d));
@@ -569,7 +622,7 @@ void MELACandidate::createAssociatedVs(std::vector<MELAParticle*>& particleArray
 
       if (bosonId!=-1){
         TLorentzVector pV = particleArray.at(i)->p4+particleArray.at(j)->p4;
-        MELAParticle* boson = new MELAParticle(bosonId, pV);
+        MELAParticle* boson = createV(bosonId, pV);
         // Order by f-f'b
         int firstdaughter = i, seconddaughter = j;
         if (
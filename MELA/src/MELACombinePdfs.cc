@@ -1928,11 +1928,17 @@ MELAqqZZPdf_v2::MELAqqZZPdf_v2(
 
 
 Double_t MELAqqZZPdf_v2::evaluate() const
+{
+	const Double_t a[14]={ a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13 };
+	return evaluateShape(m4l, a);
+}
+
+Double_t MELAqqZZPdf_v2::evaluateShape(Double_t m4l, const Double_t a[14])
 {
 	
-	double ZZ = (.5+.5*TMath::Erf((m4l-a0)/a1))*(a3/(1+exp((m4l-a0)/a2)))+
-    (.5+.5*TMath::Erf((m4l-a4)/a5))*(a7/(1+exp((m4l-a4)/a6))+a9/(1+exp((m4l-a4)/a8)))
-    +(.5+.5*TMath::Erf((m4l-a10)/a11))*(a13/(1+exp((m4l-a10)/a12)) );
+	double ZZ = (.5+.5*TMath::Erf((m4l-a[0])/a[1]))*(a[3]/(1+exp((m4l-a[0])/a[2])))+
+    (.5+.5*TMath::Erf((m4l-a[4])/a[5]))*(a[7]/(1+exp((m4l-a[4])/a[6]))+a[9]/(1+exp((m4l-a[4])/a[8])))
+    +(.5+.5*TMath::Erf((m4l-a[10])/a[11]))*(a[13]/(1+exp((m4l-a[10])/a[12])) );
 	
 	return ZZ;
 }
@@ -2028,7 +2034,8 @@ alpha2("alpha2", this, other.alpha2),
 n2("n2", this, other.n2)
 {}
 
-double MELADoubleCB::evaluate() const{
+double MELADoubleCB::evaluate() const{ return evaluateShape(x, mean, width, alpha1, n1, alpha2, n2); }
+Double_t MELADoubleCB::evaluateShape(Double_t x, Double_t mean, Double_t width, Double_t alpha1, Double_t n1, Double_t alpha2, Double_t n2){
   double t = (x-mean)/width;
   if (t>-alpha1 && t<alpha2){
     return exp(-0.5*t*t);
@@ -0,0 +1,90 @@
+#include "MELAEventArena.h"
+
+
+using namespace std;
+
+
+MELAEventArena::MELAEventArena() :
+nParticlesInUse(0),
+nCandidatesInUse(0),
+nTopCandidatesInUse(0),
+nAllocations(0)
+{}
+MELAEventArena::~MELAEventArena(){
+  // Candidates do not own the Vs they took from the arena, so the deletion order does not matter.
+  for (unsigned int ic=0; ic<candidates.size(); ic++) delete candidates.at(ic);
+  for (unsigned int ic=0; ic<topCandidates.size(); ic++) delete topCandidates.at(ic);
+  for (unsigned int ip=0; ip<particles.size(); ip++) delete particles.at(ip);
+}
+
+MELAParticle* MELAEventArena::newParticle(int id_, const TLorentzVector& p4_){
+  MELAParticle* part=0;
+  if (nParticlesInUse<particles.size()){
+    part = particles.at(nParticlesInUse);
+    part->reset(id_, p4_);
+  }
+  else{
+    part = new MELAParticle(id_, p4_);
+    particles.push_back(part);
+    nAllocations++;
+  }
+  nParticlesInUse++;
+  return part;
+}
+MELACandidate* MELAEventArena::newCandidate(int id_, const TLorentzVector& p4_, bool associatedByHighestPt_){
+  MELACandidate* cand=0;
+  if (nCandidatesInUse<candidates.size()){
+    cand = candidates.at(nCandidatesInUse);
+    cand->reset(id_, p4_, associatedByHighestPt_);
+  }
+  else{
+    cand = new MELACandidate(id_, p4_, associatedByHighestPt_);
+    cand->setEventArena(this);
+    candidates.push_back(cand);
+    nAllocations++;
+  }
+  nCandidatesInUse++;
+  return cand;
+}
+MELATopCandidate* MELAEventArena::newTopCandidate(int id_, const TLorentzVector& p4_){
+  MELATopCandidate* cand=0;
+  if (nTopCandidatesInUse<topCandidates.size()){
+    cand = topCandidates.at(nTopCandidatesInUse);
+    cand->reset(id_, p4_);
+  }
+  else{
+    cand = new MELATopCandidate(id_, p4_);
+    topCandidates.push_back(cand);
+    nAllocations++;
+  }
+  nTopCandidatesInUse++;
+  return cand;
+}
+MELATopCandidate* MELAEventArena::newTopCandidate(MELAParticle* lightQuark_, MELAParticle* Wferm_, MELAParticle* Wfermbar_){
+  MELATopCandidate* cand=0;
+  if (nTopCandidatesInUse<topCandidates.size()){
+    cand = topCandidates.at(nTopCandidatesInUse);
+    cand->reset(lightQuark_, Wferm_, Wfermbar_);
+  }
+  else{
+    cand = new MELATopCandidate(lightQuark_, Wferm_, Wfermbar_);
+    topCandidates.push_back(cand);
+    nAllocations++;
+  }
+  nTopCandidatesInUse++;
+  return cand;
+}
+
+void MELAEventArena::rewind(){
+  nParticlesInUse=0;
+  nCandidatesInUse=0;
+  nTopCandidatesInUse=0;
+}
+
+size_t MELAEventArena::getRelationsCapacity()const{
+  size_t result=0;
+  for (unsigned int ip=0; ip<particles.size(); ip++) result += particles.at(ip)->getRelationsCapacity();
+  for (unsigned int ic=0; ic<candidates.size(); ic++) result += candidates.at(ic)->getRelationsCapacity();
+  for (unsigned int ic=0; ic<topCandidates.size(); ic++) result += topCandidates.at(ic)->getRelationsCapacity();
+  return result;
+}
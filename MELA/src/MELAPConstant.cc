@@ -1,15 +1,74 @@
 #include <iostream>
+#include <fstream>
 #include <vector>
 #include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "MelaPConstant.h"
 #include "TROOT.h"
 #include "TFile.h"
+#include "TKey.h"
 #include "TString.h"
 
 
 using namespace std;
 
 
+namespace{
+  // Layout of the binary files: MPCFileHeader, nConstants x MPCConstant, then the spline knots of each constant as (x, y, b, c, d) doubles.
+  // All record sizes are multiples of 8 bytes so that the knots are aligned in the memory-mapped file.
+  const char mpcMagic[8]={ 'M', 'E', 'L', 'A', 'P', 'C', '0', '1' };
+  const unsigned int mpcNameLength=128;
+  const unsigned int mpcMaxPars=8;
+  const unsigned int mpcKnotSize=5;
+
+  struct MPCFileHeader{
+    char magic[8];
+    unsigned int nConstants;
+    unsigned int reserved;
+  };
+  struct MPCFcn{
+    double xmin;
+    double xmax;
+    double pars[mpcMaxPars];
+    unsigned int npars;
+    unsigned int reserved;
+    char formula[mpcNameLength]; // Empty if the function is absent
+  };
+  struct MPCConstant{
+    char name[mpcNameLength];
+    MPCFcn fcnLow;
+    MPCFcn fcnHigh;
+    unsigned long long knotsOffset; // Bytes from the beginning of the file
+    unsigned int nKnots;
+    unsigned int reserved;
+  };
+
+  bool setFcnRecord(TF1* fcn, MPCFcn& record){
+    memset(&record, 0, sizeof(MPCFcn));
+    if (fcn==0) return true;
+    // The functions are made by calcC_lintolog.c from formula expressions, which TF1 keeps as its title
+    TString formula = fcn->GetTitle();
+    if (formula.Length()==0 || formula.Length()>=(int)mpcNameLength || fcn->GetNpar()>(int)mpcMaxPars) return false;
+    strncpy(record.formula, formula.Data(), mpcNameLength-1);
+    record.xmin = fcn->GetXmin();
+    record.xmax = fcn->GetXmax();
+    record.npars = fcn->GetNpar();
+    for (unsigned int ipar=0; ipar<record.npars; ipar++) record.pars[ipar] = fcn->GetParameter(ipar);
+    return true;
+  }
+  TF1* getFcnFromRecord(const MPCFcn& record, const TString& name){
+    if (record.formula[0]=='\0') return 0;
+    TF1* fcn = new TF1(name, record.formula, record.xmin, record.xmax);
+    for (unsigned int ipar=0; ipar<record.npars && ipar<mpcMaxPars; ipar++) fcn->SetParameter(ipar, record.pars[ipar]);
+    return fcn;
+  }
+}
+
+
 MelaPConstant::MelaPConstant(
   TVar::MatrixElement me_,
   TVar::Production prod_,
@@ -20,16 +79,32 @@ MelaPConstant::MelaPConstant(
   processME(me_),
   processProd(prod_),
   processProc(proc_),
+  fcnPath(path),
+  fcnName(spname),
+  isLoaded(false),
   fcnLow(0),
   fcnHigh(0),
-  fcnMid(0)
-{
-  GetFcnFromFile(path, spname);
+  fcnMid(0),
+  mapAddress(0),
+  mapLength(0),
+  midKnots(0),
+  nMidKnots(0)
+{}
+
+MelaPConstant::~MelaPConstant(){
+  delete fcnLow;
+  delete fcnHigh;
+  delete fcnMid;
+  if (mapAddress!=0) munmap(mapAddress, mapLength);
 }
 
-MelaPConstant::~MelaPConstant(){}
+void MelaPConstant::Load()const{
+  isLoaded=true;
+  if (fcnPath.length()>4 && fcnPath.compare(fcnPath.length()-4, 4, ".mpc")==0) GetFcnFromBinaryFile(fcnPath.c_str(), fcnName.c_str());
+  else GetFcnFromFile(fcnPath.c_str(), fcnName.c_str());
+}
 
-void MelaPConstant::GetFcnFromFile(const char* path, const char* spname){
+void MelaPConstant::GetFcnFromFile(const char* path, const char* spname)const{
   TString spname_core = spname;
   spname_core.Append("_Smooth");
   spname_core.Prepend("sp_tg_");
@@ -52,6 +127,172 @@ void MelaPConstant::GetFcnFromFile(const char* path, const char* spname){
   if (fin!=0 && fin->IsOpen()) fin->Close();
 }
 
+void MelaPConstant::GetFcnFromBinaryFile(const char* path, const char* spname)const{
+  int fd = open(path, O_RDONLY);
+  if (fd<0){ cerr << "MelaPConstant::GetFcnFromBinaryFile: Failed to open file in path " << path << endl; return; }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat)!=0 || fileStat.st_size<(off_t)sizeof(MPCFileHeader)){
+    cerr << "MelaPConstant::GetFcnFromBinaryFile: File " << path << " is too short" << endl;
+    close(fd);
+    return;
+  }
+  size_t length = fileStat.st_size;
+  void* address = mmap(0, length, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (address==MAP_FAILED){ cerr << "MelaPConstant::GetFcnFromBinaryFile: Failed to map file in path " << path << endl; return; }
+
+  const char* data = (const char*)address;
+  const MPCFileHeader* header = (const MPCFileHeader*)data;
+  const MPCConstant* record=0;
+  if (memcmp(header->magic, mpcMagic, sizeof(mpcMagic))!=0 || length<sizeof(MPCFileHeader)+header->nConstants*sizeof(MPCConstant)) cerr << "MelaPConstant::GetFcnFromBinaryFile: File " << path << " is not in the expected format" << endl;
+  else{
+    const MPCConstant* constants = (const MPCConstant*)(data+sizeof(MPCFileHeader));
+    for (unsigned int ic=0; ic<header->nConstants; ic++){
+      if (strncmp(constants[ic].name, spname, mpcNameLength)==0){ record = &(constants[ic]); break; }
+    }
+    if (record==0) cerr << "MelaPConstant::GetFcnFromBinaryFile: " << spname << " is not found in file " << path << endl;
+    else if (record->knotsOffset+(unsigned long long)record->nKnots*mpcKnotSize*sizeof(double)>length){
+      cerr << "MelaPConstant::GetFcnFromBinaryFile: Knots of " << spname << " exceed the size of file " << path << endl;
+      record=0;
+    }
+  }
+  if (record==0){ munmap(address, length); return; }
+
+  // Names are made unique per handle since older ROOT versions delete global functions with the same name
+  TString spname_core = spname;
+  spname_core.Append("_Smooth");
+  spname_core.Prepend("sp_tg_");
+  fcnLow = getFcnFromRecord(record->fcnLow, Form("lowFcn_%s_%p", spname_core.Data(), (const void*)this));
+  fcnHigh = getFcnFromRecord(record->fcnHigh, Form("highFcn_%s_%p", spname_core.Data(), (const void*)this));
+  if (record->nKnots>0){
+    midKnots = (const double*)(data+record->knotsOffset);
+    nMidKnots = record->nKnots;
+  }
+  mapAddress = address;
+  mapLength = length;
+}
+
+bool MelaPConstant::ConvertFile(const char* rootpath, const char* binpath){
+  TFile* fin = TFile::Open(rootpath, "read");
+  gROOT->cd();
+  if (fin==0 || fin->IsZombie() || !fin->IsOpen()){
+    cerr << "MelaPConstant::ConvertFile: Failed to open file in path " << rootpath << endl;
+    if (fin!=0 && fin->IsOpen()) fin->Close();
+    return false;
+  }
+
+  bool success=true;
+  vector<MPCConstant> constants;
+  vector< vector<double> > knots;
+  TIter nextKey(fin->GetListOfKeys());
+  TKey* key;
+  while ((key = (TKey*)nextKey())){
+    TString keyname = key->GetName();
+    if (!keyname.BeginsWith("sp_tg_") || !keyname.EndsWith("_Smooth")) continue;
+    TString spname = keyname(6, keyname.Length()-6-7);
+
+    bool isDuplicate=false; // Keys are listed once per cycle
+    for (unsigned int ic=0; ic<constants.size(); ic++){ if (spname==constants.at(ic).name){ isDuplicate=true; break; } }
+    if (isDuplicate) continue;
+
+    TSpline3* sp = dynamic_cast<TSpline3*>(fin->Get(keyname));
+    if (sp==0) continue;
+
+    MPCConstant record;
+    memset(&record, 0, sizeof(MPCConstant));
+    if (spname.Length()>=(int)mpcNameLength){
+      cerr << "MelaPConstant::ConvertFile: Name " << spname << " is too long" << endl;
+      success=false;
+      delete sp;
+      continue;
+    }
+    strncpy(record.name, spname.Data(), mpcNameLength-1);
+    TF1* fcnLow = dynamic_cast<TF1*>(fin->Get(Form("lowFcn_%s", keyname.Data())));
+    TF1* fcnHigh = dynamic_cast<TF1*>(fin->Get(Form("highFcn_%s", keyname.Data())));
+    if (!setFcnRecord(fcnLow, record.fcnLow) || !setFcnRecord(fcnHigh, record.fcnHigh)){
+      cerr << "MelaPConstant::ConvertFile: Low or high function of " << spname << " cannot be stored as a formula" << endl;
+      success=false;
+      delete sp;
+      delete fcnLow;
+      delete fcnHigh;
+      continue;
+    }
+
+    vector<double> spknots;
+    for (int ip=0; ip<sp->GetNp(); ip++){
+      double x, y, b, c, d;
+      sp->GetCoeff(ip, x, y, b, c, d);
+      spknots.push_back(x); spknots.push_back(y); spknots.push_back(b); spknots.push_back(c); spknots.push_back(d);
+    }
+    record.nKnots = sp->GetNp();
+    constants.push_back(record);
+    knots.push_back(spknots);
+    delete sp;
+    delete fcnLow;
+    delete fcnHigh;
+  }
+  fin->Close();
+  if (constants.empty()){ cerr << "MelaPConstant::ConvertFile: No splines are found in file " << rootpath << endl; return false; }
+
+  unsigned long long offset = sizeof(MPCFileHeader)+constants.size()*sizeof(MPCConstant);
+  for (unsigned int ic=0; ic<constants.size(); ic++){
+    constants.at(ic).knotsOffset = offset;
+    offset += knots.at(ic).size()*sizeof(double);
+  }
+
+  MPCFileHeader header;
+  memset(&header, 0, sizeof(MPCFileHeader));
+  memcpy(header.magic, mpcMagic, sizeof(mpcMagic));
+  header.nConstants = constants.size();
+
+  ofstream fout(binpath, ios::out | ios::binary | ios::trunc);
+  if (!fout.good()){ cerr << "MelaPConstant::ConvertFile: Failed to open file in path " << binpath << endl; return false; }
+  fout.write((const char*)&header, sizeof(MPCFileHeader));
+  fout.write((const char*)&(constants.front()), constants.size()*sizeof(MPCConstant));
+  for (unsigned int ic=0; ic<knots.size(); ic++){ if (!knots.at(ic).empty()) fout.write((const char*)&(knots.at(ic).front()), knots.at(ic).size()*sizeof(double)); }
+  fout.close();
+  if (fout.fail()){ cerr << "MelaPConstant::ConvertFile: Failed to write file " << binpath << endl; return false; }
+  return success;
+}
+
+double MelaPConstant::EvalMid(double candMass)const{
+  if (fcnMid!=0) return fcnMid->Eval(candMass);
+
+  // Same knot search and polynomial as TSpline3::Eval for knots that are not equidistant
+  int klow=0, khigh=nMidKnots-1;
+  if (candMass<=midKnots[0]) klow=0;
+  else if (candMass>=midKnots[mpcKnotSize*khigh]) klow=khigh;
+  else{
+    while (khigh-klow>1){
+      int khalf=(klow+khigh)/2;
+      if (candMass>midKnots[mpcKnotSize*khalf]) klow=khalf;
+      else khigh=khalf;
+    }
+  }
+  if (klow>=(int)nMidKnots-1 && nMidKnots>1) klow=nMidKnots-2;
+
+  const double* knot = midKnots+mpcKnotSize*klow;
+  double dx = candMass-knot[0];
+  return (knot[1]+dx*(knot[2]+dx*(knot[3]+dx*knot[4])));
+}
+
+bool MelaPConstant::EvalFcn(double candMass, double& val)const{
+  if (!isLoaded) Load();
+
+  if (fcnLow!=0 && candMass<fcnLow->GetXmax()) val = fcnLow->Eval(candMass);
+  else if (fcnHigh!=0 && candMass>fcnHigh->GetXmin()) val = fcnHigh->Eval(candMass);
+  else if (fcnMid!=0 || midKnots!=0) val = EvalMid(candMass);
+  else return false;
+  return true;
+}
+
+double MelaPConstant::GetVal(double candMass)const{
+  double val=1;
+  if (candMass<=0.) return 0.;
+  EvalFcn(candMass, val);
+  return val;
+}
+
 double MelaPConstant::Eval(MelaIO* RcdME, TVar::VerbosityLevel verbosity)const{
   if (verbosity>=TVar::DEBUG) cout << "Begin MelaPConstant::Eval" << endl;
 
@@ -61,10 +302,7 @@ double MelaPConstant::Eval(MelaIO* RcdME, TVar::VerbosityLevel verbosity)const{
   double candMass = RcdME->melaCand->m();
   if (verbosity>=TVar::DEBUG) cout << "MelaPConstant::Eval: Candidate mass is " << candMass << endl;
   if (candMass<=0.) return 0.;
-  else if (fcnLow!=0 && candMass<fcnLow->GetXmax()) result = fcnLow->Eval(candMass);
-  else if (fcnHigh!=0 && candMass>fcnHigh->GetXmin()) result = fcnHigh->Eval(candMass);
-  else if (fcnMid!=0) result = fcnMid->Eval(candMass);
-  else return result;
+  else if (!EvalFcn(candMass, result)) return result;
 
   if (verbosity>=TVar::DEBUG) cout << "MelaPConstant::Eval: Spline evaluated to " << result << endl;
 
@@ -44,6 +44,16 @@ MELAParticle& MELAParticle::operator=(const MELAParticle& particle_){
   return *this;
 }
 
+void MELAParticle::reset(int id_, const TLorentzVector& p4_){
+  id=id_;
+  passSelection=true;
+  genStatus=-2;
+  lifetime=0;
+  p4.SetXYZT(p4_.X(), p4_.Y(), p4_.Z(), p4_.T());
+  mothers.clear();
+  daughters.clear();
+}
+
 
 bool MELAParticle::checkParticleExists(MELAParticle* myParticle, std::vector<MELAParticle*>& particleArray){
   for (std::vector<MELAParticle*>::iterator it = particleArray.begin(); it<particleArray.end(); it++){
@@ -11,6 +11,22 @@ MELATopCandidate::MELATopCandidate(
   Wferm(Wferm_),
   Wfermbar(Wfermbar_)
 {
+  setDaughterQuarks();
+}
+void MELATopCandidate::reset(int id_, const TLorentzVector& p4_){
+  MELAParticle::reset(id_, p4_);
+  lightQuark=0;
+  Wferm=0;
+  Wfermbar=0;
+}
+void MELATopCandidate::reset(MELAParticle* lightQuark_, MELAParticle* Wferm_, MELAParticle* Wfermbar_){
+  MELAParticle::reset(0, TLorentzVector(0, 0, 0, 0));
+  lightQuark=lightQuark_;
+  Wferm=Wferm_;
+  Wfermbar=Wfermbar_;
+  setDaughterQuarks();
+}
+void MELATopCandidate::setDaughterQuarks(){
   if (lightQuark!=0){
     p4 = p4 + lightQuark->p4;
     addDaughter(lightQuark);
@@ -18,6 +18,7 @@ Please adhere to the following coding conventions:
 #include <string>
 #include <cstdio>
 #include <cmath>
+#include <cstring>
 #include <unistd.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -36,7 +37,6 @@ Please adhere to the following coding conventions:
 #include "TH2F.h"
 #include "TH3F.h"
 #include "TGraph.h"
-#include "TSpline.h"
 #include "TString.h"
 
 
@@ -48,21 +48,38 @@ Mela::Mela(
   double mh_,
   TVar::VerbosityLevel verbosity_
   ) :
+  pdf(0),
+  ggSpin0Model(0),
+  spin1Model(0),
+  spin2Model(0),
+  qqZZmodel(0),
+  super(0),
+  mzz_rrv(0),
+  z1mass_rrv(0),
+  z2mass_rrv(0),
+  costhetastar_rrv(0),
+  costheta1_rrv(0),
+  costheta2_rrv(0),
+  phi_rrv(0),
+  phi1_rrv(0),
+  Y_rrv(0),
+  upFrac_rrv(0),
   LHCsqrts(LHCsqrts_),
   myVerbosity_(verbosity_),
   ZZME(0),
   auxiliaryProb(0.),
-  melaCand(0)
+  melaCand(0),
+  decompositionModel(TVar::nProcesses),
+  decompositionME(TVar::MCFM),
+  decompositionProduction(TVar::nProductions),
+  decompositionUseConstant(false),
+  cacheAnalyticalIntegrals(true),
+  initialHiggsMass(mh_)
 {
   if (myVerbosity_>=TVar::DEBUG) cout << "Start Mela constructor" << endl;
-  //setRemoveLeptonMasses(false); // Use Run 1 scheme for not removing fermion masses
-  setRemoveLeptonMasses(true); // Use Run 2 scheme for removing fermion masses to compute MEs that expect massless fermions properly
-
-  const double maxSqrts = 8.;
-
-  // Create symlinks to the required files, if these are not already present (do nothing otherwise)
-  if (myVerbosity_>=TVar::DEBUG) cout << "Create symlinks to the required files if these are not already present:" << endl;
+  MelaContext::Lock contextLock(0); // Serialize the construction
 
+  // Data files are read from the package data directory, see TEvtProb::InitializeMCFM for the MCFM inputs
 #ifdef _melapkgpathstr_
   const string MELAPKGPATH = _melapkgpathstr_;
   if (myVerbosity_>=TVar::DEBUG)  cout << "\t- MELA package path: " << MELAPKGPATH << endl;
@@ -70,20 +87,47 @@ Mela::Mela(
   cout << "MELA package path is undefined! Please modify the makefle or the makefile-equivalent!" << endl;
   assert(0);
 #endif
-
+  // The FF library in MCFM opens ffwarn.dat by this fixed relative name whenever it issues a warning, and the prebuilt library cannot be given another path.
+  // This symlink in the working directory is therefore the only file that Mela still creates there (does nothing if present).
   const string mcfmWarning = MELAPKGPATH + "data/ffwarn.dat"; symlink(mcfmWarning.c_str(), "ffwarn.dat");
-  const string mcfm_brsm_o = MELAPKGPATH + "data/br.sm1"; symlink(mcfm_brsm_o.c_str(), "br.sm1");
-  const string mcfm_brsm_t = MELAPKGPATH + "data/br.sm2"; symlink(mcfm_brsm_t.c_str(), "br.sm2");
-  const string mcfmInput1 = MELAPKGPATH + "data/input.DAT"; symlink(mcfmInput1.c_str(), "input.DAT");
-  const string mcfmInput2 = MELAPKGPATH + "data/process.DAT"; symlink(mcfmInput2.c_str(), "process.DAT");
-  if (myVerbosity_>=TVar::DEBUG) cout << "\t- MCFM symlinks are done" << endl;
-  mkdir("Pdfdata", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
-  const string mcfmInput3 = MELAPKGPATH + "data/Pdfdata/cteq6l1.tbl"; symlink(mcfmInput3.c_str(), "Pdfdata/cteq6l1.tbl");
-  const string mcfmInput4 = MELAPKGPATH + "data/Pdfdata/cteq6l.tbl"; symlink(mcfmInput4.c_str(), "Pdfdata/cteq6l.tbl");
-  if (myVerbosity_>=TVar::DEBUG) cout << "\t- PDF symlinks are done" << endl;
+
+  if (myVerbosity_>=TVar::DEBUG) cout << "Paths for newZZMatrixElement" << endl;
+  const string path_HiggsWidthFile = MELAPKGPATH + "data/HiggsTotalWidth_YR3.txt";
+  if (myVerbosity_>=TVar::DEBUG) cout << "\t- Cross section/width file: " << path_HiggsWidthFile << endl;
+  const string path_nnpdf = MELAPKGPATH + "data/Pdfdata/NNPDF30_lo_as_0130.LHgrid";
+  int pdfmember = 0;
+  if (myVerbosity_>=TVar::DEBUG) cout << "\t- NNPDF path: " << path_nnpdf << endl;
+  if (myVerbosity_>=TVar::DEBUG) cout << "Start newZZMatrixElement" << endl;
+  ZZME = new newZZMatrixElement(path_nnpdf.c_str(), pdfmember, path_HiggsWidthFile.substr(0, path_HiggsWidthFile.length()-23).c_str(), 1000.*LHCsqrts/2., myVerbosity_);
+  //setRemoveLeptonMasses(false); // Use Run 1 scheme for not removing fermion masses
+  setRemoveLeptonMasses(true); // Use Run 2 scheme for removing fermion masses to compute MEs that expect massless fermions properly
+  if (myVerbosity_>=TVar::DEBUG) cout << "Set newZZMatrixElement masses" << endl;
+  setMelaPrimaryHiggsMass(mh_);
+  setMelaHiggsMass(mh_, 0); setMelaHiggsMass(-1., 1);
+  setMelaHiggsWidth(-1., 0); setMelaHiggsWidth(0., 1);
+  setMelaLeptonInterference(TVar::DefaultLeptonInterf);
+  setCandidateDecayMode(TVar::CandidateDecay_ZZ); // Default decay mode is ZZ at the start
+
+
+  /***** CONSTANTS FOR MATRIX ELEMENTS *****/
+  getPConstantHandles();
+
+  // Deactivate generation messages
+  RooMsgService::instance().getStream(1).removeTopic(NumIntegration);
+  RooMsgService::instance().setStreamStatus(1, kFALSE);
+  RooMsgService::instance().setStreamStatus(0, kFALSE);// silence also the error messages, but should really be looked at.
+
+  myRandomNumber=new TRandom3(35797);
+
+  reset_SelfDCouplings();
+  if (myVerbosity_>=TVar::DEBUG) cout << "End Mela constructor" << endl;
+}
+
+void Mela::buildAnalyticalModels(){
+  if (ggSpin0Model!=0) return;
 
   if (myVerbosity_>=TVar::DEBUG) cout << "Create variables used in anaMELA" << endl;
-  mzz_rrv = new RooRealVar("mzz", "m_{ZZ}", mh_, 0., 1000.);
+  mzz_rrv = new RooRealVar("mzz", "m_{ZZ}", initialHiggsMass, 0., 1000.);
   z1mass_rrv = new RooRealVar("z1mass", "m_{Z1}", 0., 160.);
   z2mass_rrv = new RooRealVar("z2mass", "m_{Z2}", 0., 200.);
   costhetastar_rrv = new RooRealVar("costhetastar", "cos#theta^{*}", -1., 1.);
@@ -110,57 +154,56 @@ Mela::Mela(
   spin1Model = new VectorPdfFactory(z1mass_rrv, z2mass_rrv, costhetastar_rrv, costheta1_rrv, costheta2_rrv, phi_rrv, phi1_rrv, mzz_rrv);
   spin2Model = new TensorPdfFactory_HVV(measurables_, RooSpin::kVdecayType_Zll, RooSpin::kVdecayType_Zll);
   qqZZmodel = new RooqqZZ_JHU_ZgammaZZ_fast("qqZZmodel", "qqZZmodel", *z1mass_rrv, *z2mass_rrv, *costheta1_rrv, *costheta2_rrv, *phi_rrv, *costhetastar_rrv, *phi1_rrv, *mzz_rrv, *upFrac_rrv);
+}
 
-  if (myVerbosity_>=TVar::DEBUG) cout << "Paths for newZZMatrixElement" << endl;
-  const string path_HiggsWidthFile = MELAPKGPATH + "data/HiggsTotalWidth_YR3.txt";
-  if (myVerbosity_>=TVar::DEBUG) cout << "\t- Cross section/width file: " << path_HiggsWidthFile << endl;
-  const string path_nnpdf = MELAPKGPATH + "data/Pdfdata/NNPDF30_lo_as_0130.LHgrid";
-  char path_nnpdf_c[] = "Pdfdata/NNPDF30_lo_as_0130.LHgrid";
-  int pdfmember = 0;
-  if (myVerbosity_>=TVar::DEBUG) cout << "\t- Linking NNPDF path " << path_nnpdf.c_str() << " -> " << path_nnpdf_c << endl;
-  symlink(path_nnpdf.c_str(), path_nnpdf_c);
-  if (myVerbosity_>=TVar::DEBUG) cout << "Start newZZMatrixElement" << endl;
-  ZZME = new newZZMatrixElement(path_nnpdf_c, pdfmember, path_HiggsWidthFile.substr(0, path_HiggsWidthFile.length()-23).c_str(), 1000.*LHCsqrts/2., myVerbosity_);
-  if (myVerbosity_>=TVar::DEBUG) cout << "Set newZZMatrixElement masses" << endl;
-  setMelaPrimaryHiggsMass(mh_);
-  setMelaHiggsMass(mh_, 0); setMelaHiggsMass(-1., 1);
-  setMelaHiggsWidth(-1., 0); setMelaHiggsWidth(0., 1);
-  setMelaLeptonInterference(TVar::DefaultLeptonInterf);
-  setCandidateDecayMode(TVar::CandidateDecay_ZZ); // Default decay mode is ZZ at the start
-
-
-  /***** CONSTANTS FOR MATRIX ELEMENTS *****/
-  getPConstantHandles();
+void Mela::buildSuperMELA(){
+  if (super!=0) return;
 
-  /***** SuperMELA *****/
-  // Deactivate generation messages
-  RooMsgService::instance().getStream(1).removeTopic(NumIntegration);
-  RooMsgService::instance().setStreamStatus(1, kFALSE);
-  RooMsgService::instance().setStreamStatus(0, kFALSE);// silence also the error messages, but should really be looked at.
+#ifdef _melapkgpathstr_
+  const string MELAPKGPATH = _melapkgpathstr_;
+#else
+  cout << "MELA package path is undefined! Please modify the makefle or the makefile-equivalent!" << endl;
+  assert(0);
+#endif
+  const double maxSqrts = 8.;
 
-  myRandomNumber=new TRandom3(35797);
   if (myVerbosity_>=TVar::DEBUG) cout << "Start superMELA" << endl;
   int superMELA_LHCsqrts = LHCsqrts;
   if (superMELA_LHCsqrts > maxSqrts) superMELA_LHCsqrts = maxSqrts;
-  super = new SuperMELA(mh_, "4mu", superMELA_LHCsqrts); // preliminary intialization, we adjust the flavor later
+  super = new SuperMELA(initialHiggsMass, "4mu", superMELA_LHCsqrts); // preliminary intialization, we adjust the flavor later
   char cardpath[500];
   sprintf(cardpath, "data/CombinationInputs/SM_inputs_%dTeV/inputs_4mu.txt", superMELA_LHCsqrts);
   string cardfile = MELAPKGPATH + cardpath;
   super->SetPathToCards(cardfile.substr(0, cardfile.length()-14).c_str());
   super->SetVerbosity((myVerbosity_>=TVar::DEBUG));
   super->init();
-
-  reset_SelfDCouplings();
-  if (myVerbosity_>=TVar::DEBUG) cout << "End Mela constructor" << endl;
 }
+RooAbsPdf* Mela::getAnalyticalPdf(){ return pdf; }
+ScalarPdfFactory_ggH* Mela::getSpinZeroModel(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return ggSpin0Model; }
+VectorPdfFactory* Mela::getSpinOneModel(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return spin1Model; }
+TensorPdfFactory_HVV* Mela::getSpinTwoModel(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return spin2Model; }
+RooqqZZ_JHU_ZgammaZZ_fast* Mela::getqqZZModel(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return qqZZmodel; }
+RooRealVar* Mela::getMZZObservable(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return mzz_rrv; }
+RooRealVar* Mela::getZ1MassObservable(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return z1mass_rrv; }
+RooRealVar* Mela::getZ2MassObservable(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return z2mass_rrv; }
+RooRealVar* Mela::getCosThetaStarObservable(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return costhetastar_rrv; }
+RooRealVar* Mela::getCosTheta1Observable(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return costheta1_rrv; }
+RooRealVar* Mela::getCosTheta2Observable(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return costheta2_rrv; }
+RooRealVar* Mela::getPhiObservable(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return phi_rrv; }
+RooRealVar* Mela::getPhi1Observable(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return phi1_rrv; }
+RooRealVar* Mela::getYObservable(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return Y_rrv; }
+RooRealVar* Mela::getUpFracObservable(){ MelaContext::Lock contextLock(0); buildAnalyticalModels(); return upFrac_rrv; }
+SuperMELA* Mela::getSuperMELA(){ MelaContext::Lock contextLock(0); buildSuperMELA(); return super; }
 
 Mela::~Mela(){
   if (myVerbosity_>=TVar::DEBUG) cout << "Begin Mela destructor" << endl;
+  MelaContext::Lock contextLock(0);
 
   //setRemoveLeptonMasses(false); // Use Run 1 scheme for not removing lepton masses. Notice the switch itself is defined as an extern, so it has to be set to default value at the destructor!
   setRemoveLeptonMasses(true); // Use Run 2 scheme for removing lepton masses. Notice the switch itself is defined as an extern, so it has to be set to default value at the destructor!
 
   // Delete the derived RooFit objects first...
+  deleteAnalyticalIntegrals();
   delete ggSpin0Model;
   delete spin1Model;
   delete spin2Model;
@@ -211,6 +254,26 @@ void Mela::setMelaHiggsWidth(double myHiggsWidth, int index){ ZZME->set_wHiggs(m
 void Mela::setMelaHiggsMassWidth(double myHiggsMass, double myHiggsWidth, int index){ ZZME->set_mHiggs_wHiggs(myHiggsMass, myHiggsWidth, index); }
 void Mela::setMelaLeptonInterference(TVar::LeptonInterference myLepInterf){ myLepInterf_=myLepInterf; ZZME->set_LeptonInterference(myLepInterf); }
 void Mela::setCandidateDecayMode(TVar::CandidateDecayMode mode){ ZZME->set_CandidateDecayMode(mode); }
+void Mela::setCacheAnalyticalIntegrals(bool flag){
+  cacheAnalyticalIntegrals=flag;
+  if (!cacheAnalyticalIntegrals) deleteAnalyticalIntegrals();
+}
+void Mela::setMCFMConfigCaching(bool flag){ MelaContext::Lock contextLock(ZZME->get_Context()); TUtil::SetMCFMConfigCaching(flag); }
+void Mela::setCouplingPushTracking(bool flag){ MelaContext::Lock contextLock(ZZME->get_Context()); TUtil::SetCouplingPushTracking(flag); }
+void Mela::setPDFCaching(bool flag){ MelaContext::Lock contextLock(ZZME->get_Context()); TUtil::SetPDFCaching(flag); }
+void Mela::setHJJChannelCaching(bool flag){ MelaContext::Lock contextLock(ZZME->get_Context()); TUtil::SetHJJChannelCaching(flag); }
+void Mela::setVHHelicitySumming(bool flag){ MelaContext::Lock contextLock(ZZME->get_Context()); TUtil::SetVHHelicitySumming(flag); }
+void Mela::setLHAgrid(const char* path, int pdfmember){ ZZME->set_LHAgrid(path, pdfmember); }
+void Mela::setAngularIntegration(TVar::AngularIntegrationRule rule, unsigned int nCosThetaStar, unsigned int nPhi1){
+  angularIntegrator.setRule(rule, nCosThetaStar, nPhi1);
+  if (myVerbosity_>=TVar::INFO && (angularIntegrator.getNCosThetaStar()!=nCosThetaStar || angularIntegrator.getNPhi1()!=nPhi1)) cout
+    << "Mela::setAngularIntegration: Using " << angularIntegrator.getNCosThetaStar() << "x" << angularIntegrator.getNPhi1()
+    << " nodes instead of " << nCosThetaStar << "x" << nPhi1 << " for this rule." << endl;
+}
+void Mela::deleteAnalyticalIntegrals(){
+  for (std::map<RooAbsPdf*, RooAbsReal*>::iterator it=analyticalIntegrals.begin(); it!=analyticalIntegrals.end(); it++) delete it->second;
+  analyticalIntegrals.clear();
+}
 void Mela::setCurrentCandidateFromIndex(unsigned int icand){ ZZME->set_CurrentCandidateFromIndex(icand); }
 void Mela::setCurrentCandidate(MELACandidate* cand){ ZZME->set_CurrentCandidate(cand); }
 void Mela::setInputEvent(
@@ -284,14 +347,82 @@ void Mela::reset_SelfDCouplings(){
 
   // Did I tell you that we have a lot of them?
 }
+void Mela::storeSelfDCouplings(SelfDCouplingsRecord& record) const{
+  //****Spin-0****//
+  memcpy(record.Hggcoupl, selfDHggcoupl, sizeof(selfDHggcoupl));
+  memcpy(record.Hg4g4coupl, selfDHg4g4coupl, sizeof(selfDHg4g4coupl));
+  memcpy(record.Hqqcoupl, selfDHqqcoupl, sizeof(selfDHqqcoupl));
+  memcpy(record.Hbbcoupl, selfDHbbcoupl, sizeof(selfDHbbcoupl));
+  memcpy(record.Httcoupl, selfDHttcoupl, sizeof(selfDHttcoupl));
+  memcpy(record.Hb4b4coupl, selfDHb4b4coupl, sizeof(selfDHb4b4coupl));
+  memcpy(record.Ht4t4coupl, selfDHt4t4coupl, sizeof(selfDHt4t4coupl));
+  memcpy(record.Hzzcoupl, selfDHzzcoupl, sizeof(selfDHzzcoupl));
+  memcpy(record.Hwwcoupl, selfDHwwcoupl, sizeof(selfDHwwcoupl));
+  memcpy(record.HzzLambda_qsq, selfDHzzLambda_qsq, sizeof(selfDHzzLambda_qsq));
+  memcpy(record.HwwLambda_qsq, selfDHwwLambda_qsq, sizeof(selfDHwwLambda_qsq));
+  memcpy(record.HzzCLambda_qsq, selfDHzzCLambda_qsq, sizeof(selfDHzzCLambda_qsq));
+  memcpy(record.HwwCLambda_qsq, selfDHwwCLambda_qsq, sizeof(selfDHwwCLambda_qsq));
+  record.differentiate_HWW_HZZ = differentiate_HWW_HZZ;
+  //****Spin-1****//
+  memcpy(record.Zqqcoupl, selfDZqqcoupl, sizeof(selfDZqqcoupl));
+  memcpy(record.Zvvcoupl, selfDZvvcoupl, sizeof(selfDZvvcoupl));
+  //****Spin-2****//
+  memcpy(record.Gqqcoupl, selfDGqqcoupl, sizeof(selfDGqqcoupl));
+  memcpy(record.Gggcoupl, selfDGggcoupl, sizeof(selfDGggcoupl));
+  memcpy(record.Gvvcoupl, selfDGvvcoupl, sizeof(selfDGvvcoupl));
+}
+void Mela::restoreSelfDCouplings(const SelfDCouplingsRecord& record){
+  //****Spin-0****//
+  memcpy(selfDHggcoupl, record.Hggcoupl, sizeof(selfDHggcoupl));
+  memcpy(selfDHg4g4coupl, record.Hg4g4coupl, sizeof(selfDHg4g4coupl));
+  memcpy(selfDHqqcoupl, record.Hqqcoupl, sizeof(selfDHqqcoupl));
+  memcpy(selfDHbbcoupl, record.Hbbcoupl, sizeof(selfDHbbcoupl));
+  memcpy(selfDHttcoupl, record.Httcoupl, sizeof(selfDHttcoupl));
+  memcpy(selfDHb4b4coupl, record.Hb4b4coupl, sizeof(selfDHb4b4coupl));
+  memcpy(selfDHt4t4coupl, record.Ht4t4coupl, sizeof(selfDHt4t4coupl));
+  memcpy(selfDHzzcoupl, record.Hzzcoupl, sizeof(selfDHzzcoupl));
+  memcpy(selfDHwwcoupl, record.Hwwcoupl, sizeof(selfDHwwcoupl));
+  memcpy(selfDHzzLambda_qsq, record.HzzLambda_qsq, sizeof(selfDHzzLambda_qsq));
+  memcpy(selfDHwwLambda_qsq, record.HwwLambda_qsq, sizeof(selfDHwwLambda_qsq));
+  memcpy(selfDHzzCLambda_qsq, record.HzzCLambda_qsq, sizeof(selfDHzzCLambda_qsq));
+  memcpy(selfDHwwCLambda_qsq, record.HwwCLambda_qsq, sizeof(selfDHwwCLambda_qsq));
+  differentiate_HWW_HZZ = record.differentiate_HWW_HZZ;
+  //****Spin-1****//
+  memcpy(selfDZqqcoupl, record.Zqqcoupl, sizeof(selfDZqqcoupl));
+  memcpy(selfDZvvcoupl, record.Zvvcoupl, sizeof(selfDZvvcoupl));
+  //****Spin-2****//
+  memcpy(selfDGqqcoupl, record.Gqqcoupl, sizeof(selfDGqqcoupl));
+  memcpy(selfDGggcoupl, record.Gggcoupl, sizeof(selfDGggcoupl));
+  memcpy(selfDGvvcoupl, record.Gvvcoupl, sizeof(selfDGvvcoupl));
+}
+void Mela::storePerComputationSettings(PerComputationSettingsRecord& record) const{
+  for (int jh=0; jh<(int)nSupportedHiggses; jh++){
+    record.mHiggs[jh] = ZZME->get_mHiggs(jh);
+    record.wHiggs[jh] = ZZME->get_wHiggs(jh);
+  }
+  record.lepInterf = ZZME->get_LeptonInterference();
+}
+void Mela::restorePerComputationSettings(const PerComputationSettingsRecord& record){
+  for (int jh=0; jh<(int)nSupportedHiggses; jh++) setMelaHiggsMassWidth(record.mHiggs[jh], record.wHiggs[jh], jh);
+  setMelaLeptonInterference(record.lepInterf);
+}
 void Mela::resetMass(double inmass, int ipart){ ZZME->reset_Mass(inmass, ipart); }
 void Mela::resetWidth(double inwidth, int ipart){ ZZME->reset_Width(inwidth, ipart); }
 void Mela::resetQuarkMasses(){ ZZME->reset_QuarkMasses(); }
 void Mela::resetMCFM_EWKParameters(double ext_Gf, double ext_aemmz, double ext_mW, double ext_mZ, double ext_xW, int ext_ewscheme){
   ZZME->reset_MCFM_EWKParameters(ext_Gf, ext_aemmz, ext_mW, ext_mZ, ext_xW, ext_ewscheme);
 }
-void Mela::setRemoveLeptonMasses(bool MasslessLeptonSwitch){ TUtil::applyLeptonMassCorrection(MasslessLeptonSwitch); }
-void Mela::setRemoveJetMasses(bool MasslessLeptonSwitch){ TUtil::applyJetMassCorrection(MasslessLeptonSwitch); }
+void Mela::resetCKMElements(double invckm_ud, double invckm_us, double invckm_cd, double invckm_cs, double invckm_ts, double invckm_tb, double invckm_ub, double invckm_cb, double invckm_td){
+  ZZME->reset_CKMElements(invckm_ud, invckm_us, invckm_cd, invckm_cs, invckm_ts, invckm_tb, invckm_ub, invckm_cb, invckm_td);
+}
+void Mela::setRemoveLeptonMasses(bool MasslessLeptonSwitch){
+  if (ZZME!=0){ MelaContext::Lock contextLock(ZZME->get_Context()); ZZME->get_Context()->setLeptonMassCorrection(MasslessLeptonSwitch); }
+  else TUtil::applyLeptonMassCorrection(MasslessLeptonSwitch);
+}
+void Mela::setRemoveJetMasses(bool MasslessLeptonSwitch){
+  if (ZZME!=0){ MelaContext::Lock contextLock(ZZME->get_Context()); ZZME->get_Context()->setJetMassCorrection(MasslessLeptonSwitch); }
+  else TUtil::applyJetMassCorrection(MasslessLeptonSwitch);
+}
 void Mela::setRenFacScaleMode(TVar::EventScaleScheme renormalizationSch, TVar::EventScaleScheme factorizationSch, double ren_sf, double fac_sf){
   ZZME->set_RenFacScaleMode(renormalizationSch, factorizationSch, ren_sf, fac_sf);
 }
@@ -308,7 +439,33 @@ MELACandidate* Mela::getCurrentCandidate(){ return ZZME->get_CurrentCandidate();
 int Mela::getCurrentCandidateIndex(){ return ZZME->get_CurrentCandidateIndex(); }
 int Mela::getNCandidates(){ return ZZME->get_NCandidates(); }
 std::vector<MELATopCandidate*>* Mela::getTopCandidateCollection(){ return ZZME->get_TopCandidateCollection(); }
+const MELAEventArena* Mela::getEventArena(){ return ZZME->get_EventArena(); }
+// PDF and alpha_s cache statistics
+TUtil::PDFCacheStatistics Mela::getPDFCacheStatistics(){ MelaContext::Lock contextLock(ZZME->get_Context()); return TUtil::GetPDFCacheStatistics(); }
+void Mela::resetPDFCacheStatistics(){ MelaContext::Lock contextLock(ZZME->get_Context()); TUtil::ResetPDFCacheStatistics(); }
+TUtil::TTHPermutationStatistics Mela::getTTHPermutationStatistics(){ MelaContext::Lock contextLock(ZZME->get_Context()); return TUtil::GetTTHPermutationStatistics(); }
+void Mela::resetTTHPermutationStatistics(){ MelaContext::Lock contextLock(ZZME->get_Context()); TUtil::ResetTTHPermutationStatistics(); }
+TUtil::HJJChannelCacheStatistics Mela::getHJJChannelCacheStatistics(){ MelaContext::Lock contextLock(ZZME->get_Context()); return TUtil::GetHJJChannelCacheStatistics(); }
+void Mela::resetHJJChannelCacheStatistics(){ MelaContext::Lock contextLock(ZZME->get_Context()); TUtil::ResetHJJChannelCacheStatistics(); }
+void Mela::invalidateHJJChannelCache(){ MelaContext::Lock contextLock(ZZME->get_Context()); TUtil::InvalidateHJJChannelCache(); }
+TUtil::MCFMConfigCacheStatistics Mela::getMCFMConfigCacheStatistics(){ MelaContext::Lock contextLock(ZZME->get_Context()); return TUtil::GetMCFMConfigCacheStatistics(); }
+void Mela::resetMCFMConfigCacheStatistics(){ MelaContext::Lock contextLock(ZZME->get_Context()); TUtil::ResetMCFMConfigCacheStatistics(); }
+TUtil::CouplingPushStatistics Mela::getCouplingPushStatistics(){ MelaContext::Lock contextLock(ZZME->get_Context()); return TUtil::GetCouplingPushStatistics(); }
+void Mela::resetCouplingPushStatistics(){ MelaContext::Lock contextLock(ZZME->get_Context()); TUtil::ResetCouplingPushStatistics(); }
+float Mela::getAngularIntegrationError(){ return angularIntegrator.getError(); }
 void Mela::reset_CandRef(){ melaCand=0; }
+void Mela::getCandidateKinematics(MELACandidate* cand, std::vector<double>& kinematics) const{
+  kinematics.clear();
+  if (cand==0) return;
+  for (int ip=0; ip<cand->getNMothers(); ip++){
+    MELAParticle* part = cand->getMother(ip);
+    kinematics.push_back(part->id); kinematics.push_back(part->x()); kinematics.push_back(part->y()); kinematics.push_back(part->z()); kinematics.push_back(part->t());
+  }
+  for (int ip=0; ip<cand->getNDaughters(); ip++){
+    MELAParticle* part = cand->getDaughter(ip);
+    kinematics.push_back(part->id); kinematics.push_back(part->x()); kinematics.push_back(part->y()); kinematics.push_back(part->z()); kinematics.push_back(part->t());
+  }
+}
 
 
 // SuperProb
@@ -471,6 +628,7 @@ void Mela::computeP(
   bool useConstant
   ){
   if (myVerbosity_>=TVar::DEBUG) cout << "Mela: Begin computeP" << endl;
+  MelaContext::Lock contextLock(ZZME->get_Context());
   reset_PAux();
 
   melaCand = getCurrentCandidate();
@@ -479,6 +637,7 @@ void Mela::computeP(
     float mZZ=0, mZ1=0, mZ2=0, costheta1=0, costheta2=0, Phi=0, costhetastar=0, Phi1=0;
 
     if (myME_ == TVar::ANALYTICAL){
+      buildAnalyticalModels();
       computeDecayAngles(
         mZZ, mZ1, mZ2,
         costheta1, costheta2, Phi,
@@ -497,9 +656,16 @@ void Mela::computeP(
       bool computeAnaMELA = configureAnalyticalPDFs();
       if (computeAnaMELA){
         if (myProduction_==TVar::ZZINDEPENDENT){
-          RooAbsPdf* integral = (RooAbsPdf*)pdf->createIntegral(RooArgSet(*costhetastar_rrv, *phi1_rrv));
-          prob = integral->getVal();
-          delete integral;
+          if (cacheAnalyticalIntegrals){
+            RooAbsReal*& integral = analyticalIntegrals[pdf];
+            if (integral==0) integral = pdf->createIntegral(RooArgSet(*costhetastar_rrv, *phi1_rrv));
+            prob = integral->getVal();
+          }
+          else{
+            RooAbsPdf* integral = (RooAbsPdf*)pdf->createIntegral(RooArgSet(*costhetastar_rrv, *phi1_rrv));
+            prob = integral->getVal();
+            delete integral;
+          }
         }
         else prob = pdf->getVal();
       }
@@ -562,66 +728,26 @@ void Mela::computeP(
 
         }
 
-        prob = 0;
-        int gridsize_hs = 5;
-        double hs_min = 0; //-1.;
-        double hs_max = 1;
-        double hs_step = (hs_max - hs_min) / double(gridsize_hs);
-
-        int gridsize_phi1 = 5;
-        double phi1_min = 0; //-TMath::Pi();
-        double phi1_max = TMath::Pi();
-        double phi1_step = (phi1_max - phi1_min) / double(gridsize_phi1);
-
-        for (int i_hs = 0; i_hs < gridsize_hs + 1; i_hs++) {
-          double hs_val = hs_min + i_hs * hs_step;
-          for (int i_phi1 = 0; i_phi1 < gridsize_phi1 +1; i_phi1++) {
-            double phi1_val = phi1_min + i_phi1 * phi1_step;
-            float temp_prob=0;
-
-            // Get identical 4-vectors
-            SimpleParticleCollection_t daughters;
-            vector<TLorentzVector> pDauVec = calculate4Momentum(mZZ, mZ1, mZ2, acos(hs_val), acos(costheta1), acos(costheta2), phi1_val, Phi);
-            for (int iv=0; iv<2; iv++){
-              for (int idau=0; idau<min(2, melaCand->getSortedV(iv)->getNDaughters()); idau++){
-                SimpleParticle_t tmpPair(melaCand->getSortedV(iv)->getDaughter(idau)->id, pDauVec.at(2*iv+idau));
-                daughters.push_back(tmpPair);
-              }
+        // Integrate over (cos theta*, Phi1) with all points evaluated in one batch on a candidate updated in place
+        angularIntegrator.setEvent(mZZ, mZ1, mZ2, costheta1, costheta2, Phi, melaCand);
+        if (myVerbosity_>=TVar::DEBUG){ // Summarize the integrated particles
+          for (unsigned int ipoint=0; ipoint<angularIntegrator.getNPoints(); ipoint++){
+            const SimpleParticleCollection_t& daughters = angularIntegrator.getDaughters(ipoint);
+            cout << "Mela::computeP: hs, Phi1 are now " << angularIntegrator.getCosThetaStar(ipoint) << " " << angularIntegrator.getPhi1(ipoint) << endl;
+            for (unsigned int idau=0; idau<daughters.size(); idau++){
+              cout << "Dau " << idau << " "
+                << "id=" << daughters.at(idau).first << " "
+                << "x=" << daughters.at(idau).second.X() << " "
+                << "y=" << daughters.at(idau).second.Y() << " "
+                << "z=" << daughters.at(idau).second.Z() << " "
+                << "t=" << daughters.at(idau).second.T() << endl;
             }
-            if (myVerbosity_>=TVar::DEBUG){ // Summarize the integrated particles
-              cout << "Mela::computeP: hs, Phi1 are now " << hs_val << " " << phi1_val << endl;
-              for (unsigned int idau=0; idau<daughters.size(); idau++){
-                cout << "Dau " << idau << " "
-                  << "id=" << daughters.at(idau).first << " "
-                  << "x=" << daughters.at(idau).second.X() << " "
-                  << "y=" << daughters.at(idau).second.Y() << " "
-                  << "z=" << daughters.at(idau).second.Z() << " "
-                  << "t=" << daughters.at(idau).second.T() << endl;
-              }
-            }
-            vector<MELAParticle*> partList_tmp;
-            vector<MELACandidate*> candList_tmp;
-            MELACandidate* cand_tmp = TUtil::ConvertVectorFormat(
-              &daughters,
-              0,
-              0,
-              false,
-              &partList_tmp,
-              &candList_tmp
-              );
-            if (myVerbosity_>=TVar::ERROR && cand_tmp==0) cerr << "Mela::computeP: Failed to construct temporary candidate!" << endl;
-            setCurrentCandidate(cand_tmp);
-            if (myVerbosity_>=TVar::DEBUG && cand_tmp!=0){ cout << "Mela::computeP: ZZINDEPENDENT calculation produces candidate:" << endl; TUtil::PrintCandidateSummary(cand_tmp); }
-            // calculate the ME
-            ZZME->computeXS(temp_prob);
-            // Delete the temporary particles
-            for (unsigned int ic=0; ic<candList_tmp.size(); ic++){ if (candList_tmp.at(ic)!=0) delete candList_tmp.at(ic); } // Only one candidate should really be here
-            for (unsigned int ip=0; ip<partList_tmp.size(); ip++){ if (partList_tmp.at(ip)!=0) delete partList_tmp.at(ip); }
-            setCurrentCandidate(melaCand);
-            prob += temp_prob;
           }
         }
-        prob =  prob / float((gridsize_hs + 1) * (gridsize_phi1 +1));
+        vector<float> probList;
+        ZZME->computeXS_AngularGrid(angularIntegrator, probList);
+        prob = angularIntegrator.integrate(probList);
+        if (myVerbosity_>=TVar::DEBUG) cout << "Mela::computeP: Integral over " << probList.size() << " points is " << prob << " +- " << angularIntegrator.getError() << endl;
       }
     }
 
@@ -634,12 +760,159 @@ void Mela::computeP(
 }
 
 
+void Mela::computeP_batch(
+  TVar::Process myModel,
+  TVar::MatrixElement myME,
+  TVar::Production myProduction,
+  std::vector<SimpleParticleCollection_t>& daughtersList,
+  std::vector<float>& probList,
+  bool useConstant,
+  std::vector<SimpleParticleCollection_t>* associatedList,
+  std::vector<SimpleParticleCollection_t>* mothersList,
+  bool isGen
+  ){
+  if (myVerbosity_>=TVar::DEBUG) cout << "Mela: Begin computeP_batch" << endl;
+  MelaContext::Lock contextLock(ZZME->get_Context());
+  const unsigned int nEvents = daughtersList.size();
+  probList.assign(nEvents, 0);
+  if (
+    (associatedList!=0 && associatedList->size()!=nEvents)
+    ||
+    (mothersList!=0 && mothersList->size()!=nEvents)
+    ){
+    if (myVerbosity_>=TVar::ERROR) cerr << "Mela::computeP_batch: The sizes of the daughter, associated particle and mother lists do not match!" << endl;
+    reset_SelfDCouplings();
+    return;
+  }
+
+  setProcess(myModel, myME, myProduction);
+
+  if (
+    !useConstant
+    &&
+    (myME_ == TVar::JHUGen || myME_ == TVar::MCFM)
+    &&
+    !(myME_ == TVar::MCFM  && myProduction_ == TVar::ZZINDEPENDENT &&  (myModel_ == TVar::bkgZZ || myModel_ == TVar::bkgWW || myModel_ == TVar::bkgZGamma))
+    ){
+    // Couplings and process are passed only once, and TEvtProb recycles its own candidate per event.
+    if (myME_ == TVar::MCFM || myModel_ == TVar::SelfDefine_spin0) ZZME->set_SpinZeroCouplings(
+      selfDHggcoupl,
+      selfDHg4g4coupl,
+      selfDHqqcoupl,
+      selfDHbbcoupl,
+      selfDHttcoupl,
+      selfDHb4b4coupl,
+      selfDHt4t4coupl,
+      selfDHzzcoupl,
+      selfDHwwcoupl,
+      selfDHzzLambda_qsq,
+      selfDHwwLambda_qsq,
+      selfDHzzCLambda_qsq,
+      selfDHwwCLambda_qsq,
+      differentiate_HWW_HZZ
+      );
+    else if (myModel_ == TVar::SelfDefine_spin1) ZZME->set_SpinOneCouplings(selfDZqqcoupl, selfDZvvcoupl);
+    else if (myModel_ == TVar::SelfDefine_spin2) ZZME->set_SpinTwoCouplings(selfDGqqcoupl, selfDGggcoupl, selfDGvvcoupl);
+    ZZME->computeXS_Batch(daughtersList, probList, associatedList, mothersList, isGen);
+  }
+  else{
+    // Generic path: Every event is passed as a temporary candidate to computeP with the same couplings.
+    MELACandidate* origCand = getCurrentCandidate();
+    SelfDCouplingsRecord couplings;
+    storeSelfDCouplings(couplings);
+    PerComputationSettingsRecord settings;
+    storePerComputationSettings(settings);
+    for (unsigned int ev=0; ev<nEvents; ev++){
+      restoreSelfDCouplings(couplings);
+      restorePerComputationSettings(settings);
+      setCurrentCandidate(0); // Leaves prob=0 if the temporary candidate cannot be built
+      setTempCandidate(
+        &(daughtersList.at(ev)),
+        (associatedList!=0 ? &(associatedList->at(ev)) : 0),
+        (mothersList!=0 ? &(mothersList->at(ev)) : 0),
+        isGen
+        );
+      computeP(probList.at(ev), useConstant);
+    }
+    setCurrentCandidate(origCand);
+  }
+
+  reset_SelfDCouplings();
+  reset_CandRef();
+  if (myVerbosity_>=TVar::DEBUG) cout << "Mela: End computeP_batch" << endl;
+}
+
+Mela::Hypothesis::Hypothesis(TVar::Process process_, TVar::MatrixElement matrixElement_, TVar::Production production_, ComputationType computation_, bool useConstant_) :
+  process(process_),
+  matrixElement(matrixElement_),
+  production(production_),
+  computation(computation_),
+  useConstant(useConstant_),
+  includeHiggsDecay(false),
+  topProcess(2),
+  topDecay(0),
+  hasCouplings(false)
+{}
+void Mela::Hypothesis::setCouplings(const Mela& mela){
+  mela.storeSelfDCouplings(couplings);
+  hasCouplings=true;
+}
+void Mela::computeP_multi(
+  const std::vector<Hypothesis>& hypotheses,
+  std::vector<float>& probList
+  ){
+  if (myVerbosity_>=TVar::DEBUG) cout << "Mela: Begin computeP_multi" << endl;
+  MelaContext::Lock contextLock(ZZME->get_Context());
+  probList.assign(hypotheses.size(), 0);
+
+  TVar::Process origModel = myModel_;
+  TVar::MatrixElement origME = myME_;
+  TVar::Production origProduction = myProduction_;
+
+  TUtil::BeginSharedEventComputation();
+  for (unsigned int ih=0; ih<hypotheses.size(); ih++){
+    const Hypothesis& hypo = hypotheses.at(ih);
+    if (hypo.hasCouplings) restoreSelfDCouplings(hypo.couplings);
+    else reset_SelfDCouplings();
+    setProcess(hypo.process, hypo.matrixElement, hypo.production);
+
+    float& prob = probList.at(ih);
+    switch (hypo.computation){
+    case Hypothesis::kComputeP:
+      computeP(prob, hypo.useConstant);
+      break;
+    case Hypothesis::kComputeProdDecP:
+      computeProdDecP(prob, hypo.useConstant);
+      break;
+    case Hypothesis::kComputeProdP:
+      computeProdP(prob, hypo.useConstant);
+      break;
+    case Hypothesis::kComputeProdP_VH:
+      computeProdP_VH(prob, hypo.includeHiggsDecay, hypo.useConstant);
+      break;
+    case Hypothesis::kComputeProdP_ttH:
+      computeProdP_ttH(prob, hypo.topProcess, hypo.topDecay, hypo.useConstant);
+      break;
+    default:
+      if (myVerbosity_>=TVar::ERROR) cerr << "Mela::computeP_multi: Computation type " << hypo.computation << " of hypothesis " << ih << " is not supported!" << endl;
+      break;
+    }
+  }
+  TUtil::EndSharedEventComputation();
+
+  setProcess(origModel, origME, origProduction);
+  reset_SelfDCouplings();
+  if (myVerbosity_>=TVar::DEBUG) cout << "Mela: End computeP_multi" << endl;
+}
+
+
 void Mela::computeD_CP(
   TVar::MatrixElement myME,
   TVar::Process myType,
   float& prob
   ){
   if (myVerbosity_>=TVar::DEBUG) cout << "Mela: Begin computeD_CP" << endl;
+  MelaContext::Lock contextLock(ZZME->get_Context());
   double coupl_mix[nSupportedHiggses][SIZE_HVV][2] ={ { { 0 } } };
   double coupl_1[nSupportedHiggses][SIZE_HVV][2] ={ { { 0 } } };
   double coupl_2[nSupportedHiggses][SIZE_HVV][2] ={ { { 0 } } };
@@ -725,6 +998,189 @@ void Mela::computeD_CP(
 }
 
 
+bool Mela::isSelfDCoupling(const double* coupl) const{
+  const double* arrayBegin[14] ={
+    &(selfDHggcoupl[0][0][0]), &(selfDHg4g4coupl[0][0][0]),
+    &(selfDHqqcoupl[0][0][0]), &(selfDHbbcoupl[0][0][0]), &(selfDHttcoupl[0][0][0]), &(selfDHb4b4coupl[0][0][0]), &(selfDHt4t4coupl[0][0][0]),
+    &(selfDHzzcoupl[0][0][0]), &(selfDHwwcoupl[0][0][0]),
+    &(selfDZqqcoupl[0][0]), &(selfDZvvcoupl[0][0]),
+    &(selfDGqqcoupl[0][0]), &(selfDGggcoupl[0][0]), &(selfDGvvcoupl[0][0])
+  };
+  const unsigned int arraySize[14] ={
+    nSupportedHiggses*SIZE_HGG*2, nSupportedHiggses*SIZE_HGG*2,
+    nSupportedHiggses*SIZE_HQQ*2, nSupportedHiggses*SIZE_HQQ*2, nSupportedHiggses*SIZE_HQQ*2, nSupportedHiggses*SIZE_HQQ*2, nSupportedHiggses*SIZE_HQQ*2,
+    nSupportedHiggses*SIZE_HVV*2, nSupportedHiggses*SIZE_HVV*2,
+    SIZE_ZQQ*2, SIZE_ZVV*2,
+    SIZE_GQQ*2, SIZE_GGG*2, SIZE_GVV*2
+  };
+  for (unsigned int ia=0; ia<14; ia++){
+    if (coupl>=arrayBegin[ia] && coupl<arrayBegin[ia]+arraySize[ia]) return ((coupl-arrayBegin[ia])%2==0); // Has to point to the real part
+  }
+  return false;
+}
+void Mela::setCouplingDecompositionBasis(const std::vector<double*>& activeCouplings){
+  resetCouplingDecomposition();
+  for (unsigned int ic=0; ic<activeCouplings.size(); ic++){
+    if (!isSelfDCoupling(activeCouplings.at(ic))){
+      if (myVerbosity_>=TVar::ERROR) cerr << "Mela::setCouplingDecompositionBasis: Coupling " << ic << " does not point to the real part of a self-defined coupling of this Mela object!" << endl;
+      decompositionBasis.clear();
+      return;
+    }
+    decompositionBasis.push_back(activeCouplings.at(ic));
+  }
+}
+void Mela::resetCouplingDecomposition(){
+  decompositionMatrix_re.clear();
+  decompositionMatrix_im.clear();
+  decompositionKinematics.clear();
+}
+void Mela::computeCouplingDecomposition(bool useConstant){
+  if (myVerbosity_>=TVar::DEBUG) cout << "Mela: Begin computeCouplingDecomposition" << endl;
+  MelaContext::Lock contextLock(ZZME->get_Context());
+  resetCouplingDecomposition();
+
+  melaCand = getCurrentCandidate();
+  if (melaCand==0 || decompositionBasis.empty()){
+    if (myVerbosity_>=TVar::ERROR) cerr << "Mela::computeCouplingDecomposition: No candidate or no active couplings are present!" << endl;
+    reset_SelfDCouplings();
+    reset_CandRef();
+    return;
+  }
+  getCandidateKinematics(melaCand, decompositionKinematics);
+  decompositionModel = myModel_;
+  decompositionME = myME_;
+  decompositionProduction = myProduction_;
+  decompositionUseConstant = useConstant;
+
+  // Inactive couplings are kept as set by the user, active ones are varied on top of them.
+  for (unsigned int ic=0; ic<decompositionBasis.size(); ic++){ decompositionBasis.at(ic)[0]=0; decompositionBasis.at(ic)[1]=0; }
+  storeSelfDCouplings(decompositionCouplings);
+  // The mass, width and lepton interference are reset after each computeP as well.
+  storePerComputationSettings(decompositionSettings);
+
+  const unsigned int nActive = decompositionBasis.size();
+  const unsigned int nDim = nActive+1;
+  decompositionMatrix_re.assign(nDim*nDim, 0);
+  decompositionMatrix_im.assign(nDim*nDim, 0);
+
+  // MCFM computes with its SM couplings and the requested lepton interference if no self-defined coupling is set,
+  // which would only happen at the points where all active couplings vanish, so the anomalous coupling path is forced for all points.
+  ZZME->set_MCFMForceBSMHiggs(true);
+
+  // P(c) = sum_ij conj(c_i) c_j H_ij with c_0=1
+  // The subtractions below cancel large terms, so they are done in double precision.
+  float prob=0;
+  restoreSelfDCouplings(decompositionCouplings);
+  restorePerComputationSettings(decompositionSettings);
+  computeP(prob, useConstant);
+  const double pZero = prob;
+  decompositionMatrix_re.at(0) = pZero;
+
+  vector<double> pPlus(nActive, 0), pMinus(nActive, 0), pImag(nActive, 0);
+  for (unsigned int ic=0; ic<nActive; ic++){
+    restoreSelfDCouplings(decompositionCouplings);
+    restorePerComputationSettings(decompositionSettings);
+    decompositionBasis.at(ic)[0]=1;
+    computeP(prob, useConstant);
+    pPlus.at(ic) = prob;
+    restoreSelfDCouplings(decompositionCouplings);
+    restorePerComputationSettings(decompositionSettings);
+    decompositionBasis.at(ic)[0]=-1;
+    computeP(prob, useConstant);
+    pMinus.at(ic) = prob;
+    restoreSelfDCouplings(decompositionCouplings);
+    restorePerComputationSettings(decompositionSettings);
+    decompositionBasis.at(ic)[1]=1;
+    computeP(prob, useConstant);
+    pImag.at(ic) = prob;
+
+    unsigned int ii = ic+1;
+    double H_ii = (pPlus.at(ic)+pMinus.at(ic))/2.-pZero;
+    double ReH_0i = (pPlus.at(ic)-pMinus.at(ic))/4.;
+    double ImH_0i = -(pImag.at(ic)-pZero-H_ii)/2.;
+    decompositionMatrix_re.at(ii*nDim+ii) = H_ii;
+    decompositionMatrix_re.at(ii) = ReH_0i; decompositionMatrix_im.at(ii) = ImH_0i;
+    decompositionMatrix_re.at(ii*nDim) = ReH_0i; decompositionMatrix_im.at(ii*nDim) = -ImH_0i;
+  }
+  for (unsigned int ic=0; ic<nActive; ic++){
+    unsigned int ii = ic+1;
+    for (unsigned int jc=ic+1; jc<nActive; jc++){
+      unsigned int jj = jc+1;
+      restoreSelfDCouplings(decompositionCouplings);
+      restorePerComputationSettings(decompositionSettings);
+      decompositionBasis.at(ic)[0]=1; decompositionBasis.at(jc)[0]=1;
+      computeP(prob, useConstant);
+      const double pRe = prob;
+      restoreSelfDCouplings(decompositionCouplings);
+      restorePerComputationSettings(decompositionSettings);
+      decompositionBasis.at(ic)[0]=1; decompositionBasis.at(jc)[1]=1;
+      computeP(prob, useConstant);
+      const double pIm = prob;
+
+      // Subtract everything but the i-j interference, using P(c_k=1) = H_00 + H_kk + 2 Re H_0k
+      double ReH_ij = (pRe - pPlus.at(ic) - pPlus.at(jc) + pZero)/2.;
+      double ImH_ij = -(pIm - pPlus.at(ic) - pImag.at(jc) + pZero)/2.;
+      decompositionMatrix_re.at(ii*nDim+jj) = ReH_ij; decompositionMatrix_im.at(ii*nDim+jj) = ImH_ij;
+      decompositionMatrix_re.at(jj*nDim+ii) = ReH_ij; decompositionMatrix_im.at(jj*nDim+ii) = -ImH_ij;
+    }
+  }
+
+  ZZME->set_MCFMForceBSMHiggs(false);
+
+  // computeP resets the couplings and settings, so set them back to the inactive values
+  restoreSelfDCouplings(decompositionCouplings);
+  restorePerComputationSettings(decompositionSettings);
+  reset_CandRef();
+  if (myVerbosity_>=TVar::DEBUG) cout << "Mela: End computeCouplingDecomposition" << endl;
+}
+void Mela::computeP_fromDecomposition(
+  const std::vector< std::pair<double, double> >& activeCouplingValues,
+  float& prob
+  ){
+  prob=0;
+  if (activeCouplingValues.size()!=decompositionBasis.size()){
+    if (myVerbosity_>=TVar::ERROR) cerr << "Mela::computeP_fromDecomposition: The number of coupling values (" << activeCouplingValues.size() << ") does not match the number of active couplings (" << decompositionBasis.size() << ")!" << endl;
+    return;
+  }
+
+  // Recompute if the candidate or the process changed
+  vector<double> kinematics;
+  getCandidateKinematics(getCurrentCandidate(), kinematics);
+  if (
+    decompositionMatrix_re.empty()
+    ||
+    kinematics!=decompositionKinematics
+    ||
+    myModel_!=decompositionModel || myME_!=decompositionME || myProduction_!=decompositionProduction
+    ){
+    if (myVerbosity_>=TVar::DEBUG) cout << "Mela::computeP_fromDecomposition: Decomposition is recomputed." << endl;
+    bool useConstant = decompositionUseConstant;
+    if (!decompositionMatrix_re.empty()){ // Keep the same inactive couplings and settings as before
+      restoreSelfDCouplings(decompositionCouplings);
+      restorePerComputationSettings(decompositionSettings);
+    }
+    computeCouplingDecomposition(useConstant);
+    if (decompositionMatrix_re.empty()) return;
+  }
+
+  const unsigned int nDim = decompositionBasis.size()+1;
+  double result=0;
+  for (unsigned int ii=0; ii<nDim; ii++){
+    double ci_re = (ii==0 ? 1. : activeCouplingValues.at(ii-1).first);
+    double ci_im = (ii==0 ? 0. : activeCouplingValues.at(ii-1).second);
+    for (unsigned int jj=0; jj<nDim; jj++){
+      double cj_re = (jj==0 ? 1. : activeCouplingValues.at(jj-1).first);
+      double cj_im = (jj==0 ? 0. : activeCouplingValues.at(jj-1).second);
+      // Re(conj(c_i) c_j H_ij)
+      double cc_re = ci_re*cj_re + ci_im*cj_im;
+      double cc_im = ci_re*cj_im - ci_im*cj_re;
+      result += cc_re*decompositionMatrix_re.at(ii*nDim+jj) - cc_im*decompositionMatrix_im.at(ii*nDim+jj);
+    }
+  }
+  prob = result;
+}
+
+
 void Mela::computeProdDecP(
   double selfDHvvcoupl_input[nSupportedHiggses][SIZE_HVV][2],
   double selfDHwwcoupl_input[nSupportedHiggses][SIZE_HVV][2],
@@ -749,6 +1205,7 @@ void Mela::computeProdDecP(
   bool useConstant
   ){
   if (myVerbosity_>=TVar::DEBUG) cout << "Mela: Begin computeProdDecP" << endl;
+  MelaContext::Lock contextLock(ZZME->get_Context());
   reset_PAux();
   melaCand = getCurrentCandidate();
 
@@ -828,6 +1285,7 @@ void Mela::computeProdP(
   bool useConstant
   ){
   if (myVerbosity_>=TVar::DEBUG) cout << "Mela: Begin computeProdP" << endl;
+  MelaContext::Lock contextLock(ZZME->get_Context());
   if (myProduction_ == TVar::ttH || myProduction_ == TVar::bbH) computeProdP_ttH(prob, 2, 0, useConstant);
   else if (myProduction_ == TVar::Lep_ZH || myProduction_ == TVar::Lep_WH || myProduction_ == TVar::Had_ZH || myProduction_ == TVar::Had_WH || myProduction_ == TVar::GammaH) computeProdP_VH(prob, false, useConstant);
   else{
@@ -905,156 +1363,36 @@ void Mela::computeProdP(
           differentiate_HWW_HZZ
           );
         ZZME->computeProdXS_JJH(prob); // Higgs + 2 jets: SBF or WBF main probability
+        // A ren./fac. scale scheme set for this computation was reset by the call above, so the eta grid uses the default scales as before.
 
-        int nGrid=11;
-        std::vector<double> etaArray;
-        std::vector<double> pArray;
         double eta_max = 10;
         if (jet2massless.Pt()>0.) eta_max = max(eta_max, 1.2*fabs(jet2massless.Eta()));
         double eta_min = -eta_max;
+        jetEtaIntegrator.setJet(jet2massless, higgs+jet1massless, 1000.*LHCsqrts/2.);
+        jetEtaIntegrator.initialize(eta_min, eta_max, 11);
 
-        for (int iter=0; iter<nGrid; iter++){
-          float prob_temp=0;
-
-          double jet2temp_eta = ((double)iter)*(eta_max-eta_min) / (((double)nGrid) - 1.) + eta_min;
-          etaArray.push_back(jet2temp_eta);
-          double jet2temp_sinh_eta = TMath::SinH(jet2temp_eta);
-          double jet2temp_pz = jet2massless.Pt()*jet2temp_sinh_eta;
-          fakeJet.p4.SetZ(jet2temp_pz);
-          fakeJet.p4.SetX(jet2massless.X()); fakeJet.p4.SetY(jet2massless.Y()); fakeJet.p4.SetT(fakeJet.p4.P());
-
-          // Skip case with invalid pz
-          const double threshold = 1000.*LHCsqrts/2.;
-          TLorentzVector pTotal = higgs+jet1massless+fakeJet.p4;
-          double sys = (pTotal.T()+fabs(pTotal.Z()))/2.;
-          if (fabs(sys)<threshold){
-            if (myModel_ == TVar::SelfDefine_spin0) ZZME->set_SpinZeroCouplings(
-              selfDHggcoupl,
-              selfDHg4g4coupl,
-              selfDHqqcoupl,
-              selfDHbbcoupl,
-              selfDHttcoupl,
-              selfDHb4b4coupl,
-              selfDHt4t4coupl,
-              selfDHzzcoupl,
-              selfDHwwcoupl,
-              selfDHzzLambda_qsq,
-              selfDHwwLambda_qsq,
-              selfDHzzCLambda_qsq,
-              selfDHwwCLambda_qsq,
-              differentiate_HWW_HZZ
-              );
-            ZZME->computeProdXS_JJH(prob_temp);
-          }
-          pArray.push_back((double)prob_temp);
-        }
-
-        double* xGrid;
-        double* yGrid;
-        const double grid_precision = 0.15;
-        int ctr_iter=0;
-        for (int iG=0; iG<nGrid-1; iG++){ // For each spacing, first compare the average of end points to spline value
-          if (pArray[iG]==pArray[iG+1]) continue;
-          if (etaArray[iG]==etaArray[iG+1]) continue;
-
-          ctr_iter++;
-
-          xGrid = new double[nGrid];
-          yGrid = new double[nGrid];
-          for (int iter=0; iter<nGrid; iter++){ // Fill the arrays
-            xGrid[iter] = (double)etaArray[iter];
-            yGrid[iter] = (double)pArray[iter];
-          }
-
-          TGraph* interpolator = new TGraph(nGrid, xGrid, yGrid);
-          double derivative_first = (yGrid[1]-yGrid[0])/(xGrid[1]-xGrid[0]);
-          double derivative_last = (yGrid[nGrid-1]-yGrid[nGrid-2])/(xGrid[nGrid-1]-xGrid[nGrid-2]);
-          TSpline3* spline = new TSpline3("spline", interpolator, "b1e1", derivative_first, derivative_last);
-          double x_middle = (xGrid[iG]+xGrid[iG+1])*0.5;
-          double y_middle = (yGrid[iG]+yGrid[iG+1])*0.5;
-          double y_sp = spline->Eval(x_middle);
-          if (y_sp<0) y_sp = 0;
-
-          std::vector<double>::iterator gridIt;
-
-          if (fabs(y_sp-y_middle)<grid_precision*fabs(y_middle) || fabs(xGrid[iG+1]-xGrid[iG])<1e-3){
-            gridIt = pArray.begin()+iG+1;
-            pArray.insert(gridIt, y_sp);
-            gridIt = etaArray.begin()+iG+1;
-            etaArray.insert(gridIt, x_middle);
-            iG++; // Pass to next bin
-          }
-          else{
-            float prob_temp=0;
-
-            double jet2temp_eta = x_middle;
-            gridIt = etaArray.begin()+iG+1;
-            etaArray.insert(gridIt, x_middle);
-            double jet2temp_sinh_eta = TMath::SinH(jet2temp_eta);
-            double jet2temp_pz = jet2massless.Pt()*jet2temp_sinh_eta;
-            fakeJet.p4.SetZ(jet2temp_pz);
-            fakeJet.p4.SetX(jet2massless.X()); fakeJet.p4.SetY(jet2massless.Y()); fakeJet.p4.SetT(fakeJet.p4.P());
-
-            // Skip case with invalid pz
-            const double threshold = 1000.*LHCsqrts/2.;
-            TLorentzVector pTotal = higgs+jet1massless+fakeJet.p4;
-            double sys = (pTotal.T()+fabs(pTotal.Z()))/2.;
-            if (fabs(sys)<threshold){
-              if (myModel_ == TVar::SelfDefine_spin0) ZZME->set_SpinZeroCouplings(
-                selfDHggcoupl,
-                selfDHg4g4coupl,
-                selfDHqqcoupl,
-                selfDHbbcoupl,
-                selfDHttcoupl,
-                selfDHb4b4coupl,
-                selfDHt4t4coupl,
-                selfDHzzcoupl,
-                selfDHwwcoupl,
-                selfDHzzLambda_qsq,
-                selfDHwwLambda_qsq,
-                selfDHzzCLambda_qsq,
-                selfDHwwCLambda_qsq,
-                differentiate_HWW_HZZ
-                );
-              ZZME->computeProdXS_JJH(prob_temp);
-            }
-            gridIt = pArray.begin()+iG+1;
-            pArray.insert(gridIt, (double)prob_temp);
-            iG--; // Do not pass to next bin, repeat until precision is achieved.
-          }
-          nGrid++;
-
-          delete spline;
-          delete interpolator;
-          delete xGrid;
-          delete yGrid;
-        }
+        // The couplings are restored for each point of the integration, so they need to be set only once
+        if (myModel_ == TVar::SelfDefine_spin0) ZZME->set_SpinZeroCouplings(
+          selfDHggcoupl,
+          selfDHg4g4coupl,
+          selfDHqqcoupl,
+          selfDHbbcoupl,
+          selfDHttcoupl,
+          selfDHb4b4coupl,
+          selfDHt4t4coupl,
+          selfDHzzcoupl,
+          selfDHwwcoupl,
+          selfDHzzLambda_qsq,
+          selfDHwwLambda_qsq,
+          selfDHzzCLambda_qsq,
+          selfDHwwCLambda_qsq,
+          differentiate_HWW_HZZ
+          );
+        ZZME->computeProdXS_JJH_JetEtaIntegration(jetEtaIntegrator, &fakeJet);
 
-        if (myVerbosity_>=TVar::DEBUG) cout << "Mela::computeProdP: Number of iterations for JVBF eta integration: " << ctr_iter << endl;
+        if (myVerbosity_>=TVar::DEBUG) cout << "Mela::computeProdP: Number of iterations for JVBF eta integration: " << jetEtaIntegrator.getNIterations() << " over " << jetEtaIntegrator.getNPoints() << " points" << endl;
 
-        auxiliaryProb = 0;
-        int iGFirst=0, iGLast=nGrid-1;
-        for (int iG=1; iG<nGrid; iG++){
-          if (pArray[iG]>0 && pArray[iG-1]==0){
-            iGFirst = iG-1;
-            break;
-          }
-        }
-        for (int iG=nGrid-2; iG>=0; iG--){
-          if (pArray[iG]>0 && pArray[iG+1]==0){
-            iGLast = iG+1;
-            break;
-          }
-        }
-        double dEtaGrid = etaArray[iGLast] - etaArray[iGFirst];
-        for (int iG=iGFirst; iG<iGLast-1; iG++){
-          double dEta = etaArray[iG+1] - etaArray[iG];
-          double sumProb = pArray[iG]+pArray[iG+1];
-          sumProb *= 0.5;
-          dEta = dEta/dEtaGrid;
-          double addProb = sumProb*dEta;
-          auxiliaryProb += (float)addProb;
-        }
+        auxiliaryProb = jetEtaIntegrator.integrate();
 
         firstJet->p4.SetXYZT(jet1.X(), jet1.Y(), jet1.Z(), jet1.T()); // Re-assign momenta of the first jet to original. Be careful, it changes candOriginal as well!
         delete candCopy; // Delete the shallow copy
@@ -1130,6 +1468,7 @@ void Mela::computeProdP_VH(
   bool useConstant
   ){
   if (myVerbosity_>=TVar::DEBUG) cout << "Mela: Begin computeProdP_VH" << endl;
+  MelaContext::Lock contextLock(ZZME->get_Context());
   reset_PAux();
 
   melaCand = getCurrentCandidate();
@@ -1170,6 +1509,7 @@ void Mela::computeProdP_ttH(
   bool useConstant
   ){
   if (myVerbosity_>=TVar::DEBUG) cout << "Mela: Begin computeProdP_ttH" << endl;
+  MelaContext::Lock contextLock(ZZME->get_Context());
   reset_PAux();
 
   melaCand = getCurrentCandidate();
@@ -1200,6 +1540,7 @@ void Mela::computeProdP_ttH(
 }
 
 void Mela::getXPropagator(TVar::ResonancePropagatorScheme scheme, float& prop){
+  MelaContext::Lock contextLock(ZZME->get_Context());
   prop=0.;
   melaCand = getCurrentCandidate();
   if (melaCand!=0) ZZME->get_XPropagator(scheme, prop);
@@ -1208,6 +1549,7 @@ void Mela::getXPropagator(TVar::ResonancePropagatorScheme scheme, float& prop){
 
 
 void Mela::compute4FermionWeight(float& w){ // Lepton interference using JHUGen
+  MelaContext::Lock contextLock(ZZME->get_Context());
   reset_PAux();
 
   melaCand = getCurrentCandidate();
@@ -1265,6 +1607,8 @@ void Mela::compute4FermionWeight(float& w){ // Lepton interference using JHUGen
 
 
 void Mela::computePM4l(TVar::SuperMelaSyst syst, float& prob){
+  MelaContext::Lock contextLock(ZZME->get_Context());
+  buildSuperMELA();
   reset_PAux();
   prob=-99;
 
@@ -1339,6 +1683,7 @@ void Mela::computeD_gg(
   TVar::Process myType,
   float& prob
   ){
+  MelaContext::Lock contextLock(ZZME->get_Context());
   prob=-99;
   if (myME != TVar::MCFM || myType != TVar::D_gg10){
     cout << "Only support MCFM and D_gg10"<<endl;
@@ -1884,6 +2229,7 @@ float Mela::getConstant_2l2q(){
   constant = constant_tmp;
   return constant;
 }
+// The handles only record their file and spline names, the functions are read on the first evaluation
 void Mela::getPConstantHandles(){
   if (myVerbosity_>=TVar::DEBUG) cout << "Begin Mela::getPConstantHandles" << endl;
 
@@ -2008,7 +2354,10 @@ MelaPConstant* Mela::getPConstantHandle(
   const string path = MELAPKGPATH + "data/";
   string cfile_fullpath = path;
   cfile_fullpath.append(relpath);
-  cfile_fullpath.append(".root");
+  // Binary tables made by MelaPConstant::ConvertFile (test/convertPConstants.c) are preferred if present
+  struct stat binStat;
+  if (stat((cfile_fullpath + ".mpc").c_str(), &binStat)==0) cfile_fullpath.append(".mpc");
+  else cfile_fullpath.append(".root");
   if (myVerbosity_>=TVar::DEBUG) cout << "Mela::getPConstantHandle: path and spline name: " << path << ", " << spname << endl;
   if (myVerbosity_>=TVar::DEBUG) cout << "Mela::getPConstantHandle: Full path and spline name: " << cfile_fullpath << ", " << spname << endl;
   MelaPConstant* pchandle = new MelaPConstant(me_, prod_, proc_, cfile_fullpath.c_str(), spname);
@@ -0,0 +1,237 @@
+#include <iostream>
+#include <cmath>
+#include "MelaAngularIntegrator.h"
+#include "TUtil.hh"
+#include "PDGHelpers.h"
+#include "TMath.h"
+
+
+using namespace std;
+
+
+MelaAngularIntegrator::MelaAngularIntegrator() :
+rule(TVar::AngularIntegration_LegacyGrid),
+hsCheckStep(1),
+phi1CheckStep(1),
+lastError(0),
+cand(0),
+candDecayMode(TVar::CandidateDecay_Stable)
+{
+  setRule(TVar::AngularIntegration_LegacyGrid, 6, 6);
+}
+MelaAngularIntegrator::~MelaAngularIntegrator(){ deleteCandidate(); }
+
+void MelaAngularIntegrator::deleteCandidate(){
+  if (cand!=0) delete cand; // Deletes the sorted Vs
+  for (unsigned int ip=0; ip<candParticles.size(); ip++){ if (candParticles.at(ip)!=0) delete candParticles.at(ip); }
+  candParticles.clear();
+  candIds.clear();
+  cand=0;
+}
+
+void MelaAngularIntegrator::setRule(TVar::AngularIntegrationRule rule_, unsigned int nCosThetaStar, unsigned int nPhi1){
+  rule = rule_;
+  if (rule==TVar::AngularIntegration_ClenshawCurtis){
+    if (nCosThetaStar<3) nCosThetaStar=3;
+    if (nCosThetaStar%2==0) nCosThetaStar++;
+    if (nPhi1<3) nPhi1=3;
+    if (nPhi1%2==0) nPhi1++;
+  }
+  else{
+    if (nCosThetaStar==0) nCosThetaStar=1;
+    if (nPhi1==0) nPhi1=1;
+  }
+  hsNodes.assign(nCosThetaStar, 0.);
+  phi1Nodes.assign(nPhi1, 0.);
+  hsWeights.assign(nCosThetaStar, 0.);
+  phi1Weights.assign(nPhi1, 0.);
+
+  if (rule==TVar::AngularIntegration_ClenshawCurtis){
+    // Clenshaw-Curtis nodes cos(k*pi/N), k=0...N on [-1, 1] with N=2*(nCosThetaStar-1).
+    // Only the nodes with cos theta*>=0 are kept, and the weights of the +-cos theta* pairs are folded together.
+    const int N = 2*(nCosThetaStar-1);
+    for (unsigned int i=0; i<nCosThetaStar; i++){
+      const int k = N/2-(int)i; // Nodes in ascending order
+      hsNodes.at(i) = (k==N/2 ? 0. : cos(double(k)*TMath::Pi()/double(N)));
+      double sum=1;
+      for (int j=1; j<=N/2; j++) sum -= (j==N/2 ? 1. : 2.)/double(4*j*j-1)*cos(double(2*j*k)*TMath::Pi()/double(N));
+      double wgt = (k==0 ? 1. : 2.)/double(N)*sum;
+      if (k==N/2) wgt /= 2.;
+      hsWeights.at(i) = wgt; // Sum of weights is 1
+    }
+    // Same rule with every other node
+    const int Nc = N/2;
+    hsWeightsCheck.assign(nCosThetaStar/2+1, 0.);
+    for (unsigned int i=0; i<hsWeightsCheck.size(); i++){
+      const int k = Nc/2-(int)i;
+      double sum=1;
+      for (int j=1; j<=Nc/2; j++) sum -= (j==Nc/2 ? 1. : 2.)/double(4*j*j-1)*cos(double(2*j*k)*TMath::Pi()/double(Nc));
+      double wgt = (k==0 ? 1. : 2.)/double(Nc)*sum;
+      if (k==Nc/2) wgt /= 2.;
+      hsWeightsCheck.at(i) = wgt;
+    }
+    hsCheckStep=2;
+
+    // Trapezoidal rule in Phi1 over [0, pi], equivalent to the periodic trapezoidal rule over [0, 2pi) for a function even in Phi1.
+    // It is exact for harmonics cos(m*Phi1) with m<2*(nPhi1-1).
+    const int M = nPhi1-1;
+    for (unsigned int i=0; i<nPhi1; i++){
+      phi1Nodes.at(i) = double(i)*TMath::Pi()/double(M);
+      phi1Weights.at(i) = (i==0 || (int)i==M ? 0.5 : 1.)/double(M);
+    }
+    phi1WeightsCheck.assign(nPhi1/2+1, 0.);
+    for (unsigned int i=0; i<phi1WeightsCheck.size(); i++) phi1WeightsCheck.at(i) = (i==0 || i==phi1WeightsCheck.size()-1 ? 0.5 : 1.)/double(M/2);
+    phi1CheckStep=2;
+  }
+  else{
+    // Same nodes as the original 6x6 grid for the default sizes
+    double hs_min = 0; //-1.;
+    double hs_max = 1;
+    double hs_step = (nCosThetaStar>1 ? (hs_max - hs_min) / double(nCosThetaStar-1) : 0.);
+    double phi1_min = 0; //-TMath::Pi();
+    double phi1_max = TMath::Pi();
+    double phi1_step = (nPhi1>1 ? (phi1_max - phi1_min) / double(nPhi1-1) : 0.);
+    for (unsigned int i=0; i<nCosThetaStar; i++){
+      hsNodes.at(i) = hs_min + i * hs_step;
+      hsWeights.at(i) = 1./double(nCosThetaStar);
+    }
+    for (unsigned int i=0; i<nPhi1; i++){
+      phi1Nodes.at(i) = phi1_min + i * phi1_step;
+      phi1Weights.at(i) = 1./double(nPhi1);
+    }
+    // The error is estimated from the trapezoidal rule on the same nodes
+    hsWeightsCheck.assign(nCosThetaStar, 1.);
+    for (unsigned int i=0; i<nCosThetaStar; i++){ if (nCosThetaStar>1) hsWeightsCheck.at(i) = (i==0 || i==nCosThetaStar-1 ? 0.5 : 1.)/double(nCosThetaStar-1); }
+    hsCheckStep=1;
+    phi1WeightsCheck.assign(nPhi1, 1.);
+    for (unsigned int i=0; i<nPhi1; i++){ if (nPhi1>1) phi1WeightsCheck.at(i) = (i==0 || i==nPhi1-1 ? 0.5 : 1.)/double(nPhi1-1); }
+    phi1CheckStep=1;
+  }
+}
+
+void MelaAngularIntegrator::setEvent(double mZZ, double mZ1, double mZ2, double costheta1, double costheta2, double Phi, const MELACandidate* cand_){
+  // Ids of the daughters, at most two per V
+  dauIds.clear();
+  dauIndices.clear();
+  if (cand_!=0){
+    for (int iv=0; iv<2; iv++){
+      MELAParticle* Vi = cand_->getSortedV(iv);
+      if (Vi==0) continue;
+      for (int idau=0; idau<min(2, Vi->getNDaughters()); idau++){
+        dauIds.push_back(Vi->getDaughter(idau)->id);
+        dauIndices.push_back(2*iv+idau);
+      }
+    }
+  }
+
+  // Same arithmetic as newZZMatrixElement::Calculate4Momentum, split into the cos theta*-dependent boosts and the Phi1-dependent momenta in the V frames
+  double Mx=mZZ, M1=mZ1, M2=mZ2;
+  double theta1=acos(costheta1), theta2=acos(costheta2);
+
+  double gamma1=1, gamma2=1, beta1=0, beta2=0;
+
+  if (M1>0. && Mx>0.){
+    gamma1=(Mx*Mx+M1*M1-M2*M2)/(2*Mx*M1);
+    beta1=sqrt(1.-1./(gamma1*gamma1));
+  }
+  if (M2>0. && Mx>0.){
+    gamma2=(Mx*Mx-M1*M1+M2*M2)/(2*Mx*M2);
+    beta2=sqrt(1.-1./(gamma2*gamma2));
+  }
+
+  Z1ToZ.resize(hsNodes.size());
+  Z2ToZ.resize(hsNodes.size());
+  for (unsigned int ih=0; ih<hsNodes.size(); ih++){
+    double theta=acos(hsNodes.at(ih));
+    Z1ToZ.at(ih) = TLorentzRotation();
+    Z2ToZ.at(ih) = TLorentzRotation();
+    Z1ToZ.at(ih).Boost(0, 0, beta1);
+    Z2ToZ.at(ih).Boost(0, 0, beta2);
+    Z1ToZ.at(ih).RotateY(theta);
+    Z2ToZ.at(ih).RotateY(TMath::Pi()+theta);
+  }
+
+  pZ1Daughters.resize(2*phi1Nodes.size());
+  pZ2Daughters.resize(2*phi1Nodes.size());
+  for (unsigned int ip=0; ip<phi1Nodes.size(); ip++){
+    double phi1, phi2;
+    phi1=TMath::Pi()-phi1Nodes.at(ip);
+    phi2=phi1Nodes.at(ip)+Phi;
+    pZ1Daughters.at(2*ip).SetXYZT((M1/2)*sin(theta1)*cos(phi1), (M1/2)*sin(theta1)*sin(phi1), (M1/2)*cos(theta1), (M1/2)*1);
+    pZ1Daughters.at(2*ip+1).SetXYZT(-(M1/2)*sin(theta1)*cos(phi1), -(M1/2)*sin(theta1)*sin(phi1), -(M1/2)*cos(theta1), (M1/2)*1);
+    pZ2Daughters.at(2*ip).SetXYZT((M2/2)*sin(theta2)*cos(phi2), (M2/2)*sin(theta2)*sin(phi2), (M2/2)*cos(theta2), (M2/2)*1);
+    pZ2Daughters.at(2*ip+1).SetXYZT(-(M2/2)*sin(theta2)*cos(phi2), -(M2/2)*sin(theta2)*sin(phi2), -(M2/2)*cos(theta2), (M2/2)*1);
+  }
+}
+
+void MelaAngularIntegrator::setPointMomenta(unsigned int ipoint){
+  const unsigned int ih = ipoint/phi1Nodes.size();
+  const unsigned int ip = ipoint%phi1Nodes.size();
+  pointMomenta.resize(dauIds.size());
+  for (unsigned int idau=0; idau<dauIds.size(); idau++){
+    const int index = dauIndices.at(idau);
+    if (index<2) pointMomenta.at(idau) = Z1ToZ.at(ih)*pZ1Daughters.at(2*ip+index);
+    else pointMomenta.at(idau) = Z2ToZ.at(ih)*pZ2Daughters.at(2*ip+index-2);
+  }
+}
+
+const SimpleParticleCollection_t& MelaAngularIntegrator::getDaughters(unsigned int ipoint){
+  setPointMomenta(ipoint);
+  pointDaughters.clear();
+  for (unsigned int idau=0; idau<dauIds.size(); idau++) pointDaughters.push_back(SimpleParticle_t(dauIds.at(idau), pointMomenta.at(idau)));
+  return pointDaughters;
+}
+
+MELACandidate* MelaAngularIntegrator::setPoint(unsigned int ipoint){
+  if (dauIds.empty() || ipoint>=getNPoints()) return 0;
+  if (cand==0 || candIds!=dauIds || candDecayMode!=PDGHelpers::HDecayMode){
+    deleteCandidate();
+    getDaughters(ipoint);
+    cand = TUtil::ConvertVectorFormat(
+      &pointDaughters,
+      0,
+      0,
+      false,
+      &candParticles,
+      0
+      );
+    if (cand==0){ deleteCandidate(); return cand; }
+    candIds = dauIds;
+    candDecayMode = PDGHelpers::HDecayMode;
+  }
+  else{
+    setPointMomenta(ipoint);
+    TUtil::UpdateCandidateDaughterMomenta(cand, candParticles, pointMomenta);
+  }
+  return cand;
+}
+
+double MelaAngularIntegrator::integrateWith(const std::vector<float>& values, const std::vector<double>& wgts_hs, unsigned int step_hs, const std::vector<double>& wgts_phi1, unsigned int step_phi1)const{
+  double sum=0;
+  for (unsigned int ih=0; ih<wgts_hs.size(); ih++){
+    double sum_phi1=0;
+    for (unsigned int ip=0; ip<wgts_phi1.size(); ip++) sum_phi1 += wgts_phi1.at(ip)*values.at(ih*step_hs*phi1Nodes.size()+ip*step_phi1);
+    sum += wgts_hs.at(ih)*sum_phi1;
+  }
+  return sum;
+}
+
+double MelaAngularIntegrator::integrate(const std::vector<float>& values){
+  lastError=0;
+  if (values.size()!=getNPoints()){
+    cerr << "MelaAngularIntegrator::integrate: " << values.size() << " values are passed for " << getNPoints() << " points!" << endl;
+    return 0;
+  }
+
+  double result;
+  if (rule==TVar::AngularIntegration_LegacyGrid){ // Accumulate as the original grid did
+    float sum=0;
+    for (unsigned int i=0; i<values.size(); i++) sum += values.at(i);
+    result = sum / float(values.size());
+  }
+  else result = integrateWith(values, hsWeights, 1, phi1Weights, 1);
+
+  // Differences to the rules used for checks in each variable
+  lastError = fabs(result - integrateWith(values, hsWeightsCheck, hsCheckStep, phi1Weights, 1)) + fabs(result - integrateWith(values, hsWeights, 1, phi1WeightsCheck, phi1CheckStep));
+  return result;
+}
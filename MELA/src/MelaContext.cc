@@ -0,0 +1,195 @@
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include "MelaContext.h"
+#include "TUtil.hh"
+#include "PDGHelpers.h"
+
+
+using namespace std;
+
+
+namespace{
+  // Process-wide state shared by all contexts, guarded by globalStateMutex
+  std::recursive_mutex globalStateMutex;
+  MelaContext* activeContext=0;
+  MelaContext* requestedContext=0; // Context requested by the innermost lock held
+  std::map<int, double> defaultMasses; // Values before any context has set them
+  std::map<int, double> defaultWidths;
+  // MCFM EW inputs before any context has set them, which SetEwkCouplingParameters passes to JHUGen as well
+  bool hasDefaultEwkParameters=false;
+  double defaultEwk_Gf=0;
+  double defaultEwk_aemmz=0;
+  double defaultEwk_mW=0;
+  double defaultEwk_mZ=0;
+  double defaultEwk_xW=0;
+  int defaultEwk_ewscheme=3;
+  std::string loadedPDFPath;
+  int loadedPDFMember=-1;
+  bool isCKMModified=false; // Set once any context sets the CKM elements
+
+  void loadLHAgrid(const std::string& path, int pdfmember){
+    char path_nnpdf_c[500];
+    snprintf(path_nnpdf_c, sizeof(path_nnpdf_c), "%s", path.c_str());
+    int pathLength = strlen(path_nnpdf_c);
+    nnpdfdriver_(path_nnpdf_c, &pathLength);
+    nninitpdf_(&pdfmember);
+    TUtil::InvalidatePDFCache();
+    loadedPDFPath = path;
+    loadedPDFMember = pdfmember;
+  }
+  void recordDefaultEwkParameters(){
+    if (hasDefaultEwkParameters) return;
+    hasDefaultEwkParameters=true;
+    defaultEwk_Gf=ewinput_.Gf_inp;
+    defaultEwk_aemmz=ewinput_.aemmz_inp;
+    defaultEwk_mW=ewinput_.wmass_inp;
+    defaultEwk_mZ=ewinput_.zmass_inp;
+    defaultEwk_xW=ewinput_.xw_inp;
+    defaultEwk_ewscheme=ewscheme_.ewscheme;
+  }
+}
+
+
+MelaContext::Lock::Lock(MelaContext* context_){
+  globalStateMutex.lock();
+  previous = requestedContext; // Non-null only for a lock nested in the same thread
+  if (context_!=0){
+    requestedContext = context_;
+    context_->activate();
+  }
+}
+MelaContext::Lock::~Lock(){
+  requestedContext = previous;
+  if (previous!=0) previous->activate();
+  globalStateMutex.unlock();
+}
+
+
+MelaContext::MelaContext(double ebeam_) :
+  ebeam(ebeam_),
+  forbidMassiveLeptons(TUtil::forbidMassiveLeptons),
+  forbidMassiveJets(TUtil::forbidMassiveJets),
+  LeptonMassScheme(TUtil::LeptonMassScheme),
+  JetMassScheme(TUtil::JetMassScheme),
+  HDecayMode(PDGHelpers::HDecayMode),
+  hasEwkParameters(false),
+  ewk_Gf(0), ewk_aemmz(0), ewk_mW(0), ewk_mZ(0), ewk_xW(0), ewk_ewscheme(3),
+  pdfPath(""),
+  pdfMember(0),
+  hasCKMElements(false),
+  state(TUtil::CreateContextState())
+{
+  for (unsigned int ic=0; ic<9; ic++) ckmElements[ic]=-1;
+}
+MelaContext::~MelaContext(){
+  // Global settings applied by this context are overwritten by the next one to be activated.
+  Lock lock(0);
+  if (activeContext==this) activeContext=0;
+  if (requestedContext==this) requestedContext=0;
+  TUtil::DeleteContextState(state);
+}
+
+bool MelaContext::isActive() const{ return (activeContext==this); }
+
+void MelaContext::setLeptonMassCorrection(bool flag){ forbidMassiveLeptons=flag; if (isActive()) TUtil::applyLeptonMassCorrection(flag); }
+void MelaContext::setJetMassCorrection(bool flag){ forbidMassiveJets=flag; if (isActive()) TUtil::applyJetMassCorrection(flag); }
+void MelaContext::setLeptonMassScheme(TVar::FermionMassRemoval scheme){ LeptonMassScheme=scheme; if (isActive()) TUtil::setLeptonMassScheme(scheme); }
+void MelaContext::setJetMassScheme(TVar::FermionMassRemoval scheme){ JetMassScheme=scheme; if (isActive()) TUtil::setJetMassScheme(scheme); }
+void MelaContext::setCandidateDecayMode(TVar::CandidateDecayMode mode){ HDecayMode=mode; if (isActive()) PDGHelpers::setCandidateDecayMode(mode); }
+void MelaContext::setMass(double inmass, int ipart){
+  ipart = abs(ipart);
+  recordDefaultEwkParameters(); // TUtil::SetMass overwrites the EW inputs for some particles
+  if (defaultMasses.find(ipart)==defaultMasses.end()) defaultMasses[ipart] = TUtil::GetMass(ipart);
+  masses[ipart] = inmass;
+  // The EW parameters carry the Z and W masses as well
+  if (ipart==23) ewk_mZ = inmass;
+  else if (ipart==24) ewk_mW = inmass;
+  if (isActive()) TUtil::SetMass(inmass, ipart);
+}
+void MelaContext::setDecayWidth(double inwidth, int ipart){
+  ipart = abs(ipart);
+  if (defaultWidths.find(ipart)==defaultWidths.end()) defaultWidths[ipart] = TUtil::GetDecayWidth(ipart);
+  widths[ipart] = inwidth;
+  if (isActive()) TUtil::SetDecayWidth(inwidth, ipart);
+}
+void MelaContext::setEwkCouplingParameters(double ext_Gf, double ext_aemmz, double ext_mW, double ext_mZ, double ext_xW, int ext_ewscheme){
+  recordDefaultEwkParameters();
+  hasEwkParameters=true;
+  ewk_Gf=ext_Gf;
+  ewk_aemmz=ext_aemmz;
+  ewk_mW=ext_mW;
+  ewk_mZ=ext_mZ;
+  ewk_xW=ext_xW;
+  ewk_ewscheme=ext_ewscheme;
+  // Z and W masses set before are superseded, and later ones update ewk_mZ and ewk_mW
+  masses.erase(23);
+  masses.erase(24);
+  if (isActive()) TUtil::SetEwkCouplingParameters(ext_Gf, ext_aemmz, ext_mW, ext_mZ, ext_xW, ext_ewscheme);
+}
+void MelaContext::setLHAgrid(const char* path, int pdfmember, bool isLoaded){
+  pdfPath = path;
+  pdfMember = pdfmember;
+  if (isLoaded){
+    if (isActive() && (pdfPath!=loadedPDFPath || pdfMember!=loadedPDFMember)) TUtil::InvalidatePDFCache();
+    loadedPDFPath = pdfPath;
+    loadedPDFMember = pdfMember;
+  }
+  else if (isActive() && (pdfPath!=loadedPDFPath || pdfMember!=loadedPDFMember)) loadLHAgrid(pdfPath, pdfMember);
+}
+void MelaContext::setCKMElements(double invckm_ud, double invckm_us, double invckm_cd, double invckm_cs, double invckm_ts, double invckm_tb, double invckm_ub, double invckm_cb, double invckm_td){
+  hasCKMElements=true;
+  isCKMModified=true;
+  ckmElements[0]=invckm_ud; ckmElements[1]=invckm_us; ckmElements[2]=invckm_cd; ckmElements[3]=invckm_cs; ckmElements[4]=invckm_ts; ckmElements[5]=invckm_tb;
+  ckmElements[6]=invckm_ub; ckmElements[7]=invckm_cb; ckmElements[8]=invckm_td;
+  if (isActive()) applyCKMElements();
+}
+void MelaContext::applyCKMElements(){
+  if (!hasCKMElements){
+    if (isCKMModified) TUtil::SetDefaultCKMElements();
+    return;
+  }
+  TUtil::SetCKMElements(
+    &(ckmElements[0]), &(ckmElements[1]), &(ckmElements[2]), &(ckmElements[3]), &(ckmElements[4]), &(ckmElements[5]),
+    (ckmElements[6]>=0. ? &(ckmElements[6]) : 0), (ckmElements[7]>=0. ? &(ckmElements[7]) : 0), (ckmElements[8]>=0. ? &(ckmElements[8]) : 0)
+  );
+}
+
+void MelaContext::activate(){
+  if (activeContext==this) return;
+  activeContext=this;
+  // The settings below invalidate the caches of the active state, but those of this context were computed with the same settings
+  TUtil::SetContextState(0);
+
+  TUtil::applyLeptonMassCorrection(forbidMassiveLeptons);
+  TUtil::applyJetMassCorrection(forbidMassiveJets);
+  TUtil::setLeptonMassScheme(LeptonMassScheme);
+  TUtil::setJetMassScheme(JetMassScheme);
+  PDGHelpers::setCandidateDecayMode(HDecayMode);
+
+  energy_.sqrts = 2.*ebeam;
+  if (hasEwkParameters) TUtil::SetEwkCouplingParameters(ewk_Gf, ewk_aemmz, ewk_mW, ewk_mZ, ewk_xW, ewk_ewscheme);
+  else if (hasDefaultEwkParameters) TUtil::SetEwkCouplingParameters(defaultEwk_Gf, defaultEwk_aemmz, defaultEwk_mW, defaultEwk_mZ, defaultEwk_xW, defaultEwk_ewscheme);
+  // Apply either the value set in this context or the default for every particle any context has modified.
+  // Only the values that differ are set in order to avoid recomputing the couplings unnecessarily.
+  // The Z and W masses of a context with its own EW parameters are already applied with them.
+  for (std::map<int, double>::const_iterator it=defaultMasses.begin(); it!=defaultMasses.end(); it++){
+    if (hasEwkParameters && (it->first==23 || it->first==24)) continue;
+    std::map<int, double>::const_iterator itOwn = masses.find(it->first);
+    double mass = (itOwn!=masses.end() ? itOwn->second : it->second);
+    if (TUtil::GetMass(it->first)!=mass) TUtil::SetMass(mass, it->first);
+  }
+  for (std::map<int, double>::const_iterator it=defaultWidths.begin(); it!=defaultWidths.end(); it++){
+    std::map<int, double>::const_iterator itOwn = widths.find(it->first);
+    double width = (itOwn!=widths.end() ? itOwn->second : it->second);
+    if (TUtil::GetDecayWidth(it->first)!=width) TUtil::SetDecayWidth(width, it->first);
+  }
+
+  applyCKMElements();
+
+  if (pdfPath!="" && (pdfPath!=loadedPDFPath || pdfMember!=loadedPDFMember)) loadLHAgrid(pdfPath, pdfMember);
+
+  TUtil::SetContextState(state);
+}
@@ -0,0 +1,162 @@
+#include <cmath>
+#include "MelaJetEtaIntegrator.h"
+#include "TMath.h"
+
+
+using namespace std;
+
+
+MelaJetEtaIntegrator::MelaJetEtaIntegrator(double precision_) :
+precision(precision_),
+threshold(0),
+nInitial(0),
+nextInitial(0),
+iInterval(0),
+iPending(-1),
+nIterations(0)
+{
+  // Typical grids stay well below this size
+  etaArray.reserve(256);
+  pArray.reserve(256);
+  splineM.reserve(256);
+  splineC.reserve(256);
+}
+
+void MelaJetEtaIntegrator::setJet(const TLorentzVector& pJetRef_, const TLorentzVector& pRecoil_, double threshold_){
+  pJetRef = pJetRef_;
+  pRecoil = pRecoil_;
+  threshold = threshold_;
+}
+bool MelaJetEtaIntegrator::getJetMomentum(double eta, TLorentzVector& pJet)const{
+  double jet2temp_sinh_eta = TMath::SinH(eta);
+  double jet2temp_pz = pJetRef.Pt()*jet2temp_sinh_eta;
+  pJet.SetZ(jet2temp_pz);
+  pJet.SetX(pJetRef.X()); pJet.SetY(pJetRef.Y()); pJet.SetT(pJet.P());
+
+  // Skip case with invalid pz
+  TLorentzVector pTotal = pRecoil+pJet;
+  double sys = (pTotal.T()+fabs(pTotal.Z()))/2.;
+  return (fabs(sys)<threshold);
+}
+
+void MelaJetEtaIntegrator::initialize(double etaMin, double etaMax, unsigned int nGrid){
+  etaArray.clear();
+  pArray.clear();
+  for (unsigned int iter=0; iter<nGrid; iter++){
+    etaArray.push_back(((double)iter)*(etaMax-etaMin) / (((double)nGrid) - 1.) + etaMin);
+    pArray.push_back(0);
+  }
+  nInitial = nGrid;
+  nextInitial = 0;
+  iInterval = 0;
+  iPending = -1;
+  nIterations = 0;
+}
+
+bool MelaJetEtaIntegrator::nextPoint(double& eta){
+  if (nextInitial<nInitial){
+    iPending = nextInitial;
+    eta = etaArray.at(nextInitial);
+    nextInitial++;
+    return true;
+  }
+  iPending = -1;
+
+  // For each spacing, first compare the average of end points to spline value
+  while (iInterval<(int)etaArray.size()-1){
+    const int iG = iInterval;
+    if (pArray[iG]==pArray[iG+1] || etaArray[iG]==etaArray[iG+1]){ iInterval++; continue; }
+
+    nIterations++;
+
+    double x_middle = (etaArray[iG]+etaArray[iG+1])*0.5;
+    double y_middle = (pArray[iG]+pArray[iG+1])*0.5;
+    double y_sp = getSplineMidpoint(iG);
+    if (y_sp<0) y_sp = 0;
+
+    if (fabs(y_sp-y_middle)<precision*fabs(y_middle) || fabs(etaArray[iG+1]-etaArray[iG])<1e-3){
+      pArray.insert(pArray.begin()+iG+1, y_sp);
+      etaArray.insert(etaArray.begin()+iG+1, x_middle);
+      iInterval += 2; // Pass to next bin
+    }
+    else{
+      // Compute the middle point, and repeat until precision is achieved
+      pArray.insert(pArray.begin()+iG+1, 0.);
+      etaArray.insert(etaArray.begin()+iG+1, x_middle);
+      iPending = iG+1;
+      eta = x_middle;
+      return true;
+    }
+  }
+  return false;
+}
+void MelaJetEtaIntegrator::setValue(float value){
+  if (iPending>=0) pArray.at(iPending) = (double)value;
+  iPending = -1;
+}
+
+// Value at the middle of interval iG of the cubic spline through the grid,
+// with the first derivatives at the ends fixed to the slopes of the first and last intervals
+double MelaJetEtaIntegrator::getSplineMidpoint(int iG){
+  const int n = etaArray.size();
+  splineM.resize(n);
+  splineC.resize(n);
+
+  // Tridiagonal system for the second derivatives. The end rows have zero right-hand sides for these end derivatives.
+  double h = etaArray[1]-etaArray[0];
+  double slope_prev = (pArray[1]-pArray[0])/h;
+  double diag = 2.*h;
+  splineC[0] = h/diag;
+  splineM[0] = 0;
+  for (int i=1; i<n; i++){
+    double h_prev = etaArray[i]-etaArray[i-1];
+    double sub = h_prev, rhs = 0;
+    if (i<n-1){
+      h = etaArray[i+1]-etaArray[i];
+      double slope = (pArray[i+1]-pArray[i])/h;
+      diag = 2.*(h_prev+h);
+      rhs = 6.*(slope-slope_prev);
+      slope_prev = slope;
+    }
+    else{
+      h = 0;
+      diag = 2.*h_prev;
+    }
+    double denom = diag - sub*splineC[i-1];
+    splineC[i] = h/denom;
+    splineM[i] = (rhs - sub*splineM[i-1])/denom;
+  }
+  for (int i=n-2; i>=0; i--) splineM[i] -= splineC[i]*splineM[i+1];
+
+  double dx = etaArray[iG+1]-etaArray[iG];
+  return (pArray[iG]+pArray[iG+1])*0.5 - dx*dx/16.*(splineM[iG]+splineM[iG+1]);
+}
+
+float MelaJetEtaIntegrator::integrate()const{
+  float result = 0;
+  const int nGrid = etaArray.size();
+  if (nGrid<2) return result;
+  int iGFirst=0, iGLast=nGrid-1;
+  for (int iG=1; iG<nGrid; iG++){
+    if (pArray[iG]>0 && pArray[iG-1]==0){
+      iGFirst = iG-1;
+      break;
+    }
+  }
+  for (int iG=nGrid-2; iG>=0; iG--){
+    if (pArray[iG]>0 && pArray[iG+1]==0){
+      iGLast = iG+1;
+      break;
+    }
+  }
+  double dEtaGrid = etaArray[iGLast] - etaArray[iGFirst];
+  for (int iG=iGFirst; iG<iGLast-1; iG++){
+    double dEta = etaArray[iG+1] - etaArray[iG];
+    double sumProb = pArray[iG]+pArray[iG+1];
+    sumProb *= 0.5;
+    dEta = dEta/dEtaGrid;
+    double addProb = sumProb*dEta;
+    result += (float)addProb;
+  }
+  return result;
+}
@@ -19,45 +19,17 @@ SuperMELA::SuperMELA(
   sqrts_(LHCsqrts)
 {
 
-  sigma_CB_=0;
-  mean_CB_err_=0;
-  sigma_CB_err_=0;
-
-  n_CB_=0;
-  alpha_CB_=0;
-  n2_CB_=0;
-  alpha2_CB_=0;
-  mean_CB_=0;
-  meanTOT_CB_=0;
-
-  mean_BW_=0;
-  width_BW_=0;
-
-  sig_CB_=0;
-  sig_BW_=0;
-  sig_FFT_=0;
-
-  a0_qqZZ_=0;
-  a1_qqZZ_=0;
-  a2_qqZZ_=0;
-  a3_qqZZ_=0;
-  a4_qqZZ_=0;
-  a5_qqZZ_=0;
-  a6_qqZZ_=0;
-  a7_qqZZ_=0;
-  a8_qqZZ_=0;
-  a9_qqZZ_=0;
-  a10_qqZZ_=0;
-  a11_qqZZ_=0;
-  a12_qqZZ_=0;
-  a13_qqZZ_=0;
-
-  qqZZ_pdf_=0;
+  for (unsigned int ich=0; ich<3; ich++) channelShapes_[ich]=0;
+  shapes_=0;
+  rangeMH_=-1;
+  lowMH_=0;
+  highMH_=0;
 
   verbose_=false;
+  useFastEvaluation_=true;
   mH_rrv_=new RooRealVar("mH", "mH", mHVal_, 0., sqrts_*1000.);
-  m4l_rrv_=0;
   strChan_=channel;
+  checkChannel();
 
   //pathToCards_="../../../HiggsAnalysis/HZZ4L_CombinationPy/CreateDatacards/SM_inputs_8TeV/";
   pathToCards_="../data/CombinationInputs/SM_inputs_8TeV/";
@@ -65,6 +37,32 @@ SuperMELA::SuperMELA(
 }
 
 SuperMELA::~SuperMELA(){
+  clearChannelShapes(false);
+  delete mH_rrv_;
+}
+
+SuperMELA::ChannelShapes::ChannelShapes() :
+  m4l_rrv_(0),
+  n_CB_(0), alpha_CB_(0), n2_CB_(0), alpha2_CB_(0),
+  mean_CB_(0), sigma_CB_(0), meanTOT_CB_(0),
+  mean_CB_err_(0), sigma_CB_err_(0),
+  sig_CB_(0), sig_BW_(0), sig_FFT_(0),
+  mean_BW_(0), width_BW_(0),
+  norm_sig_CB_(0), norm_sig_FFT_(0),
+  a0_qqZZ_(0), a1_qqZZ_(0), a2_qqZZ_(0), a3_qqZZ_(0),
+  a4_qqZZ_(0), a5_qqZZ_(0), a6_qqZZ_(0), a7_qqZZ_(0),
+  a8_qqZZ_(0), a9_qqZZ_(0), a10_qqZZ_(0), a11_qqZZ_(0),
+  a12_qqZZ_(0), a13_qqZZ_(0),
+  qqZZ_pdf_(0),
+  norm_bkg_qqZZ_(0),
+  corr_mean_sig_(0),
+  corr_sigma_sig_(0)
+{
+  for (unsigned int ip=0; ip<6; ip++) sigShapePars_[ip]=0;
+  for (unsigned int ip=0; ip<14; ip++) bkgShapePars_[ip]=0;
+}
+
+SuperMELA::ChannelShapes::~ChannelShapes(){
   delete sig_CB_;
   delete sig_BW_;
   delete sig_FFT_;
@@ -78,6 +76,8 @@ SuperMELA::~SuperMELA(){
   delete mean_CB_;
   delete sigma_CB_;
   delete meanTOT_CB_;
+  delete corr_mean_sig_;
+  delete corr_sigma_sig_;
 
   delete mean_CB_err_;
   delete sigma_CB_err_;
@@ -90,8 +90,16 @@ SuperMELA::~SuperMELA(){
   delete a8_qqZZ_; delete a9_qqZZ_; delete a10_qqZZ_; delete a11_qqZZ_;
   delete a12_qqZZ_; delete a13_qqZZ_;
 
-  delete mH_rrv_;
-  if (m4l_rrv_!=0) delete m4l_rrv_;
+  delete m4l_rrv_;
+}
+
+void SuperMELA::clearChannelShapes(bool keepCurrent){
+  for (unsigned int ich=0; ich<3; ich++){
+    if (keepCurrent && channelShapes_[ich]==shapes_) continue;
+    delete channelShapes_[ich];
+    channelShapes_[ich]=0;
+  }
+  if (!keepCurrent) shapes_=0;
 }
 
 void SuperMELA::SetDecayChannel(string myChan){
@@ -99,15 +107,25 @@ void SuperMELA::SetDecayChannel(string myChan){
   if (myChan != strChan_){ // do nothing if it's the same as before
     strChan_=myChan;
     bool newChanOK = checkChannel();
-    if (verbose_) std::cout << "Setting decay channel of SuperMELA to " << strChan_.c_str() << " , re-initializing..." << std::endl;
-    init();
+    if (newChanOK && channelShapes_[ch_]!=0){
+      if (verbose_) std::cout << "Setting decay channel of SuperMELA to " << strChan_.c_str() << " , using the shapes built before..." << std::endl;
+      shapes_ = channelShapes_[ch_];
+    }
+    else if (newChanOK){
+      if (verbose_) std::cout << "Setting decay channel of SuperMELA to " << strChan_.c_str() << " , initializing..." << std::endl;
+      buildChannelShapes();
+    }
+    else{
+      if (verbose_) std::cout << "Setting decay channel of SuperMELA to " << strChan_.c_str() << " , re-initializing..." << std::endl;
+      init();
+    }
     if (verbose_ && newChanOK) std::cout << "Decay channel set successfully to " << strChan_.c_str() << std::endl;
   }
 }
 
 double SuperMELA::GetSigShapeSystematic(string parName){
-  if (parName=="meanCB") return mean_CB_err_->getVal();
-  else if (parName=="sigmaCB") return sigma_CB_err_->getVal();
+  if (parName=="meanCB") return shapes_->mean_CB_err_->getVal();
+  else if (parName=="sigmaCB") return shapes_->sigma_CB_err_->getVal();
   else{
     std::cout << "Error from SuperMELA::GetSigShapeSystematic, unrecognized input: " << parName.c_str() << std::endl;
     try{
@@ -122,10 +140,10 @@ double SuperMELA::GetSigShapeSystematic(string parName){
 }
 
 double SuperMELA::GetSigShapeParameter(string parName){
-  if (parName=="meanCB") return meanTOT_CB_->getVal();
-  else if (parName=="sigmaCB") return sigma_CB_->getVal();
-  else if (parName=="alphaCB") return alpha_CB_->getVal();
-  else if (parName=="nCB") return n_CB_->getVal();
+  if (parName=="meanCB") return shapes_->meanTOT_CB_->getVal();
+  else if (parName=="sigmaCB") return shapes_->sigma_CB_->getVal();
+  else if (parName=="alphaCB") return shapes_->alpha_CB_->getVal();
+  else if (parName=="nCB") return shapes_->n_CB_->getVal();
   else{
     try{
       throw 40;
@@ -142,12 +160,26 @@ double SuperMELA::GetSigShapeParameter(string parName){
 void SuperMELA::init(){
   if (verbose_)std::cout << "Begin SuperMELA::init..." << std::endl;
 
-  // Calculate m4l ranges for the given mH, set range of rrv
-  calc_mZZ_range(mHVal_, lowMH_, highMH_);
+  // Shapes built before may be for a different mH or different cards
+  clearChannelShapes(false);
+  rangeMH_=-1;
+  buildChannelShapes();
+}
+
+void SuperMELA::buildChannelShapes(){
+  if (verbose_)std::cout << "Begin SuperMELA::buildChannelShapes for channel " << strChan_ << "..." << std::endl;
+  delete channelShapes_[ch_];
+  shapes_ = channelShapes_[ch_] = new ChannelShapes();
+
+  // Calculate m4l ranges for the given mH, set range of rrv. They do not depend on the channel.
+  if (rangeMH_!=mHVal_){
+    calc_mZZ_range(mHVal_, lowMH_, highMH_);
+    rangeMH_=mHVal_;
+  }
   if (verbose_)cout << "Range width=" << highMH_ - lowMH_ << endl;
-  m4l_rrv_=new RooRealVar("CMS_zz4l_mass", "CMS_zz4l_mass", mHVal_, lowMH_, highMH_);
-  m4l_rrv_->setBins(2000, "fft");
-  m4l_rrv_->setRange("shape", lowMH_, highMH_);
+  shapes_->m4l_rrv_=new RooRealVar("CMS_zz4l_mass", "CMS_zz4l_mass", mHVal_, lowMH_, highMH_);
+  shapes_->m4l_rrv_->setBins(2000, "fft");
+  shapes_->m4l_rrv_->setRange("shape", lowMH_, highMH_);
 
   //parameters for signal m4l shape systematics
   double str_mean_CB_err_e;
@@ -160,23 +192,20 @@ void SuperMELA::init(){
     std::cout << "sigma_CB systematics (ele and mu): " << str_sigma_CB_err_e << " / " << str_sigma_CB_err_m << std::endl;
   }
 
-  //delete old stuff before reinitialization
-  if (mean_CB_err_) delete mean_CB_err_;
-  if (sigma_CB_err_) delete sigma_CB_err_;
   if (strChan_=="4mu"){
-    mean_CB_err_=new RooRealVar("mean_CB_err", "mean_CB_err", str_mean_CB_err_m);
-    sigma_CB_err_=new RooRealVar("sigma_CB_err", "sigma_CB_err", str_sigma_CB_err_m);
+    shapes_->mean_CB_err_=new RooRealVar("mean_CB_err", "mean_CB_err", str_mean_CB_err_m);
+    shapes_->sigma_CB_err_=new RooRealVar("sigma_CB_err", "sigma_CB_err", str_sigma_CB_err_m);
   }
   else if (strChan_=="4e"){
-    mean_CB_err_=new RooRealVar("mean_CB_err", "mean_CB_err", str_mean_CB_err_e);
-    sigma_CB_err_=new RooRealVar("sigma_CB_err", "sigma_CB_err", str_sigma_CB_err_e);
+    shapes_->mean_CB_err_=new RooRealVar("mean_CB_err", "mean_CB_err", str_mean_CB_err_e);
+    shapes_->sigma_CB_err_=new RooRealVar("sigma_CB_err", "sigma_CB_err", str_sigma_CB_err_e);
   }
   else{//2e2mu, we should have already checked that the string of the channel is a sensible one
-    mean_CB_err_=new RooRealVar("mean_CB_err", "mean_CB_err", (str_mean_CB_err_m + str_mean_CB_err_e));
-    sigma_CB_err_=new RooRealVar("sigma_CB_err", "sigma_CB_err", std::sqrt(std::pow(str_sigma_CB_err_m, 2) + std::pow(str_sigma_CB_err_e, 2)));
+    shapes_->mean_CB_err_=new RooRealVar("mean_CB_err", "mean_CB_err", (str_mean_CB_err_m + str_mean_CB_err_e));
+    shapes_->sigma_CB_err_=new RooRealVar("sigma_CB_err", "sigma_CB_err", std::sqrt(std::pow(str_sigma_CB_err_m, 2) + std::pow(str_sigma_CB_err_e, 2)));
   }
-  if (mean_CB_err_->getVal()<0.){ std::cout << "Negative error on the m4l mean ! " << mean_CB_err_->getVal() << std::endl; }
-  if (sigma_CB_err_->getVal()<0.){ std::cout << "Negative error on the m4l sigma ! " << sigma_CB_err_->getVal() << std::endl; }
+  if (shapes_->mean_CB_err_->getVal()<0.){ std::cout << "Negative error on the m4l mean ! " << shapes_->mean_CB_err_->getVal() << std::endl; }
+  if (shapes_->sigma_CB_err_->getVal()<0.){ std::cout << "Negative error on the m4l sigma ! " << shapes_->sigma_CB_err_->getVal() << std::endl; }
 
 
   //set parameters for signal m4l shape and calculate normalization
@@ -194,87 +223,75 @@ void SuperMELA::init(){
     std::cout << "Sigma RooFormula (string): " << str_sigma_CB.c_str() << std::endl;
   }
 
-  if (n_CB_) delete n_CB_;
-  if (alpha_CB_) delete alpha_CB_;
-  if (n2_CB_) delete n2_CB_;
-  if (alpha2_CB_) delete alpha2_CB_;
   char rrvName[96];
   sprintf(rrvName, "CMS_zz4l_n_sig_%s_%d", strChan_.c_str(), int(sqrts_));
   if (verbose_) cout << "SuperMELA::init: Constructing n_CB_ from formula " << str_n_CB.c_str() << endl;
-  n_CB_=new RooFormulaVar(rrvName, str_n_CB.c_str(), RooArgList(*mH_rrv_));
+  shapes_->n_CB_=new RooFormulaVar(rrvName, str_n_CB.c_str(), RooArgList(*mH_rrv_));
   sprintf(rrvName, "CMS_zz4l_alpha_sig_%s_%d", strChan_.c_str(), int(sqrts_));
   if (verbose_) cout << "SuperMELA::init: Constructing alpha_CB_ from formula " << str_alpha_CB.c_str() << endl;
-  alpha_CB_=new RooFormulaVar(rrvName, str_alpha_CB.c_str(), RooArgList(*mH_rrv_));
+  shapes_->alpha_CB_=new RooFormulaVar(rrvName, str_alpha_CB.c_str(), RooArgList(*mH_rrv_));
   sprintf(rrvName, "CMS_zz4l_n2_sig_%s_%d", strChan_.c_str(), int(sqrts_));
   if (verbose_) cout << "SuperMELA::init: Constructing n2_CB_ from formula " << str_n2_CB.c_str() << endl;
-  n2_CB_=new RooFormulaVar(rrvName, str_n2_CB.c_str(), RooArgList(*mH_rrv_));
+  shapes_->n2_CB_=new RooFormulaVar(rrvName, str_n2_CB.c_str(), RooArgList(*mH_rrv_));
   sprintf(rrvName, "CMS_zz4l_alpha2_sig_%s_%d", strChan_.c_str(), int(sqrts_));
   if (verbose_) cout << "SuperMELA::init: Constructing alpha2_CB_ from formula " << str_alpha2_CB.c_str() << endl;
-  alpha2_CB_=new RooFormulaVar(rrvName, str_alpha2_CB.c_str(), RooArgList(*mH_rrv_));
+  shapes_->alpha2_CB_=new RooFormulaVar(rrvName, str_alpha2_CB.c_str(), RooArgList(*mH_rrv_));
 
-  RooRealVar corr_mean_sig("CMS_zz4l_mean_sig_corrMH", "CMS_zz4l_mean_sig_corrMH", 0., -10., 10.);
-  RooRealVar corr_sigma_sig("CMS_zz4l_sigma_sig_corrMH", "CMS_zz4l_sigma_sig_corrMH", 0., -10., 10.);
+  shapes_->corr_mean_sig_=new RooRealVar("CMS_zz4l_mean_sig_corrMH", "CMS_zz4l_mean_sig_corrMH", 0., -10., 10.);
+  shapes_->corr_sigma_sig_=new RooRealVar("CMS_zz4l_sigma_sig_corrMH", "CMS_zz4l_sigma_sig_corrMH", 0., -10., 10.);
 
-  if (mean_CB_) delete mean_CB_;
-  if (meanTOT_CB_) delete meanTOT_CB_;
-  if (sigma_CB_) delete sigma_CB_;
-  mean_CB_=new RooFormulaVar("CMS_zz4l_mean_m_sig", Form("(%s)+@0*@1", str_mean_CB.c_str()), RooArgList(*mH_rrv_, corr_mean_sig));//this is normalized by mHVal_
-  meanTOT_CB_=new RooFormulaVar("CMS_zz4l_mean_sig", "(@0+@1)", RooArgList(*mH_rrv_, *mean_CB_));
-  if (verbose_){ std::cout << "Signal Mean vals -> Correction: " << corr_mean_sig.getVal() << "  Mean: " << mean_CB_->getVal() << "  Total: " << meanTOT_CB_->getVal() << std::endl; }
-  sigma_CB_=new RooFormulaVar("CMS_zz4l_sigma_m_sig", Form("(%s)*(1+@1)", str_sigma_CB.c_str()), RooArgList(*mH_rrv_, corr_sigma_sig));
+  shapes_->mean_CB_=new RooFormulaVar("CMS_zz4l_mean_m_sig", Form("(%s)+@0*@1", str_mean_CB.c_str()), RooArgList(*mH_rrv_, *shapes_->corr_mean_sig_));//this is normalized by mHVal_
+  shapes_->meanTOT_CB_=new RooFormulaVar("CMS_zz4l_mean_sig", "(@0+@1)", RooArgList(*mH_rrv_, *shapes_->mean_CB_));
+  if (verbose_){ std::cout << "Signal Mean vals -> Correction: " << shapes_->corr_mean_sig_->getVal() << "  Mean: " << shapes_->mean_CB_->getVal() << "  Total: " << shapes_->meanTOT_CB_->getVal() << std::endl; }
+  shapes_->sigma_CB_=new RooFormulaVar("CMS_zz4l_sigma_m_sig", Form("(%s)*(1+@1)", str_sigma_CB.c_str()), RooArgList(*mH_rrv_, *shapes_->corr_sigma_sig_));
 
   //for high-mass one also needs a gamma RooFormulaVar, 
-  if (mean_BW_) delete mean_BW_;
-  if (width_BW_) delete width_BW_;
   sprintf(rrvName, "CMS_zz4l_mean_BW_sig_%s_%d", strChan_.c_str(), int(sqrts_));
-  mean_BW_=new RooRealVar(rrvName, "CMS_zz4l_mean_BW", mHVal_, 100., 1000.);
+  shapes_->mean_BW_=new RooRealVar(rrvName, "CMS_zz4l_mean_BW", mHVal_, 100., 1000.);
   sprintf(rrvName, "CMS_zz4l_width_BW_sig_%s_%d", strChan_.c_str(), int(sqrts_));
-  width_BW_=new RooRealVar(rrvName, "CMS_zz4l_width_BW", 1.);
-  mean_BW_->setVal(mHVal_);
-  mean_BW_->setConstant(true);
-  width_BW_->setConstant(true);
+  shapes_->width_BW_=new RooRealVar(rrvName, "CMS_zz4l_width_BW", 1.);
+  shapes_->mean_BW_->setVal(mHVal_);
+  shapes_->mean_BW_->setConstant(true);
+  shapes_->width_BW_->setConstant(true);
 
   if (verbose_){
     std::cout << "Signal shape parameter values: " << std::endl;
-    std::cout << "Mean (formula value) = " << meanTOT_CB_->getVal() << std::endl;
-    std::cout << "Sigma (formula value) = " << sigma_CB_->getVal() << std::endl;
-    std::cout << "n (formula value) = " << n_CB_->getVal() << std::endl;
-    std::cout << "alpha (formula value) = " << alpha_CB_->getVal() << std::endl;
-    std::cout << "n2 (formula value) = " << n2_CB_->getVal() << std::endl;
-    std::cout << "alpha2 (formula value) = " << alpha2_CB_->getVal() << std::endl;
-    std::cout << "Mean BW (realvar value) = " << mean_BW_->getVal() << std::endl;
-    std::cout << "Width BW (realvar value) = " << width_BW_->getVal() << std::endl;
+    std::cout << "Mean (formula value) = " << shapes_->meanTOT_CB_->getVal() << std::endl;
+    std::cout << "Sigma (formula value) = " << shapes_->sigma_CB_->getVal() << std::endl;
+    std::cout << "n (formula value) = " << shapes_->n_CB_->getVal() << std::endl;
+    std::cout << "alpha (formula value) = " << shapes_->alpha_CB_->getVal() << std::endl;
+    std::cout << "n2 (formula value) = " << shapes_->n2_CB_->getVal() << std::endl;
+    std::cout << "alpha2 (formula value) = " << shapes_->alpha2_CB_->getVal() << std::endl;
+    std::cout << "Mean BW (realvar value) = " << shapes_->mean_BW_->getVal() << std::endl;
+    std::cout << "Width BW (realvar value) = " << shapes_->width_BW_->getVal() << std::endl;
   }
 
-  if (sig_CB_) delete sig_CB_;
-  if (sig_BW_) delete sig_BW_;
-  if (sig_FFT_) delete sig_FFT_;
-  sig_CB_ =new MELADoubleCB("signalCB_ggH", "signalCB_ggH", *m4l_rrv_, *meanTOT_CB_, *sigma_CB_, *alpha_CB_, *n_CB_, *alpha2_CB_, *n2_CB_);
-  sig_BW_ =new MELARelBWUFParam("signalBW_ggH", "signalBW_ggH", *m4l_rrv_, *mean_BW_, *width_BW_);
-  sig_FFT_=new RooFFTConvPdf("signal_ggH", "BW (X) CB", *m4l_rrv_, *sig_BW_, *sig_CB_, 2);
-  sig_FFT_->setBufferFraction(0.2);
+  shapes_->sig_CB_ =new MELADoubleCB("signalCB_ggH", "signalCB_ggH", *shapes_->m4l_rrv_, *shapes_->meanTOT_CB_, *shapes_->sigma_CB_, *shapes_->alpha_CB_, *shapes_->n_CB_, *shapes_->alpha2_CB_, *shapes_->n2_CB_);
+  shapes_->sig_BW_ =new MELARelBWUFParam("signalBW_ggH", "signalBW_ggH", *shapes_->m4l_rrv_, *shapes_->mean_BW_, *shapes_->width_BW_);
+  shapes_->sig_FFT_=new RooFFTConvPdf("signal_ggH", "BW (X) CB", *shapes_->m4l_rrv_, *shapes_->sig_BW_, *shapes_->sig_CB_, 2);
+  shapes_->sig_FFT_->setBufferFraction(0.2);
   if (verbose_){
-    m4l_rrv_->setVal(125.);
-    std::cout << "Value of signal m4l CB shape is " << sig_CB_->getVal() << std::endl;
-    std::cout << "Value of signal m4l BW shape is " << sig_BW_->getVal() << std::endl;
-    sig_FFT_->Print("v");
-    std::cout << "Value of signal m4l FFT shape is " << sig_FFT_->getVal() << std::endl;
+    shapes_->m4l_rrv_->setVal(125.);
+    std::cout << "Value of signal m4l CB shape is " << shapes_->sig_CB_->getVal() << std::endl;
+    std::cout << "Value of signal m4l BW shape is " << shapes_->sig_BW_->getVal() << std::endl;
+    shapes_->sig_FFT_->Print("v");
+    std::cout << "Value of signal m4l FFT shape is " << shapes_->sig_FFT_->getVal() << std::endl;
   }
   RooAbsReal* tmpint;
-  tmpint = sig_CB_->createIntegral(RooArgSet(*m4l_rrv_), RooFit::Range("shape"));
-  norm_sig_CB_ =tmpint->getVal();
+  tmpint = shapes_->sig_CB_->createIntegral(RooArgSet(*shapes_->m4l_rrv_), RooFit::Range("shape"));
+  shapes_->norm_sig_CB_ =tmpint->getVal();
   delete tmpint;
-  if (verbose_)std::cout << "Normalization of signal m4l CB shape is " << norm_sig_CB_ << std::endl;
+  if (verbose_)std::cout << "Normalization of signal m4l CB shape is " << shapes_->norm_sig_CB_ << std::endl;
   if (verbose_)std::cout << "\n---> Integrating Breit-Wigner:" << std::endl;
-  tmpint = sig_BW_->createIntegral(RooArgSet(*m4l_rrv_), RooFit::Range("shape"));
+  tmpint = shapes_->sig_BW_->createIntegral(RooArgSet(*shapes_->m4l_rrv_), RooFit::Range("shape"));
   double norm_sig_BW_ =tmpint->getVal();
   delete tmpint;
   if (verbose_)std::cout << "Normalization of signal m4l BW shape is " << norm_sig_BW_ << std::endl;
   if (verbose_)std::cout << "\n---> Integrating full signal:" << std::endl;
-  tmpint = sig_FFT_->createIntegral(RooArgSet(*m4l_rrv_), RooFit::Range("shape"));
-  norm_sig_FFT_=tmpint->getVal();
+  tmpint = shapes_->sig_FFT_->createIntegral(RooArgSet(*shapes_->m4l_rrv_), RooFit::Range("shape"));
+  shapes_->norm_sig_FFT_=tmpint->getVal();
   delete tmpint;
-  if (verbose_)std::cout << "Normalization of signal m4l shape is " << norm_sig_FFT_ << std::endl;
+  if (verbose_)std::cout << "Normalization of signal m4l shape is " << shapes_->norm_sig_FFT_ << std::endl;
 
   if (verbose_)std::cout << "Reading background shape parameters" << std::endl;
   std::vector<double> v_apars;
@@ -285,59 +302,71 @@ void SuperMELA::init(){
     std::cout << "Param [0]=" << v_apars.at(0) << " [13]=" << v_apars.at(13) << std::endl;
   }
 
-  if (a0_qqZZ_) delete a0_qqZZ_;
-  a0_qqZZ_=new RooRealVar("CMS_zz4l_a0_qqZZ", "CMS_zz4l_a0_qqZZ", v_apars.at(0), 0., 200.);
-  if (a1_qqZZ_) delete a1_qqZZ_;
-  a1_qqZZ_=new RooRealVar("CMS_zz4l_a1_qqZZ", "CMS_zz4l_a1_qqZZ", v_apars.at(1), 0., 200.);
-  if (a2_qqZZ_) delete a2_qqZZ_;
-  a2_qqZZ_=new RooRealVar("CMS_zz4l_a2_qqZZ", "CMS_zz4l_a2_qqZZ", v_apars.at(2), 0., 200.);
-  if (a3_qqZZ_) delete a3_qqZZ_;
-  a3_qqZZ_=new RooRealVar("CMS_zz4l_a3_qqZZ", "CMS_zz4l_a3_qqZZ", v_apars.at(3), 0., 1.);
-  if (a4_qqZZ_) delete a4_qqZZ_;
-  a4_qqZZ_=new RooRealVar("CMS_zz4l_a4_qqZZ", "CMS_zz4l_a4_qqZZ", v_apars.at(4), 0., 200.);
-  if (a5_qqZZ_) delete a5_qqZZ_;
-  a5_qqZZ_=new RooRealVar("CMS_zz4l_a5_qqZZ", "CMS_zz4l_a5_qqZZ", v_apars.at(5), 0., 200.);
-  if (a6_qqZZ_) delete a6_qqZZ_;
-  a6_qqZZ_=new RooRealVar("CMS_zz4l_a6_qqZZ", "CMS_zz4l_a6_qqZZ", v_apars.at(6), 0., 100.);
-  if (a7_qqZZ_) delete a7_qqZZ_;
-  a7_qqZZ_=new RooRealVar("CMS_zz4l_a7_qqZZ", "CMS_zz4l_a7_qqZZ", v_apars.at(7), 0., 1.);
-  if (a8_qqZZ_) delete a8_qqZZ_;
-  a8_qqZZ_=new RooRealVar("CMS_zz4l_a8_qqZZ", "CMS_zz4l_a8_qqZZ", v_apars.at(8), 0., 200.);
-  if (a9_qqZZ_) delete a9_qqZZ_;
-  a9_qqZZ_=new RooRealVar("CMS_zz4l_a9_qqZZ", "CMS_zz4l_a9_qqZZ", v_apars.at(9), 0., 1.);
-  if (a10_qqZZ_) delete a10_qqZZ_;
-  a10_qqZZ_=new RooRealVar("CMS_zz4l_a10_qqZZ", "CMS_zz4l_a10_qqZZ", v_apars.at(10), 0., 200.);
-  if (a11_qqZZ_) delete a11_qqZZ_;
-  a11_qqZZ_=new RooRealVar("CMS_zz4l_a11_qqZZ", "CMS_zz4l_a11_qqZZ", v_apars.at(11), -100., 100.);
-  if (a12_qqZZ_) delete a12_qqZZ_;
-  a12_qqZZ_=new RooRealVar("CMS_zz4l_a12_qqZZ", "CMS_zz4l_a12_qqZZ", v_apars.at(12), 0., 10000.);
-  if (a13_qqZZ_) delete a13_qqZZ_;
-  a13_qqZZ_=new RooRealVar("CMS_zz4l_a13_qqZZ", "CMS_zz4l_a13_qqZZ", v_apars.at(13), 0., 1.);
-  a0_qqZZ_->setConstant(kTRUE);
-  a1_qqZZ_->setConstant(kTRUE);
-  a2_qqZZ_->setConstant(kTRUE);
-  a3_qqZZ_->setConstant(kTRUE);
-  a4_qqZZ_->setConstant(kTRUE);
-  a5_qqZZ_->setConstant(kTRUE);
-  a6_qqZZ_->setConstant(kTRUE);
-  a7_qqZZ_->setConstant(kTRUE);
-  a8_qqZZ_->setConstant(kTRUE);
-  a9_qqZZ_->setConstant(kTRUE);
-  a10_qqZZ_->setConstant(kTRUE);
-  a11_qqZZ_->setConstant(kTRUE);
-  a12_qqZZ_->setConstant(kTRUE);
-  a13_qqZZ_->setConstant(kTRUE);
-
-
-  if (qqZZ_pdf_) delete qqZZ_pdf_;
-  qqZZ_pdf_ = new MELAqqZZPdf_v2("bkg_qqzz", "bkg_qqzz", *m4l_rrv_, *a0_qqZZ_, *a1_qqZZ_, *a2_qqZZ_, *a3_qqZZ_,
-    *a4_qqZZ_, *a5_qqZZ_, *a6_qqZZ_, *a7_qqZZ_,
-    *a8_qqZZ_, *a9_qqZZ_, *a10_qqZZ_, *a11_qqZZ_,
-    *a12_qqZZ_, *a13_qqZZ_);
-
-  tmpint = qqZZ_pdf_->createIntegral(RooArgSet(*m4l_rrv_), RooFit::Range("shape"));
-  norm_bkg_qqZZ_=tmpint->getVal();
+  shapes_->a0_qqZZ_=new RooRealVar("CMS_zz4l_a0_qqZZ", "CMS_zz4l_a0_qqZZ", v_apars.at(0), 0., 200.);
+  shapes_->a1_qqZZ_=new RooRealVar("CMS_zz4l_a1_qqZZ", "CMS_zz4l_a1_qqZZ", v_apars.at(1), 0., 200.);
+  shapes_->a2_qqZZ_=new RooRealVar("CMS_zz4l_a2_qqZZ", "CMS_zz4l_a2_qqZZ", v_apars.at(2), 0., 200.);
+  shapes_->a3_qqZZ_=new RooRealVar("CMS_zz4l_a3_qqZZ", "CMS_zz4l_a3_qqZZ", v_apars.at(3), 0., 1.);
+  shapes_->a4_qqZZ_=new RooRealVar("CMS_zz4l_a4_qqZZ", "CMS_zz4l_a4_qqZZ", v_apars.at(4), 0., 200.);
+  shapes_->a5_qqZZ_=new RooRealVar("CMS_zz4l_a5_qqZZ", "CMS_zz4l_a5_qqZZ", v_apars.at(5), 0., 200.);
+  shapes_->a6_qqZZ_=new RooRealVar("CMS_zz4l_a6_qqZZ", "CMS_zz4l_a6_qqZZ", v_apars.at(6), 0., 100.);
+  shapes_->a7_qqZZ_=new RooRealVar("CMS_zz4l_a7_qqZZ", "CMS_zz4l_a7_qqZZ", v_apars.at(7), 0., 1.);
+  shapes_->a8_qqZZ_=new RooRealVar("CMS_zz4l_a8_qqZZ", "CMS_zz4l_a8_qqZZ", v_apars.at(8), 0., 200.);
+  shapes_->a9_qqZZ_=new RooRealVar("CMS_zz4l_a9_qqZZ", "CMS_zz4l_a9_qqZZ", v_apars.at(9), 0., 1.);
+  shapes_->a10_qqZZ_=new RooRealVar("CMS_zz4l_a10_qqZZ", "CMS_zz4l_a10_qqZZ", v_apars.at(10), 0., 200.);
+  shapes_->a11_qqZZ_=new RooRealVar("CMS_zz4l_a11_qqZZ", "CMS_zz4l_a11_qqZZ", v_apars.at(11), -100., 100.);
+  shapes_->a12_qqZZ_=new RooRealVar("CMS_zz4l_a12_qqZZ", "CMS_zz4l_a12_qqZZ", v_apars.at(12), 0., 10000.);
+  shapes_->a13_qqZZ_=new RooRealVar("CMS_zz4l_a13_qqZZ", "CMS_zz4l_a13_qqZZ", v_apars.at(13), 0., 1.);
+  shapes_->a0_qqZZ_->setConstant(kTRUE);
+  shapes_->a1_qqZZ_->setConstant(kTRUE);
+  shapes_->a2_qqZZ_->setConstant(kTRUE);
+  shapes_->a3_qqZZ_->setConstant(kTRUE);
+  shapes_->a4_qqZZ_->setConstant(kTRUE);
+  shapes_->a5_qqZZ_->setConstant(kTRUE);
+  shapes_->a6_qqZZ_->setConstant(kTRUE);
+  shapes_->a7_qqZZ_->setConstant(kTRUE);
+  shapes_->a8_qqZZ_->setConstant(kTRUE);
+  shapes_->a9_qqZZ_->setConstant(kTRUE);
+  shapes_->a10_qqZZ_->setConstant(kTRUE);
+  shapes_->a11_qqZZ_->setConstant(kTRUE);
+  shapes_->a12_qqZZ_->setConstant(kTRUE);
+  shapes_->a13_qqZZ_->setConstant(kTRUE);
+
+
+  shapes_->qqZZ_pdf_ = new MELAqqZZPdf_v2("bkg_qqzz", "bkg_qqzz", *shapes_->m4l_rrv_, *shapes_->a0_qqZZ_, *shapes_->a1_qqZZ_, *shapes_->a2_qqZZ_, *shapes_->a3_qqZZ_,
+    *shapes_->a4_qqZZ_, *shapes_->a5_qqZZ_, *shapes_->a6_qqZZ_, *shapes_->a7_qqZZ_,
+    *shapes_->a8_qqZZ_, *shapes_->a9_qqZZ_, *shapes_->a10_qqZZ_, *shapes_->a11_qqZZ_,
+    *shapes_->a12_qqZZ_, *shapes_->a13_qqZZ_);
+
+  tmpint = shapes_->qqZZ_pdf_->createIntegral(RooArgSet(*shapes_->m4l_rrv_), RooFit::Range("shape"));
+  shapes_->norm_bkg_qqZZ_=tmpint->getVal();
   delete tmpint;
+
+  // Parameters do not change until the next init
+  shapes_->sigShapePars_[0]=shapes_->meanTOT_CB_->getVal();
+  shapes_->sigShapePars_[1]=shapes_->sigma_CB_->getVal();
+  shapes_->sigShapePars_[2]=shapes_->alpha_CB_->getVal();
+  shapes_->sigShapePars_[3]=shapes_->n_CB_->getVal();
+  shapes_->sigShapePars_[4]=shapes_->alpha2_CB_->getVal();
+  shapes_->sigShapePars_[5]=shapes_->n2_CB_->getVal();
+  const RooRealVar* bkgPars[14]={
+    shapes_->a0_qqZZ_, shapes_->a1_qqZZ_, shapes_->a2_qqZZ_, shapes_->a3_qqZZ_, shapes_->a4_qqZZ_, shapes_->a5_qqZZ_, shapes_->a6_qqZZ_,
+    shapes_->a7_qqZZ_, shapes_->a8_qqZZ_, shapes_->a9_qqZZ_, shapes_->a10_qqZZ_, shapes_->a11_qqZZ_, shapes_->a12_qqZZ_, shapes_->a13_qqZZ_
+  };
+  for (unsigned int ip=0; ip<14; ip++) shapes_->bkgShapePars_[ip]=bkgPars[ip]->getVal();
+}
+
+double SuperMELA::evaluateSigShape(double m4l){
+  if (useFastEvaluation_){
+    const double* pars = shapes_->sigShapePars_;
+    return MELADoubleCB::evaluateShape(m4l, pars[0], pars[1], pars[2], pars[3], pars[4], pars[5]);
+  }
+  shapes_->m4l_rrv_->setVal(m4l);
+  return shapes_->sig_CB_->getVal();
+}
+double SuperMELA::evaluateBkgShape(double m4l){
+  if (useFastEvaluation_) return MELAqqZZPdf_v2::evaluateShape(m4l, shapes_->bkgShapePars_);
+  shapes_->m4l_rrv_->setVal(m4l);
+  return shapes_->qqZZ_pdf_->getVal();
 }
 
 
@@ -526,13 +555,12 @@ std::pair<double, double> SuperMELA::M4lProb(double m4l){
     return make_pair(Psig, Pbkg);
   }
 
-  m4l_rrv_->setVal(m4l);
   if (verbose_) std::cout << "In SuperMELA::superMelaLikelihoodDiscriminant,  m4l=" << m4l << std::endl;
   //calculate value of signal m4l pdf (normalize pdf to 1) 
-  double m4lPsig=sig_CB_->getVal() / norm_sig_CB_;
+  double m4lPsig=evaluateSigShape(m4l) / shapes_->norm_sig_CB_;
   if (verbose_) std::cout << "  m4lPsig=" << m4lPsig << std::flush;
   //calculate value of background m4l pdf  (normalize pdf to 1) 
-  double m4lPbkg=qqZZ_pdf_->getVal() / norm_bkg_qqZZ_;
+  double m4lPbkg=evaluateBkgShape(m4l) / shapes_->norm_bkg_qqZZ_;
   if (verbose_) std::cout << "  m4lPbkg=" << m4lPbkg << std::endl;
 
   //the angular probs given back by the Mela producer are already normalized to 1
@@ -551,14 +579,12 @@ std::pair<double, double> SuperMELA::M4lProb(std::pair<double, double> m4lPair){
     return make_pair(Psig, Pbkg);
   }
 
-  m4l_rrv_->setVal(m4lPair.first);
   if (verbose_)std::cout << "In SuperMELA::superMelaLikelihoodDiscriminant,  m4lPSig=" << m4lPair.first << "  m4lPBkg=" << m4lPair.second << std::endl;
   //calculate value of signal m4l pdf (normalize pdf to 1) 
-  double m4lPsig=sig_CB_->getVal() / norm_sig_CB_;
+  double m4lPsig=evaluateSigShape(m4lPair.first) / shapes_->norm_sig_CB_;
   if (verbose_)std::cout << "  m4lPsig=" << m4lPsig << std::flush;
   //calculate value of background m4l pdf  (normalize pdf to 1) 
-  m4l_rrv_->setVal(m4lPair.second);
-  double m4lPbkg=qqZZ_pdf_->getVal() / norm_bkg_qqZZ_;
+  double m4lPbkg=evaluateBkgShape(m4lPair.second) / shapes_->norm_bkg_qqZZ_;
   if (verbose_)std::cout << "  m4lPbkg=" << m4lPbkg << std::endl;
 
   //the angular probs given back by the Mela producer are already normalized to 1
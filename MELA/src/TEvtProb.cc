@@ -10,6 +10,8 @@
 // K. Burkett (burkett@fnal.gov)
 //-----------------------------------------------------------------------------
 
+#include <fcntl.h>
+#include <unistd.h>
 #include "TEvtProb.hh"
 
 
@@ -27,10 +29,15 @@ TEvtProb::TEvtProb(
   const char* path, double ebeam, const char* pathtoPDFSet, int PDFMember, TVar::VerbosityLevel verbosity_
   ) :
   verbosity(verbosity_),
-  EBEAM(ebeam)
+  EBEAM(ebeam),
+  forceMCFMBSMHiggs(false)
 {
   if (verbosity>=TVar::DEBUG) cout << "Begin TEvtProb constructor" << endl;
 
+  /***** Initialize the record of global settings owned by this instance *****/
+  context = new MelaContext(EBEAM);
+  MelaContext::Lock contextLock(context);
+
   SetLeptonInterf(TVar::DefaultLeptonInterf);
 
   /***** Initialize Higgs width reader *****/
@@ -39,7 +46,7 @@ TEvtProb::TEvtProb(
   if (verbosity>=TVar::DEBUG) cout << "TEvtProb::TEvtProb: HXS successful" << endl;
 
   /***** Initialize MCFM *****/
-  InitializeMCFM();
+  InitializeMCFM(path);
 
   /***** Initialize JHUGen *****/
   InitializeJHUGen(pathtoPDFSet, PDFMember);
@@ -59,15 +66,30 @@ TEvtProb::~TEvtProb(){
 
   ResetInputEvent();
   if (myCSW_!=0) delete myCSW_;
+  if (context!=0) delete context;
 
   if (verbosity>=TVar::DEBUG) cout << "End TEvtProb destructor" << endl;
 }
 
-void TEvtProb::InitializeMCFM(){
+void TEvtProb::InitializeMCFM(const char* dataPath){
   if (verbosity>=TVar::DEBUG) cout << "Begin TEvtProb::InitializeMCFM" << endl;
 
-  mcfm_init_((char *)"input.DAT", (char *)"./");
-  if (verbosity>=TVar::DEBUG) cout << "TEvtProb::TEvtProb: mcfm_init successful" << endl;
+  static bool isMCFMInitialized=false; // Guarded by the lock held in the constructor
+  // MCFM reads input.DAT, process.DAT, br.sm* and Pdfdata/ relative to the working directory, and these names are fixed in the prebuilt library.
+  // Unless the working directory provides them already, it is switched to the data directory during the initialization instead of linking them into it.
+  // chdir applies to the whole process, so the first TEvtProb has to be built before any other thread is started (see Mela::Mela).
+  int cwdDescriptor=-1;
+  if (!isMCFMInitialized){
+    if (access("input.DAT", R_OK)!=0 || access("process.DAT", R_OK)!=0 || access("br.sm1", R_OK)!=0 || access("br.sm2", R_OK)!=0){
+      cwdDescriptor = open(".", O_RDONLY);
+      if (cwdDescriptor<0 || chdir(dataPath)!=0){
+        if (verbosity>=TVar::ERROR) cerr << "TEvtProb::InitializeMCFM: Cannot change to the data directory " << dataPath << ", MCFM inputs are read from the working directory." << endl;
+        if (cwdDescriptor>=0){ close(cwdDescriptor); cwdDescriptor=-1; }
+      }
+    }
+    mcfm_init_((char *)"input.DAT", (char *)"./");
+    if (verbosity>=TVar::DEBUG) cout << "TEvtProb::TEvtProb: mcfm_init successful" << endl;
+  }
   energy_.sqrts = 2.*EBEAM;
   ResetQuarkMasses();
   ResetMCFM_EWKParameters(
@@ -79,6 +101,11 @@ void TEvtProb::InitializeMCFM(){
     3 // MCFM EW scheme
     );
   qlinit_();
+  if (cwdDescriptor>=0){
+    if (fchdir(cwdDescriptor)!=0 && verbosity>=TVar::ERROR) cerr << "TEvtProb::InitializeMCFM: Cannot change back to the working directory!" << endl;
+    close(cwdDescriptor);
+  }
+  isMCFMInitialized=true;
   // First resonance constant parameters
   spinzerohiggs_anomcoupl_.LambdaBSM=1000;
   spinzerohiggs_anomcoupl_.Lambda_Q=10000;
@@ -120,13 +147,21 @@ void TEvtProb::InitializeMCFM(){
   spinzerohiggs_anomcoupl_.AnomalCouplPR=1; spinzerohiggs_anomcoupl_.AnomalCouplDK=1;
   // Constant parameters for all processes
   qlfirst_.qlfirst=false;
+  // Some of the values above are also written by SetMCFMSpinZeroCouplings
+  TUtil::InvalidateCouplingPushes();
 
   if (verbosity>=TVar::DEBUG) cout << "End TEvtProb::InitializeMCFM" << endl;
 }
 void TEvtProb::InitializeJHUGen(const char* pathtoPDFSet, int PDFMember){
   if (verbosity>=TVar::DEBUG) cout << "Begin TEvtProb::InitializeJHUGen" << endl;
 
-  InitJHUGenMELA(pathtoPDFSet, PDFMember);
+  static bool isJHUGenInitialized=false; // Guarded by the lock held in the constructor
+  if (!isJHUGenInitialized){
+    InitJHUGenMELA(pathtoPDFSet, PDFMember);
+    context->setLHAgrid(pathtoPDFSet, PDFMember, true);
+    isJHUGenInitialized=true;
+  }
+  else context->setLHAgrid(pathtoPDFSet, PDFMember, false); // Reads the grid only if a different one is loaded
 
   if (verbosity>=TVar::DEBUG) cout << "End TEvtProb::InitializeJHUGen" << endl;
 }
@@ -167,11 +202,8 @@ void TEvtProb::CrossInitialize(){
 
 // Set NNPDF driver path
 void TEvtProb::Set_LHAgrid(const char* path, int pdfmember){
-  char path_nnpdf_c[200];
-  sprintf(path_nnpdf_c, "%s", path);
-  int pathLength = strlen(path_nnpdf_c);
-  nnpdfdriver_(path_nnpdf_c, &pathLength);
-  nninitpdf_(&pdfmember);
+  MelaContext::Lock contextLock(context);
+  context->setLHAgrid(path, pdfmember);
 }
 void TEvtProb::SetProcess(TVar::Process proc, TVar::MatrixElement me, TVar::Production prod){
   matrixElement = me;
@@ -189,13 +221,14 @@ void TEvtProb::SetProcess(TVar::Process proc, TVar::MatrixElement me, TVar::Prod
 }
 void TEvtProb::SetVerbosity(TVar::VerbosityLevel tmp){ verbosity = tmp; }
 void TEvtProb::SetLeptonInterf(TVar::LeptonInterference tmp){ leptonInterf = tmp; }
-void TEvtProb::SetCandidateDecayMode(TVar::CandidateDecayMode mode){ PDGHelpers::setCandidateDecayMode(mode); }
+void TEvtProb::SetCandidateDecayMode(TVar::CandidateDecayMode mode){ MelaContext::Lock contextLock(context); context->setCandidateDecayMode(mode); }
 void TEvtProb::SetRenFacScaleMode(TVar::EventScaleScheme renormalizationSch, TVar::EventScaleScheme factorizationSch, double ren_sf, double fac_sf){
   event_scales.renomalizationScheme = renormalizationSch;
   event_scales.factorizationScheme = factorizationSch;
   event_scales.ren_scale_factor = ren_sf;
   event_scales.fac_scale_factor = fac_sf;
 }
+void TEvtProb::SetMCFMForceBSMHiggs(bool flag){ forceMCFMBSMHiggs = flag; }
 void TEvtProb::AllowSeparateWWCouplings(bool doAllow){ SetJHUGenDistinguishWWCouplings(doAllow); selfDSpinZeroCoupl.allow_WWZZSeparation(doAllow); }
 void TEvtProb::SetPrimaryHiggsMass(double mass){ PrimaryHMass=mass; SetHiggsMass(PrimaryHMass, -1., -1); }
 void TEvtProb::SetHiggsMass(double mass, double wHiggs, int whichResonance){
@@ -259,32 +292,42 @@ void TEvtProb::SetInputEvent(
   SimpleParticleCollection_t* pMothers,
   bool isGen
   ){
+  MelaContext::Lock contextLock(context); // Mass removal schemes and the candidate decay mode are global
   MELACandidate* cand = ConvertVectorFormat(
     pDaughters,
     pAssociated,
     pMothers,
     isGen,
-    &particleList, &candList // push_back is done automatically
+    &particleList, &candList, // push_back is done automatically
+    &eventArena
     );
   if (cand!=0) melaCand=cand;
+  ResetSharedEventComputation();
 }
 void TEvtProb::AppendTopCandidate(SimpleParticleCollection_t* TopDaughters){
+  MelaContext::Lock contextLock(context);
   if (!CheckInputPresent()){
     cerr << "TEvtProb::AppendTopCandidate: No MELACandidates are present to append this top!" << endl;
     return;
   }
   MELATopCandidate* cand = ConvertTopCandidate(
     TopDaughters,
-    &particleList, &topCandList // push_back is done automatically
+    &particleList, &topCandList, // push_back is done automatically
+    &eventArena
     );
   if (cand!=0) melaCand->addAssociatedTops(cand);
+  ResetSharedEventComputation();
 }
 void TEvtProb::SetRcdCandPtr(){ RcdME.melaCand = melaCand; }
 void TEvtProb::SetCurrentCandidateFromIndex(unsigned int icand){
+  MelaContext::Lock contextLock(0); // Only to guard the shared-event computation state
+  ResetSharedEventComputation();
   if (candList.size()>icand) melaCand = candList.at(icand);
   else cerr << "TEvtProb::SetCurrentCandidateFromIndex: icand=" << icand << ">=candList.size()=" << candList.size() << endl;
 }
 void TEvtProb::SetCurrentCandidate(MELACandidate* cand){
+  MelaContext::Lock contextLock(0); // Only to guard the shared-event computation state
+  ResetSharedEventComputation();
   melaCand = cand;
   if (verbosity>=TVar::INFO && melaCand==0) cout << "TEvtProb::SetCurrentCandidate: BE CAREFUL! melaCand==0!" << endl;
   if (verbosity>=TVar::INFO && GetCurrentCandidateIndex()<0) cout << "TEvtProb::SetCurrentCandidate: The current candidate is not in the list of candidates. It is the users' responsibility to delete this candidate and all of its associated particles." << endl;
@@ -293,8 +336,8 @@ void TEvtProb::SetCurrentCandidate(MELACandidate* cand){
 // Reset functions
 void TEvtProb::ResetIORecord(){ RcdME.reset(); }
 void TEvtProb::ResetRenFacScaleMode(){ SetRenFacScaleMode(TVar::DefaultScaleScheme, TVar::DefaultScaleScheme, 0.5, 0.5); }
-void TEvtProb::ResetMass(double inmass, int ipart){ TUtil::SetMass(inmass, ipart); }
-void TEvtProb::ResetWidth(double inwidth, int ipart){ TUtil::SetDecayWidth(inwidth, ipart); }
+void TEvtProb::ResetMass(double inmass, int ipart){ MelaContext::Lock contextLock(context); context->setMass(inmass, ipart); }
+void TEvtProb::ResetWidth(double inwidth, int ipart){ MelaContext::Lock contextLock(context); context->setDecayWidth(inwidth, ipart); }
 void TEvtProb::ResetQuarkMasses(){
   ResetMass(1e-3, 1); // d
   ResetMass(5e-3, 2); // u
@@ -306,7 +349,14 @@ void TEvtProb::ResetQuarkMasses(){
   ResetMass(1e5, 8); // tprime
   //coupling_(); // Already called at b and t twice!
 }
-void TEvtProb::ResetMCFM_EWKParameters(double ext_Gf, double ext_aemmz, double ext_mW, double ext_mZ, double ext_xW, int ext_ewscheme){ SetEwkCouplingParameters(ext_Gf, ext_aemmz, ext_mW, ext_mZ, ext_xW, ext_ewscheme); }
+void TEvtProb::ResetMCFM_EWKParameters(double ext_Gf, double ext_aemmz, double ext_mW, double ext_mZ, double ext_xW, int ext_ewscheme){
+  MelaContext::Lock contextLock(context);
+  context->setEwkCouplingParameters(ext_Gf, ext_aemmz, ext_mW, ext_mZ, ext_xW, ext_ewscheme);
+}
+void TEvtProb::ResetCKMElements(double invckm_ud, double invckm_us, double invckm_cd, double invckm_cs, double invckm_ts, double invckm_tb, double invckm_ub, double invckm_cb, double invckm_td){
+  MelaContext::Lock contextLock(context);
+  context->setCKMElements(invckm_ud, invckm_us, invckm_cd, invckm_cs, invckm_ts, invckm_tb, invckm_ub, invckm_cb, invckm_td);
+}
 void TEvtProb::ResetCouplings(){
   selfDSpinZeroCoupl.reset();
   selfDSpinOneCoupl.reset();
@@ -314,28 +364,16 @@ void TEvtProb::ResetCouplings(){
   AllowSeparateWWCouplings(false);
 }
 void TEvtProb::ResetInputEvent(){
+  MelaContext::Lock contextLock(0); // Only to guard the shared-event computation state
+  ResetSharedEventComputation();
   RcdME.melaCand = 0;
   melaCand = 0;
 
-  // Clear bookkeeping objects
-  // Clean MELACandidates first since they contain all other objects
-  for (unsigned int p=0; p<candList.size(); p++){
-    MELACandidate* tmpCand = (MELACandidate*)candList.at(p);
-    if (tmpCand!=0) delete tmpCand;
-  }
+  // Clear bookkeeping objects. All of them belong to the arena, which only marks them for reuse.
   candList.clear();
-  // Clean MELATopCandidates next since they contain MELAParticles
-  for (unsigned int p=0; p<topCandList.size(); p++){
-    MELATopCandidate* tmpCand = (MELATopCandidate*)topCandList.at(p);
-    if (tmpCand!=0) delete tmpCand;
-  }
   topCandList.clear();
-  // Clean all remaining MELAPArticles
-  for (unsigned int p=0; p<particleList.size(); p++){
-    MELAParticle* tmpPart = (MELAParticle*)particleList.at(p);
-    if (tmpPart!=0) delete tmpPart;
-  }
   particleList.clear();
+  eventArena.rewind();
 }
 
 // Get-functions
@@ -354,6 +392,8 @@ int TEvtProb::GetCurrentCandidateIndex(){
 }
 int TEvtProb::GetNCandidates(){ return (static_cast<int>(candList.size())); }
 std::vector<MELATopCandidate*>* TEvtProb::GetTopCandidates(){ return &topCandList; }
+const MELAEventArena* TEvtProb::GetEventArena(){ return &eventArena; }
+MelaContext* TEvtProb::GetContext(){ return context; }
 
 
 // Check/test functions
@@ -377,6 +417,7 @@ bool TEvtProb::CheckInputPresent(){
 // Cross-section calculations for H + 0 jet
 double TEvtProb::XsecCalc_XVV(){
   if (verbosity>=TVar::DEBUG) cout << "Begin XsecCalc_XVV" << endl;
+  MelaContext::Lock contextLock(context);
   double dXsec=0;
   ResetIORecord();
   if (!CheckInputPresent()) return dXsec;
@@ -386,7 +427,7 @@ double TEvtProb::XsecCalc_XVV(){
   bool needBSMHiggs=false;
   if (useMCFM){
     if (verbosity>=TVar::DEBUG) cout << "TEvtProb::XsecCalc_XVV: Try MCFM" << endl;
-    needBSMHiggs = CheckSelfDCouplings_Hgg() || CheckSelfDCouplings_Htt() || CheckSelfDCouplings_Hbb() || CheckSelfDCouplings_HVV();
+    needBSMHiggs = forceMCFMBSMHiggs || CheckSelfDCouplings_Hgg() || CheckSelfDCouplings_Htt() || CheckSelfDCouplings_Hbb() || CheckSelfDCouplings_HVV();
     if (needBSMHiggs) SetLeptonInterf(TVar::InterfOn); // All anomalous coupling computations have to use lepton interference
 
     calculateME = (
@@ -623,9 +664,162 @@ double TEvtProb::XsecCalc_XVV(){
   return dXsec;
 }
 
+// Batched cross-section calculations for H + 0 jet
+void TEvtProb::XsecCalc_XVV_Batch(
+  std::vector<SimpleParticleCollection_t>& daughtersList,
+  std::vector<double>& dXsecList,
+  double wJHUGen,
+  std::vector<SimpleParticleCollection_t>* associatedList,
+  std::vector<SimpleParticleCollection_t>* mothersList,
+  bool isGen
+  ){
+  if (verbosity>=TVar::DEBUG) cout << "Begin XsecCalc_XVV_Batch" << endl;
+  MelaContext::Lock contextLock(context);
+  const unsigned int nEvents = daughtersList.size();
+  dXsecList.assign(nEvents, 0.);
+  if (
+    (associatedList!=0 && associatedList->size()!=nEvents)
+    ||
+    (mothersList!=0 && mothersList->size()!=nEvents)
+    ){
+    cerr << "TEvtProb::XsecCalc_XVV_Batch: Associated or mother particle lists do not match the size of the daughter list!" << endl;
+    return;
+  }
+
+  // XsecCalc_XVV resets the couplings and lepton interference at the end of each call, so keep a copy to restore them per event.
+  SpinZeroCouplings batchSpinZeroCoupl = selfDSpinZeroCoupl;
+  SpinOneCouplings batchSpinOneCoupl = selfDSpinOneCoupl;
+  SpinTwoCouplings batchSpinTwoCoupl = selfDSpinTwoCoupl;
+  TVar::LeptonInterference batchLeptonInterf = leptonInterf;
+  TVar::event_scales_type batch_event_scales = event_scales;
+  MELACandidate* inputCand = melaCand;
+
+  batchArena.rewind();
+  for (unsigned int ev=0; ev<nEvents; ev++){
+    MELACandidate* cand = ConvertVectorFormat(
+      &(daughtersList.at(ev)),
+      (associatedList!=0 ? &(associatedList->at(ev)) : 0),
+      (mothersList!=0 ? &(mothersList->at(ev)) : 0),
+      isGen,
+      0, 0,
+      &batchArena
+      );
+    if (cand!=0){
+      melaCand = cand;
+      selfDSpinZeroCoupl = batchSpinZeroCoupl;
+      selfDSpinOneCoupl = batchSpinOneCoupl;
+      selfDSpinTwoCoupl = batchSpinTwoCoupl;
+      AllowSeparateWWCouplings(batchSpinZeroCoupl.separateWWZZcouplings);
+      SetLeptonInterf(batchLeptonInterf);
+      event_scales = batch_event_scales;
+      if (matrixElement==TVar::JHUGen) SetHiggsMass(melaCand->m(), wJHUGen, -1);
+
+      dXsecList.at(ev) = XsecCalc_XVV();
+    }
+    else if (verbosity>=TVar::ERROR) cerr << "TEvtProb::XsecCalc_XVV_Batch: Event " << ev << " could not be converted to a candidate." << endl;
+
+    batchArena.rewind();
+  }
+
+  // Point back to the input event
+  melaCand = inputCand;
+  SetRcdCandPtr();
+  SetLeptonInterf(batchLeptonInterf);
+  if (verbosity>=TVar::DEBUG) cout << "End XsecCalc_XVV_Batch" << endl;
+}
+
+// Cross-section calculations for H + 0 jet over the points of an angular integration
+void TEvtProb::XsecCalc_XVV_AngularGrid(
+  MelaAngularIntegrator& integrator,
+  std::vector<double>& dXsecList,
+  double wJHUGen
+  ){
+  if (verbosity>=TVar::DEBUG) cout << "Begin XsecCalc_XVV_AngularGrid" << endl;
+  MelaContext::Lock contextLock(context);
+  const unsigned int nPoints = integrator.getNPoints();
+  dXsecList.assign(nPoints, 0.);
+
+  // Same per-point restoration as in XsecCalc_XVV_Batch
+  SpinZeroCouplings batchSpinZeroCoupl = selfDSpinZeroCoupl;
+  SpinOneCouplings batchSpinOneCoupl = selfDSpinOneCoupl;
+  SpinTwoCouplings batchSpinTwoCoupl = selfDSpinTwoCoupl;
+  TVar::LeptonInterference batchLeptonInterf = leptonInterf;
+  TVar::event_scales_type batch_event_scales = event_scales;
+  MELACandidate* inputCand = melaCand;
+
+  for (unsigned int ip=0; ip<nPoints; ip++){
+    MELACandidate* cand = integrator.setPoint(ip);
+    if (cand!=0){
+      if (verbosity>=TVar::DEBUG){ cout << "TEvtProb::XsecCalc_XVV_AngularGrid: Point " << ip << " produces candidate:" << endl; TUtil::PrintCandidateSummary(cand); }
+      ResetSharedEventComputation(); // The scratch candidate keeps its address while its momenta change
+      melaCand = cand;
+      selfDSpinZeroCoupl = batchSpinZeroCoupl;
+      selfDSpinOneCoupl = batchSpinOneCoupl;
+      selfDSpinTwoCoupl = batchSpinTwoCoupl;
+      AllowSeparateWWCouplings(batchSpinZeroCoupl.separateWWZZcouplings);
+      SetLeptonInterf(batchLeptonInterf);
+      event_scales = batch_event_scales;
+      if (matrixElement==TVar::JHUGen) SetHiggsMass(melaCand->m(), wJHUGen, -1);
+
+      dXsecList.at(ip) = XsecCalc_XVV();
+    }
+    else if (verbosity>=TVar::ERROR) cerr << "TEvtProb::XsecCalc_XVV_AngularGrid: Failed to construct the candidate of point " << ip << "!" << endl;
+  }
+  ResetSharedEventComputation();
+
+  // Point back to the input event
+  melaCand = inputCand;
+  SetRcdCandPtr();
+  SetLeptonInterf(batchLeptonInterf);
+  if (verbosity>=TVar::DEBUG) cout << "End XsecCalc_XVV_AngularGrid" << endl;
+}
+
+// Cross-section calculations for H + 2 jets over the pseudorapidity of one jet, moved in place, until the eta integration grid is complete
+void TEvtProb::XsecCalcXJJ_JetEtaIntegration(
+  MelaJetEtaIntegrator& integrator,
+  MELAParticle* jet
+  ){
+  if (verbosity>=TVar::DEBUG) cout << "Begin XsecCalcXJJ_JetEtaIntegration" << endl;
+  // The points are computed one after the other under a single lock: JHUGen is compiled with -fno-automatic and keeps its couplings in module variables,
+  // so two points of the grid cannot be computed concurrently within one process.
+  MelaContext::Lock contextLock(context);
+
+  // XsecCalcXJJ resets the couplings and scales at the end of each call, so keep a copy to restore them per point as in XsecCalc_XVV_Batch.
+  SpinZeroCouplings batchSpinZeroCoupl = selfDSpinZeroCoupl;
+  SpinOneCouplings batchSpinOneCoupl = selfDSpinOneCoupl;
+  SpinTwoCouplings batchSpinTwoCoupl = selfDSpinTwoCoupl;
+  TVar::LeptonInterference batchLeptonInterf = leptonInterf;
+  TVar::event_scales_type batch_event_scales = event_scales;
+  TLorentzVector pJetOriginal = jet->p4;
+
+  double eta=0;
+  while (integrator.nextPoint(eta)){
+    float dXsec=0;
+    if (integrator.getJetMomentum(eta, jet->p4)){
+      ResetSharedEventComputation(); // The candidate keeps its address while the jet momentum changes
+      selfDSpinZeroCoupl = batchSpinZeroCoupl;
+      selfDSpinOneCoupl = batchSpinOneCoupl;
+      selfDSpinTwoCoupl = batchSpinTwoCoupl;
+      AllowSeparateWWCouplings(batchSpinZeroCoupl.separateWWZZcouplings);
+      SetLeptonInterf(batchLeptonInterf);
+      event_scales = batch_event_scales;
+
+      dXsec = XsecCalcXJJ();
+      if (verbosity>=TVar::DEBUG) cout << "TEvtProb::XsecCalcXJJ_JetEtaIntegration: eta=" << eta << ", dXsec=" << dXsec << endl;
+    }
+    integrator.setValue(dXsec);
+  }
+  ResetSharedEventComputation();
+
+  jet->p4 = pJetOriginal;
+  SetLeptonInterf(batchLeptonInterf);
+  if (verbosity>=TVar::DEBUG) cout << "End XsecCalcXJJ_JetEtaIntegration" << endl;
+}
+
 // Cross-section calculations for H(->VV) + 2 jets
 double TEvtProb::XsecCalc_VVXVV(){
   if (verbosity>=TVar::DEBUG) cout << "Begin XsecCalc_VVXVV" << endl;
+  MelaContext::Lock contextLock(context);
   double dXsec=0;
   ResetIORecord();
   if (!CheckInputPresent()) return dXsec;
@@ -635,7 +829,7 @@ double TEvtProb::XsecCalc_VVXVV(){
   bool calculateME=false;
   if (useMCFM){
     if (verbosity>=TVar::DEBUG) cout << "TEvtProb::XsecCalc_VVXVV: Try MCFM" << endl;
-    needBSMHiggs = CheckSelfDCouplings_HVV();
+    needBSMHiggs = forceMCFMBSMHiggs || CheckSelfDCouplings_HVV();
     if (needBSMHiggs) SetLeptonInterf(TVar::InterfOn); // All anomalous coupling computations have to use lepton interference
 
     calculateME = (
@@ -669,6 +863,7 @@ double TEvtProb::XsecCalc_VVXVV(){
 // Cross-section calculations for H + 2 jets
 double TEvtProb::XsecCalcXJJ(){
   if (verbosity>=TVar::DEBUG) cout << "Begin XsecCalc_XJJ" << endl;
+  MelaContext::Lock contextLock(context);
   if (matrixElement == TVar::MCFM) return XsecCalc_VVXVV();
   double dXsec = 0;
   ResetIORecord();
@@ -732,6 +927,7 @@ double TEvtProb::XsecCalcXJJ(){
 // Cross-section calculations for H + 1 jet (only SM for the moment)
 double TEvtProb::XsecCalcXJ(){
   if (verbosity>=TVar::DEBUG) cout << "Begin XsecCalc_XJ" << endl;
+  MelaContext::Lock contextLock(context);
   double dXsec = 0;
   ResetIORecord();
   if (!CheckInputPresent()) return dXsec;
@@ -765,6 +961,7 @@ double TEvtProb::XsecCalc_VX(
   bool includeHiggsDecay
   ){
   if (verbosity>=TVar::DEBUG) cout << "Begin XsecCalc_VX" << endl;
+  MelaContext::Lock contextLock(context);
   if (matrixElement == TVar::MCFM) return XsecCalc_VVXVV();
   double dXsec = 0;
   ResetIORecord();
@@ -813,6 +1010,7 @@ double TEvtProb::XsecCalc_TTX(
   int topProcess, int topDecay
   ){
   if (verbosity>=TVar::DEBUG) cout << "Begin XsecCalc_TTX" << endl;
+  MelaContext::Lock contextLock(context);
   double dXsec = 0;
   ResetIORecord();
   if (!CheckInputPresent()) return dXsec;
@@ -1,7 +1,9 @@
 #include <iostream>
 #include <cstdio>
+#include <cstring>
 #include <cmath>
 #include <utility>
+#include <map>
 #include <algorithm>
 #include "TUtil.hh"
 #include "TMath.h"
@@ -20,6 +22,515 @@ namespace TUtil{
   TVar::FermionMassRemoval JetMassScheme = TVar::ConserveDifermionMass;
 }
 
+namespace{
+  // State of the shared-event computation, see TUtil::BeginSharedEventComputation
+  // Candidate addresses are recycled (temporary and scratch candidates), so the boosted events are matched by the candidate kinematics as well.
+  struct SharedBoostedEvent{
+    MELACandidate* cand;
+    std::vector<double> kinematics;
+    simple_event_record record;
+  };
+  int sharedEventDepth=0;
+  std::vector<SharedBoostedEvent> sharedBoostedEvents;
+  double sharedRenScale=0;
+  double sharedFacScale=0;
+  int sharedNloop=0;
+  int sharedNflav=0;
+  std::string sharedPdflabel;
+
+  bool isSameBoostRequest(const simple_event_record& rcd1, const simple_event_record& rcd2){
+    return (
+      rcd1.AssociationCode==rcd2.AssociationCode
+      && rcd1.AssociationVCompatibility==rcd2.AssociationVCompatibility
+      && rcd1.nRequested_AssociatedJets==rcd2.nRequested_AssociatedJets
+      && rcd1.nRequested_AssociatedLeptons==rcd2.nRequested_AssociatedLeptons
+      && rcd1.nRequested_AssociatedPhotons==rcd2.nRequested_AssociatedPhotons
+      && rcd1.nRequested_Tops==rcd2.nRequested_Tops
+      && rcd1.nRequested_Antitops==rcd2.nRequested_Antitops
+      );
+  }
+  void appendParticleKinematics(const MELAParticle* part, std::vector<double>& kinematics){
+    kinematics.push_back(part->id);
+    kinematics.push_back(part->x()); kinematics.push_back(part->y()); kinematics.push_back(part->z()); kinematics.push_back(part->t());
+    kinematics.push_back(part->passSelection ? 1 : 0);
+  }
+  void getSharedEventKinematics(const MELACandidate* cand, std::vector<double>& kinematics){
+    kinematics.clear();
+    appendParticleKinematics(cand, kinematics);
+    for (int ip=0; ip<cand->getNMothers(); ip++) appendParticleKinematics(cand->getMother(ip), kinematics);
+    for (int ip=0; ip<cand->getNDaughters(); ip++) appendParticleKinematics(cand->getDaughter(ip), kinematics);
+    for (int ip=0; ip<cand->getNAssociatedLeptons(); ip++) appendParticleKinematics(cand->getAssociatedLepton(ip), kinematics);
+    for (int ip=0; ip<cand->getNAssociatedNeutrinos(); ip++) appendParticleKinematics(cand->getAssociatedNeutrino(ip), kinematics);
+    for (int ip=0; ip<cand->getNAssociatedPhotons(); ip++) appendParticleKinematics(cand->getAssociatedPhoton(ip), kinematics);
+    for (int ip=0; ip<cand->getNAssociatedJets(); ip++) appendParticleKinematics(cand->getAssociatedJet(ip), kinematics);
+    for (int ip=0; ip<cand->getNAssociatedTops(); ip++){
+      const MELATopCandidate* top = cand->getAssociatedTop(ip);
+      appendParticleKinematics(top, kinematics);
+      for (int jp=0; jp<top->getNDaughters(); jp++) appendParticleKinematics(top->getDaughter(jp), kinematics);
+    }
+  }
+
+  // PDF and alpha_s caches, see TUtil::InvalidatePDFCache
+  struct PDFCacheEntry{
+    bool isValid;
+    double x1;
+    double x2;
+    double facscale;
+    double fx1[nmsq];
+    double fx2[nmsq];
+  };
+  struct AlphaSCacheEntry{
+    bool isValid;
+    double scale;
+    double alphas;
+    double alphasmz;
+  };
+  const unsigned int nPDFCacheEntries=16;
+  const unsigned int nAlphaSCacheEntries=8;
+
+  // Assignment of the top and antitop daughters to the JHUGen ttH momentum positions
+  struct TTHAssignment{
+    unsigned int b1index, f1index, fb1index;
+    unsigned int b2index, f2index, fb2index;
+  };
+
+  // Per-channel pieces of the JJQCD MEs of the last event, see TUtil::HJJMatEl.
+  // |M|**2 = |ghg2|**2 A + |ghg4|**2 B + 2 Re(ghg2 conj(ghg4) C) in each channel, and ghg3 does not enter.
+  enum{
+    kHJJPiece_A=0,
+    kHJJPiece_B,
+    kHJJPiece_ReC,
+    kHJJPiece_ImC,
+    nHJJChannelPieces
+  };
+  struct HJJChannelCacheEntry{
+    int sel[4]; // isel, jsel, rsel, ssel
+    bool isValid[nHJJChannelPieces];
+    double piece[nHJJChannelPieces];
+  };
+  struct HJJChannelCacheRecord{
+    bool isValid;
+    double p4[5][4];
+    int ids[4];
+    double alphas;
+    std::vector<HJJChannelCacheEntry> channels; // In the order of evaluation, which is fixed by the ids
+    // State of the current HJJMatEl call
+    double Hggcoupl[SIZE_HGG][2];
+    unsigned int nextChannel;
+    bool couplingsModified;
+  };
+
+
+  // MCFM configurations resolved by MCFM_chooser and MCFM_SetupParticleCouplings, see TUtil::MCFM_SetupProcess.
+  // The commons written only in some of the branches are flagged in mcfmConfigWrites by the choosers.
+  enum{
+    kMCFMWrite_srdiags=0x1,
+    kMCFMWrite_breitV2=0x2, // mass2, width2
+    kMCFMWrite_breitV3=0x4, // mass3, width3
+    kMCFMWrite_breitW=0x8, // The masses and widths above are those of the W instead of the Z
+    kMCFMWrite_vsymfact=0x10, // vsymfact, interference
+    kMCFMWrite_flags=0x20,
+    kMCFMWrite_nuflav=0x40,
+    kMCFMWrite_lastphot=0x80,
+    kMCFMWrite_toggles=0x100 // channeltoggle_stu, vvhvvtoggle_vbfvh
+  };
+  unsigned int mcfmConfigWrites=0;
+  struct MCFMConfigKey{
+    TVar::Process process;
+    TVar::Production production;
+    TVar::LeptonInterference leptonInterf;
+    int nRequested_AssociatedJets;
+    int nRequested_AssociatedLeptons;
+    std::vector<int> daughterIds;
+    std::vector<int> intermediateVids;
+    std::vector<int> associatedIds;
+    std::vector<int> motherIds;
+
+    bool operator<(const MCFMConfigKey& other) const{
+      if (process!=other.process) return process<other.process;
+      if (production!=other.production) return production<other.production;
+      if (leptonInterf!=other.leptonInterf) return leptonInterf<other.leptonInterf;
+      if (nRequested_AssociatedJets!=other.nRequested_AssociatedJets) return nRequested_AssociatedJets<other.nRequested_AssociatedJets;
+      if (nRequested_AssociatedLeptons!=other.nRequested_AssociatedLeptons) return nRequested_AssociatedLeptons<other.nRequested_AssociatedLeptons;
+      if (daughterIds!=other.daughterIds) return daughterIds<other.daughterIds;
+      if (intermediateVids!=other.intermediateVids) return intermediateVids<other.intermediateVids;
+      if (associatedIds!=other.associatedIds) return associatedIds<other.associatedIds;
+      return motherIds<other.motherIds;
+    }
+  };
+  struct MCFMConfigCacheEntry{
+    unsigned int writes;
+    int npart;
+    std::string runstring;
+    int nqcdjets;
+    int nwz;
+    int ndim;
+    int n2, n3;
+    bool srdiags;
+    double vsymfact;
+    bool interference;
+    bool Qflag, Gflag, QandGflag;
+    int nuflav;
+    int lastphot;
+    int channeltoggle_stu, vvhvvtoggle_vbfvh;
+    double q1, l1, r1, q2, l2, r2;
+    char plabel[mxpart][3];
+    std::vector<int> partOrder;
+    std::vector<int> apartOrder;
+  };
+
+  void setIdList(std::vector<int>& ids, const SimpleParticleCollection_t& particles){
+    ids.clear();
+    for (unsigned int ip=0; ip<particles.size(); ip++) ids.push_back(particles.at(ip).first);
+  }
+  void SetMCFMConfigKey(
+    MCFMConfigKey& key,
+    const TVar::Process& process, const TVar::Production& production, const TVar::LeptonInterference& leptonInterf,
+    const simple_event_record& mela_event
+    ){
+    key.process=process;
+    key.production=production;
+    key.leptonInterf=leptonInterf;
+    key.nRequested_AssociatedJets=mela_event.nRequested_AssociatedJets;
+    key.nRequested_AssociatedLeptons=mela_event.nRequested_AssociatedLeptons;
+    key.intermediateVids=mela_event.intermediateVid;
+    setIdList(key.daughterIds, mela_event.pDaughters);
+    setIdList(key.associatedIds, mela_event.pAssociated);
+    setIdList(key.motherIds, mela_event.pMothers);
+  }
+  void StoreMCFMConfig(
+    MCFMConfigCacheEntry& entry,
+    const std::vector<int>& partOrder, const std::vector<int>& apartOrder
+    ){
+    entry.writes=mcfmConfigWrites;
+    entry.npart=npart_.npart;
+    entry.runstring=runstring_.runstring;
+    entry.nqcdjets=nqcdjets_.nqcdjets;
+    entry.nwz=nwz_.nwz;
+    entry.ndim=bveg1_mcfm_.ndim;
+    entry.n2=breit_.n2;
+    entry.n3=breit_.n3;
+    entry.srdiags=srdiags_.srdiags;
+    entry.vsymfact=vsymfact_.vsymfact;
+    entry.interference=interference_.interference;
+    entry.Qflag=flags_.Qflag;
+    entry.Gflag=flags_.Gflag;
+    entry.QandGflag=flags_.QandGflag;
+    entry.nuflav=nuflav_.nuflav;
+    entry.lastphot=lastphot_.lastphot;
+    entry.channeltoggle_stu=spinzerohiggs_anomcoupl_.channeltoggle_stu;
+    entry.vvhvvtoggle_vbfvh=spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh;
+    entry.q1=zcouple_.q1; entry.l1=zcouple_.l1; entry.r1=zcouple_.r1;
+    entry.q2=zcouple_.q2; entry.l2=zcouple_.l2; entry.r2=zcouple_.r2;
+    for (int ip=0; ip<mxpart; ip++){
+      entry.plabel[ip][0]=(plabel_.plabel)[ip][0];
+      entry.plabel[ip][1]=(plabel_.plabel)[ip][1];
+      entry.plabel[ip][2]='\0';
+    }
+    entry.partOrder=partOrder;
+    entry.apartOrder=apartOrder;
+  }
+  // Writes the same values to the MCFM commons as the choosers did when the entry was stored
+  void ApplyMCFMConfig(const MCFMConfigCacheEntry& entry, std::vector<int>* partOrder, std::vector<int>* apartOrder){
+    npart_.npart=entry.npart;
+    sprintf(runstring_.runstring, "%s", entry.runstring.c_str());
+    nqcdjets_.nqcdjets=entry.nqcdjets;
+    nwz_.nwz=entry.nwz; ckmfill_(&(nwz_.nwz));
+    bveg1_mcfm_.ndim=entry.ndim;
+    breit_.n2=entry.n2;
+    breit_.n3=entry.n3;
+    const bool useW = ((entry.writes & kMCFMWrite_breitW)!=0);
+    if ((entry.writes & kMCFMWrite_breitV2)!=0){
+      breit_.mass2=(useW ? masses_mcfm_.wmass : masses_mcfm_.zmass);
+      breit_.width2=(useW ? masses_mcfm_.wwidth : masses_mcfm_.zwidth);
+    }
+    if ((entry.writes & kMCFMWrite_breitV3)!=0){
+      breit_.mass3=(useW ? masses_mcfm_.wmass : masses_mcfm_.zmass);
+      breit_.width3=(useW ? masses_mcfm_.wwidth : masses_mcfm_.zwidth);
+    }
+    if ((entry.writes & kMCFMWrite_srdiags)!=0) srdiags_.srdiags=entry.srdiags;
+    if ((entry.writes & kMCFMWrite_vsymfact)!=0){
+      vsymfact_.vsymfact=entry.vsymfact;
+      interference_.interference=entry.interference;
+    }
+    if ((entry.writes & kMCFMWrite_flags)!=0){
+      flags_.Qflag=entry.Qflag;
+      flags_.Gflag=entry.Gflag;
+      flags_.QandGflag=entry.QandGflag;
+    }
+    if ((entry.writes & kMCFMWrite_nuflav)!=0) nuflav_.nuflav=entry.nuflav;
+    if ((entry.writes & kMCFMWrite_lastphot)!=0) lastphot_.lastphot=entry.lastphot;
+    if ((entry.writes & kMCFMWrite_toggles)!=0){
+      spinzerohiggs_anomcoupl_.channeltoggle_stu=entry.channeltoggle_stu;
+      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh=entry.vvhvvtoggle_vbfvh;
+    }
+    zcouple_.q1=entry.q1; zcouple_.l1=entry.l1; zcouple_.r1=entry.r1;
+    zcouple_.q2=entry.q2; zcouple_.l2=entry.l2; zcouple_.r2=entry.r2;
+    for (int ip=0; ip<mxpart; ip++) sprintf((plabel_.plabel)[ip], "%s", entry.plabel[ip]);
+    if (partOrder!=0) partOrder->insert(partOrder->end(), entry.partOrder.begin(), entry.partOrder.end());
+    if (apartOrder!=0) apartOrder->insert(apartOrder->end(), entry.apartOrder.begin(), entry.apartOrder.end());
+  }
+
+  // Record of the couplings last pushed to MCFM and JHUGen, see TUtil::CouplingPushStatistics
+  // The records are compared by value, since the pushed arrays are rebuilt on each call and the coupling classes carry no version.
+  // Comparing an unchanged block costs less than pushing it again (about the same for the spin-2 block),
+  // but a changed MCFM block is compared and copied to the record on top of the write.
+
+  struct MCFMCouplingPushRecord{
+    bool isValid; // spinzerohiggs_anomcoupl_ holds the couplings described below
+    bool useBSM;
+    bool forceZZ;
+    SpinZeroCouplings Hcouplings; // Values written if useBSM=true
+    bool defaultPending; // Reset to the default couplings requested, but not yet written
+
+    MCFMCouplingPushRecord() : isValid(false), useBSM(false), forceZZ(false), defaultPending(false){}
+  };
+
+  struct JHUGenCouplingPushRecord{
+    bool hasDistinguishWW;
+    int distinguishWW;
+    bool hasGG;
+    double Hggcoupl[SIZE_HGG][2];
+    bool hasQQ;
+    double Hqqcoupl[SIZE_HQQ][2];
+    bool hasVV[2]; // [ZZ, WW] targets
+    double Hvvcoupl[2][SIZE_HVV][2];
+    int HvvCLambda_qsq[2][SIZE_HVV_CQSQ];
+    double HvvLambda_qsq[2][SIZE_HVV_LAMBDAQSQ][SIZE_HVV_CQSQ];
+    bool hasSpinOne;
+    double Zqqcoupl[SIZE_ZQQ][2];
+    double Zvvcoupl[SIZE_ZVV][2];
+    bool hasSpinTwo;
+    double Gggcoupl[SIZE_GGG][2];
+    double Gvvcoupl[SIZE_GVV][2];
+    double Gqqcoupl[SIZE_GQQ][2];
+
+    JHUGenCouplingPushRecord(){ invalidate(); }
+    void invalidate(){
+      hasDistinguishWW=false;
+      hasGG=false;
+      hasQQ=false;
+      hasVV[0]=false; hasVV[1]=false;
+      hasSpinOne=false;
+      hasSpinTwo=false;
+    }
+  };
+
+  template<typename T, size_t N> bool isSameCouplingArray(const T (&c1)[N], const T (&c2)[N]){ return (memcmp(c1, c2, sizeof(c1))==0); }
+  bool isSameSpinZeroCouplings(const SpinZeroCouplings& c1, const SpinZeroCouplings& c2){
+    return (
+      c1.separateWWZZcouplings==c2.separateWWZZcouplings
+      && isSameCouplingArray(c1.Hggcoupl, c2.Hggcoupl) && isSameCouplingArray(c1.Hg4g4coupl, c2.Hg4g4coupl)
+      && isSameCouplingArray(c1.Hqqcoupl, c2.Hqqcoupl) && isSameCouplingArray(c1.Httcoupl, c2.Httcoupl) && isSameCouplingArray(c1.Hbbcoupl, c2.Hbbcoupl)
+      && isSameCouplingArray(c1.Ht4t4coupl, c2.Ht4t4coupl) && isSameCouplingArray(c1.Hb4b4coupl, c2.Hb4b4coupl)
+      && isSameCouplingArray(c1.Hzzcoupl, c2.Hzzcoupl) && isSameCouplingArray(c1.Hwwcoupl, c2.Hwwcoupl)
+      && isSameCouplingArray(c1.HzzLambda_qsq, c2.HzzLambda_qsq) && isSameCouplingArray(c1.HwwLambda_qsq, c2.HwwLambda_qsq)
+      && isSameCouplingArray(c1.HzzCLambda_qsq, c2.HzzCLambda_qsq) && isSameCouplingArray(c1.HwwCLambda_qsq, c2.HwwCLambda_qsq)
+      && isSameCouplingArray(c1.H2ggcoupl, c2.H2ggcoupl) && isSameCouplingArray(c1.H2g4g4coupl, c2.H2g4g4coupl)
+      && isSameCouplingArray(c1.H2qqcoupl, c2.H2qqcoupl) && isSameCouplingArray(c1.H2ttcoupl, c2.H2ttcoupl) && isSameCouplingArray(c1.H2bbcoupl, c2.H2bbcoupl)
+      && isSameCouplingArray(c1.H2t4t4coupl, c2.H2t4t4coupl) && isSameCouplingArray(c1.H2b4b4coupl, c2.H2b4b4coupl)
+      && isSameCouplingArray(c1.H2zzcoupl, c2.H2zzcoupl) && isSameCouplingArray(c1.H2wwcoupl, c2.H2wwcoupl)
+      && isSameCouplingArray(c1.H2zzLambda_qsq, c2.H2zzLambda_qsq) && isSameCouplingArray(c1.H2wwLambda_qsq, c2.H2wwLambda_qsq)
+      && isSameCouplingArray(c1.H2zzCLambda_qsq, c2.H2zzCLambda_qsq) && isSameCouplingArray(c1.H2wwCLambda_qsq, c2.H2wwCLambda_qsq)
+      );
+  }
+  // Copies the coupling array pushed to its record, and returns true if the record had different values
+  bool UpdateCouplingRecord(void* record, const void* coupl, size_t size){
+    if (memcmp(record, coupl, size)==0) return false;
+    memcpy(record, coupl, size);
+    return true;
+  }
+}
+
+// Caches and coupling push records of a MelaContext, see TUtil::SetContextState
+struct TUtil::ContextState{
+  // PDF and alpha_s caches, see TUtil::InvalidatePDFCache
+  PDFCacheEntry pdfCache[nPDFCacheEntries];
+  AlphaSCacheEntry alphasCache[nAlphaSCacheEntries];
+  unsigned int pdfCacheNext; // Oldest entry, overwritten next
+  unsigned int alphasCacheNext;
+  bool pdfCaching;
+  TUtil::PDFCacheStatistics pdfCacheStatistics;
+
+  TUtil::TTHPermutationStatistics ttHPermutationStatistics;
+
+  HJJChannelCacheRecord hjjChannelCache;
+  bool hjjChannelCaching;
+  TUtil::HJJChannelCacheStatistics hjjChannelCacheStatistics;
+
+  bool vhHelicitySumming;
+
+  // Only successful configurations are stored, so the number of entries is bounded by the distinct hypotheses and particle ids in use
+  std::map<MCFMConfigKey, MCFMConfigCacheEntry> mcfmConfigCache;
+  bool mcfmConfigCaching;
+  TUtil::MCFMConfigCacheStatistics mcfmConfigCacheStatistics;
+
+  // Record of the couplings last pushed to MCFM and JHUGen while this state was active
+  bool couplingPushTracking;
+  TUtil::CouplingPushStatistics couplingPushStatistics;
+  MCFMCouplingPushRecord mcfmCouplingPush;
+  JHUGenCouplingPushRecord jhugenCouplingPush;
+
+  ContextState() :
+    pdfCacheNext(0),
+    alphasCacheNext(0),
+    pdfCaching(true),
+    hjjChannelCaching(true),
+    vhHelicitySumming(true),
+    mcfmConfigCaching(true),
+    couplingPushTracking(true)
+  {
+    for (unsigned int ic=0; ic<nPDFCacheEntries; ic++) pdfCache[ic].isValid=false;
+    for (unsigned int ic=0; ic<nAlphaSCacheEntries; ic++) alphasCache[ic].isValid=false;
+    hjjChannelCache.isValid=false;
+  }
+};
+
+namespace{
+  TUtil::ContextState defaultContextState; // Used outside of any MelaContext
+  TUtil::ContextState* contextState=&defaultContextState;
+
+  void BeginHJJChannelCache(double p4[5][4], int ids[4], double alphas){
+    bool isSameEvent = (contextState->hjjChannelCache.isValid && contextState->hjjChannelCache.alphas==alphas);
+    for (unsigned int ip=0; ip<5 && isSameEvent; ip++){ for (unsigned int ix=0; ix<4; ix++) isSameEvent = isSameEvent && (contextState->hjjChannelCache.p4[ip][ix]==p4[ip][ix]); }
+    for (unsigned int ip=0; ip<4 && isSameEvent; ip++) isSameEvent = (contextState->hjjChannelCache.ids[ip]==ids[ip]);
+    if (!isSameEvent){
+      for (unsigned int ip=0; ip<5; ip++){ for (unsigned int ix=0; ix<4; ix++) contextState->hjjChannelCache.p4[ip][ix]=p4[ip][ix]; }
+      for (unsigned int ip=0; ip<4; ip++) contextState->hjjChannelCache.ids[ip]=ids[ip];
+      contextState->hjjChannelCache.alphas=alphas;
+      contextState->hjjChannelCache.channels.clear();
+      contextState->hjjChannelCache.isValid=true;
+    }
+    __modjhugenmela_MOD_getspinzeroggcouplings(contextState->hjjChannelCache.Hggcoupl);
+    contextState->hjjChannelCache.nextChannel=0;
+    contextState->hjjChannelCache.couplingsModified=false;
+  }
+  void EndHJJChannelCache(){
+    if (contextState->hjjChannelCache.couplingsModified) TUtil::SetJHUGenSpinZeroGGCouplings(contextState->hjjChannelCache.Hggcoupl);
+  }
+  // Replaces __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact between BeginHJJChannelCache and EndHJJChannelCache
+  void EvalHJJChannel(double p4[5][4], int isel, int jsel, int rsel, int ssel, double* msq){
+    if (!contextState->hjjChannelCaching){ // One call with the couplings set by TEvtProb, as without the cache
+      __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, msq);
+      contextState->hjjChannelCacheStatistics.nAmplitudeEvaluations++;
+      contextState->hjjChannelCacheStatistics.nMisses++;
+      return;
+    }
+
+    const double* g2 = contextState->hjjChannelCache.Hggcoupl[gHIGGS_GG_2];
+    const double* g4 = contextState->hjjChannelCache.Hggcoupl[gHIGGS_GG_4];
+    const double z_re = g2[0]*g4[0]+g2[1]*g4[1]; // ghg2 conj(ghg4)
+    const double z_im = g2[1]*g4[0]-g2[0]*g4[1];
+    bool isNeeded[nHJJChannelPieces]={ (g2[0]!=0. || g2[1]!=0.), (g4[0]!=0. || g4[1]!=0.), (z_re!=0.), (z_im!=0.) };
+    if (isNeeded[kHJJPiece_ReC] || isNeeded[kHJJPiece_ImC]){ isNeeded[kHJJPiece_A]=true; isNeeded[kHJJPiece_B]=true; }
+
+    const int sel[4]={ isel, jsel, rsel, ssel };
+    if (contextState->hjjChannelCache.nextChannel==contextState->hjjChannelCache.channels.size()){
+      HJJChannelCacheEntry newEntry;
+      for (unsigned int ip=0; ip<nHJJChannelPieces; ip++){ newEntry.isValid[ip]=false; newEntry.piece[ip]=0; }
+      contextState->hjjChannelCache.channels.push_back(newEntry);
+    }
+    HJJChannelCacheEntry& entry = contextState->hjjChannelCache.channels.at(contextState->hjjChannelCache.nextChannel);
+    contextState->hjjChannelCache.nextChannel++;
+    bool isSameChannel = true;
+    for (unsigned int is=0; is<4; is++) isSameChannel = isSameChannel && (entry.sel[is]==sel[is]);
+    if (!isSameChannel){
+      for (unsigned int is=0; is<4; is++) entry.sel[is]=sel[is];
+      for (unsigned int ip=0; ip<nHJJChannelPieces; ip++) entry.isValid[ip]=false;
+    }
+
+    bool isHit=true;
+    for (unsigned int ip=0; ip<nHJJChannelPieces; ip++){
+      if (!isNeeded[ip] || entry.isValid[ip]) continue;
+      double basisHggcoupl[SIZE_HGG][2];
+      for (int ic=0; ic<SIZE_HGG; ic++){ for (int im=0; im<2; im++) basisHggcoupl[ic][im] = contextState->hjjChannelCache.Hggcoupl[ic][im]; }
+      for (int im=0; im<2; im++){ basisHggcoupl[gHIGGS_GG_2][im]=0; basisHggcoupl[gHIGGS_GG_4][im]=0; }
+      if (ip!=kHJJPiece_B) basisHggcoupl[gHIGGS_GG_2][0]=1;
+      if (ip==kHJJPiece_B || ip==kHJJPiece_ReC) basisHggcoupl[gHIGGS_GG_4][0]=1;
+      else if (ip==kHJJPiece_ImC) basisHggcoupl[gHIGGS_GG_4][1]=1;
+      TUtil::SetJHUGenSpinZeroGGCouplings(basisHggcoupl);
+      contextState->hjjChannelCache.couplingsModified=true;
+
+      double msq_basis=0;
+      __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, &msq_basis);
+      // A and B are always computed before the interference pieces
+      if (ip==kHJJPiece_ReC || ip==kHJJPiece_ImC) msq_basis = (msq_basis - entry.piece[kHJJPiece_A] - entry.piece[kHJJPiece_B])/2.;
+      entry.piece[ip] = msq_basis;
+      entry.isValid[ip] = true;
+      contextState->hjjChannelCacheStatistics.nAmplitudeEvaluations++;
+      isHit=false;
+    }
+    if (isHit) contextState->hjjChannelCacheStatistics.nHits++;
+    else contextState->hjjChannelCacheStatistics.nMisses++;
+
+    double result=0;
+    if (isNeeded[kHJJPiece_A]) result += (pow(g2[0], 2)+pow(g2[1], 2))*entry.piece[kHJJPiece_A];
+    if (isNeeded[kHJJPiece_B]) result += (pow(g4[0], 2)+pow(g4[1], 2))*entry.piece[kHJJPiece_B];
+    if (isNeeded[kHJJPiece_ReC]) result += 2.*z_re*entry.piece[kHJJPiece_ReC];
+    if (isNeeded[kHJJPiece_ImC]) result -= 2.*z_im*entry.piece[kHJJPiece_ImC];
+    *msq = result;
+  }
+
+  // Raw MEs of one VH parton pair per helicity [h01][h56], summed over the H->f fbar templates and their spins if there are any, see TUtil::VHiggsMatEl.
+  // Hffids holds the (id8, id9) of the templates in the layout of EvalAmp_VHiggs_HelicitySum.
+  void EvalVHiggsHelicities(int vh_ids[9], double p4[9][4], const std::vector<std::pair<int, int>>& Hffparticles, std::vector<int>& Hffids, double msq_hel[2][2]){
+    if (contextState->vhHelicitySumming){ // One call, so that the currents and the XVV vertex are computed only once
+      int nHffparticles = Hffparticles.size();
+      __modvhiggs_MOD_evalamp_vhiggs_helicitysum(vh_ids, p4, &nHffparticles, &(Hffids.front()), msq_hel);
+      return;
+    }
+
+    // One call per helicity, as before EvalAmp_VHiggs_HelicitySum
+    const double allowed_helicities[2] ={ -1, 1 }; // L,R
+    double helicities[9] ={ 0 };
+    helicities[7] = 1;
+    helicities[8] = 1;
+    for (int h01 = 0; h01 < 2; h01++){
+      helicities[0] = allowed_helicities[h01];
+      helicities[1] = -helicities[0];
+      for (int h56 = 0; h56 < 2; h56++){
+        helicities[5] = allowed_helicities[h56];
+        helicities[6] = -helicities[5];
+
+        double msq_inst=0;
+        if (Hffparticles.empty()) __modvhiggs_MOD_evalamp_vhiggs(vh_ids, helicities, p4, &msq_inst);
+        else{
+          for (int h78=0; h78<2; h78++){
+            helicities[7]=allowed_helicities[h78];
+            helicities[8]=allowed_helicities[h78];
+            for (unsigned int ihf=0; ihf<Hffparticles.size(); ihf++){
+              vh_ids[7]=Hffparticles.at(ihf).first;
+              vh_ids[8]=Hffparticles.at(ihf).second;
+              double msq_inst_LR=0;
+              __modvhiggs_MOD_evalamp_vhiggs(vh_ids, helicities, p4, &msq_inst_LR);
+              msq_inst += msq_inst_LR;
+            } // End loop over template H->f fbar products
+          } // End loop over the spin of H->f fbar line
+        }
+        msq_hel[h01][h56] = msq_inst;
+      } // End loop over h56
+    } // End loop over h01
+  }
+
+  // Writes the default MCFM couplings if their push was deferred, has to be called before any MCFM ME
+  void ApplyPendingMCFMCouplings(){
+    if (!contextState->mcfmCouplingPush.defaultPending) return;
+    TUtil::WriteMCFMSpinZeroCouplings(false, 0, true);
+    contextState->couplingPushStatistics.nMCFMWrites++;
+    contextState->mcfmCouplingPush.isValid=true;
+    contextState->mcfmCouplingPush.useBSM=false;
+    contextState->mcfmCouplingPush.defaultPending=false;
+  }
+  // Counts the push of a JHUGen coupling block, and returns true if it has to be passed to mod_JHUGenMELA
+  bool IsJHUGenPushNeeded(bool& hasBlock, bool isModified){
+    contextState->couplingPushStatistics.nJHUGenPushes++;
+    if (contextState->couplingPushTracking && hasBlock && !isModified) return false;
+    hasBlock=true;
+    contextState->couplingPushStatistics.nJHUGenWrites++;
+    return true;
+  }
+}
+
 /***************************************************/
 /***** Scripts for decay and production angles *****/
 /***************************************************/
@@ -1039,6 +1550,8 @@ void TUtil::computeVHangles(
 /****************************************************/
 
 void TUtil::SetEwkCouplingParameters(double ext_Gf, double ext_aemmz, double ext_mW, double ext_mZ, double ext_xW, int ext_ewscheme){
+  InvalidateHJJChannelCache(); // The cached MEs depend on vev
+  InvalidateMCFMConfigCache(); // The cached Z couplings depend on the EW parameters
   // Set JHUGen couplings
   const double GeV=1./100.;
   double ext_mZ_jhu = ext_mZ*GeV;
@@ -1156,6 +1669,32 @@ void TUtil::SetDecayWidth(double inwidth, int ipart){
   int jpart = convertLHEreverse(&ipart);
   __modparameters_MOD_setdecaywidth(&jinwidth, &jpart);
 }
+double TUtil::GetMass(int ipart){
+  // MCFM masses are used since JHUGen does not store light quark masses
+  if (abs(ipart)==8) return spinzerohiggs_anomcoupl_.mt_4gen;
+  else if (abs(ipart)==7) return spinzerohiggs_anomcoupl_.mb_4gen;
+  else if (abs(ipart)==6) return masses_mcfm_.mt;
+  else if (abs(ipart)==5) return masses_mcfm_.mb;
+  else if (abs(ipart)==4) return masses_mcfm_.mc;
+  else if (abs(ipart)==3) return masses_mcfm_.ms;
+  else if (abs(ipart)==2) return masses_mcfm_.mu;
+  else if (abs(ipart)==1) return masses_mcfm_.md;
+  else if (abs(ipart)==11) return masses_mcfm_.mel;
+  else if (abs(ipart)==13) return masses_mcfm_.mmu;
+  else if (abs(ipart)==15) return masses_mcfm_.mtau;
+  else if (abs(ipart)==23) return masses_mcfm_.zmass;
+  else if (abs(ipart)==24) return masses_mcfm_.wmass;
+  else if (abs(ipart)==25) return masses_mcfm_.hmass;
+  else return 0;
+}
+double TUtil::GetDecayWidth(int ipart){
+  if (abs(ipart)==6) return masses_mcfm_.twidth;
+  else if (abs(ipart)==15) return masses_mcfm_.tauwidth;
+  else if (abs(ipart)==23) return masses_mcfm_.zwidth;
+  else if (abs(ipart)==24) return masses_mcfm_.wwidth;
+  else if (abs(ipart)==25) return masses_mcfm_.hwidth;
+  else return 0;
+}
 void TUtil::SetCKMElements(double* invckm_ud, double* invckm_us, double* invckm_cd, double* invckm_cs, double* invckm_ts, double* invckm_tb, double* invckm_ub, double* invckm_cb, double* invckm_td){
   __modparameters_MOD_computeckmelements(invckm_ud, invckm_us, invckm_cd, invckm_cs, invckm_ts, invckm_tb, invckm_ub, invckm_cb, invckm_td);
 
@@ -1174,6 +1713,23 @@ void TUtil::SetCKMElements(double* invckm_ud, double* invckm_us, double* invckm_
   cabib_.Vcb = __modparameters_MOD_ckmbare(&i, &j);
   // Do not call ckmfill_(), it is called by MCFM_chooser!
 }
+void TUtil::SetDefaultCKMElements(){
+  __modparameters_MOD_setdefaultckm();
+
+  int i, j;
+  i=2; j=1;
+  cabib_.Vud = __modparameters_MOD_ckmbare(&i, &j);
+  i=2; j=3;
+  cabib_.Vus = __modparameters_MOD_ckmbare(&i, &j);
+  i=2; j=5;
+  cabib_.Vub = __modparameters_MOD_ckmbare(&i, &j);
+  i=4; j=1;
+  cabib_.Vcd = __modparameters_MOD_ckmbare(&i, &j);
+  i=4; j=3;
+  cabib_.Vcs = __modparameters_MOD_ckmbare(&i, &j);
+  i=4; j=5;
+  cabib_.Vcb = __modparameters_MOD_ckmbare(&i, &j);
+}
 
 double TUtil::InterpretScaleScheme(const TVar::Production& production, const TVar::MatrixElement& matrixElement, const TVar::EventScaleScheme& scheme, TLorentzVector p[mxpart]){
   double Q=0;
@@ -1343,8 +1899,31 @@ void TUtil::SetAlphaS(double& Q_ren, double& Q_fac, double multiplier_ren, doubl
   double muren_jhu = scale_.scale*GeV;
   double mufac_jhu = facscale_.facscale*GeV;
   __modjhugenmela_MOD_setmurenfac(&muren_jhu, &mufac_jhu);
-  __modkinematics_MOD_evalalphas();
-  TUtil::GetAlphaS(&(qcdcouple_.as), &(couple_.amz));
+  AlphaSCacheEntry* cachedAlphaS=0;
+  if (contextState->pdfCaching){
+    for (unsigned int ic=0; ic<nAlphaSCacheEntries; ic++){
+      if (contextState->alphasCache[ic].isValid && contextState->alphasCache[ic].scale==scale_.scale){ cachedAlphaS = &(contextState->alphasCache[ic]); break; }
+    }
+  }
+  if (cachedAlphaS!=0){
+    contextState->pdfCacheStatistics.nAlphaSHits++;
+    __modjhugenmela_MOD_setalphasalphasmz(&(cachedAlphaS->alphas), &(cachedAlphaS->alphasmz));
+    qcdcouple_.as = cachedAlphaS->alphas;
+    couple_.amz = cachedAlphaS->alphasmz;
+  }
+  else{
+    contextState->pdfCacheStatistics.nAlphaSMisses++;
+    __modkinematics_MOD_evalalphas();
+    TUtil::GetAlphaS(&(qcdcouple_.as), &(couple_.amz));
+    if (contextState->pdfCaching){
+      cachedAlphaS = &(contextState->alphasCache[contextState->alphasCacheNext]);
+      contextState->alphasCacheNext = (contextState->alphasCacheNext+1)%nAlphaSCacheEntries;
+      cachedAlphaS->isValid = true;
+      cachedAlphaS->scale = scale_.scale;
+      cachedAlphaS->alphas = qcdcouple_.as;
+      cachedAlphaS->alphasmz = couple_.amz;
+    }
+  }
 
   qcdcouple_.gsq = 4.0*TMath::Pi()*qcdcouple_.as;
   qcdcouple_.ason2pi = qcdcouple_.as/(2.0*TMath::Pi());
@@ -1364,6 +1943,42 @@ void TUtil::GetAlphaS(double* alphas_, double* alphasmz_){
   if (alphas_!=0) *alphas_ = alphasVal;
   if (alphasmz_!=0) *alphasmz_ = alphasmzVal;
 }
+void TUtil::SetPDFCaching(bool flag){ InvalidatePDFCache(); contextState->pdfCaching=flag; }
+void TUtil::InvalidatePDFCache(){
+  for (unsigned int ic=0; ic<nPDFCacheEntries; ic++) contextState->pdfCache[ic].isValid=false;
+  for (unsigned int ic=0; ic<nAlphaSCacheEntries; ic++) contextState->alphasCache[ic].isValid=false;
+}
+TUtil::PDFCacheStatistics TUtil::GetPDFCacheStatistics(){ return contextState->pdfCacheStatistics; }
+void TUtil::ResetPDFCacheStatistics(){ contextState->pdfCacheStatistics = TUtil::PDFCacheStatistics(); }
+TUtil::TTHPermutationStatistics TUtil::GetTTHPermutationStatistics(){ return contextState->ttHPermutationStatistics; }
+void TUtil::ResetTTHPermutationStatistics(){ contextState->ttHPermutationStatistics = TUtil::TTHPermutationStatistics(); }
+void TUtil::SetHJJChannelCaching(bool flag){ InvalidateHJJChannelCache(); contextState->hjjChannelCaching=flag; }
+void TUtil::SetVHHelicitySumming(bool flag){ contextState->vhHelicitySumming=flag; }
+void TUtil::InvalidateHJJChannelCache(){ contextState->hjjChannelCache.isValid=false; contextState->hjjChannelCache.channels.clear(); }
+TUtil::HJJChannelCacheStatistics TUtil::GetHJJChannelCacheStatistics(){ return contextState->hjjChannelCacheStatistics; }
+void TUtil::ResetHJJChannelCacheStatistics(){ contextState->hjjChannelCacheStatistics = TUtil::HJJChannelCacheStatistics(); }
+void TUtil::SetMCFMConfigCaching(bool flag){ contextState->mcfmConfigCaching=flag; if (!contextState->mcfmConfigCaching) InvalidateMCFMConfigCache(); }
+void TUtil::InvalidateMCFMConfigCache(){ contextState->mcfmConfigCache.clear(); }
+TUtil::MCFMConfigCacheStatistics TUtil::GetMCFMConfigCacheStatistics(){ return contextState->mcfmConfigCacheStatistics; }
+void TUtil::ResetMCFMConfigCacheStatistics(){ contextState->mcfmConfigCacheStatistics = TUtil::MCFMConfigCacheStatistics(); }
+void TUtil::SetCouplingPushTracking(bool flag){ ApplyPendingMCFMCouplings(); contextState->couplingPushTracking=flag; }
+void TUtil::InvalidateCouplingPushes(){ contextState->mcfmCouplingPush.isValid=false; contextState->jhugenCouplingPush.invalidate(); }
+TUtil::CouplingPushStatistics TUtil::GetCouplingPushStatistics(){ return contextState->couplingPushStatistics; }
+void TUtil::ResetCouplingPushStatistics(){ contextState->couplingPushStatistics = TUtil::CouplingPushStatistics(); }
+TUtil::ContextState* TUtil::CreateContextState(){ return new TUtil::ContextState(); }
+void TUtil::DeleteContextState(TUtil::ContextState* state){
+  if (state==0 || state==&defaultContextState) return;
+  if (state==contextState) SetContextState(0);
+  delete state;
+}
+void TUtil::SetContextState(TUtil::ContextState* state){
+  if (state==0) state=&defaultContextState;
+  if (state==contextState) return;
+  ApplyPendingMCFMCouplings();
+  contextState=state;
+  // The couplings in the MCFM and JHUGen modules may have been written while another state was active
+  InvalidateCouplingPushes();
+}
 
 // chooser.f split into 2 different functions
 bool TUtil::MCFM_chooser(
@@ -1404,7 +2019,7 @@ bool TUtil::MCFM_chooser(
     //90 '  f(p1)+f(p2) --> Z^0(-->e^-(p3)+e^+(p4)) + Z^0(-->e^-(p5)+e^+(p6))' 'L'
 
     nqcdjets_.nqcdjets=0;
-    srdiags_.srdiags=true;
+    srdiags_.srdiags=true; mcfmConfigWrites |= kMCFMWrite_srdiags;
     nwz_.nwz=0; ckmfill_(&(nwz_.nwz));
     bveg1_mcfm_.ndim=10;
     breit_.n2=1;
@@ -1412,9 +2027,9 @@ bool TUtil::MCFM_chooser(
     breit_.mass2=masses_mcfm_.zmass;
     breit_.width2=masses_mcfm_.zwidth;
     breit_.mass3=masses_mcfm_.zmass;
-    breit_.width3=masses_mcfm_.zwidth;
+    breit_.width3=masses_mcfm_.zwidth; mcfmConfigWrites |= (kMCFMWrite_breitV2 | kMCFMWrite_breitV3);
 
-    vsymfact_.vsymfact=1.0;
+    vsymfact_.vsymfact=1.0; mcfmConfigWrites |= kMCFMWrite_vsymfact;
     interference_.interference=false;
     if (hasZZ4fInterf && (leptonInterf==TVar::DefaultLeptonInterf || leptonInterf==TVar::InterfOn)){
       //90 '  f(p1)+f(p2) --> Z^0(-->e^-(p3)+e^+(p4)) + Z^0(-->e^-(p5)+e^+(p6))' 'L'
@@ -1440,8 +2055,8 @@ bool TUtil::MCFM_chooser(
     breit_.mass2=masses_mcfm_.wmass;
     breit_.width2=masses_mcfm_.wwidth;
     breit_.mass3=masses_mcfm_.wmass;
-    breit_.width3=masses_mcfm_.wwidth;
-    srdiags_.srdiags=true;
+    breit_.width3=masses_mcfm_.wwidth; mcfmConfigWrites |= (kMCFMWrite_breitV2 | kMCFMWrite_breitV3 | kMCFMWrite_breitW);
+    srdiags_.srdiags=true; mcfmConfigWrites |= kMCFMWrite_srdiags;
 
     if (verbosity>=TVar::DEBUG) cout << "TUtil::MCFM_chooser: Setup is (production, process)=(" << TVar::ProductionName(production) << ", " << TVar::ProcessName(process) << ")" << endl;
 
@@ -1456,7 +2071,7 @@ bool TUtil::MCFM_chooser(
     // -- 44 '  f(p1)+f(p2) --> Z^0(-->e^-(p3)+e^+(p4))+f(p5)+f(p6)'
     // these settings are identical to use the chooser_() function
 
-    flags_.Gflag=true;
+    flags_.Gflag=true; mcfmConfigWrites |= kMCFMWrite_flags;
     flags_.Qflag=true;
     flags_.QandGflag=true; // This is in case NLO is implemented.
     bveg1_mcfm_.ndim=10;
@@ -1465,7 +2080,7 @@ bool TUtil::MCFM_chooser(
     nqcdjets_.nqcdjets=2;
     nwz_.nwz=0; ckmfill_(&(nwz_.nwz));
     breit_.mass3=masses_mcfm_.zmass;
-    breit_.width3=masses_mcfm_.zwidth;
+    breit_.width3=masses_mcfm_.zwidth; mcfmConfigWrites |= kMCFMWrite_breitV3;
 
     if (verbosity>=TVar::DEBUG) cout << "TUtil::MCFM_chooser: Setup is (production, process)=(" << TVar::ProductionName(production) << ", " << TVar::ProcessName(process) << ")" << endl;
 
@@ -1485,7 +2100,7 @@ bool TUtil::MCFM_chooser(
     breit_.n2=0;
     breit_.n3=1;
     breit_.mass3=masses_mcfm_.zmass;
-    breit_.width3=masses_mcfm_.zwidth;
+    breit_.width3=masses_mcfm_.zwidth; mcfmConfigWrites |= kMCFMWrite_breitV3;
     nwz_.nwz=0; ckmfill_(&(nwz_.nwz));
 
     if (verbosity>=TVar::DEBUG) cout << "TUtil::MCFM_chooser: Setup is (production, process)=(" << TVar::ProductionName(production) << ", " << TVar::ProcessName(process) << ")" << endl;
@@ -1515,9 +2130,9 @@ bool TUtil::MCFM_chooser(
     breit_.mass2 =masses_mcfm_.zmass;
     breit_.width2=masses_mcfm_.zwidth;
     breit_.mass3 =masses_mcfm_.zmass;
-    breit_.width3=masses_mcfm_.zwidth;
+    breit_.width3=masses_mcfm_.zwidth; mcfmConfigWrites |= (kMCFMWrite_breitV2 | kMCFMWrite_breitV3);
 
-    vsymfact_.vsymfact=1.0;
+    vsymfact_.vsymfact=1.0; mcfmConfigWrites |= kMCFMWrite_vsymfact;
     interference_.interference=false;
     if (hasZZ4fInterf && (leptonInterf==TVar::DefaultLeptonInterf || leptonInterf==TVar::InterfOn)){
       vsymfact_.vsymfact=0.5;
@@ -1549,7 +2164,7 @@ bool TUtil::MCFM_chooser(
     bveg1_mcfm_.ndim=10;
     breit_.n2=1;
     breit_.n3=1;
-    nuflav_.nuflav=1; // Keep this at 1. Mela controls how many flavors in a more exact way.
+    nuflav_.nuflav=1; mcfmConfigWrites |= kMCFMWrite_nuflav; // Keep this at 1. Mela controls how many flavors in a more exact way.
 
     if (verbosity>=TVar::DEBUG) cout << "TUtil::MCFM_chooser: Setup is (production, process)=(" << TVar::ProductionName(production) << ", " << TVar::ProcessName(process) << ")" << endl;
 
@@ -1586,9 +2201,9 @@ bool TUtil::MCFM_chooser(
     breit_.mass2 =masses_mcfm_.zmass;
     breit_.width2=masses_mcfm_.zwidth;
     breit_.mass3 =masses_mcfm_.zmass;
-    breit_.width3=masses_mcfm_.zwidth;
+    breit_.width3=masses_mcfm_.zwidth; mcfmConfigWrites |= (kMCFMWrite_breitV2 | kMCFMWrite_breitV3);
 
-    vsymfact_.vsymfact=1.0;
+    vsymfact_.vsymfact=1.0; mcfmConfigWrites |= kMCFMWrite_vsymfact;
     interference_.interference=false;
     if (hasZZ4fInterf && (leptonInterf==TVar::DefaultLeptonInterf || leptonInterf==TVar::InterfOn)){
       vsymfact_.vsymfact=0.5;
@@ -1630,7 +2245,7 @@ bool TUtil::MCFM_chooser(
     breit_.mass2 =masses_mcfm_.wmass;
     breit_.width2=masses_mcfm_.wwidth;
     breit_.mass3 =masses_mcfm_.wmass;
-    breit_.width3=masses_mcfm_.wwidth;
+    breit_.width3=masses_mcfm_.wwidth; mcfmConfigWrites |= (kMCFMWrite_breitV2 | kMCFMWrite_breitV3 | kMCFMWrite_breitW);
 
     if (verbosity>=TVar::DEBUG) cout << "TUtil::MCFM_chooser: Setup is (production, process)=(" << TVar::ProductionName(production) << ", " << TVar::ProcessName(process) << ")" << endl;
 
@@ -1667,7 +2282,7 @@ bool TUtil::MCFM_chooser(
     breit_.mass2 =masses_mcfm_.wmass;
     breit_.width2=masses_mcfm_.wwidth;
     breit_.mass3 =masses_mcfm_.wmass;
-    breit_.width3=masses_mcfm_.wwidth;
+    breit_.width3=masses_mcfm_.wwidth; mcfmConfigWrites |= (kMCFMWrite_breitV2 | kMCFMWrite_breitV3 | kMCFMWrite_breitW);
 
     if (verbosity>=TVar::DEBUG) cout << "TUtil::MCFM_chooser: Setup is (production, process)=(" << TVar::ProductionName(production) << ", " << TVar::ProcessName(process) << ")" << endl;
 
@@ -1698,9 +2313,9 @@ bool TUtil::MCFM_chooser(
     breit_.mass2 =masses_mcfm_.zmass;
     breit_.width2=masses_mcfm_.zwidth;
     breit_.mass3 =masses_mcfm_.zmass;
-    breit_.width3=masses_mcfm_.zwidth;
+    breit_.width3=masses_mcfm_.zwidth; mcfmConfigWrites |= (kMCFMWrite_breitV2 | kMCFMWrite_breitV3);
 
-    vsymfact_.vsymfact=1.0;
+    vsymfact_.vsymfact=1.0; mcfmConfigWrites |= kMCFMWrite_vsymfact;
     interference_.interference=false;
     if (hasZZ4fInterf && (leptonInterf==TVar::DefaultLeptonInterf || leptonInterf==TVar::InterfOn)){
       vsymfact_.vsymfact=0.5;
@@ -1736,7 +2351,7 @@ bool TUtil::MCFM_chooser(
     breit_.mass2 =masses_mcfm_.wmass;
     breit_.width2=masses_mcfm_.wwidth;
     breit_.mass3 =masses_mcfm_.wmass;
-    breit_.width3=masses_mcfm_.wwidth;
+    breit_.width3=masses_mcfm_.wwidth; mcfmConfigWrites |= (kMCFMWrite_breitV2 | kMCFMWrite_breitV3 | kMCFMWrite_breitW);
 
     if (verbosity>=TVar::DEBUG) cout << "TUtil::MCFM_chooser: Setup is (production, process)=(" << TVar::ProductionName(production) << ", " << TVar::ProcessName(process) << ")" << endl;
 
@@ -1972,7 +2587,7 @@ bool TUtil::MCFM_SetupParticleCouplings(
       sprintf(runstring_.runstring, strrun.c_str());
     }
     else if (isZG && (production == TVar::ZZQQB || production == TVar::ZZINDEPENDENT) && process == TVar::bkgZGamma){
-      lastphot_.lastphot=5;
+      lastphot_.lastphot=5; mcfmConfigWrites |= kMCFMWrite_lastphot;
       strplabel[4]="ga";
       strplabel[5]="pp";
     }
@@ -2010,7 +2625,7 @@ bool TUtil::MCFM_SetupParticleCouplings(
     // VH productions loop over all possible associated particles to assign V daughters as the first two particles in particle-antiparticle order
     else if ((isWW || isZZ) && napart>=2 && (production==TVar::Lep_ZH || production==TVar::Lep_ZH_S || production==TVar::Lep_ZH_TU)){
       spinzerohiggs_anomcoupl_.channeltoggle_stu = int(production==TVar::Lep_ZH)*2 + int(production==TVar::Lep_ZH_TU)*1 + int(production==TVar::Lep_ZH_S)*0;
-      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 1;
+      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 1; mcfmConfigWrites |= kMCFMWrite_toggles;
       bool hasZll=false;
       bool hasZnn=false;
       for (unsigned int ix=0; ix<napart; ix++){
@@ -2070,7 +2685,7 @@ bool TUtil::MCFM_SetupParticleCouplings(
     }
     else if ((isWW || isZZ) && napart>=2 && (production==TVar::Lep_WH || production==TVar::Lep_WH_S || production==TVar::Lep_WH_TU)){
       spinzerohiggs_anomcoupl_.channeltoggle_stu = int(production==TVar::Lep_WH)*2 + int(production==TVar::Lep_WH_TU)*1 + int(production==TVar::Lep_WH_S)*0;
-      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 1;
+      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 1; mcfmConfigWrites |= kMCFMWrite_toggles;
       bool hasWplus=false;
       bool hasWminus=false;
       for (unsigned int ix=0; ix<napart; ix++){
@@ -2146,7 +2761,7 @@ bool TUtil::MCFM_SetupParticleCouplings(
     }
     else if ((isWW || isZZ) && napart>=2 && (production==TVar::Had_ZH || production==TVar::Had_ZH_S || production==TVar::Had_ZH_TU)){
       spinzerohiggs_anomcoupl_.channeltoggle_stu = int(production==TVar::Had_ZH)*2 + int(production==TVar::Had_ZH_TU)*1 + int(production==TVar::Had_ZH_S)*0;
-      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 1;
+      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 1; mcfmConfigWrites |= kMCFMWrite_toggles;
       bool hasZuu=false;
       bool hasZdd=false;
       bool hasZjj=false;
@@ -2214,7 +2829,7 @@ bool TUtil::MCFM_SetupParticleCouplings(
     }
     else if ((isWW || isZZ) && napart>=2 && (production==TVar::Had_WH || production==TVar::Had_WH_S || production==TVar::Had_WH_TU)){
       spinzerohiggs_anomcoupl_.channeltoggle_stu = int(production==TVar::Had_WH)*2 + int(production==TVar::Had_WH_TU)*1 + int(production==TVar::Had_WH_S)*0;
-      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 1;
+      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 1; mcfmConfigWrites |= kMCFMWrite_toggles;
       bool hasWplus=false;
       bool hasWminus=false;
       bool hasWjj=false;
@@ -2302,7 +2917,7 @@ bool TUtil::MCFM_SetupParticleCouplings(
     }
     else if ((isWW || isZZ) && napart>=2 && (production==TVar::JJQCD || production==TVar::JJQCD_S || production==TVar::JJQCD_TU)){
       spinzerohiggs_anomcoupl_.channeltoggle_stu = int(production==TVar::JJQCD)*2 + int(production==TVar::JJQCD_TU)*1 + int(production==TVar::JJQCD_S)*0;;
-      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 2; // Doesn't matter, already JJQCD
+      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 2; mcfmConfigWrites |= kMCFMWrite_toggles; // Doesn't matter, already JJQCD
       if (useQQVVQQany){
         int qqvvqq_apartordering[2]={ -1, -1 };
         TMCFMUtils::AssociatedParticleOrdering_QQVVQQAny(
@@ -2318,7 +2933,7 @@ bool TUtil::MCFM_SetupParticleCouplings(
     }
     else if ((isWW || isZZ) && napart>=2 && (production==TVar::JJVBF || production==TVar::JJVBF_S || production==TVar::JJVBF_TU)){
       spinzerohiggs_anomcoupl_.channeltoggle_stu = int(production==TVar::JJVBF)*2 + int(production==TVar::JJVBF_TU)*1 + int(production==TVar::JJVBF_S)*0;;
-      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 0; // VBF-only process
+      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 0; mcfmConfigWrites |= kMCFMWrite_toggles; // VBF-only process
       if (useQQVVQQany){
         int qqvvqq_apartordering[2]={ -1, -1 };
         TMCFMUtils::AssociatedParticleOrdering_QQVVQQAny(
@@ -2340,7 +2955,7 @@ bool TUtil::MCFM_SetupParticleCouplings(
     }
     else if ((isWW || isZZ) && napart>=2 && (production==TVar::JJEW || production==TVar::JJEWQCD || production==TVar::JJEW_S || production==TVar::JJEWQCD_S || production==TVar::JJEW_TU || production==TVar::JJEWQCD_TU)){
       spinzerohiggs_anomcoupl_.channeltoggle_stu = int(production==TVar::JJEWQCD || production==TVar::JJEW)*2 + int(production==TVar::JJEWQCD_TU || production==TVar::JJEW_TU)*1 + int(production==TVar::JJEWQCD_S || production==TVar::JJEW_S)*0;;
-      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 2; // VBF+VH process
+      spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh = 2; mcfmConfigWrites |= kMCFMWrite_toggles; // VBF+VH process
       if (useQQVVQQany){
         int qqvvqq_apartordering[2]={ -1, -1 };
         TMCFMUtils::AssociatedParticleOrdering_QQVVQQAny(
@@ -2645,6 +3260,40 @@ bool TUtil::MCFM_SetupParticleCouplings(
   if (pApartId!=0) delete[] pApartId;
   return result;
 }
+bool TUtil::MCFM_SetupProcess(
+  const TVar::Process& process, const TVar::Production& production, const TVar::LeptonInterference& leptonInterf,
+  const TVar::VerbosityLevel& verbosity,
+  const simple_event_record& mela_event,
+  vector<int>* partOrder, vector<int>* apartOrder
+  ){
+  MCFMConfigKey key;
+  if (contextState->mcfmConfigCaching){
+    SetMCFMConfigKey(key, process, production, leptonInterf, mela_event);
+    std::map<MCFMConfigKey, MCFMConfigCacheEntry>::const_iterator it = contextState->mcfmConfigCache.find(key);
+    if (it!=contextState->mcfmConfigCache.end()){
+      ApplyMCFMConfig(it->second, partOrder, apartOrder);
+      contextState->mcfmConfigCacheStatistics.nHits++;
+      if (verbosity>=TVar::DEBUG) cout << "TUtil::MCFM_SetupProcess: Applied the stored configuration with runstring=" << runstring_.runstring << " (" << contextState->mcfmConfigCache.size() << " stored)" << endl;
+      return true;
+    }
+  }
+
+  // Failed configurations are not stored, so that their error messages are repeated.
+  mcfmConfigWrites=0;
+  vector<int> tmpPartOrder, tmpApartOrder;
+  bool result = (
+    TUtil::MCFM_chooser(process, production, leptonInterf, verbosity, mela_event)
+    &&
+    TUtil::MCFM_SetupParticleCouplings(process, production, verbosity, mela_event, &tmpPartOrder, &tmpApartOrder)
+    );
+  if (result && contextState->mcfmConfigCaching){
+    StoreMCFMConfig(contextState->mcfmConfigCache[key], tmpPartOrder, tmpApartOrder);
+    contextState->mcfmConfigCacheStatistics.nMisses++;
+  }
+  if (partOrder!=0) partOrder->insert(partOrder->end(), tmpPartOrder.begin(), tmpPartOrder.end());
+  if (apartOrder!=0) apartOrder->insert(apartOrder->end(), tmpApartOrder.begin(), tmpApartOrder.end());
+  return result;
+}
 TString TUtil::GetMCFMParticleLabel(const int& pid, bool useQJ){
   if (PDGHelpers::isAnUnknownJet(pid)){
     if (useQJ) return TString("qj");
@@ -2726,10 +3375,12 @@ bool TUtil::MCFM_smalls(double s[][mxpart], int npart){
 
 
 void TUtil::InitJHUGenMELA(const char* pathtoPDFSet, int PDFMember){
-  char path_pdf_c[200];
-  sprintf(path_pdf_c, "%s", pathtoPDFSet);
+  char path_pdf_c[500]; // Same length as LHAPDFString in JHUGen
+  snprintf(path_pdf_c, sizeof(path_pdf_c), "%s", pathtoPDFSet);
   int pathpdfLength = strlen(path_pdf_c);
   __modjhugen_MOD_initfirsttime(path_pdf_c, &pathpdfLength, &PDFMember);
+  InvalidatePDFCache();
+  InvalidateCouplingPushes();
 }
 void TUtil::SetJHUGenHiggsMassWidth(double MReso, double GaReso){
   const double GeV = 1./100.;
@@ -2739,9 +3390,38 @@ void TUtil::SetJHUGenHiggsMassWidth(double MReso, double GaReso){
 }
 void TUtil::SetJHUGenDistinguishWWCouplings(bool doAllow){
   int iAllow = (doAllow ? 1 : 0);
-  __modjhugenmela_MOD_setdistinguishwwcouplingsflag(&iAllow);
+  bool isModified = UpdateCouplingRecord(&(contextState->jhugenCouplingPush.distinguishWW), &iAllow, sizeof(iAllow));
+  if (IsJHUGenPushNeeded(contextState->jhugenCouplingPush.hasDistinguishWW, isModified)) __modjhugenmela_MOD_setdistinguishwwcouplingsflag(&iAllow);
 }
 void TUtil::SetMCFMSpinZeroCouplings(bool useBSM, SpinZeroCouplings* Hcouplings, bool forceZZ){
+  contextState->couplingPushStatistics.nMCFMPushes++;
+  MCFMCouplingPushRecord& record = contextState->mcfmCouplingPush;
+  if (!contextState->couplingPushTracking){
+    WriteMCFMSpinZeroCouplings(useBSM, Hcouplings, forceZZ);
+    contextState->couplingPushStatistics.nMCFMWrites++;
+    record.isValid=false;
+    record.defaultPending=false;
+    return;
+  }
+  // The default couplings depend neither on Hcouplings nor on forceZZ, and they are needed only by the next MCFM ME if no other push comes before.
+  if (!useBSM){
+    record.defaultPending = (!record.isValid || record.useBSM);
+    return;
+  }
+  record.defaultPending=false;
+  if (
+    record.isValid && record.useBSM && record.forceZZ==forceZZ
+    &&
+    isSameSpinZeroCouplings(record.Hcouplings, *Hcouplings)
+    ) return;
+  WriteMCFMSpinZeroCouplings(useBSM, Hcouplings, forceZZ);
+  contextState->couplingPushStatistics.nMCFMWrites++;
+  record.isValid=true;
+  record.useBSM=true;
+  record.forceZZ=forceZZ;
+  record.Hcouplings = *Hcouplings;
+}
+void TUtil::WriteMCFMSpinZeroCouplings(bool useBSM, SpinZeroCouplings* Hcouplings, bool forceZZ){
   if (!useBSM){
     spinzerohiggs_anomcoupl_.AllowAnomalousCouplings = 0;
     spinzerohiggs_anomcoupl_.distinguish_HWWcouplings = 0;
@@ -3376,12 +4056,30 @@ void TUtil::SetJHUGenSpinZeroVVCouplings(double Hvvcoupl[SIZE_HVV][2], int Hvvco
   const double GeV = 1./100.;
   int iWWcoupl = (useWWcoupl ? 1 : 0);
   for (int c=0; c<SIZE_HVV_LAMBDAQSQ; c++){ for (int k=0; k<SIZE_HVV_CQSQ; k++) HvvLambda_qsq[c][k] *= GeV; } // GeV units in JHUGen
-  __modjhugenmela_MOD_setspinzerovvcouplings(Hvvcoupl, Hvvcoupl_cqsq, HvvLambda_qsq, &iWWcoupl);
+  bool isModified = UpdateCouplingRecord(contextState->jhugenCouplingPush.Hvvcoupl[iWWcoupl], Hvvcoupl, sizeof(contextState->jhugenCouplingPush.Hvvcoupl[iWWcoupl]));
+  isModified = UpdateCouplingRecord(contextState->jhugenCouplingPush.HvvCLambda_qsq[iWWcoupl], Hvvcoupl_cqsq, sizeof(contextState->jhugenCouplingPush.HvvCLambda_qsq[iWWcoupl])) || isModified;
+  isModified = UpdateCouplingRecord(contextState->jhugenCouplingPush.HvvLambda_qsq[iWWcoupl], HvvLambda_qsq, sizeof(contextState->jhugenCouplingPush.HvvLambda_qsq[iWWcoupl])) || isModified;
+  if (IsJHUGenPushNeeded(contextState->jhugenCouplingPush.hasVV[iWWcoupl], isModified)) __modjhugenmela_MOD_setspinzerovvcouplings(Hvvcoupl, Hvvcoupl_cqsq, HvvLambda_qsq, &iWWcoupl);
+}
+void TUtil::SetJHUGenSpinZeroGGCouplings(double Hggcoupl[SIZE_HGG][2]){
+  bool isModified = UpdateCouplingRecord(contextState->jhugenCouplingPush.Hggcoupl, Hggcoupl, sizeof(contextState->jhugenCouplingPush.Hggcoupl));
+  if (IsJHUGenPushNeeded(contextState->jhugenCouplingPush.hasGG, isModified)) __modjhugenmela_MOD_setspinzeroggcouplings(Hggcoupl);
+}
+void TUtil::SetJHUGenSpinZeroQQCouplings(double Hqqcoupl[SIZE_HQQ][2]){
+  bool isModified = UpdateCouplingRecord(contextState->jhugenCouplingPush.Hqqcoupl, Hqqcoupl, sizeof(contextState->jhugenCouplingPush.Hqqcoupl));
+  if (IsJHUGenPushNeeded(contextState->jhugenCouplingPush.hasQQ, isModified)) __modjhugenmela_MOD_setspinzeroqqcouplings(Hqqcoupl);
+}
+void TUtil::SetJHUGenSpinOneCouplings(double Zqqcoupl[SIZE_ZQQ][2], double Zvvcoupl[SIZE_ZVV][2]){
+  bool isModified = UpdateCouplingRecord(contextState->jhugenCouplingPush.Zqqcoupl, Zqqcoupl, sizeof(contextState->jhugenCouplingPush.Zqqcoupl));
+  isModified = UpdateCouplingRecord(contextState->jhugenCouplingPush.Zvvcoupl, Zvvcoupl, sizeof(contextState->jhugenCouplingPush.Zvvcoupl)) || isModified;
+  if (IsJHUGenPushNeeded(contextState->jhugenCouplingPush.hasSpinOne, isModified)) __modjhugenmela_MOD_setspinonecouplings(Zqqcoupl, Zvvcoupl);
+}
+void TUtil::SetJHUGenSpinTwoCouplings(double Gacoupl[SIZE_GGG][2], double Gbcoupl[SIZE_GVV][2], double qLeftRightcoupl[SIZE_GQQ][2]){
+  bool isModified = UpdateCouplingRecord(contextState->jhugenCouplingPush.Gggcoupl, Gacoupl, sizeof(contextState->jhugenCouplingPush.Gggcoupl));
+  isModified = UpdateCouplingRecord(contextState->jhugenCouplingPush.Gvvcoupl, Gbcoupl, sizeof(contextState->jhugenCouplingPush.Gvvcoupl)) || isModified;
+  isModified = UpdateCouplingRecord(contextState->jhugenCouplingPush.Gqqcoupl, qLeftRightcoupl, sizeof(contextState->jhugenCouplingPush.Gqqcoupl)) || isModified;
+  if (IsJHUGenPushNeeded(contextState->jhugenCouplingPush.hasSpinTwo, isModified)) __modjhugenmela_MOD_setspintwocouplings(Gacoupl, Gbcoupl, qLeftRightcoupl);
 }
-void TUtil::SetJHUGenSpinZeroGGCouplings(double Hggcoupl[SIZE_HGG][2]){ __modjhugenmela_MOD_setspinzeroggcouplings(Hggcoupl); }
-void TUtil::SetJHUGenSpinZeroQQCouplings(double Hqqcoupl[SIZE_HQQ][2]){ __modjhugenmela_MOD_setspinzeroqqcouplings(Hqqcoupl); }
-void TUtil::SetJHUGenSpinOneCouplings(double Zqqcoupl[SIZE_ZQQ][2], double Zvvcoupl[SIZE_ZVV][2]){ __modjhugenmela_MOD_setspinonecouplings(Zqqcoupl, Zvvcoupl); }
-void TUtil::SetJHUGenSpinTwoCouplings(double Gacoupl[SIZE_GGG][2], double Gbcoupl[SIZE_GVV][2], double qLeftRightcoupl[SIZE_GQQ][2]){ __modjhugenmela_MOD_setspintwocouplings(Gacoupl, Gbcoupl, qLeftRightcoupl); }
 
 //Make sure
 // 1. tot Energy Sum < 2EBEAM
@@ -3395,6 +4093,7 @@ double TUtil::SumMatrixElementPDF(
   TVar::VerbosityLevel verbosity
   ){
   if (verbosity>=TVar::DEBUG) cout << "Begin SumMatrixElementPDF" << endl;
+  ApplyPendingMCFMCouplings(); // Reset of the couplings deferred by SetMCFMSpinZeroCouplings
   double msqjk=0;
 
   int nRequested_AssociatedJets=0;
@@ -3454,8 +4153,7 @@ double TUtil::SumMatrixElementPDF(
   bool doProceed =
     CheckPartonMomFraction(mela_event.pMothers.at(0).second, mela_event.pMothers.at(1).second, xx, EBEAM, verbosity) // Check momentum transfers
     &&
-    TUtil::MCFM_chooser(process, production, leptonInterf, verbosity, mela_event); // Set some of the specifics of the process through this function
-  if (doProceed) doProceed = TUtil::MCFM_SetupParticleCouplings(process, production, verbosity, mela_event, &partOrder, &apartOrder); // Set the specifics of the daughter or associated particle couplings through this function
+    TUtil::MCFM_SetupProcess(process, production, leptonInterf, verbosity, mela_event, &partOrder, &apartOrder); // Set the specifics of the process and of the daughter or associated particle couplings, or apply the stored ones
   if (doProceed){
     if (partOrder.size()!=mela_event.pDaughters.size()){
       if (verbosity >= TVar::ERROR){
@@ -3990,7 +4688,7 @@ double TUtil::SumMatrixElementPDF(
         << "\tBefore reset, alphas scale: " << scale_.scale
         << ", PDF scale: " << facscale_.facscale
         << endl;
-    SetAlphaS(defaultRenScale, defaultFacScale, 1., 1., defaultNloop, defaultNflav, defaultPdflabel);
+    if (!IsSharedEventComputation()) SetAlphaS(defaultRenScale, defaultFacScale, 1., 1., defaultNloop, defaultNflav, defaultPdflabel);
     if (verbosity>=TVar::DEBUG) cout
         << "TUtil::SumMatrixElementPDF: Reset AlphaS result:\n"
         << "\tAfter reset, alphas scale: " << scale_.scale
@@ -4357,7 +5055,7 @@ double TUtil::JHUGenMatEl(
       << "TUtil::JHUGenMatEl: Reset AlphaS:\n"
       << "\tBefore reset, alphas scale: " << scale_.scale << ", PDF scale: " << facscale_.facscale << endl;
   }
-  SetAlphaS(defaultRenScale, defaultFacScale, 1., 1., defaultNloop, defaultNflav, defaultPdflabel);
+  if (!IsSharedEventComputation()) SetAlphaS(defaultRenScale, defaultFacScale, 1., 1., defaultNloop, defaultNflav, defaultPdflabel);
   if (verbosity>=TVar::DEBUG){
     GetAlphaS(&alphasVal, &alphasmzVal);
     cout
@@ -4518,6 +5216,8 @@ double TUtil::HJJMatEl(
     int ijsel[3][121];
     int nijchannels=77;
     __modhiggsjj_MOD_get_hjjchannelhash_nosplit(ijsel, &nijchannels);
+    // Channels are evaluated through the per-event cache, which reuses them for any other Hgg couplings
+    BeginHJJChannelCache(p4, MYIDUP_tmp, alphasVal);
     for (int ic=0; ic<nijchannels; ic++){
       // Emulate EvalWeighted_HJJ_test
       int isel = ijsel[0][ic];
@@ -4547,7 +5247,7 @@ double TUtil::HJJMatEl(
               &&
               (partonIsUnknown[3] || (PDGHelpers::isAQuark(MYIDUP_tmp[3]) && MYIDUP_tmp[3]<0))
               ){
-              __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, &msq_tmp);
+              EvalHJJChannel(p4, isel, jsel, rsel, ssel, &msq_tmp);
               MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
               if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
             }
@@ -4556,7 +5256,7 @@ double TUtil::HJJMatEl(
               &&
               (partonIsUnknown[3] || (PDGHelpers::isAQuark(MYIDUP_tmp[3]) && MYIDUP_tmp[3]>0))
               ){
-              __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &ssel, &rsel, &msq_tmp);
+              EvalHJJChannel(p4, isel, jsel, ssel, rsel, &msq_tmp);
               MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
               if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
             }
@@ -4568,7 +5268,7 @@ double TUtil::HJJMatEl(
               &&
               (partonIsUnknown[3] || (PDGHelpers::isAGluon(MYIDUP_tmp[3]) && ssel==0))
               ){
-              __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, &msq_tmp);
+              EvalHJJChannel(p4, isel, jsel, rsel, ssel, &msq_tmp);
               MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
               if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
             }
@@ -4580,7 +5280,7 @@ double TUtil::HJJMatEl(
             &&
             (partonIsUnknown[3] || ((PDGHelpers::isAGluon(MYIDUP_tmp[3]) && ssel==0) || MYIDUP_tmp[3]==ssel))
             ){
-            __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, &msq_tmp);
+            EvalHJJChannel(p4, isel, jsel, rsel, ssel, &msq_tmp);
             MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
             if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
           }
@@ -4589,7 +5289,7 @@ double TUtil::HJJMatEl(
             &&
             (partonIsUnknown[3] || ((PDGHelpers::isAGluon(MYIDUP_tmp[3]) && rsel==0) || MYIDUP_tmp[3]==rsel))
             ){
-            __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &ssel, &rsel, &msq_tmp);
+            EvalHJJChannel(p4, isel, jsel, ssel, rsel, &msq_tmp);
             MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
             if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
           }
@@ -4602,7 +5302,7 @@ double TUtil::HJJMatEl(
               &&
               (partonIsUnknown[3] || PDGHelpers::isAGluon(MYIDUP_tmp[3]))
               ){
-              __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, &msq_tmp);
+              EvalHJJChannel(p4, isel, jsel, rsel, ssel, &msq_tmp);
               MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
               if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
             }
@@ -4616,7 +5316,7 @@ double TUtil::HJJMatEl(
               &&
               (partonIsUnknown[3] || MYIDUP_tmp[3]==ssel)
               ){
-              __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, &msq_tmp);
+              EvalHJJChannel(p4, isel, jsel, rsel, ssel, &msq_tmp);
               MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
               if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
             }
@@ -4625,7 +5325,7 @@ double TUtil::HJJMatEl(
               &&
               (partonIsUnknown[3] || MYIDUP_tmp[3]==rsel)
               ){
-              __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &ssel, &rsel, &msq_tmp);
+              EvalHJJChannel(p4, isel, jsel, ssel, rsel, &msq_tmp);
               MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
               if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
             }
@@ -4636,7 +5336,7 @@ double TUtil::HJJMatEl(
               &&
               (partonIsUnknown[3] || MYIDUP_tmp[3]==ssel)
               ){
-              __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, &msq_tmp);
+              EvalHJJChannel(p4, isel, jsel, rsel, ssel, &msq_tmp);
               MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
               if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
             }
@@ -4645,7 +5345,7 @@ double TUtil::HJJMatEl(
               &&
               (partonIsUnknown[3] || MYIDUP_tmp[3]==rsel)
               ){
-              __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &ssel, &rsel, &msq_tmp);
+              EvalHJJChannel(p4, isel, jsel, ssel, rsel, &msq_tmp);
               MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
               if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
             }
@@ -4657,7 +5357,7 @@ double TUtil::HJJMatEl(
             &&
             (partonIsUnknown[3] || MYIDUP_tmp[3]==ssel)
             ){
-            __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, &msq_tmp);
+            EvalHJJChannel(p4, isel, jsel, rsel, ssel, &msq_tmp);
             MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
             if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
           }
@@ -4668,7 +5368,7 @@ double TUtil::HJJMatEl(
             &&
             (partonIsUnknown[3] || MYIDUP_tmp[3]==rsel)
             ){
-            __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &ssel, &rsel, &msq_tmp);
+            EvalHJJChannel(p4, isel, jsel, ssel, rsel, &msq_tmp);
             MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
             if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
           }
@@ -4696,7 +5396,7 @@ double TUtil::HJJMatEl(
             &&
             (partonIsUnknown[3] || ((PDGHelpers::isAGluon(MYIDUP_tmp[3]) && ssel==0) || MYIDUP_tmp[3]==ssel))
             ){
-            __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, &msq_tmp);
+            EvalHJJChannel(p4, isel, jsel, rsel, ssel, &msq_tmp);
             MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
             if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
           }
@@ -4705,7 +5405,7 @@ double TUtil::HJJMatEl(
             &&
             (partonIsUnknown[3] || ((PDGHelpers::isAGluon(MYIDUP_tmp[3]) && rsel==0) || MYIDUP_tmp[3]==rsel))
             ){
-            __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &ssel, &rsel, &msq_tmp);
+            EvalHJJChannel(p4, isel, jsel, ssel, rsel, &msq_tmp);
             MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
             if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
           }
@@ -4718,7 +5418,7 @@ double TUtil::HJJMatEl(
               &&
               (partonIsUnknown[3] || PDGHelpers::isAGluon(MYIDUP_tmp[3]))
               ){
-              __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, &msq_tmp);
+              EvalHJJChannel(p4, isel, jsel, rsel, ssel, &msq_tmp);
               MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
               if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
             }
@@ -4732,7 +5432,7 @@ double TUtil::HJJMatEl(
               &&
               (partonIsUnknown[3] || MYIDUP_tmp[3]==ssel)
               ){
-              __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, &msq_tmp);
+              EvalHJJChannel(p4, isel, jsel, rsel, ssel, &msq_tmp);
               MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
               if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
             }
@@ -4741,7 +5441,7 @@ double TUtil::HJJMatEl(
               &&
               (partonIsUnknown[3] || MYIDUP_tmp[3]==rsel)
               ){
-              __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &ssel, &rsel, &msq_tmp);
+              EvalHJJChannel(p4, isel, jsel, ssel, rsel, &msq_tmp);
               MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
               if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
             }
@@ -4752,7 +5452,7 @@ double TUtil::HJJMatEl(
               &&
               (partonIsUnknown[3] || MYIDUP_tmp[3]==ssel)
               ){
-              __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, &msq_tmp);
+              EvalHJJChannel(p4, isel, jsel, rsel, ssel, &msq_tmp);
               MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
               if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
             }
@@ -4761,7 +5461,7 @@ double TUtil::HJJMatEl(
               &&
               (partonIsUnknown[3] || MYIDUP_tmp[3]==rsel)
               ){
-              __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &ssel, &rsel, &msq_tmp);
+              EvalHJJChannel(p4, isel, jsel, ssel, rsel, &msq_tmp);
               MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
               if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
             }
@@ -4773,7 +5473,7 @@ double TUtil::HJJMatEl(
             &&
             (partonIsUnknown[3] || MYIDUP_tmp[3]==ssel)
             ){
-            __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &rsel, &ssel, &msq_tmp);
+            EvalHJJChannel(p4, isel, jsel, rsel, ssel, &msq_tmp);
             MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
             if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
           }
@@ -4784,13 +5484,14 @@ double TUtil::HJJMatEl(
             &&
             (partonIsUnknown[3] || MYIDUP_tmp[3]==rsel)
             ){
-            __modhiggsjj_MOD_evalamp_sbfh_unsymm_sa_select_exact(p4, &isel, &jsel, &ssel, &rsel, &msq_tmp);
+            EvalHJJChannel(p4, isel, jsel, ssel, rsel, &msq_tmp);
             MatElsq[jsel+5][isel+5] += msq_tmp; // Assign only those that match gen. info, if present at all.
             if (verbosity >= TVar::DEBUG_VERBOSE) cout << "Channel (isel, jsel, rsel, ssel)=" << isel << ", " << jsel << ", " << rsel << ", " << ssel << '\t' <<  msq_tmp << endl;
           }
         }
       } // End swapped isel<jsel cases
     } // End loop over ic<nijchannels
+    EndHJJChannelCache();
   } // End production==TVar::JJQCD
   else if (production==TVar::JJVBF){
     int isel, jsel, rsel, ssel;
@@ -5803,7 +6504,7 @@ double TUtil::HJJMatEl(
       << "TUtil::HJJMatEl: Reset AlphaS:\n"
       << "\tBefore reset, alphas scale: " << scale_.scale << ", PDF scale: " << facscale_.facscale << endl;
   }
-  SetAlphaS(defaultRenScale, defaultFacScale, 1., 1., defaultNloop, defaultNflav, defaultPdflabel);
+  if (!IsSharedEventComputation()) SetAlphaS(defaultRenScale, defaultFacScale, 1., 1., defaultNloop, defaultNflav, defaultPdflabel);
   if (verbosity>=TVar::DEBUG){
     GetAlphaS(&alphasVal, &alphasmzVal);
     cout
@@ -5878,7 +6579,6 @@ double TUtil::VHiggsMatEl(
   int MYIDUP_prod[4]={ 0 }; // "Incoming" partons 1, 2, "outgoing" partons 3, 4
   int MYIDUP_dec[2]={ -9000, -9000 }; // "Outgoing" partons 1, 2 from the Higgs (->bb)
   double p4[9][4] ={ { 0 } };
-  double helicities[9] ={ 0 };
   int vh_ids[9] ={ 0 };
   TLorentzVector MomStore[mxpart];
   for (int i = 0; i < mxpart; i++) MomStore[i].SetXYZT(0, 0, 0, 0);
@@ -6003,9 +6703,9 @@ double TUtil::VHiggsMatEl(
   if (production!=TVar::GammaH) vh_ids[3] = vh_ids[2]; // To be changed later for WH
   else vh_ids[3] = 22;
 
-  // H->ffb decay is turned off, so no need to loop over helicities[7]=helicities[8]=+-1
-  vh_ids[7] = 5; helicities[7] = 1;
-  vh_ids[8] = -5; helicities[8] = 1;
+  // H->ffb decay is turned off, so these ids are not used
+  vh_ids[7] = 5;
+  vh_ids[8] = -5;
   int HDKon = 0;
   if (includeHiggsDecay && MYIDUP_dec[0]!=-9000 && MYIDUP_dec[1]!=-9000 && MYIDUP_dec[0]==-MYIDUP_dec[1]){ // H->ffb
     HDKon=1;
@@ -6047,7 +6747,6 @@ double TUtil::VHiggsMatEl(
   for (unsigned int ip=0; ip<4; ip++) partonIsKnown[ip] = (MYIDUP_prod[ip]!=0);
   if ((production==TVar::Lep_WH || production==TVar::Lep_ZH || production==TVar::GammaH) && !(partonIsKnown[2] && partonIsKnown[3])){ if (verbosity>=TVar::INFO) cerr << "TUtil::VHiggsMatEl: Final state particles in leptonic/photonic VH have to have a definite id!" << endl; return sum_msqjk; }
 
-  const double allowed_helicities[2] ={ -1, 1 }; // L,R
   // Setup outgoing H decay products (H->f fbar), templated with H->b bar if both fermions are unknown.
   vector<pair<int, int>> Hffparticles;
   double Hffscale=1;
@@ -6075,6 +6774,13 @@ double TUtil::VHiggsMatEl(
     for (unsigned int ihf=0; ihf<Hffparticles.size(); ihf++) cout << "\t - (id8, id9) = (" << Hffparticles.at(ihf).first << ", " << Hffparticles.at(ihf).second << ")" << endl;
     cout << "TUtil::VHiggsMatEl: ME scale for the H-> f fbar particles: " << Hffscale << endl;
   }
+  // (id8, id9) of the templates in the layout of the Fortran helicity sum
+  int nHffparticles = Hffparticles.size();
+  vector<int> Hffids(2*max(nHffparticles, 1), 0);
+  for (int ihf=0; ihf<nHffparticles; ihf++){
+    Hffids.at(2*ihf) = Hffparticles.at(ihf).first;
+    Hffids.at(2*ihf+1) = Hffparticles.at(ihf).second;
+  }
 
   if (production==TVar::Lep_WH || production==TVar::Had_WH){
     // Setup incoming partons
@@ -6204,29 +6910,12 @@ double TUtil::VHiggsMatEl(
 
         // Compute a raw ME
         double msq=0;
+        double msq_hel[2][2]={ { 0 } }; // [h01][h56], summed over the H->f fbar templates and their spins if HDKon
+        EvalVHiggsHelicities(vh_ids, p4, Hffparticles, Hffids, msq_hel);
         for (int h01 = 0; h01 < 2; h01++){
-          helicities[0] = allowed_helicities[h01];
-          helicities[1] = -helicities[0];
           for (int h56 = 0; h56 < 2; h56++){
-            helicities[5] = allowed_helicities[h56];
-            helicities[6] = -helicities[5];
-
-            double msq_inst=0;
-            if (HDKon==0) __modvhiggs_MOD_evalamp_vhiggs(vh_ids, helicities, p4, &msq_inst);
-            else{
-              for (int h78=0; h78<2; h78++){
-                helicities[7]=allowed_helicities[h78];
-                helicities[8]=allowed_helicities[h78];
-                for (unsigned int ihf=0; ihf<Hffparticles.size(); ihf++){
-                  vh_ids[7]=Hffparticles.at(ihf).first;
-                  vh_ids[8]=Hffparticles.at(ihf).second;
-                  double msq_inst_LR=0;
-                  __modvhiggs_MOD_evalamp_vhiggs(vh_ids, helicities, p4, &msq_inst_LR);
-                  msq_inst += msq_inst_LR;
-                } // End loop over template H->f fbar products
-              } // End loop over the spin of H->f fbar line
-              msq_inst *= Hffscale;
-            } // End HDKon!=0
+            double msq_inst=msq_hel[h01][h56];
+            if (HDKon!=0) msq_inst *= Hffscale;
             msq += msq_inst;
           } // End loop over h56
         } // End loop over h01
@@ -6340,29 +7029,12 @@ double TUtil::VHiggsMatEl(
 
         // Compute a raw ME
         double msq=0;
+        double msq_hel[2][2]={ { 0 } }; // [h01][h56], summed over the H->f fbar templates and their spins if HDKon
+        EvalVHiggsHelicities(vh_ids, p4, Hffparticles, Hffids, msq_hel);
         for (int h01 = 0; h01 < 2; h01++){
-          helicities[0] = allowed_helicities[h01];
-          helicities[1] = -helicities[0];
           for (int h56 = 0; h56 < 2; h56++){
-            helicities[5] = allowed_helicities[h56];
-            helicities[6] = -helicities[5];
-
-            double msq_inst=0;
-            if (HDKon==0) __modvhiggs_MOD_evalamp_vhiggs(vh_ids, helicities, p4, &msq_inst);
-            else{
-              for (int h78=0; h78<2; h78++){
-                helicities[7]=allowed_helicities[h78];
-                helicities[8]=allowed_helicities[h78];
-                for (unsigned int ihf=0; ihf<Hffparticles.size(); ihf++){
-                  vh_ids[7]=Hffparticles.at(ihf).first;
-                  vh_ids[8]=Hffparticles.at(ihf).second;
-                  double msq_inst_LR=0;
-                  __modvhiggs_MOD_evalamp_vhiggs(vh_ids, helicities, p4, &msq_inst_LR);
-                  msq_inst += msq_inst_LR;
-                } // End loop over template H->f fbar products
-              } // End loop over the spin of H->f fbar line
-              msq_inst *= Hffscale;
-            } // End HDKon!=0
+            double msq_inst=msq_hel[h01][h56];
+            if (HDKon!=0) msq_inst *= Hffscale;
             msq += msq_inst;
           } // End loop over h56
         } // End loop over h01
@@ -6411,7 +7083,7 @@ double TUtil::VHiggsMatEl(
       << "TUtil::VHiggsMatEl: Reset AlphaS:\n"
       << "\tBefore reset, alphas scale: " << scale_.scale << ", PDF scale: " << facscale_.facscale << endl;
   }
-  SetAlphaS(defaultRenScale, defaultFacScale, 1., 1., defaultNloop, defaultNflav, defaultPdflabel);
+  if (!IsSharedEventComputation()) SetAlphaS(defaultRenScale, defaultFacScale, 1., 1., defaultNloop, defaultNflav, defaultPdflabel);
   if (verbosity>=TVar::DEBUG){
     GetAlphaS(&alphasVal, &alphasmzVal);
     cout
@@ -6655,6 +7327,11 @@ double TUtil::TTHiggsMatEl(
 
   __modjhugenmela_MOD_settopdecays(&topDecay);
   /***** BEGIN TTH ME CALCULATION *****/
+  // Collect the assignments of the top and antitop daughters first,
+  // so that all of them are evaluated with a single initialization of the JHUGen ttH amplitudes.
+  // The assignments are evaluated one after the other since the amplitudes are kept in JHUGen module variables,
+  // and none of them is skipped since there is no inexpensive upper bound on their MEs.
+  vector<TTHAssignment> assignments;
   for (unsigned int ib1=0; ib1<3; ib1++){
     if (topDaughters.size()==1 && ib1!=0) continue;
     else if (topDaughters.size()==3 && !PDGHelpers::isAnUnknownJet(topDaughters.at(0).first) && ib1!=0) continue;
@@ -6703,67 +7380,88 @@ double TUtil::TTHiggsMatEl(
 
               if (b2index==f2index || b2index==fb2index || f2index==fb2index) continue;
 
-              double p4_current[13][4]={ { 0 } };
-              for (unsigned int ix=0; ix<4; ix++){
-                for (unsigned int ip=0; ip<=2; ip++) p4_current[ip][ix] = p4[ip][ix]; // I1, I2, H do not change.
-                p4_current[t_pos][ix] = p4[t_pos][ix]; // t does not change.
-                p4_current[b1index][ix] = p4[b_pos][ix]; // Assign b to different position.
-                p4_current[f1index][ix] = p4[Wpf_pos][ix]; // Assign Wp->f? to different position.
-                p4_current[fb1index][ix] = p4[Wpfb_pos][ix]; // Assign Wp->?fb to different position.
-                p4_current[Wp_pos][ix] = p4_current[Wpf_pos][ix] + p4_current[Wpfb_pos][ix]; // Re-sum W+ momentum.
-
-                p4_current[tb_pos][ix] = p4[tb_pos][ix]; // tb does not change.
-                p4_current[b2index][ix] = p4[bb_pos][ix]; // Assign bb to different position.
-                p4_current[f2index][ix] = p4[Wmf_pos][ix]; // Assign Wm->f? to different position.
-                p4_current[fb2index][ix] = p4[Wmfb_pos][ix]; // Assign Wm->?fb to different position.
-                p4_current[Wm_pos][ix] = p4_current[Wmf_pos][ix] + p4_current[Wmfb_pos][ix]; // Re-sum W- momentum.
-              }
-              if (verbosity>=TVar::DEBUG){
-                cout
-                  << "TUtil::TTHiggsMatEl: Unswapped instance for "
-                  << "b(" << b_pos << ") -> " << b1index << ", "
-                  << "Wpf(" << Wpf_pos << ") -> " << f1index << ", "
-                  << "Wpfb(" << Wpfb_pos << ") -> " << fb1index << ", "
-                  << "bb(" << bb_pos << ") -> " << b2index << ", "
-                  << "Wmf(" << Wmf_pos << ") -> " << f2index << ", "
-                  << "Wmfb(" << Wmfb_pos << ") -> " << fb2index << endl;
-                for (int ii=0; ii<13; ii++){ cout << "p4_instance[" << ii << "] = "; for (int jj=0; jj<4; jj++) cout << p4_current[ii][jj]/GeV << '\t'; cout << endl; }
-                cout << endl;
-              }
-
-              double MatElsq_tmp[nmsq][nmsq]={ { 0 } };
-              double MatElsq_tmp_swap[nmsq][nmsq]={ { 0 } };
-              __modttbhiggs_MOD_evalxsec_pp_ttbh(p4_current, &topProcess, MatElsq_tmp);
-              if (isUnknown[0] && isUnknown[1]){
-                for (unsigned int ix=0; ix<4; ix++){
-                  swap(p4_current[t_pos][ix], p4_current[tb_pos][ix]);
-                  swap(p4_current[b_pos][ix], p4_current[bb_pos][ix]);
-                  swap(p4_current[Wp_pos][ix], p4_current[Wm_pos][ix]);
-                  swap(p4_current[Wpf_pos][ix], p4_current[Wmf_pos][ix]);
-                  swap(p4_current[Wpfb_pos][ix], p4_current[Wmfb_pos][ix]);
-                }
-                __modttbhiggs_MOD_evalxsec_pp_ttbh(p4_current, &topProcess, MatElsq_tmp_swap);
-                for (int ix=0; ix<11; ix++){ for (int iy=0; iy<11; iy++) MatElsq_tmp[iy][ix] = (MatElsq_tmp[iy][ix]+MatElsq_tmp_swap[iy][ix])/2.; }
-              }
-              for (int ix=0; ix<11; ix++){ for (int iy=0; iy<11; iy++) MatElsq[iy][ix] += MatElsq_tmp[iy][ix]; }
-              if (verbosity>=TVar::DEBUG){
-                cout
-                  << "TUtil::TTHiggsMatEl: Swapped instance for "
-                  << "b(" << b_pos << ") -> " << b1index << ", "
-                  << "Wpf(" << Wpf_pos << ") -> " << f1index << ", "
-                  << "Wpfb(" << Wpfb_pos << ") -> " << fb1index << ", "
-                  << "bb(" << bb_pos << ") -> " << b2index << ", "
-                  << "Wmf(" << Wmf_pos << ") -> " << f2index << ", "
-                  << "Wmfb(" << Wmfb_pos << ") -> " << fb2index << endl;
-                for (int ii=0; ii<13; ii++){ cout << "p4_instance[" << ii << "] = "; for (int jj=0; jj<4; jj++) cout << p4_current[ii][jj]/GeV << '\t'; cout << endl; }
-                cout << endl;
-              }
+              TTHAssignment assignment={ b1index, f1index, fb1index, b2index, f2index, fb2index };
+              assignments.push_back(assignment);
             } // End loop over ifb2
           } // End loop over if2
         } // End loop over ib2
       } // End loop over ifb1
     } // End loop over if1
   } // End loop over ib1
+
+  const bool evalSwapped = (isUnknown[0] && isUnknown[1]);
+  const unsigned int nInstancesPerAssignment = (evalSwapped ? 2 : 1);
+  contextState->ttHPermutationStatistics.nEvents++;
+  contextState->ttHPermutationStatistics.nAssignmentsEvaluated += assignments.size();
+
+  int nInstances = assignments.size()*nInstancesPerAssignment;
+  vector<double> p4_instances(max(nInstances, 1)*13*4, 0.);
+  vector<double> MatElsq_instances(max(nInstances, 1)*nmsq*nmsq, 0.);
+  double (*p4_inst)[13][4] = reinterpret_cast<double(*)[13][4]>(&(p4_instances[0]));
+  double (*MatElsq_inst)[nmsq][nmsq] = reinterpret_cast<double(*)[nmsq][nmsq]>(&(MatElsq_instances[0]));
+  for (unsigned int ia=0; ia<assignments.size(); ia++){
+    const TTHAssignment& assignment = assignments.at(ia);
+    double (&p4_current)[13][4] = p4_inst[ia*nInstancesPerAssignment];
+    for (unsigned int ix=0; ix<4; ix++){
+      for (unsigned int ip=0; ip<=2; ip++) p4_current[ip][ix] = p4[ip][ix]; // I1, I2, H do not change.
+      p4_current[t_pos][ix] = p4[t_pos][ix]; // t does not change.
+      p4_current[assignment.b1index][ix] = p4[b_pos][ix]; // Assign b to different position.
+      p4_current[assignment.f1index][ix] = p4[Wpf_pos][ix]; // Assign Wp->f? to different position.
+      p4_current[assignment.fb1index][ix] = p4[Wpfb_pos][ix]; // Assign Wp->?fb to different position.
+      p4_current[Wp_pos][ix] = p4_current[Wpf_pos][ix] + p4_current[Wpfb_pos][ix]; // Re-sum W+ momentum.
+
+      p4_current[tb_pos][ix] = p4[tb_pos][ix]; // tb does not change.
+      p4_current[assignment.b2index][ix] = p4[bb_pos][ix]; // Assign bb to different position.
+      p4_current[assignment.f2index][ix] = p4[Wmf_pos][ix]; // Assign Wm->f? to different position.
+      p4_current[assignment.fb2index][ix] = p4[Wmfb_pos][ix]; // Assign Wm->?fb to different position.
+      p4_current[Wm_pos][ix] = p4_current[Wmf_pos][ix] + p4_current[Wmfb_pos][ix]; // Re-sum W- momentum.
+    }
+    if (verbosity>=TVar::DEBUG){
+      cout
+        << "TUtil::TTHiggsMatEl: Unswapped instance for "
+        << "b(" << b_pos << ") -> " << assignment.b1index << ", "
+        << "Wpf(" << Wpf_pos << ") -> " << assignment.f1index << ", "
+        << "Wpfb(" << Wpfb_pos << ") -> " << assignment.fb1index << ", "
+        << "bb(" << bb_pos << ") -> " << assignment.b2index << ", "
+        << "Wmf(" << Wmf_pos << ") -> " << assignment.f2index << ", "
+        << "Wmfb(" << Wmfb_pos << ") -> " << assignment.fb2index << endl;
+      for (int ii=0; ii<13; ii++){ cout << "p4_instance[" << ii << "] = "; for (int jj=0; jj<4; jj++) cout << p4_current[ii][jj]/GeV << '\t'; cout << endl; }
+      cout << endl;
+    }
+    if (evalSwapped){
+      double (&p4_swapped)[13][4] = p4_inst[ia*nInstancesPerAssignment+1];
+      for (unsigned int ip=0; ip<13; ip++){ for (unsigned int ix=0; ix<4; ix++) p4_swapped[ip][ix] = p4_current[ip][ix]; }
+      for (unsigned int ix=0; ix<4; ix++){
+        swap(p4_swapped[t_pos][ix], p4_swapped[tb_pos][ix]);
+        swap(p4_swapped[b_pos][ix], p4_swapped[bb_pos][ix]);
+        swap(p4_swapped[Wp_pos][ix], p4_swapped[Wm_pos][ix]);
+        swap(p4_swapped[Wpf_pos][ix], p4_swapped[Wmf_pos][ix]);
+        swap(p4_swapped[Wpfb_pos][ix], p4_swapped[Wmfb_pos][ix]);
+      }
+      if (verbosity>=TVar::DEBUG){
+        cout
+          << "TUtil::TTHiggsMatEl: Swapped instance for "
+          << "b(" << b_pos << ") -> " << assignment.b1index << ", "
+          << "Wpf(" << Wpf_pos << ") -> " << assignment.f1index << ", "
+          << "Wpfb(" << Wpfb_pos << ") -> " << assignment.fb1index << ", "
+          << "bb(" << bb_pos << ") -> " << assignment.b2index << ", "
+          << "Wmf(" << Wmf_pos << ") -> " << assignment.f2index << ", "
+          << "Wmfb(" << Wmfb_pos << ") -> " << assignment.fb2index << endl;
+        for (int ii=0; ii<13; ii++){ cout << "p4_instance[" << ii << "] = "; for (int jj=0; jj<4; jj++) cout << p4_swapped[ii][jj]/GeV << '\t'; cout << endl; }
+        cout << endl;
+      }
+    }
+  }
+  if (nInstances>0) __modttbhiggs_MOD_evalxsec_pp_ttbh_multi(&nInstances, p4_inst, &topProcess, MatElsq_inst);
+  // Sum in the same order as the instances were listed
+  for (unsigned int ia=0; ia<assignments.size(); ia++){
+    double (&MatElsq_tmp)[nmsq][nmsq] = MatElsq_inst[ia*nInstancesPerAssignment];
+    if (evalSwapped){
+      double (&MatElsq_tmp_swap)[nmsq][nmsq] = MatElsq_inst[ia*nInstancesPerAssignment+1];
+      for (int ix=0; ix<11; ix++){ for (int iy=0; iy<11; iy++) MatElsq_tmp[iy][ix] = (MatElsq_tmp[iy][ix]+MatElsq_tmp_swap[iy][ix])/2.; }
+    }
+    for (int ix=0; ix<11; ix++){ for (int iy=0; iy<11; iy++) MatElsq[iy][ix] += MatElsq_tmp[iy][ix]; }
+  }
   /***** END TTH ME CALCULATION *****/
   int defaultTopDecay=-1;
   __modjhugenmela_MOD_settopdecays(&defaultTopDecay); // reset top decay
@@ -6787,7 +7485,7 @@ double TUtil::TTHiggsMatEl(
       << "TUtil::TTHiggsMatEl: Reset AlphaS:\n"
       << "\tBefore reset, alphas scale: " << scale_.scale << ", PDF scale: " << facscale_.facscale << endl;
   }
-  SetAlphaS(defaultRenScale, defaultFacScale, 1., 1., defaultNloop, defaultNflav, defaultPdflabel);
+  if (!IsSharedEventComputation()) SetAlphaS(defaultRenScale, defaultFacScale, 1., 1., defaultNloop, defaultNflav, defaultPdflabel);
   if (verbosity>=TVar::DEBUG){
     GetAlphaS(&alphasVal, &alphasmzVal);
     cout
@@ -6954,7 +7652,7 @@ double TUtil::BBHiggsMatEl(
       << "TUtil::BBHiggsMatEl: Reset AlphaS:\n"
       << "\tBefore reset, alphas scale: " << scale_.scale << ", PDF scale: " << facscale_.facscale << endl;
   }
-  SetAlphaS(defaultRenScale, defaultFacScale, 1., 1., defaultNloop, defaultNflav, defaultPdflabel);
+  if (!IsSharedEventComputation()) SetAlphaS(defaultRenScale, defaultFacScale, 1., 1., defaultNloop, defaultNflav, defaultPdflabel);
   if (verbosity>=TVar::DEBUG){
     GetAlphaS(&alphasVal, &alphasmzVal);
     cout
@@ -7124,6 +7822,24 @@ void TUtil::ComputePDF(const TLorentzVector& p0, const TLorentzVector& p1, doubl
   double xx[2]={ 0 };
   bool passPartonErgFrac=CheckPartonMomFraction(p0, p1, xx, EBEAM, verbosity);
   if (passPartonErgFrac){
+    // The same parton momentum fractions and factorization scale recur for every ME computed on the same event
+    for (unsigned int ic=0; ic<(contextState->pdfCaching ? nPDFCacheEntries : 0); ic++){
+      const PDFCacheEntry& entry = contextState->pdfCache[ic];
+      if (entry.isValid && entry.x1==xx[0] && entry.x2==xx[1] && entry.facscale==facscale_.facscale){
+        contextState->pdfCacheStatistics.nPDFHits++;
+        for (int ip=0; ip<nmsq; ip++){
+          fx1[ip]=entry.fx1[ip];
+          fx2[ip]=entry.fx2[ip];
+        }
+        if (verbosity>=TVar::DEBUG){
+          cout << "End TUtil::ComputePDF (cached):"<< endl;
+          for (int ip=-nf; ip<=nf; ip++) cout << "(fx1, fx2)[" << ip << "] = (" << fx1[ip+5] << " , " << fx2[ip+5] << ")" << endl;
+        }
+        return;
+      }
+    }
+    contextState->pdfCacheStatistics.nPDFMisses++;
+
     ///// USE JHUGEN SUBROUTINE (Accomodates LHAPDF) /////
     double fx1x2_jhu[2][13]={ { 0 } };
     if (verbosity>=TVar::DEBUG) cout << "TUtil::ComputePDF: Calling setpdfs"<< endl;
@@ -7138,6 +7854,18 @@ void TUtil::ComputePDF(const TLorentzVector& p0, const TLorentzVector& p1, doubl
       fx1[jp+5]=fx1x2_jhu[0][ip+6];
       fx2[jp+5]=fx1x2_jhu[1][ip+6];
     }
+    if (contextState->pdfCaching){
+      PDFCacheEntry& entry = contextState->pdfCache[contextState->pdfCacheNext];
+      contextState->pdfCacheNext = (contextState->pdfCacheNext+1)%nPDFCacheEntries;
+      entry.isValid = true;
+      entry.x1 = xx[0];
+      entry.x2 = xx[1];
+      entry.facscale = facscale_.facscale;
+      for (int ip=0; ip<nmsq; ip++){
+        entry.fx1[ip]=fx1[ip];
+        entry.fx2[ip]=fx2[ip];
+      }
+    }
     /*
     ///// USE MCFM SUBROUTINE fdist_linux /////
     //Calculate Pdf
@@ -7170,6 +7898,31 @@ double TUtil::SumMEPDF(const TLorentzVector& p0, const TLorentzVector& p1, doubl
 }
 
 
+// Shared-event computation
+void TUtil::BeginSharedEventComputation(){
+  if (sharedEventDepth==0){
+    sharedBoostedEvents.clear();
+    sharedRenScale = scale_.scale;
+    sharedFacScale = facscale_.facscale;
+    sharedNloop = nlooprun_.nlooprun;
+    sharedNflav = nflav_.nflav;
+    sharedPdflabel = pdlabel_.pdlabel;
+  }
+  sharedEventDepth++;
+}
+void TUtil::EndSharedEventComputation(){
+  if (sharedEventDepth==0) return;
+  sharedEventDepth--;
+  if (sharedEventDepth==0){
+    sharedBoostedEvents.clear();
+    // Same as the alpha_s reset at the end of each ME computation
+    SetAlphaS(sharedRenScale, sharedFacScale, 1., 1., sharedNloop, sharedNflav, sharedPdflabel);
+  }
+}
+void TUtil::ResetSharedEventComputation(){ sharedBoostedEvents.clear(); }
+bool TUtil::IsSharedEventComputation(){ return (sharedEventDepth>0); }
+
+
 // Propagator reweighting
 double TUtil::ResonancePropagator(double sqrts, TVar::ResonancePropagatorScheme scheme){
   __modjhugenmela_MOD_resetmubarhgabarh();
@@ -7195,6 +7948,18 @@ void TUtil::GetBoostedParticleVectors(
   TVar::VerbosityLevel verbosity
   ){
   if (verbosity>=TVar::DEBUG) cout << "Begin GetBoostedParticles" << endl;
+  vector<double> sharedKinematics;
+  if (sharedEventDepth>0){
+    getSharedEventKinematics(melaCand, sharedKinematics);
+    for (unsigned int ie=0; ie<sharedBoostedEvents.size(); ie++){
+      const SharedBoostedEvent& shared = sharedBoostedEvents.at(ie);
+      if (shared.cand==melaCand && isSameBoostRequest(shared.record, mela_event) && shared.kinematics==sharedKinematics){
+        mela_event = shared.record;
+        if (verbosity>=TVar::DEBUG) cout << "End GetBoostedParticles with the shared result" << endl;
+        return;
+      }
+    }
+  }
   // This is the beginning of one long function.
 
   int code = mela_event.AssociationCode;
@@ -7642,6 +8407,14 @@ void TUtil::GetBoostedParticleVectors(
   mela_event.pAntitopDaughters.clear();
   for (unsigned int ip=0; ip<antitopDaughters.size(); ip++) mela_event.pAntitopDaughters.push_back(antitopDaughters.at(ip));
 
+  if (sharedEventDepth>0){
+    SharedBoostedEvent shared;
+    shared.cand = melaCand;
+    shared.kinematics.swap(sharedKinematics);
+    shared.record = mela_event;
+    sharedBoostedEvents.push_back(shared);
+  }
+
   // This is the end of one long function.
   if (verbosity>=TVar::DEBUG){
     cout << "TUtil::GetBoostedParticles mela_event.intermediateVid.size=" << mela_event.intermediateVid.size() << endl;
@@ -7666,7 +8439,8 @@ MELACandidate* TUtil::ConvertVectorFormat(
   bool isGen,
   // Outputs
   std::vector<MELAParticle*>* particleList,
-  std::vector<MELACandidate*>* candList
+  std::vector<MELACandidate*>* candList,
+  MELAEventArena* arena
   ){
   MELACandidate* cand=0;
 
@@ -7675,31 +8449,15 @@ MELACandidate* TUtil::ConvertVectorFormat(
   else if (pDaughters->size()>4){ cerr << "TUtil::ConvertVectorFormat: Daughter size " << pDaughters->size() << ">4 is not supported!" << endl; return cand; }
   if (pMothers!=0 && pMothers->size()!=2){ cerr << "TUtil::ConvertVectorFormat: Mothers momentum size (" << pMothers->size() << ") has to have had been 2! Continuing by omitting mothers." << endl; /*return cand;*/ }
 
-  // Create mother, daughter and associated particle MELAParticle objects
-  std::vector<MELAParticle*> daughters;
-  std::vector<MELAParticle*> aparticles;
-  std::vector<MELAParticle*> mothers;
-  for (unsigned int ip=0; ip<pDaughters->size(); ip++){
-    MELAParticle* onePart = new MELAParticle((pDaughters->at(ip)).first, (pDaughters->at(ip)).second);
+  // Create the daughter MELAParticle objects. Mothers and associated particles are created after the candidate.
+  // No temporary containers are used so that nothing is allocated when the objects come from an arena.
+  const unsigned int nDaughters = pDaughters->size();
+  MELAParticle* daughters[4]={ 0 };
+  for (unsigned int ip=0; ip<nDaughters; ip++){
+    MELAParticle* onePart = (arena!=0 ? arena->newParticle((pDaughters->at(ip)).first, (pDaughters->at(ip)).second) : new MELAParticle((pDaughters->at(ip)).first, (pDaughters->at(ip)).second));
     onePart->setGenStatus(1); // Final state status
     if (particleList!=0) particleList->push_back(onePart);
-    daughters.push_back(onePart);
-  }
-  if (pAssociated!=0){
-    for (unsigned int ip=0; ip<pAssociated->size(); ip++){
-      MELAParticle* onePart = new MELAParticle((pAssociated->at(ip)).first, (pAssociated->at(ip)).second);
-      onePart->setGenStatus(1); // Final state status
-      if (particleList!=0) particleList->push_back(onePart);
-      aparticles.push_back(onePart);
-    }
-  }
-  if (pMothers!=0 && pMothers->size()==2){
-    for (unsigned int ip=0; ip<pMothers->size(); ip++){
-      MELAParticle* onePart = new MELAParticle((pMothers->at(ip)).first, (pMothers->at(ip)).second);
-      onePart->setGenStatus(-1); // Mother status
-      if (particleList!=0) particleList->push_back(onePart);
-      mothers.push_back(onePart);
-    }
+    daughters[ip] = onePart;
   }
 
   // Create the candidate
@@ -7711,13 +8469,13 @@ MELACandidate* TUtil::ConvertVectorFormat(
   */
 
   // Undecayed Higgs
-  if (daughters.size()==1) cand = new MELACandidate(25, (daughters.at(0))->p4); // No sorting!
+  if (nDaughters==1) cand = (arena!=0 ? arena->newCandidate(25, daughters[0]->p4) : new MELACandidate(25, daughters[0]->p4)); // No sorting!
   // GG / ff final states
-  else if (daughters.size()==2){
-    MELAParticle* F1 = daughters.at(0);
-    MELAParticle* F2 = daughters.at(1);
+  else if (nDaughters==2){
+    MELAParticle* F1 = daughters[0];
+    MELAParticle* F2 = daughters[1];
     TLorentzVector pH = F1->p4+F2->p4;
-    cand = new MELACandidate(25, pH);
+    cand = (arena!=0 ? arena->newCandidate(25, pH) : new MELACandidate(25, pH));
     cand->addDaughter(F1);
     cand->addDaughter(F2);
     TVar::CandidateDecayMode defaultHDecayMode = PDGHelpers::HDecayMode;
@@ -7727,10 +8485,10 @@ MELACandidate* TUtil::ConvertVectorFormat(
     PDGHelpers::setCandidateDecayMode(defaultHDecayMode);
   }
   // ZG / WG
-  else if (daughters.size()==3){
-    MELAParticle* F1 = daughters.at(0);
-    MELAParticle* F2 = daughters.at(1);
-    MELAParticle* gamma = daughters.at(2);
+  else if (nDaughters==3){
+    MELAParticle* F1 = daughters[0];
+    MELAParticle* F2 = daughters[1];
+    MELAParticle* gamma = daughters[2];
     if (PDGHelpers::isAPhoton(F1->id)){
       MELAParticle* tmp = F1;
       F1 = gamma;
@@ -7743,7 +8501,7 @@ MELACandidate* TUtil::ConvertVectorFormat(
     }
     TLorentzVector pH = F1->p4+F2->p4+gamma->p4;
     double charge = F1->charge()+F2->charge()+gamma->charge();
-    cand = new MELACandidate(25, pH);
+    cand = (arena!=0 ? arena->newCandidate(25, pH) : new MELACandidate(25, pH));
     cand->addDaughter(F1);
     cand->addDaughter(F2);
     cand->addDaughter(gamma);
@@ -7757,9 +8515,9 @@ MELACandidate* TUtil::ConvertVectorFormat(
   else/* if (daughters.size()==4)*/{
     TLorentzVector pH(0, 0, 0, 0);
     double charge = 0.;
-    for (int ip=0; ip<4; ip++){ pH = pH + (daughters.at(ip))->p4; charge += (daughters.at(ip))->charge(); }
-    cand = new MELACandidate(25, pH);
-    for (int ip=0; ip<4; ip++) cand->addDaughter(daughters.at(ip));
+    for (int ip=0; ip<4; ip++){ pH = pH + daughters[ip]->p4; charge += daughters[ip]->charge(); }
+    cand = (arena!=0 ? arena->newCandidate(25, pH) : new MELACandidate(25, pH));
+    for (int ip=0; ip<4; ip++) cand->addDaughter(daughters[ip]);
     // FIXME/REIMPLEMENT: ZW trickier than I thought: Summing over charges over all 4f is not enough, affects SSSF pairing in ZZ
     //TVar::CandidateDecayMode defaultHDecayMode = PDGHelpers::HDecayMode;
     //if (fabs(charge)>0.01) PDGHelpers::setCandidateDecayMode(TVar::CandidateDecay_ZW);
@@ -7768,18 +8526,26 @@ MELACandidate* TUtil::ConvertVectorFormat(
   }
 
   /***** Adaptation of LHEAnalyzer::Event::addVVCandidateMother *****/
-  if (mothers.size()>0){ // ==2
-    for (unsigned int ip=0; ip<mothers.size(); ip++) cand->addMother(mothers.at(ip));
+  if (pMothers!=0 && pMothers->size()==2){
+    for (unsigned int ip=0; ip<pMothers->size(); ip++){
+      MELAParticle* onePart = (arena!=0 ? arena->newParticle((pMothers->at(ip)).first, (pMothers->at(ip)).second) : new MELAParticle((pMothers->at(ip)).first, (pMothers->at(ip)).second));
+      onePart->setGenStatus(-1); // Mother status
+      if (particleList!=0) particleList->push_back(onePart);
+      cand->addMother(onePart);
+    }
     if (isGen) cand->setGenStatus(-1); // Candidate is a gen. particle!
   }
   /***** Adaptation of LHEAnalyzer::Event::addVVCandidateAppendages *****/
-  if (aparticles.size()>0){
-    for (unsigned int ip=0; ip<aparticles.size(); ip++){
-      const int partId = (aparticles.at(ip))->id;
-      if (PDGHelpers::isALepton(partId)) cand->addAssociatedLeptons(aparticles.at(ip));
-      else if (PDGHelpers::isANeutrino(partId)) cand->addAssociatedNeutrinos(aparticles.at(ip)); // Be careful: Neutrinos are neutrinos, but also "leptons" in MELACandidate!
-      else if (PDGHelpers::isAPhoton(partId)) cand->addAssociatedPhotons(aparticles.at(ip));
-      else if (PDGHelpers::isAJet(partId)) cand->addAssociatedJets(aparticles.at(ip));
+  if (pAssociated!=0 && pAssociated->size()>0){
+    for (unsigned int ip=0; ip<pAssociated->size(); ip++){
+      MELAParticle* onePart = (arena!=0 ? arena->newParticle((pAssociated->at(ip)).first, (pAssociated->at(ip)).second) : new MELAParticle((pAssociated->at(ip)).first, (pAssociated->at(ip)).second));
+      onePart->setGenStatus(1); // Final state status
+      if (particleList!=0) particleList->push_back(onePart);
+      const int partId = onePart->id;
+      if (PDGHelpers::isALepton(partId)) cand->addAssociatedLeptons(onePart);
+      else if (PDGHelpers::isANeutrino(partId)) cand->addAssociatedNeutrinos(onePart); // Be careful: Neutrinos are neutrinos, but also "leptons" in MELACandidate!
+      else if (PDGHelpers::isAPhoton(partId)) cand->addAssociatedPhotons(onePart);
+      else if (PDGHelpers::isAJet(partId)) cand->addAssociatedJets(onePart);
     }
     cand->addAssociatedVs(); // For the VH topology
   }
@@ -7788,6 +8554,31 @@ MELACandidate* TUtil::ConvertVectorFormat(
   return cand;
 }
 
+// Update the daughter momenta of a candidate made by ConvertVectorFormat without creating any new objects
+void TUtil::UpdateCandidateDaughterMomenta(
+  MELACandidate* cand,
+  std::vector<MELAParticle*>& daughters,
+  const std::vector<TLorentzVector>& pDaughters
+  ){
+  if (cand==0 || daughters.size()!=pDaughters.size() || daughters.empty()){ cerr << "TUtil::UpdateCandidateDaughterMomenta: Invalid candidate or momenta!" << endl; return; }
+  for (unsigned int ip=0; ip<daughters.size(); ip++) daughters.at(ip)->p4.SetXYZT(pDaughters.at(ip).X(), pDaughters.at(ip).Y(), pDaughters.at(ip).Z(), pDaughters.at(ip).T());
+
+  // Same sums as in ConvertVectorFormat, with the (reordered) daughters of the candidate
+  TLorentzVector pH;
+  const int nDaughters = cand->getNDaughters();
+  if (nDaughters==0) pH = daughters.at(0)->p4;
+  else if (nDaughters<4){
+    pH = cand->getDaughter(0)->p4;
+    for (int ip=1; ip<nDaughters; ip++) pH = pH + cand->getDaughter(ip)->p4;
+  }
+  else{
+    pH.SetXYZT(0, 0, 0, 0);
+    for (int ip=0; ip<4; ip++) pH = pH + cand->getDaughter(ip)->p4;
+  }
+  cand->p4.SetXYZT(pH.X(), pH.Y(), pH.Z(), pH.T());
+  if (nDaughters>0) cand->resortDaughters();
+}
+
 // Convert the vector of top daughters (as simple particles) to MELAParticles and create a MELATopCandidate
 // The output lists could be members of TEvtProb directly.
 MELATopCandidate* TUtil::ConvertTopCandidate(
@@ -7795,7 +8586,8 @@ MELATopCandidate* TUtil::ConvertTopCandidate(
   SimpleParticleCollection_t* TopDaughters,
   // Outputs
   std::vector<MELAParticle*>* particleList,
-  std::vector<MELATopCandidate*>* topCandList
+  std::vector<MELATopCandidate*>* topCandList,
+  MELAEventArena* arena
   ){
   MELATopCandidate* cand=0;
 
@@ -7805,14 +8597,14 @@ MELATopCandidate* TUtil::ConvertTopCandidate(
 
   if (TopDaughters->size()==1){
     if (abs((TopDaughters->at(0)).first)==6 || (TopDaughters->at(0)).first==0){
-      cand = new MELATopCandidate((TopDaughters->at(0)).first, (TopDaughters->at(0)).second);
+      cand = (arena!=0 ? arena->newTopCandidate((TopDaughters->at(0)).first, (TopDaughters->at(0)).second) : new MELATopCandidate((TopDaughters->at(0)).first, (TopDaughters->at(0)).second));
       topCandList->push_back(cand);
     }
   }
   else if (TopDaughters->size()==3){
-    MELAParticle* bottom = new MELAParticle((TopDaughters->at(0)).first, (TopDaughters->at(0)).second);
-    MELAParticle* Wf = new MELAParticle((TopDaughters->at(1)).first, (TopDaughters->at(1)).second);
-    MELAParticle* Wfb = new MELAParticle((TopDaughters->at(2)).first, (TopDaughters->at(2)).second);
+    MELAParticle* bottom = (arena!=0 ? arena->newParticle((TopDaughters->at(0)).first, (TopDaughters->at(0)).second) : new MELAParticle((TopDaughters->at(0)).first, (TopDaughters->at(0)).second));
+    MELAParticle* Wf = (arena!=0 ? arena->newParticle((TopDaughters->at(1)).first, (TopDaughters->at(1)).second) : new MELAParticle((TopDaughters->at(1)).first, (TopDaughters->at(1)).second));
+    MELAParticle* Wfb = (arena!=0 ? arena->newParticle((TopDaughters->at(2)).first, (TopDaughters->at(2)).second) : new MELAParticle((TopDaughters->at(2)).first, (TopDaughters->at(2)).second));
 
     if (Wf->id<0 || Wfb->id>0){
       MELAParticle* parttmp = Wf;
@@ -7824,7 +8616,7 @@ MELATopCandidate* TUtil::ConvertTopCandidate(
     particleList->push_back(Wf);
     particleList->push_back(Wfb);
 
-    cand = new MELATopCandidate(bottom, Wf, Wfb);
+    cand = (arena!=0 ? arena->newTopCandidate(bottom, Wf, Wfb) : new MELATopCandidate(bottom, Wf, Wfb));
     topCandList->push_back(cand);
   }
   return cand;
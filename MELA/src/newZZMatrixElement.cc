@@ -116,6 +116,7 @@ void newZZMatrixElement::set_RenFacScaleMode(TVar::EventScaleScheme renormalizat
   Xcal2.SetRenFacScaleMode(renormalizationSch, factorizationSch, ren_sf, fac_sf);
 }
 void newZZMatrixElement::set_CandidateDecayMode(TVar::CandidateDecayMode mode){ Xcal2.SetCandidateDecayMode(mode); }
+void newZZMatrixElement::set_MCFMForceBSMHiggs(bool flag){ Xcal2.SetMCFMForceBSMHiggs(flag); }
 void newZZMatrixElement::set_PrimaryHiggsMass(double mh){ Xcal2.SetPrimaryHiggsMass(mh); }
 void newZZMatrixElement::set_CurrentCandidateFromIndex(unsigned int icand){ Xcal2.SetCurrentCandidateFromIndex(icand); }
 void newZZMatrixElement::set_CurrentCandidate(MELACandidate* cand){ Xcal2.SetCurrentCandidate(cand); }
@@ -139,12 +140,14 @@ void newZZMatrixElement::set_TempCandidate(
   SimpleParticleCollection_t* pMothers,
   bool isGen
   ){
+  MelaContext::Lock contextLock(get_Context());
   MELACandidate* cand = ConvertVectorFormat(
     pDaughters,
     pAssociated,
     pMothers,
     isGen,
-    &tmpPartList, &tmpCandList // push_back is done automatically
+    &tmpPartList, &tmpCandList, // push_back is done automatically
+    &tmpArena
     );
   if (cand!=0){
     melaCand=cand;
@@ -177,8 +180,11 @@ void newZZMatrixElement::reset_QuarkMasses(){ Xcal2.ResetQuarkMasses(); }
 void newZZMatrixElement::reset_MCFM_EWKParameters(double ext_Gf, double ext_aemmz, double ext_mW, double ext_mZ, double ext_xW, int ext_ewscheme){
   Xcal2.ResetMCFM_EWKParameters(ext_Gf, ext_aemmz, ext_mW, ext_mZ, ext_xW, ext_ewscheme);
 }
+void newZZMatrixElement::reset_CKMElements(double invckm_ud, double invckm_us, double invckm_cd, double invckm_cs, double invckm_ts, double invckm_tb, double invckm_ub, double invckm_cb, double invckm_td){
+  Xcal2.ResetCKMElements(invckm_ud, invckm_us, invckm_cd, invckm_cs, invckm_ts, invckm_tb, invckm_ub, invckm_cb, invckm_td);
+}
 //
-// resetPerEvent resets the mass, width and lepton interference settings and deletes the temporary input objects newZZMatrixElement owns.
+// resetPerEvent resets the mass, width and lepton interference settings and releases the temporary input objects newZZMatrixElement owns.
 void newZZMatrixElement::resetPerEvent(){
   // Protection against forgetfulness; custom width has to be set per-computation
   set_mHiggs(Xcal2.GetPrimaryHiggsMass(), 0); // Sets mHiggs[0]
@@ -192,10 +198,10 @@ void newZZMatrixElement::resetPerEvent(){
   // Return back to default lepton interference settings after each calculation
   if (processLeptonInterference!=TVar::DefaultLeptonInterf) set_LeptonInterference(TVar::DefaultLeptonInterf);
 
-  // Delete the temporary input objects owned
-  for (unsigned int ic=0; ic<tmpCandList.size(); ic++){ if (tmpCandList.at(ic)!=0) delete tmpCandList.at(ic); }
-  //for (unsigned int itc=0; itc<tmpTopCandList.size(); itc++){ if (tmpTopCandList.at(itc)!=0) delete tmpTopCandList.at(itc); }
-  for (unsigned int ip=0; ip<tmpPartList.size(); ip++){ if (tmpPartList.at(ip)!=0) delete tmpPartList.at(ip); }
+  // Release the temporary input objects owned
+  tmpCandList.clear();
+  tmpPartList.clear();
+  tmpArena.rewind();
   melaCand=0;
 }
 // Resets all candidates in Xcal2, to be called at the end of each event after all computations are done
@@ -207,6 +213,11 @@ MELACandidate* newZZMatrixElement::get_CurrentCandidate(){ return Xcal2.GetCurre
 int newZZMatrixElement::get_CurrentCandidateIndex(){ return Xcal2.GetCurrentCandidateIndex(); }
 int newZZMatrixElement::get_NCandidates(){ return Xcal2.GetNCandidates(); }
 vector<MELATopCandidate*>* newZZMatrixElement::get_TopCandidateCollection(){ return Xcal2.GetTopCandidates(); }
+MelaContext* newZZMatrixElement::get_Context(){ return Xcal2.GetContext(); }
+const MELAEventArena* newZZMatrixElement::get_EventArena(){ return Xcal2.GetEventArena(); }
+double newZZMatrixElement::get_mHiggs(int index) const{ return ((index<nSupportedHiggses && index>=0) ? mHiggs[index] : -1.); }
+double newZZMatrixElement::get_wHiggs(int index) const{ return ((index<nSupportedHiggses && index>=0) ? wHiggs[index] : -1.); }
+TVar::LeptonInterference newZZMatrixElement::get_LeptonInterference() const{ return processLeptonInterference; }
 
 
 // LEFT HERE
@@ -288,6 +299,47 @@ void newZZMatrixElement::computeXS(
   return;
 }
 
+// Batched version of computeXS over a list of events, which do not need to be set as input events
+void newZZMatrixElement::computeXS_Batch(
+  std::vector<SimpleParticleCollection_t>& daughtersList,
+  std::vector<float>& mevalueList,
+  std::vector<SimpleParticleCollection_t>* associatedList,
+  std::vector<SimpleParticleCollection_t>* mothersList,
+  bool isGen
+  ){
+  if (processME==TVar::MCFM){
+    for (int jh=0; jh<(int)nSupportedHiggses; jh++) Xcal2.SetHiggsMass(mHiggs[jh], wHiggs[jh], jh+1);
+  }
+
+  vector<double> dXsecList;
+  Xcal2.XsecCalc_XVV_Batch(
+    daughtersList, dXsecList,
+    wHiggs[0],
+    associatedList, mothersList, isGen
+    );
+  mevalueList.assign(dXsecList.begin(), dXsecList.end());
+
+  resetPerEvent();
+  return;
+}
+
+// computeXS at all points of an angular integration, evaluated on the scratch candidate of the integrator
+void newZZMatrixElement::computeXS_AngularGrid(
+  MelaAngularIntegrator& integrator,
+  std::vector<float>& mevalueList
+  ){
+  if (processME==TVar::MCFM){
+    for (int jh=0; jh<(int)nSupportedHiggses; jh++) Xcal2.SetHiggsMass(mHiggs[jh], wHiggs[jh], jh+1);
+  }
+
+  vector<double> dXsecList;
+  Xcal2.XsecCalc_XVV_AngularGrid(integrator, dXsecList, wHiggs[0]);
+  mevalueList.assign(dXsecList.begin(), dXsecList.end());
+
+  resetPerEvent();
+  return;
+}
+
 // VBF+VH dedicated function (production(+)decay)
 void newZZMatrixElement::computeProdXS_VVHVV(
   float& mevalue
@@ -321,6 +373,18 @@ void newZZMatrixElement::computeProdXS_JJH(
   resetPerEvent();
   return;
 }
+// computeProdXS_JJH at all points of the integration over the pseudorapidity of jet, stored in the integrator
+void newZZMatrixElement::computeProdXS_JJH_JetEtaIntegration(
+  MelaJetEtaIntegrator& integrator,
+  MELAParticle* jet
+  ){
+  melaCand = get_CurrentCandidate();
+
+  if (melaCand!=0 && jet!=0) Xcal2.XsecCalcXJJ_JetEtaIntegration(integrator, jet);
+
+  resetPerEvent();
+  return;
+}
 
 // Higgs + 1 jet: Only SM is supported for now.
 void newZZMatrixElement::computeProdXS_JH(
@@ -0,0 +1,101 @@
+// Timing of the JHUGen MEs per hypothesis.
+// Run once with each build of libjhugenmela.so (make Optimized=No/Yes in MELA/fortran) to compare the timings, e.g.
+// root -l -b -q loadMELA.C benchmarkME_JHUGen.c+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Mela.h"
+#include "TLorentzVector.h"
+#include "TStopwatch.h"
+
+
+using namespace std;
+
+
+namespace{
+  struct benchmarkHypothesis{
+    string name;
+    TVar::Process proc;
+    TVar::Production prod;
+  };
+}
+
+
+void benchmarkME_JHUGen(int nLoops=1000){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+
+  const double l_array[4][4] ={
+    { 51.374202, 25.924766, 12.290178, 42.616376 },
+    { 271.875752, 70.427173, -11.138146, 261.769598 },
+    { 75.823478, -16.640412, 23.246999, 70.227220 },
+    { 21.481452, 9.489680, -9.336587, 16.858699 }
+  };
+  const double a_array[2][4] ={
+    { 101.52463181523598, 27.359569630718468, -0.90299073100241323, -97.764458892691749 },
+    { 180.10885677707822, -6.7240759244122792, 35.742176497019194, -176.39865053838915 }
+  };
+  const int idOrdered[4] ={ 13, -13, 11, -11 };
+
+  TLorentzVector pDaughters[4];
+  SimpleParticleCollection_t daughters;
+  for (unsigned int idau=0; idau<4; idau++){
+    pDaughters[idau].SetXYZT(l_array[idau][1], l_array[idau][2], l_array[idau][3], l_array[idau][0]);
+    daughters.push_back(SimpleParticle_t(idOrdered[idau], pDaughters[idau]));
+  }
+  TLorentzVector pJets[2];
+  SimpleParticleCollection_t associated;
+  for (unsigned int iap=0; iap<2; iap++){
+    pJets[iap].SetXYZT(a_array[iap][1], a_array[iap][2], a_array[iap][3], a_array[iap][0]);
+    associated.push_back(SimpleParticle_t(0, pJets[iap]));
+  }
+
+  mela.setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+  mela.setInputEvent(&daughters, &associated, (SimpleParticleCollection_t*)0, false);
+  // Top candidates for ttH, assembled from the same particles
+  for (unsigned int it=0; it<2; it++){
+    SimpleParticleCollection_t topDaughters;
+    topDaughters.push_back(SimpleParticle_t(0, pJets[it]));
+    for (unsigned int idau=2*it; idau<2*it+2; idau++) topDaughters.push_back(SimpleParticle_t(0, pDaughters[idau]));
+    mela.appendTopCandidate(&topDaughters);
+  }
+
+  vector<benchmarkHypothesis> hypotheses;
+  {
+    benchmarkHypothesis hypo;
+    hypo.name="Decay 0+m (mod_Higgs)"; hypo.proc=TVar::HSMHiggs; hypo.prod=TVar::ZZGG; hypotheses.push_back(hypo);
+    hypo.name="Decay 0- (mod_Higgs)"; hypo.proc=TVar::H0minus; hypo.prod=TVar::ZZGG; hypotheses.push_back(hypo);
+    hypo.name="Decay 2+m (mod_Graviton)"; hypo.proc=TVar::H2_g1g5; hypo.prod=TVar::ZZGG; hypotheses.push_back(hypo);
+    hypo.name="Decay 1+ (mod_Zprime)"; hypo.proc=TVar::H1plus; hypo.prod=TVar::ZZQQB; hypotheses.push_back(hypo);
+    hypo.name="VBF 0+m (mod_HiggsJJ)"; hypo.proc=TVar::HSMHiggs; hypo.prod=TVar::JJVBF; hypotheses.push_back(hypo);
+    hypo.name="JJQCD 0+m (mod_HiggsJJ)"; hypo.proc=TVar::HSMHiggs; hypo.prod=TVar::JJQCD; hypotheses.push_back(hypo);
+    hypo.name="Hadronic ZH 0+m (mod_VHiggs)"; hypo.proc=TVar::HSMHiggs; hypo.prod=TVar::Had_ZH; hypotheses.push_back(hypo);
+    hypo.name="Hadronic WH 0+m (mod_VHiggs)"; hypo.proc=TVar::HSMHiggs; hypo.prod=TVar::Had_WH; hypotheses.push_back(hypo);
+    hypo.name="ttH 0+m (mod_TTBHiggs)"; hypo.proc=TVar::HSMHiggs; hypo.prod=TVar::ttH; hypotheses.push_back(hypo);
+  }
+
+  cout << "benchmarkME_JHUGen: Timing per call averaged over " << nLoops << " calls" << endl;
+  for (unsigned int ih=0; ih<hypotheses.size(); ih++){
+    const benchmarkHypothesis& hypo = hypotheses.at(ih);
+    mela.setProcess(hypo.proc, TVar::JHUGen, hypo.prod);
+
+    float prob=0;
+    TStopwatch timer;
+    timer.Start();
+    for (int iloop=0; iloop<nLoops; iloop++){
+      if (hypo.prod==TVar::ZZGG || hypo.prod==TVar::ZZQQB) mela.computeP(prob, false);
+      else if (hypo.prod==TVar::JJVBF || hypo.prod==TVar::JJQCD) mela.computeProdP(prob, false);
+      else if (hypo.prod==TVar::Had_ZH || hypo.prod==TVar::Had_WH) mela.computeProdP_VH(prob, false, false);
+      else if (hypo.prod==TVar::ttH) mela.computeProdP_ttH(prob, 2, 0, false);
+    }
+    timer.Stop();
+    cout << "\t" << hypo.name << ": "
+      << timer.CpuTime()/nLoops*1e6 << " us CPU, "
+      << timer.RealTime()/nLoops*1e6 << " us real "
+      << "(P = " << prob << ")" << endl;
+  }
+
+  mela.resetInputEvent();
+}
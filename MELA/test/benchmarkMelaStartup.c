@@ -0,0 +1,96 @@
+// Timing of the Mela construction and of the first computations, which build the analytical models, SuperMELA and the ME constants on first use.
+// Run from an empty directory to check that no MCFM input is linked into the working directory (only the ffwarn.dat link is expected), e.g.
+// root -l -b -q loadMELA.C benchmarkMelaStartup.c+
+#include <iostream>
+#include <string>
+#include "Mela.h"
+#include "TLorentzVector.h"
+#include "TStopwatch.h"
+#include "TSystem.h"
+
+
+using namespace std;
+
+
+namespace{
+  const unsigned int nCwdFiles=7;
+  const char* cwdFiles[nCwdFiles]={
+    "br.sm1", "br.sm2", "input.DAT", "process.DAT",
+    "Pdfdata/cteq6l1.tbl", "Pdfdata/cteq6l.tbl", "Pdfdata/NNPDF30_lo_as_0130.LHgrid"
+  };
+
+  void printTime(const string& step, TStopwatch& timer){
+    cout << "benchmarkMelaStartup: " << step << ": " << timer.CpuTime()*1e3 << " ms CPU, " << timer.RealTime()*1e3 << " ms real" << endl;
+  }
+}
+
+
+void benchmarkMelaStartup(){
+  bool existedBefore[nCwdFiles];
+  for (unsigned int ifile=0; ifile<nCwdFiles; ifile++) existedBefore[ifile] = !gSystem->AccessPathName(cwdFiles[ifile]); // AccessPathName returns false if the file exists
+
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  TStopwatch timer;
+
+  timer.Start();
+  Mela* mela = new Mela(erg_tev, mPOLE, verbosity);
+  timer.Stop();
+  printTime("First Mela construction", timer);
+
+  timer.Start();
+  Mela* melaSecond = new Mela(erg_tev, mPOLE, verbosity);
+  timer.Stop();
+  printTime("Second Mela construction", timer);
+  delete melaSecond;
+
+  const double l_array[4][4] ={
+    { 51.374202, 25.924766, 12.290178, 42.616376 },
+    { 271.875752, 70.427173, -11.138146, 261.769598 },
+    { 75.823478, -16.640412, 23.246999, 70.227220 },
+    { 21.481452, 9.489680, -9.336587, 16.858699 }
+  };
+  const int idOrdered[4] ={ 13, -13, 11, -11 };
+  SimpleParticleCollection_t daughters;
+  for (unsigned int idau=0; idau<4; idau++){
+    TLorentzVector pDau;
+    pDau.SetXYZT(l_array[idau][1], l_array[idau][2], l_array[idau][3], l_array[idau][0]);
+    daughters.push_back(SimpleParticle_t(idOrdered[idau], pDau));
+  }
+  mela->setInputEvent(&daughters, (SimpleParticleCollection_t*)0, (SimpleParticleCollection_t*)0, false);
+
+  float prob=0;
+  for (int irep=0; irep<2; irep++){
+    string rep = (irep==0 ? " (first call)" : " (second call)");
+
+    timer.Start();
+    mela->setProcess(TVar::HSMHiggs, TVar::JHUGen, TVar::ZZGG);
+    mela->computeP(prob, true);
+    timer.Stop();
+    printTime("JHUGen computeP with the ME constant"+rep, timer);
+
+    timer.Start();
+    mela->setProcess(TVar::HSMHiggs, TVar::ANALYTICAL, TVar::ZZGG);
+    mela->computeP(prob, false);
+    timer.Stop();
+    printTime("Analytical computeP"+rep, timer);
+
+    timer.Start();
+    mela->setProcess(TVar::HSMHiggs, TVar::JHUGen, TVar::ZZGG);
+    mela->computePM4l(TVar::SMSyst_None, prob);
+    timer.Stop();
+    printTime("computePM4l"+rep, timer);
+  }
+  mela->resetInputEvent();
+  delete mela;
+
+  unsigned int nCreated=0;
+  for (unsigned int ifile=0; ifile<nCwdFiles; ifile++){
+    if (!existedBefore[ifile] && !gSystem->AccessPathName(cwdFiles[ifile])){
+      cout << "benchmarkMelaStartup: " << cwdFiles[ifile] << " was created in the working directory!" << endl;
+      nCreated++;
+    }
+  }
+  if (nCreated==0) cout << "benchmarkMelaStartup: No MCFM input was created in the working directory." << endl;
+}
@@ -0,0 +1,106 @@
+// Timing of Mela::computePM4l on a stream of events with mixed 4mu/4e/2e2mu flavors.
+// The same events are processed once ordered by flavor and once shuffled, and the probabilities have to agree event by event.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C benchmarkSuperMELA.c+
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "Mela.h"
+#include "TLorentzVector.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+
+using namespace std;
+
+
+namespace{
+  const double l_array[4][4] ={
+    { 51.374202, 25.924766, 12.290178, 42.616376 },
+    { 271.875752, 70.427173, -11.138146, 261.769598 },
+    { 75.823478, -16.640412, 23.246999, 70.227220 },
+    { 21.481452, 9.489680, -9.336587, 16.858699 }
+  };
+  const int idOrdered[3][4] ={
+    { 13, -13, 13, -13 },
+    { 11, -11, 11, -11 },
+    { 13, -13, 11, -11 }
+  };
+  const char* flavorName[3] ={ "4mu", "4e", "2e2mu" };
+
+  // Events are (flavor, scale factor of the momenta), the scale factor sets m4l
+  void computeStream(Mela& mela, const vector< pair<int, double> >& events, vector<float>& probs, double& cputime, double& realtime){
+    probs.assign(2*events.size(), 0);
+    TStopwatch timer;
+    timer.Reset();
+    for (unsigned int ev=0; ev<events.size(); ev++){
+      SimpleParticleCollection_t daughters;
+      for (unsigned int idau=0; idau<4; idau++){
+        TLorentzVector pDau;
+        pDau.SetXYZT(l_array[idau][1], l_array[idau][2], l_array[idau][3], l_array[idau][0]);
+        pDau *= events.at(ev).second;
+        daughters.push_back(SimpleParticle_t(idOrdered[events.at(ev).first][idau], pDau));
+      }
+      mela.setInputEvent(&daughters, (SimpleParticleCollection_t*)0, (SimpleParticleCollection_t*)0, false);
+
+      timer.Start(false);
+      mela.setProcess(TVar::HSMHiggs, TVar::JHUGen, TVar::ZZGG);
+      mela.computePM4l(TVar::SMSyst_None, probs.at(2*ev));
+      mela.setProcess(TVar::bkgZZ, TVar::MCFM, TVar::ZZQQB);
+      mela.computePM4l(TVar::SMSyst_None, probs.at(2*ev+1));
+      timer.Stop();
+
+      mela.resetInputEvent();
+    }
+    cputime = timer.CpuTime();
+    realtime = timer.RealTime();
+  }
+}
+
+
+void benchmarkSuperMELA(unsigned int nEvents=3000, unsigned int seed=12345){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+
+  TRandom3 rand(seed);
+  vector< pair<int, double> > orderedEvents;
+  for (int flavor=0; flavor<3; flavor++){
+    for (unsigned int ev=0; ev<nEvents/3; ev++) orderedEvents.push_back(pair<int, double>(flavor, rand.Uniform(0.9, 1.1)));
+  }
+  vector<unsigned int> order;
+  for (unsigned int ev=0; ev<orderedEvents.size(); ev++) order.push_back(ev);
+  for (unsigned int ev=order.size(); ev>1; ev--) swap(order.at(ev-1), order.at(rand.Integer(ev)));
+  vector< pair<int, double> > shuffledEvents;
+  for (unsigned int ev=0; ev<order.size(); ev++) shuffledEvents.push_back(orderedEvents.at(order.at(ev)));
+
+  // Warm-up so that the channel shapes are built before either measurement
+  vector<float> probs;
+  double cputime=0, realtime=0;
+  for (int flavor=0; flavor<3; flavor++) computeStream(mela, vector< pair<int, double> >(1, pair<int, double>(flavor, 1.)), probs, cputime, realtime);
+
+  vector<float> orderedProbs, shuffledProbs;
+  computeStream(mela, orderedEvents, orderedProbs, cputime, realtime);
+  cout << "benchmarkSuperMELA: Events ordered by flavor: "
+    << cputime/orderedEvents.size()*1e6 << " us CPU, "
+    << realtime/orderedEvents.size()*1e6 << " us real per event" << endl;
+  computeStream(mela, shuffledEvents, shuffledProbs, cputime, realtime);
+  cout << "benchmarkSuperMELA: Events with shuffled flavors: "
+    << cputime/shuffledEvents.size()*1e6 << " us CPU, "
+    << realtime/shuffledEvents.size()*1e6 << " us real per event" << endl;
+
+  unsigned int nFailed=0;
+  for (unsigned int ev=0; ev<order.size(); ev++){
+    for (unsigned int ip=0; ip<2; ip++){
+      float pOrdered = orderedProbs.at(2*order.at(ev)+ip);
+      float pShuffled = shuffledProbs.at(2*ev+ip);
+      if (pOrdered!=pShuffled){
+        cout << "benchmarkSuperMELA: " << (ip==0 ? "Signal" : "Background") << " probability of " << flavorName[shuffledEvents.at(ev).first] << " event " << order.at(ev)
+          << " is " << pShuffled << " in the shuffled stream instead of " << pOrdered << endl;
+        nFailed++;
+      }
+    }
+  }
+  if (nFailed==0) cout << "benchmarkSuperMELA: The probabilities in both streams agree." << endl;
+  else cout << "benchmarkSuperMELA: " << nFailed << " mismatches found!" << endl;
+}
@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+
+# Compares the .out files produced by the testME_v2.c ping functions against test/reference/*.ref.
+# Numbers are compared with a relative tolerance, all other tokens have to match exactly (except pointer addresses and file paths).
+# The default tolerance, 1e-5, corresponds to the 6 significant digits printed in the outputs,
+# and is the tolerance to which the optimized build of libjhugenmela.so (make Optimized=Yes) is validated.
+#
+# Usage: python compareRefOutputs.py [directory with .out files] [relative tolerance]
+
+import os
+import sys
+import glob
+
+
+def isEnvironmentDependent(token):
+    return token.startswith("0x") or ("/" in token)
+
+
+def toNumber(token):
+    try:
+        return float(token)
+    except ValueError:
+        return None
+
+
+def compareFiles(outname, refname, tolerance):
+    with open(outname) as outfile:
+        outlines = outfile.read().splitlines()
+    with open(refname) as reffile:
+        reflines = reffile.read().splitlines()
+    if len(outlines) != len(reflines):
+        return ["number of lines differ: {} vs {}".format(len(outlines), len(reflines))]
+
+    mismatches = []
+    for iline, (outline, refline) in enumerate(zip(outlines, reflines)):
+        outtokens = outline.replace("(", " ").replace(")", " ").replace(",", " ").split()
+        reftokens = refline.replace("(", " ").replace(")", " ").replace(",", " ").split()
+        if len(outtokens) != len(reftokens):
+            mismatches.append("line {}: {} | {}".format(iline+1, outline, refline))
+            continue
+        for outtoken, reftoken in zip(outtokens, reftokens):
+            if isEnvironmentDependent(outtoken) and isEnvironmentDependent(reftoken):
+                continue
+            outnumber = toNumber(outtoken)
+            refnumber = toNumber(reftoken)
+            if outnumber is None or refnumber is None:
+                matches = (outtoken == reftoken)
+            elif max(abs(outnumber), abs(refnumber)) < 1e-300:
+                matches = True # Denormals are printed from uninitialized values in some of the outputs
+            else:
+                matches = (abs(outnumber-refnumber) <= tolerance*max(abs(outnumber), abs(refnumber)))
+            if not matches:
+                mismatches.append("line {}: {} | {}".format(iline+1, outline, refline))
+                break
+    return mismatches
+
+
+def main():
+    outdir = (sys.argv[1] if len(sys.argv)>1 else ".")
+    tolerance = (float(sys.argv[2]) if len(sys.argv)>2 else 1e-5)
+    refdir = os.path.join(os.path.dirname(os.path.abspath(__file__)), "reference")
+
+    nCompared = 0
+    nFailed = 0
+    for refname in sorted(glob.glob(os.path.join(refdir, "*.ref"))):
+        outname = os.path.join(outdir, os.path.basename(refname)[:-len(".ref")] + ".out")
+        if not os.path.isfile(outname):
+            continue
+        nCompared += 1
+        mismatches = compareFiles(outname, refname, tolerance)
+        if mismatches:
+            nFailed += 1
+            print("{} differs from the reference:".format(outname))
+            for mismatch in mismatches:
+                print("    " + mismatch)
+
+    print("Compared {} files with relative tolerance {}, {} failed.".format(nCompared, tolerance, nFailed))
+    return (1 if nFailed>0 or nCompared==0 else 0)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,35 @@
+// Converts the pAvgSmooth_*.root files into the binary format read by MelaPConstant through a memory map.
+// Mela uses data/<name>.mpc instead of data/<name>.root once the binary file exists.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C convertPConstants.c+
+#include <iostream>
+#include "MelaPConstant.h"
+#include "TString.h"
+#include "TSystem.h"
+
+
+using namespace std;
+
+
+void convertPConstants(TString datadir="../data/"){
+  if (!datadir.EndsWith("/")) datadir.Append("/");
+  void* dir = gSystem->OpenDirectory(datadir);
+  if (dir==0){ cout << "convertPConstants: Cannot open directory " << datadir << endl; return; }
+
+  unsigned int nConverted=0, nFailed=0;
+  const char* entry;
+  while ((entry = gSystem->GetDirEntry(dir))){
+    TString fname = entry;
+    if (!fname.BeginsWith("pAvgSmooth_") || !fname.EndsWith(".root")) continue;
+    TString binname = fname; binname.Replace(binname.Length()-5, 5, ".mpc");
+    if (MelaPConstant::ConvertFile(datadir+fname, datadir+binname)){
+      cout << "convertPConstants: " << fname << " -> " << binname << endl;
+      nConverted++;
+    }
+    else{
+      cout << "convertPConstants: Failed to convert " << fname << endl;
+      nFailed++;
+    }
+  }
+  gSystem->FreeDirectory(dir);
+  cout << "convertPConstants: Converted " << nConverted << " files, " << nFailed << " failed." << endl;
+}
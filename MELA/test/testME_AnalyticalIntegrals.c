@@ -0,0 +1,79 @@
+// Regression test of the cached ZZINDEPENDENT analytical projections (Mela::setCacheAnalyticalIntegrals) against projections rebuilt per event.
+// All MEs except the interference term have to be positive, and the cached ones have to agree with the rebuilt ones within the given tolerance.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_AnalyticalIntegrals.c+
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+namespace{
+  struct analyticalHypothesis{
+    string name;
+    TVar::Process proc;
+  };
+
+  // Computes all hypotheses event by event, so that the cached projections see the observables and couplings change between calls
+  void computeAll(Mela& mela, const vector<analyticalHypothesis>& hypotheses, vector<float>& result){
+    result.assign(nLeptonOrders*hypotheses.size(), 0);
+    for (unsigned int ev=0; ev<nLeptonOrders; ev++){
+      SimpleParticleCollection_t daughters = getReorderedLeptons(ids_2e2mu, ev);
+      mela.setInputEvent(&daughters, (SimpleParticleCollection_t*)0, (SimpleParticleCollection_t*)0, false);
+      for (unsigned int ih=0; ih<hypotheses.size(); ih++){
+        mela.setProcess(hypotheses.at(ih).proc, TVar::ANALYTICAL, TVar::ZZINDEPENDENT);
+        mela.computeP(result.at(ev*hypotheses.size()+ih), false);
+      }
+      mela.resetInputEvent();
+    }
+  }
+}
+
+
+int testME_AnalyticalIntegrals(float tolerance=1e-6){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+  TestStatus status("testME_AnalyticalIntegrals");
+
+  vector<analyticalHypothesis> hypotheses;
+  {
+    analyticalHypothesis hypo;
+    hypo.name="0+m"; hypo.proc=TVar::HSMHiggs; hypotheses.push_back(hypo);
+    hypo.name="0-"; hypo.proc=TVar::H0minus; hypotheses.push_back(hypo);
+    hypo.name="0+h"; hypo.proc=TVar::H0hplus; hypotheses.push_back(hypo);
+    hypo.name="0+L1"; hypo.proc=TVar::H0_g1prime2; hypotheses.push_back(hypo);
+    hypo.name="g1-g4 interference"; hypo.proc=TVar::D_g1g4; hypotheses.push_back(hypo);
+    hypo.name="1-"; hypo.proc=TVar::H1minus; hypotheses.push_back(hypo);
+    hypo.name="1+"; hypo.proc=TVar::H1plus; hypotheses.push_back(hypo);
+    hypo.name="2+m"; hypo.proc=TVar::H2_g1g5; hypotheses.push_back(hypo);
+    hypo.name="2+h2"; hypo.proc=TVar::H2_g2; hypotheses.push_back(hypo);
+    hypo.name="2-h"; hypo.proc=TVar::H2_g8; hypotheses.push_back(hypo);
+    hypo.name="qqZZ"; hypo.proc=TVar::bkgZZ; hypotheses.push_back(hypo);
+  }
+
+  vector<float> cached, uncached;
+  mela.setCacheAnalyticalIntegrals(true);
+  computeAll(mela, hypotheses, cached);
+  mela.setCacheAnalyticalIntegrals(false);
+  computeAll(mela, hypotheses, uncached);
+  mela.setCacheAnalyticalIntegrals(true);
+
+  for (unsigned int ev=0; ev<nLeptonOrders; ev++){
+    for (unsigned int ih=0; ih<hypotheses.size(); ih++){
+      float pCached = cached.at(ev*hypotheses.size()+ih);
+      float pUncached = uncached.at(ev*hypotheses.size()+ih);
+      TString what = Form("%s of event %u", hypotheses.at(ih).name.c_str(), ev);
+      // The interference term can have either sign
+      if (hypotheses.at(ih).proc==TVar::D_g1g4) status.check(pUncached!=0.f, Form("%s: ME with the rebuilt projection is 0", what.Data()));
+      else status.check(pUncached>0.f, Form("%s: ME with the rebuilt projection is %g", what.Data(), pUncached));
+      status.checkClose(pCached, pUncached, tolerance, what.Data());
+    }
+  }
+  return status.finish();
+}
@@ -0,0 +1,109 @@
+// Accuracy and timing of the (cos theta*, Phi1) integration rules of MCFM ZZINDEPENDENT backgrounds (Mela::setAngularIntegration).
+// Each rule is compared to a fine Clenshaw-Curtis reference, and the difference is compared to the error estimate reported for the rule.
+// All MEs have to be positive with finite, non-negative error estimates, and the error estimate of the reference has to be below the given relative tolerance.
+// How well the coarser rules agree with the reference is only reported.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_AngularIntegration.c+
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "TStopwatch.h"
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+namespace{
+  const int nFlavors = 2;
+  const int* const idOrdered[nFlavors] ={ ids_2e2mu, ids_4mu };
+
+  struct angularRule{
+    string name;
+    TVar::AngularIntegrationRule rule;
+    unsigned int nCosThetaStar;
+    unsigned int nPhi1;
+  };
+
+  void computeAll(Mela& mela, const angularRule& rule, vector<float>& result, vector<float>& error, double& cputime){
+    mela.setAngularIntegration(rule.rule, rule.nCosThetaStar, rule.nPhi1);
+    result.clear();
+    error.clear();
+    TStopwatch timer;
+    for (int fl=0; fl<nFlavors; fl++){
+      for (unsigned int ev=0; ev<nLeptonOrders; ev++){
+        SimpleParticleCollection_t daughters = getReorderedLeptons(idOrdered[fl], ev);
+        mela.setInputEvent(&daughters, (SimpleParticleCollection_t*)0, (SimpleParticleCollection_t*)0, false);
+        float prob=0;
+        mela.setProcess(TVar::bkgZZ, TVar::MCFM, TVar::ZZINDEPENDENT);
+        mela.computeP(prob, false);
+        result.push_back(prob);
+        error.push_back(mela.getAngularIntegrationError());
+        mela.resetInputEvent();
+      }
+    }
+    timer.Stop();
+    cputime = timer.CpuTime()/double(nFlavors*nLeptonOrders);
+  }
+
+  void checkAll(TestStatus& status, const angularRule& rule, const vector<float>& result, const vector<float>& error){
+    for (unsigned int ev=0; ev<result.size(); ev++){
+      status.check(result.at(ev)>0.f, Form("%s, event %u: ME is %g", rule.name.c_str(), ev, result.at(ev)));
+      status.check(error.at(ev)>=0.f && std::isfinite(error.at(ev)), Form("%s, event %u: Error estimate is %g", rule.name.c_str(), ev, error.at(ev)));
+    }
+  }
+}
+
+
+int testME_AngularIntegration(double tolerance=1e-2){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+  TestStatus status("testME_AngularIntegration");
+
+  vector<angularRule> rules;
+  {
+    angularRule rule;
+    rule.name="Legacy 6x6"; rule.rule=TVar::AngularIntegration_LegacyGrid; rule.nCosThetaStar=6; rule.nPhi1=6; rules.push_back(rule);
+    rule.name="Clenshaw-Curtis 3x3"; rule.rule=TVar::AngularIntegration_ClenshawCurtis; rule.nCosThetaStar=3; rule.nPhi1=3; rules.push_back(rule);
+    rule.name="Clenshaw-Curtis 5x5"; rule.rule=TVar::AngularIntegration_ClenshawCurtis; rule.nCosThetaStar=5; rule.nPhi1=5; rules.push_back(rule);
+    rule.name="Clenshaw-Curtis 7x5"; rule.rule=TVar::AngularIntegration_ClenshawCurtis; rule.nCosThetaStar=7; rule.nPhi1=5; rules.push_back(rule);
+  }
+  angularRule reference;
+  reference.name="Clenshaw-Curtis 17x17"; reference.rule=TVar::AngularIntegration_ClenshawCurtis; reference.nCosThetaStar=17; reference.nPhi1=17;
+
+  vector<float> refResult, refError;
+  double refTime=0;
+  computeAll(mela, reference, refResult, refError, refTime);
+  cout << "testME_AngularIntegration: Reference " << reference.name << " takes " << refTime*1e3 << " ms per event" << endl;
+  checkAll(status, reference, refResult, refError);
+  for (unsigned int ev=0; ev<refResult.size(); ev++) status.check(
+    refError.at(ev)<=tolerance*refResult.at(ev),
+    Form("%s, event %u: Error estimate %g is above %g of the ME %g", reference.name.c_str(), ev, refError.at(ev), tolerance, refResult.at(ev))
+  );
+
+  for (unsigned int ir=0; ir<rules.size(); ir++){
+    vector<float> result, error;
+    double cputime=0;
+    computeAll(mela, rules.at(ir), result, error, cputime);
+    checkAll(status, rules.at(ir), result, error);
+    double maxRelDiff=0, maxRelError=0;
+    unsigned int nCovered=0;
+    for (unsigned int ev=0; ev<result.size(); ev++){
+      double diff = fabs(result.at(ev)-refResult.at(ev));
+      double relDiff = diff/max(fabs(double(refResult.at(ev))), 1e-300);
+      double relError = error.at(ev)/max(fabs(double(refResult.at(ev))), 1e-300);
+      if (relDiff>maxRelDiff) maxRelDiff=relDiff;
+      if (relError>maxRelError) maxRelError=relError;
+      if (diff<=error.at(ev)+refError.at(ev)) nCovered++;
+    }
+    cout << "testME_AngularIntegration: " << rules.at(ir).name << endl;
+    cout << "\tTime per event: " << cputime*1e3 << " ms" << endl;
+    cout << "\tMaximum relative difference to the reference: " << maxRelDiff << endl;
+    cout << "\tMaximum relative error estimate: " << maxRelError << endl;
+    cout << "\tDifferences covered by the error estimate: " << nCovered << "/" << result.size() << endl;
+  }
+  return status.finish();
+}
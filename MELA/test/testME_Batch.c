@@ -0,0 +1,58 @@
+// Consistency of Mela::computeP_batch with an event-by-event computeP loop, on the fast path (JHUGen/MCFM decay MEs without constants)
+// and on the generic path (MCFM ZZINDEPENDENT, useConstant=true), with a non-default Higgs mass and width and the lepton interference off.
+// The Higgs mass, width and lepton interference are reset after each computation, so the loop sets them per event.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_Batch.c+
+#include <iostream>
+#include <vector>
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+int testME_Batch(unsigned int nEvents=20){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+  mela.setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+  TestStatus status("testME_Batch");
+
+  vector<SimpleParticleCollection_t> daughtersList;
+  TRandom3 rand(12345);
+  for (unsigned int ev=0; ev<nEvents; ev++) daughtersList.push_back(getLeptons(ids_4e, &rand)); // 4e, so that the lepton interference setting matters
+
+  vector<TestHypothesis> hypotheses;
+  hypotheses.push_back(TestHypothesis("Fast path, JHUGen 0+m", TVar::HSMHiggs, TVar::JHUGen, TVar::ZZGG));
+  hypotheses.push_back(TestHypothesis("Fast path, MCFM gg->H->ZZ", TVar::HSMHiggs, TVar::MCFM, TVar::ZZGG));
+  hypotheses.push_back(TestHypothesis("Generic path, MCFM ZZINDEPENDENT qq->ZZ", TVar::bkgZZ, TVar::MCFM, TVar::ZZINDEPENDENT));
+  hypotheses.push_back(TestHypothesis("Generic path, MCFM gg->H->ZZ with constant", TVar::HSMHiggs, TVar::MCFM, TVar::ZZGG, Mela::Hypothesis::kComputeP, true));
+  hypotheses.push_back(TestHypothesis("Generic path, JHUGen 0+m with constant", TVar::HSMHiggs, TVar::JHUGen, TVar::ZZGG, Mela::Hypothesis::kComputeP, true));
+  for (unsigned int ih=0; ih<hypotheses.size(); ih++){
+    hypotheses.at(ih).lepInterf = TVar::InterfOff;
+    if (hypotheses.at(ih).production!=TVar::ZZINDEPENDENT){ hypotheses.at(ih).mH=300.; hypotheses.at(ih).wH=10.; }
+  }
+
+  for (unsigned int ih=0; ih<hypotheses.size(); ih++){
+    const TestHypothesis& hypo = hypotheses.at(ih);
+
+    vector<float> probRef;
+    for (unsigned int ev=0; ev<nEvents; ev++){
+      mela.setInputEvent(&(daughtersList.at(ev)), (SimpleParticleCollection_t*)0, (SimpleParticleCollection_t*)0, false);
+      probRef.push_back(hypo.compute(mela));
+      mela.resetInputEvent();
+    }
+
+    vector<float> probBatch;
+    hypo.setPerComputationSettings(mela);
+    mela.computeP_batch(hypo.process, hypo.matrixElement, hypo.production, daughtersList, probBatch, hypo.useConstant);
+
+    if (!status.check(probBatch.size()==nEvents, Form("%s: computeP_batch returned %u values for %u events", hypo.name.c_str(), (unsigned int) probBatch.size(), nEvents))) continue;
+    for (unsigned int ev=0; ev<nEvents; ev++){
+      status.check(probRef.at(ev)>0.f, Form("%s, event %u: Reference ME is %g", hypo.name.c_str(), ev, probRef.at(ev)));
+      status.checkClose(probBatch.at(ev), probRef.at(ev), 1e-5, Form("%s, event %u", hypo.name.c_str(), ev));
+    }
+  }
+  return status.finish();
+}
@@ -0,0 +1,189 @@
+// Events, hypotheses and pass/fail bookkeeping shared by the testME_*.c tests.
+// Each test function returns 0 if all of its checks pass and 1 otherwise, which root -l -b -q passes on as the exit status,
+// and prints a last line that starts with "<test>: PASSED" or "<test>: FAILED".
+#ifndef TESTME_COMMON_H
+#define TESTME_COMMON_H
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "Mela.h"
+#include "TLorentzVector.h"
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TString.h"
+
+
+namespace testME{
+
+  // Four leptons of the first entries of l1_array...l4_array in testME_v2.c as (E, px, py, pz)
+  const double leptonArray[4][4] ={
+    { 51.374202, 25.924766, 12.290178, 42.616376 },
+    { 271.875752, 70.427173, -11.138146, 261.769598 },
+    { 75.823478, -16.640412, 23.246999, 70.227220 },
+    { 21.481452, 9.489680, -9.336587, 16.858699 }
+  };
+  // Two jets from the third entries of the commented-out l1_array and l3_array in testME_v2.c
+  const double jetArray[2][4] ={
+    { 101.52463181523598, 27.359569630718468, -0.90299073100241323, -97.764458892691749 },
+    { 180.10885677707822, -6.7240759244122792, 35.742176497019194, -176.39865053838915 }
+  };
+  const int ids_2e2mu[4] ={ 13, -13, 11, -11 };
+  const int ids_4mu[4] ={ 13, -13, 13, -13 };
+  const int ids_4e[4] ={ 11, -11, 11, -11 };
+
+  // Leptons of leptonArray with the given ids. If rand is not null, px is smeared by 10% and the leptons are made massless.
+  inline SimpleParticleCollection_t getLeptons(const int ids[4], TRandom3* rand=0){
+    SimpleParticleCollection_t daughters;
+    for (unsigned int idau=0; idau<4; idau++){
+      TLorentzVector pDaughter;
+      pDaughter.SetXYZT(leptonArray[idau][1]*(rand!=0 ? 1.+0.1*rand->Gaus() : 1.), leptonArray[idau][2], leptonArray[idau][3], leptonArray[idau][0]);
+      if (rand!=0) pDaughter.SetE(pDaughter.P());
+      daughters.push_back(SimpleParticle_t(ids[idau], pDaughter));
+    }
+    return daughters;
+  }
+  // Leptons of leptonArray with the given ids, in one of nLeptonOrders orders of its rows. The orders serve as distinct events with unchanged momenta.
+  const unsigned int nLeptonOrders = 3;
+  const unsigned int leptonOrders[nLeptonOrders][4] ={ { 0, 1, 2, 3 }, { 0, 3, 2, 1 }, { 2, 3, 0, 1 } };
+  inline SimpleParticleCollection_t getReorderedLeptons(const int ids[4], unsigned int iorder){
+    SimpleParticleCollection_t daughters;
+    for (unsigned int idau=0; idau<4; idau++){
+      const double* pArray = leptonArray[leptonOrders[iorder][idau]];
+      TLorentzVector pDaughter;
+      pDaughter.SetXYZT(pArray[1], pArray[2], pArray[3], pArray[0]);
+      daughters.push_back(SimpleParticle_t(ids[idau], pDaughter));
+    }
+    return daughters;
+  }
+  // Jets of jetArray with unknown ids. If rand is not null, px is smeared by 10% and the jets are made massless.
+  inline SimpleParticleCollection_t getJets(TRandom3* rand=0){
+    SimpleParticleCollection_t associated;
+    for (unsigned int iap=0; iap<2; iap++){
+      TLorentzVector pJet;
+      pJet.SetXYZT(jetArray[iap][1]*(rand!=0 ? 1.+0.1*rand->Gaus() : 1.), jetArray[iap][2], jetArray[iap][3], jetArray[iap][0]);
+      if (rand!=0) pJet.SetE(pJet.P());
+      associated.push_back(SimpleParticle_t(0, pJet));
+    }
+    return associated;
+  }
+  // Massless jets with 30<pT<230 GeV and |eta|<4.7
+  inline SimpleParticleCollection_t getRandomJets(TRandom3& rand, unsigned int nJets=2){
+    SimpleParticleCollection_t associated;
+    for (unsigned int iap=0; iap<nJets; iap++){
+      TLorentzVector pJet;
+      pJet.SetPtEtaPhiM(30.+200.*rand.Rndm(), rand.Uniform(-4.7, 4.7), rand.Uniform(-TMath::Pi(), TMath::Pi()), 0.);
+      associated.push_back(SimpleParticle_t(0, pJet));
+    }
+    return associated;
+  }
+
+  // NNPDF grid shipped with the package, for the tests that switch PDF members
+  inline std::string getNNPDFPath(){
+    const char* cmsswBase = getenv("CMSSW_BASE");
+    return std::string(cmsswBase!=0 ? cmsswBase : ".") + "/src/ZZMatrixElement/MELA/data/Pdfdata/NNPDF30_lo_as_0130.LHgrid";
+  }
+
+  // Mela::Hypothesis with the settings that Mela resets after each computation
+  struct TestHypothesis : public Mela::Hypothesis{
+    std::string name;
+    double mH; // <0: Leave the Higgs mass and width as they are
+    double wH;
+    TVar::LeptonInterference lepInterf;
+
+    TestHypothesis(
+      const std::string& name_,
+      TVar::Process process_, TVar::MatrixElement matrixElement_, TVar::Production production_,
+      ComputationType computation_=kComputeP, bool useConstant_=false
+      ) :
+      Mela::Hypothesis(process_, matrixElement_, production_, computation_, useConstant_),
+      name(name_),
+      mH(-1), wH(-1),
+      lepInterf(TVar::DefaultLeptonInterf)
+    {}
+
+    void setPerComputationSettings(Mela& mela) const{
+      if (mH>=0.) mela.setMelaHiggsMassWidth(mH, wH, 0);
+      mela.setMelaLeptonInterference(lepInterf);
+    }
+    // Same as the corresponding computation in Mela::computeP_multi
+    float compute(Mela& mela) const{
+      if (hasCouplings) mela.restoreSelfDCouplings(couplings);
+      mela.setProcess(process, matrixElement, production);
+      setPerComputationSettings(mela);
+      float prob=0;
+      switch (computation){
+      case kComputeP:
+        mela.computeP(prob, useConstant);
+        break;
+      case kComputeProdDecP:
+        mela.computeProdDecP(prob, useConstant);
+        break;
+      case kComputeProdP:
+        mela.computeProdP(prob, useConstant);
+        break;
+      case kComputeProdP_VH:
+        mela.computeProdP_VH(prob, includeHiggsDecay, useConstant);
+        break;
+      case kComputeProdP_ttH:
+        mela.computeProdP_ttH(prob, topProcess, topDecay, useConstant);
+        break;
+      }
+      return prob;
+    }
+  };
+
+  // Counts the checks of a test and their failures
+  class TestStatus{
+  public:
+    TestStatus(const std::string& testName_) : testName(testName_), nChecks(0), nFailed(0), maxRelDiff(0){}
+
+    bool check(bool condition, const std::string& what){
+      nChecks++;
+      if (!condition){
+        nFailed++;
+        std::cout << testName << ": Check failed: " << what << std::endl;
+      }
+      return condition;
+    }
+    // |value-reference| <= tolerance*|reference|, i.e. exact equality for tolerance=0
+    bool checkClose(double value, double reference, double tolerance, const std::string& what){
+      double relDiff = (value==reference ? 0. : fabs(value-reference)/std::max(fabs(reference), 1e-300));
+      if (relDiff>maxRelDiff) maxRelDiff=relDiff;
+      bool pass = (relDiff<=tolerance);
+      nChecks++;
+      if (!pass){
+        nFailed++;
+        std::cout << testName << ": Check failed: " << what << ": " << value << " instead of " << reference << " (relative difference " << relDiff << ")" << std::endl;
+      }
+      return pass;
+    }
+
+    unsigned int getNChecks() const{ return nChecks; }
+    unsigned int getNFailed() const{ return nFailed; }
+    double getMaxRelDiff() const{ return maxRelDiff; }
+
+    // Prints the summary line and returns the exit status
+    int finish() const{
+      if (nFailed==0 && nChecks>0){
+        std::cout << testName << ": PASSED (" << nChecks << " checks, maximum relative difference " << maxRelDiff << ")" << std::endl;
+        return 0;
+      }
+      std::cout << testName << ": FAILED (" << nFailed << " of " << nChecks << " checks failed)" << std::endl;
+      return 1;
+    }
+
+  protected:
+    std::string testName;
+    unsigned int nChecks;
+    unsigned int nFailed;
+    double maxRelDiff;
+  };
+
+}
+
+
+#endif
@@ -0,0 +1,166 @@
+// Isolation of the per-instance contexts: Two Mela objects with different PDF members, lepton mass removal, top mass, EW parameters and CKM elements
+// compute the same hypotheses on the same events, first each on its own and then interleaved hypothesis by hypothesis.
+// The interleaved MEs have to agree bitwise with the isolated ones, and the PDF, JJQCD channel and MCFM configuration cache statistics of each object
+// have to be the same in both runs, i.e. neither object may use or invalidate the caches of the other.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_Contexts.c+
+#include <iostream>
+#include <vector>
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+namespace{
+  const unsigned int nConfigurations = 2;
+
+  struct CacheStatistics{
+    TUtil::PDFCacheStatistics pdf;
+    TUtil::HJJChannelCacheStatistics hjj;
+    TUtil::MCFMConfigCacheStatistics mcfmConfig;
+
+    void record(Mela& mela){
+      pdf = mela.getPDFCacheStatistics();
+      hjj = mela.getHJJChannelCacheStatistics();
+      mcfmConfig = mela.getMCFMConfigCacheStatistics();
+    }
+  };
+
+  Mela* createMela(unsigned int iconf){
+    Mela* mela = new Mela(13, 125, TVar::ERROR);
+    mela->setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+    if (iconf==1){
+      mela->setLHAgrid(getNNPDFPath().c_str(), 2);
+      mela->setRemoveLeptonMasses(false);
+      mela->resetMCFM_EWKParameters(1.16639E-05, 1./132.5, 80.385, 91.1876, 0.23119, 3);
+      mela->resetMass(172.5, 6);
+      mela->resetCKMElements(0.97425, 0.2253, -0.2252, 0.97345, -0.0405, 0.99914);
+    }
+    mela->resetPDFCacheStatistics();
+    mela->resetHJJChannelCacheStatistics();
+    mela->resetMCFMConfigCacheStatistics();
+    return mela;
+  }
+
+  vector<TestHypothesis> getHypotheses(){
+    Mela& mela = *(createMela(0));
+    vector<TestHypothesis> hypotheses;
+    hypotheses.push_back(TestHypothesis("MCFM qq->ZZ", TVar::bkgZZ, TVar::MCFM, TVar::ZZQQB));
+    hypotheses.push_back(TestHypothesis("MCFM gg->H->ZZ", TVar::HSMHiggs, TVar::MCFM, TVar::ZZGG));
+    {
+      TestHypothesis hypo("MCFM gg->H->ZZ with self-defined couplings", TVar::SelfDefine_spin0, TVar::MCFM, TVar::ZZGG);
+      mela.selfDHggcoupl[0][gHIGGS_GG_2][0]=1.0;
+      mela.selfDHzzcoupl[0][gHIGGS_VV_1][0]=1.0;
+      mela.selfDHzzcoupl[0][gHIGGS_VV_4][0]=0.5;
+      hypo.setCouplings(mela);
+      hypotheses.push_back(hypo);
+      mela.reset_SelfDCouplings();
+    }
+    hypotheses.push_back(TestHypothesis("JHUGen H+jj 0+m", TVar::HSMHiggs, TVar::JHUGen, TVar::JJQCD, Mela::Hypothesis::kComputeProdP));
+    hypotheses.push_back(TestHypothesis("JHUGen H+jj 0-", TVar::H0minus, TVar::JHUGen, TVar::JJQCD, Mela::Hypothesis::kComputeProdP));
+    {
+      TestHypothesis hypo("JHUGen VBF with self-defined couplings", TVar::SelfDefine_spin0, TVar::JHUGen, TVar::JJVBF, Mela::Hypothesis::kComputeProdP);
+      mela.selfDHzzcoupl[0][gHIGGS_VV_1][0]=1.0;
+      mela.selfDHzzcoupl[0][gHIGGS_VV_2][0]=0.3;
+      mela.selfDHwwcoupl[0][gHIGGS_VV_1][0]=1.0;
+      mela.selfDHwwcoupl[0][gHIGGS_VV_2][0]=0.3;
+      hypo.setCouplings(mela);
+      hypotheses.push_back(hypo);
+      mela.reset_SelfDCouplings();
+    }
+    hypotheses.push_back(TestHypothesis("JHUGen ZH", TVar::HSMHiggs, TVar::JHUGen, TVar::Had_ZH, Mela::Hypothesis::kComputeProdP_VH));
+    hypotheses.push_back(TestHypothesis("MCFM VBF with decay", TVar::HSMHiggs, TVar::MCFM, TVar::JJVBF, Mela::Hypothesis::kComputeProdDecP));
+    delete &mela;
+    return hypotheses;
+  }
+
+  void checkStatistics(TestStatus& status, const CacheStatistics& isolated, const CacheStatistics& interleaved, unsigned int iconf){
+    status.check(
+      interleaved.pdf.nPDFHits==isolated.pdf.nPDFHits && interleaved.pdf.nPDFMisses==isolated.pdf.nPDFMisses
+      && interleaved.pdf.nAlphaSHits==isolated.pdf.nAlphaSHits && interleaved.pdf.nAlphaSMisses==isolated.pdf.nAlphaSMisses,
+      Form(
+        "Configuration %u: PDF cache hits/misses are %llu/%llu interleaved and %llu/%llu isolated",
+        iconf, interleaved.pdf.nPDFHits, interleaved.pdf.nPDFMisses, isolated.pdf.nPDFHits, isolated.pdf.nPDFMisses
+      )
+    );
+    status.check(
+      interleaved.hjj.nHits==isolated.hjj.nHits && interleaved.hjj.nMisses==isolated.hjj.nMisses && interleaved.hjj.nAmplitudeEvaluations==isolated.hjj.nAmplitudeEvaluations,
+      Form(
+        "Configuration %u: JJQCD channel cache hits/misses are %llu/%llu interleaved and %llu/%llu isolated",
+        iconf, interleaved.hjj.nHits, interleaved.hjj.nMisses, isolated.hjj.nHits, isolated.hjj.nMisses
+      )
+    );
+    status.check(
+      interleaved.mcfmConfig.nHits==isolated.mcfmConfig.nHits && interleaved.mcfmConfig.nMisses==isolated.mcfmConfig.nMisses,
+      Form(
+        "Configuration %u: MCFM configuration cache hits/misses are %llu/%llu interleaved and %llu/%llu isolated",
+        iconf, interleaved.mcfmConfig.nHits, interleaved.mcfmConfig.nMisses, isolated.mcfmConfig.nHits, isolated.mcfmConfig.nMisses
+      )
+    );
+    // Otherwise the comparison above would not test any caching
+    status.check(isolated.pdf.nPDFHits>0 && isolated.hjj.nHits>0 && isolated.mcfmConfig.nHits>0, Form("Configuration %u: The isolated run has no cache hits", iconf));
+  }
+}
+
+
+int testME_Contexts(unsigned int nEvents=10){
+  TestStatus status("testME_Contexts");
+  vector<TestHypothesis> hypotheses = getHypotheses();
+
+  vector<SimpleParticleCollection_t> daughtersList;
+  vector<SimpleParticleCollection_t> associatedList;
+  TRandom3 rand(12345);
+  for (unsigned int ev=0; ev<nEvents; ev++){
+    daughtersList.push_back(getLeptons(ids_2e2mu, &rand));
+    associatedList.push_back(getRandomJets(rand));
+  }
+
+  // Each configuration on its own
+  vector<float> probIsolated[nConfigurations];
+  CacheStatistics statsIsolated[nConfigurations];
+  for (unsigned int iconf=0; iconf<nConfigurations; iconf++){
+    Mela* mela = createMela(iconf);
+    for (unsigned int ev=0; ev<nEvents; ev++){
+      mela->setInputEvent(&(daughtersList.at(ev)), &(associatedList.at(ev)), (SimpleParticleCollection_t*)0, false);
+      for (unsigned int ih=0; ih<hypotheses.size(); ih++) probIsolated[iconf].push_back(hypotheses.at(ih).compute(*mela));
+      mela->resetInputEvent();
+    }
+    statsIsolated[iconf].record(*mela);
+    delete mela;
+  }
+
+  // Both configurations alternated after every computation
+  vector<float> probInterleaved[nConfigurations];
+  CacheStatistics statsInterleaved[nConfigurations];
+  Mela* melaList[nConfigurations];
+  for (unsigned int iconf=0; iconf<nConfigurations; iconf++) melaList[iconf] = createMela(iconf);
+  for (unsigned int ev=0; ev<nEvents; ev++){
+    for (unsigned int iconf=0; iconf<nConfigurations; iconf++) melaList[iconf]->setInputEvent(&(daughtersList.at(ev)), &(associatedList.at(ev)), (SimpleParticleCollection_t*)0, false);
+    for (unsigned int ih=0; ih<hypotheses.size(); ih++){
+      for (unsigned int iconf=0; iconf<nConfigurations; iconf++) probInterleaved[iconf].push_back(hypotheses.at(ih).compute(*(melaList[iconf])));
+    }
+    for (unsigned int iconf=0; iconf<nConfigurations; iconf++) melaList[iconf]->resetInputEvent();
+  }
+  for (unsigned int iconf=0; iconf<nConfigurations; iconf++){
+    statsInterleaved[iconf].record(*(melaList[iconf]));
+    delete melaList[iconf];
+  }
+
+  for (unsigned int iconf=0; iconf<nConfigurations; iconf++){
+    for (unsigned int ip=0; ip<probIsolated[iconf].size(); ip++){
+      const TestHypothesis& hypo = hypotheses.at(ip%hypotheses.size());
+      unsigned int ev = ip/hypotheses.size();
+      status.check(probIsolated[iconf].at(ip)>0.f, Form("Configuration %u, event %u, %s: Isolated ME is %g", iconf, ev, hypo.name.c_str(), probIsolated[iconf].at(ip)));
+      status.checkClose(probInterleaved[iconf].at(ip), probIsolated[iconf].at(ip), 0, Form("Configuration %u, event %u, %s", iconf, ev, hypo.name.c_str()));
+    }
+    checkStatistics(status, statsIsolated[iconf], statsInterleaved[iconf], iconf);
+  }
+  // The configurations have to differ, or the interleaving would not test anything
+  unsigned int nDifferent=0;
+  for (unsigned int ip=0; ip<probIsolated[0].size(); ip++){ if (probIsolated[0].at(ip)!=probIsolated[1].at(ip)) nDifferent++; }
+  cout << "testME_Contexts: " << nDifferent << " of " << probIsolated[0].size() << " MEs differ between the two configurations." << endl;
+  status.check(nDifferent>0, "The two configurations give the same MEs");
+
+  return status.finish();
+}
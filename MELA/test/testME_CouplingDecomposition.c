@@ -0,0 +1,110 @@
+// Consistency of Mela::computeP_fromDecomposition with a direct computeP for random values of the active couplings,
+// with a non-default Higgs mass and width and the lepton interference off.
+// Only the active HVV couplings are set in the first MCFM case, so the point with all active couplings at zero has no self-defined coupling at all.
+// The decomposition has to compute it with the anomalous couplings and lepton interference as well, like all other points.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_CouplingDecomposition.c+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+namespace{
+  enum InactiveCouplings{
+    kNoInactiveCouplings,
+    kInactiveHgg, // ghg2=1 for the JHUGen gg->H production
+    kInactiveHtt // kappa_top=1 for the MCFM gg->H production
+  };
+  struct DecompositionHypothesis{
+    string name;
+    TVar::Process process;
+    TVar::MatrixElement me;
+    InactiveCouplings inactiveCouplings;
+    bool useConstant;
+
+    DecompositionHypothesis(const string& name_, TVar::Process process_, TVar::MatrixElement me_, InactiveCouplings inactiveCouplings_, bool useConstant_) :
+      name(name_), process(process_), me(me_), inactiveCouplings(inactiveCouplings_), useConstant(useConstant_)
+    {}
+
+    void setInactiveCouplings(Mela& mela) const{
+      if (inactiveCouplings==kInactiveHgg) mela.selfDHggcoupl[0][gHIGGS_GG_2][0]=1.0;
+      else if (inactiveCouplings==kInactiveHtt) mela.selfDHttcoupl[0][gHIGGS_KAPPA][0]=1.0;
+    }
+  };
+  void setPerComputationSettings(Mela& mela){
+    mela.setMelaHiggsMassWidth(200., 5., 0);
+    mela.setMelaLeptonInterference(TVar::InterfOff);
+  }
+}
+
+
+int testME_CouplingDecomposition(unsigned int nEvents=5, unsigned int nPoints=20){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+  mela.setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+  TestStatus status("testME_CouplingDecomposition");
+
+  vector<DecompositionHypothesis> hypotheses;
+  hypotheses.push_back(DecompositionHypothesis("JHUGen", TVar::SelfDefine_spin0, TVar::JHUGen, kInactiveHgg, false));
+  hypotheses.push_back(DecompositionHypothesis("JHUGen with constant", TVar::SelfDefine_spin0, TVar::JHUGen, kInactiveHgg, true));
+  hypotheses.push_back(DecompositionHypothesis("MCFM gg->ZZ with the Higgs, HVV couplings only", TVar::bkgZZ_SMHiggs, TVar::MCFM, kNoInactiveCouplings, false));
+  hypotheses.push_back(DecompositionHypothesis("MCFM gg->H->ZZ with kappa_top", TVar::SelfDefine_spin0, TVar::MCFM, kInactiveHtt, false));
+  const int activeIndices[3] ={ gHIGGS_VV_1, gHIGGS_VV_2, gHIGGS_VV_4 };
+  const unsigned int nActive = sizeof(activeIndices)/sizeof(int);
+
+  TRandom3 rand(12345);
+  for (unsigned int ev=0; ev<nEvents; ev++){
+    SimpleParticleCollection_t daughters = getLeptons(ids_4e, &rand); // 4e, so that the lepton interference setting matters
+    mela.setInputEvent(&daughters, (SimpleParticleCollection_t*)0, (SimpleParticleCollection_t*)0, false);
+
+    for (unsigned int ih=0; ih<hypotheses.size(); ih++){
+      const DecompositionHypothesis& hypo = hypotheses.at(ih);
+
+      vector<double*> basis;
+      for (unsigned int ic=0; ic<nActive; ic++) basis.push_back(&(mela.selfDHzzcoupl[0][activeIndices[ic]][0]));
+      mela.setCouplingDecompositionBasis(basis);
+      mela.setProcess(hypo.process, hypo.me, TVar::ZZGG);
+      hypo.setInactiveCouplings(mela);
+      setPerComputationSettings(mela);
+      mela.computeCouplingDecomposition(hypo.useConstant);
+
+      for (unsigned int ip=0; ip<nPoints; ip++){
+        vector< pair<double, double> > values;
+        for (unsigned int ic=0; ic<nActive; ic++) values.push_back(pair<double, double>(rand.Uniform(-2., 2.), rand.Uniform(-2., 2.)));
+        // One active coupling at a time, which probes the subtractions of the zero point most directly
+        if (ip<nActive){
+          for (unsigned int ic=0; ic<nActive; ic++){ if (ic!=ip) values.at(ic) = pair<double, double>(0, 0); }
+        }
+
+        float probDecomposed=0;
+        mela.computeP_fromDecomposition(values, probDecomposed);
+
+        float probDirect=0;
+        hypo.setInactiveCouplings(mela);
+        for (unsigned int ic=0; ic<nActive; ic++){
+          mela.selfDHzzcoupl[0][activeIndices[ic]][0]=values.at(ic).first;
+          mela.selfDHzzcoupl[0][activeIndices[ic]][1]=values.at(ic).second;
+        }
+        setPerComputationSettings(mela);
+        mela.computeP(probDirect, hypo.useConstant);
+
+        // computeP resets the couplings, so bring back the inactive ones for the next point
+        hypo.setInactiveCouplings(mela);
+
+        status.check(probDirect>0.f, Form("%s, event %u, point %u: Direct ME is %g", hypo.name.c_str(), ev, ip, probDirect));
+        status.checkClose(probDecomposed, probDirect, 1e-4, Form("%s, event %u, point %u", hypo.name.c_str(), ev, ip));
+      }
+      mela.resetCouplingDecomposition();
+      mela.reset_SelfDCouplings();
+    }
+    mela.resetInputEvent();
+  }
+  return status.finish();
+}
@@ -0,0 +1,155 @@
+// Consistency of the coupling push tracking: the same sequence of MCFM and JHUGen MEs with standard and self-defined couplings
+// is computed with the tracking switched off and on, and the MEs are compared.
+// Both MCFM and JHUGen pushes have to be skipped with the tracking on, and none without it.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_CouplingPushes.c+
+#include <iostream>
+#include <vector>
+#include "TStopwatch.h"
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+namespace{
+  enum CouplingChoice{
+    kDefaultCouplings,
+    kMCFMg1,
+    kMCFMg4,
+    kJHUGeng1,
+    kJHUGeng4,
+    kJHUGenSpinOne,
+    kJHUGenSpinTwo
+  };
+  struct CouplingHypothesis{
+    TVar::Process proc;
+    TVar::MatrixElement me;
+    TVar::Production prod;
+    CouplingChoice couplings;
+  };
+  void setCouplings(Mela& mela, CouplingChoice couplings){
+    switch (couplings){
+    case kMCFMg1:
+      mela.selfDHbbcoupl[0][gHIGGS_KAPPA][0]=1.0;
+      mela.selfDHttcoupl[0][gHIGGS_KAPPA][0]=1.0;
+      mela.selfDHzzcoupl[0][gHIGGS_VV_1][0]=1.0;
+      break;
+    case kMCFMg4:
+      mela.selfDHbbcoupl[0][gHIGGS_KAPPA][0]=1.0;
+      mela.selfDHttcoupl[0][gHIGGS_KAPPA][0]=1.0;
+      mela.selfDHzzcoupl[0][gHIGGS_VV_4][0]=1.0;
+      break;
+    case kJHUGeng1:
+      mela.selfDHggcoupl[0][gHIGGS_GG_2][0]=1.0;
+      mela.selfDHzzcoupl[0][gHIGGS_VV_1][0]=1.0;
+      break;
+    case kJHUGeng4:
+      mela.selfDHggcoupl[0][gHIGGS_GG_2][0]=1.0;
+      mela.selfDHzzcoupl[0][gHIGGS_VV_4][0]=1.0;
+      break;
+    case kJHUGenSpinOne:
+      mela.selfDZqqcoupl[gZPRIME_QQ_LEFT][0]=1.0;
+      mela.selfDZqqcoupl[gZPRIME_QQ_RIGHT][0]=1.0;
+      mela.selfDZvvcoupl[gZPRIME_VV_1][0]=1.0;
+      break;
+    case kJHUGenSpinTwo:
+      mela.selfDGggcoupl[gGRAVITON_GG_1][0]=1.0;
+      mela.selfDGvvcoupl[gGRAVITON_VV_1][0]=1.0;
+      mela.selfDGvvcoupl[gGRAVITON_VV_5][0]=1.0;
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+
+int testME_CouplingPushes(unsigned int nEvents=20){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+  mela.setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+  TestStatus status("testME_CouplingPushes");
+
+  // Repeated hypotheses and coupling choices within an event are intentional, they are the pushes that can be skipped.
+  const CouplingHypothesis hypotheses[] ={
+    { TVar::bkgZZ, TVar::MCFM, TVar::ZZQQB, kDefaultCouplings },
+    { TVar::HSMHiggs, TVar::MCFM, TVar::ZZGG, kDefaultCouplings },
+    { TVar::bkgZZ_SMHiggs, TVar::MCFM, TVar::ZZGG, kDefaultCouplings },
+    { TVar::HSMHiggs, TVar::MCFM, TVar::ZZGG, kMCFMg1 },
+    { TVar::bkgZZ_SMHiggs, TVar::MCFM, TVar::ZZGG, kMCFMg1 },
+    { TVar::HSMHiggs, TVar::MCFM, TVar::ZZGG, kMCFMg4 },
+    { TVar::bkgZZ, TVar::MCFM, TVar::ZZGG, kDefaultCouplings },
+    { TVar::HSMHiggs, TVar::JHUGen, TVar::ZZGG, kDefaultCouplings },
+    { TVar::H0minus, TVar::JHUGen, TVar::ZZGG, kDefaultCouplings },
+    { TVar::SelfDefine_spin0, TVar::JHUGen, TVar::ZZGG, kJHUGeng1 },
+    { TVar::SelfDefine_spin0, TVar::JHUGen, TVar::ZZGG, kJHUGeng1 },
+    { TVar::SelfDefine_spin0, TVar::JHUGen, TVar::ZZGG, kJHUGeng4 },
+    { TVar::HSMHiggs, TVar::JHUGen, TVar::ZZGG, kDefaultCouplings },
+    { TVar::H1plus, TVar::JHUGen, TVar::ZZQQB, kDefaultCouplings },
+    { TVar::SelfDefine_spin1, TVar::JHUGen, TVar::ZZQQB, kJHUGenSpinOne },
+    { TVar::H2_g1, TVar::JHUGen, TVar::ZZGG, kDefaultCouplings },
+    { TVar::SelfDefine_spin2, TVar::JHUGen, TVar::ZZGG, kJHUGenSpinTwo },
+    { TVar::H2_g1, TVar::JHUGen, TVar::ZZGG, kDefaultCouplings }
+  };
+  const unsigned int nHypotheses = sizeof(hypotheses)/sizeof(CouplingHypothesis);
+
+  vector<float> probRef, probTracked;
+  TStopwatch timerRef, timerTracked;
+  timerRef.Stop(); timerRef.Reset();
+  timerTracked.Stop(); timerTracked.Reset();
+  for (int useTracking=0; useTracking<2; useTracking++){
+    mela.setCouplingPushTracking(useTracking==1);
+    mela.resetCouplingPushStatistics();
+    vector<float>& probs = (useTracking==1 ? probTracked : probRef);
+    TStopwatch& timer = (useTracking==1 ? timerTracked : timerRef);
+
+    TRandom3 rand(12345);
+    for (unsigned int ev=0; ev<nEvents; ev++){
+      SimpleParticleCollection_t daughters = getLeptons(ids_2e2mu, &rand);
+      mela.setInputEvent(&daughters, (SimpleParticleCollection_t*)0, (SimpleParticleCollection_t*)0, false);
+
+      for (unsigned int ih=0; ih<nHypotheses; ih++){
+        const CouplingHypothesis& hypo = hypotheses[ih];
+        mela.setProcess(hypo.proc, hypo.me, hypo.prod);
+        setCouplings(mela, hypo.couplings);
+        float prob=0;
+        timer.Start(false);
+        mela.computeP(prob, false);
+        timer.Stop();
+        probs.push_back(prob);
+      }
+      mela.resetInputEvent();
+    }
+
+    TUtil::CouplingPushStatistics stats = mela.getCouplingPushStatistics();
+    cout << "testME_CouplingPushes: Tracking " << (useTracking==1 ? "on" : "off") << endl;
+    cout << "\tMCFM: " << stats.nMCFMPushes << " pushes, " << stats.getNMCFMSkipped() << " skipped (" << stats.getMCFMSkippedFraction() << ")" << endl;
+    cout << "\tJHUGen: " << stats.nJHUGenPushes << " pushes, " << stats.getNJHUGenSkipped() << " skipped (" << stats.getJHUGenSkippedFraction() << ")" << endl;
+    if (useTracking==1){
+      status.check(stats.getNMCFMSkipped()>0, "The tracking is on, but no MCFM push was skipped");
+      status.check(stats.getNJHUGenSkipped()>0, "The tracking is on, but no JHUGen push was skipped");
+    }
+    else status.check(
+      stats.getNMCFMSkipped()==0 && stats.getNJHUGenSkipped()==0,
+      Form("The tracking is off, but %llu MCFM and %llu JHUGen pushes were skipped", stats.getNMCFMSkipped(), stats.getNJHUGenSkipped())
+    );
+  }
+  mela.setCouplingPushTracking(true);
+
+  for (unsigned int is=0; is<probRef.size(); is++){
+    const CouplingHypothesis& hypo = hypotheses[is%nHypotheses];
+    TString what = Form(
+      "Event %u, %s (%s, %s) with coupling choice %i",
+      is/nHypotheses, TVar::ProcessName(hypo.proc).Data(), TVar::MatrixElementName(hypo.me).Data(), TVar::ProductionName(hypo.prod).Data(), (int) hypo.couplings
+    );
+    status.check(probRef.at(is)>0.f, Form("%s: ME without tracking is %g", what.Data(), probRef.at(is)));
+    status.checkClose(probTracked.at(is), probRef.at(is), 0, what.Data());
+  }
+  cout << "testME_CouplingPushes: Timing per ME over " << nEvents << " events and " << nHypotheses << " hypotheses" << endl;
+  cout << "\tWithout tracking: " << timerRef.CpuTime()/double(probRef.size())*1e6 << " us" << endl;
+  cout << "\tWith tracking: " << timerTracked.CpuTime()/double(probTracked.size())*1e6 << " us" << endl;
+  return status.finish();
+}
@@ -0,0 +1,137 @@
+// Counts the heap allocations in a typical setInputEvent/computeP/resetInputEvent loop.
+// After the first occurrence of each event topology, setInputEvent and resetInputEvent must not call operator new at all,
+// and the number of live allocations has to stay the same from one event to the next,
+// i.e. the event arena of Mela has to reuse its objects and the MEs must not keep anything per event.
+// The global operator new/delete below do the counting. They only replace the ones used in the libraries when the test is an executable,
+// e.g. g++ -DTESTME_EVENTARENA_MAIN testME_EventArena.c $(root-config --cflags --libs) -I../interface -L../data/$SCRAM_ARCH -lZZMatrixElementMELA -lmcfm_703
+// With root -l -b -q loadMELA.C testME_EventArena.c+, the libraries keep the operators of libstdc++, and the test fails because it cannot count.
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "MELAEventArena.h"
+#include "TStopwatch.h"
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+namespace{
+  size_t nNew=0; // Total number of calls to operator new
+  size_t nLive=0; // Allocations not deleted yet
+}
+
+void* operator new(size_t size){
+  void* ptr = malloc(size>0 ? size : 1);
+  if (ptr==0) throw std::bad_alloc();
+  nNew++;
+  nLive++;
+  return ptr;
+}
+void* operator new[](size_t size){ return operator new(size); }
+void operator delete(void* ptr) throw(){
+  if (ptr==0) return;
+  nLive--;
+  free(ptr);
+}
+void operator delete[](void* ptr) throw(){ operator delete(ptr); }
+
+
+int testME_EventArena(unsigned int nEvents=200){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+  mela.setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+  TestStatus status("testME_EventArena");
+
+  const int nTopologies = 4;
+  const int* idOrdered[2] ={ ids_2e2mu, ids_4mu };
+  const unsigned int nWarmup = 2*nTopologies; // Each topology and flavor appears once
+
+  // Calls to operator new in setInputEvent and resetInputEvent per event, reserved in advance so that the recording does not allocate
+  vector<size_t> nNewPerEvent;
+  nNewPerEvent.reserve(nEvents);
+
+  TRandom3 rand(12345);
+  TStopwatch timer;
+  timer.Stop(); timer.Reset();
+  size_t nLiveWarmup=0;
+  unsigned int nEventsGrown=0;
+  for (unsigned int ev=0; ev<=nEvents; ev++){
+    // Sampled at the start of the next event, when the particle collections of the previous one are gone
+    if (ev==nWarmup) nLiveWarmup = nLive;
+    else if (ev>nWarmup && nLive!=nLiveWarmup){
+      cout << "testME_EventArena: Event " << ev-1 << " (topology " << (ev-1)%nTopologies << ") changed the number of live allocations by "
+        << (long long) nLive - (long long) nLiveWarmup << endl;
+      nLiveWarmup = nLive;
+      nEventsGrown++;
+    }
+    if (ev==nEvents) break;
+
+    const int topology = ev%nTopologies; // 0: Decay only, 1: + 2 jets, 2: + 1 jet, 3: + 2 jets and mothers
+    const int flavor = (ev/nTopologies)%2;
+
+    SimpleParticleCollection_t daughters = getLeptons(idOrdered[flavor], &rand);
+    const int nJets = (topology==0 ? 0 : (topology==2 ? 1 : 2));
+    SimpleParticleCollection_t associated = getRandomJets(rand, nJets);
+    SimpleParticleCollection_t mothers;
+    if (topology==3){
+      TLorentzVector pSum(0, 0, 0, 0);
+      for (unsigned int idau=0; idau<daughters.size(); idau++) pSum += daughters.at(idau).second;
+      for (unsigned int ij=0; ij<associated.size(); ij++) pSum += associated.at(ij).second;
+      TLorentzVector pM1(0, 0, (pSum.E()+pSum.Z())/2., (pSum.E()+pSum.Z())/2.);
+      TLorentzVector pM2(0, 0, -(pSum.E()-pSum.Z())/2., (pSum.E()-pSum.Z())/2.);
+      mothers.push_back(SimpleParticle_t(21, pM1));
+      mothers.push_back(SimpleParticle_t(21, pM2));
+    }
+
+    size_t nNewBefore = nNew;
+    timer.Start(false);
+    mela.setInputEvent(&daughters, (nJets>0 ? &associated : 0), (topology==3 ? &mothers : 0), topology==3);
+    timer.Stop();
+    size_t nNewEvent = nNew-nNewBefore;
+
+    float prob=0;
+    mela.setProcess(TVar::HSMHiggs, TVar::JHUGen, TVar::ZZGG);
+    mela.computeP(prob, false);
+    if (nJets>0){
+      mela.setProcess(TVar::HSMHiggs, TVar::JHUGen, TVar::JJQCD);
+      mela.computeProdP(prob, false);
+    }
+
+    nNewBefore = nNew;
+    timer.Start(false);
+    mela.resetInputEvent();
+    timer.Stop();
+    nNewEvent += nNew-nNewBefore;
+    nNewPerEvent.push_back(nNewEvent);
+  }
+
+  cout << "testME_EventArena: setInputEvent+resetInputEvent take " << timer.CpuTime()/double(nEvents)*1e6 << " us per event" << endl;
+  cout << "testME_EventArena: The event arena created " << mela.getEventArena()->getNAllocations() << " objects over " << nEvents << " events" << endl;
+  const bool isCounting = status.check(
+    nEvents==0 || nNewPerEvent.front()>0,
+    "The first setInputEvent did not go through the counting operator new, so the allocations of the libraries cannot be checked."
+    " Compile the test as an executable with -DTESTME_EVENTARENA_MAIN."
+  );
+  if (!isCounting) return status.finish();
+
+  for (unsigned int ev=nWarmup; ev<nNewPerEvent.size(); ev++){
+    status.check(
+      nNewPerEvent.at(ev)==0,
+      Form("Event %u (topology %u): setInputEvent and resetInputEvent called operator new %llu times", ev, ev%nTopologies, (unsigned long long) nNewPerEvent.at(ev))
+    );
+  }
+  status.check(nEventsGrown==0, Form("%u events changed the number of live allocations after the first %u events", nEventsGrown, nWarmup));
+  return status.finish();
+}
+
+
+#ifdef TESTME_EVENTARENA_MAIN
+int main(){
+  return testME_EventArena();
+}
+#endif
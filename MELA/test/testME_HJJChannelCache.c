@@ -0,0 +1,88 @@
+// Consistency and timing of the JJQCD channel cache: MEs for a scan of Hgg couplings on the same event, recombined from the cached channels,
+// are compared to the MEs computed with the cache switched off, where each channel is one JHUGen call with the Hgg couplings of the scan.
+// The whole cached scan has to cost no more amplitude evaluations than one computation per piece of the channels with the cache off.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_HJJChannelCache.c+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "TStopwatch.h"
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+int testME_HJJChannelCache(unsigned int nEvents=20, unsigned int nCouplings=20, double tolerance=1e-6){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+  mela.setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+  TestStatus status("testME_HJJChannelCache");
+
+  // ghg2 and ghg4 on the unit circle, including the pure 0+m and 0- couplings
+  vector< pair<double, double> > ghg2, ghg4;
+  for (unsigned int ic=0; ic<nCouplings; ic++){
+    double angle = TMath::Pi()*double(ic)/double(nCouplings);
+    ghg2.push_back(pair<double, double>(cos(angle), 0));
+    ghg4.push_back(pair<double, double>(sin(angle)*cos(3.*angle), sin(angle)*sin(3.*angle)));
+  }
+
+  TRandom3 rand(12345);
+  TStopwatch timerUncached, timerCached;
+  unsigned long long nEvaluationsTotal[2]={ 0, 0 };
+  mela.resetHJJChannelCacheStatistics();
+  for (unsigned int ev=0; ev<nEvents; ev++){
+    SimpleParticleCollection_t daughters = getLeptons(ids_2e2mu);
+    SimpleParticleCollection_t associated = getRandomJets(rand);
+    mela.setInputEvent(&daughters, &associated, (SimpleParticleCollection_t*)0, false);
+
+    // The cached scan starts from an empty cache
+    vector<float> probUncached, probCached;
+    unsigned long long nEvaluationsCached=0, nEvaluationsUncached=0, nHitsCached=0, nHitsUncached=0;
+    for (unsigned int icache=0; icache<2; icache++){
+      const bool useCache = (icache==1);
+      TStopwatch& timer = (useCache ? timerCached : timerUncached);
+      mela.setHJJChannelCaching(useCache);
+      const TUtil::HJJChannelCacheStatistics statsBeforeScan = mela.getHJJChannelCacheStatistics();
+      for (unsigned int ic=0; ic<nCouplings; ic++){
+        timer.Start(false);
+        mela.setProcess(TVar::SelfDefine_spin0, TVar::JHUGen, TVar::JJQCD);
+        mela.selfDHggcoupl[0][gHIGGS_GG_2][0] = ghg2.at(ic).first; mela.selfDHggcoupl[0][gHIGGS_GG_2][1] = ghg2.at(ic).second;
+        mela.selfDHggcoupl[0][gHIGGS_GG_4][0] = ghg4.at(ic).first; mela.selfDHggcoupl[0][gHIGGS_GG_4][1] = ghg4.at(ic).second;
+        float prob=0;
+        mela.computeProdP(prob, false);
+        timer.Stop();
+        (useCache ? probCached : probUncached).push_back(prob);
+      }
+      const TUtil::HJJChannelCacheStatistics statsAfterScan = mela.getHJJChannelCacheStatistics();
+      (useCache ? nEvaluationsCached : nEvaluationsUncached) = statsAfterScan.nAmplitudeEvaluations - statsBeforeScan.nAmplitudeEvaluations;
+      (useCache ? nHitsCached : nHitsUncached) = statsAfterScan.nHits - statsBeforeScan.nHits;
+    }
+    mela.resetInputEvent();
+
+    for (unsigned int ic=0; ic<nCouplings; ic++){
+      status.check(probUncached.at(ic)>0.f, Form("Event %u, couplings %u: ME with the cache off is %g", ev, ic, probUncached.at(ic)));
+      status.checkClose(probCached.at(ic), probUncached.at(ic), tolerance, Form("Event %u, couplings %u", ev, ic));
+    }
+    status.check(nHitsUncached==0, Form("Event %u: The cache is off, but has %llu hits", ev, nHitsUncached));
+    status.check(nCouplings<2 || nHitsCached>0, Form("Event %u: The scan over the couplings never hit the cache", ev));
+    // A, B, Re C and Im C of each channel
+    const unsigned long long nEvaluationsPerComputation = nEvaluationsUncached/nCouplings;
+    status.check(
+      nEvaluationsCached<=4*nEvaluationsPerComputation,
+      Form("Event %u: The cached scan took %llu amplitude evaluations, more than 4x the %llu of one computation with the cache off", ev, nEvaluationsCached, nEvaluationsPerComputation)
+    );
+    nEvaluationsTotal[0] += nEvaluationsUncached;
+    nEvaluationsTotal[1] += nEvaluationsCached;
+  }
+  mela.setHJJChannelCaching(true);
+
+  TUtil::HJJChannelCacheStatistics stats = mela.getHJJChannelCacheStatistics();
+  cout << "testME_HJJChannelCache: Timing per event for " << nCouplings << " sets of Hgg couplings" << endl;
+  cout << "\tCache off: " << timerUncached.CpuTime()/double(nEvents)*1e3 << " ms, " << nEvaluationsTotal[0] << " amplitude evaluations" << endl;
+  cout << "\tCached channels: " << timerCached.CpuTime()/double(nEvents)*1e3 << " ms, " << nEvaluationsTotal[1] << " amplitude evaluations" << endl;
+  cout << "testME_HJJChannelCache: Channel hit rate " << stats.getHitRate() << endl;
+  return status.finish();
+}
@@ -0,0 +1,309 @@
+// Agreement and timing of the integration over the unknown jet pseudorapidity in single-jet JJVBF probabilities (Mela::getPAux).
+// 1) MelaJetEtaIntegrator is compared to the previous implementation with TGraph/TSpline3 on analytic integrands.
+// 2) Single-jet events, made of the four leptons of the first entries of l1_array...l4_array in testME_v2.c and a random jet,
+//    are computed with HSMHiggs and with the equivalent self-defined couplings, which are set only once per integration.
+//    The HSMHiggs probabilities are also compared to the previous implementation, with the JJVBF MEs of the grid points
+//    computed from two-jet events.
+// 3) The same events with a non-default renormalization/factorization scale scheme. The scheme applies to the main probability
+//    only, the grid points use the default scales as in the previous implementation. The difference to the scheme applied at
+//    every grid point is printed, not checked.
+// All integrals and probabilities have to be positive and agree within the given tolerance.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_JVBFEtaIntegration.c+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "MelaJetEtaIntegrator.h"
+#include "TGraph.h"
+#include "TSpline.h"
+#include "TStopwatch.h"
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+namespace{
+  class EtaIntegrand{
+  public:
+    virtual ~EtaIntegrand(){}
+    virtual float operator()(double eta)=0;
+  };
+
+  // Smooth bump in [center-width, center+width], modulated to require refinements
+  double testIntegrand(double eta, double center, double width){
+    double u = (eta-center)/width;
+    if (fabs(u)>=1.) return 0;
+    return pow(1.-u*u, 2)*(1.+0.5*u*sin(2.*eta));
+  }
+  class AnalyticIntegrand : public EtaIntegrand{
+  public:
+    double center;
+    double width;
+    AnalyticIntegrand(double center_, double width_) : center(center_), width(width_){}
+    float operator()(double eta){ return (float)testIntegrand(eta, center, width); }
+  };
+
+  // Scale scheme used in 3), with the scale factors it is set with
+  const TVar::EventScaleScheme testScaleScheme = TVar::Fixed_mW;
+  const double testScaleFactor = 1.;
+  void setScaleScheme(Mela& mela, TVar::EventScaleScheme scheme){
+    if (scheme!=TVar::DefaultScaleScheme) mela.setRenFacScaleMode(scheme, scheme, testScaleFactor, testScaleFactor);
+  }
+
+  // JJVBF ME of the event with the known jet and the unknown one at the given momentum
+  float computeTwoJetProb(Mela& mela, SimpleParticleCollection_t& daughters, const TLorentzVector& jet1, const TLorentzVector& jet2, TVar::EventScaleScheme scheme=TVar::DefaultScaleScheme){
+    SimpleParticleCollection_t associated;
+    associated.push_back(SimpleParticle_t(0, jet1));
+    associated.push_back(SimpleParticle_t(0, jet2));
+    mela.setInputEvent(&daughters, &associated, (SimpleParticleCollection_t*)0, false);
+    mela.setProcess(TVar::HSMHiggs, TVar::JHUGen, TVar::JJVBF);
+    setScaleScheme(mela, scheme);
+    float prob=0;
+    mela.computeProdP(prob, false);
+    mela.resetInputEvent();
+    return prob;
+  }
+  // The unknown jet at pseudorapidity eta, as in the previous implementation in Mela::computeProdP
+  class JVBFIntegrand : public EtaIntegrand{
+  public:
+    Mela& mela;
+    SimpleParticleCollection_t& daughters;
+    TLorentzVector higgs;
+    TLorentzVector jet1massless;
+    TLorentzVector jet2massless;
+    double threshold;
+    TVar::EventScaleScheme scheme;
+    JVBFIntegrand(Mela& mela_, SimpleParticleCollection_t& daughters_, const TLorentzVector& higgs_, const TLorentzVector& jet1massless_, const TLorentzVector& jet2massless_, double threshold_, TVar::EventScaleScheme scheme_=TVar::DefaultScaleScheme) :
+      mela(mela_), daughters(daughters_), higgs(higgs_), jet1massless(jet1massless_), jet2massless(jet2massless_), threshold(threshold_), scheme(scheme_)
+    {}
+    float operator()(double eta){
+      TLorentzVector fakeJet(jet2massless.X(), jet2massless.Y(), jet2massless.Pt()*TMath::SinH(eta), 0);
+      fakeJet.SetT(fakeJet.P());
+      TLorentzVector pTotal = higgs+jet1massless+fakeJet;
+      if (fabs((pTotal.T()+fabs(pTotal.Z()))/2.)>=threshold) return 0; // Skip case with invalid pz
+      return computeTwoJetProb(mela, daughters, jet1massless, fakeJet, scheme);
+    }
+  };
+
+  // Known and fake jets and the eta range of the previous implementation
+  void getLegacyJets(const TLorentzVector& pJet, const TLorentzVector& higgs, double threshold, TLorentzVector& jet1massless, TLorentzVector& jet2massless, double& eta_max){
+    TUtil::scaleMomentumToEnergy(pJet, jet1massless);
+    TUtil::computeFakeJet(jet1massless, higgs, jet2massless);
+    double sysZ = (higgs+jet1massless+jet2massless).Z();
+    if (fabs(sysZ)>threshold){
+      double maxpz2 = threshold - higgs.Z() - jet1massless.Z();
+      if (fabs(maxpz2)>0.){
+        double ratio = jet2massless.Z()/maxpz2;
+        jet2massless.SetXYZT(jet2massless.X(), jet2massless.Y(), jet2massless.Z()*ratio, sqrt(pow(jet2massless.Pt(), 2)+pow(jet2massless.Z()*ratio, 2)));
+      }
+      else jet2massless.SetXYZT(jet2massless.X(), jet2massless.Y(), 0., jet2massless.Pt());
+    }
+    eta_max = 10;
+    if (jet2massless.Pt()>0.) eta_max = max(eta_max, 1.2*fabs(jet2massless.Eta()));
+  }
+
+  // Previous implementation in Mela::computeProdP
+  float legacyIntegral(EtaIntegrand& integrand, double eta_min, double eta_max, int& nGrid){
+    nGrid=11;
+    std::vector<double> etaArray;
+    std::vector<double> pArray;
+    for (int iter=0; iter<nGrid; iter++){
+      double jet2temp_eta = ((double)iter)*(eta_max-eta_min) / (((double)nGrid) - 1.) + eta_min;
+      etaArray.push_back(jet2temp_eta);
+      pArray.push_back((double)integrand(jet2temp_eta));
+    }
+    const double grid_precision = 0.15;
+    for (int iG=0; iG<nGrid-1; iG++){
+      if (pArray[iG]==pArray[iG+1]) continue;
+      if (etaArray[iG]==etaArray[iG+1]) continue;
+      double* xGrid = new double[nGrid];
+      double* yGrid = new double[nGrid];
+      for (int iter=0; iter<nGrid; iter++){ xGrid[iter] = etaArray[iter]; yGrid[iter] = pArray[iter]; }
+      TGraph* interpolator = new TGraph(nGrid, xGrid, yGrid);
+      double derivative_first = (yGrid[1]-yGrid[0])/(xGrid[1]-xGrid[0]);
+      double derivative_last = (yGrid[nGrid-1]-yGrid[nGrid-2])/(xGrid[nGrid-1]-xGrid[nGrid-2]);
+      TSpline3* spline = new TSpline3("spline", interpolator, "b1e1", derivative_first, derivative_last);
+      double x_middle = (xGrid[iG]+xGrid[iG+1])*0.5;
+      double y_middle = (yGrid[iG]+yGrid[iG+1])*0.5;
+      double y_sp = spline->Eval(x_middle);
+      if (y_sp<0) y_sp = 0;
+      etaArray.insert(etaArray.begin()+iG+1, x_middle);
+      if (fabs(y_sp-y_middle)<grid_precision*fabs(y_middle) || fabs(xGrid[iG+1]-xGrid[iG])<1e-3){
+        pArray.insert(pArray.begin()+iG+1, y_sp);
+        iG++;
+      }
+      else{
+        pArray.insert(pArray.begin()+iG+1, (double)integrand(x_middle));
+        iG--;
+      }
+      nGrid++;
+      delete spline;
+      delete interpolator;
+      delete[] xGrid;
+      delete[] yGrid;
+    }
+
+    float result = 0;
+    int iGFirst=0, iGLast=nGrid-1;
+    for (int iG=1; iG<nGrid; iG++){ if (pArray[iG]>0 && pArray[iG-1]==0){ iGFirst = iG-1; break; } }
+    for (int iG=nGrid-2; iG>=0; iG--){ if (pArray[iG]>0 && pArray[iG+1]==0){ iGLast = iG+1; break; } }
+    double dEtaGrid = etaArray[iGLast] - etaArray[iGFirst];
+    for (int iG=iGFirst; iG<iGLast-1; iG++) result += (float)((pArray[iG]+pArray[iG+1])*0.5*(etaArray[iG+1] - etaArray[iG])/dEtaGrid);
+    return result;
+  }
+
+  float newIntegral(MelaJetEtaIntegrator& integrator, EtaIntegrand& integrand, double eta_min, double eta_max, int& nGrid){
+    integrator.initialize(eta_min, eta_max, 11);
+    double eta=0;
+    while (integrator.nextPoint(eta)) integrator.setValue(integrand(eta));
+    nGrid = integrator.getNPoints();
+    return integrator.integrate();
+  }
+}
+
+
+int testME_JVBFEtaIntegration(unsigned int nFunctions=200, unsigned int nEvents=20, double tolerance=1e-4){
+  TRandom3 rand(12345);
+  TestStatus status("testME_JVBFEtaIntegration");
+
+  // 1) Analytic integrands
+  {
+    MelaJetEtaIntegrator integrator;
+    TStopwatch timerLegacy, timerNew;
+    timerLegacy.Stop(); timerLegacy.Reset();
+    timerNew.Stop(); timerNew.Reset();
+    unsigned int nDifferentGrids=0;
+    for (unsigned int ifcn=0; ifcn<nFunctions; ifcn++){
+      double center = rand.Uniform(-3., 3.);
+      double width = rand.Uniform(2., 7.);
+      double eta_max = 10;
+      double eta_min = -eta_max;
+
+      AnalyticIntegrand integrand(center, width);
+      int nGridLegacy=0, nGridNew=0;
+      timerLegacy.Start(false);
+      float resLegacy = legacyIntegral(integrand, eta_min, eta_max, nGridLegacy);
+      timerLegacy.Stop();
+      timerNew.Start(false);
+      float resNew = newIntegral(integrator, integrand, eta_min, eta_max, nGridNew);
+      timerNew.Stop();
+
+      if (nGridLegacy!=nGridNew) nDifferentGrids++;
+      status.check(resLegacy>0.f, Form("Function %u: Integral with TGraph/TSpline3 is %g", ifcn, resLegacy));
+      status.checkClose(resNew, resLegacy, tolerance, Form("Function %u with %i instead of %i points", ifcn, nGridNew, nGridLegacy));
+    }
+    cout << "testME_JVBFEtaIntegration: Analytic integrands, timing per integral without the integrand evaluations" << endl;
+    cout << "\tTGraph/TSpline3: " << timerLegacy.CpuTime()/double(nFunctions)*1e6 << " us" << endl;
+    cout << "\tMelaJetEtaIntegrator: " << timerNew.CpuTime()/double(nFunctions)*1e6 << " us" << endl;
+    cout << "testME_JVBFEtaIntegration: " << nDifferentGrids << "/" << nFunctions << " grids differ in size" << endl;
+  }
+
+  // 2) Single-jet JJVBF events
+  {
+    int erg_tev=13;
+    float mPOLE=125.;
+    TVar::VerbosityLevel verbosity = TVar::ERROR;
+    Mela mela(erg_tev, mPOLE, verbosity);
+    mela.setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+
+    const double threshold = 1000.*erg_tev/2.;
+
+    TStopwatch timerSM, timerSelfD;
+    timerSM.Stop(); timerSM.Reset();
+    timerSelfD.Stop(); timerSelfD.Reset();
+    for (unsigned int ev=0; ev<nEvents; ev++){
+      SimpleParticleCollection_t daughters = getLeptons(ids_2e2mu);
+      SimpleParticleCollection_t associated = getRandomJets(rand, 1);
+      const TLorentzVector& pJet = associated.front().second;
+      mela.setInputEvent(&daughters, &associated, (SimpleParticleCollection_t*)0, false);
+
+      float probSM=0, pAuxSM=0, probSelfD=0, pAuxSelfD=0;
+      timerSM.Start(false);
+      mela.setProcess(TVar::HSMHiggs, TVar::JHUGen, TVar::JJVBF);
+      mela.computeProdP(probSM, false);
+      mela.getPAux(pAuxSM);
+      timerSM.Stop();
+
+      timerSelfD.Start(false);
+      mela.setProcess(TVar::SelfDefine_spin0, TVar::JHUGen, TVar::JJVBF);
+      mela.selfDHzzcoupl[0][gHIGGS_VV_1][0]=1.;
+      mela.selfDHwwcoupl[0][gHIGGS_VV_1][0]=1.;
+      mela.computeProdP(probSelfD, false);
+      mela.getPAux(pAuxSelfD);
+      timerSelfD.Stop();
+      TLorentzVector higgs = mela.getCurrentCandidate()->p4;
+      mela.resetInputEvent();
+
+      status.check(probSM>0.f && pAuxSM>0.f, Form("Event %u: HSMHiggs prob, pAux = %g, %g", ev, probSM, pAuxSM));
+      status.checkClose(probSelfD, probSM, tolerance, Form("Event %u: Self-defined couplings vs HSMHiggs, prob", ev));
+      status.checkClose(pAuxSelfD, pAuxSM, tolerance, Form("Event %u: Self-defined couplings vs HSMHiggs, pAux", ev));
+
+      // Previous implementation: the same fake jet and eta range, with the MEs of two-jet events
+      TLorentzVector jet1massless, jet2massless;
+      double eta_max;
+      getLegacyJets(pJet, higgs, threshold, jet1massless, jet2massless, eta_max);
+
+      float probLegacy = computeTwoJetProb(mela, daughters, jet1massless, jet2massless);
+      JVBFIntegrand integrand(mela, daughters, higgs, jet1massless, jet2massless, threshold);
+      int nGridLegacy=0;
+      float pAuxLegacy = legacyIntegral(integrand, -eta_max, eta_max, nGridLegacy);
+      if (fabs(probLegacy)>0) pAuxLegacy /= probLegacy;
+
+      status.checkClose(probSM, probLegacy, tolerance, Form("Event %u: HSMHiggs vs the previous implementation, prob", ev));
+      status.checkClose(pAuxSM, pAuxLegacy, tolerance, Form("Event %u: HSMHiggs vs the previous implementation (%i points), pAux", ev, nGridLegacy));
+    }
+    cout << "testME_JVBFEtaIntegration: Single-jet JJVBF, timing per event including the eta integration" << endl;
+    cout << "\tHSMHiggs: " << timerSM.CpuTime()/double(nEvents)*1e3 << " ms" << endl;
+    cout << "\tSelfDefine_spin0: " << timerSelfD.CpuTime()/double(nEvents)*1e3 << " ms" << endl;
+  }
+
+  // 3) Single-jet JJVBF events with a non-default scale scheme
+  {
+    int erg_tev=13;
+    float mPOLE=125.;
+    TVar::VerbosityLevel verbosity = TVar::ERROR;
+    Mela mela(erg_tev, mPOLE, verbosity);
+    mela.setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+
+    const double threshold = 1000.*erg_tev/2.;
+
+    double sumRelDiffAllPoints=0;
+    for (unsigned int ev=0; ev<nEvents; ev++){
+      SimpleParticleCollection_t daughters = getLeptons(ids_2e2mu);
+      SimpleParticleCollection_t associated = getRandomJets(rand, 1);
+      const TLorentzVector& pJet = associated.front().second;
+      mela.setInputEvent(&daughters, &associated, (SimpleParticleCollection_t*)0, false);
+
+      float prob=0, pAux=0, probDefault=0;
+      mela.setProcess(TVar::HSMHiggs, TVar::JHUGen, TVar::JJVBF);
+      mela.computeProdP(probDefault, false);
+      setScaleScheme(mela, testScaleScheme);
+      mela.computeProdP(prob, false);
+      mela.getPAux(pAux);
+      TLorentzVector higgs = mela.getCurrentCandidate()->p4;
+      mela.resetInputEvent();
+
+      status.check(prob>0.f && pAux>0.f, Form("Event %u: prob, pAux with scale scheme %i = %g, %g", ev, (int) testScaleScheme, prob, pAux));
+      status.check(prob!=probDefault, Form("Event %u: Scale scheme %i does not change prob = %g", ev, (int) testScaleScheme, prob));
+
+      TLorentzVector jet1massless, jet2massless;
+      double eta_max;
+      getLegacyJets(pJet, higgs, threshold, jet1massless, jet2massless, eta_max);
+
+      float probLegacy = computeTwoJetProb(mela, daughters, jet1massless, jet2massless, testScaleScheme);
+      JVBFIntegrand integrand(mela, daughters, higgs, jet1massless, jet2massless, threshold);
+      JVBFIntegrand integrandAllPoints(mela, daughters, higgs, jet1massless, jet2massless, threshold, testScaleScheme);
+      int nGridLegacy=0, nGridAllPoints=0;
+      float pAuxLegacy = legacyIntegral(integrand, -eta_max, eta_max, nGridLegacy);
+      float pAuxAllPoints = legacyIntegral(integrandAllPoints, -eta_max, eta_max, nGridAllPoints);
+      if (fabs(probLegacy)>0){ pAuxLegacy /= probLegacy; pAuxAllPoints /= probLegacy; }
+
+      status.checkClose(prob, probLegacy, tolerance, Form("Event %u: Scale scheme %i vs the previous implementation, prob", ev, (int) testScaleScheme));
+      status.checkClose(pAux, pAuxLegacy, tolerance, Form("Event %u: Scale scheme %i vs the previous implementation (%i points), pAux", ev, (int) testScaleScheme, nGridLegacy));
+      if (pAux>0.f) sumRelDiffAllPoints += fabs(pAuxAllPoints/pAux-1.);
+    }
+    cout << "testME_JVBFEtaIntegration: Scale scheme " << (int) testScaleScheme << " at the grid points too would change pAux by " << sumRelDiffAllPoints/double(nEvents) << " on average" << endl;
+  }
+  return status.finish();
+}
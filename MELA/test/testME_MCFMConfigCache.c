@@ -0,0 +1,219 @@
+// Consistency of the MCFM configuration cache: the same sequence of MCFM MEs is computed with the cache switched off and on,
+// and the MCFM commons set by MCFM_chooser and MCFM_SetupParticleCouplings, as well as the MEs, are compared after each computation.
+// With the cache on, every event after the first one has to reuse the stored configurations, i.e. give hits and no misses.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_MCFMConfigCache.c+
+#include <iostream>
+#include <cstring>
+#include <vector>
+#include "TMCFM.hh"
+#include "TStopwatch.h"
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+namespace{
+  struct MCFMConfigState{
+    int npart;
+    char runstring[30];
+    int nqcdjets;
+    int nwz;
+    int ndim;
+    int n2, n3;
+    double mass2, width2, mass3, width3;
+    bool srdiags;
+    double vsymfact;
+    bool interference;
+    bool Qflag, Gflag, QandGflag;
+    int nuflav;
+    int lastphot;
+    int channeltoggle_stu, vvhvvtoggle_vbfvh;
+    double q1, l1, r1, q2, l2, r2;
+    char plabel[mxpart][2];
+  };
+  MCFMConfigState getMCFMConfigState(){
+    MCFMConfigState state;
+    state.npart=npart_.npart;
+    memcpy(state.runstring, runstring_.runstring, sizeof(state.runstring));
+    state.nqcdjets=nqcdjets_.nqcdjets;
+    state.nwz=nwz_.nwz;
+    state.ndim=bveg1_mcfm_.ndim;
+    state.n2=breit_.n2; state.n3=breit_.n3;
+    state.mass2=breit_.mass2; state.width2=breit_.width2;
+    state.mass3=breit_.mass3; state.width3=breit_.width3;
+    state.srdiags=srdiags_.srdiags;
+    state.vsymfact=vsymfact_.vsymfact;
+    state.interference=interference_.interference;
+    state.Qflag=flags_.Qflag; state.Gflag=flags_.Gflag; state.QandGflag=flags_.QandGflag;
+    state.nuflav=nuflav_.nuflav;
+    state.lastphot=lastphot_.lastphot;
+    state.channeltoggle_stu=spinzerohiggs_anomcoupl_.channeltoggle_stu;
+    state.vvhvvtoggle_vbfvh=spinzerohiggs_anomcoupl_.vvhvvtoggle_vbfvh;
+    state.q1=zcouple_.q1; state.l1=zcouple_.l1; state.r1=zcouple_.r1;
+    state.q2=zcouple_.q2; state.l2=zcouple_.l2; state.r2=zcouple_.r2;
+    memcpy(state.plabel, plabel_.plabel, sizeof(state.plabel));
+    return state;
+  }
+  bool isSameMCFMConfigState(const MCFMConfigState& s1, const MCFMConfigState& s2){
+    return (
+      s1.npart==s2.npart && strncmp(s1.runstring, s2.runstring, sizeof(s1.runstring))==0
+      && s1.nqcdjets==s2.nqcdjets && s1.nwz==s2.nwz && s1.ndim==s2.ndim
+      && s1.n2==s2.n2 && s1.n3==s2.n3
+      && s1.mass2==s2.mass2 && s1.width2==s2.width2 && s1.mass3==s2.mass3 && s1.width3==s2.width3
+      && s1.srdiags==s2.srdiags && s1.vsymfact==s2.vsymfact && s1.interference==s2.interference
+      && s1.Qflag==s2.Qflag && s1.Gflag==s2.Gflag && s1.QandGflag==s2.QandGflag
+      && s1.nuflav==s2.nuflav && s1.lastphot==s2.lastphot
+      && s1.channeltoggle_stu==s2.channeltoggle_stu && s1.vvhvvtoggle_vbfvh==s2.vvhvvtoggle_vbfvh
+      && s1.q1==s2.q1 && s1.l1==s2.l1 && s1.r1==s2.r1 && s1.q2==s2.q2 && s1.l2==s2.l2 && s1.r2==s2.r2
+      && memcmp(s1.plabel, s2.plabel, sizeof(s1.plabel))==0
+      );
+  }
+
+  struct MCFMHypothesis{
+    int cindex;
+    TVar::Process proc;
+    TVar::Production prod;
+    TVar::LeptonInterference interf;
+  };
+  bool isProductionHypothesis(const MCFMHypothesis& hypo){
+    return !(hypo.prod==TVar::ZZGG || hypo.prod==TVar::ZZQQB || hypo.prod==TVar::ZZINDEPENDENT || (hypo.prod==TVar::JJQCD && hypo.proc==TVar::bkgZJets));
+  }
+}
+
+
+int testME_MCFMConfigCache(unsigned int nEvents=5){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+  TestStatus status("testME_MCFMConfigCache");
+
+  // Candidates: 0: 2e2mu+jj, 1: 4e, 2: WW+jj, 3: Z+photon, 4: Z+qq, 5: 2e2mu+ee, 6: 2e2mu+enu, 7: 2e2mu+ud
+  const int nCandidates=8;
+  const int idDaughters[nCandidates][4] ={
+    { 13, -13, 11, -11 }, { 11, -11, 11, -11 }, { 11, -12, -11, 12 }, { 13, -13, 22, 0 },
+    { 13, -13, 1, -1 }, { 13, -13, 11, -11 }, { 13, -13, 11, -11 }, { 13, -13, 11, -11 }
+  };
+  const int idAssociated[nCandidates][2] ={
+    { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 },
+    { 0, 0 }, { 11, -11 }, { 11, -12 }, { 2, -1 }
+  };
+  const bool hasAssociated[nCandidates] ={ true, false, true, false, false, true, true, true };
+
+  const MCFMHypothesis hypotheses[] ={
+    { 0, TVar::bkgZZ, TVar::ZZQQB, TVar::DefaultLeptonInterf },
+    { 0, TVar::bkgZZ, TVar::ZZINDEPENDENT, TVar::DefaultLeptonInterf },
+    { 0, TVar::bkgZZ, TVar::ZZGG, TVar::DefaultLeptonInterf },
+    { 0, TVar::HSMHiggs, TVar::ZZGG, TVar::DefaultLeptonInterf },
+    { 0, TVar::bkgZZ_SMHiggs, TVar::ZZGG, TVar::DefaultLeptonInterf },
+    { 0, TVar::HSMHiggs_WWZZ, TVar::ZZGG, TVar::DefaultLeptonInterf },
+    { 0, TVar::bkgWWZZ, TVar::ZZGG, TVar::DefaultLeptonInterf },
+    { 1, TVar::bkgZZ, TVar::ZZQQB, TVar::InterfOn },
+    { 1, TVar::bkgZZ, TVar::ZZQQB, TVar::InterfOff },
+    { 1, TVar::HSMHiggs, TVar::ZZGG, TVar::InterfOn },
+    { 2, TVar::bkgWW, TVar::ZZQQB, TVar::DefaultLeptonInterf },
+    { 2, TVar::bkgWW, TVar::ZZGG, TVar::DefaultLeptonInterf },
+    { 2, TVar::HSMHiggs, TVar::ZZGG, TVar::DefaultLeptonInterf },
+    { 2, TVar::bkgWWZZ_SMHiggs, TVar::ZZGG, TVar::DefaultLeptonInterf },
+    { 3, TVar::bkgZGamma, TVar::ZZQQB, TVar::DefaultLeptonInterf },
+    { 4, TVar::bkgZJets, TVar::JJQCD, TVar::DefaultLeptonInterf },
+    { 0, TVar::HSMHiggs, TVar::JJVBF, TVar::DefaultLeptonInterf },
+    { 0, TVar::bkgZZ, TVar::JJVBF, TVar::DefaultLeptonInterf },
+    { 0, TVar::bkgZZ_SMHiggs, TVar::JJEW, TVar::DefaultLeptonInterf },
+    { 0, TVar::bkgZZ, TVar::JJQCD, TVar::DefaultLeptonInterf },
+    { 0, TVar::bkgZZ, TVar::JJEWQCD, TVar::DefaultLeptonInterf },
+    { 0, TVar::HSMHiggs, TVar::Had_ZH, TVar::DefaultLeptonInterf },
+    { 0, TVar::HSMHiggs, TVar::Had_WH, TVar::DefaultLeptonInterf },
+    { 2, TVar::HSMHiggs, TVar::JJVBF, TVar::DefaultLeptonInterf },
+    { 2, TVar::bkgWW, TVar::JJQCD, TVar::DefaultLeptonInterf },
+    { 5, TVar::HSMHiggs, TVar::Lep_ZH, TVar::DefaultLeptonInterf },
+    { 6, TVar::HSMHiggs, TVar::Lep_WH, TVar::DefaultLeptonInterf },
+    { 7, TVar::HSMHiggs, TVar::Had_WH, TVar::DefaultLeptonInterf }
+  };
+  const unsigned int nHypotheses = sizeof(hypotheses)/sizeof(MCFMHypothesis);
+
+  vector<MCFMConfigState> statesRef, statesCached;
+  vector<float> probRef, probCached;
+  TStopwatch timerRef, timerCached;
+  timerRef.Stop(); timerRef.Reset();
+  timerCached.Stop(); timerCached.Reset();
+  for (int useCache=0; useCache<2; useCache++){
+    mela.setMCFMConfigCaching(useCache==1);
+    mela.resetMCFMConfigCacheStatistics();
+    vector<MCFMConfigState>& states = (useCache==1 ? statesCached : statesRef);
+    vector<float>& probs = (useCache==1 ? probCached : probRef);
+    TStopwatch& timer = (useCache==1 ? timerCached : timerRef);
+
+    TRandom3 rand(12345);
+    for (unsigned int ev=0; ev<nEvents; ev++){
+      const TUtil::MCFMConfigCacheStatistics statsBefore = mela.getMCFMConfigCacheStatistics();
+      // Only the momenta are taken from these, the ids come from idDaughters and idAssociated
+      const SimpleParticleCollection_t leptons = getLeptons(ids_2e2mu, &rand);
+      const SimpleParticleCollection_t jets = getRandomJets(rand);
+      TLorentzVector pDaughters[4];
+      for (unsigned int idau=0; idau<4; idau++) pDaughters[idau] = leptons.at(idau).second;
+      TLorentzVector pAssociated[2];
+      for (unsigned int iap=0; iap<2; iap++) pAssociated[iap] = jets.at(iap).second;
+
+      for (int ic=0; ic<nCandidates; ic++){
+        SimpleParticleCollection_t daughters;
+        if (idDaughters[ic][2]==22){
+          daughters.push_back(SimpleParticle_t(idDaughters[ic][0], pDaughters[0]));
+          daughters.push_back(SimpleParticle_t(idDaughters[ic][1], pDaughters[1]));
+          daughters.push_back(SimpleParticle_t(22, pDaughters[2]+pDaughters[3]));
+        }
+        else{ for (unsigned int idau=0; idau<4; idau++) daughters.push_back(SimpleParticle_t(idDaughters[ic][idau], pDaughters[idau])); }
+        SimpleParticleCollection_t associated;
+        for (unsigned int iap=0; iap<2; iap++) associated.push_back(SimpleParticle_t(idAssociated[ic][iap], pAssociated[iap]));
+        mela.setCandidateDecayMode(ic==2 ? TVar::CandidateDecay_WW : TVar::CandidateDecay_ZZ);
+        mela.setInputEvent(&daughters, (hasAssociated[ic] ? &associated : 0), (SimpleParticleCollection_t*)0, false);
+      }
+
+      for (unsigned int ih=0; ih<nHypotheses; ih++){
+        const MCFMHypothesis& hypo = hypotheses[ih];
+        mela.setCurrentCandidateFromIndex(hypo.cindex);
+        mela.setProcess(hypo.proc, TVar::MCFM, hypo.prod);
+        mela.setMelaLeptonInterference(hypo.interf);
+        float prob=0;
+        timer.Start(false);
+        if (isProductionHypothesis(hypo)) mela.computeProdDecP(prob, false);
+        else mela.computeP(prob, false);
+        timer.Stop();
+        probs.push_back(prob);
+        states.push_back(getMCFMConfigState());
+      }
+      mela.resetInputEvent();
+
+      const TUtil::MCFMConfigCacheStatistics statsAfter = mela.getMCFMConfigCacheStatistics();
+      const unsigned long long nHits = statsAfter.nHits-statsBefore.nHits;
+      const unsigned long long nMisses = statsAfter.nMisses-statsBefore.nMisses;
+      if (useCache==0) status.check(nHits==0, Form("Event %u: The cache is off, but has %llu hits", ev, nHits));
+      else if (ev>0) status.check(nHits>0 && nMisses==0, Form("Event %u: %llu hits and %llu misses with the cache on", ev, nHits, nMisses));
+    }
+
+    if (useCache==1){
+      TUtil::MCFMConfigCacheStatistics stats = mela.getMCFMConfigCacheStatistics();
+      cout << "testME_MCFMConfigCache: " << stats.nHits << " hits, " << stats.nMisses << " misses, hit rate " << stats.getHitRate() << endl;
+    }
+  }
+  mela.setMCFMConfigCaching(true);
+
+  for (unsigned int is=0; is<statesRef.size(); is++){
+    const MCFMHypothesis& hypo = hypotheses[is%nHypotheses];
+    TString what = Form(
+      "Event %u, %s (%s) on candidate %i",
+      is/nHypotheses, TVar::ProcessName(hypo.proc).Data(), TVar::ProductionName(hypo.prod).Data(), hypo.cindex
+    );
+    status.check(
+      isSameMCFMConfigState(statesRef.at(is), statesCached.at(is)),
+      Form("%s: The MCFM configuration differs, runstring %.30s instead of %.30s", what.Data(), statesCached.at(is).runstring, statesRef.at(is).runstring)
+    );
+    status.checkClose(probCached.at(is), probRef.at(is), 0, what.Data());
+  }
+  cout << "testME_MCFMConfigCache: Timing per ME over " << nEvents << " events and " << nHypotheses << " hypotheses" << endl;
+  cout << "\tWithout cache: " << timerRef.CpuTime()/double(statesRef.size())*1e6 << " us" << endl;
+  cout << "\tWith cache: " << timerCached.CpuTime()/double(statesCached.size())*1e6 << " us" << endl;
+  return status.finish();
+}
@@ -0,0 +1,77 @@
+// Consistency of Mela::computeP_multi with the individual compute functions over several events.
+// Each event is set with setInputEvent and cleared with resetInputEvent, so the candidates of later events reuse the addresses of earlier ones.
+// The test requires that this recycling happens, since the per-event work shared by computeP_multi must not be matched by the address alone.
+// The MCFM ZZINDEPENDENT hypothesis also recycles one scratch candidate over all points of its angular integration.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_Multi.c+
+#include <iostream>
+#include <vector>
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+namespace{
+  void setSelfDCouplings(Mela& mela){
+    mela.selfDHggcoupl[0][gHIGGS_GG_2][0]=1.0;
+    mela.selfDHzzcoupl[0][gHIGGS_VV_1][0]=1.0;
+    mela.selfDHzzcoupl[0][gHIGGS_VV_4][0]=0.5;
+    mela.selfDHwwcoupl[0][gHIGGS_VV_1][0]=1.0;
+    mela.selfDHwwcoupl[0][gHIGGS_VV_4][0]=0.5;
+  }
+}
+
+
+int testME_Multi(unsigned int nEvents=20){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+  mela.setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+  TestStatus status("testME_Multi");
+
+  vector<TestHypothesis> hypotheses;
+  hypotheses.push_back(TestHypothesis("JHUGen gg->H->ZZ", TVar::HSMHiggs, TVar::JHUGen, TVar::ZZGG));
+  hypotheses.push_back(TestHypothesis("MCFM gg->H->ZZ", TVar::HSMHiggs, TVar::MCFM, TVar::ZZGG));
+  hypotheses.push_back(TestHypothesis("MCFM qq->ZZ", TVar::bkgZZ, TVar::MCFM, TVar::ZZQQB));
+  hypotheses.push_back(TestHypothesis("MCFM ZZINDEPENDENT qq->ZZ", TVar::bkgZZ, TVar::MCFM, TVar::ZZINDEPENDENT));
+  hypotheses.push_back(TestHypothesis("JHUGen VBF", TVar::HSMHiggs, TVar::JHUGen, TVar::JJVBF, Mela::Hypothesis::kComputeProdP));
+  hypotheses.push_back(TestHypothesis("JHUGen H+jj", TVar::HSMHiggs, TVar::JHUGen, TVar::JJQCD, Mela::Hypothesis::kComputeProdP));
+  hypotheses.push_back(TestHypothesis("JHUGen ZH", TVar::HSMHiggs, TVar::JHUGen, TVar::Had_ZH, Mela::Hypothesis::kComputeProdP_VH));
+  hypotheses.push_back(TestHypothesis("MCFM VBF with decay", TVar::HSMHiggs, TVar::MCFM, TVar::JJVBF, Mela::Hypothesis::kComputeProdDecP));
+  {
+    TestHypothesis hypo("JHUGen VBF with self-defined couplings", TVar::SelfDefine_spin0, TVar::JHUGen, TVar::JJVBF, Mela::Hypothesis::kComputeProdP);
+    setSelfDCouplings(mela);
+    hypo.setCouplings(mela);
+    hypotheses.push_back(hypo);
+  }
+  mela.reset_SelfDCouplings();
+  vector<Mela::Hypothesis> melaHypotheses(hypotheses.begin(), hypotheses.end());
+
+  unsigned int nRecycled=0;
+  MELACandidate* prevCand=0;
+  TRandom3 rand(12345);
+  for (unsigned int ev=0; ev<nEvents; ev++){
+    SimpleParticleCollection_t daughters = getLeptons(ids_2e2mu, &rand);
+    SimpleParticleCollection_t associated = getJets(&rand);
+    mela.setInputEvent(&daughters, &associated, (SimpleParticleCollection_t*)0, false);
+    MELACandidate* cand = mela.getCurrentCandidate();
+    if (cand!=0 && cand==prevCand) nRecycled++;
+    prevCand = cand;
+
+    vector<float> probSingle;
+    for (unsigned int ih=0; ih<hypotheses.size(); ih++) probSingle.push_back(hypotheses.at(ih).compute(mela));
+    vector<float> probMulti;
+    mela.computeP_multi(melaHypotheses, probMulti);
+
+    for (unsigned int ih=0; ih<hypotheses.size(); ih++){
+      status.check(probSingle.at(ih)>0.f, Form("Event %u, %s: Individual ME is %g", ev, hypotheses.at(ih).name.c_str(), probSingle.at(ih)));
+      status.checkClose(probMulti.at(ih), probSingle.at(ih), 1e-5, Form("Event %u, %s", ev, hypotheses.at(ih).name.c_str()));
+    }
+    mela.resetInputEvent();
+  }
+  cout << "testME_Multi: The candidate address was recycled in " << nRecycled << "/" << (nEvents>0 ? nEvents-1 : 0) << " events." << endl;
+  status.check(nEvents<2 || nRecycled>0, "No candidate address was recycled, so the matching of the shared work by kinematics is not exercised");
+  return status.finish();
+}
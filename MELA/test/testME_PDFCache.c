@@ -0,0 +1,87 @@
+// Consistency of the PDF and alpha_s caches: MEs that use PDFs are computed with the caches switched off and on, and compared.
+// Two Mela objects with different NNPDF members are alternated, and the member of the first one is changed every event,
+// so that every path that loads a PDF (setLHAgrid and the context switches) has to invalidate the caches.
+// The caches have to be hit when they are on and never when they are off.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_PDFCache.c+
+#include <iostream>
+#include <vector>
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+namespace{
+  void computeHypotheses(Mela& mela, const vector<TestHypothesis>& hypotheses, vector<float>& probs){
+    for (unsigned int ih=0; ih<hypotheses.size(); ih++) probs.push_back(hypotheses.at(ih).compute(mela));
+  }
+}
+
+
+int testME_PDFCache(unsigned int nEvents=10){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela melaA(erg_tev, mPOLE, verbosity);
+  Mela melaB(erg_tev, mPOLE, verbosity);
+  melaA.setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+  melaB.setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+  TestStatus status("testME_PDFCache");
+
+  const string pdfPath = getNNPDFPath();
+  melaB.setLHAgrid(pdfPath.c_str(), 2);
+
+  vector<TestHypothesis> hypotheses;
+  hypotheses.push_back(TestHypothesis("MCFM qq->ZZ", TVar::bkgZZ, TVar::MCFM, TVar::ZZQQB));
+  hypotheses.push_back(TestHypothesis("MCFM gg->H->ZZ", TVar::HSMHiggs, TVar::MCFM, TVar::ZZGG));
+  hypotheses.push_back(TestHypothesis("JHUGen VBF", TVar::HSMHiggs, TVar::JHUGen, TVar::JJVBF, Mela::Hypothesis::kComputeProdP));
+  hypotheses.push_back(TestHypothesis("JHUGen H+jj", TVar::HSMHiggs, TVar::JHUGen, TVar::JJQCD, Mela::Hypothesis::kComputeProdP));
+  const unsigned int nHypotheses = hypotheses.size();
+
+  vector<float> probRef, probCached;
+  for (int useCache=0; useCache<2; useCache++){
+    melaA.setPDFCaching(useCache==1);
+    melaA.resetPDFCacheStatistics();
+    vector<float>& probs = (useCache==1 ? probCached : probRef);
+
+    TRandom3 rand(12345);
+    for (unsigned int ev=0; ev<nEvents; ev++){
+      SimpleParticleCollection_t daughters = getLeptons(ids_2e2mu, &rand);
+      SimpleParticleCollection_t associated = getJets();
+
+      // The same kinematics in both objects, so only the invalidation separates their PDF values
+      melaA.setLHAgrid(pdfPath.c_str(), ev%2);
+      melaA.setInputEvent(&daughters, &associated, (SimpleParticleCollection_t*)0, false);
+      melaB.setInputEvent(&daughters, &associated, (SimpleParticleCollection_t*)0, false);
+      computeHypotheses(melaA, hypotheses, probs);
+      computeHypotheses(melaB, hypotheses, probs);
+      computeHypotheses(melaA, hypotheses, probs);
+      melaA.resetInputEvent();
+      melaB.resetInputEvent();
+    }
+
+    TUtil::PDFCacheStatistics stats = melaA.getPDFCacheStatistics();
+    cout << "testME_PDFCache: Caching " << (useCache==1 ? "on" : "off") << endl;
+    cout << "\tPDF: " << stats.nPDFHits << " hits, " << stats.nPDFMisses << " misses (hit rate " << stats.getPDFHitRate() << ")" << endl;
+    cout << "\talpha_s: " << stats.nAlphaSHits << " hits, " << stats.nAlphaSMisses << " misses (hit rate " << stats.getAlphaSHitRate() << ")" << endl;
+    if (useCache==1){
+      status.check(stats.nPDFHits>0, "The PDF cache is on, but it was never hit");
+      status.check(stats.nAlphaSHits>0, "The alpha_s cache is on, but it was never hit");
+    }
+    else status.check(
+      stats.nPDFHits==0 && stats.nAlphaSHits==0,
+      Form("The caches are off, but have %llu PDF and %llu alpha_s hits", stats.nPDFHits, stats.nAlphaSHits)
+    );
+  }
+  melaA.setPDFCaching(true);
+
+  for (unsigned int is=0; is<probRef.size(); is++){
+    const TestHypothesis& hypo = hypotheses.at(is%nHypotheses);
+    unsigned int iset = (is/nHypotheses)%3;
+    TString what = Form("Event %u, %s Mela object (pass %u), %s", is/(3*nHypotheses), (iset==1 ? "second" : "first"), iset, hypo.name.c_str());
+    status.check(probRef.at(is)>0.f, Form("%s: ME without caching is %g", what.Data(), probRef.at(is)));
+    status.checkClose(probCached.at(is), probRef.at(is), 0, what.Data());
+  }
+  return status.finish();
+}
@@ -0,0 +1,116 @@
+// Sum over the top daughter assignments in the ttH ME, on ttH events with t -> b W, W -> 2 jets, and H -> 2e2mu.
+// The daughters have unknown jet ids, so all 3! assignments of each top are summed, and the ME cannot depend on the order in which they are passed.
+// The test requires this for a permuted order of both tops, and that all 36 assignments are evaluated in every event.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_TTH.c+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "testME_Common.h"
+#include "TStopwatch.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+namespace{
+  // Isotropic two-body decay of mother into daughters of masses m1 and m2
+  void twoBodyDecay(const TLorentzVector& mother, double m1, double m2, TRandom3& rand, TLorentzVector& d1, TLorentzVector& d2){
+    double M = mother.M();
+    double q = sqrt((M*M-pow(m1+m2, 2))*(M*M-pow(m1-m2, 2)))/(2.*M);
+    double x, y, z;
+    rand.Sphere(x, y, z, q);
+    d1.SetXYZM(x, y, z, m1);
+    d2.SetXYZM(-x, -y, -z, m2);
+    d1.Boost(mother.BoostVector());
+    d2.Boost(mother.BoostVector());
+  }
+
+  struct ttHEvent{
+    SimpleParticleCollection_t daughters;
+    SimpleParticleCollection_t topDaughters[2];
+  };
+
+  ttHEvent generateEvent(TRandom3& rand){
+    const double mt=173.2, mW=80.399, gaW=2.085, mH=125., mZ=91.1876;
+    ttHEvent ev;
+
+    TLorentzVector pSystem, pTT, pH, pTop[2];
+    double mTT = 2.*mt+20.+200.*rand.Rndm();
+    double sqrts = mTT+mH+50.+300.*rand.Rndm();
+    pSystem.SetXYZM(0, 0, sqrts*sinh(rand.Uniform(-1., 1.)), sqrts);
+    twoBodyDecay(pSystem, mTT, mH, rand, pTT, pH);
+    twoBodyDecay(pTT, mt, mt, rand, pTop[0], pTop[1]);
+
+    // Daughters are ordered as b, Wf, Wfb, with unknown jet ids so that all assignments are summed
+    for (unsigned int it=0; it<2; it++){
+      double mWstar;
+      do{ mWstar = rand.BreitWigner(mW, gaW); } while (mWstar<=0. || mWstar>=mt);
+      TLorentzVector pb, pW, pf, pfb;
+      twoBodyDecay(pTop[it], 0., mWstar, rand, pb, pW);
+      twoBodyDecay(pW, 0., 0., rand, pf, pfb);
+      ev.topDaughters[it].push_back(SimpleParticle_t(0, pb));
+      ev.topDaughters[it].push_back(SimpleParticle_t(0, pf));
+      ev.topDaughters[it].push_back(SimpleParticle_t(0, pfb));
+    }
+
+    TLorentzVector pZ[2], pl[4];
+    twoBodyDecay(pH, mZ, mH-mZ-5., rand, pZ[0], pZ[1]);
+    twoBodyDecay(pZ[0], 0., 0., rand, pl[0], pl[1]);
+    twoBodyDecay(pZ[1], 0., 0., rand, pl[2], pl[3]);
+    for (unsigned int idau=0; idau<4; idau++) ev.daughters.push_back(SimpleParticle_t(ids_2e2mu[idau], pl[idau]));
+
+    return ev;
+  }
+
+  float computeTTH(Mela& mela, const ttHEvent& event, int topProcess){
+    SimpleParticleCollection_t daughters = event.daughters;
+    SimpleParticleCollection_t topDaughters[2] ={ event.topDaughters[0], event.topDaughters[1] };
+    mela.setInputEvent(&daughters, (SimpleParticleCollection_t*)0, (SimpleParticleCollection_t*)0, false);
+    for (unsigned int it=0; it<2; it++) mela.appendTopCandidate(&(topDaughters[it]));
+    mela.setProcess(TVar::HSMHiggs, TVar::JHUGen, TVar::ttH);
+    float prob=0;
+    mela.computeProdP_ttH(prob, topProcess, 1, false);
+    mela.resetInputEvent();
+    return prob;
+  }
+}
+
+
+int testME_TTH(unsigned int nEvents=100, int topProcess=2){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+  mela.setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+  TestStatus status("testME_TTH");
+
+  TRandom3 rand(12345);
+  vector<ttHEvent> events;
+  for (unsigned int ev=0; ev<nEvents; ev++) events.push_back(generateEvent(rand));
+
+  vector<float> probOrdered;
+  mela.resetTTHPermutationStatistics();
+  TStopwatch timer;
+  timer.Start();
+  for (unsigned int ev=0; ev<nEvents; ev++) probOrdered.push_back(computeTTH(mela, events.at(ev), topProcess));
+  timer.Stop();
+  TUtil::TTHPermutationStatistics stats = mela.getTTHPermutationStatistics();
+  cout << "testME_TTH: " << timer.CpuTime()/double(max(nEvents, 1u))*1e3 << " ms per event, " << stats.getAssignmentsPerEvent() << " assignments per event" << endl;
+  status.check(stats.nEvents==nEvents, Form("%llu ttH MEs counted for %u events", stats.nEvents, nEvents));
+  status.check(stats.nAssignmentsEvaluated==36*stats.nEvents, Form("%llu assignments evaluated in %llu events instead of 36 per event", stats.nAssignmentsEvaluated, stats.nEvents));
+
+  // (b, Wf, Wfb) -> (Wfb, b, Wf) for the top and (Wf, Wfb, b) for the antitop
+  const unsigned int order[2][3] ={ { 2, 0, 1 }, { 1, 2, 0 } };
+  for (unsigned int ev=0; ev<nEvents; ev++){
+    ttHEvent permuted = events.at(ev);
+    for (unsigned int it=0; it<2; it++){
+      for (unsigned int id=0; id<3; id++) permuted.topDaughters[it].at(id) = events.at(ev).topDaughters[it].at(order[it][id]);
+    }
+    float probPermuted = computeTTH(mela, permuted, topProcess);
+    status.check(probOrdered.at(ev)>0.f, Form("Event %u: ME is %g", ev, probOrdered.at(ev)));
+    // Only the order of the terms in the sum changes
+    status.checkClose(probPermuted, probOrdered.at(ev), 1e-5, Form("Event %u with permuted top daughters", ev));
+  }
+  return status.finish();
+}
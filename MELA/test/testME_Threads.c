@@ -0,0 +1,106 @@
+// Stress test of concurrent Mela instances: Each thread computes a set of MEs over the same events several times with its own Mela object,
+// and the values have to agree bitwise with those of a single-threaded run of the same configuration.
+// Instances alternate between two configurations (lepton mass removal and PDF member), which are kept per instance.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_Threads.c+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+namespace{
+  vector<TestHypothesis> getHypotheses(Mela& mela){
+    vector<TestHypothesis> hypotheses;
+    hypotheses.push_back(TestHypothesis("JHUGen gg->H->ZZ 0+m", TVar::HSMHiggs, TVar::JHUGen, TVar::ZZGG));
+    hypotheses.push_back(TestHypothesis("JHUGen gg->H->ZZ 0-", TVar::H0minus, TVar::JHUGen, TVar::ZZGG));
+    hypotheses.push_back(TestHypothesis("MCFM qq->ZZ", TVar::bkgZZ, TVar::MCFM, TVar::ZZQQB));
+    hypotheses.push_back(TestHypothesis("MCFM gg->ZZ with the SM Higgs", TVar::bkgZZ_SMHiggs, TVar::MCFM, TVar::ZZGG));
+    {
+      TestHypothesis hypo("MCFM gg->ZZ with self-defined couplings", TVar::SelfDefine_spin0, TVar::MCFM, TVar::ZZGG);
+      mela.selfDHggcoupl[0][gHIGGS_GG_2][0]=1.0;
+      mela.selfDHzzcoupl[0][gHIGGS_VV_1][0]=1.0;
+      mela.selfDHzzcoupl[0][gHIGGS_VV_4][0]=0.5;
+      hypo.setCouplings(mela);
+      hypotheses.push_back(hypo);
+      mela.reset_SelfDCouplings();
+    }
+    hypotheses.push_back(TestHypothesis("JHUGen H+jj", TVar::HSMHiggs, TVar::JHUGen, TVar::JJQCD, Mela::Hypothesis::kComputeProdP));
+    hypotheses.push_back(TestHypothesis("JHUGen VBF", TVar::HSMHiggs, TVar::JHUGen, TVar::JJVBF, Mela::Hypothesis::kComputeProdP));
+    hypotheses.push_back(TestHypothesis("JHUGen ZH", TVar::HSMHiggs, TVar::JHUGen, TVar::Had_ZH, Mela::Hypothesis::kComputeProdP_VH));
+    return hypotheses;
+  }
+
+  // Computes the hypotheses over all events nLoops times, and records the values of the last loop
+  void computeMEs(
+    Mela* mela, const vector<TestHypothesis>* hypotheses,
+    const vector<SimpleParticleCollection_t>* daughtersList, const vector<SimpleParticleCollection_t>* associatedList,
+    unsigned int nLoops, vector<float>* result
+    ){
+    for (unsigned int iloop=0; iloop<nLoops; iloop++){
+      result->clear();
+      for (unsigned int ev=0; ev<daughtersList->size(); ev++){
+        SimpleParticleCollection_t daughters = daughtersList->at(ev);
+        SimpleParticleCollection_t associated = associatedList->at(ev);
+        mela->setInputEvent(&daughters, &associated, (SimpleParticleCollection_t*)0, false);
+        for (unsigned int ih=0; ih<hypotheses->size(); ih++) result->push_back(hypotheses->at(ih).compute(*mela));
+        mela->resetInputEvent();
+      }
+    }
+  }
+}
+
+
+int testME_Threads(unsigned int nthreads=8, unsigned int nLoops=10, unsigned int nEvents=20){
+  const int erg_tev=13;
+  const float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  TestStatus status("testME_Threads");
+
+  vector<Mela*> melaList;
+  for (unsigned int it=0; it<nthreads; it++){
+    melaList.push_back(new Mela(erg_tev, mPOLE, verbosity));
+    melaList.back()->setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+    melaList.back()->setRemoveLeptonMasses(it%2==0);
+    if (it%2==1) melaList.back()->setLHAgrid(getNNPDFPath().c_str(), 2);
+  }
+  const vector<TestHypothesis> hypotheses = getHypotheses(*(melaList.front()));
+
+  // Massive leptons, so that the lepton mass removal setting matters
+  vector<SimpleParticleCollection_t> daughtersList;
+  vector<SimpleParticleCollection_t> associatedList;
+  TRandom3 rand(12345);
+  for (unsigned int ev=0; ev<nEvents; ev++){
+    SimpleParticleCollection_t daughters = getLeptons(ids_2e2mu, &rand);
+    for (unsigned int idau=0; idau<daughters.size(); idau++) daughters.at(idau).second.SetE(daughters.at(idau).second.E()*1.001);
+    daughtersList.push_back(daughters);
+    associatedList.push_back(getRandomJets(rand));
+  }
+
+  // Single-threaded reference values
+  vector<float> reference[2];
+  for (unsigned int is=0; is<2 && is<nthreads; is++) computeMEs(melaList.at(is), &hypotheses, &daughtersList, &associatedList, 1, &(reference[is]));
+  if (nthreads>=2) status.check(reference[0]!=reference[1], "The two configurations give the same MEs");
+
+  vector< vector<float> > results(nthreads);
+  vector<thread> threads;
+  for (unsigned int it=0; it<nthreads; it++) threads.push_back(thread(computeMEs, melaList.at(it), &hypotheses, &daughtersList, &associatedList, nLoops, &(results.at(it))));
+  for (unsigned int it=0; it<nthreads; it++) threads.at(it).join();
+
+  for (unsigned int it=0; it<nthreads; it++){
+    const vector<float>& ref = reference[it%2];
+    const vector<float>& res = results.at(it);
+    if (!status.check(res.size()==ref.size(), Form("Thread %u computed %u MEs instead of %u", it, (unsigned int) res.size(), (unsigned int) ref.size()))) continue;
+    for (unsigned int ir=0; ir<ref.size(); ir++){
+      status.check(ref.at(ir)>0.f, Form("Thread %u, event %u, %s: Reference ME is %g", it, (unsigned int) (ir/hypotheses.size()), hypotheses.at(ir%hypotheses.size()).name.c_str(), ref.at(ir)));
+      status.checkClose(res.at(ir), ref.at(ir), 0, Form("Thread %u, event %u, %s", it, (unsigned int) (ir/hypotheses.size()), hypotheses.at(ir%hypotheses.size()).name.c_str()));
+    }
+  }
+
+  for (unsigned int it=0; it<nthreads; it++) delete melaList.at(it);
+  return status.finish();
+}
@@ -0,0 +1,96 @@
+// Consistency and timing of the VH helicity sum: MEs computed with one call to EvalAmp_VHiggs_HelicitySum per parton pair
+// are compared to the MEs computed with one call to EvalAmp_VHiggs per helicity, as before the helicity sum.
+// Hadronic ZH and WH are computed with SM and mixed couplings for H->4l, and with H->b bbar included in the ME.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testME_VHHelicitySum.c+
+#include <iostream>
+#include <vector>
+#include "TStopwatch.h"
+#include "testME_Common.h"
+
+
+using namespace std;
+using namespace testME;
+
+
+namespace{
+  void setSelfDCouplings(Mela& mela){
+    mela.selfDHzzcoupl[0][gHIGGS_VV_1][0]=1.0;
+    mela.selfDHzzcoupl[0][gHIGGS_VV_2][0]=0.5; mela.selfDHzzcoupl[0][gHIGGS_VV_2][1]=0.2;
+    mela.selfDHzzcoupl[0][gHIGGS_VV_4][1]=-0.8;
+    mela.selfDHzzcoupl[0][gHIGGS_ZA_2][0]=0.3;
+    mela.selfDHwwcoupl[0][gHIGGS_VV_1][0]=1.0;
+    mela.selfDHwwcoupl[0][gHIGGS_VV_2][0]=0.5; mela.selfDHwwcoupl[0][gHIGGS_VV_2][1]=0.2;
+    mela.selfDHwwcoupl[0][gHIGGS_VV_4][1]=-0.8;
+  }
+  // H->b bbar from the two lepton pairs of testME_Common.h, which Mela sorts as H->f fbar
+  SimpleParticleCollection_t getBQuarks(){
+    SimpleParticleCollection_t leptons = getLeptons(ids_2e2mu);
+    SimpleParticleCollection_t daughters;
+    daughters.push_back(SimpleParticle_t(5, leptons.at(0).second+leptons.at(1).second));
+    daughters.push_back(SimpleParticle_t(-5, leptons.at(2).second+leptons.at(3).second));
+    return daughters;
+  }
+}
+
+
+int testME_VHHelicitySum(unsigned int nEvents=20, double tolerance=1e-6){
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+  mela.setCandidateDecayMode(TVar::CandidateDecay_ZZ);
+  TestStatus status("testME_VHHelicitySum");
+
+  vector<TestHypothesis> hypotheses;
+  hypotheses.push_back(TestHypothesis("JHUGen ZH", TVar::HSMHiggs, TVar::JHUGen, TVar::Had_ZH, Mela::Hypothesis::kComputeProdP_VH));
+  hypotheses.push_back(TestHypothesis("JHUGen WH", TVar::HSMHiggs, TVar::JHUGen, TVar::Had_WH, Mela::Hypothesis::kComputeProdP_VH));
+  for (unsigned int iv=0; iv<2; iv++){
+    TestHypothesis hypo(
+      (iv==0 ? "JHUGen ZH with self-defined couplings" : "JHUGen WH with self-defined couplings"),
+      TVar::SelfDefine_spin0, TVar::JHUGen, (iv==0 ? TVar::Had_ZH : TVar::Had_WH), Mela::Hypothesis::kComputeProdP_VH
+    );
+    setSelfDCouplings(mela);
+    hypo.setCouplings(mela);
+    hypotheses.push_back(hypo);
+  }
+  mela.reset_SelfDCouplings();
+  const unsigned int nHypotheses4l = hypotheses.size();
+  for (unsigned int iv=0; iv<2; iv++){
+    TestHypothesis hypo(
+      (iv==0 ? "JHUGen ZH, H->bb" : "JHUGen WH, H->bb"),
+      TVar::HSMHiggs, TVar::JHUGen, (iv==0 ? TVar::Had_ZH : TVar::Had_WH), Mela::Hypothesis::kComputeProdP_VH
+    );
+    hypo.includeHiggsDecay=true;
+    hypotheses.push_back(hypo);
+  }
+
+  TRandom3 rand(12345);
+  TStopwatch timer[2];
+  for (unsigned int ev=0; ev<nEvents; ev++){
+    SimpleParticleCollection_t associated = (ev==0 ? getJets() : getRandomJets(rand));
+
+    vector<float> probs[2]; // Per helicity, summed
+    for (unsigned int isum=0; isum<2; isum++){
+      mela.setVHHelicitySumming(isum==1);
+      for (unsigned int idecay=0; idecay<2; idecay++){
+        SimpleParticleCollection_t daughters = (idecay==0 ? getLeptons(ids_2e2mu) : getBQuarks());
+        mela.setInputEvent(&daughters, &associated, (SimpleParticleCollection_t*)0, false);
+        timer[isum].Start(false);
+        for (unsigned int ih=(idecay==0 ? 0 : nHypotheses4l); ih<(idecay==0 ? nHypotheses4l : hypotheses.size()); ih++) probs[isum].push_back(hypotheses.at(ih).compute(mela));
+        timer[isum].Stop();
+        mela.resetInputEvent();
+      }
+    }
+
+    for (unsigned int ih=0; ih<hypotheses.size(); ih++){
+      status.check(probs[0].at(ih)>0.f, Form("Event %u, %s: ME with one call per helicity is %g", ev, hypotheses.at(ih).name.c_str(), probs[0].at(ih)));
+      status.checkClose(probs[1].at(ih), probs[0].at(ih), tolerance, Form("Event %u, %s", ev, hypotheses.at(ih).name.c_str()));
+    }
+  }
+  mela.setVHHelicitySumming(true);
+
+  cout << "testME_VHHelicitySum: Timing per event for " << hypotheses.size() << " hypotheses" << endl;
+  cout << "\tOne call per helicity: " << timer[0].CpuTime()/double(nEvents)*1e3 << " ms" << endl;
+  cout << "\tHelicity sum: " << timer[1].CpuTime()/double(nEvents)*1e3 << " ms" << endl;
+  return status.finish();
+}
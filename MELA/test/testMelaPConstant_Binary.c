@@ -0,0 +1,139 @@
+// Comparison of the MelaPConstant values read from the binary format (MelaPConstant::ConvertFile) against those read from the ROOT files.
+// The values have to be identical, both for the bare functions (GetVal) and for MelaPConstant::Eval on full events.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testMelaPConstant_Binary.c+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Mela.h"
+#include "MelaPConstant.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TLorentzVector.h"
+#include "TString.h"
+
+
+using namespace std;
+
+
+namespace{
+  struct constantFile{
+    string name;
+    TVar::MatrixElement me;
+    TVar::Production prod;
+    TVar::Process proc;
+  };
+
+  vector<TString> getSplineNames(const TString& rootpath){
+    vector<TString> names;
+    TFile* fin = TFile::Open(rootpath, "read");
+    if (fin==0 || fin->IsZombie()) return names;
+    TIter nextKey(fin->GetListOfKeys());
+    TKey* key;
+    while ((key = (TKey*)nextKey())){
+      TString keyname = key->GetName();
+      if (!keyname.BeginsWith("sp_tg_") || !keyname.EndsWith("_Smooth")) continue;
+      TString spname = keyname(6, keyname.Length()-6-7);
+      bool isDuplicate=false;
+      for (unsigned int in=0; in<names.size(); in++){ if (names.at(in)==spname) isDuplicate=true; }
+      if (!isDuplicate) names.push_back(spname);
+    }
+    fin->Close();
+    return names;
+  }
+}
+
+
+void testMelaPConstant_Binary(TString datadir="../data/", TString outdir="./"){
+  if (!datadir.EndsWith("/")) datadir.Append("/");
+  if (!outdir.EndsWith("/")) outdir.Append("/");
+
+  vector<constantFile> files;
+  {
+    constantFile cf;
+    cf.name="pAvgSmooth_JHUGen_JJQCD_HSMHiggs_13TeV"; cf.me=TVar::JHUGen; cf.prod=TVar::JJQCD; cf.proc=TVar::HSMHiggs; files.push_back(cf);
+    cf.name="pAvgSmooth_JHUGen_JJVBF_HSMHiggs_13TeV"; cf.me=TVar::JHUGen; cf.prod=TVar::JJVBF; cf.proc=TVar::HSMHiggs; files.push_back(cf);
+    cf.name="pAvgSmooth_JHUGen_JQCD_HSMHiggs_13TeV"; cf.me=TVar::JHUGen; cf.prod=TVar::JQCD; cf.proc=TVar::HSMHiggs; files.push_back(cf);
+    cf.name="pAvgSmooth_MCFM_JJQCD_bkgZJets_13TeV_2l2q"; cf.me=TVar::MCFM; cf.prod=TVar::JJQCD; cf.proc=TVar::bkgZJets; files.push_back(cf);
+    cf.name="pAvgSmooth_JHUGen_ZZGG_HSMHiggs"; cf.me=TVar::JHUGen; cf.prod=TVar::ZZGG; cf.proc=TVar::HSMHiggs; files.push_back(cf);
+    cf.name="pAvgSmooth_MCFM_ZZGG_HSMHiggs"; cf.me=TVar::MCFM; cf.prod=TVar::ZZGG; cf.proc=TVar::HSMHiggs; files.push_back(cf);
+    cf.name="pAvgSmooth_MCFM_ZZGG_bkgZZ"; cf.me=TVar::MCFM; cf.prod=TVar::ZZGG; cf.proc=TVar::bkgZZ; files.push_back(cf);
+    cf.name="pAvgSmooth_MCFM_ZZQQB_bkgZZ"; cf.me=TVar::MCFM; cf.prod=TVar::ZZQQB; cf.proc=TVar::bkgZZ; files.push_back(cf);
+  }
+
+  vector<MelaPConstant*> rootHandles, binHandles;
+  vector<TString> handleNames;
+  unsigned int nFailed=0;
+  for (unsigned int ifile=0; ifile<files.size(); ifile++){
+    const constantFile& cf = files.at(ifile);
+    TString rootpath = datadir + cf.name.c_str() + ".root";
+    TString binpath = outdir + cf.name.c_str() + ".mpc";
+    if (!MelaPConstant::ConvertFile(rootpath, binpath)){
+      cout << "testMelaPConstant_Binary: Failed to convert " << rootpath << endl;
+      nFailed++;
+      continue;
+    }
+    vector<TString> spnames = getSplineNames(rootpath);
+    for (unsigned int isp=0; isp<spnames.size(); isp++){
+      rootHandles.push_back(new MelaPConstant(cf.me, cf.prod, cf.proc, rootpath, spnames.at(isp)));
+      binHandles.push_back(new MelaPConstant(cf.me, cf.prod, cf.proc, binpath, spnames.at(isp)));
+      handleNames.push_back(TString(cf.name.c_str()) + ":" + spnames.at(isp));
+      if (rootHandles.back()->IsLoaded() || binHandles.back()->IsLoaded()){
+        cout << "testMelaPConstant_Binary: " << handleNames.back() << " is loaded before its first evaluation" << endl;
+        nFailed++;
+      }
+    }
+  }
+
+  // Bare functions over the full mass range, including the low/high function and spline boundaries
+  for (unsigned int ih=0; ih<rootHandles.size(); ih++){
+    for (double mass=1.; mass<=7000.; mass+=0.25){
+      double vRoot = rootHandles.at(ih)->GetVal(mass);
+      double vBin = binHandles.at(ih)->GetVal(mass);
+      if (vRoot!=vBin){
+        cout << "testMelaPConstant_Binary: " << handleNames.at(ih) << " at m=" << mass << " is " << vBin << " from the binary file instead of " << vRoot << endl;
+        nFailed++;
+        break;
+      }
+    }
+  }
+
+  // MelaPConstant::Eval on events with different masses
+  int erg_tev=13;
+  float mPOLE=125.;
+  TVar::VerbosityLevel verbosity = TVar::ERROR;
+  Mela mela(erg_tev, mPOLE, verbosity);
+  const double l_array[4][4] ={
+    { 51.374202, 25.924766, 12.290178, 42.616376 },
+    { 271.875752, 70.427173, -11.138146, 261.769598 },
+    { 75.823478, -16.640412, 23.246999, 70.227220 },
+    { 21.481452, 9.489680, -9.336587, 16.858699 }
+  };
+  const int idOrdered[4] ={ 13, -13, 11, -11 };
+  const double scales[5] ={ 0.3, 0.5, 1., 2., 5. };
+  for (unsigned int isc=0; isc<5; isc++){
+    SimpleParticleCollection_t daughters;
+    for (unsigned int idau=0; idau<4; idau++){
+      TLorentzVector pDau;
+      pDau.SetXYZT(l_array[idau][1], l_array[idau][2], l_array[idau][3], l_array[idau][0]);
+      pDau *= scales[isc];
+      daughters.push_back(SimpleParticle_t(idOrdered[idau], pDau));
+    }
+    mela.setInputEvent(&daughters, (SimpleParticleCollection_t*)0, (SimpleParticleCollection_t*)0, false);
+    float prob=0;
+    mela.setProcess(TVar::HSMHiggs, TVar::JHUGen, TVar::ZZGG);
+    mela.computeP(prob, false);
+    for (unsigned int ih=0; ih<rootHandles.size(); ih++){
+      double vRoot = rootHandles.at(ih)->Eval(mela.getIORecord(), verbosity);
+      double vBin = binHandles.at(ih)->Eval(mela.getIORecord(), verbosity);
+      if (vRoot!=vBin){
+        cout << "testMelaPConstant_Binary: Eval of " << handleNames.at(ih) << " for event " << isc << " is " << vBin << " from the binary file instead of " << vRoot << endl;
+        nFailed++;
+      }
+    }
+    mela.resetInputEvent();
+  }
+
+  for (unsigned int ih=0; ih<rootHandles.size(); ih++){ delete rootHandles.at(ih); delete binHandles.at(ih); }
+  if (nFailed==0) cout << "testMelaPConstant_Binary: All " << rootHandles.size() << " constants are identical in the binary format." << endl;
+  else cout << "testMelaPConstant_Binary: " << nFailed << " mismatches found!" << endl;
+}
@@ -0,0 +1,52 @@
+// Comparison of the SuperMELA m4l probabilities evaluated without RooFit (default) against those from the RooFit pdfs.
+// Has to be compiled, e.g. root -l -b -q loadMELA.C testSuperMELA_FastEvaluation.c+
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <utility>
+#include "SuperMELA.h"
+
+
+using namespace std;
+
+
+void testSuperMELA_FastEvaluation(double tolerance=1e-12, unsigned int nPoints=500){
+  const string channels[3] ={ "4mu", "4e", "2e2mu" };
+  const double mHList[2] ={ 125., 150. };
+
+  unsigned int nFailed=0;
+  double maxRelDiff=0;
+  for (unsigned int imh=0; imh<2; imh++){
+    SuperMELA super(mHList[imh], "4mu", 8.);
+    super.SetPathToCards("../data/CombinationInputs/SM_inputs_8TeV/");
+    super.init();
+    for (unsigned int ich=0; ich<3; ich++){
+      super.SetDecayChannel(channels[ich]);
+      for (unsigned int ip=0; ip<nPoints; ip++){
+        double m4l = 100.+double(ip)*(mHList[imh]+50.-100.)/double(nPoints);
+
+        super.SetFastEvaluation(true);
+        pair<double, double> pFast = super.M4lProb(m4l);
+        super.SetFastEvaluation(false);
+        pair<double, double> pRooFit = super.M4lProb(m4l);
+        if (pRooFit.first<0.) continue; // Outside the m4l range
+
+        double relDiff[2] ={
+          fabs(pFast.first-pRooFit.first)/max(fabs(pRooFit.first), 1e-300),
+          fabs(pFast.second-pRooFit.second)/max(fabs(pRooFit.second), 1e-300)
+        };
+        for (unsigned int is=0; is<2; is++){
+          if (relDiff[is]>maxRelDiff) maxRelDiff=relDiff[is];
+          if (relDiff[is]>tolerance){
+            cout << "testSuperMELA_FastEvaluation: " << (is==0 ? "Signal" : "Background") << " probability for mH=" << mHList[imh] << ", " << channels[ich] << ", m4l=" << m4l
+              << " is " << (is==0 ? pFast.first : pFast.second) << " instead of " << (is==0 ? pRooFit.first : pRooFit.second) << endl;
+            nFailed++;
+          }
+        }
+      }
+    }
+  }
+  cout << "testSuperMELA_FastEvaluation: Maximum relative difference is " << maxRelDiff << endl;
+  if (nFailed==0) cout << "testSuperMELA_FastEvaluation: All probabilities agree within " << tolerance << "." << endl;
+  else cout << "testSuperMELA_FastEvaluation: " << nFailed << " mismatches found!" << endl;
+}
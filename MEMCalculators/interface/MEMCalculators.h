@@ -103,7 +103,7 @@ public:
 	/// \param[out] me2process              retrieved |ME|^2 for the specified process and calculator.
 	/// \return                             error code of the computation: 0 = NO_ERR, 1 = ERR_PROCESS, 2 = ERR_COMPUTE
 	///
-	int computeME(Processes process, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId, double& me2process);
+	int computeME(Processes process, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId, double& me2process);
 	
 	///
 	/// Compute individual mixed MEs for the specified "model".
@@ -117,7 +117,7 @@ public:
 	/// \param[out] me2process              retrieved |ME|^2 for the specified process and calculator.
 	/// \return                             error code of the computation: 0 = NO_ERR, 1 = ERR_PROCESS, 2 = ERR_COMPUTE
 	///
-	int computeME(Processes process, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings, double& me2process);
+	int computeME(Processes process, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings, double& me2process);
 	
 	///
 	/// Compute individual mixed MEs interference term for the specified "model". Intended for the production-independent models PLUS gg -> Spin 0
@@ -130,10 +130,10 @@ public:
 	/// \param[out] me2process              retrieved |ME|^2 for the specified process and calculator.
 	/// \return                             error code of the computation: 0 = NO_ERR, 1 = ERR_PROCESS, 2 = ERR_COMPUTE
 	///
-	int computeME_Interference(Processes process, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId, vector<complex<double> > *DecayCouplings, double& me2process);
+	int computeME_Interference(Processes process, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId, vector<complex<double> > *DecayCouplings, double& me2process);
 	
 	/// Work in progress method. Currently serves as a bridge to MELA package implementations.
-	int computeME_Interference(Processes_int process, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId,  double& me2process);
+	int computeME_Interference(Processes_int process, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId,  double& me2process);
 	
 	///
 	/// Compute individual KD and MEs for process A and process B, obtained with the specified calculator tool.
@@ -147,7 +147,7 @@ public:
 	/// \param[out] me2processB             computed |ME|^2 for process B.
 	/// \return                             error code of the computation: 0 = NO_ERR, 1 = ERR_PROCESS, 2 = ERR_COMPUTE
 	///
-	int computeKD(Processes processA, Processes processB, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId, double& kd, double& me2processA, double& me2processB );
+	int computeKD(Processes processA, Processes processB, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId, double& kd, double& me2processA, double& me2processB );
 	
 	///
 	/// Compute individual KD and MEs for process A and process B, obtained with the specified calculator tool.
@@ -165,18 +165,20 @@ public:
 	/// \param[out] me2processB             computed |ME|^2 for process B.
 	/// \return                             error code of the computation: 0 = NO_ERR, 1 = ERR_PROCESS, 2 = ERR_COMPUTE
 	///
-	int computeKD(Processes processA, Processes processB, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId, vector<complex<double> > *ProdCouplingsA, vector<complex<double> > *DecayCouplingsA, vector<complex<double> > *ProdCouplingsB, vector<complex<double> > *DecayCouplingsB, double& kd, double& me2processA, double& me2processB );
+	int computeKD(Processes processA, Processes processB, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId, vector<complex<double> > *ProdCouplingsA, vector<complex<double> > *DecayCouplingsA, vector<complex<double> > *ProdCouplingsB, vector<complex<double> > *DecayCouplingsB, double& kd, double& me2processA, double& me2processB );
 	
 	///
-	/// Compute MEs for all supported processes.
+	/// Set the event for which the MEs of all supported processes are retrieved.
 	///
 	/// Individual MEs and KDs can be retrieved using retrieveME(Processes,MEMCalcs,double&) and computeKD(Processes,MEMCalcs,Processes,MEMCalcs,double(*)(double,double),double&,double&,double&).
+	/// The MEs and P(m4l) values are computed on the first retrieval and kept until the kinematics of the event change.
+	/// Errors of these computations are returned by the retrieval methods.
 	///
 	/// \param[in]  partP                   the input vector with TLorentzVectors for 4 leptons and 1 photon.
 	/// \param[in]  partId                  the input vecor with IDs (PDG) for 4 leptons and 1 photon.
-	/// \return                             error code of the computation: 0 = NO_ERR, 2 = ERR_COMPUTE
+	/// \return                             error code: 0 = NO_ERR, 2 = ERR_COMPUTE if the event is not valid
 	///
-	int computeMEs(vector<TLorentzVector> partP, vector<int> partId);
+	int computeMEs(const vector<TLorentzVector>& partP, const vector<int>& partId);
 	
 	///
 	/// Retrieve ME for specified process and specified calculator tool.
@@ -185,8 +187,8 @@ public:
 	///
 	/// \param[in]  process                 names of the process for which the ME should be retrieved.
 	/// \param[in]  calculator              name of the calculator tool to be used.
-	/// \param[out] me2process              retrieved |ME|^2 for the specified process and calculator.
-	/// \return                             error codes: 0 = NO_ERR, 1 = ERR_PROCESS
+	/// \param[out] me2process              retrieved |ME|^2 for the specified process and calculator, 0 on error.
+	/// \return                             error codes: 0 = NO_ERR, 1 = ERR_PROCESS, 2 = ERR_COMPUTE (also if no valid event was set)
 	///
 	int retrieveME(Processes process, MEMCalcs calculator, double& me2process);
 	
@@ -202,7 +204,7 @@ public:
 	/// \param[out] kd                          computed KD value for discrimination of processes A and B.
 	/// \param[out] me2processA                 computed |ME|^2 for process A.
 	/// \param[out] me2processB                 computed |ME|^2 for process B.
-	/// \return                                 error code of the computation: 0 = NO_ERR, 1 = ERR_PROCESS
+	/// \return                                 error code of the computation: 0 = NO_ERR, 1 = ERR_PROCESS, 2 = ERR_COMPUTE
 	///
 	int computeKD(Processes processA, MEMCalcs calculatorA, Processes processB, MEMCalcs calculatorB, double (MEMs::*funcKD)(double, double), double& kd, double& me2processA, double& me2processB );
 	
@@ -220,7 +222,7 @@ public:
 	/// \param[out] kd                          computed KD value for discrimination of processes A and B.
 	/// \param[out] me2processA                 computed |ME|^2 for process A.
 	/// \param[out] me2processB                 computed |ME|^2 for process B.
-	/// \return                                 error code of the computation: 0 = NO_ERR, 1 = ERR_PROCESS
+	/// \return                                 error code of the computation: 0 = NO_ERR, 1 = ERR_PROCESS, 2 = ERR_COMPUTE
 	///
 	int computeKD(Processes processA, MEMCalcs calculatorA, Processes processB, MEMCalcs calculatorB, double (MEMs::*funcKD)(Processes, MEMCalcs, Processes, MEMCalcs), double& kd, double& me2processA, double& me2processB );
 	
@@ -237,7 +239,7 @@ public:
 	/// \param[out] me2processA                 computed |ME|^2 for process A.
 	/// \param[out] me2processB                 computed |ME|^2 for process B.
 	/// \param[in]  syst                        controls whether PDF mean or width is adjusted to gauge the systematic effects (DEFAULT = kNone)
-	/// \return                                 error code of the computation: 0 = NO_ERR, 1 = ERR_PROCESS
+	/// \return                                 error code of the computation: 0 = NO_ERR, 1 = ERR_PROCESS, 2 = ERR_COMPUTE
 	///
 	int computeKD(Processes processA, MEMCalcs calculatorA, Processes processB, MEMCalcs calculatorB, double (MEMs::*funcKD)(double, double, SuperKDsyst), double& kd, double& me2processA, double& me2processB, SuperKDsyst syst = MEMNames::kNone );
 	
@@ -259,7 +261,7 @@ public:
 	/// \param[out] sigProb                 calculated P(m4l) for signal
 	/// \param[out] bkgProb                 calculated P(m4l) for background
 	///
-	void computePm4l(vector<TLorentzVector> partP, vector<int> partId, SuperKDsyst syst, double& sigProb, double& bkgProb);
+	void computePm4l(const vector<TLorentzVector>& partP, const vector<int>& partId, SuperKDsyst syst, double& sigProb, double& bkgProb);
 	
 	
 	///
@@ -326,12 +328,16 @@ public:
 	
 	
 	/// MEM calculators: MEKD (FeynRules+MadGraph5_v1) and MELA (Analytic, JHUGen, MCFM). Placed here for the expert use.
+	/// The input event of m_MELA is kept between calls for the same kinematics; call resetCache() before using m_MELA directly.
 	MEKD* m_MEKD;
 	Mela* m_MELA;
 
   /// Enable removing of lepton masses from the MEs
   void removeLeptonMasses(bool doRemove = false);
 
+  /// Forget the cached event and its MEs, and clear the MELA input event
+  void resetCache();
+
 private:
 	/// For error handling and supported precalculations
 	int m_err, NUM_PROCESSES_PRECALC;
@@ -344,15 +350,18 @@ private:
 	/// debug flag
 	bool debug;
 	
-	/// stored results of MEs computed with computeMEs(...)
+	/// stored results of MEs computed for the cached event, valid where m_isMEComputed is set
 	double m_computedME[NUM_PROCESSES][NUM_MEMCALCS];
+	bool m_isMEComputed[NUM_PROCESSES][NUM_MEMCALCS];
 	
-	/// stored results of P(m4l) computed with computePm4l(...)
+	/// stored results of P(m4l) computed with computePm4l(...) for the cached event
 	double m_computedPm4lSig[NUM_SuperKDsyst];
 	double m_computedPm4lBkg[NUM_SuperKDsyst];
+	bool m_isPm4lComputed[NUM_SuperKDsyst];
 	
-	/// compute pdf(m4l) with computePm4l(...) for all systs
-	void computePm4ls(vector<TLorentzVector> partP, vector<int> partId);
+	/// retrieve the ME or pdf(m4l) of the cached event, computing it on first use
+	int getComputedME(Processes process, MEMCalcs calculator, double& me2process);
+	void getComputedPm4l(SuperKDsyst syst);
 	
 	/// Checks the couplings' vectors for the consistent size
 	int Check_Couplings( Processes process, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings );
@@ -372,6 +381,15 @@ private:
 	// caches to avoid multiplemela computations
 	std::vector<TLorentzVector> partPCache;
 	std::vector<int> partIdCache;
+	bool m_hasCachedEvent;
+	bool m_isMELAInputSet;
+	
+	/// make partP, partId the cached event, invalidating the stored results if the kinematics differ
+	void setCachedEvent(const vector<TLorentzVector>& partP, const vector<int>& partId);
+	/// set the cached event as the MELA input event if it is not set yet
+	void setMELAInputEvent();
+	/// only MEs of MEMNames::Processes computed without explicit couplings are stored for the cached event
+	bool isCacheable(int process, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings);
 	
 	/// mapping of process enums between MEMNames and MELA (defined in TVar.hh
 	map<Processes,TVar::Process> MELAprocMap;
@@ -384,9 +402,9 @@ private:
 	float m_weight;
 	
 	/// MELA calculation
-	int cacheMELAcalculation(Processes process, MEMCalcs calculator,vector<TLorentzVector> partP, vector<int> partId, double& me2process);
-	int cacheMELAcalculation(Processes process, MEMCalcs calculator,vector<TLorentzVector> partP, vector<int> partId, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings, double& me2process);
-	int cacheMELAcalculation(int process, MEMCalcs calculator,vector<TLorentzVector> partP, vector<int> partId, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings, double& me2process);
+	int cacheMELAcalculation(Processes process, MEMCalcs calculator,const vector<TLorentzVector>& partP, const vector<int>& partId, double& me2process);
+	int cacheMELAcalculation(Processes process, MEMCalcs calculator,const vector<TLorentzVector>& partP, const vector<int>& partId, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings, double& me2process);
+	int cacheMELAcalculation(int process, MEMCalcs calculator,const vector<TLorentzVector>& partP, const vector<int>& partId, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings, double& me2process);
 };
 
 
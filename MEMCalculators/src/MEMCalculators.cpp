@@ -334,10 +334,9 @@ MEMs::MEMs(double collisionEnergy, double sKD_mass, string PDFName, bool debug_)
     /// Initialise MELA
     m_MELA = new Mela(collisionEnergy, sKD_mass); //sMELA_mass for SuperMELA calculation
     
-    /// Set some non-physical values for MEs initially
-    for(int iMemCalc = 0; iMemCalc < NUM_MEMCALCS; iMemCalc++ )
-        for(int iProcess = 0; iProcess < NUM_PROCESSES; iProcess++ )
-            m_computedME[iProcess][iMemCalc] = -999.;
+    /// Set some non-physical values for MEs initially, no event is cached yet
+    m_isMELAInputSet = false;
+    resetCache();
 
     m_weight = 0.0;
 	
@@ -349,7 +348,7 @@ MEMs::MEMs(double collisionEnergy, double sKD_mass, string PDFName, bool debug_)
 ///----------------------------------------------------------------------------------------------
 /// MEMs::computeME - Compute ME for the specified process.
 ///----------------------------------------------------------------------------------------------
-int MEMs::computeME(Processes process, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId, double& me2process)
+int MEMs::computeME(Processes process, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId, double& me2process)
 {
 	return computeME(process, calculator, partP, partId, (vector<complex<double> >*) NULL, (vector<complex<double> >*) NULL, me2process);
 }
@@ -359,7 +358,7 @@ int MEMs::computeME(Processes process, MEMCalcs calculator, vector<TLorentzVecto
 ///----------------------------------------------------------------------------------------------
 /// MEMs::computeME - Compute ME for the specified process. A generic case
 ///----------------------------------------------------------------------------------------------
-int MEMs::computeME(Processes process, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings, double& me2process)
+int MEMs::computeME(Processes process, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings, double& me2process)
 {
 	if( debug ) cout << "MEMs::computeME started.\n";
 	if( debug ) cout << "MEMs::computeME. Selected calculator: " << calculator << "\n";
@@ -381,9 +380,20 @@ int MEMs::computeME(Processes process, MEMCalcs calculator, vector<TLorentzVecto
 	switch ( calculator )
 	{
 		case kMEKD:			/// compute ME with MEKD
+			setCachedEvent(partP, partId);
+			if( isCacheable(process, ProdCouplings, DecayCouplings) && m_isMEComputed[process][calculator] )
+			{
+				me2process = m_computedME[process][calculator];
+				break;
+			}
 			if( ProdCouplings!=(vector<complex<double> >*) NULL || DecayCouplings!=(vector<complex<double> >*) NULL )
 				if( (m_err=MEKD_Mixed_State( m_processNameMEKD[process], ProdCouplings, DecayCouplings )) != 0 ) return ERR_COMPUTE;
 			if( (m_MEKD->computeME(m_processNameMEKD[process], partP, partId, me2process)) != 0 ) return ERR_COMPUTE;
+			if( isCacheable(process, ProdCouplings, DecayCouplings) )
+			{
+				m_computedME[process][calculator] = me2process;
+				m_isMEComputed[process][calculator] = true;
+			}
 			break;
 			
 		case kAnalytical:	/// compute ME with MELA
@@ -437,7 +447,7 @@ int MEMs::computeME(Processes process, MEMCalcs calculator, vector<TLorentzVecto
 ///----------------------------------------------------------------------------------------------
 /// MEMs::computeME_Interference - Compute individual mixed MEs interference term for the specified "model". Intended for the production-independent models PLUS gg -> Spin 0
 ///----------------------------------------------------------------------------------------------
-int MEMs::computeME_Interference(Processes process, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId, vector<complex<double> > *DecayCouplings, double& me2process)
+int MEMs::computeME_Interference(Processes process, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId, vector<complex<double> > *DecayCouplings, double& me2process)
 {
 	if( debug ) cout << "MEMs::computeME_Interference started.\n";
 	
@@ -466,7 +476,7 @@ int MEMs::computeME_Interference(Processes process, MEMCalcs calculator, vector<
 
 
 /// Work in progress method. Currently serves as a bridge to MELA package implementations.
-int MEMs::computeME_Interference(Processes_int process, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId,  double& me2process)
+int MEMs::computeME_Interference(Processes_int process, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId,  double& me2process)
 {
 	if( calculator == kJHUGen || calculator ==kAnalytical )
 		cacheMELAcalculation( static_cast<int>(process), calculator, partP, partId, (vector<complex<double> >*) NULL, (vector<complex<double> >*) NULL, me2process);
@@ -480,7 +490,7 @@ int MEMs::computeME_Interference(Processes_int process, MEMCalcs calculator, vec
 ///----------------------------------------------------------------------------------------------
 /// MEMs::computeKD - Compute KD and MEs for the specified processes and MEM calculator.
 ///----------------------------------------------------------------------------------------------
-int MEMs::computeKD(Processes processA, Processes processB, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId, double& kd, double& me2processA, double& me2processB )
+int MEMs::computeKD(Processes processA, Processes processB, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId, double& kd, double& me2processA, double& me2processB )
 {    
 	return computeKD( processA, processB, calculator, partP, partId, (vector<complex<double> >*) NULL, (vector<complex<double> >*) NULL, (vector<complex<double> >*) NULL, (vector<complex<double> >*) NULL, kd, me2processA, me2processB );
 }
@@ -490,7 +500,7 @@ int MEMs::computeKD(Processes processA, Processes processB, MEMCalcs calculator,
 ///----------------------------------------------------------------------------------------------
 /// MEMs::computeKD - Compute KD and MEs for the specified processes and MEM calculator. A generic case
 ///----------------------------------------------------------------------------------------------
-int MEMs::computeKD(Processes processA, Processes processB, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId, vector<complex<double> > *ProdCouplingsA, vector<complex<double> > *DecayCouplingsA, vector<complex<double> > *ProdCouplingsB, vector<complex<double> > *DecayCouplingsB, double& kd, double& me2processA, double& me2processB )
+int MEMs::computeKD(Processes processA, Processes processB, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId, vector<complex<double> > *ProdCouplingsA, vector<complex<double> > *DecayCouplingsA, vector<complex<double> > *ProdCouplingsB, vector<complex<double> > *DecayCouplingsB, double& kd, double& me2processA, double& me2processB )
 {    
 	/// check if processes are supported
 	if (!isProcSupported[processA][calculator]) return ERR_PROCESS;
@@ -513,14 +523,9 @@ int MEMs::computeKD(Processes processA, Processes processB, MEMCalcs calculator,
 	/// perform computation according to the specified process and MEM package
 	switch ( calculator )
 	{
-		case kMEKD:			/// compute KD with MEKD
-			if( ProdCouplingsA!=(vector<complex<double> >*) NULL || DecayCouplingsA!=(vector<complex<double> >*) NULL )
-				if( (m_err=MEKD_Mixed_State( m_processNameMEKD[processA], ProdCouplingsA, DecayCouplingsA )) != 0 ) return ERR_COMPUTE;
-			if( (m_MEKD->computeME(m_processNameMEKD[processA], partP, partId, me2processA)) != 0 ) return ERR_COMPUTE;
-			
-			if( ProdCouplingsB!=(vector<complex<double> >*) NULL || DecayCouplingsB!=(vector<complex<double> >*) NULL )
-				if( (m_err=MEKD_Mixed_State( m_processNameMEKD[processB], ProdCouplingsB, DecayCouplingsB )) != 0 ) return ERR_COMPUTE;
-			if( (m_MEKD->computeME(m_processNameMEKD[processB], partP, partId, me2processB)) != 0 ) return ERR_COMPUTE;
+		case kMEKD:			/// compute KD with MEKD, through computeME to reuse the MEs of the cached event
+			if( (computeME(processA, calculator, partP, partId, ProdCouplingsA, DecayCouplingsA, me2processA)) != 0 ) return ERR_COMPUTE;
+			if( (computeME(processB, calculator, partP, partId, ProdCouplingsB, DecayCouplingsB, me2processB)) != 0 ) return ERR_COMPUTE;
 			
 			kd = log( me2processA/me2processB );
 			break;
@@ -570,43 +575,61 @@ int MEMs::computeKD(Processes processA, Processes processB, MEMCalcs calculator,
 
 
 ///----------------------------------------------------------------------------------------------
-/// MEMs::computeMEs - Compute MEs for the supported set of processes.
+/// MEMs::computeMEs - Set the event for the supported set of processes. MEs are computed on retrieval.
 ///----------------------------------------------------------------------------------------------
-int MEMs::computeMEs(vector<TLorentzVector> partP, vector<int> partId)
+int MEMs::computeMEs(const vector<TLorentzVector>& partP, const vector<int>& partId)
 {
-	double me2process;
-	
-	//loop over MEMCalcs and loop over Processes
-	for(int iMemCalc = 0; iMemCalc < NUM_MEMCALCS; iMemCalc++ )
+	/// an event without 4 leptons cannot be computed, forget the previous one so nothing stale is retrieved
+	if( partP.size()<4 || partP.size()!=partId.size() )
 	{
-		for(int iProcess = 0; iProcess < NUM_PROCESSES_PRECALC; iProcess++ )
-		{
-			if (!isProcSupported[iProcess][iMemCalc]) continue;
-			if( (computeME(static_cast<Processes>(iProcess), static_cast<MEMCalcs>(iMemCalc), partP, partId, me2process)) != 0 ) return ERR_COMPUTE;
-			m_computedME[iProcess][iMemCalc] = me2process;
-		}
+		resetCache();
+		return ERR_COMPUTE;
 	}
 	
-	// compute and store the sig. and bkg. pdf(m4l) values for all systs
-	computePm4ls(partP, partId);
+	// the stored MEs and pdf(m4l) values are kept if the kinematics did not change
+	setCachedEvent(partP, partId);
 	
-	//return NO_ERR only if all ME computations were successful
-	return 0;
+	return NO_ERR;
 }
 
 
 
 ///----------------------------------------------------------------------------------------------
-/// MEMs::computePm4ls - Compute pdf(m4l) with computePm4l(...) for all systs
+/// MEMs::getComputedME - Retrieve the ME of the cached event, computing it if not done yet
 ///----------------------------------------------------------------------------------------------
-void MEMs::computePm4ls(vector<TLorentzVector> partP, vector<int> partId)
+int MEMs::getComputedME(Processes process, MEMCalcs calculator, double& me2process)
 {
-    for(int iSuperKDsyst = 0; iSuperKDsyst < NUM_SuperKDsyst; iSuperKDsyst++ ) {
-        double sigProb, bkgProb;
-        computePm4l(partP, partId, static_cast<SuperKDsyst>(iSuperKDsyst), sigProb, bkgProb);
-        m_computedPm4lSig[iSuperKDsyst] = sigProb;
-        m_computedPm4lBkg[iSuperKDsyst] = bkgProb;
-    }
+	/// no event set, or the last one was invalid
+	if( !m_hasCachedEvent )
+	{
+		me2process = 0.;
+		return ERR_COMPUTE;
+	}
+	if( m_isMEComputed[process][calculator] )
+	{
+		me2process = m_computedME[process][calculator];
+		return NO_ERR;
+	}
+	/// failures of the on-demand computation are passed to the caller, nothing is stored for them
+	if( (m_err=computeME(process, calculator, partPCache, partIdCache, me2process)) != 0 )
+	{
+		me2process = 0.;
+		return m_err;
+	}
+	
+	return NO_ERR;
+}
+
+
+
+///----------------------------------------------------------------------------------------------
+/// MEMs::getComputedPm4l - Compute pdf(m4l) of the cached event for the syst if not done yet
+///----------------------------------------------------------------------------------------------
+void MEMs::getComputedPm4l(SuperKDsyst syst)
+{
+	if( !m_hasCachedEvent || m_isPm4lComputed[syst] ) return;
+	double sigProb, bkgProb;
+	computePm4l(partPCache, partIdCache, syst, sigProb, bkgProb);
 }
 
 
@@ -619,10 +642,8 @@ int MEMs::retrieveME(Processes process, MEMCalcs calculator, double& me2process)
     /// check if process is supported
     if (!isProcSupported[process][calculator]) return ERR_PROCESS;
     
-    /// retrieve ME
-    me2process = m_computedME[process][calculator];
-    
-    return NO_ERR;
+    /// retrieve ME, computed on first use for the cached event
+    return getComputedME(process, calculator, me2process);
 }
 
 
@@ -636,9 +657,9 @@ int MEMs::computeKD(Processes processA, MEMCalcs calculatorA, Processes processB
     if (!isProcSupported[processA][calculatorA]) return ERR_PROCESS;
     if (!isProcSupported[processB][calculatorB]) return ERR_PROCESS;
 
-	/// retrieve already computed MEs
-    me2processA = m_computedME[processA][calculatorA];
-    me2processB = m_computedME[processB][calculatorB];
+	/// retrieve MEs, computed on first use for the cached event
+    if( (m_err=getComputedME(processA, calculatorA, me2processA)) != 0 ) return m_err;
+    if( (m_err=getComputedME(processB, calculatorB, me2processB)) != 0 ) return m_err;
 	/// compute KD
     kd = (*this.*funcKD)(me2processA, me2processB);
     
@@ -656,9 +677,9 @@ int MEMs::computeKD(Processes processA, MEMCalcs calculatorA, Processes processB
     if (!isProcSupported[processA][calculatorA]) return ERR_PROCESS;
     if (!isProcSupported[processB][calculatorB]) return ERR_PROCESS;
     
-    /// retrieve already computed MEs
-    me2processA = m_computedME[processA][calculatorA];
-    me2processB = m_computedME[processB][calculatorB];
+    /// retrieve MEs, computed on first use for the cached event
+    if( (m_err=getComputedME(processA, calculatorA, me2processA)) != 0 ) return m_err;
+    if( (m_err=getComputedME(processB, calculatorB, me2processB)) != 0 ) return m_err;
     /// compute KD
     kd = (*this.*funcKD)(processA, calculatorA, processB, calculatorB);
     
@@ -678,9 +699,9 @@ int MEMs::computeKD(Processes processA, MEMCalcs calculatorA, Processes processB
     /// check if processB is kqqZZ or kqqZZ_prodIndep
     if( processB != kqqZZ && processB != kqqZZ_prodIndep ) return ERR_PROCESS;
 
-	/// retrieve already computed MEs
-    me2processA = m_computedME[processA][calculatorA];
-    me2processB = m_computedME[processB][calculatorB];
+	/// retrieve MEs, computed on first use for the cached event
+    if( (m_err=getComputedME(processA, calculatorA, me2processA)) != 0 ) return m_err;
+    if( (m_err=getComputedME(processB, calculatorB, me2processB)) != 0 ) return m_err;
 	/// compute KD with pdf(m4l) folded in
     kd = (*this.*funcKD)(me2processA, me2processB, syst);
 
@@ -708,9 +729,10 @@ double MEMs::probRatio(Processes processA, MEMCalcs calculatorA, Processes proce
     if (!isProcSupported[processA][calculatorA]) return ERR_PROCESS;
     if (!isProcSupported[processB][calculatorB]) return ERR_PROCESS;
 
-    /// retrieve already computed MEs
-    double me2processA = m_computedME[processA][calculatorA];
-    double me2processB = m_computedME[processB][calculatorB];
+    /// retrieve MEs, computed on first use for the cached event
+    double me2processA, me2processB;
+    if( getComputedME(processA, calculatorA, me2processA) != 0 ) return ERR_COMPUTE;
+    if( getComputedME(processB, calculatorB, me2processB) != 0 ) return ERR_COMPUTE;
 
     // compute KD per case basis (for the time being, find more elegant solution later)
     double c;
@@ -750,6 +772,7 @@ double MEMs::probRatio(Processes processA, MEMCalcs calculatorA, Processes proce
 ///----------------------------------------------------------------------------------------------
 double MEMs::PDFm4lRatio(double me2processA, double me2processB, SuperKDsyst syst)
 {
+    getComputedPm4l(syst);
     if (m_computedPm4lSig[syst] * me2processA + m_computedPm4lBkg[syst] * me2processB == 0) return -999.;
     return m_computedPm4lSig[syst]*me2processA/( m_computedPm4lSig[syst] * me2processA + m_computedPm4lBkg[syst] * me2processB );
 }
@@ -876,7 +899,7 @@ int MEMs::MEKD_Mixed_State( TString Model, vector<complex<double> > *ProdCouplin
 ///----------------------------------------------------------------------------------------------
 /// MEMCalculators::cacheMELAcalculation - method to interface with Mela::computeP and cache results
 ///----------------------------------------------------------------------------------------------
-int MEMs::cacheMELAcalculation(Processes process, MEMCalcs calculator,vector<TLorentzVector> partP, vector<int> partId, double& me2process)
+int MEMs::cacheMELAcalculation(Processes process, MEMCalcs calculator,const vector<TLorentzVector>& partP, const vector<int>& partId, double& me2process)
 {
 	return MEMs::cacheMELAcalculation( static_cast<int>(process), calculator, partP, partId, (vector<complex<double> >*) NULL, (vector<complex<double> >*) NULL, me2process);
 }
@@ -886,7 +909,7 @@ int MEMs::cacheMELAcalculation(Processes process, MEMCalcs calculator,vector<TLo
 ///----------------------------------------------------------------------------------------------
 /// MEMCalculators::cacheMELAcalculation - method to interface with Mela::computeP and cache results. A transfer function
 ///----------------------------------------------------------------------------------------------
-int MEMs::cacheMELAcalculation(Processes process, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings, double& me2process)
+int MEMs::cacheMELAcalculation(Processes process, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings, double& me2process)
 {
 	return cacheMELAcalculation( static_cast<int>(process), calculator, partP, partId, ProdCouplings, DecayCouplings, me2process);
 }
@@ -896,7 +919,7 @@ int MEMs::cacheMELAcalculation(Processes process, MEMCalcs calculator, vector<TL
 ///----------------------------------------------------------------------------------------------
 /// MEMCalculators::cacheMELAcalculation - method to interface with Mela::computeP and cache results. A generic case
 ///----------------------------------------------------------------------------------------------
-int MEMs::cacheMELAcalculation(int process, MEMCalcs calculator, vector<TLorentzVector> partP, vector<int> partId, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings, double& me2process){
+int MEMs::cacheMELAcalculation(int process, MEMCalcs calculator, const vector<TLorentzVector>& partP, const vector<int>& partId, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings, double& me2process){
 
   if (debug){
     std::cout << "MEMs::cacheMELAcalculation started." << std::endl;
@@ -904,20 +927,15 @@ int MEMs::cacheMELAcalculation(int process, MEMCalcs calculator, vector<TLorentz
     std::cout << "MEMs::cacheMELAcalculation. Calculator: " << calculator << std::endl;
   }
 
-  partPCache = partP;
-  partIdCache = partId;
-
-  SimpleParticleCollection_t daughters;
-  SimpleParticleCollection_t associateds;
-  for (unsigned int idau=0; idau<4; idau++) daughters.push_back(SimpleParticle_t(partId.at(idau), partP.at(idau))); // Needs generalization for final state
-  for (unsigned int iap=4; iap<partP.size(); iap++) associateds.push_back(SimpleParticle_t(partId.at(iap), partP.at(iap)));
-  // Mothers, blah...
-  m_MELA->setInputEvent(
-    &daughters,
-    &associateds,
-    0,
-    false
-    );
+  // reuse the ME and the MELA input event if the kinematics did not change
+  bool doCache = isCacheable(process, ProdCouplings, DecayCouplings);
+  setCachedEvent(partP, partId);
+  if (doCache && m_isMEComputed[process][calculator]){
+    me2process = m_computedME[process][calculator];
+    if (debug) cout << "MEMs::cacheMELAcalculation. Cached me2process: " << me2process << endl;
+    return NO_ERR;
+  }
+  setMELAInputEvent();
 
   //if(MELAprocMap[static_cast<Processes>(process)] == TVar::HJJVBF || MELAprocMap[static_cast<Processes>(process)] == TVar::PSHJJVBF || MELAprocMap[static_cast<Processes>(process)] == TVar::HJJNONVBF || MELAprocMap[static_cast<Processes>(process)] == TVar::PSHJJNONVBF )
   //	if(MELAprodMap[static_cast<Processes>(process)] == TVar::JJVBF|| MELAprodMap[static_cast<Processes>(process)] == TVar::JJQCD || MELAprodMap[static_cast<Processes>(process)] == TVar::JJVH)
@@ -1074,10 +1092,83 @@ int MEMs::cacheMELAcalculation(int process, MEMCalcs calculator, vector<TLorentz
     if (debug) cout << "MEMs::cacheMELAcalculation. me2process: " << me2process << endl;
   }
 
+  if (doCache){
+    m_computedME[process][calculator] = me2process;
+    m_isMEComputed[process][calculator] = true;
+  }
+
   if (debug) cout << "MEMs::cacheMELAcalculation. Done!" << endl;
 
-  m_MELA->resetInputEvent(); // Do not forget this!
-  return NO_ERR;
+  return NO_ERR; // The MELA input event is reset when the event changes, see resetCache
+}
+
+
+
+///----------------------------------------------------------------------------------------------
+/// MEMs::setCachedEvent - Keep the event for later calls, forgetting the stored results of a different event
+///----------------------------------------------------------------------------------------------
+void MEMs::setCachedEvent(const vector<TLorentzVector>& partP, const vector<int>& partId){
+  if (m_hasCachedEvent && partId==partIdCache && partP==partPCache) return;
+
+  resetCache();
+  partPCache = partP;
+  partIdCache = partId;
+  m_hasCachedEvent = true;
+}
+
+
+
+///----------------------------------------------------------------------------------------------
+/// MEMs::setMELAInputEvent - Set the cached event as the MELA input event, once per event
+///----------------------------------------------------------------------------------------------
+void MEMs::setMELAInputEvent(){
+  if (m_isMELAInputSet) return;
+
+  SimpleParticleCollection_t daughters;
+  SimpleParticleCollection_t associateds;
+  for (unsigned int idau=0; idau<4; idau++) daughters.push_back(SimpleParticle_t(partIdCache.at(idau), partPCache.at(idau))); // Needs generalization for final state
+  for (unsigned int iap=4; iap<partPCache.size(); iap++) associateds.push_back(SimpleParticle_t(partIdCache.at(iap), partPCache.at(iap)));
+  // Mothers, blah...
+  m_MELA->setInputEvent(
+    &daughters,
+    &associateds,
+    0,
+    false
+    );
+  m_isMELAInputSet = true;
+}
+
+
+
+///----------------------------------------------------------------------------------------------
+/// MEMs::isCacheable - Whether the ME is stored for the cached event
+///----------------------------------------------------------------------------------------------
+bool MEMs::isCacheable(int process, vector<complex<double> > *ProdCouplings, vector<complex<double> > *DecayCouplings){
+  return (
+    process>=0 && process<NUM_PROCESSES
+    && ProdCouplings==(vector<complex<double> >*) NULL && DecayCouplings==(vector<complex<double> >*) NULL
+    );
+}
+
+
+
+///----------------------------------------------------------------------------------------------
+/// MEMs::resetCache - Forget the cached event and its stored results
+///----------------------------------------------------------------------------------------------
+void MEMs::resetCache(){
+  if (m_isMELAInputSet) m_MELA->resetInputEvent(); // Do not forget this!
+  m_isMELAInputSet = false;
+  m_hasCachedEvent = false;
+  partPCache.clear();
+  partIdCache.clear();
+
+  for (int iMemCalc = 0; iMemCalc < NUM_MEMCALCS; iMemCalc++){
+    for (int iProcess = 0; iProcess < NUM_PROCESSES; iProcess++){
+      m_computedME[iProcess][iMemCalc] = -999.;
+      m_isMEComputed[iProcess][iMemCalc] = false;
+    }
+  }
+  for (int iSuperKDsyst = 0; iSuperKDsyst < NUM_SuperKDsyst; iSuperKDsyst++) m_isPm4lComputed[iSuperKDsyst] = false;
 }
 
 
@@ -1274,22 +1365,22 @@ complex<double> MEMs::XZZ_form_factor( complex<double> form_c1, complex<double>
 ///----------------------------------------------------------------------------------------------
 //////////////////////////////////////////////////////////////////////////
 void MEMs::computePm4l(
-  vector<TLorentzVector> partP,
-  vector<int> partId,
+  const vector<TLorentzVector>& partP,
+  const vector<int>& partId,
   SuperKDsyst syst,
   double& sigProb,
   double& bkgProb
   ){
   float prob_float;
 
-  SimpleParticleCollection_t daughters;
-  for (unsigned int idau=0; idau<4; idau++) daughters.push_back(SimpleParticle_t(partId.at(idau), partP.at(idau))); // Needs generalization for final state
-  m_MELA->setInputEvent(
-    &daughters,
-    0,
-    0,
-    false
-    );
+  // P(m4l) only depends on the four daughters, so the input event of the MEs is used as well
+  setCachedEvent(partP, partId);
+  if (m_isPm4lComputed[syst]){
+    sigProb = m_computedPm4lSig[syst];
+    bkgProb = m_computedPm4lBkg[syst];
+    return;
+  }
+  setMELAInputEvent();
 
   m_MELA->setProcess(TVar::bkgZZ, TVar::JHUGen, TVar::ZZGG);
   m_MELA->computePM4l((TVar::SuperMelaSyst)syst, prob_float);
@@ -1299,10 +1390,12 @@ void MEMs::computePm4l(
   m_MELA->computePM4l((TVar::SuperMelaSyst)syst, prob_float);
   sigProb = (double)prob_float;
 
-  m_MELA->resetInputEvent(); // Do not forget this!
+  m_computedPm4lSig[syst] = sigProb;
+  m_computedPm4lBkg[syst] = bkgProb;
+  m_isPm4lComputed[syst] = true;
 }
 
-void MEMs::removeLeptonMasses(bool doRemove){ m_MELA->setRemoveLeptonMasses(doRemove); }
+void MEMs::removeLeptonMasses(bool doRemove){ m_MELA->setRemoveLeptonMasses(doRemove); resetCache(); } // The MELA input event has to be rebuilt
 
 
 #endif